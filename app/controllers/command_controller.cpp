@@ -7,8 +7,6 @@
 #include "../../game/systems/production_service.h"
 #include "../../game/systems/selection_system.h"
 #include "../../render/gl/camera.h"
-#include "../utils/movement_utils.h"
-#include "units/spawn_type.h"
 #include <QPointF>
 #include <qglobal.h>
 #include <qobject.h>
@@ -60,8 +58,7 @@ auto CommandController::onAttackClick(qreal sx, qreal sy, int viewportWidth,
     return result;
   }
 
-  Game::Systems::CommandService::attack_target(*m_world, selected, target_id,
-                                               true);
+  Game::Systems::CommandService::queueAttack(selected, target_id, true);
 
   emit attack_targetSelected();
 
@@ -81,26 +78,8 @@ auto CommandController::onStopCommand() -> CommandResult {
     return result;
   }
 
-  for (auto id : selected) {
-    auto *entity = m_world->getEntity(id);
-    if (entity == nullptr) {
-      continue;
-    }
-
-    resetMovement(entity);
-    entity->removeComponent<Engine::Core::AttackTargetComponent>();
-
-    if (auto *patrol = entity->getComponent<Engine::Core::PatrolComponent>()) {
-      patrol->patrolling = false;
-      patrol->waypoints.clear();
-    }
-
-    auto *hold_mode = entity->getComponent<Engine::Core::HoldModeComponent>();
-    if ((hold_mode != nullptr) && hold_mode->active) {
-      hold_mode->active = false;
-      hold_mode->exitCooldown = hold_mode->standUpDuration;
-      emit hold_modeChanged(false);
-    }
+  if (Game::Systems::CommandService::stopUnits(*m_world, selected)) {
+    emit hold_modeChanged(false);
   }
 
   result.inputConsumed = true;
@@ -119,52 +98,10 @@ auto CommandController::onHoldCommand() -> CommandResult {
     return result;
   }
 
-  for (auto id : selected) {
-    auto *entity = m_world->getEntity(id);
-    if (entity == nullptr) {
-      continue;
-    }
-
-    auto *unit = entity->getComponent<Engine::Core::UnitComponent>();
-
-    if ((unit == nullptr) ||
-        (unit->spawn_type != Game::Units::SpawnType::Archer &&
-         unit->spawn_type != Game::Units::SpawnType::Spearman)) {
-      continue;
-    }
-
-    auto *hold_mode = entity->getComponent<Engine::Core::HoldModeComponent>();
-
-    if ((hold_mode != nullptr) && hold_mode->active) {
-      hold_mode->active = false;
-      hold_mode->exitCooldown = hold_mode->standUpDuration;
-      emit hold_modeChanged(false);
-      continue;
-    }
-
-    resetMovement(entity);
-    entity->removeComponent<Engine::Core::AttackTargetComponent>();
-
-    if (auto *patrol = entity->getComponent<Engine::Core::PatrolComponent>()) {
-      patrol->patrolling = false;
-      patrol->waypoints.clear();
-    }
-
-    if (hold_mode == nullptr) {
-      hold_mode = entity->addComponent<Engine::Core::HoldModeComponent>();
-    }
-    hold_mode->active = true;
-    hold_mode->exitCooldown = 0.0F;
-    emit hold_modeChanged(true);
-
-    auto *movement = entity->getComponent<Engine::Core::MovementComponent>();
-    if (movement != nullptr) {
-      movement->hasTarget = false;
-      movement->path.clear();
-      movement->pathPending = false;
-      movement->vx = 0.0F;
-      movement->vz = 0.0F;
-    }
+  auto const toggled =
+      Game::Systems::CommandService::toggleHoldMode(*m_world, selected);
+  if (toggled.has_value()) {
+    emit hold_modeChanged(*toggled);
   }
 
   result.inputConsumed = true;
@@ -214,34 +151,8 @@ auto CommandController::onPatrolClick(qreal sx, qreal sy, int viewportWidth,
 
   QVector3D const second_waypoint = hit;
 
-  for (auto id : selected) {
-    auto *entity = m_world->getEntity(id);
-    if (entity == nullptr) {
-      continue;
-    }
-
-    auto *building = entity->getComponent<Engine::Core::BuildingComponent>();
-    if (building != nullptr) {
-      continue;
-    }
-
-    auto *patrol = entity->getComponent<Engine::Core::PatrolComponent>();
-    if (patrol == nullptr) {
-      patrol = entity->addComponent<Engine::Core::PatrolComponent>();
-    }
-
-    if (patrol != nullptr) {
-      patrol->waypoints.clear();
-      patrol->waypoints.emplace_back(m_patrolFirstWaypoint.x(),
-                                     m_patrolFirstWaypoint.z());
-      patrol->waypoints.emplace_back(second_waypoint.x(), second_waypoint.z());
-      patrol->currentWaypoint = 0;
-      patrol->patrolling = true;
-    }
-
-    resetMovement(entity);
-    entity->removeComponent<Engine::Core::AttackTargetComponent>();
-  }
+  Game::Systems::CommandService::queuePatrol(selected, m_patrolFirstWaypoint,
+                                             second_waypoint);
 
   clearPatrolFirstWaypoint();
   result.inputConsumed = true;
@@ -293,10 +204,6 @@ void CommandController::recruitNearSelected(const QString &unit_type,
   }
 }
 
-void CommandController::resetMovement(Engine::Core::Entity *entity) {
-  App::Utils::resetMovement(entity);
-}
-
 auto CommandController::anySelectedInHoldMode() const -> bool {
   if ((m_selection_system == nullptr) || (m_world == nullptr)) {
     return false;
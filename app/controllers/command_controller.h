@@ -64,8 +64,6 @@ private:
 
   bool m_hasPatrolFirstWaypoint = false;
   QVector3D m_patrolFirstWaypoint;
-
-  static void resetMovement(Engine::Core::Entity *entity);
 };
 
 } // namespace App::Controllers
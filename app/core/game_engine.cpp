@@ -5,6 +5,7 @@
 #include "../models/audio_system_proxy.h"
 #include "../models/cursor_manager.h"
 #include "../models/hover_tracker.h"
+#include "../models/minimap_provider.h"
 #include "AudioEventHandler.h"
 #include "app/models/cursor_mode.h"
 #include "app/utils/engine_view_helpers.h"
@@ -44,6 +45,11 @@
 
 #include "../models/selected_units_model.h"
 #include "game/core/component.h"
+#include "game/core/alloc_tracker.h"
+#include "game/core/determinism.h"
+#include "game/core/frame_governor.h"
+#include "game/core/latency_tracker.h"
+#include "game/core/profiler.h"
 #include "game/core/event_manager.h"
 #include "game/core/world.h"
 #include "game/game_config.h"
@@ -58,12 +64,14 @@
 #include "game/map/world_bootstrap.h"
 #include "game/systems/ai_system.h"
 #include "game/systems/arrow_system.h"
+#include "game/systems/benchmark_scenario.h"
 #include "game/systems/building_collision_registry.h"
 #include "game/systems/camera_service.h"
 #include "game/systems/capture_system.h"
 #include "game/systems/cleanup_system.h"
 #include "game/systems/combat_system.h"
 #include "game/systems/command_service.h"
+#include "game/systems/pathfinding.h"
 #include "game/systems/game_state_serializer.h"
 #include "game/systems/global_stats_registry.h"
 #include "game/systems/movement_system.h"
@@ -73,6 +81,7 @@
 #include "game/systems/picking_service.h"
 #include "game/systems/production_service.h"
 #include "game/systems/production_system.h"
+#include "game/systems/replay_service.h"
 #include "game/systems/save_load_service.h"
 #include "game/systems/selection_system.h"
 #include "game/systems/terrain_alignment_system.h"
@@ -92,27 +101,56 @@
 #include "render/ground/pine_renderer.h"
 #include "render/ground/plant_renderer.h"
 #include "render/ground/river_renderer.h"
+#include "render/ground/riverbank_asset_renderer.h"
 #include "render/ground/riverbank_renderer.h"
 #include "render/ground/stone_renderer.h"
 #include "render/ground/terrain_renderer.h"
+#include "render/particle_system.h"
 #include "render/scene_renderer.h"
+#include "render/thread_topology.h"
+#include "utils/resource_utils.h"
+#include <QDateTime>
 #include <QDir>
+#include <QStandardPaths>
 #include <QFile>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QSet>
+#include <QStringList>
+#include <QTimer>
 #include <algorithm>
 #include <cmath>
 #include <utility>
 #include <vector>
 
+namespace {
+constexpr int k_autosave_interval_ms = 3 * 60 * 1000;
+constexpr const char *k_autosave_slot = "autosave";
+constexpr qint64 k_spike_export_cooldown_ms = 10 * 1000;
+// Median-relative spikes below this absolute floor are ignored: on a
+// fast machine a few milliseconds of jitter can be many multiples of the
+// median without being a stutter anyone perceives.
+constexpr double k_spike_floor_ms = 20.0;
+// One minute of frames at the render cadence; long enough for both
+// armies to close and fight, short enough for a CI smoke run.
+constexpr std::size_t k_benchmark_sample_frames = 1800;
+constexpr const char *k_benchmark_map = ":/assets/maps/map_rivers.json";
+// The tuning file lives on disk rather than in the qrc so balancing
+// edits apply to a running game; polling its mtime once a second is
+// cheaper than a file watcher and plenty responsive for hand edits.
+constexpr const char *k_tuning_file = "assets/config/tuning.json";
+constexpr float k_tuning_poll_interval_s = 1.0F;
+} // namespace
+
 GameEngine::GameEngine()
     : m_selectedUnitsModel(new SelectedUnitsModel(this, this)) {
 
   Game::Systems::NationRegistry::instance().initializeDefaults();
   Game::Systems::TroopCountRegistry::instance().initialize();
   Game::Systems::GlobalStatsRegistry::instance().initialize();
+  Game::GameConfig::instance().setSourceFile(
+      QString::fromUtf8(k_tuning_file));
 
   m_world = std::make_unique<Engine::Core::World>();
   m_renderer = std::make_unique<Render::GL::Renderer>();
@@ -122,6 +160,7 @@ GameEngine::GameEngine()
   m_biome = std::make_unique<Render::GL::BiomeRenderer>();
   m_river = std::make_unique<Render::GL::RiverRenderer>();
   m_riverbank = std::make_unique<Render::GL::RiverbankRenderer>();
+  m_riverbankAssets = std::make_unique<Render::GL::RiverbankAssetRenderer>();
   m_bridge = std::make_unique<Render::GL::BridgeRenderer>();
   m_fog = std::make_unique<Render::GL::FogRenderer>();
   m_stone = std::make_unique<Render::GL::StoneRenderer>();
@@ -129,14 +168,52 @@ GameEngine::GameEngine()
   m_pine = std::make_unique<Render::GL::PineRenderer>();
   m_firecamp = std::make_unique<Render::GL::FireCampRenderer>();
 
-  m_passes = {m_ground.get(),    m_terrain.get(), m_river.get(),
-              m_riverbank.get(), m_bridge.get(),  m_biome.get(),
-              m_stone.get(),     m_plant.get(),   m_pine.get(),
-              m_firecamp.get(),  m_fog.get()};
+  m_passGraph.clear();
+  m_passGraph.addPass("ground", m_ground.get(), {}, {"ground"});
+  m_passGraph.addPass("terrain", m_terrain.get(), {"ground"}, {"terrain"});
+  m_passGraph.addPass("river", m_river.get(), {"terrain"}, {"water"});
+  m_passGraph.addPass("riverbank", m_riverbank.get(), {"water"},
+                      {"riverbank"});
+  m_passGraph.addPass("riverbank_assets", m_riverbankAssets.get(),
+                      {"riverbank"}, {"riverbank-assets"});
+  m_passGraph.addPass("bridge", m_bridge.get(), {"water"}, {"bridges"});
+  m_passGraph.addPass("biome", m_biome.get(), {"terrain"}, {"biome"});
+  m_passGraph.addPass("stone", m_stone.get(), {"biome"}, {"stones"});
+  m_passGraph.addPass("plant", m_plant.get(), {"biome"}, {"plants"});
+  m_passGraph.addPass("pine", m_pine.get(), {"biome"}, {"pines"});
+  m_passGraph.addPass("firecamp", m_firecamp.get(), {"biome"}, {"firecamps"});
+  m_passGraph.addPass("fog", m_fog.get(), {"terrain"}, {"fog-mask"});
+
+  // Buildings placed after the grass scatter clear their own footprint
+  // locally instead of triggering a full re-scatter; the clear is queued
+  // and drained on the render thread.
+  Game::Systems::BuildingCollisionRegistry::instance().setPlacementListener(
+      [biome = m_biome.get()](
+          const Game::Systems::BuildingFootprint &footprint) {
+        float const half_width = footprint.width * 0.5F;
+        float const half_depth = footprint.depth * 0.5F;
+        biome->invalidateFootprint(footprint.center_x - half_width,
+                                   footprint.center_z - half_depth,
+                                   footprint.center_x + half_width,
+                                   footprint.center_z + half_depth);
+      });
+
+  Render::ThreadTopology::instance().registerCurrentThread(
+      Render::ThreadTopology::Role::Main, "main");
+  // Flight recorder: zone recording runs from startup so a field stutter
+  // is already captured when the spike trigger fires; the HUD and GPU
+  // timer queries stay off until F10.
+  Engine::Core::Profiler::instance().setEnabled(true);
 
-  std::unique_ptr<Engine::Core::System> arrow_sys =
-      std::make_unique<Game::Systems::ArrowSystem>();
-  m_world->addSystem(std::move(arrow_sys));
+  // Pass node names are stable for the graph's lifetime, so the zone name
+  // pointer handed to the profiler stays valid.
+  m_passGraph.setBeforePassHook([](const std::string &name) {
+    Engine::Core::Profiler::instance().pushZone(name.c_str());
+  });
+  m_passGraph.setAfterPassHook(
+      [](const std::string &) { Engine::Core::Profiler::instance().popZone(); });
+
+  m_world->addSystem(std::make_unique<Game::Systems::ArrowSystem>());
 
   m_world->addSystem(std::make_unique<Game::Systems::MovementSystem>());
   m_world->addSystem(std::make_unique<Game::Systems::PatrolSystem>());
@@ -147,18 +224,25 @@ GameEngine::GameEngine()
   m_world->addSystem(std::make_unique<Game::Systems::TerrainAlignmentSystem>());
   m_world->addSystem(std::make_unique<Game::Systems::CleanupSystem>());
 
-  {
-    std::unique_ptr<Engine::Core::System> sel_sys =
-        std::make_unique<Game::Systems::SelectionSystem>();
-    m_world->addSystem(std::move(sel_sys));
-  }
+  m_world->addSystem(std::make_unique<Game::Systems::SelectionSystem>());
+
+  // Cache the cross-system pointers the engine touches every frame; the set
+  // of systems is fixed after bootstrap.
+  m_arrowSystem = m_world->getSystem<Game::Systems::ArrowSystem>();
+  m_selectionSystem = m_world->getSystem<Game::Systems::SelectionSystem>();
+  m_aiSystem = m_world->getSystem<Game::Systems::AISystem>();
 
   m_pickingService = std::make_unique<Game::Systems::PickingService>();
   m_victoryService = std::make_unique<Game::Systems::VictoryService>();
   m_saveLoadService = std::make_unique<Game::Systems::SaveLoadService>();
   m_cameraService = std::make_unique<Game::Systems::CameraService>();
 
-  auto *selection_system = m_world->getSystem<Game::Systems::SelectionSystem>();
+  m_autosaveTimer = new QTimer(this);
+  m_autosaveTimer->setInterval(k_autosave_interval_ms);
+  connect(m_autosaveTimer, &QTimer::timeout, this, &GameEngine::autosave);
+  m_autosaveTimer->start();
+
+  auto *selection_system = m_selectionSystem;
   m_selectionController = std::make_unique<Game::Systems::SelectionController>(
       m_world.get(), selection_system, m_pickingService.get());
   m_commandController = std::make_unique<App::Controllers::CommandController>(
@@ -233,7 +317,7 @@ GameEngine::GameEngine()
           &App::Controllers::CommandController::attack_targetSelected,
           [this]() {
             if (auto *sel_sys =
-                    m_world->getSystem<Game::Systems::SelectionSystem>()) {
+                    m_selectionSystem) {
               const auto &sel = sel_sys->getSelectedUnits();
               if (!sel.empty()) {
                 auto *cam = m_camera.get();
@@ -276,16 +360,20 @@ GameEngine::GameEngine()
               m_enemyTroopsDefeated += individuals_per_unit;
               emit enemyTroopsDefeatedChanged();
             }
-          });
+          },
+          Engine::Core::DispatchLane::Late, "ui:unit_died");
 
   m_unitSpawnedSubscription =
       Engine::Core::ScopedEventSubscription<Engine::Core::UnitSpawnedEvent>(
           [this](const Engine::Core::UnitSpawnedEvent &e) {
             onUnitSpawned(e);
-          });
+          },
+          Engine::Core::DispatchLane::Late, "ui:unit_spawned");
 }
 
 GameEngine::~GameEngine() {
+  Game::Systems::BuildingCollisionRegistry::instance().setPlacementListener(
+      nullptr);
 
   if (m_audioEventHandler) {
     m_audioEventHandler->shutdown();
@@ -295,6 +383,7 @@ GameEngine::~GameEngine() {
 }
 
 void GameEngine::onMapClicked(qreal sx, qreal sy) {
+  Engine::Core::LatencyTracker::instance().noteInput();
   if (m_window == nullptr) {
     return;
   }
@@ -307,11 +396,12 @@ void GameEngine::onMapClicked(qreal sx, qreal sy) {
 }
 
 void GameEngine::onRightClick(qreal sx, qreal sy) {
+  Engine::Core::LatencyTracker::instance().noteInput();
   if (m_window == nullptr) {
     return;
   }
   ensureInitialized();
-  auto *selection_system = m_world->getSystem<Game::Systems::SelectionSystem>();
+  auto *selection_system = m_selectionSystem;
   if (selection_system == nullptr) {
     return;
   }
@@ -333,6 +423,7 @@ void GameEngine::onRightClick(qreal sx, qreal sy) {
 }
 
 void GameEngine::onAttackClick(qreal sx, qreal sy) {
+  Engine::Core::LatencyTracker::instance().noteInput();
   if (m_window == nullptr) {
     return;
   }
@@ -344,7 +435,7 @@ void GameEngine::onAttackClick(qreal sx, qreal sy) {
   auto result = m_commandController->onAttackClick(
       sx, sy, m_viewport.width, m_viewport.height, m_camera.get());
 
-  auto *selection_system = m_world->getSystem<Game::Systems::SelectionSystem>();
+  auto *selection_system = m_selectionSystem;
   if ((selection_system == nullptr) || !m_pickingService || !m_camera ||
       !m_world) {
     return;
@@ -380,6 +471,7 @@ void GameEngine::resetMovement(Engine::Core::Entity *entity) {
 }
 
 void GameEngine::onStopCommand() {
+  Engine::Core::LatencyTracker::instance().noteInput();
   if (!m_commandController) {
     return;
   }
@@ -392,6 +484,7 @@ void GameEngine::onStopCommand() {
 }
 
 void GameEngine::onHoldCommand() {
+  Engine::Core::LatencyTracker::instance().noteInput();
   if (!m_commandController) {
     return;
   }
@@ -411,6 +504,7 @@ auto GameEngine::anySelectedInHoldMode() const -> bool {
 }
 
 void GameEngine::onPatrolClick(qreal sx, qreal sy) {
+  Engine::Core::LatencyTracker::instance().noteInput();
   if (!m_commandController || !m_camera) {
     return;
   }
@@ -483,13 +577,19 @@ void GameEngine::setHoverAtScreen(qreal sx, qreal sy) {
     return;
   }
 
-  m_cursorManager->updateCursorShape(m_window);
-
-  m_hoverTracker->updateHover(float(sx), float(sy), *m_world, *m_camera,
-                              m_viewport.width, m_viewport.height);
+  // The cursor shape depends only on the mode, and setCursorMode applies
+  // it when the mode changes; re-applying it per mouse move bought
+  // nothing. Moves only feed the cursor to the renderer's ID-buffer pass
+  // and record it for the per-frame resolve in render(); no picking
+  // happens on the event path.
+  if (m_renderer) {
+    m_renderer->setPickCursor(float(sx), float(sy));
+  }
+  m_hoverTracker->setCursor(float(sx), float(sy));
 }
 
 void GameEngine::onClickSelect(qreal sx, qreal sy, bool additive) {
+  Engine::Core::LatencyTracker::instance().noteInput();
   if (m_window == nullptr) {
     return;
   }
@@ -503,6 +603,7 @@ void GameEngine::onClickSelect(qreal sx, qreal sy, bool additive) {
 
 void GameEngine::onAreaSelected(qreal x1, qreal y1, qreal x2, qreal y2,
                                 bool additive) {
+  Engine::Core::LatencyTracker::instance().noteInput();
   if (m_window == nullptr) {
     return;
   }
@@ -515,6 +616,7 @@ void GameEngine::onAreaSelected(qreal x1, qreal y1, qreal x2, qreal y2,
 }
 
 void GameEngine::selectAllTroops() {
+  Engine::Core::LatencyTracker::instance().noteInput();
   ensureInitialized();
   if (m_selectionController) {
     m_selectionController->selectAllPlayerTroops(m_runtime.localOwnerId);
@@ -537,32 +639,287 @@ auto GameEngine::enemyTroopsDefeated() const -> int {
 QVariantMap GameEngine::getPlayerStats(int owner_id) {
   QVariantMap result;
 
-  auto &stats_registry = Game::Systems::GlobalStatsRegistry::instance();
-  const auto *stats = stats_registry.getStats(owner_id);
-
-  if (stats != nullptr) {
-    result["troopsRecruited"] = stats->troopsRecruited;
-    result["enemiesKilled"] = stats->enemiesKilled;
-    result["barracksOwned"] = stats->barracksOwned;
-    result["playTimeSec"] = stats->playTimeSec;
-    result["gameEnded"] = stats->gameEnded;
-  } else {
-    result["troopsRecruited"] = 0;
-    result["enemiesKilled"] = 0;
-    result["barracksOwned"] = 0;
-    result["playTimeSec"] = 0.0F;
-    result["gameEnded"] = false;
-  }
+  // Invoked from QML on the GUI thread while the simulation thread keeps
+  // mutating the registry; the published snapshot makes this read safe
+  // without blocking the writer.
+  auto const stats = Game::Systems::GlobalStatsRegistry::instance()
+                         .snapshotStats(owner_id);
+
+  result["troopsRecruited"] = stats.troopsRecruited;
+  result["enemiesKilled"] = stats.enemiesKilled;
+  result["barracksOwned"] = stats.barracksOwned;
+  result["playTimeSec"] = stats.playTimeSec;
+  result["gameEnded"] = stats.gameEnded;
 
   return result;
 }
 
+void GameEngine::setDeterministicMode(bool enabled) {
+  if (m_deterministicMode == enabled) {
+    return;
+  }
+  m_deterministicMode = enabled;
+  emit deterministicModeChanged();
+}
+
+void GameEngine::setSimSeed(int seed) {
+  Engine::Core::SimRng::instance().setSeed(static_cast<quint32>(seed));
+}
+
+auto GameEngine::tickChecksum() const -> QString {
+  return QStringLiteral("%1:%2").arg(m_simTick).arg(m_lastTickChecksum, 8, 16,
+                                                    QLatin1Char('0'));
+}
+
+auto GameEngine::startReplayRecording(const QString &path) -> bool {
+  if (m_level.map_path.isEmpty()) {
+    return false;
+  }
+  return Game::Systems::ReplayService::instance().startRecording(
+      path, Engine::Core::SimRng::instance().seed(), m_level.map_path,
+      m_lastPlayerConfigs);
+}
+
+void GameEngine::stopReplayRecording() {
+  Game::Systems::ReplayService::instance().stopRecording();
+}
+
+auto GameEngine::startReplayPlayback(const QString &path) -> bool {
+  auto &replay = Game::Systems::ReplayService::instance();
+  if (!replay.startPlayback(path)) {
+    return false;
+  }
+  Engine::Core::SimRng::instance().setSeed(replay.playbackSeed());
+  startSkirmish(replay.playbackMapPath(), replay.playbackPlayerConfigs());
+  return true;
+}
+
+void GameEngine::stopReplayPlayback() {
+  Game::Systems::ReplayService::instance().stopPlayback();
+}
+
+auto GameEngine::profilerEnabled() const -> bool {
+  return m_profilerHudVisible;
+}
+
+void GameEngine::setProfilerEnabled(bool enabled) {
+  if (m_profilerHudVisible == enabled) {
+    return;
+  }
+  // Zone recording itself is always on (flight recorder); the toggle only
+  // controls the overlay and the GPU timer queries behind it.
+  m_profilerHudVisible = enabled;
+  Engine::Core::Profiler::instance().setGpuTimingEnabled(enabled);
+  emit profilerEnabledChanged();
+}
+
+namespace {
+
+constexpr int k_profiler_overlay_max_rows = 96;
+
+auto zonesToVariant(const Engine::Core::Profiler::FrameSnapshot &frame)
+    -> QVariantList {
+  QVariantList rows;
+  const int count = std::min(static_cast<int>(frame.zones.size()),
+                             k_profiler_overlay_max_rows);
+  rows.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    const auto &zone = frame.zones[static_cast<std::size_t>(i)];
+    QVariantMap row;
+    row["name"] = QString::fromLatin1(zone.name);
+    row["start"] = zone.startMs;
+    row["ms"] = zone.durationMs;
+    row["depth"] = zone.depth;
+    row["thread"] = zone.threadIndex;
+    rows.push_back(row);
+  }
+  return rows;
+}
+
+} // namespace
+
+auto GameEngine::exportProfilerTrace() -> QString {
+  QString const tracesDir =
+      QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) +
+      QStringLiteral("/traces");
+  QDir const dir;
+  if (!dir.exists(tracesDir) && !dir.mkpath(tracesDir)) {
+    return {};
+  }
+  QString const path =
+      tracesDir + QStringLiteral("/trace_") +
+      QDateTime::currentDateTime().toString(QStringLiteral(
+          "yyyyMMdd_hhmmss")) +
+      QStringLiteral(".json");
+  if (!Engine::Core::Profiler::instance().writeChromeTrace(path)) {
+    return {};
+  }
+  return path;
+}
+
+void GameEngine::setProfilerSpikeThreshold(double ms) {
+  m_profilerSpikeThresholdMs = std::max(0.0, ms);
+}
+
+void GameEngine::setProfilerSpikeMultiplier(double multiplier) {
+  m_profilerSpikeMultiplier = std::max(0.0, multiplier);
+}
+
+void GameEngine::startBenchmark(int unitsPerSide) {
+  m_benchmarkUnitsPerSide = std::max(2, unitsPerSide);
+  m_benchmarkUnitsSpawned = 0;
+  m_benchmarkActive = false;
+  m_benchmarkReport = {};
+  // The GL side may not exist yet when this is called from main(); defer
+  // the actual map load until update() sees an initialized engine.
+  m_benchmarkLaunchPending = true;
+}
+
+auto GameEngine::profilerSnapshot() const -> QVariantMap {
+  auto &profiler = Engine::Core::Profiler::instance();
+  const auto last = profiler.lastFrame();
+  const auto worst = profiler.worstFrame();
+  QVariantMap snapshot;
+  snapshot["frameIndex"] = static_cast<qulonglong>(last.frameIndex);
+  snapshot["frameMs"] = last.totalMs;
+  snapshot["zones"] = zonesToVariant(last);
+  snapshot["worstFrameIndex"] = static_cast<qulonglong>(worst.frameIndex);
+  snapshot["worstMs"] = worst.totalMs;
+  snapshot["worstZones"] = zonesToVariant(worst);
+
+  const auto latency = Engine::Core::LatencyTracker::instance().stats();
+  snapshot["inputLatencyP50"] = latency.p50Ms;
+  snapshot["inputLatencyP99"] = latency.p99Ms;
+  snapshot["inputLatencySamples"] =
+      static_cast<qulonglong>(latency.sampleCount);
+
+  QVariantList alloc_rows;
+  for (std::size_t i = 0; i < Engine::Core::AllocTracker::k_tag_count; ++i) {
+    const auto tag = static_cast<Engine::Core::AllocTag>(i);
+    const auto counters = Engine::Core::AllocTracker::lastFrame(tag);
+    QVariantMap row;
+    row["tag"] = QString::fromLatin1(Engine::Core::AllocTracker::tagName(tag));
+    row["count"] = static_cast<qulonglong>(counters.allocations);
+    row["bytes"] = static_cast<qulonglong>(counters.bytes);
+    alloc_rows.push_back(row);
+  }
+  snapshot["allocs"] = alloc_rows;
+
+  QVariantList thread_rows;
+  for (const auto &info : Render::ThreadTopology::instance().layout()) {
+    QVariantMap row;
+    row["name"] = info.name;
+    row["role"] =
+        QString::fromLatin1(Render::ThreadTopology::roleName(info.role));
+    QStringList cores;
+    cores.reserve(static_cast<qsizetype>(info.cores.size()));
+    for (int core : info.cores) {
+      cores.push_back(QString::number(core));
+    }
+    row["cores"] = cores.isEmpty() ? QStringLiteral("any")
+                                   : cores.join(QStringLiteral(","));
+    thread_rows.push_back(row);
+  }
+  snapshot["threads"] = thread_rows;
+
+  if (auto *pathfinder = Game::Systems::CommandService::getPathfinder()) {
+    const auto depths = pathfinder->queueDepths();
+    QVariantMap paths;
+    paths["high"] = static_cast<qulonglong>(depths.high);
+    paths["normal"] = static_cast<qulonglong>(depths.normal);
+    paths["highWaitMs"] = depths.highWaitMs;
+    paths["normalWaitMs"] = depths.normalWaitMs;
+    paths["dropped"] = static_cast<qulonglong>(depths.dropped);
+    snapshot["pathQueues"] = paths;
+  }
+  return snapshot;
+}
+
+void GameEngine::setWindow(QQuickWindow *w) {
+  if (m_window == w) {
+    return;
+  }
+  if (m_window != nullptr) {
+    disconnect(m_window, &QQuickWindow::frameSwapped, this, nullptr);
+  }
+  m_window = w;
+  if (m_window != nullptr) {
+    // Direct connection: frameSwapped fires on the render thread right
+    // after the buffer swap, which is the present edge the input
+    // latency samples close against.
+    connect(
+        m_window, &QQuickWindow::frameSwapped, this,
+        [] { Engine::Core::LatencyTracker::instance().notePresent(); },
+        Qt::DirectConnection);
+  }
+}
+
 void GameEngine::update(float dt) {
 
+  // Inputs stamped before this point are part of the frame this update
+  // produces; the swap of that frame completes their latency samples.
+  Engine::Core::LatencyTracker::instance().beginSimStep();
+
+  auto &profiler = Engine::Core::Profiler::instance();
+  profiler.beginFrame();
+  const double last_frame_ms = profiler.lastFrameTotalMs();
+  Engine::Core::FrameGovernor::instance().beginFrame(last_frame_ms);
+  bool spike = m_profilerSpikeThresholdMs > 0.0 &&
+               last_frame_ms >= m_profilerSpikeThresholdMs;
+  if (!spike && m_profilerSpikeMultiplier > 0.0 &&
+      last_frame_ms >= k_spike_floor_ms) {
+    const double median_ms = profiler.rollingMedianMs();
+    spike = median_ms > 0.0 &&
+            last_frame_ms >= median_ms * m_profilerSpikeMultiplier;
+  }
+  if (spike) {
+    const qint64 now_ms = QDateTime::currentMSecsSinceEpoch();
+    if (now_ms - m_lastSpikeExportMs >= k_spike_export_cooldown_ms) {
+      m_lastSpikeExportMs = now_ms;
+      const QString trace_path = exportProfilerTrace();
+      if (!trace_path.isEmpty()) {
+        qInfo() << "Frame spike" << last_frame_ms << "ms (median"
+                << profiler.rollingMedianMs() << "ms); trace written to"
+                << trace_path;
+      }
+    }
+  }
+
+  if (m_benchmarkLaunchPending && m_runtime.initialized && !m_runtime.loading) {
+    m_benchmarkLaunchPending = false;
+    m_benchmarkSpawnPending = true;
+    startSkirmish(
+        Utils::Resources::resolveResourcePath(QString::fromUtf8(k_benchmark_map)),
+        Game::Systems::BenchmarkScenario::playerConfigs());
+  }
+
   if (m_runtime.loading) {
     return;
   }
 
+  // The caller runs on the render cadence; measure real elapsed time so the
+  // sim keeps its fixed rate when the frame rate dips or spikes.
+  const qint64 now_ns = m_frameTimer.isValid() ? m_frameTimer.nsecsElapsed()
+                                               : (m_frameTimer.start(), 0);
+  if (m_runtime.lastFrameNs >= 0) {
+    dt = static_cast<float>(now_ns - m_runtime.lastFrameNs) * 1e-9F;
+    dt = std::min(dt, kMaxFrameDt);
+  }
+  m_runtime.lastFrameNs = now_ns;
+
+  // Detect tuning-file edits on real elapsed time (works while paused);
+  // an applied reload publishes through the double-buffered config swap
+  // and never stalls the frame.
+  m_runtime.tuningPollAccumulator += dt;
+  if (m_runtime.tuningPollAccumulator >= k_tuning_poll_interval_s) {
+    m_runtime.tuningPollAccumulator = 0.0F;
+    Game::GameConfig::instance().reloadIfChanged();
+  }
+
+  if (m_benchmarkActive) {
+    m_benchmarkReport.addFrameMs(static_cast<double>(dt) * 1000.0);
+  }
+
   if (m_runtime.paused) {
     dt = 0.0F;
   } else {
@@ -582,14 +939,58 @@ void GameEngine::update(float dt) {
   }
 
   if (m_world) {
-    m_world->update(dt);
+    // Fixed-timestep simulation: unit logic ticks at kSimTickDt regardless
+    // of the render frame rate. A slow frame runs several catch-up ticks
+    // (bounded by kMaxFrameDt above), a fast one may skip the sim entirely.
+    m_runtime.simAccumulator += dt;
+    while (m_runtime.simAccumulator >= kSimTickDt) {
+      Engine::Core::SimRng::instance().beginTick(++m_simTick);
+      auto &replay = Game::Systems::ReplayService::instance();
+      replay.beginTick(m_simTick);
+      if (replay.isPlaybackActive()) {
+        replay.playbackTick(*m_world);
+      }
+      // Apply UI commands queued since the last tick; input never
+      // mutates the world mid-tick.
+      Game::Systems::CommandService::flushQueuedCommands(*m_world);
+      if (m_benchmarkActive) {
+        QElapsedTimer tick_timer;
+        tick_timer.start();
+        m_world->update(kSimTickDt);
+        m_benchmarkReport.addTickMs(
+            static_cast<double>(tick_timer.nsecsElapsed()) * 1e-6);
+      } else {
+        m_world->update(kSimTickDt);
+      }
+      m_runtime.simAccumulator -= kSimTickDt;
+      if (m_deterministicMode) {
+        m_lastTickChecksum = Engine::Core::computeWorldChecksum(*m_world);
+        emit tickChecksumChanged();
+      }
+    }
+
+    // Refresh the render snapshot every frame (not just on sim ticks) so
+    // entities spawned or mutated from input handlers between ticks show up
+    // immediately.
+    if (m_renderer) {
+      SOI_PROFILE_ZONE("Renderer::captureWorld");
+      Engine::Core::AllocTagScope const alloc_tag(
+          Engine::Core::AllocTag::Render);
+      // The accumulator's progress toward the next tick interpolates
+      // captured transforms between the last two sim ticks, so the frame
+      // rate can outrun the fixed tick rate without stepped motion.
+      const float tick_alpha =
+          std::clamp(m_runtime.simAccumulator / kSimTickDt, 0.0F, 1.0F);
+      m_renderer->captureWorld(m_world.get(), m_simTick, tick_alpha);
+    }
 
     auto &visibility_service = Game::Map::VisibilityService::instance();
     if (visibility_service.isInitialized()) {
 
       m_runtime.visibilityUpdateAccumulator += dt;
       const float visibility_update_interval =
-          Game::GameConfig::instance().gameplay().visibility_update_interval;
+          Game::GameConfig::instance().gameplay().visibility_update_interval *
+          Engine::Core::FrameGovernor::instance().visibilityIntervalScale();
       if (m_runtime.visibilityUpdateAccumulator >= visibility_update_interval) {
         m_runtime.visibilityUpdateAccumulator = 0.0F;
         visibility_service.update(*m_world, m_runtime.localOwnerId);
@@ -598,13 +999,27 @@ void GameEngine::update(float dt) {
       const auto new_version = visibility_service.version();
       if (new_version != m_runtime.visibilityVersion) {
         if (m_fog) {
-          m_fog->updateMask(visibility_service.getWidth(),
-                            visibility_service.getHeight(),
-                            visibility_service.getTileSize(),
-                            visibility_service.snapshotCells());
+          // Scatter-update with the changed runs when the delta window
+          // covers us; fall back to the full snapshot otherwise.
+          if (!m_fog->patchMask(visibility_service,
+                                m_runtime.visibilityVersion)) {
+            m_fog->updateMask(visibility_service.getWidth(),
+                              visibility_service.getHeight(),
+                              visibility_service.getTileSize(),
+                              visibility_service.snapshotCells());
+          }
         }
         m_runtime.visibilityVersion = new_version;
       }
+      if (m_fog) {
+        m_fog->updateSources(visibility_service.snapshotVisionSourcesWorld());
+      }
+    }
+
+    if (m_minimapProvider != nullptr &&
+        m_minimapProvider->maybeRefresh(*m_world, m_runtime.localOwnerId)) {
+      ++m_minimapVersion;
+      emit minimapVersionChanged();
     }
   }
 
@@ -612,14 +1027,21 @@ void GameEngine::update(float dt) {
     m_victoryService->update(*m_world, dt);
   }
 
-  if (m_followSelectionEnabled && m_camera && m_world && m_cameraService) {
-    m_cameraService->updateFollow(*m_camera, *m_world,
-                                  m_followSelectionEnabled);
+  // Camera follow runs on the render thread now (see
+  // Renderer::updateFollowCamera), tracking the interpolated snapshot at
+  // display refresh rate instead of the sim update rate.
+
+  if (m_audioEventHandler) {
+    if (m_camera) {
+      const QVector3D &listener = m_camera->getTarget();
+      m_audioEventHandler->setListenerPosition(listener.x(), listener.z());
+    }
+    m_audioEventHandler->update();
   }
 
   if (m_selectedUnitsModel != nullptr) {
     auto *selection_system =
-        m_world->getSystem<Game::Systems::SelectionSystem>();
+        m_selectionSystem;
     if ((selection_system != nullptr) &&
         !selection_system->getSelectedUnits().empty()) {
       m_runtime.selectionRefreshCounter++;
@@ -629,6 +1051,13 @@ void GameEngine::update(float dt) {
       }
     }
   }
+
+  if (m_benchmarkActive &&
+      m_benchmarkReport.frameCount() >= k_benchmark_sample_frames) {
+    m_benchmarkActive = false;
+    qInfo().noquote() << QString::fromUtf8(m_benchmarkReport.toJson(
+        m_benchmarkUnitsPerSide, m_benchmarkUnitsSpawned));
+  }
 }
 
 void GameEngine::render(int pixelWidth, int pixelHeight) {
@@ -636,36 +1065,82 @@ void GameEngine::render(int pixelWidth, int pixelHeight) {
   if (!m_renderer || !m_world || !m_runtime.initialized || m_runtime.loading) {
     return;
   }
+  Engine::Core::AllocTagScope const alloc_tag(Engine::Core::AllocTag::Render);
   if (pixelWidth > 0 && pixelHeight > 0) {
     m_viewport.width = pixelWidth;
     m_viewport.height = pixelHeight;
     m_renderer->setViewport(pixelWidth, pixelHeight);
   }
   if (auto *selection_system =
-          m_world->getSystem<Game::Systems::SelectionSystem>()) {
+          m_selectionSystem) {
     const auto &sel = selection_system->getSelectedUnits();
     std::vector<unsigned int> const ids(sel.begin(), sel.end());
     m_renderer->setSelectedEntities(ids);
   }
   m_renderer->beginFrame();
   if (auto *res = m_renderer->resources()) {
-    for (auto *pass : m_passes) {
-      if (pass != nullptr) {
-        pass->submit(*m_renderer, res);
-      }
-    }
+    m_passGraph.submitAll(*m_renderer, res);
   }
   if (m_renderer && m_hoverTracker) {
+    // Resolve at most one hover pick per rendered frame, seeded with the
+    // previous frame's ID-buffer readback — one frame of hover latency,
+    // but mouse-move cost no longer scales with entity count.
+    if (m_pickingService) {
+      unsigned int gpu_id = 0;
+      bool const gpu_valid = m_renderer->pickedEntityId(gpu_id);
+      m_pickingService->setResolvedPick(
+          gpu_id,
+          QPointF(m_hoverTracker->cursorX(), m_hoverTracker->cursorY()),
+          gpu_valid);
+    }
+    if (m_world && m_camera) {
+      m_hoverTracker->resolvePending(*m_world, *m_camera, m_viewport.width,
+                                     m_viewport.height);
+    }
     m_renderer->setHoveredEntityId(m_hoverTracker->getLastHoveredEntity());
+
+    // Classify the cached hover result once per frame; QML reads the
+    // property for the attack-context cursor, so mouse movement itself
+    // never queries the world.
+    bool hovered_enemy = false;
+    auto const hovered_id = m_hoverTracker->getLastHoveredEntity();
+    if (hovered_id != 0 && m_world) {
+      if (auto *e = m_world->getEntity(hovered_id)) {
+        if (auto *u = e->getComponent<Engine::Core::UnitComponent>()) {
+          hovered_enemy =
+              u->health > 0 &&
+              Game::Systems::OwnerRegistry::instance().areEnemies(
+                  m_runtime.localOwnerId, u->owner_id);
+        }
+      }
+    }
+    if (hovered_enemy != m_hoveredEnemy) {
+      m_hoveredEnemy = hovered_enemy;
+      emit hoveredEnemyChanged();
+    }
   }
   if (m_renderer) {
     m_renderer->setLocalOwnerId(m_runtime.localOwnerId);
   }
-  m_renderer->renderWorld(m_world.get());
-  if (auto *arrow_system = m_world->getSystem<Game::Systems::ArrowSystem>()) {
+  m_renderer->renderWorld();
+  if (auto *arrow_system = m_arrowSystem) {
     if (auto *res = m_renderer->resources()) {
       Render::GL::renderArrows(m_renderer.get(), res, *arrow_system);
     }
+    if (auto *particles = m_renderer->particles()) {
+      const float now = m_renderer->getAnimationTime();
+      for (const auto &impact : arrow_system->impacts()) {
+        Render::GL::ParticleSystem::BurstDesc burst;
+        burst.count = 10;
+        burst.speed = 2.2F;
+        burst.life = 0.45F;
+        burst.size = 0.10F;
+        burst.velocityBias = QVector3D(0.0F, 0.8F, 0.0F);
+        burst.color = impact.color * 0.7F + QVector3D(0.25F, 0.22F, 0.18F);
+        particles->spawnBurst(impact.position, burst, now);
+      }
+      arrow_system->clearImpacts();
+    }
   }
 
   if (auto *res = m_renderer->resources()) {
@@ -678,6 +1153,10 @@ void GameEngine::render(int pixelWidth, int pixelHeight) {
   }
   m_renderer->endFrame();
 
+  if (m_benchmarkActive) {
+    m_benchmarkReport.addDrawCommands(m_renderer->lastDrawCommandCount());
+  }
+
   qreal const current_x = globalCursorX();
   qreal const current_y = globalCursorY();
   if (current_x != m_runtime.lastCursorX ||
@@ -703,7 +1182,7 @@ auto GameEngine::worldToScreen(const QVector3D &world,
 }
 
 void GameEngine::syncSelectionFlags() {
-  auto *selection_system = m_world->getSystem<Game::Systems::SelectionSystem>();
+  auto *selection_system = m_selectionSystem;
   if (!m_world || (selection_system == nullptr)) {
     return;
   }
@@ -801,6 +1280,9 @@ void GameEngine::cameraFollowSelection(bool enable) {
   }
 
   m_cameraService->followSelection(*m_camera, *m_world, enable);
+  if (m_renderer) {
+    m_renderer->setFollowSelection(enable);
+  }
 }
 
 void GameEngine::cameraSetFollowLerp(float alpha) {
@@ -858,7 +1340,7 @@ auto GameEngine::getSelectedProductionState() const -> QVariantMap {
   if (!m_world) {
     return m;
   }
-  auto *selection_system = m_world->getSystem<Game::Systems::SelectionSystem>();
+  auto *selection_system = m_selectionSystem;
   if (selection_system == nullptr) {
     return m;
   }
@@ -891,7 +1373,7 @@ auto GameEngine::getSelectedUnitsCommandMode() const -> QString {
   if (!m_world) {
     return "normal";
   }
-  auto *selection_system = m_world->getSystem<Game::Systems::SelectionSystem>();
+  auto *selection_system = m_selectionSystem;
   if (selection_system == nullptr) {
     return "normal";
   }
@@ -971,6 +1453,17 @@ void GameEngine::startSkirmish(const QString &map_path,
 
   clearError();
 
+  {
+    // A fresh battle invalidates any in-progress recording; playback that
+    // initiated this very restart is still pending and survives.
+    auto &replay = Game::Systems::ReplayService::instance();
+    replay.stopRecording();
+    if (!replay.isPlaybackPending()) {
+      replay.stopPlayback();
+    }
+  }
+  m_lastPlayerConfigs = playerConfigs;
+
   m_level.map_path = map_path;
   m_level.map_name = map_path;
 
@@ -990,17 +1483,31 @@ void GameEngine::startSkirmish(const QString &map_path,
     m_runtime.loading = true;
 
     if (m_hoverTracker) {
-      m_hoverTracker->updateHover(-1, -1, *m_world, *m_camera, 0, 0);
+      m_hoverTracker->clear();
+    }
+    m_renderer->clearPickCursor();
+    if (m_pickingService) {
+      m_pickingService->setResolvedPick(0, QPointF(), false);
+    }
+    if (m_minimapProvider != nullptr) {
+      m_minimapProvider->invalidate();
     }
 
     m_entityCache.reset();
 
-    Game::Map::SkirmishLoader loader(*m_world, *m_renderer, *m_camera);
+    if (m_skirmishLoader && m_skirmishLoader->isLoading()) {
+      return;
+    }
+
+    m_skirmishLoader = std::make_unique<Game::Map::SkirmishLoader>(
+        *m_world, *m_renderer, *m_camera);
+    auto &loader = *m_skirmishLoader;
     loader.setGroundRenderer(m_ground.get());
     loader.setTerrainRenderer(m_terrain.get());
     loader.setBiomeRenderer(m_biome.get());
     loader.setRiverRenderer(m_river.get());
     loader.setRiverbankRenderer(m_riverbank.get());
+    loader.setRiverbankAssetRenderer(m_riverbankAssets.get());
     loader.setBridgeRenderer(m_bridge.get());
     loader.setFogRenderer(m_fog.get());
     loader.setStoneRenderer(m_stone.get());
@@ -1016,9 +1523,39 @@ void GameEngine::startSkirmish(const QString &map_path,
       m_runtime.visibilityUpdateAccumulator = 0.0F;
     });
 
-    int updated_player_id = m_selectedPlayerId;
-    auto result = loader.start(map_path, playerConfigs, m_selectedPlayerId,
-                               updated_player_id);
+    loader.setProgressCallback([this](float progress, const QString &stage) {
+      m_loadingProgress = progress;
+      m_loadingStage = stage;
+      emit loadingProgressChanged();
+    });
+
+    m_levelLoading = true;
+    m_loadingProgress = 0.0;
+    m_loadingStage.clear();
+    emit loadingProgressChanged();
+
+    loader.startAsync(map_path, playerConfigs, m_selectedPlayerId,
+                      [this](const Game::Map::SkirmishLoadResult &result,
+                             int updated_player_id) {
+                        onSkirmishLoadFinished(result, updated_player_id);
+                      });
+  }
+}
+
+void GameEngine::onSkirmishLoadFinished(
+    const Game::Map::SkirmishLoadResult &result, int updated_player_id) {
+  {
+    m_levelLoading = false;
+    emit loadingProgressChanged();
+
+    if (m_saveLoadService) {
+      m_saveLoadService->resetAutosaveBaseline();
+    }
+
+    // Each battle gets its own tick stream so replay logs and checksum
+    // streams line up with a fresh load of the same map.
+    m_simTick = 0;
+    Game::Systems::ReplayService::instance().armPlayback();
 
     if (updated_player_id != m_selectedPlayerId) {
       m_selectedPlayerId = updated_player_id;
@@ -1057,14 +1594,26 @@ void GameEngine::startSkirmish(const QString &map_path,
     }
 
     m_runtime.loading = false;
+    // Loading frames are huge and would otherwise seed the rolling window
+    // with a shed cycle the first gameplay frames have to climb out of.
+    Engine::Core::FrameGovernor::instance().reset();
+
+    if (m_benchmarkSpawnPending && m_world) {
+      m_benchmarkSpawnPending = false;
+      m_benchmarkUnitsSpawned = Game::Systems::BenchmarkScenario::spawnArmies(
+          *m_world, m_benchmarkUnitsPerSide);
+      m_benchmarkActive = true;
+      qInfo() << "Benchmark: spawned" << m_benchmarkUnitsSpawned << "of"
+              << m_benchmarkUnitsPerSide * 2 << "requested units";
+    }
 
-    if (auto *ai_system = m_world->getSystem<Game::Systems::AISystem>()) {
+    if (auto *ai_system = m_aiSystem) {
       ai_system->reinitialize();
     }
 
-    rebuildEntityCache();
     auto &troops = Game::Systems::TroopCountRegistry::instance();
     troops.rebuildFromWorld(*m_world);
+    rebuildEntityCache();
 
     auto &stats_registry = Game::Systems::GlobalStatsRegistry::instance();
     stats_registry.rebuildFromWorld(*m_world);
@@ -1145,7 +1694,7 @@ auto GameEngine::loadFromSlot(const QString &slot) -> bool {
   rebuildRegistriesAfterLoad();
   rebuildEntityCache();
 
-  if (auto *ai_system = m_world->getSystem<Game::Systems::AISystem>()) {
+  if (auto *ai_system = m_aiSystem) {
     qInfo() << "Reinitializing AI system after loading saved game";
     ai_system->reinitialize();
   }
@@ -1182,6 +1731,27 @@ auto GameEngine::saveToSlot(const QString &slot, const QString &title) -> bool {
   return true;
 }
 
+void GameEngine::autosave() {
+  if (!m_saveLoadService || !m_world || m_runtime.loading || m_levelLoading ||
+      m_runtime.paused || m_level.map_path.isEmpty() ||
+      !m_runtime.victoryState.isEmpty()) {
+    return;
+  }
+
+  // Capture the world snapshot and metadata on the game thread; the SQLite
+  // write happens on a background thread so the frame never blocks on disk.
+  // No screenshot: the GL readback would cost more than the snapshot itself.
+  Game::Systems::RuntimeSnapshot const runtime_snap = toRuntimeSnapshot();
+  QJsonObject meta = Game::Systems::GameStateSerializer::buildMetadata(
+      *m_world, m_camera.get(), m_level, runtime_snap);
+  const QString title = QStringLiteral("Autosave");
+  meta["title"] = title;
+
+  m_saveLoadService->saveAutosaveAsync(*m_world,
+                                       QString::fromLatin1(k_autosave_slot),
+                                       title, m_level.map_name, meta);
+}
+
 auto GameEngine::getSaveSlots() const -> QVariantList {
   if (!m_saveLoadService) {
     qWarning() << "Cannot get save slots: service not initialized";
@@ -1218,6 +1788,19 @@ void GameEngine::exitGame() {
   }
 }
 
+void GameEngine::setWaterQuality(const QString &quality) {
+  if (!m_river) {
+    return;
+  }
+  auto tier = Render::GL::WaterQuality::High;
+  if (quality.compare(QStringLiteral("medium"), Qt::CaseInsensitive) == 0) {
+    tier = Render::GL::WaterQuality::Medium;
+  } else if (quality.compare(QStringLiteral("low"), Qt::CaseInsensitive) == 0) {
+    tier = Render::GL::WaterQuality::Low;
+  }
+  m_river->setQuality(tier);
+}
+
 auto GameEngine::getOwnerInfo() const -> QVariantList {
   QVariantList result;
   const auto &owner_registry = Game::Systems::OwnerRegistry::instance();
@@ -1290,11 +1873,6 @@ void GameEngine::onUnitSpawned(const Engine::Core::UnitSpawnedEvent &event) {
   if (event.owner_id == m_runtime.localOwnerId) {
     if (event.spawn_type == Game::Units::SpawnType::Barracks) {
       m_entityCache.playerBarracksAlive = true;
-    } else {
-      int const individuals_per_unit =
-          Game::Units::TroopConfig::instance().getIndividualsPerUnit(
-              event.spawn_type);
-      m_entityCache.playerTroopCount += individuals_per_unit;
     }
   } else if (owners.isAI(event.owner_id)) {
     if (event.spawn_type == Game::Units::SpawnType::Barracks) {
@@ -1303,6 +1881,13 @@ void GameEngine::onUnitSpawned(const Engine::Core::UnitSpawnedEvent &event) {
     }
   }
 
+  // The troop count registry subscribes earlier in the constructor, so
+  // its handler has already applied this event; read it back instead of
+  // repeating the headcount arithmetic here.
+  m_entityCache.playerTroopCount =
+      Game::Systems::TroopCountRegistry::instance().getTroopCount(
+          m_runtime.localOwnerId);
+
   auto emit_if_changed = [&] {
     if (m_entityCache.playerTroopCount != m_runtime.lastTroopCount) {
       m_runtime.lastTroopCount = m_entityCache.playerTroopCount;
@@ -1318,13 +1903,6 @@ void GameEngine::onUnitDied(const Engine::Core::UnitDiedEvent &event) {
   if (event.owner_id == m_runtime.localOwnerId) {
     if (event.spawn_type == Game::Units::SpawnType::Barracks) {
       m_entityCache.playerBarracksAlive = false;
-    } else {
-      int const individuals_per_unit =
-          Game::Units::TroopConfig::instance().getIndividualsPerUnit(
-              event.spawn_type);
-      m_entityCache.playerTroopCount -= individuals_per_unit;
-      m_entityCache.playerTroopCount =
-          std::max(0, m_entityCache.playerTroopCount);
     }
   } else if (owners.isAI(event.owner_id)) {
     if (event.spawn_type == Game::Units::SpawnType::Barracks) {
@@ -1335,6 +1913,10 @@ void GameEngine::onUnitDied(const Engine::Core::UnitDiedEvent &event) {
     }
   }
 
+  m_entityCache.playerTroopCount =
+      Game::Systems::TroopCountRegistry::instance().getTroopCount(
+          m_runtime.localOwnerId);
+
   syncSelectionFlags();
 
   auto emit_if_changed = [&] {
@@ -1365,11 +1947,6 @@ void GameEngine::rebuildEntityCache() {
     if (unit->owner_id == m_runtime.localOwnerId) {
       if (unit->spawn_type == Game::Units::SpawnType::Barracks) {
         m_entityCache.playerBarracksAlive = true;
-      } else {
-        int const individuals_per_unit =
-            Game::Units::TroopConfig::instance().getIndividualsPerUnit(
-                unit->spawn_type);
-        m_entityCache.playerTroopCount += individuals_per_unit;
       }
     } else if (owners.isAI(unit->owner_id)) {
       if (unit->spawn_type == Game::Units::SpawnType::Barracks) {
@@ -1379,6 +1956,12 @@ void GameEngine::rebuildEntityCache() {
     }
   }
 
+  // Headcount comes from the incremental registry; callers rebuild it
+  // before this cache when the world has been replaced wholesale.
+  m_entityCache.playerTroopCount =
+      Game::Systems::TroopCountRegistry::instance().getTroopCount(
+          m_runtime.localOwnerId);
+
   auto emit_if_changed = [&] {
     if (m_entityCache.playerTroopCount != m_runtime.lastTroopCount) {
       m_runtime.lastTroopCount = m_entityCache.playerTroopCount;
@@ -1488,6 +2071,9 @@ void GameEngine::applyRuntimeSnapshot(
       m_cameraService->followSelection(*m_camera, *m_world,
                                        m_followSelectionEnabled);
     }
+    if (m_renderer) {
+      m_renderer->setFollowSelection(m_followSelectionEnabled);
+    }
   }
 }
 
@@ -1539,7 +2125,7 @@ void GameEngine::restoreEnvironmentFromMetadata(const QJsonObject &metadata) {
 
   if (!terrain_already_restored && !map_path.isEmpty()) {
     loaded_definition =
-        Game::Map::MapLoader::loadFromJsonFile(map_path, def, &map_error);
+        Game::Map::MapLoader::loadFromFile(map_path, def, &map_error);
     if (!loaded_definition) {
       qWarning() << "GameEngine: Failed to load map definition from" << map_path
                  << "during save load:" << map_error;
@@ -1591,6 +2177,11 @@ void GameEngine::restoreEnvironmentFromMetadata(const QJsonObject &metadata) {
       if (m_riverbank) {
         m_riverbank->configure(height_map->getRiverSegments(), *height_map);
       }
+      if (m_riverbankAssets) {
+        m_riverbankAssets->configure(height_map->getRiverSegments(),
+                                     *height_map,
+                                     terrain_service.biomeSettings());
+      }
       if (m_bridge) {
         m_bridge->configure(height_map->getBridges(),
                             height_map->getTileSize());
@@ -1614,6 +2205,8 @@ void GameEngine::restoreEnvironmentFromMetadata(const QJsonObject &metadata) {
     }
 
     Game::Systems::CommandService::initialize(grid_width, grid_height);
+    Game::Systems::ProductionService::resetScheduler();
+    Game::Systems::ProductionService::rescheduleAll(*m_world);
 
     auto &visibility_service = Game::Map::VisibilityService::instance();
     visibility_service.initialize(grid_width, grid_height, tile_size);
@@ -1646,6 +2239,8 @@ void GameEngine::restoreEnvironmentFromMetadata(const QJsonObject &metadata) {
 
     Game::Systems::CommandService::initialize(fallback_grid_width,
                                               fallback_grid_height);
+    Game::Systems::ProductionService::resetScheduler();
+    Game::Systems::ProductionService::rescheduleAll(*m_world);
 
     auto &visibility_service = Game::Map::VisibilityService::instance();
     visibility_service.initialize(fallback_grid_width, fallback_grid_height,
@@ -1778,6 +2373,15 @@ void GameEngine::loadAudioResources() {
     return;
   }
 
+  int const manifest_count =
+      audio_sys.loadSoundManifest((base_path + "manifest.json").toStdString());
+  if (manifest_count > 0) {
+    qInfo() << "Loaded" << manifest_count << "audio resources from manifest";
+    return;
+  }
+  qWarning() << "Audio manifest missing or empty, falling back to built-in "
+                "resource list";
+
   if (audio_sys.loadSound("archer_voice",
                           (base_path + "voices/archer_voice.wav").toStdString(),
                           AudioCategory::VOICE)) {
@@ -8,7 +8,10 @@
 #include "../utils/selection_utils.h"
 #include "game/audio/AudioEventHandler.h"
 #include "game/core/event_manager.h"
+#include "game/systems/benchmark_scenario.h"
 #include "game/systems/game_state_serializer.h"
+#include "render/pass_graph.h"
+#include <QElapsedTimer>
 #include <QJsonObject>
 #include <QList>
 #include <QMatrix4x4>
@@ -39,6 +42,7 @@ class TerrainRenderer;
 class BiomeRenderer;
 class RiverRenderer;
 class RiverbankRenderer;
+class RiverbankAssetRenderer;
 class BridgeRenderer;
 class FogRenderer;
 class StoneRenderer;
@@ -53,6 +57,7 @@ namespace Systems {
 class SelectionSystem;
 class SelectionController;
 class ArrowSystem;
+class AISystem;
 class PickingService;
 class VictoryService;
 class CameraService;
@@ -60,7 +65,9 @@ class SaveLoadService;
 } // namespace Systems
 namespace Map {
 class MapCatalog;
-}
+class SkirmishLoader;
+struct SkirmishLoadResult;
+} // namespace Map
 } // namespace Game
 
 namespace App {
@@ -73,6 +80,8 @@ class AudioSystemProxy;
 } // namespace App
 
 class QQuickWindow;
+class QTimer;
+class MinimapProvider;
 
 class GameEngine : public QObject {
   Q_OBJECT
@@ -91,6 +100,7 @@ public:
   Q_PROPERTY(qreal globalCursorY READ globalCursorY NOTIFY globalCursorChanged)
   Q_PROPERTY(
       bool hasUnitsSelected READ hasUnitsSelected NOTIFY selectedUnitsChanged)
+  Q_PROPERTY(bool hoveredEnemy READ hoveredEnemy NOTIFY hoveredEnemyChanged)
   Q_PROPERTY(
       int playerTroopCount READ playerTroopCount NOTIFY troop_countChanged)
   Q_PROPERTY(int max_troops_per_player READ max_troops_per_player NOTIFY
@@ -98,6 +108,16 @@ public:
   Q_PROPERTY(
       QVariantList availableMaps READ availableMaps NOTIFY availableMapsChanged)
   Q_PROPERTY(bool mapsLoading READ mapsLoading NOTIFY mapsLoadingChanged)
+  Q_PROPERTY(bool levelLoading READ levelLoading NOTIFY loadingProgressChanged)
+  Q_PROPERTY(
+      qreal loadingProgress READ loadingProgress NOTIFY loadingProgressChanged)
+  Q_PROPERTY(
+      QString loadingStage READ loadingStage NOTIFY loadingProgressChanged)
+  Q_PROPERTY(bool deterministicMode READ deterministicMode WRITE
+                 setDeterministicMode NOTIFY deterministicModeChanged)
+  Q_PROPERTY(QString tickChecksum READ tickChecksum NOTIFY tickChecksumChanged)
+  Q_PROPERTY(bool profilerEnabled READ profilerEnabled WRITE setProfilerEnabled
+                 NOTIFY profilerEnabledChanged)
   Q_PROPERTY(int enemyTroopsDefeated READ enemyTroopsDefeated NOTIFY
                  enemyTroopsDefeatedChanged)
   Q_PROPERTY(QVariantList ownerInfo READ getOwnerInfo NOTIFY ownerInfoChanged)
@@ -105,6 +125,7 @@ public:
                  setSelectedPlayerId NOTIFY selectedPlayerIdChanged)
   Q_PROPERTY(QString lastError READ lastError NOTIFY lastErrorChanged)
   Q_PROPERTY(QObject *audio_system READ audio_system CONSTANT)
+  Q_PROPERTY(int minimapVersion READ minimapVersion NOTIFY minimapVersionChanged)
 
   Q_INVOKABLE void onMapClicked(qreal sx, qreal sy);
   Q_INVOKABLE void onRightClick(qreal sx, qreal sy);
@@ -140,12 +161,60 @@ public:
   [[nodiscard]] auto victoryState() const -> QString {
     return m_runtime.victoryState;
   }
+  // Determinism mode: fixed-seed RNG and a per-tick quantized world
+  // checksum, for diffing scripted runs across machines. System ordering is
+  // already replay-deterministic; this adds the seed and the digest stream.
+  Q_INVOKABLE void setDeterministicMode(bool enabled);
+  Q_INVOKABLE void setSimSeed(int seed);
+  [[nodiscard]] auto deterministicMode() const -> bool {
+    return m_deterministicMode;
+  }
+  [[nodiscard]] auto tickChecksum() const -> QString;
+
+  // Replay: every command is logged with its sim tick and can be re-fed
+  // into a fresh world. Start recording right after a skirmish loads so
+  // the log reproduces from the initial state; playback restarts the
+  // recorded map, players, and seed itself. A replayed battle doubles as
+  // a fixed benchmarking workload.
+  Q_INVOKABLE bool startReplayRecording(const QString &path);
+  Q_INVOKABLE void stopReplayRecording();
+  Q_INVOKABLE bool startReplayPlayback(const QString &path);
+  Q_INVOKABLE void stopReplayPlayback();
+
+  // Profiler HUD: toggled with F10. Snapshots are pulled by the overlay on
+  // a timer rather than pushed per frame, so an open overlay costs one
+  // QVariant conversion every refresh, not every frame.
+  [[nodiscard]] auto profilerEnabled() const -> bool;
+  void setProfilerEnabled(bool enabled);
+  Q_INVOKABLE [[nodiscard]] QVariantMap profilerSnapshot() const;
+  // Dumps the profiler's retained frame window as Chrome trace-event JSON
+  // under AppData/traces and returns the file path (empty on failure).
+  // Zone recording runs from startup as a flight recorder, and any frame
+  // exceeding the configured multiple of the rolling median frame time
+  // (or the absolute threshold in ms, if one is set; 0 disables either
+  // trigger) exports automatically, rate-limited so a sustained stall
+  // produces one trace rather than one per frame.
+  Q_INVOKABLE QString exportProfilerTrace();
+  Q_INVOKABLE void setProfilerSpikeThreshold(double ms);
+  Q_INVOKABLE void setProfilerSpikeMultiplier(double multiplier);
+
+  // Benchmark mode: loads a fixed map with two AI armies of
+  // `unitsPerSide` mixed troops each and lets them fight. Frame, sim-tick
+  // and draw-command samples are collected for a fixed frame budget, then
+  // a single-line JSON report is printed to the log. Launched from the
+  // command line with --benchmark=<units-per-side>.
+  Q_INVOKABLE void startBenchmark(int unitsPerSide);
+  Q_INVOKABLE [[nodiscard]] bool benchmarkRequested() const {
+    return m_benchmarkLaunchPending;
+  }
+
   [[nodiscard]] auto cursorMode() const -> QString;
   void setCursorMode(CursorMode mode);
   void setCursorMode(const QString &mode);
   [[nodiscard]] auto globalCursorX() const -> qreal;
   [[nodiscard]] auto globalCursorY() const -> qreal;
   [[nodiscard]] auto hasUnitsSelected() const -> bool;
+  [[nodiscard]] auto hoveredEnemy() const -> bool { return m_hoveredEnemy; }
   [[nodiscard]] auto playerTroopCount() const -> int;
   [[nodiscard]] auto max_troops_per_player() const -> int {
     return m_level.max_troops_per_player;
@@ -180,6 +249,11 @@ public:
   Q_INVOKABLE void setRallyAtScreen(qreal sx, qreal sy);
   Q_INVOKABLE [[nodiscard]] QVariantList availableMaps() const;
   [[nodiscard]] auto mapsLoading() const -> bool { return m_mapsLoading; }
+  [[nodiscard]] auto levelLoading() const -> bool { return m_levelLoading; }
+  [[nodiscard]] auto loadingProgress() const -> qreal {
+    return m_loadingProgress;
+  }
+  [[nodiscard]] auto loadingStage() const -> QString { return m_loadingStage; }
   Q_INVOKABLE void
   startSkirmish(const QString &map_path,
                 const QVariantList &playerConfigs = QVariantList());
@@ -192,11 +266,19 @@ public:
   Q_INVOKABLE void refreshSaveSlots();
   Q_INVOKABLE bool deleteSaveSlot(const QString &slotName);
   Q_INVOKABLE void exitGame();
+  Q_INVOKABLE void setWaterQuality(const QString &quality);
   Q_INVOKABLE [[nodiscard]] QVariantList getOwnerInfo() const;
 
   auto audio_system() -> QObject *;
 
-  void setWindow(QQuickWindow *w) { m_window = w; }
+  void setWindow(QQuickWindow *w);
+
+  // The QML engine owns the provider; we only hold it to drive refreshes
+  // from the game tick.
+  void setMinimapProvider(MinimapProvider *provider) {
+    m_minimapProvider = provider;
+  }
+  [[nodiscard]] auto minimapVersion() const -> int { return m_minimapVersion; }
 
   void ensureInitialized();
   void update(float dt);
@@ -211,6 +293,11 @@ public:
   [[nodiscard]] auto getPatrolPreviewWaypoint() const -> QVector3D;
 
 private:
+  // Simulation runs on a fixed 30 Hz timestep decoupled from the render
+  // cadence; kMaxFrameDt bounds catch-up work after a long stall.
+  static constexpr float kSimTickDt = 1.0F / 30.0F;
+  static constexpr float kMaxFrameDt = 0.25F;
+
   struct RuntimeState {
     bool initialized = false;
     bool paused = false;
@@ -224,6 +311,9 @@ private:
     int lastTroopCount = 0;
     std::uint64_t visibilityVersion = 0;
     float visibilityUpdateAccumulator = 0.0F;
+    float tuningPollAccumulator = 0.0F;
+    float simAccumulator = 0.0F;
+    qint64 lastFrameNs = -1;
     qreal lastCursorX = -1.0;
     qreal lastCursorY = -1.0;
     int selectionRefreshCounter = 0;
@@ -261,6 +351,7 @@ private:
   void setError(const QString &errorMessage);
   auto loadFromSlot(const QString &slot) -> bool;
   auto saveToSlot(const QString &slot, const QString &title) -> bool;
+  void autosave();
   [[nodiscard]] auto
   toRuntimeSnapshot() const -> Game::Systems::RuntimeSnapshot;
   void applyRuntimeSnapshot(const Game::Systems::RuntimeSnapshot &snapshot);
@@ -275,18 +366,27 @@ private:
   std::unique_ptr<Render::GL::BiomeRenderer> m_biome;
   std::unique_ptr<Render::GL::RiverRenderer> m_river;
   std::unique_ptr<Render::GL::RiverbankRenderer> m_riverbank;
+  std::unique_ptr<Render::GL::RiverbankAssetRenderer> m_riverbankAssets;
   std::unique_ptr<Render::GL::BridgeRenderer> m_bridge;
   std::unique_ptr<Render::GL::FogRenderer> m_fog;
   std::unique_ptr<Render::GL::StoneRenderer> m_stone;
   std::unique_ptr<Render::GL::PlantRenderer> m_plant;
   std::unique_ptr<Render::GL::PineRenderer> m_pine;
   std::unique_ptr<Render::GL::FireCampRenderer> m_firecamp;
-  std::vector<Render::GL::IRenderPass *> m_passes;
+  Render::GL::PassGraph m_passGraph;
+  // Cached at bootstrap; owned by the world, valid for its lifetime.
+  Game::Systems::ArrowSystem *m_arrowSystem = nullptr;
+  Game::Systems::SelectionSystem *m_selectionSystem = nullptr;
+  Game::Systems::AISystem *m_aiSystem = nullptr;
   std::unique_ptr<Game::Systems::PickingService> m_pickingService;
   std::unique_ptr<Game::Systems::VictoryService> m_victoryService;
   std::unique_ptr<Game::Systems::SaveLoadService> m_saveLoadService;
   std::unique_ptr<CursorManager> m_cursorManager;
   std::unique_ptr<HoverTracker> m_hoverTracker;
+  // Cached relation of the hovered entity to the local player, refreshed
+  // once per frame from the async hover resolve; QML binds it for the
+  // attack-context cursor without ever touching the world.
+  bool m_hoveredEnemy = false;
   std::unique_ptr<Game::Systems::CameraService> m_cameraService;
   std::unique_ptr<Game::Systems::SelectionController> m_selectionController;
   std::unique_ptr<App::Controllers::CommandController> m_commandController;
@@ -294,15 +394,40 @@ private:
   std::unique_ptr<Game::Audio::AudioEventHandler> m_audioEventHandler;
   std::unique_ptr<App::Models::AudioSystemProxy> m_audio_systemProxy;
   QQuickWindow *m_window = nullptr;
+  QTimer *m_autosaveTimer = nullptr;
+  MinimapProvider *m_minimapProvider = nullptr;
+  int m_minimapVersion = 0;
   RuntimeState m_runtime;
+  QElapsedTimer m_frameTimer;
   ViewportState m_viewport;
   bool m_followSelectionEnabled = false;
   Game::Systems::LevelSnapshot m_level;
+  // Skirmish setup of the current battle, kept for the replay file header.
+  QVariantList m_lastPlayerConfigs;
   QObject *m_selectedUnitsModel = nullptr;
   int m_enemyTroopsDefeated = 0;
   int m_selectedPlayerId = 1;
+  bool m_deterministicMode = false;
+  std::uint64_t m_simTick = 0;
+  quint32 m_lastTickChecksum = 0;
+  double m_profilerSpikeThresholdMs = 0.0;
+  // Default spike trigger: a frame eight times the rolling median is a
+  // stutter on any machine.
+  double m_profilerSpikeMultiplier = 8.0;
+  bool m_profilerHudVisible = false;
+  qint64 m_lastSpikeExportMs = 0;
+  Game::Systems::BenchmarkReport m_benchmarkReport;
+  int m_benchmarkUnitsPerSide = 0;
+  int m_benchmarkUnitsSpawned = 0;
+  bool m_benchmarkLaunchPending = false;
+  bool m_benchmarkSpawnPending = false;
+  bool m_benchmarkActive = false;
   QVariantList m_availableMaps;
   bool m_mapsLoading = false;
+  std::unique_ptr<Game::Map::SkirmishLoader> m_skirmishLoader;
+  bool m_levelLoading = false;
+  qreal m_loadingProgress = 0.0;
+  QString m_loadingStage;
   Engine::Core::ScopedEventSubscription<Engine::Core::UnitDiedEvent>
       m_unitDiedSubscription;
   Engine::Core::ScopedEventSubscription<Engine::Core::UnitSpawnedEvent>
@@ -315,6 +440,8 @@ private:
   void updateAmbientState(float dt);
   [[nodiscard]] auto isPlayerInCombat() const -> bool;
   static void loadAudioResources();
+  void onSkirmishLoadFinished(const Game::Map::SkirmishLoadResult &result,
+                              int updated_player_id);
 signals:
   void selectedUnitsChanged();
   void selectedUnitsDataChanged();
@@ -322,11 +449,17 @@ signals:
   void victoryStateChanged();
   void cursorModeChanged();
   void globalCursorChanged();
+  void hoveredEnemyChanged();
   void troop_countChanged();
   void availableMapsChanged();
   void ownerInfoChanged();
   void selectedPlayerIdChanged();
   void lastErrorChanged();
   void mapsLoadingChanged();
+  void loadingProgressChanged();
   void saveSlotsChanged();
+  void minimapVersionChanged();
+  void deterministicModeChanged();
+  void tickChecksumChanged();
+  void profilerEnabledChanged();
 };
@@ -46,6 +46,17 @@ void LanguageManager::setLanguage(const QString &language) {
 void LanguageManager::loadLanguage(const QString &language) {
   QCoreApplication::removeTranslator(m_translator);
 
+  // The source language needs no catalog: lookups fall through to the
+  // untranslated strings, so a default-locale startup parses nothing.
+  // Other locales load on demand at switch time; only the active
+  // catalog is ever installed, and QTranslator maps resource-backed .qm
+  // data in place rather than copying the string table.
+  if (language == QStringLiteral("en")) {
+    m_currentLanguage = language;
+    emit languageChanged();
+    return;
+  }
+
   QString const qm_file =
       QString(":/StandardOfIron/translations/app_%1.qm").arg(language);
 
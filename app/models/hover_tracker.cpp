@@ -6,21 +6,36 @@
 HoverTracker::HoverTracker(Game::Systems::PickingService *pickingService)
     : m_pickingService(pickingService) {}
 
-auto HoverTracker::updateHover(float sx, float sy, Engine::Core::World &world,
-                               const Render::GL::Camera &camera,
-                               int viewportWidth,
-                               int viewportHeight) -> Engine::Core::EntityID {
-  if (m_pickingService == nullptr) {
-    return 0;
+void HoverTracker::setCursor(float sx, float sy) {
+  m_cursorX = sx;
+  m_cursorY = sy;
+  m_pending = true;
+}
+
+void HoverTracker::clear() {
+  m_cursorX = -1.0F;
+  m_cursorY = -1.0F;
+  m_pending = false;
+  m_hoveredEntityId = 0;
+}
+
+auto HoverTracker::resolvePending(Engine::Core::World &world,
+                                  const Render::GL::Camera &camera,
+                                  int viewportWidth,
+                                  int viewportHeight) -> Engine::Core::EntityID {
+  if (!m_pending || m_pickingService == nullptr) {
+    return m_hoveredEntityId;
   }
+  m_pending = false;
 
-  if (sx < 0 || sy < 0 || sx >= viewportWidth || sy >= viewportHeight) {
+  if (m_cursorX < 0 || m_cursorY < 0 || m_cursorX >= viewportWidth ||
+      m_cursorY >= viewportHeight) {
     m_hoveredEntityId = 0;
     return 0;
   }
 
   m_hoveredEntityId = m_pickingService->updateHover(
-      sx, sy, world, camera, viewportWidth, viewportHeight);
+      m_cursorX, m_cursorY, world, camera, viewportWidth, viewportHeight);
 
   return m_hoveredEntityId;
 }
@@ -12,19 +12,34 @@ namespace Render::GL {
 class Camera;
 }
 
+// Defers hover picking off the mouse-move path: moves only record the
+// cursor, and resolvePending() runs at most one pick per rendered frame
+// against the previous frame's ID-buffer result (entity scan as
+// fallback). Hover therefore lands a frame late, which is imperceptible;
+// a pick per mouse-move event was not.
 class HoverTracker {
 public:
   HoverTracker(Game::Systems::PickingService *pickingService);
 
-  auto updateHover(float sx, float sy, Engine::Core::World &world,
-                   const Render::GL::Camera &camera, int viewportWidth,
-                   int viewportHeight) -> Engine::Core::EntityID;
+  // Cheap enough for every mouse-move event; no picking happens here.
+  void setCursor(float sx, float sy);
+  void clear();
+
+  // Resolves the most recent cursor sample; call once per frame.
+  auto resolvePending(Engine::Core::World &world,
+                      const Render::GL::Camera &camera, int viewportWidth,
+                      int viewportHeight) -> Engine::Core::EntityID;
 
   [[nodiscard]] auto getLastHoveredEntity() const -> Engine::Core::EntityID {
     return m_hoveredEntityId;
   }
+  [[nodiscard]] auto cursorX() const -> float { return m_cursorX; }
+  [[nodiscard]] auto cursorY() const -> float { return m_cursorY; }
 
 private:
   Game::Systems::PickingService *m_pickingService;
   Engine::Core::EntityID m_hoveredEntityId = 0;
+  float m_cursorX = -1.0F;
+  float m_cursorY = -1.0F;
+  bool m_pending = false;
 };
@@ -0,0 +1,296 @@
+#include "minimap_provider.h"
+#include "game/core/component.h"
+#include "game/core/world.h"
+#include "game/map/terrain_service.h"
+#include "game/map/visibility_service.h"
+#include "game/visuals/team_colors.h"
+#include <QMutexLocker>
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace {
+constexpr int k_minimap_size = 256;
+constexpr qint64 k_refresh_interval_ms = 100; // ~10 Hz
+constexpr int k_dot_radius = 2;
+// Fog deltas are coalesced to square chunks of this many visibility cells
+// before any pixels are re-shaded.
+constexpr int k_fog_chunk_cells = 16;
+
+// Fog multipliers applied over the terrain base layer.
+constexpr float k_unseen_shade = 0.18F;
+constexpr float k_explored_shade = 0.55F;
+
+auto terrainColor(Game::Map::TerrainType type, bool walkable) -> QRgb {
+  switch (type) {
+  case Game::Map::TerrainType::River:
+    return qRgb(52, 86, 128);
+  case Game::Map::TerrainType::Mountain:
+    return qRgb(108, 104, 96);
+  case Game::Map::TerrainType::Hill:
+    return qRgb(96, 112, 58);
+  case Game::Map::TerrainType::Flat:
+    break;
+  }
+  return walkable ? qRgb(74, 96, 50) : qRgb(60, 70, 44);
+}
+
+auto shaded(QRgb base, float factor) -> QRgb {
+  return qRgb(static_cast<int>(static_cast<float>(qRed(base)) * factor),
+              static_cast<int>(static_cast<float>(qGreen(base)) * factor),
+              static_cast<int>(static_cast<float>(qBlue(base)) * factor));
+}
+
+} // namespace
+
+MinimapProvider::MinimapProvider()
+    : QQuickImageProvider(QQuickImageProvider::Image) {
+  m_clock.start();
+}
+
+auto MinimapProvider::requestImage(const QString & /*id*/, QSize *size,
+                                   const QSize &requestedSize) -> QImage {
+  QMutexLocker const lock(&m_mutex);
+  QImage result = m_image;
+  if (result.isNull()) {
+    result = QImage(k_minimap_size, k_minimap_size, QImage::Format_RGB32);
+    result.fill(Qt::black);
+  }
+  if (size != nullptr) {
+    *size = result.size();
+  }
+  if (requestedSize.isValid() && requestedSize != result.size()) {
+    result = result.scaled(requestedSize, Qt::KeepAspectRatio,
+                           Qt::FastTransformation);
+  }
+  return result;
+}
+
+void MinimapProvider::invalidate() {
+  QMutexLocker const lock(&m_mutex);
+  m_terrainLayer = QImage();
+  m_fogLayer = QImage();
+  m_cells.clear();
+  m_cellsVersion = 0;
+  m_chunkDirty.clear();
+  m_lastRefreshMs = -1;
+}
+
+auto MinimapProvider::maybeRefresh(Engine::Core::World &world,
+                                   int localOwnerId) -> bool {
+  qint64 const now_ms = m_clock.elapsed();
+  if (m_lastRefreshMs >= 0 && now_ms - m_lastRefreshMs < k_refresh_interval_ms) {
+    return false;
+  }
+  m_lastRefreshMs = now_ms;
+
+  if (m_terrainLayer.isNull()) {
+    rebuildTerrainLayer();
+    if (m_terrainLayer.isNull()) {
+      return false;
+    }
+  }
+  compose(world, localOwnerId);
+  return true;
+}
+
+void MinimapProvider::rebuildTerrainLayer() {
+  auto &terrain = Game::Map::TerrainService::instance();
+  if (!terrain.isInitialized()) {
+    return;
+  }
+  const auto *height_map = terrain.getHeightMap();
+  int const grid_w = height_map->getWidth();
+  int const grid_h = height_map->getHeight();
+  if (grid_w <= 0 || grid_h <= 0) {
+    return;
+  }
+
+  QImage layer(k_minimap_size, k_minimap_size, QImage::Format_RGB32);
+  for (int py = 0; py < k_minimap_size; ++py) {
+    auto *scanline = reinterpret_cast<QRgb *>(layer.scanLine(py));
+    int const gz = py * grid_h / k_minimap_size;
+    for (int px = 0; px < k_minimap_size; ++px) {
+      int const gx = px * grid_w / k_minimap_size;
+      scanline[px] = terrainColor(terrain.getTerrainType(gx, gz),
+                                  terrain.isWalkable(gx, gz));
+    }
+  }
+  m_terrainLayer = layer;
+}
+
+void MinimapProvider::shadePixelRect(int px0, int px1, int py0, int py1,
+                                     int grid_w, int grid_h) {
+  for (int py = py0; py < py1; ++py) {
+    auto *dst = reinterpret_cast<QRgb *>(m_fogLayer.scanLine(py));
+    const auto *src =
+        reinterpret_cast<const QRgb *>(m_terrainLayer.constScanLine(py));
+    int const gz = py * grid_h / k_minimap_size;
+    for (int px = px0; px < px1; ++px) {
+      int const gx = px * grid_w / k_minimap_size;
+      switch (static_cast<Game::Map::VisibilityState>(
+          m_cells[gz * grid_w + gx])) {
+      case Game::Map::VisibilityState::Unseen:
+        dst[px] = shaded(src[px], k_unseen_shade);
+        break;
+      case Game::Map::VisibilityState::Explored:
+        dst[px] = shaded(src[px], k_explored_shade);
+        break;
+      case Game::Map::VisibilityState::Visible:
+        dst[px] = src[px];
+        break;
+      }
+    }
+  }
+}
+
+void MinimapProvider::refreshFogLayer(int grid_w, int grid_h) {
+  auto &visibility = Game::Map::VisibilityService::instance();
+  const auto current_version = visibility.version();
+
+  bool full_rebuild =
+      m_fogLayer.isNull() ||
+      m_cells.size() != static_cast<std::size_t>(grid_w) *
+                            static_cast<std::size_t>(grid_h);
+  std::vector<std::pair<int, int>> runs;
+  if (!full_rebuild) {
+    if (current_version == m_cellsVersion) {
+      return;
+    }
+    int first_changed = -1;
+    int last_changed = -1;
+    if (!visibility.applyChangesSince(m_cellsVersion, m_cells, first_changed,
+                                      last_changed, &runs)) {
+      // Fell out of the delta window (long pause, map reset); resync.
+      full_rebuild = true;
+    }
+  }
+
+  if (full_rebuild) {
+    m_cells = visibility.snapshotCells();
+    m_chunksX = (grid_w + k_fog_chunk_cells - 1) / k_fog_chunk_cells;
+    m_chunksZ = (grid_h + k_fog_chunk_cells - 1) / k_fog_chunk_cells;
+    m_chunkDirty.assign(
+        static_cast<std::size_t>(m_chunksX) * m_chunksZ, 0);
+    m_fogLayer = m_terrainLayer.copy();
+    if (m_cells.size() == static_cast<std::size_t>(grid_w) *
+                              static_cast<std::size_t>(grid_h)) {
+      shadePixelRect(0, k_minimap_size, 0, k_minimap_size, grid_w, grid_h);
+    }
+    m_cellsVersion = current_version;
+    return;
+  }
+
+  m_cellsVersion = current_version;
+  if (runs.empty()) {
+    return;
+  }
+
+  // Coalesce the changed cell runs into chunk dirty bits; a reveal wave
+  // touching thousands of cells collapses to the few chunks it crossed.
+  for (const auto &[start, count] : runs) {
+    int idx = start;
+    int remaining = count;
+    while (remaining > 0) {
+      int const z = idx / grid_w;
+      int const x = idx % grid_w;
+      int const row_count = std::min(remaining, grid_w - x);
+      int const cz = z / k_fog_chunk_cells;
+      int const cx1 = (x + row_count - 1) / k_fog_chunk_cells;
+      for (int cx = x / k_fog_chunk_cells; cx <= cx1; ++cx) {
+        m_chunkDirty[static_cast<std::size_t>(cz) * m_chunksX + cx] = 1;
+      }
+      idx += row_count;
+      remaining -= row_count;
+    }
+  }
+
+  // Re-shade only the pixel regions the dirty chunks map to. px covers
+  // grid column px * grid_w / size, so the first pixel inside a chunk is
+  // the ceiling of the inverse mapping.
+  for (int cz = 0; cz < m_chunksZ; ++cz) {
+    for (int cx = 0; cx < m_chunksX; ++cx) {
+      auto &dirty =
+          m_chunkDirty[static_cast<std::size_t>(cz) * m_chunksX + cx];
+      if (dirty == 0) {
+        continue;
+      }
+      dirty = 0;
+      int const gx0 = cx * k_fog_chunk_cells;
+      int const gz0 = cz * k_fog_chunk_cells;
+      int const gx1 = std::min(grid_w, gx0 + k_fog_chunk_cells);
+      int const gz1 = std::min(grid_h, gz0 + k_fog_chunk_cells);
+      int const px0 = (gx0 * k_minimap_size + grid_w - 1) / grid_w;
+      int const px1 = std::min(
+          k_minimap_size, (gx1 * k_minimap_size + grid_w - 1) / grid_w);
+      int const py0 = (gz0 * k_minimap_size + grid_h - 1) / grid_h;
+      int const py1 = std::min(
+          k_minimap_size, (gz1 * k_minimap_size + grid_h - 1) / grid_h);
+      shadePixelRect(px0, px1, py0, py1, grid_w, grid_h);
+    }
+  }
+}
+
+void MinimapProvider::compose(Engine::Core::World &world, int localOwnerId) {
+  auto &terrain = Game::Map::TerrainService::instance();
+  auto &visibility = Game::Map::VisibilityService::instance();
+  const auto *height_map = terrain.getHeightMap();
+  if (height_map == nullptr) {
+    return;
+  }
+  int const grid_w = height_map->getWidth();
+  int const grid_h = height_map->getHeight();
+  float const tile_size = height_map->getTileSize();
+  float const world_w = static_cast<float>(grid_w) * tile_size;
+  float const world_h = static_cast<float>(grid_h) * tile_size;
+  bool const fog_enabled = visibility.isInitialized();
+
+  QImage composed;
+  if (fog_enabled) {
+    refreshFogLayer(grid_w, grid_h);
+    composed = m_fogLayer.copy();
+  } else {
+    composed = m_terrainLayer.copy();
+  }
+
+  for (auto *entity : world.getEntitiesWith<Engine::Core::UnitComponent>()) {
+    const auto *unit = entity->getComponent<Engine::Core::UnitComponent>();
+    const auto *transform =
+        entity->getComponent<Engine::Core::TransformComponent>();
+    if (unit == nullptr || transform == nullptr || unit->health <= 0) {
+      continue;
+    }
+    float const wx = transform->position.x;
+    float const wz = transform->position.z;
+    if (fog_enabled && unit->owner_id != localOwnerId &&
+        !visibility.isVisibleWorld(wx, wz)) {
+      continue;
+    }
+    // World origin sits at the map centre; shift into [0, world] range.
+    int const px = static_cast<int>((wx + world_w * 0.5F) / world_w *
+                                    static_cast<float>(k_minimap_size));
+    int const py = static_cast<int>((wz + world_h * 0.5F) / world_h *
+                                    static_cast<float>(k_minimap_size));
+    QVector3D const tint = Game::Visuals::team_colorForOwner(unit->owner_id);
+    QRgb const dot = qRgb(static_cast<int>(tint.x() * 255.0F),
+                          static_cast<int>(tint.y() * 255.0F),
+                          static_cast<int>(tint.z() * 255.0F));
+    for (int dy = -k_dot_radius; dy <= k_dot_radius; ++dy) {
+      int const y = py + dy;
+      if (y < 0 || y >= k_minimap_size) {
+        continue;
+      }
+      auto *scanline = reinterpret_cast<QRgb *>(composed.scanLine(y));
+      for (int dx = -k_dot_radius; dx <= k_dot_radius; ++dx) {
+        int const x = px + dx;
+        if (x >= 0 && x < k_minimap_size) {
+          scanline[x] = dot;
+        }
+      }
+    }
+  }
+
+  QMutexLocker const lock(&m_mutex);
+  m_image = std::move(composed);
+}
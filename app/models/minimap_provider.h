@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QImage>
+#include <QMutex>
+#include <QQuickImageProvider>
+#include <cstdint>
+#include <vector>
+
+namespace Engine::Core {
+class World;
+}
+
+// Offscreen minimap rebuilt on a ~10 Hz cadence instead of per-frame
+// per-entity model updates. The terrain base layer is rasterized once per
+// map; each refresh composes fog-of-war shading from the visibility grid
+// and unit dots in team colours on top, and QML pulls the result as an
+// image-provider texture keyed on the engine's minimapVersion property.
+class MinimapProvider : public QQuickImageProvider {
+public:
+  MinimapProvider();
+
+  auto requestImage(const QString &id, QSize *size,
+                    const QSize &requestedSize) -> QImage override;
+
+  // Called from the engine tick; recomposes at most every refresh
+  // interval. Returns true when the image changed so the caller can bump
+  // the version QML keys its source URL on.
+  auto maybeRefresh(Engine::Core::World &world, int localOwnerId) -> bool;
+
+  // Drops the cached terrain layer; call when a new map is loaded.
+  void invalidate();
+
+private:
+  void rebuildTerrainLayer();
+  void compose(Engine::Core::World &world, int localOwnerId);
+  // Keeps m_fogLayer (terrain with fog shading baked in) current. Fog
+  // deltas are consumed as cell runs and aggregated to chunk granularity;
+  // only the pixel regions of dirty chunks are re-shaded, so early-game
+  // scouting that reveals thousands of cells per refresh touches a
+  // handful of chunks instead of re-walking the whole grid.
+  void refreshFogLayer(int grid_w, int grid_h);
+  void shadePixelRect(int px0, int px1, int py0, int py1, int grid_w,
+                      int grid_h);
+
+  QImage m_terrainLayer;
+  QImage m_fogLayer;
+  QImage m_image;
+  mutable QMutex m_mutex;
+  QElapsedTimer m_clock;
+  qint64 m_lastRefreshMs = -1;
+
+  // Caller-tracked visibility copy plus the version it reflects; chunk
+  // dirty bits cover the visibility grid at k_fog_chunk_cells granularity.
+  std::vector<std::uint8_t> m_cells;
+  std::uint64_t m_cellsVersion = 0;
+  std::vector<std::uint8_t> m_chunkDirty;
+  int m_chunksX = 0;
+  int m_chunksZ = 0;
+};
@@ -17,43 +17,34 @@ auto SelectedUnitsModel::rowCount(const QModelIndex &parent) const -> int {
   if (parent.isValid()) {
     return 0;
   }
-  return static_cast<int>(m_ids.size());
+  return static_cast<int>(m_rows.size());
 }
 
 auto SelectedUnitsModel::data(const QModelIndex &index,
                               int role) const -> QVariant {
   if (!index.isValid() || index.row() < 0 ||
-      index.row() >= static_cast<int>(m_ids.size())) {
+      index.row() >= static_cast<int>(m_rows.size())) {
     return {};
   }
-  auto id = m_ids[index.row()];
-  if (m_engine == nullptr) {
-    return {};
-  }
-  QString name;
-  int hp = 0;
-  int max_hp = 0;
-  bool isB = false;
-  bool alive = false;
+  const Row &row = m_rows[index.row()];
   if (role == UnitIdRole) {
-    return QVariant::fromValue<int>(static_cast<int>(id));
-  }
-  if (!m_engine->getUnitInfo(id, name, hp, max_hp, isB, alive)) {
-    return {};
+    return QVariant::fromValue<int>(static_cast<int>(row.id));
   }
   if (role == NameRole) {
-    return name;
+    return row.name;
   }
   if (role == HealthRole) {
-    return hp;
+    return row.health;
   }
   if (role == max_healthRole) {
-    return max_hp;
+    return row.maxHealth;
   }
   if (role == HealthRatioRole) {
-    return (max_hp > 0 ? static_cast<double>(std::clamp(hp, 0, max_hp)) /
-                             static_cast<double>(max_hp)
-                       : 0.0);
+    return (row.maxHealth > 0
+                ? static_cast<double>(
+                      std::clamp(row.health, 0, row.maxHealth)) /
+                      static_cast<double>(row.maxHealth)
+                : 0.0);
   }
   return {};
 }
@@ -73,36 +64,76 @@ void SelectedUnitsModel::refresh() {
   std::vector<Engine::Core::EntityID> ids;
   m_engine->getSelectedUnitIds(ids);
 
-  if (ids.size() == m_ids.size() &&
-      std::equal(ids.begin(), ids.end(), m_ids.begin())) {
-    if (!m_ids.empty()) {
-      QModelIndex const first = index(0, 0);
-      QModelIndex const last = index(static_cast<int>(m_ids.size()) - 1, 0);
-      emit dataChanged(first, last,
-                       {HealthRole, max_healthRole, HealthRatioRole});
-    }
+  bool const same_selection =
+      ids.size() == m_rows.size() &&
+      std::equal(ids.begin(), ids.end(), m_rows.begin(),
+                 [](Engine::Core::EntityID id, const Row &row) {
+                   return id == row.id;
+                 });
+  if (!same_selection) {
+    beginResetModel();
+    rebuildRows(ids);
+    endResetModel();
     return;
   }
 
-  beginResetModel();
+  // Same selection: update rows in place and notify only the contiguous
+  // ranges whose stats actually changed, so a quiet 200-unit selection
+  // costs no QVariant traffic at all.
+  int range_first = -1;
+  for (int row_index = 0; row_index < static_cast<int>(m_rows.size());
+       ++row_index) {
+    Row &row = m_rows[row_index];
+    QString name;
+    int hp = 0;
+    int max_hp = 0;
+    bool is_building = false;
+    bool alive = false;
+    bool changed = false;
+    if (m_engine->getUnitInfo(row.id, name, hp, max_hp, is_building, alive)) {
+      changed = hp != row.health || max_hp != row.maxHealth;
+      row.health = hp;
+      row.maxHealth = max_hp;
+    }
 
-  m_ids.clear();
+    if (changed) {
+      if (range_first < 0) {
+        range_first = row_index;
+      }
+    } else if (range_first >= 0) {
+      emit dataChanged(index(range_first, 0), index(row_index - 1, 0),
+                       {HealthRole, max_healthRole, HealthRatioRole});
+      range_first = -1;
+    }
+  }
+  if (range_first >= 0) {
+    emit dataChanged(index(range_first, 0),
+                     index(static_cast<int>(m_rows.size()) - 1, 0),
+                     {HealthRole, max_healthRole, HealthRatioRole});
+  }
+}
+
+void SelectedUnitsModel::rebuildRows(
+    const std::vector<Engine::Core::EntityID> &ids) {
+  m_rows.clear();
+  m_rows.reserve(ids.size());
   for (auto id : ids) {
-    QString nm;
+    QString name;
     int hp = 0;
     int max_hp = 0;
-    bool isB = false;
+    bool is_building = false;
     bool alive = false;
-    if (!m_engine->getUnitInfo(id, nm, hp, max_hp, isB, alive)) {
-      continue;
-    }
-    if (isB) {
+    if (!m_engine->getUnitInfo(id, name, hp, max_hp, is_building, alive)) {
       continue;
     }
-    if (!alive) {
+    if (is_building || !alive) {
       continue;
     }
-    m_ids.push_back(id);
+    Row row;
+    row.id = id;
+    row.name = name;
+    row.health = hp;
+    row.maxHealth = max_hp;
+    m_rows.push_back(row);
   }
-  endResetModel();
 }
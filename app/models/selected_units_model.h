@@ -2,6 +2,7 @@
 
 #include "../../game/core/entity.h"
 #include <QAbstractListModel>
+#include <QString>
 #include <vector>
 
 class GameEngine;
@@ -29,6 +30,18 @@ public:
   void refresh();
 
 private:
+  // Cached copy of a selected unit's UI-facing stats; data() serves
+  // from here so repaints never walk the ECS, and refresh() diffs
+  // against it to emit dataChanged only for rows that actually moved.
+  struct Row {
+    Engine::Core::EntityID id = 0;
+    QString name;
+    int health = 0;
+    int maxHealth = 0;
+  };
+
+  void rebuildRows(const std::vector<Engine::Core::EntityID> &ids);
+
   GameEngine *m_engine = nullptr;
-  std::vector<Engine::Core::EntityID> m_ids;
+  std::vector<Row> m_rows;
 };
@@ -10,7 +10,15 @@ layout(location = 5) in float i_radius;
 layout(location = 6) in float i_alpha;
 layout(location = 7) in vec3 i_color;
 
-uniform mat4 u_viewProj;
+// Per-frame state shared by every pass; the backend fills this block once
+// per frame and binds it for all draws.
+layout(std140) uniform FrameUniforms {
+  mat4 u_viewProj;
+  vec4 u_lightDirection; // xyz: normalized sun direction
+  vec4 u_cameraRight;    // xyz
+  vec4 u_cameraForward;  // xyz
+  vec4 u_frameTime;      // x: seconds since renderer start
+};
 
 out vec3 v_worldPos;
 out vec3 v_normal;
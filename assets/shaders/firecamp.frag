@@ -5,22 +5,31 @@ in float Intensity;
 in float FlamePhase;
 in float FlameHeight;
 
+// Per-frame state shared by every pass; the backend fills this block once
+// per frame and binds it for all draws.
+layout(std140) uniform FrameUniforms {
+  mat4 u_viewProj;
+  vec4 u_lightDirection; // xyz: normalized sun direction
+  vec4 u_cameraRight;    // xyz
+  vec4 u_cameraForward;  // xyz
+  vec4 u_frameTime;      // x: seconds since renderer start
+};
+
 uniform sampler2D fireTexture;
-uniform float u_time;
 uniform float u_glowStrength;
 
 void main() {
   float flameHeight = clamp(FlameHeight, 0.0, 1.0);
   float intensityScale = clamp(Intensity, 0.6, 1.6);
 
-  vec2 animatedUV =
-      vec2(TexCoord.x, TexCoord.y + fract(u_time * 0.45 + FlamePhase * 0.05));
+  vec2 animatedUV = vec2(
+      TexCoord.x, TexCoord.y + fract(u_frameTime.x * 0.45 + FlamePhase * 0.05));
   vec4 texColor = texture(fireTexture, animatedUV);
 
-  float noiseLow =
-      0.5 + 0.5 * sin(u_time * 2.3 + FlamePhase * 1.9 + flameHeight * 7.0);
-  float noiseHigh =
-      0.5 + 0.5 * sin(u_time * 4.8 + FlamePhase * 3.6 + TexCoord.x * 10.0);
+  float noiseLow = 0.5 + 0.5 * sin(u_frameTime.x * 2.3 + FlamePhase * 1.9 +
+                                   flameHeight * 7.0);
+  float noiseHigh = 0.5 + 0.5 * sin(u_frameTime.x * 4.8 + FlamePhase * 3.6 +
+                                    TexCoord.x * 10.0);
   float flicker = mix(noiseLow, noiseHigh, clamp(flameHeight * 1.2, 0.0, 1.0));
 
   vec3 baseColor =
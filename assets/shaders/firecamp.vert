@@ -6,12 +6,18 @@ layout(location = 1) in vec2 aTexCoord;
 layout(location = 3) in vec4 i_posIntensity; // x, y, z, intensity
 layout(location = 4) in vec4 i_radiusPhase;  // radius, phase, duration, unused
 
-uniform mat4 u_viewProj;
-uniform float u_time;
+// Per-frame state shared by every pass; the backend fills this block once
+// per frame and binds it for all draws.
+layout(std140) uniform FrameUniforms {
+  mat4 u_viewProj;
+  vec4 u_lightDirection; // xyz: normalized sun direction
+  vec4 u_cameraRight;    // xyz
+  vec4 u_cameraForward;  // xyz
+  vec4 u_frameTime;      // x: seconds since renderer start
+};
+
 uniform float u_flickerSpeed;
 uniform float u_flickerAmount;
-uniform vec3 u_cameraRight;
-uniform vec3 u_cameraForward;
 
 out vec2 TexCoord;
 out float Intensity;
@@ -48,9 +54,9 @@ void main() {
   float heightScale = clamp(radius * 0.24 * intensityScale, 0.55, 1.05);
 
   float flickerOffset =
-      sin(u_time * u_flickerSpeed + phase) * (u_flickerAmount * 0.55);
-  float sway =
-      sin(u_time * (u_flickerSpeed * 1.05) + phase * 2.1 + heightT * 2.7);
+      sin(u_frameTime.x * u_flickerSpeed + phase) * (u_flickerAmount * 0.55);
+  float sway = sin(u_frameTime.x * (u_flickerSpeed * 1.05) + phase * 2.1 +
+                   heightT * 2.7);
   vec3 wobbleOffset = horizontalAxis * (sway * u_flickerAmount * radius *
                                         (0.18 + heightT * 0.35));
 
@@ -0,0 +1,39 @@
+#version 330 core
+
+const int kMaxSources = 256;
+
+in vec2 v_worldXZ;
+
+out vec4 FragColor;
+
+// R8 grid texture: 0 = unseen, 1/255 = explored, 2/255 = visible.
+uniform sampler2D u_cells;
+uniform vec2 u_worldSize;
+uniform int u_sourceCount;
+// xy = world position, z = vision range.
+uniform vec4 u_sources[kMaxSources];
+
+void main() {
+  vec2 uv = v_worldXZ / u_worldSize + 0.5;
+  float state = texture(u_cells, uv).r * 255.0;
+
+  // Vision circles are evaluated per fragment so the visible area follows
+  // units smoothly between the throttled CPU visibility updates; the cell
+  // texture keeps correctness when the source buffer is clamped.
+  float visibility = state >= 1.5 ? 1.0 : 0.0;
+  for (int i = 0; i < u_sourceCount; ++i) {
+    vec2 d = v_worldXZ - u_sources[i].xy;
+    float range = u_sources[i].z;
+    float dist = length(d);
+    visibility = max(visibility, 1.0 - smoothstep(range - 1.0, range, dist));
+  }
+
+  if (visibility >= 0.999) {
+    discard;
+  }
+
+  float explored = state >= 0.5 ? 1.0 : 0.0;
+  vec3 color = mix(vec3(0.02, 0.02, 0.05), vec3(0.05, 0.05, 0.05), explored);
+  float alpha = mix(0.9, 0.45, explored) * (1.0 - visibility);
+  FragColor = vec4(color, alpha);
+}
@@ -0,0 +1,23 @@
+#version 330 core
+
+layout(location = 0) in vec3 a_position;
+
+// Per-frame state shared by every pass; the backend fills this block once
+// per frame and binds it for all draws.
+layout(std140) uniform FrameUniforms {
+  mat4 u_viewProj;
+  vec4 u_lightDirection; // xyz: normalized sun direction
+  vec4 u_cameraRight;    // xyz
+  vec4 u_cameraForward;  // xyz
+  vec4 u_frameTime;      // x: seconds since renderer start
+};
+
+uniform vec2 u_worldSize;
+
+out vec2 v_worldXZ;
+
+void main() {
+  vec2 worldXZ = a_position.xz * u_worldSize;
+  v_worldXZ = worldXZ;
+  gl_Position = u_viewProj * vec4(worldXZ.x, 0.25, worldXZ.y, 1.0);
+}
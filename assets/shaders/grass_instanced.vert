@@ -6,12 +6,19 @@ layout(location = 2) in vec4 a_posHeight;
 layout(location = 3) in vec4 a_colorWidth;
 layout(location = 4) in vec4 a_swayParams;
 
-uniform mat4 u_viewProj;
-uniform float u_time;
+// Per-frame state shared by every pass; the backend fills this block once
+// per frame and binds it for all draws.
+layout(std140) uniform FrameUniforms {
+  mat4 u_viewProj;
+  vec4 u_lightDirection; // xyz: normalized sun direction
+  vec4 u_cameraRight;    // xyz
+  vec4 u_cameraForward;  // xyz
+  vec4 u_frameTime;      // x: seconds since renderer start
+};
+
 uniform float u_windStrength;
 uniform float u_windSpeed;
 uniform vec3 u_soilColor;
-uniform vec3 u_lightDir;
 
 out vec3 v_color;
 out float v_alpha;
@@ -29,7 +36,7 @@ void main() {
   float orientation = a_swayParams.w;
 
   float tip = clamp(a_uv.y, 0.0, 1.0);
-  float sway = sin(u_time * swaySpeed + swayPhase) * swayStrength;
+  float sway = sin(u_frameTime.x * swaySpeed + swayPhase) * swayStrength;
   float bend = smoothstep(0.0, 1.0, tip);
   float swayOffset = sway * bend;
 
@@ -43,7 +50,7 @@ void main() {
 
   vec3 worldPos = basePos + rotated;
 
-  vec3 lightDir = normalize(u_lightDir);
+  vec3 lightDir = normalize(u_lightDirection.xyz);
   vec3 normal = normalize(vec3(sinO, 1.6, cosO));
   float lightTerm = clamp(dot(normal, lightDir), 0.0, 1.0);
   float tipHighlight = mix(0.7, 1.0, tip);
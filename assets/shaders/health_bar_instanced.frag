@@ -0,0 +1,15 @@
+#version 330 core
+
+in vec2 v_uv;
+in vec3 v_color;
+in float v_fill;
+
+out vec4 FragColor;
+
+void main() {
+  // The fill boundary resolves per fragment, so one instance covers both
+  // the dark backing and the colored fill portion of the bar.
+  float filled = step(v_uv.x, v_fill);
+  vec3 color = mix(vec3(0.06), v_color, filled);
+  FragColor = vec4(color, 0.9);
+}
@@ -0,0 +1,40 @@
+#version 330 core
+
+layout(location = 0) in vec3 a_position;
+layout(location = 1) in vec3 a_normal;
+layout(location = 2) in vec2 a_texCoord;
+
+layout(location = 3) in vec3 i_anchor;
+layout(location = 4) in float i_width;
+layout(location = 5) in vec3 i_color;
+layout(location = 6) in float i_fill;
+
+// Per-frame state shared by every pass; the backend fills this block once
+// per frame and binds it for all draws.
+layout(std140) uniform FrameUniforms {
+  mat4 u_viewProj;
+  vec4 u_lightDirection; // xyz: normalized sun direction
+  vec4 u_cameraRight;    // xyz
+  vec4 u_cameraForward;  // xyz
+  vec4 u_frameTime;      // x: seconds since renderer start
+};
+
+out vec2 v_uv;
+out vec3 v_color;
+out float v_fill;
+
+void main() {
+  // One camera-facing quad per bar, projected here so the CPU side only
+  // ever writes an anchor, a width and a fill fraction per instance.
+  vec3 rightVec = normalize(u_cameraRight.xyz);
+  vec3 upVec = normalize(cross(rightVec, normalize(u_cameraForward.xyz)));
+  float height = i_width * 0.12;
+  vec3 world = i_anchor + rightVec * (a_position.x * i_width) +
+               upVec * (a_position.y * height);
+
+  v_uv = a_texCoord;
+  v_color = i_color;
+  v_fill = i_fill;
+
+  gl_Position = u_viewProj * vec4(world, 1.0);
+}
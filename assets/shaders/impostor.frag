@@ -0,0 +1,20 @@
+#version 330 core
+
+in vec2 v_texCoord;
+in vec3 v_worldPos;
+
+uniform sampler2D u_texture;
+uniform vec3 u_color;
+uniform bool u_useTexture;
+uniform float u_alpha;
+
+out vec4 FragColor;
+
+void main() {
+  vec4 texel = u_useTexture ? texture(u_texture, v_texCoord) : vec4(1.0);
+  // Alpha test instead of blending keeps impostors in the opaque batch.
+  if (texel.a < 0.5) {
+    discard;
+  }
+  FragColor = vec4(texel.rgb * u_color, u_alpha);
+}
@@ -0,0 +1,20 @@
+#version 330 core
+
+in vec3 v_normal;
+in vec2 v_texCoord;
+in vec3 v_worldPos;
+in vec4 v_color;
+
+uniform sampler2D u_texture;
+uniform bool u_useTexture;
+
+out vec4 FragColor;
+
+void main() {
+  vec4 texel = u_useTexture ? texture(u_texture, v_texCoord) : vec4(1.0);
+  // Alpha test instead of blending keeps impostors in the opaque batch.
+  if (texel.a < 0.5) {
+    discard;
+  }
+  FragColor = vec4(texel.rgb * v_color.rgb, v_color.a);
+}
@@ -0,0 +1,19 @@
+#version 330 core
+in vec2 TexCoord;
+in vec3 Color;
+in float LifeT;
+
+out vec4 FragColor;
+
+void main() {
+  // Soft round sprite: quadratic falloff from the quad center, fading
+  // out over the particle's lifetime. Drawn additively, so alpha acts
+  // as a brightness scale.
+  vec2 fromCenter = TexCoord - vec2(0.5);
+  float r2 = dot(fromCenter, fromCenter) * 4.0;
+  float falloff = clamp(1.0 - r2, 0.0, 1.0);
+  falloff *= falloff;
+
+  float fade = 1.0 - LifeT;
+  FragColor = vec4(Color, falloff * fade);
+}
@@ -0,0 +1,63 @@
+#version 330 core
+layout(location = 0) in vec3 aPos;      // unit quad corner, xy in [-0.5, 0.5]
+layout(location = 1) in vec2 aTexCoord;
+
+// Instance attributes: one burst particle, written once at spawn. The
+// whole trajectory is reconstructed here from the frame clock, so live
+// particles need no CPU updates and no re-uploads.
+layout(location = 3) in vec4 i_originSpawn;  // xyz: origin, w: spawn time
+layout(location = 4) in vec4 i_velocityLife; // xyz: velocity, w: lifetime
+layout(location = 5) in vec4 i_colorSize;    // rgb: color, w: base size
+layout(location = 6) in vec4 i_misc;         // x: gravity scale, y: seed
+
+// Per-frame state shared by every pass; the backend fills this block once
+// per frame and binds it for all draws.
+layout(std140) uniform FrameUniforms {
+  mat4 u_viewProj;
+  vec4 u_lightDirection; // xyz: normalized sun direction
+  vec4 u_cameraRight;    // xyz
+  vec4 u_cameraForward;  // xyz
+  vec4 u_frameTime;      // x: seconds since renderer start
+};
+
+uniform float u_gravity;
+
+out vec2 TexCoord;
+out vec3 Color;
+out float LifeT;
+
+void main() {
+  float age = u_frameTime.x - i_originSpawn.w;
+  float life = i_velocityLife.w;
+
+  // Expired, not yet spawned, or never-written pool slots collapse to a
+  // degenerate quad outside the clip volume.
+  if (life <= 0.0 || age < 0.0 || age >= life) {
+    gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+    TexCoord = vec2(0.0);
+    Color = vec3(0.0);
+    LifeT = 1.0;
+    return;
+  }
+
+  float t = age / life;
+
+  // Ballistic path plus a slight per-particle horizontal drift so a
+  // burst does not read as perfectly radial.
+  vec3 pos = i_originSpawn.xyz + i_velocityLife.xyz * age;
+  pos.y -= 0.5 * u_gravity * i_misc.x * age * age;
+  float seed = i_misc.y * 6.2831853;
+  pos.xz += vec2(cos(seed), sin(seed)) * (age * age * 0.15);
+
+  // Shrink toward death; the fragment fade handles the alpha ramp.
+  float size = i_colorSize.w * (1.0 - t * t);
+
+  vec3 rightVec = normalize(u_cameraRight.xyz);
+  vec3 upVec = normalize(cross(rightVec, normalize(u_cameraForward.xyz)));
+  vec3 world = pos + (rightVec * aPos.x + upVec * aPos.y) * size;
+
+  gl_Position = u_viewProj * vec4(world, 1.0);
+  TexCoord = aTexCoord;
+  Color = i_colorSize.rgb;
+  LifeT = t;
+}
@@ -0,0 +1,8 @@
+#version 330 core
+
+// Entity id of the proxy volume being drawn; 0 is reserved for "nothing".
+uniform uint u_entityId;
+
+out uint fragId;
+
+void main() { fragId = u_entityId; }
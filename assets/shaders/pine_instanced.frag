@@ -8,7 +8,15 @@ in float vFoliageMask; // 0 = bark, 1 = foliage
 in float vNeedleSeed;  // per-instance variation
 in float vBarkSeed;    // per-instance variation
 
-uniform vec3 uLightDirection;
+// Per-frame state shared by every pass; the backend fills this block once
+// per frame and binds it for all draws.
+layout(std140) uniform FrameUniforms {
+  mat4 u_viewProj;
+  vec4 u_lightDirection; // xyz: normalized sun direction
+  vec4 u_cameraRight;    // xyz
+  vec4 u_cameraForward;  // xyz
+  vec4 u_frameTime;      // x: seconds since renderer start
+};
 
 out vec4 FragColor;
 
@@ -23,7 +31,7 @@ float hash(vec2 p) {
 void main() {
   // --- Lighting ---
   vec3 n = normalize(vNormal);
-  vec3 l = normalize(uLightDirection);
+  vec3 l = normalize(u_lightDirection.xyz);
   float diffuse = max(dot(n, l), 0.0);
   float ambient = 0.4;
   float lighting = ambient + diffuse * 0.7;
@@ -14,8 +14,16 @@ layout(location =
 // ─────────────────────────────────────────────────────────────
 // Uniforms
 // ─────────────────────────────────────────────────────────────
-uniform mat4 uViewProj;
-uniform float uTime;
+// Per-frame state shared by every pass; the backend fills this block once
+// per frame and binds it for all draws.
+layout(std140) uniform FrameUniforms {
+  mat4 u_viewProj;
+  vec4 u_lightDirection; // xyz: normalized sun direction
+  vec4 u_cameraRight;    // xyz
+  vec4 u_cameraForward;  // xyz
+  vec4 u_frameTime;      // x: seconds since renderer start
+};
+
 uniform float uWindStrength;
 uniform float uWindSpeed;
 
@@ -69,8 +77,8 @@ void main() {
   vec3 localPos = modelPos * scale;
 
   // ── Wind sway (stronger at upper regions) ─────────────────
-  float sway = sin(uTime * uWindSpeed * 0.5 + swayPhase) * uWindStrength * 0.8 *
-               heightFactor * heightFactor;
+  float sway = sin(u_frameTime.x * uWindSpeed * 0.5 + swayPhase) *
+               uWindStrength * 0.8 * heightFactor * heightFactor;
 
   float swayInfluence = mix(0.04, 0.12, foliageMask);
   localPos.x += sway * swayInfluence;
@@ -108,5 +116,5 @@ void main() {
   vNeedleSeed = needleSeed;
   vBarkSeed = barkSeed;
 
-  gl_Position = uViewProj * vec4(vWorldPos, 1.0);
+  gl_Position = u_viewProj * vec4(vWorldPos, 1.0);
 }
@@ -11,7 +11,15 @@ in float vType;
 in vec3 vTangent;
 in vec3 vBitangent;
 
-uniform vec3 uLightDirection;
+// Per-frame state shared by every pass; the backend fills this block once
+// per frame and binds it for all draws.
+layout(std140) uniform FrameUniforms {
+  mat4 u_viewProj;
+  vec4 u_lightDirection; // xyz: normalized sun direction
+  vec4 u_cameraRight;    // xyz
+  vec4 u_cameraForward;  // xyz
+  vec4 u_frameTime;      // x: seconds since renderer start
+};
 
 out vec4 FragColor;
 
@@ -187,7 +195,7 @@ void main() {
   float edgeAtten = mix(0.6, 1.0, pow(1.0 - edge1, 1.5)); // 0.6 at very edge
 
   // Lighting
-  vec3 L = normalize(uLightDirection);
+  vec3 L = normalize(u_lightDirection.xyz);
   float nl = max(dot(N, L), 0.0);
   float halfLambert = nl * 0.5 + 0.5;
   float wrap = clamp((dot(N, L) + 0.20) / 1.20, 0.0, 1.0);
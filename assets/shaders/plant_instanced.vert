@@ -12,8 +12,16 @@ layout(location = 4) in vec4 aColorSway; // rgb = tint, a = sway phase
 layout(location = 5) in vec4
     aTypeParams; // x = type, y = rotation, z = sway strength, w = sway speed
 
-uniform mat4 uViewProj;
-uniform float uTime;
+// Per-frame state shared by every pass; the backend fills this block once
+// per frame and binds it for all draws.
+layout(std140) uniform FrameUniforms {
+  mat4 u_viewProj;
+  vec4 u_lightDirection; // xyz: normalized sun direction
+  vec4 u_cameraRight;    // xyz
+  vec4 u_cameraForward;  // xyz
+  vec4 u_frameTime;      // x: seconds since renderer start
+};
+
 uniform float uWindStrength;
 uniform float uWindSpeed;
 
@@ -60,8 +68,9 @@ void main() {
   localPos.xz += leanDir * (h * h) * tan(leanAngle) * finalScale;
 
   // wind: gentle gusts with per-instance direction
-  float gust = sin(uTime * 0.35 + seed * 6.0) * 0.5 + 0.5;
-  float sway = sin(uTime * swaySpeed * uWindSpeed + swayPhase + seed * 4.0);
+  float gust = sin(u_frameTime.x * 0.35 + seed * 6.0) * 0.5 + 0.5;
+  float sway =
+      sin(u_frameTime.x * swaySpeed * uWindSpeed + swayPhase + seed * 4.0);
   sway *= (0.22 + 0.55 * gust) * swayStrength * uWindStrength * pow(h, 1.25);
 
   float windYaw = seed * 9.0;
@@ -108,5 +117,5 @@ void main() {
   // fuller base alpha (final silhouette handled in FS)
   vAlpha = 1.0 - smoothstep(0.49, 0.56, abs(aTexCoord.x - 0.5));
 
-  gl_Position = uViewProj * vec4(vWorldPos, 1.0);
+  gl_Position = u_viewProj * vec4(vWorldPos, 1.0);
 }
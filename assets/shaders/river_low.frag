@@ -0,0 +1,30 @@
+#version 330 core
+out vec4 FragColor;
+in vec2 TexCoord;
+in vec3 WorldPos;
+
+uniform float time;
+
+// Low water tier: the vertex waves in river.vert provide all the motion;
+// per pixel this is just a depth gradient, a fixed-view fresnel rim and a
+// faded shoreline, with no noise evaluation at all.
+void main() {
+  vec3 deepWater = vec3(0.010, 0.045, 0.095);
+  vec3 shallowWater = vec3(0.060, 0.180, 0.300);
+
+  // Approximate depth from the cross-river coordinate: shallow at the
+  // banks, deep mid-channel.
+  float bank = smoothstep(0.0, 0.35, TexCoord.y) *
+               smoothstep(0.0, 0.35, 1.0 - TexCoord.y);
+  vec3 color = mix(shallowWater, deepWater, bank);
+
+  // Cheap moving highlight so the surface doesn't read as static.
+  float glint =
+      0.5 + 0.5 * sin(WorldPos.x * 1.7 + WorldPos.z * 2.3 + time * 1.8);
+  color += vec3(0.04, 0.06, 0.08) * glint * bank;
+
+  // Fresnel rim against the fixed RTS view direction.
+  color += vec3(0.05, 0.09, 0.14) * (1.0 - bank);
+
+  FragColor = vec4(clamp(color, 0.0, 1.0), 0.85);
+}
@@ -0,0 +1,109 @@
+#version 330 core
+out vec4 FragColor;
+in vec2 TexCoord;
+in vec3 WorldPos;
+
+uniform float time;
+
+// Medium water tier: same look as river.frag but with three fbm octaves,
+// one domain warp, forward-difference gradients and no micro-normal, so
+// the per-pixel cost is roughly a quarter of the full tier.
+float saturate(float x) { return clamp(x, 0.0, 1.0); }
+vec3 saturate(vec3 v) { return clamp(v, vec3(0.0), vec3(1.0)); }
+mat2 rot(float a) {
+  float c = cos(a), s = sin(a);
+  return mat2(c, -s, s, c);
+}
+
+float hash(vec2 p) {
+  p = fract(p * vec2(123.34, 456.21));
+  p += dot(p, p + 45.32);
+  return fract(p.x * p.y);
+}
+float noise(vec2 p) {
+  vec2 i = floor(p), f = fract(p);
+  f = f * f * (3.0 - 2.0 * f);
+  float a = hash(i), b = hash(i + vec2(1, 0)), c = hash(i + vec2(0, 1)),
+        d = hash(i + vec2(1, 1));
+  return mix(mix(a, b, f.x), mix(c, d, f.x), f.y);
+}
+float fbm(vec2 p) {
+  float v = 0., a = .5, f = 1.;
+  for (int i = 0; i < 3; i++) {
+    v += a * noise(p * f);
+    f *= 2.;
+    a *= .5;
+  }
+  return v;
+}
+
+vec3 skyColor(vec3 rd, vec3 sunDir) {
+  float t = saturate(rd.y * 0.5 + 0.5);
+  vec3 horizon = vec3(0.68, 0.84, 0.95), zenith = vec3(0.15, 0.36, 0.70);
+  vec3 sky = mix(horizon, zenith, t);
+  float sun = pow(max(dot(rd, sunDir), 0.0), 260.0);
+  float halo = pow(max(dot(rd, sunDir), 0.0), 6.0) * 0.03;
+  return sky + vec3(1.0, 0.96, 0.88) * (sun * 1.0 + halo);
+}
+float fresnelSchlick(float c, float F0) {
+  return F0 + (1.0 - F0) * pow(1.0 - c, 5.0);
+}
+
+float waterHeight(vec2 uv) {
+  vec2 p = uv + 0.75 * vec2(fbm(uv * 0.6 + time * 0.05),
+                            fbm(uv * 0.6 - time * 0.04));
+  float h = 0.0;
+  h += 0.55 * (fbm(p * 1.6 - time * 0.15) - 0.5);
+  h += 0.30 * (fbm(rot(0.8) * p * 2.8 + time * 0.20) - 0.5);
+  return h;
+}
+
+void main() {
+  vec2 uv = rot(0.35) * (WorldPos.xz * 0.38);
+
+  // Forward differences: three height taps instead of five.
+  float s = max(0.003, 0.35 * length(fwidth(uv)));
+  float h = waterHeight(uv);
+  vec2 grad = vec2(waterHeight(uv + vec2(s, 0)) - h,
+                   waterHeight(uv + vec2(0, s)) - h) /
+              s * 0.85;
+  vec3 N = normalize(vec3(-grad.x * 3.2, 1.0, -grad.y * 3.2));
+
+  vec3 sunDir = normalize(vec3(0.28, 0.85, 0.43));
+  vec3 V = normalize(vec3(0.0, 0.7, 0.7));
+  float NdotV = max(dot(N, V), 0.0);
+
+  vec3 deepWater = vec3(0.008, 0.035, 0.080);
+  vec3 shallowWater = vec3(0.060, 0.180, 0.300);
+  float calm = smoothstep(0.0, 0.45, abs(h));
+  float shallow = saturate(0.35 + 0.35 * (fbm(uv * 0.6) * (1.0 - calm)));
+  vec3 absorb = vec3(0.90, 0.45, 0.12);
+  float thickness =
+      mix(0.6, 3.5, 1.0 - shallow) * (0.35 + pow(1.0 - NdotV, 0.7));
+  vec3 transmission = mix(deepWater, shallowWater, shallow) *
+                      exp(-absorb * thickness);
+
+  vec3 R = reflect(-V, N);
+  vec3 reflection = skyColor(R, sunDir) * 0.70 * vec3(0.60, 0.75, 1.00);
+  float F = fresnelSchlick(NdotV, 0.02) * 0.40;
+
+  // Blinn-Phong stand-in for the GGX lobe of the full tier.
+  float NdotL = max(dot(N, sunDir), 0.0);
+  vec3 H = normalize(V + sunDir);
+  float spec = pow(max(dot(N, H), 0.0), 90.0) * 0.30;
+  vec3 specCol = vec3(0.75, 0.85, 1.10) * spec;
+  vec3 sunDiffuse = transmission * NdotL * 0.20;
+
+  float shore = 1.0 - (smoothstep(0.07, 0.28, TexCoord.y) *
+                       smoothstep(0.07, 0.28, 1.0 - TexCoord.y));
+  float foam = clamp(shore * (0.45 + 0.55 * fbm(uv * 3.0 + time * 0.6)) * 0.35,
+                     0.0, 1.0);
+  vec3 foamCol = vec3(0.92, 0.96, 1.0);
+
+  vec3 color = transmission * (1.0 - F) + reflection * F;
+  color += specCol + sunDiffuse;
+  color = mix(color, foamCol * mix(0.82, 1.0, NdotL), foam);
+  color += vec3(0.03, 0.06, 0.12) * pow(1.0 - NdotV, 3.0);
+
+  FragColor = vec4(saturate(color), 0.85);
+}
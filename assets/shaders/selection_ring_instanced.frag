@@ -0,0 +1,8 @@
+#version 330 core
+
+in vec3 v_color;
+in float v_alpha;
+
+out vec4 FragColor;
+
+void main() { FragColor = vec4(v_color, v_alpha); }
@@ -0,0 +1,34 @@
+#version 330 core
+
+layout(location = 0) in vec3 a_position;
+layout(location = 1) in vec3 a_normal;
+layout(location = 2) in vec2 a_texCoord;
+
+layout(location = 3) in vec3 i_center;
+layout(location = 4) in float i_size;
+layout(location = 5) in vec3 i_color;
+layout(location = 6) in float i_alpha;
+
+// Per-frame state shared by every pass; the backend fills this block once
+// per frame and binds it for all draws.
+layout(std140) uniform FrameUniforms {
+  mat4 u_viewProj;
+  vec4 u_lightDirection; // xyz: normalized sun direction
+  vec4 u_cameraRight;    // xyz
+  vec4 u_cameraForward;  // xyz
+  vec4 u_frameTime;      // x: seconds since renderer start
+};
+
+out vec3 v_color;
+out float v_alpha;
+
+void main() {
+  vec3 worldPos =
+      vec3(i_center.x + a_position.x * i_size, i_center.y + a_position.y,
+           i_center.z + a_position.z * i_size);
+
+  v_color = i_color;
+  v_alpha = i_alpha;
+
+  gl_Position = u_viewProj * vec4(worldPos, 1.0);
+}
@@ -4,13 +4,21 @@ in vec3 vWorldPos;
 in vec3 vNormal;
 in vec3 vColor;
 
-uniform vec3 uLightDirection;
+// Per-frame state shared by every pass; the backend fills this block once
+// per frame and binds it for all draws.
+layout(std140) uniform FrameUniforms {
+  mat4 u_viewProj;
+  vec4 u_lightDirection; // xyz: normalized sun direction
+  vec4 u_cameraRight;    // xyz
+  vec4 u_cameraForward;  // xyz
+  vec4 u_frameTime;      // x: seconds since renderer start
+};
 
 out vec4 FragColor;
 
 void main() {
   vec3 normal = normalize(vNormal);
-  vec3 lightDir = normalize(uLightDirection);
+  vec3 lightDir = normalize(u_lightDirection.xyz);
 
   // Diffuse lighting
   float diffuse = max(dot(normal, lightDir), 0.0);
@@ -5,7 +5,15 @@ layout(location = 1) in vec3 aNormal;
 layout(location = 2) in vec4 aPosScale; // instance: xyz=world pos, w=scale
 layout(location = 3) in vec4 aColorRot; // instance: rgb=color, a=rotation
 
-uniform mat4 uViewProj;
+// Per-frame state shared by every pass; the backend fills this block once
+// per frame and binds it for all draws.
+layout(std140) uniform FrameUniforms {
+  mat4 u_viewProj;
+  vec4 u_lightDirection; // xyz: normalized sun direction
+  vec4 u_cameraRight;    // xyz
+  vec4 u_cameraForward;  // xyz
+  vec4 u_frameTime;      // x: seconds since renderer start
+};
 
 out vec3 vWorldPos;
 out vec3 vNormal;
@@ -33,5 +41,5 @@ void main() {
 
   vColor = aColorRot.rgb;
 
-  gl_Position = uViewProj * vec4(vWorldPos, 1.0);
+  gl_Position = u_viewProj * vec4(vWorldPos, 1.0);
 }
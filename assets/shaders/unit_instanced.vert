@@ -0,0 +1,36 @@
+#version 330 core
+
+layout(location = 0) in vec3 a_position;
+layout(location = 1) in vec3 a_normal;
+layout(location = 2) in vec2 a_texCoord;
+
+layout(location = 3) in vec4 i_model0;
+layout(location = 4) in vec4 i_model1;
+layout(location = 5) in vec4 i_model2;
+layout(location = 6) in vec4 i_model3;
+layout(location = 7) in vec4 i_colorAlpha;
+
+// Per-frame state shared by every pass; the backend fills this block once
+// per frame and binds it for all draws.
+layout(std140) uniform FrameUniforms {
+  mat4 u_viewProj;
+  vec4 u_lightDirection; // xyz: normalized sun direction
+  vec4 u_cameraRight;    // xyz
+  vec4 u_cameraForward;  // xyz
+  vec4 u_frameTime;      // x: seconds since renderer start
+};
+
+out vec3 v_normal;
+out vec2 v_texCoord;
+out vec3 v_worldPos;
+out vec4 v_color;
+
+void main() {
+  mat4 model = mat4(i_model0, i_model1, i_model2, i_model3);
+  vec4 worldPos = model * vec4(a_position, 1.0);
+  v_normal = mat3(transpose(inverse(model))) * a_normal;
+  v_texCoord = a_texCoord;
+  v_worldPos = worldPos.xyz;
+  v_color = i_colorAlpha;
+  gl_Position = u_viewProj * worldPos;
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+// Shared between the high-level AudioSystem and the miniaudio backend so
+// the backend can enforce per-category voice limits without pulling in
+// the whole event system.
+enum class AudioCategory { SFX, VOICE, MUSIC };
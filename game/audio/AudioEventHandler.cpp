@@ -2,12 +2,27 @@
 #include "../core/component.h"
 #include "../core/entity.h"
 #include "../core/world.h"
+#include "../map/visibility_service.h"
 #include "AudioSystem.h"
 #include "core/event_manager.h"
 #include "units/spawn_type.h"
+#include <algorithm>
 #include <chrono>
 #include <string>
 
+namespace {
+
+// Positioned triggers beyond this world-space radius from the listener
+// are inaudible at RTS camera heights and get dropped outright.
+constexpr float k_max_audible_distance = 75.0F;
+
+// Coalesced bursts gain this much volume per merged instance, capped so
+// a hundred simultaneous arrow hits read as "many", not as clipping.
+constexpr float k_burst_gain_per_extra = 0.15F;
+constexpr int k_burst_gain_max_extras = 4;
+
+} // namespace
+
 namespace Game::Audio {
 
 AudioEventHandler::AudioEventHandler(Engine::Core::World *world)
@@ -20,29 +35,37 @@ auto AudioEventHandler::initialize() -> bool {
     return true;
   }
 
+  // Audio reactions tolerate landing a drain later, so every handler
+  // rides the Late lane: their cost shows up at the frame sync point
+  // under its own profiler zone instead of inside whichever system
+  // published the event.
   m_unitSelectedSub =
       Engine::Core::ScopedEventSubscription<Engine::Core::UnitSelectedEvent>(
           [this](const Engine::Core::UnitSelectedEvent &event) {
             onUnitSelected(event);
-          });
+          },
+          Engine::Core::DispatchLane::Late, "audio:unit_selected");
 
   m_ambientChangedSub = Engine::Core::ScopedEventSubscription<
       Engine::Core::AmbientStateChangedEvent>(
       [this](const Engine::Core::AmbientStateChangedEvent &event) {
         onAmbientStateChanged(event);
-      });
+      },
+      Engine::Core::DispatchLane::Late, "audio:ambient_changed");
 
   m_audioTriggerSub =
       Engine::Core::ScopedEventSubscription<Engine::Core::AudioTriggerEvent>(
           [this](const Engine::Core::AudioTriggerEvent &event) {
             onAudioTrigger(event);
-          });
+          },
+          Engine::Core::DispatchLane::Late, "audio:trigger");
 
   m_musicTriggerSub =
       Engine::Core::ScopedEventSubscription<Engine::Core::MusicTriggerEvent>(
           [this](const Engine::Core::MusicTriggerEvent &event) {
             onMusicTrigger(event);
-          });
+          },
+          Engine::Core::DispatchLane::Late, "audio:music_trigger");
 
   m_initialized = true;
   return true;
@@ -60,6 +83,7 @@ void AudioEventHandler::shutdown() {
 
   m_unitVoiceMap.clear();
   m_ambientMusicMap.clear();
+  m_pendingTriggers.clear();
 
   m_initialized = false;
 }
@@ -78,6 +102,28 @@ void AudioEventHandler::setVoiceSoundCategory(bool useVoiceCategory) {
   m_useVoiceCategory = useVoiceCategory;
 }
 
+void AudioEventHandler::setListenerPosition(float world_x, float world_z) {
+  m_listenerX = world_x;
+  m_listenerZ = world_z;
+  m_hasListener = true;
+}
+
+void AudioEventHandler::update() {
+  for (auto &[sound_id, pending] : m_pendingTriggers) {
+    float volume = pending.volume;
+    if (pending.count > 1) {
+      int const extras =
+          std::min(pending.count - 1, k_burst_gain_max_extras);
+      volume = std::min(1.0F,
+                        volume * (1.0F + k_burst_gain_per_extra *
+                                             static_cast<float>(extras)));
+    }
+    AudioSystem::getInstance().playSound(sound_id, volume, pending.loop,
+                                         pending.priority);
+  }
+  m_pendingTriggers.clear();
+}
+
 void AudioEventHandler::onUnitSelected(
     const Engine::Core::UnitSelectedEvent &event) {
   if (m_world == nullptr) {
@@ -129,8 +175,34 @@ void AudioEventHandler::onAmbientStateChanged(
 
 void AudioEventHandler::onAudioTrigger(
     const Engine::Core::AudioTriggerEvent &event) {
-  AudioSystem::getInstance().playSound(event.soundId, event.volume, event.loop,
-                                       event.priority);
+  if (event.hasPosition) {
+    if (m_hasListener) {
+      float const dx = event.worldX - m_listenerX;
+      float const dz = event.worldZ - m_listenerZ;
+      if (dx * dx + dz * dz >
+          k_max_audible_distance * k_max_audible_distance) {
+        return;
+      }
+    }
+    auto &visibility = Game::Map::VisibilityService::instance();
+    if (visibility.isInitialized() &&
+        !visibility.isVisibleWorld(event.worldX, event.worldZ)) {
+      return;
+    }
+  }
+
+  // Don't play yet: identical triggers landing in the same frame are
+  // merged and flushed as one voice by update().
+  auto [it, inserted] = m_pendingTriggers.try_emplace(
+      event.soundId,
+      PendingTrigger{event.volume, event.priority, event.loop, 1});
+  if (!inserted) {
+    auto &pending = it->second;
+    pending.volume = std::max(pending.volume, event.volume);
+    pending.priority = std::max(pending.priority, event.priority);
+    pending.loop = pending.loop || event.loop;
+    ++pending.count;
+  }
 }
 
 void AudioEventHandler::onMusicTrigger(
@@ -29,16 +29,37 @@ public:
 
   void setVoiceSoundCategory(bool useVoiceCategory);
 
+  // Where the player is listening from (camera focus point, world XZ);
+  // positioned triggers further than the audible radius are dropped.
+  void setListenerPosition(float world_x, float world_z);
+
+  // Flushes triggers coalesced during the frame; call once per engine
+  // update. Identical sounds fired in the same frame play as a single,
+  // slightly louder instance instead of stacking voices.
+  void update();
+
 private:
   void onUnitSelected(const Engine::Core::UnitSelectedEvent &event);
   void
   onAmbientStateChanged(const Engine::Core::AmbientStateChangedEvent &event);
-  static void onAudioTrigger(const Engine::Core::AudioTriggerEvent &event);
+  void onAudioTrigger(const Engine::Core::AudioTriggerEvent &event);
   static void onMusicTrigger(const Engine::Core::MusicTriggerEvent &event);
 
+  struct PendingTrigger {
+    float volume = 1.0F;
+    int priority = 0;
+    bool loop = false;
+    int count = 0;
+  };
+
   Engine::Core::World *m_world;
   std::unordered_map<std::string, std::string> m_unitVoiceMap;
   std::unordered_map<Engine::Core::AmbientState, std::string> m_ambientMusicMap;
+  std::unordered_map<std::string, PendingTrigger> m_pendingTriggers;
+
+  float m_listenerX = 0.0F;
+  float m_listenerZ = 0.0F;
+  bool m_hasListener = false;
 
   bool m_useVoiceCategory{true};
 
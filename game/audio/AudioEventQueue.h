@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Game::Audio {
+
+// Bounded lock-free multi-producer / single-consumer ring (Vyukov-style:
+// every slot carries a sequence counter that tells producers whether the
+// slot is free and the consumer whether it is filled). Push and pop are
+// a CAS / a pair of atomic ops with no mutex, so game-thread producers
+// never contend with the audio thread on a lock. tryPush fails instead
+// of blocking when the ring is full; the caller decides what overflow
+// means for its traffic class.
+//
+// T must be trivially copyable — slots are assigned, never constructed
+// in place.
+template <typename T, std::size_t Capacity> class AudioEventQueue {
+  static_assert((Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of two");
+
+public:
+  AudioEventQueue() {
+    for (std::size_t i = 0; i < Capacity; ++i) {
+      m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  auto tryPush(const T &value) -> bool {
+    std::uint64_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot &slot = m_slots[pos & (Capacity - 1)];
+      const std::uint64_t sequence =
+          slot.sequence.load(std::memory_order_acquire);
+      const auto diff =
+          static_cast<std::int64_t>(sequence) - static_cast<std::int64_t>(pos);
+      if (diff == 0) {
+        if (m_enqueuePos.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          slot.value = value;
+          slot.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        // The slot one lap ahead is still unconsumed: ring is full.
+        return false;
+      } else {
+        // Another producer claimed this position; catch up.
+        pos = m_enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Single consumer only.
+  auto tryPop(T &out) -> bool {
+    const std::uint64_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+    Slot &slot = m_slots[pos & (Capacity - 1)];
+    const std::uint64_t sequence =
+        slot.sequence.load(std::memory_order_acquire);
+    if (static_cast<std::int64_t>(sequence) -
+            static_cast<std::int64_t>(pos + 1) <
+        0) {
+      return false;
+    }
+    out = slot.value;
+    slot.sequence.store(pos + Capacity, std::memory_order_release);
+    m_dequeuePos.store(pos + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+private:
+  struct Slot {
+    std::atomic<std::uint64_t> sequence{0};
+    T value{};
+  };
+
+  std::array<Slot, Capacity> m_slots;
+  std::atomic<std::uint64_t> m_enqueuePos{0};
+  std::atomic<std::uint64_t> m_dequeuePos{0};
+};
+
+} // namespace Game::Audio
@@ -1,12 +1,27 @@
 #include "AudioSystem.h"
 
+#include "../../render/thread_topology.h"
+#include "../core/alloc_tracker.h"
+
 #include "MiniaudioBackend.h"
 #include "MusicPlayer.h"
 #include "Sound.h"
+#include <QCryptographicHash>
+#include <QDateTime>
 #include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QStandardPaths>
+#include <QString>
 #include <algorithm>
-#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <span>
 #include <math.h>
 #include <memory>
 #include <mutex>
@@ -48,56 +63,83 @@ void AudioSystem::shutdown() {
     return;
   }
 
-  {
-    std::lock_guard<std::mutex> const lock(queueMutex);
-    eventQueue.emplace(AudioEventType::SHUTDOWN);
-  }
-  queueCondition.notify_one();
+  enqueueEvent(AudioEvent(AudioEventType::SHUTDOWN));
 
   if (audioThread.joinable()) {
     audioThread.join();
   }
 
+  // Sounds release their decoded PCM through the backend, so they must
+  // go before the MusicPlayer tears the backend down.
+  sounds.clear();
+  soundCategories.clear();
+  activeResources.clear();
+  soundLastUse.clear();
+
   if (m_musicPlayer != nullptr) {
     m_musicPlayer->shutdown();
     m_musicPlayer = nullptr;
   }
+}
 
-  sounds.clear();
-  soundCategories.clear();
-  activeResources.clear();
+// Pushes into the lock-free ring and wakes the audio thread. When the
+// ring is full, SFX plays are disposable — dropping the newest request
+// under overload is inaudible in a battle already saturating the mixer —
+// but control events (shutdown, unload, music) must land, so those spin
+// until the consumer drains a slot.
+void AudioSystem::enqueueEvent(const AudioEvent &event) {
+  while (!eventQueue.tryPush(event)) {
+    if (event.type == AudioEventType::PLAY_SOUND &&
+        event.category == AudioCategory::SFX) {
+      droppedSfxCount.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    std::this_thread::yield();
+  }
+  queuedEventCount.fetch_add(1, std::memory_order_release);
+  queuedEventCount.notify_one();
+}
 
-  {
-    std::lock_guard<std::mutex> const lock(activeSoundsMutex);
-    activeSounds.clear();
+auto AudioSystem::internResourceId(const std::string &resourceId)
+    -> AudioResourceId {
+  std::lock_guard<std::mutex> const lock(internMutex);
+  auto it = resourceIdsByName.find(resourceId);
+  if (it != resourceIdsByName.end()) {
+    return it->second;
+  }
+  const auto id = static_cast<AudioResourceId>(resourceNames.size());
+  resourceNames.push_back(resourceId);
+  resourceIdsByName.emplace(resourceId, id);
+  return id;
+}
+
+auto AudioSystem::resourceName(AudioResourceId id) const -> std::string {
+  std::lock_guard<std::mutex> const lock(internMutex);
+  if (id >= resourceNames.size()) {
+    return {};
   }
+  return resourceNames[id];
 }
 
 void AudioSystem::playSound(const std::string &soundId, float volume, bool loop,
                             int priority, AudioCategory category) {
-  std::lock_guard<std::mutex> const lock(queueMutex);
-  eventQueue.emplace(AudioEventType::PLAY_SOUND, soundId, volume, loop,
-                     priority, category);
-  queueCondition.notify_one();
+  enqueueEvent(AudioEvent(AudioEventType::PLAY_SOUND, internResourceId(soundId),
+                          volume, loop, priority, category));
 }
 
 void AudioSystem::playMusic(const std::string &musicId, float volume,
                             bool crossfade) {
-  std::lock_guard<std::mutex> const lock(queueMutex);
-  eventQueue.emplace(AudioEventType::PLAY_MUSIC, musicId, volume);
-  queueCondition.notify_one();
+  enqueueEvent(AudioEvent(AudioEventType::PLAY_MUSIC, internResourceId(musicId),
+                          volume));
 }
 
 void AudioSystem::stopSound(const std::string &soundId) {
-  std::lock_guard<std::mutex> const lock(queueMutex);
-  eventQueue.emplace(AudioEventType::STOP_SOUND, soundId);
-  queueCondition.notify_one();
+  enqueueEvent(
+      AudioEvent(AudioEventType::STOP_SOUND, internResourceId(soundId)));
 }
 
 void AudioSystem::stopMusic() {
-  std::lock_guard<std::mutex> const lock(queueMutex);
-  eventQueue.emplace(AudioEventType::STOP_MUSIC);
-  queueCondition.notify_one();
+  enqueueEvent(AudioEvent(AudioEventType::STOP_MUSIC));
 }
 
 void AudioSystem::setMasterVolume(float volume) {
@@ -150,15 +192,11 @@ void AudioSystem::setVoiceVolume(float volume) {
 }
 
 void AudioSystem::pauseAll() {
-  std::lock_guard<std::mutex> const lock(queueMutex);
-  eventQueue.emplace(AudioEventType::PAUSE);
-  queueCondition.notify_one();
+  enqueueEvent(AudioEvent(AudioEventType::PAUSE));
 }
 
 void AudioSystem::resumeAll() {
-  std::lock_guard<std::mutex> const lock(queueMutex);
-  eventQueue.emplace(AudioEventType::RESUME);
-  queueCondition.notify_one();
+  enqueueEvent(AudioEvent(AudioEventType::RESUME));
 }
 
 auto AudioSystem::loadSound(const std::string &soundId,
@@ -171,7 +209,25 @@ auto AudioSystem::loadSound(const std::string &soundId,
 
   MiniaudioBackend *backend =
       (m_musicPlayer != nullptr) ? m_musicPlayer->getBackend() : nullptr;
-  auto sound = std::make_unique<Sound>(filePath, backend);
+
+  // Prefer the mapped pack entry when it matches the source file: the
+  // decoder then reads the encoded bytes straight out of the mapping.
+  std::span<const std::byte> packed;
+  const QString q_path = QString::fromStdString(filePath);
+  if (soundPack.isOpen()) {
+    QFileInfo const info(q_path);
+    const QDateTime modified = info.lastModified();
+    const auto mtime_ms =
+        modified.isValid()
+            ? static_cast<std::uint64_t>(modified.toMSecsSinceEpoch())
+            : 0U;
+    if (soundPack.stampMatches(
+            q_path, static_cast<std::uint64_t>(info.size()), mtime_ms)) {
+      packed = soundPack.view(q_path);
+    }
+  }
+
+  auto sound = std::make_unique<Sound>(filePath, backend, packed);
   if (!sound || !sound->isLoaded()) {
     return false;
   }
@@ -179,9 +235,181 @@ auto AudioSystem::loadSound(const std::string &soundId,
   sounds[soundId] = std::move(sound);
   soundCategories[soundId] = category;
   activeResources.insert(soundId);
+  soundLastUse[soundId] = ++soundUseCounter;
+  evictOverBudgetLocked();
   return true;
 }
 
+auto AudioSystem::loadSoundManifest(const std::string &manifestPath) -> int {
+  QFile file(QString::fromStdString(manifestPath));
+  if (!file.open(QIODevice::ReadOnly)) {
+    return 0;
+  }
+
+  const QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+  if (!doc.isArray()) {
+    qWarning() << "AudioSystem: manifest is not a JSON array:"
+               << file.fileName();
+    return 0;
+  }
+
+  QDir const base = QFileInfo(file).dir();
+
+  struct ManifestEntry {
+    QString id;
+    QString path;
+    AudioCategory category = AudioCategory::SFX;
+  };
+  std::vector<ManifestEntry> entries;
+  QStringList pack_files;
+  for (const QJsonValue &value : doc.array()) {
+    const QJsonObject entry = value.toObject();
+    const QString id = entry.value(QStringLiteral("id")).toString();
+    const QString rel = entry.value(QStringLiteral("file")).toString();
+    if (id.isEmpty() || rel.isEmpty()) {
+      qWarning() << "AudioSystem: manifest entry missing id or file";
+      continue;
+    }
+
+    const QString category_name =
+        entry.value(QStringLiteral("category")).toString();
+    AudioCategory category = AudioCategory::SFX;
+    if (category_name == QStringLiteral("VOICE")) {
+      category = AudioCategory::VOICE;
+    } else if (category_name == QStringLiteral("MUSIC")) {
+      category = AudioCategory::MUSIC;
+    }
+
+    entries.push_back({id, base.filePath(rel), category});
+    // Music streams from its file and never predecodes, so it stays out
+    // of the pack.
+    if (category != AudioCategory::MUSIC) {
+      pack_files.append(base.filePath(rel));
+    }
+  }
+
+  ensureSoundPack(file.fileName(), pack_files);
+
+  int loaded = 0;
+  for (const auto &entry : entries) {
+    bool const ok =
+        entry.category == AudioCategory::MUSIC
+            ? loadMusic(entry.id.toStdString(), entry.path.toStdString())
+            : loadSound(entry.id.toStdString(), entry.path.toStdString(),
+                        entry.category);
+    if (ok) {
+      ++loaded;
+    } else {
+      qWarning() << "AudioSystem: failed to load manifest entry" << entry.id
+                 << "->" << entry.path;
+    }
+  }
+  return loaded;
+}
+
+void AudioSystem::ensureSoundPack(const QString &manifestPath,
+                                  const QStringList &files) {
+  const QString base =
+      QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+  if (base.isEmpty() || files.isEmpty()) {
+    return;
+  }
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  hash.addData(manifestPath.toUtf8());
+  const QString pack_path = base + QStringLiteral("/audio/") +
+                            QString::fromLatin1(hash.result().toHex()) +
+                            QStringLiteral(".soipack");
+
+  if (soundPack.open(pack_path)) {
+    bool fresh = true;
+    for (const QString &source_path : files) {
+      QFileInfo const info(source_path);
+      const QDateTime modified = info.lastModified();
+      const auto mtime_ms =
+          modified.isValid()
+              ? static_cast<std::uint64_t>(modified.toMSecsSinceEpoch())
+              : 0U;
+      if (!soundPack.stampMatches(
+              source_path, static_cast<std::uint64_t>(info.size()),
+              mtime_ms)) {
+        fresh = false;
+        break;
+      }
+    }
+    if (fresh) {
+      return;
+    }
+    soundPack.close();
+  }
+
+  // First run or stale pack: copy the encoded files into a fresh archive
+  // once, so every later start maps it instead of re-reading each file.
+  Engine::Core::AssetPackWriter writer;
+  for (const QString &source_path : files) {
+    QFile source(source_path);
+    if (!source.open(QIODevice::ReadOnly)) {
+      continue;
+    }
+    QFileInfo const info(source_path);
+    const QDateTime modified = info.lastModified();
+    writer.add(source_path, Engine::Core::AssetPack::Kind::Audio,
+               source.readAll(), static_cast<std::uint64_t>(info.size()),
+               modified.isValid()
+                   ? static_cast<std::uint64_t>(modified.toMSecsSinceEpoch())
+                   : 0U);
+  }
+  if (writer.commit(pack_path)) {
+    (void)soundPack.open(pack_path);
+  }
+}
+
+void AudioSystem::setSoundMemoryBudget(size_t bytes) {
+  std::lock_guard<std::mutex> const lock(resourceMutex);
+  soundMemoryBudget = std::max(size_t(1), bytes);
+  evictOverBudgetLocked();
+}
+
+// Enqueues UNLOAD_RESOURCE for the least recently played sounds until
+// the resident PCM total fits the budget again. resourceMutex held; the
+// unloads land on the audio thread, whose Sound destruction frees the
+// backend PCM. The newest sound is never evicted, so a single oversized
+// file cannot evict itself in a loop.
+void AudioSystem::evictOverBudgetLocked() {
+  size_t total = 0;
+  for (const auto &[sound_id, last_use] : soundLastUse) {
+    auto it = sounds.find(sound_id);
+    if (it != sounds.end()) {
+      total += it->second->decodedBytes();
+    }
+  }
+
+  while (total > soundMemoryBudget && soundLastUse.size() > 1) {
+    auto victim = soundLastUse.end();
+    for (auto it = soundLastUse.begin(); it != soundLastUse.end(); ++it) {
+      if (it->second == soundUseCounter) {
+        continue;
+      }
+      if (victim == soundLastUse.end() || it->second < victim->second) {
+        victim = it;
+      }
+    }
+    if (victim == soundLastUse.end()) {
+      break;
+    }
+
+    auto sound_it = sounds.find(victim->first);
+    size_t const bytes =
+        sound_it != sounds.end() ? sound_it->second->decodedBytes() : 0;
+    enqueueEvent(AudioEvent(AudioEventType::UNLOAD_RESOURCE,
+                            internResourceId(victim->first)));
+    soundLastUse.erase(victim);
+    if (bytes >= total) {
+      break;
+    }
+    total -= bytes;
+  }
+}
+
 auto AudioSystem::loadMusic(const std::string &musicId,
                             const std::string &filePath) -> bool {
   std::lock_guard<std::mutex> const lock(resourceMutex);
@@ -197,23 +425,27 @@ auto AudioSystem::loadMusic(const std::string &musicId,
 }
 
 void AudioSystem::unloadSound(const std::string &soundId) {
-  std::lock_guard<std::mutex> const lock(queueMutex);
-  eventQueue.emplace(AudioEventType::UNLOAD_RESOURCE, soundId);
-  queueCondition.notify_one();
+  enqueueEvent(
+      AudioEvent(AudioEventType::UNLOAD_RESOURCE, internResourceId(soundId)));
 }
 
 void AudioSystem::unloadMusic(const std::string &musicId) {
-  std::lock_guard<std::mutex> const lock(queueMutex);
-  eventQueue.emplace(AudioEventType::UNLOAD_RESOURCE, musicId);
-  queueCondition.notify_one();
+  enqueueEvent(
+      AudioEvent(AudioEventType::UNLOAD_RESOURCE, internResourceId(musicId)));
 }
 
 void AudioSystem::unloadAllSounds() {
-  std::lock_guard<std::mutex> const lock(queueMutex);
-  for (const auto &sound : sounds) {
-    eventQueue.emplace(AudioEventType::UNLOAD_RESOURCE, sound.first);
+  std::vector<AudioResourceId> ids;
+  {
+    std::lock_guard<std::mutex> const lock(resourceMutex);
+    ids.reserve(sounds.size());
+    for (const auto &sound : sounds) {
+      ids.push_back(internResourceId(sound.first));
+    }
+  }
+  for (const AudioResourceId id : ids) {
+    enqueueEvent(AudioEvent(AudioEventType::UNLOAD_RESOURCE, id));
   }
-  queueCondition.notify_one();
 }
 
 void AudioSystem::unloadAllMusic() {
@@ -235,57 +467,61 @@ void AudioSystem::unloadAllMusic() {
   }
 }
 
-void AudioSystem::setMaxChannels(size_t channels) {
-  maxChannels = std::max(size_t(1), channels);
-}
-
 auto AudioSystem::getActiveChannelCount() const -> size_t {
-  std::lock_guard<std::mutex> const lock(activeSoundsMutex);
-  return activeSounds.size();
+  if (m_musicPlayer == nullptr) {
+    return 0;
+  }
+  MiniaudioBackend *backend = m_musicPlayer->getBackend();
+  if (backend == nullptr) {
+    return 0;
+  }
+  return static_cast<size_t>(backend->activeVoiceCount());
 }
 
 void AudioSystem::audioThreadFunc() {
+  Render::ThreadTopology::instance().registerCurrentThread(
+      Render::ThreadTopology::Role::Audio, "audio");
+  Engine::Core::AllocTagScope const alloc_tag(Engine::Core::AllocTag::Audio);
+  // The push counter only ever grows, so sleeping until it moves past the
+  // last observed value cannot miss a wakeup: a push between the drain
+  // and the wait leaves the counter ahead of last_seen and wait() returns
+  // immediately.
+  std::uint32_t last_seen = 0;
   while (isRunning) {
-    std::unique_lock<std::mutex> lock(queueMutex);
-    queueCondition.wait(lock, [this] { return !eventQueue.empty(); });
-
-    while (!eventQueue.empty()) {
-      AudioEvent const event = eventQueue.front();
-      eventQueue.pop();
-      lock.unlock();
+    queuedEventCount.wait(last_seen, std::memory_order_acquire);
+    last_seen = queuedEventCount.load(std::memory_order_acquire);
 
+    AudioEvent event;
+    while (eventQueue.tryPop(event)) {
       processEvent(event);
 
       if (event.type == AudioEventType::SHUTDOWN) {
         isRunning = false;
         return;
       }
-
-      lock.lock();
     }
   }
 }
 
 void AudioSystem::processEvent(const AudioEvent &event) {
+  // Resolve the interned id back to the string key the resource maps use;
+  // done before any lock so the intern mutex never nests inside
+  // resourceMutex.
+  const std::string resource_id = resourceName(event.resourceId);
+
   switch (event.type) {
   case AudioEventType::PLAY_SOUND: {
     std::lock_guard<std::mutex> const lock(resourceMutex);
-    auto it = sounds.find(event.resourceId);
+    auto it = sounds.find(resource_id);
     if (it != sounds.end()) {
-      if (!canPlaySound(event.priority)) {
-        evictLowestPrioritySoundLocked();
-      }
-
+      soundLastUse[resource_id] = ++soundUseCounter;
       float const effective_vol =
           getEffectiveVolume(event.category, event.volume);
-      it->second->play(effective_vol, event.loop);
-
-      {
-        std::lock_guard<std::mutex> const active_lock(activeSoundsMutex);
-        activeSounds.push_back({event.resourceId, event.priority, event.loop,
-                                event.category,
-                                std::chrono::steady_clock::now()});
-      }
+      // Voice limits, per-sound instance caps and priority stealing all
+      // live in the backend pool now, which also retires voices the
+      // moment playback ends.
+      it->second->play(effective_vol, event.loop, event.priority,
+                       event.category);
     }
     break;
   }
@@ -293,23 +529,15 @@ void AudioSystem::processEvent(const AudioEvent &event) {
     std::lock_guard<std::mutex> const lock(resourceMutex);
     if (m_musicPlayer != nullptr) {
       float const effective_volume = masterVolume * musicVolume * event.volume;
-      m_musicPlayer->play(event.resourceId, effective_volume, event.loop);
+      m_musicPlayer->play(resource_id, effective_volume, event.loop);
     }
     break;
   }
   case AudioEventType::STOP_SOUND: {
     std::lock_guard<std::mutex> const lock(resourceMutex);
-    auto it = sounds.find(event.resourceId);
+    auto it = sounds.find(resource_id);
     if (it != sounds.end()) {
       it->second->stop();
-
-      std::lock_guard<std::mutex> const active_lock(activeSoundsMutex);
-      activeSounds.erase(std::remove_if(activeSounds.begin(),
-                                        activeSounds.end(),
-                                        [&](const ActiveSound &as) {
-                                          return as.id == event.resourceId;
-                                        }),
-                         activeSounds.end());
     }
     break;
   }
@@ -336,28 +564,23 @@ void AudioSystem::processEvent(const AudioEvent &event) {
   }
   case AudioEventType::UNLOAD_RESOURCE: {
     std::lock_guard<std::mutex> const lock(resourceMutex);
-    auto sound_it = sounds.find(event.resourceId);
+    auto sound_it = sounds.find(resource_id);
     if (sound_it != sounds.end()) {
       sound_it->second->stop();
 
-      std::lock_guard<std::mutex> const active_lock(activeSoundsMutex);
-      activeSounds.erase(std::remove_if(activeSounds.begin(),
-                                        activeSounds.end(),
-                                        [&](const ActiveSound &as) {
-                                          return as.id == event.resourceId;
-                                        }),
-                         activeSounds.end());
-
       sounds.erase(sound_it);
-      soundCategories.erase(event.resourceId);
-      activeResources.erase(event.resourceId);
+      soundCategories.erase(resource_id);
+      activeResources.erase(resource_id);
+      soundLastUse.erase(resource_id);
     }
 
-    activeResources.erase(event.resourceId);
+    activeResources.erase(resource_id);
     break;
   }
   case AudioEventType::CLEANUP_INACTIVE: {
-    cleanupInactiveSounds();
+    // Obsolete: the backend voice pool frees voices as soon as playback
+    // ends, so there is no shadow list left to prune. Kept in the enum
+    // so queued events from older callers stay harmless.
     break;
   }
   case AudioEventType::SET_VOLUME:
@@ -366,94 +589,6 @@ void AudioSystem::processEvent(const AudioEvent &event) {
   }
 }
 
-auto AudioSystem::canPlaySound(int priority) -> bool {
-  std::lock_guard<std::mutex> const lock(activeSoundsMutex);
-  return activeSounds.size() < maxChannels;
-}
-
-void AudioSystem::evictLowestPrioritySound() {
-  std::string sound_id_to_stop;
-
-  {
-    std::lock_guard<std::mutex> const active_lock(activeSoundsMutex);
-
-    if (activeSounds.empty()) {
-      return;
-    }
-
-    auto lowest_it =
-        std::min_element(activeSounds.begin(), activeSounds.end(),
-                         [](const ActiveSound &a, const ActiveSound &b) {
-                           if (a.priority != b.priority) {
-                             return a.priority < b.priority;
-                           }
-                           return a.startTime < b.startTime;
-                         });
-
-    if (lowest_it != activeSounds.end()) {
-      sound_id_to_stop = lowest_it->id;
-      activeSounds.erase(lowest_it);
-    }
-  }
-
-  if (!sound_id_to_stop.empty()) {
-    std::lock_guard<std::mutex> const resource_lock(resourceMutex);
-    auto it = sounds.find(sound_id_to_stop);
-    if (it != sounds.end()) {
-      it->second->stop();
-    }
-  }
-}
-
-void AudioSystem::evictLowestPrioritySoundLocked() {
-  std::string sound_id_to_stop;
-
-  {
-    std::lock_guard<std::mutex> const active_lock(activeSoundsMutex);
-
-    if (activeSounds.empty()) {
-      return;
-    }
-
-    auto lowest_it =
-        std::min_element(activeSounds.begin(), activeSounds.end(),
-                         [](const ActiveSound &a, const ActiveSound &b) {
-                           if (a.priority != b.priority) {
-                             return a.priority < b.priority;
-                           }
-                           return a.startTime < b.startTime;
-                         });
-
-    if (lowest_it != activeSounds.end()) {
-      sound_id_to_stop = lowest_it->id;
-      activeSounds.erase(lowest_it);
-    }
-  }
-
-  if (!sound_id_to_stop.empty()) {
-    auto it = sounds.find(sound_id_to_stop);
-    if (it != sounds.end()) {
-      it->second->stop();
-    }
-  }
-}
-
-void AudioSystem::cleanupInactiveSounds() {
-  std::lock_guard<std::mutex> const resource_lock(resourceMutex);
-  std::lock_guard<std::mutex> const active_lock(activeSoundsMutex);
-
-  activeSounds.erase(std::remove_if(activeSounds.begin(), activeSounds.end(),
-                                    [this](const ActiveSound &as) {
-                                      if (as.loop) {
-                                        return false;
-                                      }
-
-                                      auto it = sounds.find(as.id);
-                                      return it == sounds.end();
-                                    }),
-                     activeSounds.end());
-}
-
 auto AudioSystem::getEffectiveVolume(AudioCategory category,
                                      float eventVolume) const -> float {
   float category_volume = NAN;
@@ -1,17 +1,18 @@
 #pragma once
 
+#include "AudioCategory.h"
+#include "AudioEventQueue.h"
+#include "../core/asset_pack.h"
+#include <QStringList>
 #include <atomic>
-#include <chrono>
-#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <string>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
-#include <utility>
-#include <vector>
 
 class Sound;
 
@@ -32,19 +33,26 @@ enum class AudioEventType {
   CLEANUP_INACTIVE
 };
 
-enum class AudioCategory { SFX, VOICE, MUSIC };
+// Interned handle for a sound or music resource name; events carry these
+// instead of heap-allocated strings so they stay trivially copyable and
+// fit a lock-free ring slot.
+using AudioResourceId = std::uint16_t;
+inline constexpr AudioResourceId k_invalid_audio_resource = 0xFFFF;
 
 struct AudioEvent {
-  AudioEventType type;
-  std::string resourceId;
+  AudioEventType type = AudioEventType::PLAY_SOUND;
+  AudioResourceId resourceId = k_invalid_audio_resource;
   float volume = 1.0F;
   bool loop = false;
   int priority = 0;
   AudioCategory category = AudioCategory::SFX;
 
-  AudioEvent(AudioEventType t, std::string id = "", float vol = 1.0F,
-             bool l = false, int p = 0, AudioCategory cat = AudioCategory::SFX)
-      : type(t), resourceId(std::move(id)), volume(vol), loop(l), priority(p),
+  AudioEvent() = default;
+  explicit AudioEvent(AudioEventType t,
+                      AudioResourceId id = k_invalid_audio_resource,
+                      float vol = 1.0F, bool l = false, int p = 0,
+                      AudioCategory cat = AudioCategory::SFX)
+      : type(t), resourceId(id), volume(vol), loop(l), priority(p),
         category(cat) {}
 };
 
@@ -73,12 +81,20 @@ public:
                  AudioCategory category = AudioCategory::SFX) -> bool;
   auto loadMusic(const std::string &musicId,
                  const std::string &filePath) -> bool;
+  // Loads every entry of a JSON manifest (array of {id, file, category},
+  // paths relative to the manifest). SFX and voices pre-decode up front
+  // so first plays never hitch; MUSIC entries register for streaming.
+  // Returns the number of resources loaded.
+  auto loadSoundManifest(const std::string &manifestPath) -> int;
+  // Resident PCM ceiling for pre-decoded sounds; exceeding it evicts the
+  // least recently played sounds via UNLOAD_RESOURCE events. Tune per
+  // platform.
+  void setSoundMemoryBudget(size_t bytes);
   void unloadSound(const std::string &soundId);
   void unloadMusic(const std::string &musicId);
   void unloadAllSounds();
   void unloadAllMusic();
 
-  void setMaxChannels(size_t maxChannels);
   auto getActiveChannelCount() const -> size_t;
 
   auto getMasterVolume() const -> float { return masterVolume; }
@@ -86,6 +102,11 @@ public:
   auto getMusicVolume() const -> float { return musicVolume; }
   auto getVoiceVolume() const -> float { return voiceVolume; }
 
+  // Interns a resource name, assigning a new id on first sight. Cheap
+  // enough to call per play, but callers that fire the same sound often
+  // can cache the returned id.
+  auto internResourceId(const std::string &resourceId) -> AudioResourceId;
+
 private:
   AudioSystem();
   ~AudioSystem();
@@ -95,40 +116,54 @@ private:
 
   void audioThreadFunc();
   void processEvent(const AudioEvent &event);
-  void cleanupInactiveSounds();
-  auto canPlaySound(int priority) -> bool;
-  void evictLowestPrioritySound();
-  void evictLowestPrioritySoundLocked();
+  void enqueueEvent(const AudioEvent &event);
+  [[nodiscard]] auto resourceName(AudioResourceId id) const -> std::string;
+  void evictOverBudgetLocked();
+  // Opens the mapped sound pack for this manifest's files, rebuilding it
+  // under the user cache dir when any source changed; loadSound then
+  // decodes straight from the mapping.
+  void ensureSoundPack(const QString &manifestPath, const QStringList &files);
   auto getEffectiveVolume(AudioCategory category,
                           float eventVolume) const -> float;
 
   std::unordered_map<std::string, std::unique_ptr<Sound>> sounds;
   std::unordered_map<std::string, AudioCategory> soundCategories;
   std::unordered_set<std::string> activeResources;
+  // LRU bookkeeping for the pre-decoded SFX budget; counter bumps on
+  // load and on every play, all under resourceMutex.
+  std::unordered_map<std::string, std::uint64_t> soundLastUse;
+  std::uint64_t soundUseCounter{0};
+  size_t soundMemoryBudget{32UL * 1024UL * 1024UL};
   mutable std::mutex resourceMutex;
 
+  // Mapped archive of the manifest's encoded sound files, keyed by source
+  // path; views into it feed the decoder with zero copies and let the OS
+  // page cache persist the bytes across restarts.
+  Engine::Core::AssetPack soundPack;
+
   Game::Audio::MusicPlayer *m_musicPlayer{nullptr};
 
+  // Sized for the worst battle bursts observed plus headroom; overflow
+  // drops SFX plays (see enqueueEvent), never control events.
+  static constexpr std::size_t k_event_queue_capacity = 512;
+
   std::thread audioThread;
-  std::queue<AudioEvent> eventQueue;
-  mutable std::mutex queueMutex;
-  std::condition_variable queueCondition;
+  Game::Audio::AudioEventQueue<AudioEvent, k_event_queue_capacity> eventQueue;
+  // Monotonic push counter; the audio thread waits on it (C++20 atomic
+  // wait) instead of a mutex + condition variable, so producers never
+  // block behind the consumer.
+  std::atomic<std::uint32_t> queuedEventCount{0};
+  std::atomic<std::uint32_t> droppedSfxCount{0};
   std::atomic<bool> isRunning;
 
+  // Append-only intern table. Names are stored in a deque so references
+  // stay valid as it grows; ids are never reused, even after unload.
+  mutable std::mutex internMutex;
+  std::unordered_map<std::string, AudioResourceId> resourceIdsByName;
+  std::deque<std::string> resourceNames;
+
   std::atomic<float> masterVolume;
   std::atomic<float> soundVolume;
   std::atomic<float> musicVolume;
   std::atomic<float> voiceVolume;
-
-  size_t maxChannels{32};
-
-  struct ActiveSound {
-    std::string id;
-    int priority;
-    bool loop;
-    AudioCategory category;
-    std::chrono::steady_clock::time_point startTime;
-  };
-  std::vector<ActiveSound> activeSounds;
-  mutable std::mutex activeSoundsMutex;
 };
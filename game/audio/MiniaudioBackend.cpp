@@ -23,6 +23,38 @@
 #define MA_ENABLE_VORBIS
 #include <miniaudio.h>
 
+namespace {
+
+// Fixed voice pool size; the mixer cost is bounded by this no matter how
+// many plays the game requests per frame.
+constexpr int k_sound_voices = 32;
+
+// A single sound retriggered en masse (volleys of arrow hits) adds
+// nothing audible past a few overlapping instances; beyond this cap the
+// oldest instance of the same sound is restarted instead of taking
+// another voice.
+constexpr int k_max_instances_per_sound = 4;
+
+// Frames decoded per streamed-read chunk inside the mixer callback.
+constexpr unsigned k_stream_scratch_frames = 4096;
+
+// How much of the pool each category may hold. VOICE lines are few but
+// must not be crowded out by battle SFX; MUSIC normally runs on the
+// dedicated fade channels and only lands here if misrouted.
+auto categoryVoiceCap(AudioCategory category) -> int {
+  switch (category) {
+  case AudioCategory::SFX:
+    return 24;
+  case AudioCategory::VOICE:
+    return 6;
+  case AudioCategory::MUSIC:
+    return 2;
+  }
+  return 24;
+}
+
+} // namespace
+
 struct DeviceWrapper {
   MiniaudioBackend *self;
 };
@@ -71,11 +103,13 @@ auto MiniaudioBackend::initialize(int deviceRate, int outChannels,
     ch = Channel{};
   }
 
-  m_soundEffects.resize(32);
+  m_soundEffects.resize(k_sound_voices);
   for (auto &sfx : m_soundEffects) {
     sfx = SoundEffect{};
   }
 
+  m_streamScratch.resize(int(k_stream_scratch_frames) * 2);
+
   if (ma_device_start(m_device) != MA_SUCCESS) {
     qWarning() << "MiniaudioBackend: Failed to start audio device";
     ma_device_uninit(m_device);
@@ -96,9 +130,21 @@ void MiniaudioBackend::shutdown() {
   QMutexLocker const lk(&m_mutex);
   stopDevice();
   m_tracks.clear();
+  m_streamPaths.clear();
+  for (auto &ch : m_channels) {
+    releaseChannelDecoder(ch);
+  }
   m_channels.clear();
 }
 
+void MiniaudioBackend::releaseChannelDecoder(Channel &channel) {
+  if (channel.decoder != nullptr) {
+    ma_decoder_uninit(channel.decoder);
+    delete channel.decoder;
+    channel.decoder = nullptr;
+  }
+}
+
 void MiniaudioBackend::stopDevice() {
   if (m_device == nullptr) {
     return;
@@ -111,19 +157,11 @@ void MiniaudioBackend::stopDevice() {
   delete wrap;
 }
 
-auto MiniaudioBackend::predecode(const QString &id,
-                                 const QString &path) -> bool {
-
-  ma_decoder_config const dc =
-      ma_decoder_config_init(ma_format_f32, m_outCh, m_rate);
-  ma_decoder dec;
-  if (ma_decoder_init_file(path.toUtf8().constData(), &dc, &dec) !=
-      MA_SUCCESS) {
-    qWarning() << "miniaudio: cannot open" << path;
-    return false;
-  }
+namespace {
 
-  QVector<float> pcm;
+// Drains an initialized decoder into interleaved f32 PCM; uninits the
+// decoder in every path.
+auto drainDecoder(ma_decoder &dec, QVector<float> &pcm) -> bool {
   float buffer[4096 * 2];
   for (;;) {
     ma_uint64 frames_read = 0;
@@ -144,6 +182,27 @@ auto MiniaudioBackend::predecode(const QString &id,
     }
   }
   ma_decoder_uninit(&dec);
+  return true;
+}
+
+} // namespace
+
+auto MiniaudioBackend::predecode(const QString &id,
+                                 const QString &path) -> bool {
+
+  ma_decoder_config const dc =
+      ma_decoder_config_init(ma_format_f32, m_outCh, m_rate);
+  ma_decoder dec;
+  if (ma_decoder_init_file(path.toUtf8().constData(), &dc, &dec) !=
+      MA_SUCCESS) {
+    qWarning() << "miniaudio: cannot open" << path;
+    return false;
+  }
+
+  QVector<float> pcm;
+  if (!drainDecoder(dec, pcm)) {
+    return false;
+  }
 
   QMutexLocker const lk(&m_mutex);
   DecodedTrack t;
@@ -153,27 +212,103 @@ auto MiniaudioBackend::predecode(const QString &id,
   return true;
 }
 
+auto MiniaudioBackend::predecodeMemory(const QString &id, const void *data,
+                                       size_t bytes) -> bool {
+  if (data == nullptr || bytes == 0) {
+    return false;
+  }
+
+  ma_decoder_config const dc =
+      ma_decoder_config_init(ma_format_f32, m_outCh, m_rate);
+  ma_decoder dec;
+  if (ma_decoder_init_memory(data, bytes, &dc, &dec) != MA_SUCCESS) {
+    qWarning() << "miniaudio: cannot decode in-memory track" << id;
+    return false;
+  }
+
+  QVector<float> pcm;
+  if (!drainDecoder(dec, pcm)) {
+    return false;
+  }
+
+  QMutexLocker const lk(&m_mutex);
+  DecodedTrack t;
+  t.frames = pcm.size() / 2;
+  t.pcm = std::move(pcm);
+  m_tracks[id] = std::move(t);
+  return true;
+}
+
+void MiniaudioBackend::registerStream(const QString &id, const QString &path) {
+  QMutexLocker const lk(&m_mutex);
+  m_streamPaths[id] = path;
+}
+
+auto MiniaudioBackend::trackBytes(const QString &id) const -> size_t {
+  QMutexLocker const lk(&m_mutex);
+  auto it = m_tracks.find(id);
+  if (it == m_tracks.end()) {
+    return 0;
+  }
+  return size_t(it.value().pcm.size()) * sizeof(float);
+}
+
+void MiniaudioBackend::dropTrack(const QString &id) {
+  QMutexLocker const lk(&m_mutex);
+  auto it = m_tracks.find(id);
+  if (it == m_tracks.end()) {
+    return;
+  }
+  const DecodedTrack *track = &it.value();
+  for (auto &sfx : m_soundEffects) {
+    if (sfx.track == track) {
+      sfx.track = nullptr;
+      sfx.active = false;
+    }
+  }
+  for (auto &ch : m_channels) {
+    if (ch.track == track) {
+      ch.track = nullptr;
+      ch.active = false;
+    }
+  }
+  m_tracks.erase(it);
+}
+
 void MiniaudioBackend::play(int channel, const QString &id, float volume,
                             bool loop, int fadeMs) {
-  QMutexLocker lk(&m_mutex);
+  QMutexLocker const lk(&m_mutex);
   if (channel < 0 || channel >= m_channels.size()) {
     return;
   }
-  auto it = m_tracks.find(id);
-  if (it == m_tracks.end()) {
-    lk.unlock();
 
-    predecode(id, id);
-    lk.relock();
-    it = m_tracks.find(id);
-    if (it == m_tracks.end()) {
+  auto &ch = m_channels[channel];
+  releaseChannelDecoder(ch);
+  ch.track = nullptr;
+
+  auto it = m_tracks.find(id);
+  if (it != m_tracks.end()) {
+    ch.track = &it.value();
+  } else {
+    // Not preloaded: open a streaming decoder instead of pulling the
+    // whole file into RAM. Registered stream ids map to their path;
+    // otherwise treat the id itself as a path, which is what legacy
+    // callers passed here.
+    auto stream_it = m_streamPaths.find(id);
+    QString const path = stream_it != m_streamPaths.end() ? stream_it.value()
+                                                          : id;
+    ma_decoder_config const dc =
+        ma_decoder_config_init(ma_format_f32, m_outCh, m_rate);
+    auto *decoder = new ma_decoder();
+    if (ma_decoder_init_file(path.toUtf8().constData(), &dc, decoder) !=
+        MA_SUCCESS) {
+      delete decoder;
       qWarning() << "MiniaudioBackend: unknown track" << id;
       return;
     }
+    ch.decoder = decoder;
   }
 
-  auto &ch = m_channels[channel];
-  ch.track = &it.value();
   ch.framePos = 0;
   ch.looping = loop;
   ch.paused = false;
@@ -271,7 +406,8 @@ auto MiniaudioBackend::channelPlaying(int channel) const -> bool {
   return ch.active && !ch.paused;
 }
 
-void MiniaudioBackend::playSound(const QString &id, float volume, bool loop) {
+void MiniaudioBackend::playSound(const QString &id, float volume, bool loop,
+                                 int priority, AudioCategory category) {
   QMutexLocker const lk(&m_mutex);
 
   auto it = m_tracks.find(id);
@@ -280,20 +416,53 @@ void MiniaudioBackend::playSound(const QString &id, float volume, bool loop) {
     return;
   }
 
-  int const slot = findFreeSoundSlot();
+  int const slot = acquireVoiceSlot(id, priority, category);
   if (slot < 0) {
-    qWarning() << "MiniaudioBackend: No free sound slots available";
+    // Every voice the pool would let this play take is busy with
+    // something higher priority; dropping here is the flat-cost path, so
+    // just count it rather than log per request.
+    ++m_droppedVoices;
     return;
   }
 
   auto &sfx = m_soundEffects[slot];
   sfx.track = &it.value();
+  sfx.id = id;
   sfx.framePos = 0;
   sfx.volume = std::clamp(volume, 0.0F, 1.0F);
+  sfx.priority = priority;
+  sfx.category = category;
+  sfx.serial = ++m_voiceSerial;
   sfx.looping = loop;
   sfx.active = true;
 }
 
+void MiniaudioBackend::stopSound(const QString &id) {
+  QMutexLocker const lk(&m_mutex);
+  for (auto &sfx : m_soundEffects) {
+    if (sfx.active && sfx.id == id) {
+      sfx.active = false;
+      sfx.looping = false;
+    }
+  }
+}
+
+auto MiniaudioBackend::activeVoiceCount() const -> int {
+  QMutexLocker const lk(&m_mutex);
+  int count = 0;
+  for (const auto &sfx : m_soundEffects) {
+    if (sfx.active) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+auto MiniaudioBackend::droppedVoiceCount() const -> quint64 {
+  QMutexLocker const lk(&m_mutex);
+  return m_droppedVoices;
+}
+
 auto MiniaudioBackend::findFreeSoundSlot() const -> int {
   for (int i = 0; i < m_soundEffects.size(); ++i) {
     if (!m_soundEffects[i].active) {
@@ -303,6 +472,64 @@ auto MiniaudioBackend::findFreeSoundSlot() const -> int {
   return -1;
 }
 
+// Picks the voice a new play may use, mutex held. Order of preference:
+// restart the oldest instance of the same sound once its instance cap is
+// hit, then a free slot while the category is under its cap, then steal
+// the least important voice (lowest priority, oldest on ties) that is
+// not more important than the incoming play. Returns -1 when nothing
+// can be taken.
+auto MiniaudioBackend::acquireVoiceSlot(const QString &id, int priority,
+                                        AudioCategory category) -> int {
+  int same_sound_count = 0;
+  int oldest_same_sound = -1;
+  int category_count = 0;
+  int steal_in_category = -1;
+  int steal_any = -1;
+
+  for (int i = 0; i < m_soundEffects.size(); ++i) {
+    const auto &sfx = m_soundEffects[i];
+    if (!sfx.active) {
+      continue;
+    }
+    if (sfx.id == id) {
+      ++same_sound_count;
+      if (oldest_same_sound < 0 ||
+          sfx.serial < m_soundEffects[oldest_same_sound].serial) {
+        oldest_same_sound = i;
+      }
+    }
+    if (sfx.category == category) {
+      ++category_count;
+    }
+    if (sfx.priority <= priority) {
+      auto better = [this, &sfx](int current) {
+        return current < 0 ||
+               sfx.priority < m_soundEffects[current].priority ||
+               (sfx.priority == m_soundEffects[current].priority &&
+                sfx.serial < m_soundEffects[current].serial);
+      };
+      if (better(steal_any)) {
+        steal_any = i;
+      }
+      if (sfx.category == category && better(steal_in_category)) {
+        steal_in_category = i;
+      }
+    }
+  }
+
+  if (same_sound_count >= k_max_instances_per_sound) {
+    return oldest_same_sound;
+  }
+  if (category_count >= categoryVoiceCap(category)) {
+    return steal_in_category;
+  }
+  int const free_slot = findFreeSoundSlot();
+  if (free_slot >= 0) {
+    return free_slot;
+  }
+  return steal_any;
+}
+
 void MiniaudioBackend::onAudio(float *out, unsigned frames) {
 
   const unsigned samples = frames * 2;
@@ -311,7 +538,56 @@ void MiniaudioBackend::onAudio(float *out, unsigned frames) {
   QMutexLocker const lk(&m_mutex);
 
   for (auto &ch : m_channels) {
-    if (!ch.active || ch.paused || ch.track == nullptr) {
+    if (!ch.active || ch.paused ||
+        (ch.track == nullptr && ch.decoder == nullptr)) {
+      continue;
+    }
+
+    if (ch.decoder != nullptr) {
+      // Streamed music: decode chunk-wise into the preallocated scratch
+      // and mix with the same per-sample fade stepping as preloaded
+      // tracks. File reads happen here on the audio thread by design.
+      unsigned frames_left = frames;
+      float *dst = out;
+      bool wrapped = false;
+      while (frames_left > 0) {
+        unsigned const want = std::min(frames_left, k_stream_scratch_frames);
+        ma_uint64 got = 0;
+        ma_decoder_read_pcm_frames(ch.decoder, m_streamScratch.data(), want,
+                                   &got);
+        if (got == 0) {
+          if (ch.looping && !wrapped &&
+              ma_decoder_seek_to_pcm_frame(ch.decoder, 0) == MA_SUCCESS) {
+            wrapped = true;
+            continue;
+          }
+          ch.active = false;
+          break;
+        }
+        wrapped = false;
+        const float *src = m_streamScratch.constData();
+        for (unsigned i = 0; i < unsigned(got); ++i) {
+          const float vol = ch.curVol * m_masterVol;
+          dst[0] += src[0] * vol;
+          dst[1] += src[1] * vol;
+          dst += 2;
+          src += 2;
+
+          if (ch.fade_samples > 0) {
+            ch.curVol += ch.volStep;
+            --ch.fade_samples;
+            if (ch.fade_samples == 0) {
+              ch.curVol = ch.tgtVol;
+            }
+          }
+        }
+        frames_left -= unsigned(got);
+      }
+
+      if (ch.fade_samples == 0 && ch.curVol == 0.0F && ch.tgtVol == 0.0F &&
+          !ch.looping) {
+        ch.active = false;
+      }
       continue;
     }
 
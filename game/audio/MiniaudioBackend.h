@@ -1,12 +1,15 @@
 #pragma once
+#include "AudioCategory.h"
 #include <QMap>
 #include <QMutex>
 #include <QObject>
 #include <QString>
 #include <QVector>
 #include <atomic>
+#include <cstddef>
 
 struct ma_device;
+struct ma_decoder;
 
 class MiniaudioBackend : public QObject {
   Q_OBJECT
@@ -19,6 +22,24 @@ public:
 
   auto predecode(const QString &id, const QString &path) -> bool;
 
+  // Predecode straight from caller-owned bytes (a mapped asset-pack
+  // view); the bytes are only read during this call, so no intermediate
+  // file or QByteArray copy is made.
+  auto predecodeMemory(const QString &id, const void *data,
+                       size_t bytes) -> bool;
+
+  // Registers a track for chunked decode in the mixer callback instead
+  // of predecoding the whole file; the right path for music, whose PCM
+  // would otherwise dominate audio memory.
+  void registerStream(const QString &id, const QString &path);
+
+  // Decoded PCM size of a preloaded track, 0 for unknown or streamed.
+  auto trackBytes(const QString &id) const -> size_t;
+
+  // Frees a preloaded track's PCM, silencing any voice or channel still
+  // playing it.
+  void dropTrack(const QString &id);
+
   void play(int channel, const QString &id, float volume, bool loop,
             int fadeMs);
   void stop(int channel, int fadeMs);
@@ -31,7 +52,13 @@ public:
   auto anyChannelPlaying() const -> bool;
   auto channelPlaying(int channel) const -> bool;
 
-  void playSound(const QString &id, float volume, bool loop = false);
+  void playSound(const QString &id, float volume, bool loop = false,
+                 int priority = 0,
+                 AudioCategory category = AudioCategory::SFX);
+  void stopSound(const QString &id);
+
+  auto activeVoiceCount() const -> int;
+  auto droppedVoiceCount() const -> quint64;
 
   void onAudio(float *out, unsigned frames);
 
@@ -43,6 +70,9 @@ private:
 
   struct Channel {
     const DecodedTrack *track = nullptr;
+    // Set instead of track for streamed music; owned by the channel and
+    // released on reuse or shutdown, never inside the mixer callback.
+    ma_decoder *decoder = nullptr;
     unsigned framePos = 0;
     float curVol = 0.0F;
     float tgtVol = 1.0F;
@@ -53,17 +83,28 @@ private:
     bool active = false;
   };
 
+  // One voice of the fixed pool. Voices carry the track id plus the
+  // priority and category they were started with so playSound can steal
+  // the least important one when the pool saturates instead of
+  // allocating or silently dropping everything.
   struct SoundEffect {
     const DecodedTrack *track = nullptr;
+    QString id;
     unsigned framePos = 0;
     float volume = 1.0F;
+    int priority = 0;
+    AudioCategory category = AudioCategory::SFX;
+    quint64 serial = 0;
     bool looping = false;
     bool active = false;
   };
 
   void startDevice();
   void stopDevice();
+  void releaseChannelDecoder(Channel &channel);
   auto findFreeSoundSlot() const -> int;
+  auto acquireVoiceSlot(const QString &id, int priority,
+                        AudioCategory category) -> int;
 
   ma_device *m_device{nullptr};
   int m_rate{48000};
@@ -71,7 +112,13 @@ private:
 
   mutable QMutex m_mutex;
   QMap<QString, DecodedTrack> m_tracks;
+  QMap<QString, QString> m_streamPaths;
   QVector<Channel> m_channels;
+  // Mixer-callback scratch for streamed reads; sized up front so the
+  // callback never allocates.
+  QVector<float> m_streamScratch;
   QVector<SoundEffect> m_soundEffects;
+  quint64 m_voiceSerial{0};
+  quint64 m_droppedVoices{0};
   float m_masterVol{1.0F};
 };
@@ -103,13 +103,11 @@ void MusicPlayer::registerTrack(const std::string &trackId,
   m_tracks[trackId] = fi.absoluteFilePath();
 
   if (m_backend != nullptr) {
-    if (!m_backend->predecode(QString::fromStdString(trackId),
-                              fi.absoluteFilePath())) {
-      qWarning() << "MusicPlayer: predecode failed for"
-                 << fi.absoluteFilePath();
-    } else {
-      qDebug() << "MusicPlayer: predecoded" << fi.absoluteFilePath();
-    }
+    // Music is streamed chunk-by-chunk at playback time; registering
+    // only records the path, so load cost and resident memory stay flat
+    // no matter how many tracks a level ships.
+    m_backend->registerStream(QString::fromStdString(trackId),
+                              fi.absoluteFilePath());
   }
 }
 
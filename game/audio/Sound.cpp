@@ -10,14 +10,23 @@
 #include <qstringview.h>
 #include <string>
 
-Sound::Sound(const std::string &filePath, MiniaudioBackend *backend)
-    : QObject(nullptr), m_filepath(filePath), m_backend(backend),
-      m_loaded(false), m_volume(1.0F) {
+Sound::Sound(const std::string &filePath, MiniaudioBackend *backend,
+             std::span<const std::byte> packedBytes)
+    : QObject(nullptr), m_filepath(filePath), m_packedBytes(packedBytes),
+      m_backend(backend), m_loaded(false), m_volume(1.0F) {
 
   QByteArray const hash = QCryptographicHash::hash(
       QByteArray::fromStdString(filePath), QCryptographicHash::Md5);
   m_trackId = "sound_" + QString(hash.toHex());
 
+  if (!m_packedBytes.empty()) {
+    if (m_backend != nullptr) {
+      m_loaded = m_backend->predecodeMemory(m_trackId, m_packedBytes.data(),
+                                            m_packedBytes.size());
+    }
+    return;
+  }
+
   QFileInfo const fi(QString::fromStdString(m_filepath));
   if (!fi.exists()) {
     qWarning() << "Sound: File does not exist:" << fi.absoluteFilePath();
@@ -32,7 +41,20 @@ Sound::Sound(const std::string &filePath, MiniaudioBackend *backend)
   }
 }
 
-Sound::~Sound() = default;
+Sound::~Sound() {
+  // Unloading a Sound frees its decoded PCM; the backend silences any
+  // voice still playing it.
+  if ((m_backend != nullptr) && m_loaded) {
+    m_backend->dropTrack(m_trackId);
+  }
+}
+
+auto Sound::decodedBytes() const -> size_t {
+  if ((m_backend == nullptr) || !m_loaded) {
+    return 0;
+  }
+  return m_backend->trackBytes(m_trackId);
+}
 
 void Sound::setBackend(MiniaudioBackend *backend) {
   if (m_backend == backend) {
@@ -42,6 +64,11 @@ void Sound::setBackend(MiniaudioBackend *backend) {
   m_backend = backend;
 
   if ((m_backend != nullptr) && !m_loaded) {
+    if (!m_packedBytes.empty()) {
+      m_loaded = m_backend->predecodeMemory(m_trackId, m_packedBytes.data(),
+                                            m_packedBytes.size());
+      return;
+    }
     QFileInfo const fi(QString::fromStdString(m_filepath));
     if (fi.exists()) {
       m_loaded = m_backend->predecode(m_trackId, fi.absoluteFilePath());
@@ -51,19 +78,21 @@ void Sound::setBackend(MiniaudioBackend *backend) {
 
 auto Sound::isLoaded() const -> bool { return m_loaded.load(); }
 
-void Sound::play(float volume, bool loop) {
+void Sound::play(float volume, bool loop, int priority,
+                 AudioCategory category) {
   if ((m_backend == nullptr) || !m_loaded) {
     qWarning() << "Sound: Cannot play - backend not available or not loaded";
     return;
   }
 
   m_volume = volume;
-  m_backend->playSound(m_trackId, volume, loop);
-
-  qDebug() << "Sound: Playing" << QString::fromStdString(m_filepath)
-           << "volume:" << volume << "loop:" << loop;
+  m_backend->playSound(m_trackId, volume, loop, priority, category);
 }
 
-void Sound::stop() {}
+void Sound::stop() {
+  if (m_backend != nullptr) {
+    m_backend->stopSound(m_trackId);
+  }
+}
 
 void Sound::setVolume(float volume) { m_volume = volume; }
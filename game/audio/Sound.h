@@ -1,8 +1,11 @@
 #pragma once
 
+#include "AudioCategory.h"
 #include <QObject>
 #include <atomic>
+#include <cstddef>
 #include <memory>
+#include <span>
 #include <string>
 
 class MiniaudioBackend;
@@ -10,12 +13,20 @@ class MiniaudioBackend;
 class Sound : public QObject {
   Q_OBJECT
 public:
+  // `packedBytes` is an optional zero-copy view of the encoded file (a
+  // mapped asset-pack entry); when non-empty the decoder reads it
+  // directly and the file path is only kept for diagnostics. The view
+  // must stay valid for the Sound's lifetime.
   explicit Sound(const std::string &filePath,
-                 MiniaudioBackend *backend = nullptr);
+                 MiniaudioBackend *backend = nullptr,
+                 std::span<const std::byte> packedBytes = {});
   ~Sound() override;
 
   [[nodiscard]] auto isLoaded() const -> bool;
-  void play(float volume = 1.0F, bool loop = false);
+  // Resident size of the pre-decoded PCM; feeds the SFX memory budget.
+  [[nodiscard]] auto decodedBytes() const -> size_t;
+  void play(float volume = 1.0F, bool loop = false, int priority = 0,
+            AudioCategory category = AudioCategory::SFX);
   void stop();
   void setVolume(float volume);
 
@@ -23,6 +34,7 @@ public:
 
 private:
   std::string m_filepath;
+  std::span<const std::byte> m_packedBytes;
   QString m_trackId;
   MiniaudioBackend *m_backend;
   std::atomic<bool> m_loaded;
@@ -0,0 +1,179 @@
+#include "alloc_tracker.h"
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace Engine::Core {
+
+namespace {
+
+constinit std::atomic<bool> g_enabled{false};
+
+thread_local AllocTag t_currentTag = AllocTag::Untagged;
+
+struct AtomicCounters {
+  std::atomic<std::uint64_t> allocations{0};
+  std::atomic<std::uint64_t> bytes{0};
+};
+
+constinit std::array<AtomicCounters, AllocTracker::k_tag_count>
+    g_frameCounters{};
+
+std::array<AllocTracker::TagCounters, AllocTracker::k_tag_count> g_lastFrame{};
+
+constexpr std::array<const char *, AllocTracker::k_tag_count> k_tag_names = {
+    "untagged", "ecs", "pathfinding", "render", "ai", "audio",
+};
+
+} // namespace
+
+void AllocTracker::setEnabled(bool enabled) {
+  g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+auto AllocTracker::enabled() -> bool {
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+void AllocTracker::recordAllocation(std::size_t bytes) {
+  if (!enabled()) {
+    return;
+  }
+  auto &counters = g_frameCounters[static_cast<std::size_t>(t_currentTag)];
+  counters.allocations.fetch_add(1, std::memory_order_relaxed);
+  counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void AllocTracker::beginFrame() {
+  for (std::size_t i = 0; i < k_tag_count; ++i) {
+    g_lastFrame[i].allocations =
+        g_frameCounters[i].allocations.exchange(0, std::memory_order_relaxed);
+    g_lastFrame[i].bytes =
+        g_frameCounters[i].bytes.exchange(0, std::memory_order_relaxed);
+  }
+}
+
+auto AllocTracker::lastFrame(AllocTag tag) -> TagCounters {
+  return g_lastFrame[static_cast<std::size_t>(tag)];
+}
+
+auto AllocTracker::tagName(AllocTag tag) -> const char * {
+  return k_tag_names[static_cast<std::size_t>(tag)];
+}
+
+AllocTagScope::AllocTagScope(AllocTag tag) : m_previous(t_currentTag) {
+  t_currentTag = tag;
+}
+
+AllocTagScope::~AllocTagScope() { t_currentTag = m_previous; }
+
+} // namespace Engine::Core
+
+// Global overrides so every heap allocation in the process — Qt and
+// driver threads included — is attributed. Deallocation is left
+// untracked on purpose: the HUD is after allocation storms, not leaks,
+// and sized/aligned delete variance across libraries makes freed-byte
+// accounting unreliable.
+
+namespace {
+
+auto alignedAlloc(std::size_t size, std::size_t alignment) -> void * {
+#if defined(_MSC_VER)
+  return _aligned_malloc(size, alignment);
+#else
+  return std::aligned_alloc(alignment,
+                            (size + alignment - 1) / alignment * alignment);
+#endif
+}
+
+void alignedFree(void *ptr) {
+#if defined(_MSC_VER)
+  _aligned_free(ptr);
+#else
+  std::free(ptr);
+#endif
+}
+
+auto trackedAlloc(std::size_t size, std::size_t alignment) -> void * {
+  void *ptr = alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__
+                  ? alignedAlloc(size, alignment)
+                  : std::malloc(size);
+  if (ptr != nullptr) {
+    Engine::Core::AllocTracker::recordAllocation(size);
+  }
+  return ptr;
+}
+
+} // namespace
+
+auto operator new(std::size_t size) -> void * {
+  void *ptr = trackedAlloc(size, 0);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+auto operator new[](std::size_t size) -> void * {
+  void *ptr = trackedAlloc(size, 0);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+auto operator new(std::size_t size, std::align_val_t alignment) -> void * {
+  void *ptr = trackedAlloc(size, static_cast<std::size_t>(alignment));
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+auto operator new[](std::size_t size, std::align_val_t alignment) -> void * {
+  void *ptr = trackedAlloc(size, static_cast<std::size_t>(alignment));
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+auto operator new(std::size_t size, const std::nothrow_t & /*tag*/) noexcept
+    -> void * {
+  return trackedAlloc(size, 0);
+}
+
+auto operator new[](std::size_t size, const std::nothrow_t & /*tag*/) noexcept
+    -> void * {
+  return trackedAlloc(size, 0);
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t /*size*/) noexcept {
+  std::free(ptr);
+}
+void operator delete[](void *ptr, std::size_t /*size*/) noexcept {
+  std::free(ptr);
+}
+void operator delete(void *ptr, std::align_val_t /*alignment*/) noexcept {
+  alignedFree(ptr);
+}
+void operator delete[](void *ptr, std::align_val_t /*alignment*/) noexcept {
+  alignedFree(ptr);
+}
+void operator delete(void *ptr, std::size_t /*size*/,
+                     std::align_val_t /*alignment*/) noexcept {
+  alignedFree(ptr);
+}
+void operator delete[](void *ptr, std::size_t /*size*/,
+                       std::align_val_t /*alignment*/) noexcept {
+  alignedFree(ptr);
+}
+void operator delete(void *ptr, const std::nothrow_t & /*tag*/) noexcept {
+  std::free(ptr);
+}
+void operator delete[](void *ptr, const std::nothrow_t & /*tag*/) noexcept {
+  std::free(ptr);
+}
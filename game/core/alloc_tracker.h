@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Engine::Core {
+
+// Subsystem attribution for heap traffic. The global operator new
+// override in alloc_tracker.cpp charges every allocation to the tag the
+// calling thread currently carries; scopes nest, and threads that never
+// set one count as Untagged.
+enum class AllocTag : std::uint8_t {
+  Untagged = 0,
+  Ecs,
+  Pathfinding,
+  Render,
+  Ai,
+  Audio,
+  Count,
+};
+
+// Per-tag allocation/byte counters, reset once per frame. All storage is
+// constinit atomics at namespace scope so the operator new override is
+// safe from any thread at any point of static initialization; when
+// tracking is disabled an allocation costs one relaxed atomic load.
+class AllocTracker {
+public:
+  static constexpr std::size_t k_tag_count =
+      static_cast<std::size_t>(AllocTag::Count);
+
+  struct TagCounters {
+    std::uint64_t allocations = 0;
+    std::uint64_t bytes = 0;
+  };
+
+  static void setEnabled(bool enabled);
+  [[nodiscard]] static auto enabled() -> bool;
+
+  // Called by the operator new overrides; charges the current thread's
+  // tag.
+  static void recordAllocation(std::size_t bytes);
+
+  // Snapshots and resets the per-frame counters; call once per frame.
+  static void beginFrame();
+
+  [[nodiscard]] static auto lastFrame(AllocTag tag) -> TagCounters;
+  [[nodiscard]] static auto tagName(AllocTag tag) -> const char *;
+};
+
+// Charges allocations on this thread to `tag` until destruction;
+// restores the enclosing tag on exit.
+class AllocTagScope {
+public:
+  explicit AllocTagScope(AllocTag tag);
+  ~AllocTagScope();
+
+  AllocTagScope(const AllocTagScope &) = delete;
+  auto operator=(const AllocTagScope &) -> AllocTagScope & = delete;
+  AllocTagScope(AllocTagScope &&) = delete;
+  auto operator=(AllocTagScope &&) -> AllocTagScope & = delete;
+
+private:
+  AllocTag m_previous;
+};
+
+} // namespace Engine::Core
@@ -0,0 +1,221 @@
+#include "asset_pack.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QIODevice>
+#include <QSaveFile>
+#include <cstring>
+
+namespace Engine::Core {
+
+namespace {
+
+using std::uint32_t;
+using std::uint64_t;
+
+constexpr uint32_t k_magic = 0x5049'4F53U; // "SOIP" on disk, little-endian
+constexpr uint32_t k_version = 1U;
+
+// Payload alignment: generous enough for GL staging copies and SIMD
+// decoders, and a multiple of every record size below.
+constexpr uint64_t k_payload_align = 64U;
+
+// All records are trivially copyable so a mapped pack is decoded straight
+// from the mapping without per-entry allocation.
+struct PackHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t entryCount;
+  uint32_t reserved;
+};
+
+struct PackEntry {
+  uint32_t kind;
+  uint32_t nameOffset; // into the name blob following the entry table
+  uint32_t nameLength;
+  uint32_t reserved;
+  uint64_t offset; // from the start of the file, k_payload_align aligned
+  uint64_t byteSize;
+  uint64_t sourceSize;
+  uint64_t sourceMtimeMs;
+};
+
+auto alignUp(uint64_t value, uint64_t align) -> uint64_t {
+  return (value + align - 1U) / align * align;
+}
+
+} // namespace
+
+auto AssetPack::open(const QString &path) -> bool {
+  close();
+
+  m_file.setFileName(path);
+  if (!m_file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+
+  const auto total = static_cast<uint64_t>(m_file.size());
+  if (total < sizeof(PackHeader)) {
+    close();
+    return false;
+  }
+
+  // Map the whole file; blob views point straight into the mapping.
+  // readAll() is the fallback for filesystems without mmap.
+  m_base = m_file.map(0, static_cast<qint64>(total));
+  if (m_base == nullptr) {
+    m_fallback = m_file.readAll();
+    if (static_cast<uint64_t>(m_fallback.size()) != total) {
+      close();
+      return false;
+    }
+    m_base = reinterpret_cast<const unsigned char *>(m_fallback.constData());
+  }
+  m_totalSize = total;
+
+  PackHeader header;
+  std::memcpy(&header, m_base, sizeof(header));
+  if (header.magic != k_magic || header.version != k_version) {
+    close();
+    return false;
+  }
+
+  const uint64_t table_end =
+      sizeof(PackHeader) + uint64_t(header.entryCount) * sizeof(PackEntry);
+  if (table_end > total) {
+    close();
+    return false;
+  }
+
+  m_entries.reserve(header.entryCount);
+  for (uint32_t i = 0; i < header.entryCount; ++i) {
+    PackEntry raw;
+    std::memcpy(&raw, m_base + sizeof(PackHeader) + i * sizeof(PackEntry),
+                sizeof(raw));
+
+    const uint64_t name_end =
+        table_end + uint64_t(raw.nameOffset) + raw.nameLength;
+    if (name_end > total || raw.offset + raw.byteSize > total) {
+      close();
+      return false;
+    }
+
+    Entry entry;
+    entry.name = QString::fromUtf8(
+        reinterpret_cast<const char *>(m_base + table_end + raw.nameOffset),
+        static_cast<int>(raw.nameLength));
+    entry.kind = static_cast<Kind>(raw.kind);
+    entry.offset = raw.offset;
+    entry.byteSize = raw.byteSize;
+    entry.sourceSize = raw.sourceSize;
+    entry.sourceMtimeMs = raw.sourceMtimeMs;
+    m_entries.push_back(std::move(entry));
+  }
+
+  return true;
+}
+
+void AssetPack::close() {
+  m_entries.clear();
+  m_base = nullptr;
+  m_totalSize = 0;
+  m_fallback.clear();
+  if (m_file.isOpen()) {
+    m_file.close();
+  }
+}
+
+auto AssetPack::find(const QString &name) const -> const Entry * {
+  for (const auto &entry : m_entries) {
+    if (entry.name == name) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+auto AssetPack::view(const QString &name) const -> std::span<const std::byte> {
+  const Entry *entry = find(name);
+  if (entry == nullptr || m_base == nullptr) {
+    return {};
+  }
+  return {reinterpret_cast<const std::byte *>(m_base + entry->offset),
+          static_cast<std::size_t>(entry->byteSize)};
+}
+
+auto AssetPack::stampMatches(const QString &name, std::uint64_t sourceSize,
+                             std::uint64_t sourceMtimeMs) const -> bool {
+  const Entry *entry = find(name);
+  return entry != nullptr && entry->sourceSize == sourceSize &&
+         entry->sourceMtimeMs == sourceMtimeMs;
+}
+
+void AssetPackWriter::add(const QString &name, AssetPack::Kind kind,
+                          QByteArray bytes, std::uint64_t sourceSize,
+                          std::uint64_t sourceMtimeMs) {
+  m_pending.push_back(
+      {name, kind, std::move(bytes), sourceSize, sourceMtimeMs});
+}
+
+auto AssetPackWriter::commit(const QString &path) const -> bool {
+  if (path.isEmpty()) {
+    return false;
+  }
+
+  QByteArray names;
+  std::vector<PackEntry> table;
+  table.reserve(m_pending.size());
+
+  const uint64_t table_end =
+      sizeof(PackHeader) + m_pending.size() * sizeof(PackEntry);
+  for (const auto &pending : m_pending) {
+    const QByteArray utf8 = pending.name.toUtf8();
+    PackEntry entry{};
+    entry.kind = static_cast<uint32_t>(pending.kind);
+    entry.nameOffset = static_cast<uint32_t>(names.size());
+    entry.nameLength = static_cast<uint32_t>(utf8.size());
+    entry.byteSize = static_cast<uint64_t>(pending.bytes.size());
+    entry.sourceSize = pending.sourceSize;
+    entry.sourceMtimeMs = pending.sourceMtimeMs;
+    names.append(utf8);
+    table.push_back(entry);
+  }
+
+  uint64_t offset = alignUp(table_end + uint64_t(names.size()),
+                            k_payload_align);
+  for (auto &entry : table) {
+    entry.offset = offset;
+    offset = alignUp(offset + entry.byteSize, k_payload_align);
+  }
+
+  PackHeader header{};
+  header.magic = k_magic;
+  header.version = k_version;
+  header.entryCount = static_cast<uint32_t>(table.size());
+
+  QDir().mkpath(QFileInfo(path).absolutePath());
+  QSaveFile file(path);
+  if (!file.open(QIODevice::WriteOnly)) {
+    return false;
+  }
+
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char *>(table.data()),
+             static_cast<qint64>(table.size() * sizeof(PackEntry)));
+  file.write(names);
+
+  uint64_t written = table_end + uint64_t(names.size());
+  static constexpr char k_zeros[k_payload_align] = {};
+  for (std::size_t i = 0; i < m_pending.size(); ++i) {
+    const uint64_t padding = table[i].offset - written;
+    if (padding != 0U) {
+      file.write(k_zeros, static_cast<qint64>(padding));
+    }
+    file.write(m_pending[i].bytes);
+    written = table[i].offset + table[i].byteSize;
+  }
+
+  return file.commit();
+}
+
+} // namespace Engine::Core
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Engine::Core {
+
+// Packed archive of named asset blobs: a fixed header, an entry table, a
+// name blob and 64-byte-aligned payload sections, written once (typically
+// under the user cache dir) and memory-mapped on later loads so consumers
+// read straight from the OS page cache with no intermediate copies.
+// Entries carry the source file's size and mtime so a stale blob is
+// detected per entry; WAV/PNG/JSON sources stay the authoring formats.
+class AssetPack {
+public:
+  enum class Kind : std::uint32_t {
+    Blob = 0,
+    Mesh = 1,
+    Texture = 2,
+    Audio = 3,
+  };
+
+  AssetPack() = default;
+  ~AssetPack() { close(); }
+
+  AssetPack(const AssetPack &) = delete;
+  auto operator=(const AssetPack &) -> AssetPack & = delete;
+  AssetPack(AssetPack &&) = delete;
+  auto operator=(AssetPack &&) -> AssetPack & = delete;
+
+  // Maps the pack at `path`; falls back to a full read on filesystems
+  // that cannot mmap. Returns false for a missing, truncated or
+  // version-mismatched file.
+  [[nodiscard]] auto open(const QString &path) -> bool;
+  void close();
+
+  [[nodiscard]] auto isOpen() const -> bool { return m_base != nullptr; }
+  [[nodiscard]] auto entryCount() const -> std::size_t {
+    return m_entries.size();
+  }
+
+  // Zero-copy view of the named blob, valid until close(); empty when
+  // the entry is missing.
+  [[nodiscard]] auto view(const QString &name) const
+      -> std::span<const std::byte>;
+
+  // Whether the named entry was packed from a source of exactly this
+  // size and mtime; false for unknown names.
+  [[nodiscard]] auto stampMatches(const QString &name,
+                                  std::uint64_t sourceSize,
+                                  std::uint64_t sourceMtimeMs) const -> bool;
+
+private:
+  struct Entry {
+    QString name;
+    Kind kind = Kind::Blob;
+    std::uint64_t offset = 0;
+    std::uint64_t byteSize = 0;
+    std::uint64_t sourceSize = 0;
+    std::uint64_t sourceMtimeMs = 0;
+  };
+
+  [[nodiscard]] auto find(const QString &name) const -> const Entry *;
+
+  QFile m_file;
+  QByteArray m_fallback;
+  const unsigned char *m_base = nullptr;
+  std::uint64_t m_totalSize = 0;
+  std::vector<Entry> m_entries;
+};
+
+// Accumulates named blobs and writes them as one pack with 64-byte
+// aligned payloads; commit() goes through QSaveFile so readers never
+// observe a half-written archive.
+class AssetPackWriter {
+public:
+  void add(const QString &name, AssetPack::Kind kind, QByteArray bytes,
+           std::uint64_t sourceSize, std::uint64_t sourceMtimeMs);
+
+  [[nodiscard]] auto commit(const QString &path) const -> bool;
+
+private:
+  struct Pending {
+    QString name;
+    AssetPack::Kind kind = AssetPack::Kind::Blob;
+    QByteArray bytes;
+    std::uint64_t sourceSize = 0;
+    std::uint64_t sourceMtimeMs = 0;
+  };
+
+  std::vector<Pending> m_pending;
+};
+
+} // namespace Engine::Core
@@ -0,0 +1,964 @@
+#include "binary_serialization.h"
+#include "../map/terrain.h"
+#include "../map/terrain_service.h"
+#include "../units/spawn_type.h"
+#include "../units/troop_type.h"
+#include "component.h"
+#include "component_reflection.h"
+#include "entity.h"
+#include "world.h"
+#include <QDebug>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+#include <QVector3D>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../systems/owner_registry.h"
+
+namespace Engine::Core {
+
+namespace {
+
+// Little-endian packed save-game world state, layout version 1:
+//   header  : magic 'SOIS', version
+//   strings : count, then per string u32 length + UTF-8 bytes
+//   entities: count, then per entity id + component mask + POD blocks
+//   trailer : nextEntityId, owner-registry JSON blob, optional terrain
+constexpr uint32_t k_magic = 0x53494F53U; // "SOIS"
+constexpr uint32_t k_version = 1;
+
+// Delta blobs ('SOID') carry a string table, changed/added entity records in
+// the same per-entity format as full saves, removed ids, and the trailer
+// fields that can drift between autosaves. Terrain is checkpoint-only.
+constexpr uint32_t k_delta_magic = 0x44494F53U; // "SOID"
+constexpr uint32_t k_delta_version = 1;
+
+constexpr uint32_t k_has_transform = 1U << 0U;
+constexpr uint32_t k_has_renderable = 1U << 1U;
+constexpr uint32_t k_has_unit = 1U << 2U;
+constexpr uint32_t k_has_movement = 1U << 3U;
+constexpr uint32_t k_has_attack = 1U << 4U;
+constexpr uint32_t k_has_attack_target = 1U << 5U;
+constexpr uint32_t k_has_patrol = 1U << 6U;
+constexpr uint32_t k_has_building = 1U << 7U;
+constexpr uint32_t k_has_production = 1U << 8U;
+constexpr uint32_t k_has_ai_controlled = 1U << 9U;
+constexpr uint32_t k_has_capture = 1U << 10U;
+
+class BlobWriter {
+public:
+  explicit BlobWriter(QByteArray &out) : m_out(out) {}
+
+  void putU8(uint8_t value) { putRaw(&value, sizeof(value)); }
+  void putU32(uint32_t value) { putRaw(&value, sizeof(value)); }
+  void putU64(uint64_t value) { putRaw(&value, sizeof(value)); }
+  void putI32(int32_t value) { putRaw(&value, sizeof(value)); }
+  void putF32(float value) { putRaw(&value, sizeof(value)); }
+
+  void putBytes(const void *data, qsizetype byteCount) {
+    m_out.append(static_cast<const char *>(data), byteCount);
+  }
+
+private:
+  void putRaw(const void *data, std::size_t byteCount) {
+    m_out.append(static_cast<const char *>(data),
+                 static_cast<qsizetype>(byteCount));
+  }
+
+  QByteArray &m_out;
+};
+
+class BlobReader {
+public:
+  explicit BlobReader(const QByteArray &data) : m_data(data) {}
+
+  auto getU8(uint8_t &value) -> bool { return getRaw(&value, sizeof(value)); }
+  auto getU32(uint32_t &value) -> bool { return getRaw(&value, sizeof(value)); }
+  auto getU64(uint64_t &value) -> bool { return getRaw(&value, sizeof(value)); }
+  auto getI32(int32_t &value) -> bool { return getRaw(&value, sizeof(value)); }
+  auto getF32(float &value) -> bool { return getRaw(&value, sizeof(value)); }
+
+  auto getBytes(void *out, qsizetype byteCount) -> bool {
+    if (byteCount < 0 || m_pos + byteCount > m_data.size()) {
+      m_ok = false;
+      return false;
+    }
+    std::memcpy(out, m_data.constData() + m_pos,
+                static_cast<std::size_t>(byteCount));
+    m_pos += byteCount;
+    return true;
+  }
+
+  auto skip(qsizetype byteCount) -> bool {
+    if (byteCount < 0 || m_pos + byteCount > m_data.size()) {
+      m_ok = false;
+      return false;
+    }
+    m_pos += byteCount;
+    return true;
+  }
+
+  // Bytes between the cursor and the end of the blob.
+  [[nodiscard]] auto remaining() const -> qsizetype {
+    return m_data.size() - m_pos;
+  }
+
+  // Reads a list count and fails unless the remaining payload could hold
+  // that many items of at least perItemBytes each. A truncated or corrupt
+  // blob then fails the load like any other short read instead of asking
+  // for a multi-gigabyte reserve on the raw count.
+  auto getCount(uint32_t &count, qsizetype perItemBytes) -> bool {
+    if (!getU32(count)) {
+      return false;
+    }
+    if (static_cast<qsizetype>(count) > remaining() / perItemBytes) {
+      m_ok = false;
+      count = 0;
+      return false;
+    }
+    return true;
+  }
+
+  [[nodiscard]] auto ok() const -> bool { return m_ok; }
+
+private:
+  auto getRaw(void *out, std::size_t byteCount) -> bool {
+    return getBytes(out, static_cast<qsizetype>(byteCount));
+  }
+
+  const QByteArray &m_data;
+  qsizetype m_pos = 0;
+  bool m_ok = true;
+};
+
+class StringTable {
+public:
+  auto intern(const std::string &value) -> uint32_t {
+    const auto found = m_indices.find(value);
+    if (found != m_indices.end()) {
+      return found->second;
+    }
+    const auto index = static_cast<uint32_t>(m_strings.size());
+    m_strings.push_back(value);
+    m_indices.emplace(value, index);
+    return index;
+  }
+
+  void write(BlobWriter &writer) const {
+    writer.putU32(static_cast<uint32_t>(m_strings.size()));
+    for (const auto &value : m_strings) {
+      writer.putU32(static_cast<uint32_t>(value.size()));
+      writer.putBytes(value.data(), static_cast<qsizetype>(value.size()));
+    }
+  }
+
+  auto read(BlobReader &reader) -> bool {
+    uint32_t count = 0;
+    if (!reader.getCount(count, sizeof(uint32_t))) {
+      return false;
+    }
+    m_strings.clear();
+    m_strings.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+      uint32_t length = 0;
+      if (!reader.getU32(length) ||
+          static_cast<qsizetype>(length) > reader.remaining()) {
+        return false;
+      }
+      std::string value(length, '\0');
+      if (length > 0 && !reader.getBytes(value.data(),
+                                         static_cast<qsizetype>(length))) {
+        return false;
+      }
+      m_strings.push_back(std::move(value));
+    }
+    return true;
+  }
+
+  [[nodiscard]] auto get(uint32_t index) const -> const std::string & {
+    static const std::string k_empty;
+    return index < m_strings.size() ? m_strings[index] : k_empty;
+  }
+
+private:
+  std::vector<std::string> m_strings;
+  std::unordered_map<std::string, uint32_t> m_indices;
+};
+
+// Binary sides of the component_reflection.h field descriptions. Keys are
+// ignored: the packed layout is the description's field order, identical
+// to the hand-written version-1 encoding it replaces. Strings and named
+// enums go through the save's string table exactly as before.
+struct BinaryWriteVisitor {
+  BlobWriter &writer;
+  StringTable &strings;
+
+  void f32(const char *, float value, float = 0.0F) { writer.putF32(value); }
+  void i32(const char *, int value, int = 0) { writer.putI32(value); }
+  void boolean(const char *, bool value, bool = false) {
+    writer.putU8(value ? 1U : 0U);
+  }
+  void u64(const char *, std::uint64_t value) { writer.putU64(value); }
+  void entityId(const char *, EntityID value) {
+    writer.putU32(static_cast<uint32_t>(value));
+  }
+  template <typename E> void enumI32(const char *, E value, E) {
+    writer.putI32(static_cast<int32_t>(value));
+  }
+  void str(const char *, const std::string &value) {
+    writer.putU32(strings.intern(value));
+  }
+  void combatMode(const char *, AttackComponent::CombatMode value) {
+    writer.putU8(static_cast<uint8_t>(value));
+  }
+  void spawnType(const char *, Game::Units::SpawnType value) {
+    writer.putU32(strings.intern(Game::Units::spawn_typeToString(value)));
+  }
+  void troopType(const char *, Game::Units::TroopType value) {
+    writer.putU32(strings.intern(Game::Units::troop_typeToString(value)));
+  }
+  template <typename Queue>
+  void troopTypeQueue(const char *, const Queue &queue) {
+    writer.putU32(static_cast<uint32_t>(queue.size()));
+    for (const auto queued : queue) {
+      writer.putU32(strings.intern(Game::Units::troop_typeToString(queued)));
+    }
+  }
+  void color3(const char *, const std::array<float, 3> &color) {
+    writer.putF32(color[0]);
+    writer.putF32(color[1]);
+    writer.putF32(color[2]);
+  }
+  template <typename List>
+  void waypointList(const char *, const List &points) {
+    writer.putU32(static_cast<uint32_t>(points.size()));
+    for (const auto &point : points) {
+      writer.putF32(point.first);
+      writer.putF32(point.second);
+    }
+  }
+  void indexU32(const char *, std::size_t value) {
+    writer.putU32(static_cast<uint32_t>(value));
+  }
+};
+
+struct BinaryReadVisitor {
+  BlobReader &reader;
+  const StringTable &strings;
+
+  void f32(const char *, float &value, float = 0.0F) { reader.getF32(value); }
+  void i32(const char *, int &value, int = 0) { reader.getI32(value); }
+  void boolean(const char *, bool &value, bool = false) {
+    uint8_t raw = 0;
+    reader.getU8(raw);
+    value = raw != 0U;
+  }
+  void u64(const char *, std::uint64_t &value) { reader.getU64(value); }
+  void entityId(const char *, EntityID &value) {
+    uint32_t raw = 0;
+    reader.getU32(raw);
+    value = static_cast<EntityID>(raw);
+  }
+  template <typename E> void enumI32(const char *, E &value, E def) {
+    int32_t raw = static_cast<int32_t>(def);
+    reader.getI32(raw);
+    value = static_cast<E>(raw);
+  }
+  void str(const char *, std::string &value) {
+    uint32_t ref = 0;
+    reader.getU32(ref);
+    value = strings.get(ref);
+  }
+  void combatMode(const char *, AttackComponent::CombatMode &value) {
+    uint8_t raw = 0;
+    reader.getU8(raw);
+    value = static_cast<AttackComponent::CombatMode>(raw);
+  }
+  void spawnType(const char *, Game::Units::SpawnType &value) {
+    uint32_t ref = 0;
+    reader.getU32(ref);
+    const QString text = QString::fromStdString(strings.get(ref));
+    Game::Units::SpawnType parsed;
+    if (Game::Units::tryParseSpawnType(text, parsed)) {
+      value = parsed;
+    } else {
+      qWarning() << "Unknown spawn type in save file:" << text
+                 << "- defaulting to Archer";
+      value = Game::Units::SpawnType::Archer;
+    }
+  }
+  void troopType(const char *, Game::Units::TroopType &value) {
+    uint32_t ref = 0;
+    reader.getU32(ref);
+    value = Game::Units::troop_typeFromString(strings.get(ref));
+  }
+  template <typename Queue>
+  void troopTypeQueue(const char *, Queue &queue) {
+    uint32_t count = 0;
+    if (!reader.getCount(count, sizeof(uint32_t))) {
+      return;
+    }
+    queue.clear();
+    queue.reserve(count);
+    for (uint32_t i = 0; i < count && reader.ok(); ++i) {
+      uint32_t ref = 0;
+      reader.getU32(ref);
+      queue.push_back(Game::Units::troop_typeFromString(strings.get(ref)));
+    }
+  }
+  void color3(const char *, std::array<float, 3> &color) {
+    reader.getF32(color[0]);
+    reader.getF32(color[1]);
+    reader.getF32(color[2]);
+  }
+  template <typename List>
+  void waypointList(const char *, List &points) {
+    uint32_t count = 0;
+    if (!reader.getCount(count, 2 * sizeof(float))) {
+      return;
+    }
+    points.clear();
+    points.reserve(count);
+    for (uint32_t i = 0; i < count && reader.ok(); ++i) {
+      float x = 0.0F;
+      float y = 0.0F;
+      reader.getF32(x);
+      reader.getF32(y);
+      points.emplace_back(x, y);
+    }
+  }
+  void indexU32(const char *, std::size_t &value) {
+    uint32_t raw = 0;
+    reader.getU32(raw);
+    value = static_cast<std::size_t>(raw);
+  }
+};
+
+void writeEntity(BlobWriter &writer, StringTable &strings,
+                 const Entity *entity) {
+  const auto *transform = entity->getComponent<TransformComponent>();
+  const auto *renderable = entity->getComponent<RenderableComponent>();
+  const auto *unit = entity->getComponent<UnitComponent>();
+  const auto *movement = entity->getComponent<MovementComponent>();
+  const auto *attack = entity->getComponent<AttackComponent>();
+  const auto *attack_target = entity->getComponent<AttackTargetComponent>();
+  const auto *patrol = entity->getComponent<PatrolComponent>();
+  const auto *production = entity->getComponent<ProductionComponent>();
+  const auto *capture = entity->getComponent<CaptureComponent>();
+
+  uint32_t mask = 0;
+  mask |= transform != nullptr ? k_has_transform : 0U;
+  mask |= renderable != nullptr ? k_has_renderable : 0U;
+  mask |= unit != nullptr ? k_has_unit : 0U;
+  mask |= movement != nullptr ? k_has_movement : 0U;
+  mask |= attack != nullptr ? k_has_attack : 0U;
+  mask |= attack_target != nullptr ? k_has_attack_target : 0U;
+  mask |= patrol != nullptr ? k_has_patrol : 0U;
+  mask |= entity->getComponent<BuildingComponent>() != nullptr ? k_has_building
+                                                               : 0U;
+  mask |= production != nullptr ? k_has_production : 0U;
+  mask |= entity->getComponent<AIControlledComponent>() != nullptr
+              ? k_has_ai_controlled
+              : 0U;
+  mask |= capture != nullptr ? k_has_capture : 0U;
+
+  writer.putU32(static_cast<uint32_t>(entity->getId()));
+  writer.putU32(mask);
+
+  BinaryWriteVisitor visitor{writer, strings};
+  if (transform != nullptr) {
+    reflectConst(*transform, visitor);
+  }
+  if (renderable != nullptr) {
+    reflectConst(*renderable, visitor);
+  }
+  if (unit != nullptr) {
+    reflectConst(*unit, visitor);
+  }
+  if (movement != nullptr) {
+    reflectConst(*movement, visitor);
+  }
+  if (attack != nullptr) {
+    reflectConst(*attack, visitor);
+  }
+  if (attack_target != nullptr) {
+    reflectConst(*attack_target, visitor);
+  }
+  if (patrol != nullptr) {
+    reflectConst(*patrol, visitor);
+  }
+  if (production != nullptr) {
+    reflectConst(*production, visitor);
+  }
+  if (capture != nullptr) {
+    reflectConst(*capture, visitor);
+  }
+}
+
+auto readEntityComponents(BlobReader &reader, const StringTable &strings,
+                          Entity *entity, uint32_t mask) -> bool {
+  BinaryReadVisitor visitor{reader, strings};
+
+  if ((mask & k_has_transform) != 0U) {
+    reflectComponent(*entity->addComponent<TransformComponent>(), visitor);
+  }
+
+  if ((mask & k_has_renderable) != 0U) {
+    reflectComponent(*entity->addComponent<RenderableComponent>("", ""),
+                     visitor);
+  }
+
+  if ((mask & k_has_unit) != 0U) {
+    reflectComponent(*entity->addComponent<UnitComponent>(), visitor);
+  }
+
+  if ((mask & k_has_movement) != 0U) {
+    reflectComponent(*entity->addComponent<MovementComponent>(), visitor);
+  }
+
+  if ((mask & k_has_attack) != 0U) {
+    reflectComponent(*entity->addComponent<AttackComponent>(), visitor);
+  }
+
+  if ((mask & k_has_attack_target) != 0U) {
+    reflectComponent(*entity->addComponent<AttackTargetComponent>(), visitor);
+  }
+
+  if ((mask & k_has_patrol) != 0U) {
+    reflectComponent(*entity->addComponent<PatrolComponent>(), visitor);
+  }
+
+  if ((mask & k_has_building) != 0U) {
+    entity->addComponent<BuildingComponent>();
+  }
+
+  if ((mask & k_has_production) != 0U) {
+    reflectComponent(*entity->addComponent<ProductionComponent>(), visitor);
+  }
+
+  if ((mask & k_has_ai_controlled) != 0U) {
+    entity->addComponent<AIControlledComponent>();
+  }
+
+  if ((mask & k_has_capture) != 0U) {
+    reflectComponent(*entity->addComponent<CaptureComponent>(), visitor);
+  }
+
+  return reader.ok();
+}
+
+auto readEntity(BlobReader &reader, const StringTable &strings,
+                World *world) -> bool {
+  uint32_t entity_id = 0;
+  uint32_t mask = 0;
+  if (!reader.getU32(entity_id) || !reader.getU32(mask)) {
+    return false;
+  }
+
+  auto *entity = entity_id == NULL_ENTITY
+                     ? world->createEntity()
+                     : world->createEntityWithId(entity_id);
+  if (entity == nullptr) {
+    return false;
+  }
+
+  return readEntityComponents(reader, strings, entity, mask);
+}
+
+void writeVec3(BlobWriter &writer, const QVector3D &value) {
+  writer.putF32(value.x());
+  writer.putF32(value.y());
+  writer.putF32(value.z());
+}
+
+auto readVec3(BlobReader &reader) -> QVector3D {
+  float x = 0.0F;
+  float y = 0.0F;
+  float z = 0.0F;
+  reader.getF32(x);
+  reader.getF32(y);
+  reader.getF32(z);
+  return {x, y, z};
+}
+
+void writeTerrain(BlobWriter &writer,
+                  const Game::Map::TerrainHeightMap *height_map,
+                  const Game::Map::BiomeSettings &biome) {
+  writer.putI32(height_map->getWidth());
+  writer.putI32(height_map->getHeight());
+  writer.putF32(height_map->getTileSize());
+
+  const auto &heights = height_map->getHeightData();
+  writer.putU32(static_cast<uint32_t>(heights.size()));
+  writer.putBytes(heights.data(),
+                  static_cast<qsizetype>(heights.size() * sizeof(float)));
+
+  const auto &terrain_types = height_map->getTerrainTypes();
+  writer.putU32(static_cast<uint32_t>(terrain_types.size()));
+  for (const auto type : terrain_types) {
+    writer.putU8(static_cast<uint8_t>(type));
+  }
+
+  const auto &rivers = height_map->getRiverSegments();
+  writer.putU32(static_cast<uint32_t>(rivers.size()));
+  for (const auto &river : rivers) {
+    writeVec3(writer, river.start);
+    writeVec3(writer, river.end);
+    writer.putF32(river.width);
+  }
+
+  const auto &bridges = height_map->getBridges();
+  writer.putU32(static_cast<uint32_t>(bridges.size()));
+  for (const auto &bridge : bridges) {
+    writeVec3(writer, bridge.start);
+    writeVec3(writer, bridge.end);
+    writer.putF32(bridge.width);
+    writer.putF32(bridge.height);
+  }
+
+  writeVec3(writer, biome.grassPrimary);
+  writeVec3(writer, biome.grassSecondary);
+  writeVec3(writer, biome.grassDry);
+  writeVec3(writer, biome.soilColor);
+  writeVec3(writer, biome.rockLow);
+  writeVec3(writer, biome.rockHigh);
+  writer.putF32(biome.patchDensity);
+  writer.putF32(biome.patchJitter);
+  writer.putF32(biome.backgroundBladeDensity);
+  writer.putF32(biome.bladeHeightMin);
+  writer.putF32(biome.bladeHeightMax);
+  writer.putF32(biome.bladeWidthMin);
+  writer.putF32(biome.bladeWidthMax);
+  writer.putF32(biome.sway_strength);
+  writer.putF32(biome.sway_speed);
+  writer.putF32(biome.heightNoiseAmplitude);
+  writer.putF32(biome.heightNoiseFrequency);
+  writer.putF32(biome.terrainMacroNoiseScale);
+  writer.putF32(biome.terrainDetailNoiseScale);
+  writer.putF32(biome.terrainSoilHeight);
+  writer.putF32(biome.terrainSoilSharpness);
+  writer.putF32(biome.terrainRockThreshold);
+  writer.putF32(biome.terrainRockSharpness);
+  writer.putF32(biome.terrainAmbientBoost);
+  writer.putF32(biome.terrainRockDetailStrength);
+  writer.putF32(biome.backgroundSwayVariance);
+  writer.putF32(biome.backgroundScatterRadius);
+  writer.putF32(biome.plant_density);
+  writer.putF32(biome.spawnEdgePadding);
+  writer.putU32(biome.seed);
+}
+
+auto readTerrain(BlobReader &reader) -> bool {
+  int32_t width = 0;
+  int32_t height = 0;
+  float tile_size = 1.0F;
+  reader.getI32(width);
+  reader.getI32(height);
+  reader.getF32(tile_size);
+
+  uint32_t height_count = 0;
+  if (!reader.getCount(height_count, sizeof(float))) {
+    return false;
+  }
+  std::vector<float> heights(height_count);
+  if (height_count > 0 &&
+      !reader.getBytes(heights.data(),
+                       static_cast<qsizetype>(height_count * sizeof(float)))) {
+    return false;
+  }
+
+  uint32_t type_count = 0;
+  if (!reader.getCount(type_count, sizeof(uint8_t))) {
+    return false;
+  }
+  std::vector<Game::Map::TerrainType> terrain_types;
+  terrain_types.reserve(type_count);
+  for (uint32_t i = 0; i < type_count && reader.ok(); ++i) {
+    uint8_t type = 0;
+    reader.getU8(type);
+    terrain_types.push_back(static_cast<Game::Map::TerrainType>(type));
+  }
+
+  // Two endpoints and a width per segment.
+  uint32_t river_count = 0;
+  if (!reader.getCount(river_count, 7 * sizeof(float))) {
+    return false;
+  }
+  std::vector<Game::Map::RiverSegment> rivers;
+  rivers.reserve(river_count);
+  for (uint32_t i = 0; i < river_count && reader.ok(); ++i) {
+    Game::Map::RiverSegment river;
+    river.start = readVec3(reader);
+    river.end = readVec3(reader);
+    reader.getF32(river.width);
+    rivers.push_back(river);
+  }
+
+  // Two endpoints, a width and a height per bridge.
+  uint32_t bridge_count = 0;
+  if (!reader.getCount(bridge_count, 8 * sizeof(float))) {
+    return false;
+  }
+  std::vector<Game::Map::Bridge> bridges;
+  bridges.reserve(bridge_count);
+  for (uint32_t i = 0; i < bridge_count && reader.ok(); ++i) {
+    Game::Map::Bridge bridge;
+    bridge.start = readVec3(reader);
+    bridge.end = readVec3(reader);
+    reader.getF32(bridge.width);
+    reader.getF32(bridge.height);
+    bridges.push_back(bridge);
+  }
+
+  Game::Map::BiomeSettings biome;
+  biome.grassPrimary = readVec3(reader);
+  biome.grassSecondary = readVec3(reader);
+  biome.grassDry = readVec3(reader);
+  biome.soilColor = readVec3(reader);
+  biome.rockLow = readVec3(reader);
+  biome.rockHigh = readVec3(reader);
+  reader.getF32(biome.patchDensity);
+  reader.getF32(biome.patchJitter);
+  reader.getF32(biome.backgroundBladeDensity);
+  reader.getF32(biome.bladeHeightMin);
+  reader.getF32(biome.bladeHeightMax);
+  reader.getF32(biome.bladeWidthMin);
+  reader.getF32(biome.bladeWidthMax);
+  reader.getF32(biome.sway_strength);
+  reader.getF32(biome.sway_speed);
+  reader.getF32(biome.heightNoiseAmplitude);
+  reader.getF32(biome.heightNoiseFrequency);
+  reader.getF32(biome.terrainMacroNoiseScale);
+  reader.getF32(biome.terrainDetailNoiseScale);
+  reader.getF32(biome.terrainSoilHeight);
+  reader.getF32(biome.terrainSoilSharpness);
+  reader.getF32(biome.terrainRockThreshold);
+  reader.getF32(biome.terrainRockSharpness);
+  reader.getF32(biome.terrainAmbientBoost);
+  reader.getF32(biome.terrainRockDetailStrength);
+  reader.getF32(biome.backgroundSwayVariance);
+  reader.getF32(biome.backgroundScatterRadius);
+  reader.getF32(biome.plant_density);
+  reader.getF32(biome.spawnEdgePadding);
+  reader.getU32(biome.seed);
+
+  if (!reader.ok()) {
+    return false;
+  }
+
+  auto &terrain_service = Game::Map::TerrainService::instance();
+  terrain_service.restoreFromSerialized(width, height, tile_size, heights,
+                                        terrain_types, rivers, bridges, biome);
+  return true;
+}
+
+} // namespace
+
+auto BinarySerialization::serializeWorld(const World *world) -> QByteArray {
+  // Entities are packed into their own buffer first so the string table they
+  // intern into can be written ahead of them in the final stream.
+  QByteArray entity_payload;
+  StringTable strings;
+  {
+    BlobWriter entity_writer(entity_payload);
+    const auto &entities = world->entities();
+    entity_writer.putU32(static_cast<uint32_t>(entities.size()));
+    for (const Entity *entity : entities) {
+      writeEntity(entity_writer, strings, entity);
+    }
+  }
+
+  QByteArray out;
+  out.reserve(entity_payload.size() + entity_payload.size() / 4);
+  BlobWriter writer(out);
+  writer.putU32(k_magic);
+  writer.putU32(k_version);
+  strings.write(writer);
+  writer.putBytes(entity_payload.constData(), entity_payload.size());
+
+  writer.putU32(static_cast<uint32_t>(world->getNextEntityId()));
+
+  const QByteArray owner_registry_bytes =
+      QJsonDocument(Game::Systems::OwnerRegistry::instance().toJson())
+          .toJson(QJsonDocument::Compact);
+  writer.putU32(static_cast<uint32_t>(owner_registry_bytes.size()));
+  writer.putBytes(owner_registry_bytes.constData(),
+                  owner_registry_bytes.size());
+
+  const auto &terrain_service = Game::Map::TerrainService::instance();
+  const bool has_terrain = terrain_service.isInitialized() &&
+                           (terrain_service.getHeightMap() != nullptr);
+  writer.putU8(has_terrain ? 1U : 0U);
+  if (has_terrain) {
+    writeTerrain(writer, terrain_service.getHeightMap(),
+                 terrain_service.biomeSettings());
+  }
+
+  return out;
+}
+
+auto BinarySerialization::deserializeWorld(World *world,
+                                           const QByteArray &bytes) -> bool {
+  BlobReader reader(bytes);
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  if (!reader.getU32(magic) || magic != k_magic || !reader.getU32(version)) {
+    return false;
+  }
+  if (version != k_version) {
+    qWarning() << "Unsupported binary save version:" << version;
+    return false;
+  }
+
+  StringTable strings;
+  if (!strings.read(reader)) {
+    return false;
+  }
+
+  uint32_t entity_count = 0;
+  if (!reader.getU32(entity_count)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < entity_count; ++i) {
+    if (!readEntity(reader, strings, world)) {
+      return false;
+    }
+  }
+
+  uint32_t next_entity_id = 0;
+  if (!reader.getU32(next_entity_id)) {
+    return false;
+  }
+  world->setNextEntityId(static_cast<EntityID>(next_entity_id));
+
+  uint32_t owner_registry_size = 0;
+  if (!reader.getU32(owner_registry_size) ||
+      static_cast<qsizetype>(owner_registry_size) > reader.remaining()) {
+    return false;
+  }
+  QByteArray owner_registry_bytes(static_cast<qsizetype>(owner_registry_size),
+                                  '\0');
+  if (owner_registry_size > 0) {
+    if (!reader.getBytes(owner_registry_bytes.data(),
+                         owner_registry_bytes.size())) {
+      return false;
+    }
+    Game::Systems::OwnerRegistry::instance().fromJson(
+        QJsonDocument::fromJson(owner_registry_bytes).object());
+  }
+
+  uint8_t has_terrain = 0;
+  if (!reader.getU8(has_terrain)) {
+    return false;
+  }
+  if (has_terrain != 0U && !readTerrain(reader)) {
+    return false;
+  }
+
+  return reader.ok();
+}
+
+auto BinarySerialization::applyWorldDelta(World *world,
+                                          const QByteArray &bytes) -> bool {
+  BlobReader reader(bytes);
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  if (!reader.getU32(magic) || magic != k_delta_magic ||
+      !reader.getU32(version)) {
+    return false;
+  }
+  if (version != k_delta_version) {
+    qWarning() << "Unsupported binary save delta version:" << version;
+    return false;
+  }
+
+  StringTable strings;
+  if (!strings.read(reader)) {
+    return false;
+  }
+
+  uint32_t changed_count = 0;
+  if (!reader.getU32(changed_count)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < changed_count; ++i) {
+    uint32_t entity_id = 0;
+    uint32_t mask = 0;
+    if (!reader.getU32(entity_id) || !reader.getU32(mask)) {
+      return false;
+    }
+    // Changed entities are rebuilt wholesale so component removals between
+    // saves are reflected too.
+    if (world->getEntity(entity_id) != nullptr) {
+      world->destroyEntity(entity_id);
+    }
+    auto *entity = entity_id == NULL_ENTITY
+                       ? world->createEntity()
+                       : world->createEntityWithId(entity_id);
+    if (entity == nullptr ||
+        !readEntityComponents(reader, strings, entity, mask)) {
+      return false;
+    }
+  }
+
+  uint32_t removed_count = 0;
+  if (!reader.getU32(removed_count)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < removed_count; ++i) {
+    uint32_t entity_id = 0;
+    if (!reader.getU32(entity_id)) {
+      return false;
+    }
+    world->destroyEntity(entity_id);
+  }
+
+  uint32_t next_entity_id = 0;
+  if (!reader.getU32(next_entity_id)) {
+    return false;
+  }
+  world->setNextEntityId(static_cast<EntityID>(next_entity_id));
+
+  uint8_t owner_registry_changed = 0;
+  if (!reader.getU8(owner_registry_changed)) {
+    return false;
+  }
+  if (owner_registry_changed != 0U) {
+    uint32_t owner_registry_size = 0;
+    if (!reader.getU32(owner_registry_size) ||
+        static_cast<qsizetype>(owner_registry_size) > reader.remaining()) {
+      return false;
+    }
+    QByteArray owner_registry_bytes(static_cast<qsizetype>(owner_registry_size),
+                                    '\0');
+    if (!reader.getBytes(owner_registry_bytes.data(),
+                         owner_registry_bytes.size())) {
+      return false;
+    }
+    Game::Systems::OwnerRegistry::instance().fromJson(
+        QJsonDocument::fromJson(owner_registry_bytes).object());
+  }
+
+  return reader.ok();
+}
+
+auto BinarySerialization::isBinaryWorldState(const QByteArray &bytes) -> bool {
+  if (bytes.size() < static_cast<qsizetype>(sizeof(uint32_t))) {
+    return false;
+  }
+  uint32_t magic = 0;
+  std::memcpy(&magic, bytes.constData(), sizeof(magic));
+  return magic == k_magic;
+}
+
+auto BinarySerialization::isDeltaWorldState(const QByteArray &bytes) -> bool {
+  if (bytes.size() < static_cast<qsizetype>(sizeof(uint32_t))) {
+    return false;
+  }
+  uint32_t magic = 0;
+  std::memcpy(&magic, bytes.constData(), sizeof(magic));
+  return magic == k_delta_magic;
+}
+
+struct WorldDeltaTracker::Impl {
+  StringTable strings;
+  std::unordered_map<uint32_t, QByteArray> entity_bytes;
+  QByteArray owner_registry_bytes;
+  bool has_baseline = false;
+
+  auto captureOwnerRegistry() -> QByteArray {
+    return QJsonDocument(Game::Systems::OwnerRegistry::instance().toJson())
+        .toJson(QJsonDocument::Compact);
+  }
+};
+
+WorldDeltaTracker::WorldDeltaTracker() : m_impl(std::make_unique<Impl>()) {}
+
+WorldDeltaTracker::~WorldDeltaTracker() = default;
+
+void WorldDeltaTracker::rebase(const World *world) {
+  m_impl->entity_bytes.clear();
+  for (const Entity *entity : world->entities()) {
+    QByteArray record;
+    BlobWriter writer(record);
+    writeEntity(writer, m_impl->strings, entity);
+    m_impl->entity_bytes.emplace(static_cast<uint32_t>(entity->getId()),
+                                 std::move(record));
+  }
+  m_impl->owner_registry_bytes = m_impl->captureOwnerRegistry();
+  m_impl->has_baseline = true;
+}
+
+void WorldDeltaTracker::reset() { m_impl = std::make_unique<Impl>(); }
+
+auto WorldDeltaTracker::hasBaseline() const -> bool {
+  return m_impl->has_baseline;
+}
+
+auto WorldDeltaTracker::serializeDelta(const World *world) -> QByteArray {
+  QByteArray changed_payload;
+  uint32_t changed_count = 0;
+  std::unordered_map<uint32_t, QByteArray> current;
+  const auto &entities = world->entities();
+  current.reserve(entities.size());
+
+  {
+    BlobWriter changed_writer(changed_payload);
+    for (const Entity *entity : entities) {
+      QByteArray record;
+      BlobWriter writer(record);
+      writeEntity(writer, m_impl->strings, entity);
+
+      const auto entity_id = static_cast<uint32_t>(entity->getId());
+      const auto previous = m_impl->entity_bytes.find(entity_id);
+      if (previous == m_impl->entity_bytes.end() ||
+          previous->second != record) {
+        changed_writer.putBytes(record.constData(), record.size());
+        ++changed_count;
+      }
+      current.emplace(entity_id, std::move(record));
+    }
+  }
+
+  std::vector<uint32_t> removed;
+  for (const auto &[entity_id, record] : m_impl->entity_bytes) {
+    if (current.find(entity_id) == current.end()) {
+      removed.push_back(entity_id);
+    }
+  }
+
+  const QByteArray owner_registry_bytes = m_impl->captureOwnerRegistry();
+  const bool owner_registry_changed =
+      owner_registry_bytes != m_impl->owner_registry_bytes;
+
+  QByteArray out;
+  out.reserve(changed_payload.size() + changed_payload.size() / 4);
+  BlobWriter writer(out);
+  writer.putU32(k_delta_magic);
+  writer.putU32(k_delta_version);
+  m_impl->strings.write(writer);
+  writer.putU32(changed_count);
+  writer.putBytes(changed_payload.constData(), changed_payload.size());
+  writer.putU32(static_cast<uint32_t>(removed.size()));
+  for (const uint32_t entity_id : removed) {
+    writer.putU32(entity_id);
+  }
+  writer.putU32(static_cast<uint32_t>(world->getNextEntityId()));
+  writer.putU8(owner_registry_changed ? 1U : 0U);
+  if (owner_registry_changed) {
+    writer.putU32(static_cast<uint32_t>(owner_registry_bytes.size()));
+    writer.putBytes(owner_registry_bytes.constData(),
+                    owner_registry_bytes.size());
+  }
+
+  m_impl->entity_bytes = std::move(current);
+  m_impl->owner_registry_bytes = owner_registry_bytes;
+  return out;
+}
+
+} // namespace Engine::Core
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <QByteArray>
+#include <memory>
+
+namespace Engine::Core {
+
+class World;
+
+// Versioned binary world-state format for save games. Entities are written
+// as per-component POD blocks behind a presence mask, with repeated strings
+// (mesh paths, unit type names) deduplicated through a string table, so a
+// late-game world serializes in one streamed pass without building a JSON
+// DOM. The JSON path in Serialization stays available for debugging saves;
+// loaders sniff the leading magic to accept either format.
+class BinarySerialization {
+public:
+  static auto serializeWorld(const World *world) -> QByteArray;
+  static auto deserializeWorld(World *world, const QByteArray &bytes) -> bool;
+
+  // Applies a delta blob produced by WorldDeltaTracker on top of an already
+  // restored world: changed entities are rebuilt from their records, removed
+  // ones destroyed. Terrain is never part of a delta.
+  static auto applyWorldDelta(World *world, const QByteArray &bytes) -> bool;
+
+  [[nodiscard]] static auto isBinaryWorldState(const QByteArray &bytes) -> bool;
+  [[nodiscard]] static auto isDeltaWorldState(const QByteArray &bytes) -> bool;
+};
+
+// Tracks per-entity record bytes between saves so autosaves can emit only
+// what changed since the last one. rebase() seeds the baseline from a full
+// checkpoint; serializeDelta() then packs changed/added entity records and
+// removed ids, updating the baseline as it goes. The tracker's string table
+// persists across deltas so record bytes stay comparable.
+class WorldDeltaTracker {
+public:
+  WorldDeltaTracker();
+  ~WorldDeltaTracker();
+
+  WorldDeltaTracker(const WorldDeltaTracker &) = delete;
+  auto operator=(const WorldDeltaTracker &) -> WorldDeltaTracker & = delete;
+
+  void rebase(const World *world);
+  void reset();
+  [[nodiscard]] auto hasBaseline() const -> bool;
+
+  auto serializeDelta(const World *world) -> QByteArray;
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace Engine::Core
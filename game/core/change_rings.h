@@ -0,0 +1,85 @@
+#pragma once
+
+#include "component_type_id.h"
+#include "entity.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Engine::Core {
+
+// Fixed-size change log per component type, fed by the ECS mutation
+// path (component add/remove). One writer — the sim thread — publishes
+// records with a release store on the ring head; any number of readers
+// drain at their own cadence through private cursors with no locks and
+// no allocation. Consumers that fall more than a ring behind are told
+// so and resynchronize with a full scan, which keeps the memory bound
+// fixed regardless of how rarely a reader polls.
+class ComponentChangeRings {
+public:
+  enum class ChangeKind : std::uint8_t { Added, Removed };
+
+  struct Record {
+    EntityID entity = NULL_ENTITY;
+    ChangeKind kind = ChangeKind::Added;
+  };
+
+  // Each reader owns one cursor per ring it follows; default-initialized
+  // cursors start at the ring's origin and report an overflow on first
+  // use once the ring has wrapped, which doubles as "do an initial full
+  // scan".
+  struct Cursor {
+    std::uint64_t next = 0;
+  };
+
+  // Structural changes are rare relative to ticks (spawns, deaths,
+  // captures), so a modest ring absorbs even mass-battle bursts between
+  // two reads of a per-tick consumer.
+  static constexpr std::size_t k_ring_capacity = 256;
+
+  void record(ComponentTypeId type, EntityID entity, ChangeKind kind) {
+    auto &ring = m_rings[type];
+    std::uint64_t const head = ring.head.load(std::memory_order_relaxed);
+    ring.records[head & (k_ring_capacity - 1)] = {entity, kind};
+    ring.head.store(head + 1, std::memory_order_release);
+  }
+
+  // Invokes fn(const Record &) for every change since the cursor and
+  // advances it. Returns false when the writer lapped the cursor:
+  // records were overwritten unseen, the cursor snaps to the head and
+  // the caller must resynchronize with a full scan.
+  template <typename Fn>
+  auto consume(ComponentTypeId type, Cursor &cursor, Fn &&fn) const -> bool {
+    const auto &ring = m_rings[type];
+    std::uint64_t const head = ring.head.load(std::memory_order_acquire);
+    if (head - cursor.next > k_ring_capacity) {
+      cursor.next = head;
+      return false;
+    }
+    for (std::uint64_t i = cursor.next; i < head; ++i) {
+      fn(static_cast<const Record &>(ring.records[i & (k_ring_capacity - 1)]));
+    }
+    cursor.next = head;
+    return true;
+  }
+
+  // Number of records ever written to a ring; cheap staleness probe for
+  // readers that only want to know whether anything changed.
+  [[nodiscard]] auto head(ComponentTypeId type) const -> std::uint64_t {
+    return m_rings[type].head.load(std::memory_order_acquire);
+  }
+
+private:
+  struct Ring {
+    std::atomic<std::uint64_t> head{0};
+    std::array<Record, k_ring_capacity> records{};
+  };
+
+  static_assert((k_ring_capacity & (k_ring_capacity - 1)) == 0,
+                "ring capacity must be a power of two for mask indexing");
+
+  std::array<Ring, kMaxComponentTypes> m_rings;
+};
+
+} // namespace Engine::Core
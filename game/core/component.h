@@ -3,6 +3,7 @@
 #include "../units/spawn_type.h"
 #include "../units/troop_type.h"
 #include "entity.h"
+#include "small_vector.h"
 #include <array>
 #include <cstdint>
 #include <optional>
@@ -80,6 +81,9 @@ public:
   Game::Units::SpawnType spawn_type{Game::Units::SpawnType::Archer};
   int owner_id{0};
   float vision_range;
+  // 1-based row in Game::Units::UnitDefTable holding this type's shared
+  // immutable stats; 0 for entities without a def (buildings).
+  std::uint16_t unit_def_index{0};
 };
 
 class MovementComponent : public Component {
@@ -90,9 +94,12 @@ public:
   float target_x{0.0F}, target_y{0.0F};
   float goalX{0.0F}, goalY{0.0F};
   float vx{0.0F}, vz{0.0F};
-  std::vector<std::pair<float, float>> path;
+  // Inline capacity sized so trimmed command paths rarely spill; long
+  // A* routes grow onto the heap as before.
+  SmallVector<std::pair<float, float>, 8> path;
   bool pathPending{false};
   std::uint64_t pendingRequestId{0};
+  std::uint64_t flowFieldKey{0};
   float repathCooldown{0.0F};
 
   float lastGoalX{0.0F}, lastGoalY{0.0F};
@@ -165,7 +172,7 @@ class PatrolComponent : public Component {
 public:
   PatrolComponent() = default;
 
-  std::vector<std::pair<float, float>> waypoints;
+  SmallVector<std::pair<float, float>, 4> waypoints;
   size_t currentWaypoint{0};
   bool patrolling{false};
 };
@@ -195,7 +202,7 @@ public:
   float rallyX{0.0F}, rallyZ{0.0F};
   bool rallySet{false};
   int villagerCost{1};
-  std::vector<Game::Units::TroopType> productionQueue;
+  SmallVector<Game::Units::TroopType, 8> productionQueue;
 };
 
 class AIControlledComponent : public Component {
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "component_type_id.h"
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Engine::Core {
+
+class Component;
+class Entity;
+
+class ComponentPoolBase {
+public:
+  ComponentPoolBase() = default;
+  ComponentPoolBase(const ComponentPoolBase &) = delete;
+  ComponentPoolBase(ComponentPoolBase &&) = delete;
+  auto operator=(const ComponentPoolBase &) -> ComponentPoolBase & = delete;
+  auto operator=(ComponentPoolBase &&) -> ComponentPoolBase & = delete;
+  virtual ~ComponentPoolBase() = default;
+
+  virtual void destroy(Component *component) = 0;
+  [[nodiscard]] virtual auto liveCount() const -> std::size_t = 0;
+  [[nodiscard]] virtual auto owners() const -> const std::vector<Entity *> & = 0;
+};
+
+template <typename T> class ComponentPool : public ComponentPoolBase {
+public:
+  static constexpr std::size_t kChunkCapacity = 256;
+
+  ~ComponentPool() override {
+    for (auto *component : m_components) {
+      static_cast<T *>(component)->~T();
+    }
+  }
+
+  template <typename... Args>
+  auto create(Entity *owner, Args &&...args) -> T * {
+    Slot *slot = nullptr;
+    if (!m_freeSlots.empty()) {
+      slot = m_freeSlots.back();
+      m_freeSlots.pop_back();
+    } else {
+      if (m_chunks.empty() || m_nextInChunk == kChunkCapacity) {
+        m_chunks.push_back(std::make_unique<Slot[]>(kChunkCapacity));
+        m_nextInChunk = 0;
+      }
+      slot = &m_chunks.back()[m_nextInChunk++];
+    }
+    auto *component = new (slot->bytes) T(std::forward<Args>(args)...);
+    m_slotIndex[component] = m_owners.size();
+    m_owners.push_back(owner);
+    m_components.push_back(component);
+    return component;
+  }
+
+  void destroy(Component *component) override {
+    auto it = m_slotIndex.find(component);
+    if (it == m_slotIndex.end()) {
+      return;
+    }
+    const std::size_t index = it->second;
+    const std::size_t last = m_owners.size() - 1;
+    if (index != last) {
+      m_owners[index] = m_owners[last];
+      m_components[index] = m_components[last];
+      m_slotIndex[m_components[index]] = index;
+    }
+    m_owners.pop_back();
+    m_components.pop_back();
+    m_slotIndex.erase(component);
+    auto *typed = static_cast<T *>(component);
+    typed->~T();
+    m_freeSlots.push_back(reinterpret_cast<Slot *>(typed));
+  }
+
+  [[nodiscard]] auto liveCount() const -> std::size_t override {
+    return m_owners.size();
+  }
+
+  [[nodiscard]] auto owners() const -> const std::vector<Entity *> & override {
+    return m_owners;
+  }
+
+private:
+  struct Slot {
+    alignas(T) unsigned char bytes[sizeof(T)];
+  };
+
+  std::vector<std::unique_ptr<Slot[]>> m_chunks;
+  std::vector<Slot *> m_freeSlots;
+  std::size_t m_nextInChunk = kChunkCapacity;
+
+  std::vector<Entity *> m_owners;
+  std::vector<Component *> m_components;
+  std::unordered_map<Component *, std::size_t> m_slotIndex;
+};
+
+class ComponentStorage {
+public:
+  // Invoked after a component is added (added == true) or just before it is
+  // released (added == false). During entity destruction the entity is being
+  // torn down, so listeners must not dereference it.
+  using StructuralListener =
+      std::function<void(Entity *, ComponentTypeId, bool added)>;
+
+  void setStructuralListener(StructuralListener listener) {
+    m_listener = std::move(listener);
+  }
+
+  void notifyChanged(Entity *entity, ComponentTypeId type, bool added) {
+    if (m_listener) {
+      m_listener(entity, type, added);
+    }
+  }
+
+  template <typename T, typename... Args>
+  auto create(Entity *owner, Args &&...args) -> T * {
+    return pool<T>().create(owner, std::forward<Args>(args)...);
+  }
+
+  void destroy(ComponentTypeId type, Component *component) {
+    auto &entry = m_pools[type];
+    if (entry) {
+      entry->destroy(component);
+    }
+  }
+
+  template <typename T>
+  [[nodiscard]] auto entitiesWith() const -> const std::vector<Entity *> & {
+    const auto &entry = m_pools[componentTypeId<T>()];
+    if (entry) {
+      return entry->owners();
+    }
+    static const std::vector<Entity *> s_empty;
+    return s_empty;
+  }
+
+private:
+  template <typename T> auto pool() -> ComponentPool<T> & {
+    auto &entry = m_pools[componentTypeId<T>()];
+    if (!entry) {
+      entry = std::make_unique<ComponentPool<T>>();
+    }
+    return static_cast<ComponentPool<T> &>(*entry);
+  }
+
+  std::array<std::unique_ptr<ComponentPoolBase>, kMaxComponentTypes> m_pools;
+  StructuralListener m_listener;
+};
+
+} // namespace Engine::Core
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "component.h"
+#include <utility>
+
+namespace Engine::Core {
+
+// Single-source field descriptions for the save-game serializers. Each
+// reflectComponent overload lists a component's persisted fields once, in
+// the order the binary format packs them; the JSON and binary serializers
+// run their own read/write visitors over the same description, so a field
+// added here reaches both formats in both directions and the two paths
+// cannot drift apart.
+//
+// A visitor provides one member per field kind. The trailing default
+// arguments are what the JSON reader substitutes for missing keys; the
+// other visitors ignore them. Fields whose encoding is format-specific
+// (interned strings, named enums, waypoint lists) get dedicated hooks so
+// each serializer keeps its existing on-disk representation.
+
+template <typename Visitor>
+void reflectComponent(TransformComponent &c, Visitor &&v) {
+  v.f32("posX", c.position.x);
+  v.f32("posY", c.position.y);
+  v.f32("posZ", c.position.z);
+  v.f32("rotX", c.rotation.x);
+  v.f32("rotY", c.rotation.y);
+  v.f32("rotZ", c.rotation.z);
+  v.f32("scale_x", c.scale.x);
+  v.f32("scaleY", c.scale.y);
+  v.f32("scale_z", c.scale.z);
+  v.f32("desiredYaw", c.desiredYaw);
+  v.boolean("hasDesiredYaw", c.hasDesiredYaw);
+}
+
+template <typename Visitor>
+void reflectComponent(RenderableComponent &c, Visitor &&v) {
+  v.str("meshPath", c.meshPath);
+  v.str("texturePath", c.texturePath);
+  v.boolean("visible", c.visible, true);
+  v.enumI32("mesh", c.mesh, RenderableComponent::MeshKind::Cube);
+  v.color3("color", c.color);
+}
+
+template <typename Visitor>
+void reflectComponent(UnitComponent &c, Visitor &&v) {
+  v.i32("health", c.health, Defaults::kUnitDefaultHealth);
+  v.i32("max_health", c.max_health, Defaults::kUnitDefaultHealth);
+  v.f32("speed", c.speed);
+  v.f32("vision_range", c.vision_range, Defaults::kUnitDefaultVisionRange);
+  v.spawnType("unit_type", c.spawn_type);
+  v.i32("owner_id", c.owner_id);
+}
+
+template <typename Visitor>
+void reflectComponent(MovementComponent &c, Visitor &&v) {
+  v.boolean("hasTarget", c.hasTarget);
+  v.f32("target_x", c.target_x);
+  v.f32("target_y", c.target_y);
+  v.f32("goalX", c.goalX);
+  v.f32("goalY", c.goalY);
+  v.f32("vx", c.vx);
+  v.f32("vz", c.vz);
+  v.boolean("pathPending", c.pathPending);
+  v.u64("pendingRequestId", c.pendingRequestId);
+  v.f32("repathCooldown", c.repathCooldown);
+  v.f32("lastGoalX", c.lastGoalX);
+  v.f32("lastGoalY", c.lastGoalY);
+  v.f32("timeSinceLastPathRequest", c.timeSinceLastPathRequest);
+  v.waypointList("path", c.path);
+}
+
+template <typename Visitor>
+void reflectComponent(AttackComponent &c, Visitor &&v) {
+  v.f32("range", c.range);
+  v.i32("damage", c.damage);
+  v.f32("cooldown", c.cooldown);
+  v.f32("timeSinceLast", c.timeSinceLast);
+  v.f32("meleeRange", c.meleeRange, Defaults::kAttackMeleeRange);
+  v.i32("meleeDamage", c.meleeDamage);
+  v.f32("meleeCooldown", c.meleeCooldown);
+  v.combatMode("preferredMode", c.preferredMode);
+  v.combatMode("currentMode", c.currentMode);
+  v.boolean("canMelee", c.canMelee, true);
+  v.boolean("canRanged", c.canRanged);
+  v.f32("max_heightDifference", c.max_heightDifference,
+        Defaults::kAttackHeightTolerance);
+  v.boolean("inMeleeLock", c.inMeleeLock);
+  v.entityId("meleeLockTargetId", c.meleeLockTargetId);
+}
+
+template <typename Visitor>
+void reflectComponent(AttackTargetComponent &c, Visitor &&v) {
+  v.entityId("target_id", c.target_id);
+  v.boolean("shouldChase", c.shouldChase);
+}
+
+template <typename Visitor>
+void reflectComponent(PatrolComponent &c, Visitor &&v) {
+  v.indexU32("currentWaypoint", c.currentWaypoint);
+  v.boolean("patrolling", c.patrolling);
+  v.waypointList("waypoints", c.waypoints);
+}
+
+template <typename Visitor>
+void reflectComponent(ProductionComponent &c, Visitor &&v) {
+  v.boolean("inProgress", c.inProgress);
+  v.f32("buildTime", c.buildTime);
+  v.f32("timeRemaining", c.timeRemaining);
+  v.i32("producedCount", c.producedCount);
+  v.i32("maxUnits", c.maxUnits);
+  v.troopType("product_type", c.product_type);
+  v.f32("rallyX", c.rallyX);
+  v.f32("rallyZ", c.rallyZ);
+  v.boolean("rallySet", c.rallySet);
+  v.i32("villagerCost", c.villagerCost, 1);
+  v.troopTypeQueue("queue", c.productionQueue);
+}
+
+template <typename Visitor>
+void reflectComponent(CaptureComponent &c, Visitor &&v) {
+  v.i32("capturing_player_id", c.capturing_player_id, -1);
+  v.f32("captureProgress", c.captureProgress);
+  v.f32("requiredTime", c.requiredTime, Defaults::kCaptureRequiredTime);
+  v.boolean("isBeingCaptured", c.isBeingCaptured);
+}
+
+// Write visitors never mutate fields; shed const once here instead of at
+// every serializer call site.
+template <typename Component, typename Visitor>
+void reflectConst(const Component &c, Visitor &&v) {
+  reflectComponent(const_cast<Component &>(c), std::forward<Visitor>(v));
+}
+
+} // namespace Engine::Core
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace Engine::Core {
+
+using ComponentTypeId = std::uint32_t;
+using ComponentMask = std::uint64_t;
+
+inline constexpr std::size_t kMaxComponentTypes = 64;
+
+namespace Detail {
+inline auto nextComponentTypeId() -> ComponentTypeId {
+  static std::atomic<ComponentTypeId> s_counter{0};
+  return s_counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename T>
+inline const ComponentTypeId kComponentTypeId = nextComponentTypeId();
+} // namespace Detail
+
+template <typename T> auto componentTypeId() -> ComponentTypeId {
+  return Detail::kComponentTypeId<std::remove_cv_t<T>>;
+}
+
+template <typename T> auto componentBit() -> ComponentMask {
+  return ComponentMask{1} << componentTypeId<T>();
+}
+
+} // namespace Engine::Core
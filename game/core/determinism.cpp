@@ -0,0 +1,120 @@
+#include "determinism.h"
+#include "component.h"
+#include "entity.h"
+#include "world.h"
+#include <cmath>
+#include <cstdint>
+
+namespace Engine::Core {
+
+namespace {
+
+// splitmix64 finalizer; full-avalanche, cheap enough for per-draw use.
+auto mix64(std::uint64_t value) -> std::uint64_t {
+  value ^= value >> 30U;
+  value *= 0xBF58476D1CE4E5B9ULL;
+  value ^= value >> 27U;
+  value *= 0x94D049BB133111EBULL;
+  value ^= value >> 31U;
+  return value;
+}
+
+constexpr std::uint32_t k_fnv_offset = 2166136261U;
+constexpr std::uint32_t k_fnv_prime = 16777619U;
+
+auto fnv_step(std::uint32_t hash, std::uint32_t value) -> std::uint32_t {
+  for (int i = 0; i < 4; ++i) {
+    hash ^= (value >> (i * 8)) & 0xFFU;
+    hash *= k_fnv_prime;
+  }
+  return hash;
+}
+
+auto quantize(float value, float scale) -> std::uint32_t {
+  return static_cast<std::uint32_t>(
+      static_cast<std::int32_t>(std::lround(value * scale)));
+}
+
+} // namespace
+
+auto SimRng::instance() -> SimRng & {
+  static SimRng instance;
+  return instance;
+}
+
+void SimRng::setSeed(std::uint32_t seed) {
+  m_seed.store(seed, std::memory_order_relaxed);
+}
+
+auto SimRng::seed() const -> std::uint32_t {
+  return m_seed.load(std::memory_order_relaxed);
+}
+
+void SimRng::beginTick(std::uint64_t tick) {
+  m_tick.store(tick, std::memory_order_relaxed);
+}
+
+auto SimRng::uniformInt(std::uint32_t key, std::uint32_t draw, int lo,
+                        int hi) const -> int {
+  if (hi <= lo) {
+    return lo;
+  }
+  const std::uint64_t base =
+      (static_cast<std::uint64_t>(seed()) << 32U) ^
+      m_tick.load(std::memory_order_relaxed);
+  const std::uint64_t bits = mix64(
+      mix64(base) ^ ((static_cast<std::uint64_t>(key) << 32U) | draw));
+  const auto span = static_cast<std::uint64_t>(hi - lo) + 1U;
+  return lo + static_cast<int>(bits % span);
+}
+
+auto SimRng::uniformFloat(std::uint32_t key, std::uint32_t draw, float lo,
+                          float hi) const -> float {
+  const std::uint64_t base =
+      (static_cast<std::uint64_t>(seed()) << 32U) ^
+      m_tick.load(std::memory_order_relaxed);
+  const std::uint64_t bits = mix64(
+      mix64(base) ^ ((static_cast<std::uint64_t>(key) << 32U) | draw));
+  // 24 high-quality bits -> [0, 1); exact in float.
+  const float unit =
+      static_cast<float>(bits >> 40U) * (1.0F / 16777216.0F);
+  return lo + unit * (hi - lo);
+}
+
+auto computeWorldChecksum(const World &world) -> std::uint32_t {
+  // Per-entity hashes are summed rather than chained so the digest does not
+  // depend on dense-array iteration order (which shuffles on destruction).
+  std::uint32_t sum = 0;
+  for (const Entity *entity : world.entities()) {
+    std::uint32_t hash = k_fnv_offset;
+    hash = fnv_step(hash, static_cast<std::uint32_t>(entity->getId()));
+
+    if (const auto *transform = entity->getComponent<TransformComponent>()) {
+      hash = fnv_step(hash, quantize(transform->position.x, 256.0F));
+      hash = fnv_step(hash, quantize(transform->position.y, 256.0F));
+      hash = fnv_step(hash, quantize(transform->position.z, 256.0F));
+    }
+    if (const auto *unit = entity->getComponent<UnitComponent>()) {
+      hash = fnv_step(hash, static_cast<std::uint32_t>(unit->health));
+      hash = fnv_step(hash, static_cast<std::uint32_t>(unit->owner_id));
+    }
+    if (const auto *attack = entity->getComponent<AttackComponent>()) {
+      hash = fnv_step(hash, quantize(attack->timeSinceLast, 1024.0F));
+    }
+    if (const auto *movement = entity->getComponent<MovementComponent>()) {
+      hash = fnv_step(hash, quantize(movement->vx, 256.0F));
+      hash = fnv_step(hash, quantize(movement->vz, 256.0F));
+    }
+
+    sum += hash;
+  }
+
+  std::uint32_t digest = k_fnv_offset;
+  digest = fnv_step(digest,
+                    static_cast<std::uint32_t>(world.entities().size()));
+  digest = fnv_step(digest, static_cast<std::uint32_t>(world.getNextEntityId()));
+  digest = fnv_step(digest, sum);
+  return digest;
+}
+
+} // namespace Engine::Core
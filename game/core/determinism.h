@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace Engine::Core {
+
+class World;
+
+// Seeded simulation RNG with stateless draws. Every draw is keyed by
+// (seed, tick, key, draw index) through a mixing hash rather than advancing
+// shared generator state, so results do not depend on thread scheduling or
+// call order — sim systems may execute on scheduler workers. Identical
+// seeds and inputs therefore give identical streams on any machine.
+class SimRng {
+public:
+  static auto instance() -> SimRng &;
+
+  void setSeed(std::uint32_t seed);
+  [[nodiscard]] auto seed() const -> std::uint32_t;
+
+  // Advances the tick the draws are keyed by; called once per sim tick.
+  void beginTick(std::uint64_t tick);
+
+  // `key` identifies the call site (typically the acting entity id) and
+  // `draw` disambiguates multiple draws from the same site within a tick.
+  [[nodiscard]] auto uniformInt(std::uint32_t key, std::uint32_t draw, int lo,
+                                int hi) const -> int;
+  [[nodiscard]] auto uniformFloat(std::uint32_t key, std::uint32_t draw,
+                                  float lo, float hi) const -> float;
+
+private:
+  SimRng() = default;
+
+  std::atomic<std::uint64_t> m_tick{0};
+  std::atomic<std::uint32_t> m_seed{0x9E3779B9U};
+};
+
+// Order-independent digest of the simulation-relevant world state, with
+// positions and timers quantized so float formatting noise is ignored.
+// Identical inputs produce identical per-tick checksum streams, which can
+// be diffed across runs or machines to localize desyncs.
+[[nodiscard]] auto computeWorldChecksum(const World &world) -> std::uint32_t;
+
+} // namespace Engine::Core
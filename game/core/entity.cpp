@@ -2,8 +2,26 @@
 
 namespace Engine::Core {
 
-Entity::Entity(EntityID id) : m_id(id) {}
+Entity::Entity(EntityID id, ComponentStorage *storage)
+    : m_id(id), m_storage(storage) {}
+
+Entity::~Entity() {
+  for (ComponentTypeId type = 0; type < kMaxComponentTypes; ++type) {
+    if (m_components[type] != nullptr) {
+      releaseComponent(type, m_components[type]);
+    }
+  }
+}
 
 auto Entity::getId() const -> EntityID { return m_id; }
 
+void Entity::releaseComponent(ComponentTypeId type, Component *component) {
+  if (m_storage != nullptr) {
+    m_storage->notifyChanged(this, type, false);
+    m_storage->destroy(type, component);
+  } else {
+    delete component;
+  }
+}
+
 } // namespace Engine::Core
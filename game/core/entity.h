@@ -1,17 +1,36 @@
 #pragma once
 
+#include "component_pool.h"
+#include "component_type_id.h"
+#include <array>
 #include <cstdint>
-#include <memory>
 #include <type_traits>
-#include <typeindex>
-#include <unordered_map>
-#include <vector>
 
 namespace Engine::Core {
 
 using EntityID = std::uint32_t;
 constexpr EntityID NULL_ENTITY = 0;
 
+// Entity IDs encode a slot index in the low bits and a generation counter in
+// the high bits, so a recycled slot invalidates every stale ID that pointed
+// at its previous occupant. Index 0 is reserved for NULL_ENTITY.
+inline constexpr std::uint32_t kEntityIndexBits = 20U;
+inline constexpr EntityID kEntityIndexMask =
+    (EntityID{1} << kEntityIndexBits) - 1;
+
+inline auto entityIndex(EntityID id) -> std::uint32_t {
+  return id & kEntityIndexMask;
+}
+
+inline auto entityGeneration(EntityID id) -> std::uint32_t {
+  return id >> kEntityIndexBits;
+}
+
+inline auto makeEntityId(std::uint32_t index,
+                         std::uint32_t generation) -> EntityID {
+  return (static_cast<EntityID>(generation) << kEntityIndexBits) | index;
+}
+
 class Component {
 public:
   virtual ~Component() = default;
@@ -19,7 +38,13 @@ public:
 
 class Entity {
 public:
-  Entity(EntityID id);
+  Entity(EntityID id, ComponentStorage *storage = nullptr);
+  ~Entity();
+
+  Entity(const Entity &) = delete;
+  Entity(Entity &&) = delete;
+  auto operator=(const Entity &) -> Entity & = delete;
+  auto operator=(Entity &&) -> Entity & = delete;
 
   auto getId() const -> EntityID;
 
@@ -27,39 +52,54 @@ public:
   auto addComponent(Args &&...args) -> T * {
     static_assert(std::is_base_of_v<Component, T>,
                   "T must inherit from Component");
-    auto component = std::make_unique<T>(std::forward<Args>(args)...);
-    auto ptr = component.get();
-    m_components[std::type_index(typeid(T))] = std::move(component);
+    const ComponentTypeId type = componentTypeId<T>();
+    if (m_components[type] != nullptr) {
+      releaseComponent(type, m_components[type]);
+    }
+    T *ptr = nullptr;
+    if (m_storage != nullptr) {
+      ptr = m_storage->create<T>(this, std::forward<Args>(args)...);
+    } else {
+      ptr = new T(std::forward<Args>(args)...);
+    }
+    m_components[type] = ptr;
+    m_mask |= ComponentMask{1} << type;
+    if (m_storage != nullptr) {
+      m_storage->notifyChanged(this, type, true);
+    }
     return ptr;
   }
 
   template <typename T> auto getComponent() -> T * {
-    auto it = m_components.find(std::type_index(typeid(T)));
-    if (it != m_components.end()) {
-      return static_cast<T *>(it->second.get());
-    }
-    return nullptr;
+    return static_cast<T *>(m_components[componentTypeId<T>()]);
   }
 
   template <typename T> auto getComponent() const -> const T * {
-    auto it = m_components.find(std::type_index(typeid(T)));
-    if (it != m_components.end()) {
-      return static_cast<const T *>(it->second.get());
-    }
-    return nullptr;
+    return static_cast<const T *>(m_components[componentTypeId<T>()]);
   }
 
   template <typename T> void removeComponent() {
-    m_components.erase(std::type_index(typeid(T)));
+    const ComponentTypeId type = componentTypeId<T>();
+    if (m_components[type] != nullptr) {
+      releaseComponent(type, m_components[type]);
+      m_components[type] = nullptr;
+      m_mask &= ~(ComponentMask{1} << type);
+    }
   }
 
   template <typename T> auto hasComponent() const -> bool {
-    return m_components.find(std::type_index(typeid(T))) != m_components.end();
+    return (m_mask & componentBit<T>()) != 0;
   }
 
+  [[nodiscard]] auto componentMask() const -> ComponentMask { return m_mask; }
+
 private:
+  void releaseComponent(ComponentTypeId type, Component *component);
+
   EntityID m_id;
-  std::unordered_map<std::type_index, std::unique_ptr<Component>> m_components;
+  ComponentStorage *m_storage = nullptr;
+  ComponentMask m_mask = 0;
+  std::array<Component *, kMaxComponentTypes> m_components{};
 };
 
 } // namespace Engine::Core
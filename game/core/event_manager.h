@@ -2,7 +2,12 @@
 
 #include "../units/spawn_type.h"
 #include "entity.h"
+#include "mpsc_queue.h"
+#include "profiler.h"
+#include <QDebug>
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -25,6 +30,14 @@ template <typename T> using EventHandler = std::function<void(const T &)>;
 
 using SubscriptionHandle = std::size_t;
 
+// Which drain a subscriber's handlers run on. Critical handlers run
+// inline in publish(), on whatever thread published. Late handlers are
+// batched and run together at the frame sync point (dispatchLate()),
+// for listeners that tolerate the extra latency — UI models, audio —
+// so their cost lands at one known place in the frame instead of
+// inside whichever system happened to publish.
+enum class DispatchLane : std::uint8_t { Critical, Late };
+
 struct EventStats {
   size_t publishCount = 0;
   size_t subscriberCount = 0;
@@ -37,8 +50,19 @@ public:
     return inst;
   }
 
+  // Default per-handler dispatch budget; subscribe() callers can raise
+  // it or pass 0 to opt out of the over-budget warning entirely.
+  static constexpr double k_default_subscriber_budget_ms = 0.5;
+
+  // `label` names the subscriber in profiler zones and budget warnings
+  // and must be a string literal (only the pointer is stored); when
+  // null the event's type name is used instead.
   template <typename T>
-  auto subscribe(EventHandler<T> handler) -> SubscriptionHandle {
+  auto subscribe(EventHandler<T> handler,
+                 DispatchLane lane = DispatchLane::Critical,
+                 const char *label = nullptr,
+                 double budgetMs = k_default_subscriber_budget_ms)
+      -> SubscriptionHandle {
     static_assert(std::is_base_of_v<Event, T>, "T must inherit from Event");
     std::lock_guard<std::mutex> const lock(m_mutex);
 
@@ -46,8 +70,10 @@ public:
     auto wrapper = [handler, handle](const void *event) {
       handler(*static_cast<const T *>(event));
     };
-    HandlerEntry const entry{handle, wrapper};
-    m_handlers[std::type_index(typeid(T))].push_back(entry);
+    HandlerEntry entry{handle, wrapper, lane, label,
+                       static_cast<std::uint64_t>(budgetMs * 1.0e6),
+                       std::make_shared<std::atomic<std::uint32_t>>(0)};
+    m_handlers[std::type_index(typeid(T))].push_back(std::move(entry));
 
     m_stats[std::type_index(typeid(T))].subscriberCount++;
 
@@ -74,6 +100,32 @@ public:
     }
   }
 
+  // Queues an event for batched dispatch at the frame sync point. Producers
+  // never block and may call this from any thread; if the ring is full the
+  // event degrades to a synchronous publish. Ownership of the copy stays
+  // with the manager until dispatchQueued() runs it.
+  template <typename T> void publishDeferred(const T &event) {
+    static_assert(std::is_base_of_v<Event, T>, "T must inherit from Event");
+    auto *copy = new T(event);
+    const QueuedEvent item{copy, [](EventManager &manager, const Event *ev) {
+                             manager.publish(*static_cast<const T *>(ev));
+                           }};
+    if (!m_queuedEvents.tryPush(item)) {
+      publish(event);
+      delete copy;
+    }
+  }
+
+  // Drains the deferred queue in FIFO order. Called once per frame from the
+  // sim sync point; single consumer.
+  void dispatchQueued() {
+    QueuedEvent item{};
+    while (m_queuedEvents.tryPop(item)) {
+      item.dispatch(*this, item.event);
+      delete item.event;
+    }
+  }
+
   template <typename T> void publish(const T &event) {
     static_assert(std::is_base_of_v<Event, T>, "T must inherit from Event");
     std::vector<HandlerEntry> handlersCopy;
@@ -87,8 +139,32 @@ public:
       }
     }
 
+    std::shared_ptr<const T> lateCopy;
     for (const auto &entry : handlersCopy) {
-      entry.handler(&event);
+      if (entry.lane == DispatchLane::Late) {
+        // One shared copy feeds every late subscriber of this event.
+        if (!lateCopy) {
+          lateCopy = std::make_shared<const T>(event);
+        }
+        std::lock_guard<std::mutex> const lateLock(m_lateMutex);
+        m_lateLane.push_back(LateItem{lateCopy, entry});
+        continue;
+      }
+      invokeTimed(entry, &event, event.getTypeName());
+    }
+  }
+
+  // Runs handlers that subscribed on the Late lane. Called once per
+  // frame from the sim sync point, right after dispatchQueued(); single
+  // consumer.
+  void dispatchLate() {
+    std::vector<LateItem> batch;
+    {
+      std::lock_guard<std::mutex> const lock(m_lateMutex);
+      batch.swap(m_lateLane);
+    }
+    for (const auto &item : batch) {
+      invokeTimed(item.entry, item.event.get(), item.event->getTypeName());
     }
   }
 
@@ -120,20 +196,75 @@ private:
   struct HandlerEntry {
     SubscriptionHandle handle;
     std::function<void(const void *)> handler;
+    DispatchLane lane = DispatchLane::Critical;
+    // Profiler zone label; the event's type name when null.
+    const char *label = nullptr;
+    // 0 disables the budget warning for this subscriber.
+    std::uint64_t budgetNs = 0;
+    // Shared across the snapshots publish() takes, so the over-budget
+    // throttle survives the handler-vector copy.
+    std::shared_ptr<std::atomic<std::uint32_t>> overBudget;
+  };
+
+  struct QueuedEvent {
+    Event *event = nullptr;
+    void (*dispatch)(EventManager &, const Event *) = nullptr;
+  };
+
+  // One late-lane delivery: the shared event copy plus the subscriber
+  // snapshot taken at publish time.
+  struct LateItem {
+    std::shared_ptr<const Event> event;
+    HandlerEntry entry;
   };
 
+  static constexpr std::size_t kQueueCapacity = 1024;
+  // A persistently slow handler re-warns every this many over-budget
+  // hits, so it stays visible without flooding the log.
+  static constexpr std::uint32_t k_budget_warn_interval = 100;
+
+  // Runs one handler under a profiler zone and checks it against its
+  // dispatch budget. The zone is cheap when the profiler is off, so
+  // every dispatch path goes through here.
+  void invokeTimed(const HandlerEntry &entry, const void *event,
+                   const char *eventName) const {
+    const char *name = entry.label != nullptr ? entry.label : eventName;
+    auto &profiler = Profiler::instance();
+    profiler.pushZone(name);
+    std::uint64_t const begin = Profiler::nowNs();
+    entry.handler(event);
+    std::uint64_t const end = Profiler::nowNs();
+    profiler.popZone();
+    if (entry.budgetNs != 0 && end - begin > entry.budgetNs) {
+      auto const hits =
+          entry.overBudget->fetch_add(1, std::memory_order_relaxed);
+      if (hits % k_budget_warn_interval == 0) {
+        qWarning() << "EventManager: handler" << name << "for" << eventName
+                   << "took" << static_cast<double>(end - begin) / 1.0e6
+                   << "ms (budget"
+                   << static_cast<double>(entry.budgetNs) / 1.0e6 << "ms)";
+      }
+    }
+  }
+
   mutable std::mutex m_mutex;
   std::unordered_map<std::type_index, std::vector<HandlerEntry>> m_handlers;
   std::unordered_map<std::type_index, EventStats> m_stats;
   SubscriptionHandle m_nextHandle = 1;
+  MpscBoundedQueue<QueuedEvent> m_queuedEvents{kQueueCapacity};
+  std::mutex m_lateMutex;
+  std::vector<LateItem> m_lateLane;
 };
 
 template <typename T> class ScopedEventSubscription {
 public:
   ScopedEventSubscription() : m_handle(0) {}
 
-  ScopedEventSubscription(EventHandler<T> handler)
-      : m_handle(EventManager::instance().subscribe<T>(handler)) {}
+  ScopedEventSubscription(EventHandler<T> handler,
+                          DispatchLane lane = DispatchLane::Critical,
+                          const char *label = nullptr)
+      : m_handle(
+            EventManager::instance().subscribe<T>(handler, lane, label)) {}
 
   ~ScopedEventSubscription() { unsubscribe(); }
 
@@ -255,10 +386,21 @@ public:
                     int priority = 0)
       : soundId(std::move(soundId)), volume(volume), loop(loop),
         priority(priority) {}
+  // Positioned variant for world-anchored SFX (combat hits, deaths); the
+  // audio layer culls these by listener distance and fog before they
+  // reach the mixer. Unpositioned triggers (UI, stingers) always play.
+  AudioTriggerEvent(std::string soundId, float worldX, float worldZ,
+                    float volume, bool loop = false, int priority = 0)
+      : soundId(std::move(soundId)), volume(volume), loop(loop),
+        priority(priority), worldX(worldX), worldZ(worldZ),
+        hasPosition(true) {}
   std::string soundId;
   float volume;
   bool loop;
   int priority;
+  float worldX = 0.0F;
+  float worldZ = 0.0F;
+  bool hasPosition = false;
 };
 
 class MusicTriggerEvent : public Event {
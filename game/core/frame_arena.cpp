@@ -0,0 +1,46 @@
+#include "frame_arena.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace Engine::Core {
+
+auto FrameArena::instance() -> FrameArena & {
+  static FrameArena inst;
+  return inst;
+}
+
+auto FrameArena::addBlock(std::size_t min_capacity) -> Block & {
+  const std::size_t capacity = std::max(min_capacity, kBlockSize);
+  Block block;
+  block.data = std::make_unique<std::byte[]>(capacity);
+  block.capacity = capacity;
+  m_blocks.push_back(std::move(block));
+  m_activeBlock = m_blocks.size() - 1;
+  return m_blocks.back();
+}
+
+auto FrameArena::allocate(std::size_t bytes, std::size_t alignment) -> void * {
+  if (m_blocks.empty()) {
+    addBlock(bytes + alignment);
+  }
+  Block *block = &m_blocks[m_activeBlock];
+  auto base = reinterpret_cast<std::uintptr_t>(block->data.get());
+  std::uintptr_t aligned = (base + block->used + alignment - 1) & ~(alignment - 1);
+  std::size_t const needed = (aligned - base) + bytes;
+  if (needed > block->capacity) {
+    block = &addBlock(bytes + alignment);
+    base = reinterpret_cast<std::uintptr_t>(block->data.get());
+    aligned = (base + alignment - 1) & ~(alignment - 1);
+  }
+  block->used = (aligned - base) + bytes;
+  return reinterpret_cast<void *>(aligned);
+}
+
+void FrameArena::reset() {
+  for (auto &block : m_blocks) {
+    block.used = 0;
+  }
+  m_activeBlock = 0;
+}
+
+} // namespace Engine::Core
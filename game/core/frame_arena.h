@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Engine::Core {
+
+// Frame-scoped linear allocator for per-tick scratch collections. Memory is
+// handed out by bumping a pointer through reusable blocks and reclaimed all
+// at once when World::update resets the arena at the end of the sim phase.
+// Sim-thread only: allocations must not outlive the frame and must not be
+// made from worker threads.
+class FrameArena {
+public:
+  static constexpr std::size_t kBlockSize = 256 * 1024;
+
+  static auto instance() -> FrameArena &;
+
+  auto allocate(std::size_t bytes, std::size_t alignment) -> void *;
+  void reset();
+
+  [[nodiscard]] auto blockCount() const -> std::size_t {
+    return m_blocks.size();
+  }
+
+private:
+  struct Block {
+    std::unique_ptr<std::byte[]> data;
+    std::size_t capacity = 0;
+    std::size_t used = 0;
+  };
+
+  auto addBlock(std::size_t min_capacity) -> Block &;
+
+  std::vector<Block> m_blocks;
+  std::size_t m_activeBlock = 0;
+};
+
+// STL-compatible adapter over the frame arena. Deallocation is a no-op; the
+// whole arena is rewound at frame end.
+template <typename T> class FrameAllocator {
+public:
+  using value_type = T;
+
+  FrameAllocator() = default;
+  template <typename U>
+  FrameAllocator(const FrameAllocator<U> & /*other*/) noexcept {}
+
+  auto allocate(std::size_t count) -> T * {
+    return static_cast<T *>(
+        FrameArena::instance().allocate(count * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T * /*ptr*/, std::size_t /*count*/) noexcept {}
+
+  friend auto operator==(const FrameAllocator & /*lhs*/,
+                         const FrameAllocator & /*rhs*/) -> bool {
+    return true;
+  }
+};
+
+template <typename T> using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+} // namespace Engine::Core
@@ -0,0 +1,103 @@
+#include "frame_governor.h"
+#include "profiler.h"
+#include <QDebug>
+#include <cstdint>
+
+namespace {
+
+// Rolling-average thresholds in milliseconds. Raising above the ~30 FPS
+// budget and recovering only well below it is the hysteresis band; a level
+// shift also starts a dwell so two raises cannot land back-to-back while
+// the average still reflects pre-shed frames.
+constexpr double k_raise_ms = 30.0;
+constexpr double k_recover_ms = 22.0;
+constexpr int k_min_frames_between_shifts = 60;
+constexpr int k_calm_frames_to_recover = 120;
+
+constexpr float k_visibility_scale[] = {1.0F, 2.0F, 4.0F};
+constexpr float k_ai_scale[] = {1.0F, 1.5F, 2.0F};
+constexpr float k_veg_distance[] = {0.0F, 90.0F, 55.0F};
+
+// Trace marker names; indexed by the level being entered.
+constexpr const char *k_level_markers[] = {"FrameGovernor::normal",
+                                           "FrameGovernor::reduced",
+                                           "FrameGovernor::minimal"};
+
+} // namespace
+
+namespace Engine::Core {
+
+auto FrameGovernor::instance() -> FrameGovernor & {
+  static FrameGovernor instance;
+  return instance;
+}
+
+void FrameGovernor::beginFrame(double frame_ms) {
+  if (frame_ms <= 0.0) {
+    return;
+  }
+
+  m_sum -= m_samples[m_next];
+  m_samples[m_next] = frame_ms;
+  m_sum += frame_ms;
+  m_next = (m_next + 1) % k_window;
+  if (m_count < k_window) {
+    // Warm up before judging; a partial window over-weights spikes.
+    ++m_count;
+    return;
+  }
+
+  const double avg = m_sum / static_cast<double>(k_window);
+  ++m_framesSinceShift;
+
+  const int level = m_level.load(std::memory_order_relaxed);
+  if (avg > k_raise_ms) {
+    m_calmFrames = 0;
+    if (level < 2 && m_framesSinceShift >= k_min_frames_between_shifts) {
+      setLevel(level + 1, avg);
+    }
+  } else if (avg < k_recover_ms && level > 0) {
+    if (++m_calmFrames >= k_calm_frames_to_recover) {
+      setLevel(level - 1, avg);
+    }
+  } else {
+    m_calmFrames = 0;
+  }
+}
+
+void FrameGovernor::setLevel(int level, double rolling_avg_ms) {
+  m_level.store(level, std::memory_order_relaxed);
+  m_framesSinceShift = 0;
+  m_calmFrames = 0;
+
+  const std::uint64_t now = Profiler::nowNs();
+  Profiler::instance().recordZone(k_level_markers[level], now, now, 0);
+  qInfo() << "Frame governor ->" << k_level_markers[level] << "(rolling avg"
+          << rolling_avg_ms << "ms)";
+}
+
+auto FrameGovernor::visibilityIntervalScale() const -> float {
+  return k_visibility_scale[m_level.load(std::memory_order_relaxed)];
+}
+
+auto FrameGovernor::aiIntervalScale() const -> float {
+  return k_ai_scale[m_level.load(std::memory_order_relaxed)];
+}
+
+auto FrameGovernor::vegetationDrawDistance() const -> float {
+  return k_veg_distance[m_level.load(std::memory_order_relaxed)];
+}
+
+void FrameGovernor::reset() {
+  m_level.store(0, std::memory_order_relaxed);
+  m_sum = 0.0;
+  m_next = 0;
+  m_count = 0;
+  m_framesSinceShift = 0;
+  m_calmFrames = 0;
+  for (auto &sample : m_samples) {
+    sample = 0.0;
+  }
+}
+
+} // namespace Engine::Core
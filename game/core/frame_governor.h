@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace Engine::Core {
+
+// Frame pacing governor: trades deferrable quality for latency when frames
+// run over budget. GameEngine feeds it the profiler's total for every
+// completed frame; the governor keeps a rolling average and steps through
+// shed levels with hysteresis — it raises quickly on sustained overload and
+// recovers only after the average has sat well below budget for a while, so
+// it does not oscillate at the boundary. Consumers poll the knobs: the fog
+// visibility refresh stretches its interval, AI players think less often,
+// and distant vegetation cells stop drawing. Every level change is dropped
+// into the profiler trace as a zero-length marker so shed decisions line up
+// with the frames that caused them.
+//
+// Level reads are relaxed atomics: the AI system polls from the sim tick
+// and the vegetation cullers from the render thread.
+class FrameGovernor {
+public:
+  enum class Level : int { Normal = 0, Reduced = 1, Minimal = 2 };
+
+  static auto instance() -> FrameGovernor &;
+
+  // Called once per frame on the main thread with the last completed
+  // frame's total in milliseconds; non-positive samples are ignored.
+  void beginFrame(double frame_ms);
+
+  [[nodiscard]] auto level() const -> Level {
+    return static_cast<Level>(m_level.load(std::memory_order_relaxed));
+  }
+
+  // Multiplier for the fog-of-war visibility refresh interval.
+  [[nodiscard]] auto visibilityIntervalScale() const -> float;
+  // Multiplier for the per-player AI think interval.
+  [[nodiscard]] auto aiIntervalScale() const -> float;
+  // Camera-distance cap for vegetation cells; cells entirely beyond it are
+  // culled. Non-positive means uncapped.
+  [[nodiscard]] auto vegetationDrawDistance() const -> float;
+
+  // Drops back to Normal and forgets the frame history; used on map loads
+  // so one expensive loading frame cannot start a shed cycle.
+  void reset();
+
+private:
+  FrameGovernor() = default;
+
+  void setLevel(int level, double rolling_avg_ms);
+
+  static constexpr std::size_t k_window = 30;
+
+  std::atomic<int> m_level{0};
+  double m_samples[k_window] = {};
+  double m_sum = 0.0;
+  std::size_t m_next = 0;
+  std::size_t m_count = 0;
+  int m_framesSinceShift = 0;
+  int m_calmFrames = 0;
+};
+
+} // namespace Engine::Core
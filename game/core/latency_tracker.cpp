@@ -0,0 +1,65 @@
+#include "latency_tracker.h"
+#include "profiler.h"
+#include <algorithm>
+
+namespace Engine::Core {
+
+auto LatencyTracker::instance() -> LatencyTracker & {
+  static LatencyTracker inst;
+  return inst;
+}
+
+void LatencyTracker::noteInput() {
+  const std::uint64_t now = Profiler::nowNs();
+  const std::lock_guard<std::mutex> lock(m_mutex);
+  m_pending.push_back(now);
+}
+
+void LatencyTracker::beginSimStep() {
+  const std::lock_guard<std::mutex> lock(m_mutex);
+  m_claimed.insert(m_claimed.end(), m_pending.begin(), m_pending.end());
+  m_pending.clear();
+}
+
+void LatencyTracker::notePresent() {
+  const std::uint64_t now = Profiler::nowNs();
+  const std::lock_guard<std::mutex> lock(m_mutex);
+  for (const std::uint64_t stamp : m_claimed) {
+    if (now > stamp) {
+      m_samplesMs.push_back(static_cast<double>(now - stamp) * 1e-6);
+    }
+  }
+  m_claimed.clear();
+  while (m_samplesMs.size() > k_sample_window) {
+    m_samplesMs.pop_front();
+  }
+}
+
+auto LatencyTracker::stats() const -> Stats {
+  std::vector<double> samples;
+  {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    samples.assign(m_samplesMs.begin(), m_samplesMs.end());
+  }
+  Stats stats;
+  stats.sampleCount = samples.size();
+  if (samples.empty()) {
+    return stats;
+  }
+
+  const auto rank = [&samples](double fraction) -> std::size_t {
+    const auto last = samples.size() - 1;
+    return std::min(last,
+                    static_cast<std::size_t>(
+                        fraction * static_cast<double>(samples.size())));
+  };
+  auto const p50 = samples.begin() + static_cast<std::ptrdiff_t>(rank(0.50));
+  std::nth_element(samples.begin(), p50, samples.end());
+  stats.p50Ms = *p50;
+  auto const p99 = samples.begin() + static_cast<std::ptrdiff_t>(rank(0.99));
+  std::nth_element(samples.begin(), p99, samples.end());
+  stats.p99Ms = *p99;
+  return stats;
+}
+
+} // namespace Engine::Core
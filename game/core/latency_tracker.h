@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace Engine::Core {
+
+// Measures end-to-end input latency: UI input handlers stamp arrival,
+// the engine update claims every stamp still pending when the sim step
+// begins (those inputs are part of the frame it produces), and the
+// window's buffer swap completes the claimed stamps. One sample
+// therefore spans the whole pipeline — Qt event, command, sim tick,
+// snapshot, render, present — and a rolling window of samples feeds
+// the profiler HUD's p50/p99 readout.
+//
+// noteInput runs on the GUI thread; beginSimStep and notePresent run
+// on the render thread. All three are cheap enough to stay compiled in.
+class LatencyTracker {
+public:
+  // Samples retained for the percentile window (~4 s of continuous
+  // input at 60 FPS).
+  static constexpr std::size_t k_sample_window = 256;
+
+  static auto instance() -> LatencyTracker &;
+
+  // Stamps one input event's arrival on the GUI thread.
+  void noteInput();
+
+  // Called at the top of the engine update on the render thread;
+  // claims the pending stamps for the frame this sim step produces.
+  void beginSimStep();
+
+  // Called from the window's frameSwapped signal: the frame carrying
+  // the claimed inputs is on screen, so their samples complete.
+  void notePresent();
+
+  struct Stats {
+    double p50Ms = 0.0;
+    double p99Ms = 0.0;
+    std::size_t sampleCount = 0;
+  };
+
+  // Percentiles over the current sample window; zeros until the first
+  // input completes a round trip.
+  [[nodiscard]] auto stats() const -> Stats;
+
+private:
+  LatencyTracker() = default;
+
+  mutable std::mutex m_mutex;
+  std::vector<std::uint64_t> m_pending;
+  std::vector<std::uint64_t> m_claimed;
+  std::deque<double> m_samplesMs;
+};
+
+} // namespace Engine::Core
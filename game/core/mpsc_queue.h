@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace Engine::Core {
+
+// Bounded lock-free queue (Vyukov-style ring with per-cell sequence
+// numbers). Safe for multiple producers and multiple consumers; used as an
+// MPSC queue by the event manager. Capacity is rounded up to a power of
+// two. tryPush fails when the ring is full rather than blocking.
+template <typename T> class MpscBoundedQueue {
+public:
+  explicit MpscBoundedQueue(std::size_t capacity) {
+    std::size_t rounded = 1;
+    while (rounded < capacity) {
+      rounded <<= 1U;
+    }
+    m_mask = rounded - 1;
+    m_cells = std::make_unique<Cell[]>(rounded);
+    for (std::size_t i = 0; i < rounded; ++i) {
+      m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  auto tryPush(T value) -> bool {
+    std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    while (true) {
+      Cell &cell = m_cells[pos & m_mask];
+      const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(sequence) -
+                        static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (m_enqueuePos.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          cell.value = std::move(value);
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = m_enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  auto tryPop(T &out) -> bool {
+    std::size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+    while (true) {
+      Cell &cell = m_cells[pos & m_mask];
+      const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(sequence) -
+                        static_cast<std::ptrdiff_t>(pos + 1);
+      if (diff == 0) {
+        if (m_dequeuePos.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          out = std::move(cell.value);
+          cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = m_dequeuePos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+private:
+  struct Cell {
+    std::atomic<std::size_t> sequence{0};
+    T value{};
+  };
+
+  std::unique_ptr<Cell[]> m_cells;
+  std::size_t m_mask = 0;
+  alignas(64) std::atomic<std::size_t> m_enqueuePos{0};
+  alignas(64) std::atomic<std::size_t> m_dequeuePos{0};
+};
+
+} // namespace Engine::Core
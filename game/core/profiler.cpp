@@ -0,0 +1,298 @@
+#include "profiler.h"
+#include "alloc_tracker.h"
+#include <QByteArray>
+#include <QFile>
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace Engine::Core {
+
+namespace {
+
+constexpr double k_ns_per_ms = 1.0e6;
+
+thread_local std::uint16_t t_zoneDepth = 0;
+
+// Manual push/pop zones for callback-style call sites; bounded so a
+// missing pop cannot run away.
+constexpr std::size_t k_manual_stack_depth = 32;
+
+struct ManualZone {
+  const char *name = nullptr;
+  std::uint64_t beginNs = 0;
+  std::uint16_t depth = 0;
+};
+
+thread_local std::array<ManualZone, k_manual_stack_depth> t_manualStack;
+thread_local std::size_t t_manualTop = 0;
+
+} // namespace
+
+auto Profiler::instance() -> Profiler & {
+  static Profiler instance;
+  return instance;
+}
+
+auto Profiler::nowNs() -> std::uint64_t {
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+void Profiler::setEnabled(bool enabled) {
+  m_enabled.store(enabled, std::memory_order_relaxed);
+  AllocTracker::setEnabled(enabled);
+}
+
+auto Profiler::threadBuffer() -> ThreadBuffer & {
+  thread_local ThreadBuffer *t_buffer = nullptr;
+  if (t_buffer == nullptr) {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->index = static_cast<int>(m_buffers.size());
+    t_buffer = buffer.get();
+    m_buffers.push_back(std::move(buffer));
+  }
+  return *t_buffer;
+}
+
+void Profiler::recordZone(const char *name, std::uint64_t beginNs,
+                          std::uint64_t endNs, std::uint16_t depth) {
+  auto &buffer = threadBuffer();
+  const std::uint64_t head = buffer.head.load(std::memory_order_relaxed);
+  auto &event = buffer.events[head % k_events_per_thread];
+  event.name = name;
+  event.beginNs = beginNs;
+  event.endNs = endNs;
+  event.depth = depth;
+  buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::pushZone(const char *name) {
+  if (!enabled() || t_manualTop >= k_manual_stack_depth) {
+    return;
+  }
+  t_manualStack[t_manualTop++] = {name, nowNs(), t_zoneDepth++};
+}
+
+void Profiler::popZone() {
+  if (t_manualTop == 0) {
+    return;
+  }
+  const ManualZone zone = t_manualStack[--t_manualTop];
+  if (t_zoneDepth > 0) {
+    --t_zoneDepth;
+  }
+  recordZone(zone.name, zone.beginNs, nowNs(), zone.depth);
+}
+
+void Profiler::beginFrame() {
+  const std::uint64_t now = nowNs();
+  const std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (!enabled()) {
+    // Keep the frame clock current so the first enabled frame does not
+    // absorb the whole disabled span.
+    m_frameBeginNs = now;
+    return;
+  }
+
+  AllocTracker::beginFrame();
+
+  FrameSnapshot snapshot;
+  snapshot.frameIndex = m_frameIndex;
+  snapshot.beginNs = m_frameBeginNs;
+  snapshot.totalMs =
+      static_cast<double>(now - m_frameBeginNs) / k_ns_per_ms;
+
+  for (auto &buffer : m_buffers) {
+    const std::uint64_t head = buffer->head.load(std::memory_order_acquire);
+    if (head - buffer->consumed > k_events_per_thread) {
+      buffer->consumed = head - k_events_per_thread;
+    }
+    for (std::uint64_t i = buffer->consumed; i < head; ++i) {
+      const Event &event = buffer->events[i % k_events_per_thread];
+      ZoneSample sample;
+      sample.name = event.name;
+      sample.startMs =
+          event.beginNs > m_frameBeginNs
+              ? static_cast<double>(event.beginNs - m_frameBeginNs) /
+                    k_ns_per_ms
+              : 0.0;
+      sample.durationMs =
+          static_cast<double>(event.endNs - event.beginNs) / k_ns_per_ms;
+      sample.depth = event.depth;
+      sample.threadIndex = buffer->index;
+      snapshot.zones.push_back(sample);
+    }
+    buffer->consumed = head;
+  }
+
+  if (!m_pendingGpuZones.empty()) {
+    snapshot.zones.insert(snapshot.zones.end(), m_pendingGpuZones.begin(),
+                          m_pendingGpuZones.end());
+    m_pendingGpuZones.clear();
+  }
+
+  // Nested zones complete before their parents, so each thread's events
+  // arrive in end order; begin order is what the overlay indents by.
+  std::stable_sort(snapshot.zones.begin(), snapshot.zones.end(),
+                   [](const ZoneSample &a, const ZoneSample &b) {
+                     if (a.threadIndex != b.threadIndex) {
+                       return a.threadIndex < b.threadIndex;
+                     }
+                     return a.startMs < b.startMs;
+                   });
+
+  if (m_frameIndex >= m_worstExpiresAt ||
+      snapshot.totalMs >= m_worstFrame.totalMs) {
+    m_worstFrame = snapshot;
+    m_worstExpiresAt = m_frameIndex + k_worst_window_frames;
+  }
+  m_history.push_back(snapshot);
+  while (m_history.size() > k_trace_window_frames) {
+    m_history.pop_front();
+  }
+  m_frameTotals.push_back(snapshot.totalMs);
+  while (m_frameTotals.size() > k_median_window_frames) {
+    m_frameTotals.pop_front();
+  }
+  m_lastFrame = std::move(snapshot);
+
+  m_frameBeginNs = now;
+  ++m_frameIndex;
+}
+
+auto Profiler::lastFrame() const -> FrameSnapshot {
+  const std::lock_guard<std::mutex> lock(m_mutex);
+  return m_lastFrame;
+}
+
+auto Profiler::worstFrame() const -> FrameSnapshot {
+  const std::lock_guard<std::mutex> lock(m_mutex);
+  return m_worstFrame;
+}
+
+auto Profiler::lastFrameTotalMs() const -> double {
+  const std::lock_guard<std::mutex> lock(m_mutex);
+  return m_lastFrame.totalMs;
+}
+
+auto Profiler::rollingMedianMs() const -> double {
+  const std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_frameTotals.empty()) {
+    return 0.0;
+  }
+  std::vector<double> totals(m_frameTotals.begin(), m_frameTotals.end());
+  const auto middle = totals.begin() +
+                      static_cast<std::ptrdiff_t>(totals.size() / 2);
+  std::nth_element(totals.begin(), middle, totals.end());
+  return *middle;
+}
+
+void Profiler::setCurrentThreadName(const char *name) {
+  threadBuffer().name = name;
+}
+
+void Profiler::submitGpuZone(const char *name, double durationMs) {
+  if (!enabled()) {
+    return;
+  }
+  const std::lock_guard<std::mutex> lock(m_mutex);
+  ZoneSample sample;
+  sample.name = name;
+  sample.startMs = m_pendingGpuZones.empty()
+                       ? 0.0
+                       : m_pendingGpuZones.back().startMs +
+                             m_pendingGpuZones.back().durationMs;
+  sample.durationMs = durationMs;
+  sample.threadIndex = k_gpu_thread_index;
+  m_pendingGpuZones.push_back(sample);
+}
+
+auto Profiler::writeChromeTrace(const QString &path) const -> bool {
+  // Zone names are string literals and thread names are set by us, so the
+  // JSON can be emitted directly without an escaping pass.
+  QByteArray json;
+  json.reserve(1 << 20);
+  json += "{\"traceEvents\":[";
+  bool first = true;
+
+  const std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_history.empty()) {
+    return false;
+  }
+
+  for (const auto &buffer : m_buffers) {
+    if (buffer->name == nullptr) {
+      continue;
+    }
+    if (!first) {
+      json += ',';
+    }
+    first = false;
+    json += "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":";
+    json += QByteArray::number(buffer->index);
+    json += ",\"args\":{\"name\":\"";
+    json += buffer->name;
+    json += "\"}}";
+  }
+  if (!first) {
+    json += ',';
+  }
+  first = false;
+  json += "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":";
+  json += QByteArray::number(k_gpu_thread_index);
+  json += ",\"args\":{\"name\":\"gpu\"}}";
+
+  // Anchor timestamps at the window start so the trace opens near t=0.
+  const std::uint64_t originNs = m_history.front().beginNs;
+  for (const auto &frame : m_history) {
+    const double frameBeginUs =
+        static_cast<double>(frame.beginNs - originNs) / 1.0e3;
+    for (const auto &zone : frame.zones) {
+      if (!first) {
+        json += ',';
+      }
+      first = false;
+      json += "{\"ph\":\"X\",\"name\":\"";
+      json += zone.name;
+      json += "\",\"pid\":1,\"tid\":";
+      json += QByteArray::number(zone.threadIndex);
+      json += ",\"ts\":";
+      json += QByteArray::number(frameBeginUs + zone.startMs * 1.0e3, 'f', 3);
+      json += ",\"dur\":";
+      json += QByteArray::number(zone.durationMs * 1.0e3, 'f', 3);
+      json += '}';
+    }
+  }
+  json += "]}";
+
+  QFile file(path);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    return false;
+  }
+  return file.write(json) == json.size();
+}
+
+ProfileScope::ProfileScope(const char *name) {
+  if (!Profiler::instance().enabled()) {
+    return;
+  }
+  m_name = name;
+  m_depth = t_zoneDepth++;
+  m_beginNs = Profiler::nowNs();
+}
+
+ProfileScope::~ProfileScope() {
+  if (m_name == nullptr) {
+    return;
+  }
+  --t_zoneDepth;
+  Profiler::instance().recordZone(m_name, m_beginNs, Profiler::nowNs(),
+                                  m_depth);
+}
+
+} // namespace Engine::Core
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <QString>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Engine::Core {
+
+// Lightweight hierarchical profiler. Zones record into lock-free
+// per-thread ring buffers — a disabled zone costs one relaxed atomic
+// load, an enabled one two clock reads and a buffer store — so the
+// instrumentation can stay compiled into release builds and be flipped
+// on from the HUD on player machines. beginFrame() (called once per
+// render frame on the main thread) drains the buffers into a frame
+// snapshot whose zones carry their nesting depth, and keeps the worst
+// frame seen over a rolling window for the overlay's worst-frame view.
+//
+// Zone names must be string literals or otherwise outlive the profiler;
+// only the pointer is stored.
+class Profiler {
+public:
+  static constexpr std::size_t k_events_per_thread = 8192;
+  // Frames the worst-frame snapshot is retained for before it is allowed
+  // to decay to the current frame (~4 s at 30 FPS).
+  static constexpr std::uint64_t k_worst_window_frames = 120;
+  // Completed frames retained for trace export (~20 s at 30 FPS).
+  static constexpr std::size_t k_trace_window_frames = 600;
+  // Frame totals kept for the rolling median the flight recorder's spike
+  // trigger compares against (~8 s at 30 FPS).
+  static constexpr std::size_t k_median_window_frames = 240;
+  // Synthetic track GPU timer-query results are reported on; far above
+  // any real registered thread index.
+  static constexpr int k_gpu_thread_index = 255;
+
+  struct ZoneSample {
+    const char *name = nullptr;
+    // Milliseconds relative to the frame begin; zones started by worker
+    // threads before the frame began clamp to zero.
+    double startMs = 0.0;
+    double durationMs = 0.0;
+    int depth = 0;
+    int threadIndex = 0;
+  };
+
+  struct FrameSnapshot {
+    std::uint64_t frameIndex = 0;
+    // Absolute steady-clock time the frame began at; anchors the
+    // frame-relative zone times when exporting a trace.
+    std::uint64_t beginNs = 0;
+    double totalMs = 0.0;
+    std::vector<ZoneSample> zones;
+  };
+
+  static auto instance() -> Profiler &;
+
+  [[nodiscard]] auto enabled() const -> bool {
+    return m_enabled.load(std::memory_order_relaxed);
+  }
+  void setEnabled(bool enabled);
+
+  // GPU timer queries are gated separately from CPU zone recording: the
+  // always-on flight recorder keeps CPU zones cheap enough for shipped
+  // builds, but queries are only issued while the HUD is open.
+  [[nodiscard]] auto gpuTimingEnabled() const -> bool {
+    return m_gpuTimingEnabled.load(std::memory_order_relaxed);
+  }
+  void setGpuTimingEnabled(bool enabled) {
+    m_gpuTimingEnabled.store(enabled, std::memory_order_relaxed);
+  }
+
+  void beginFrame();
+
+  [[nodiscard]] auto lastFrame() const -> FrameSnapshot;
+  [[nodiscard]] auto worstFrame() const -> FrameSnapshot;
+  // Cheap spike test for auto-export triggers; avoids copying a snapshot.
+  [[nodiscard]] auto lastFrameTotalMs() const -> double;
+  // Median frame total over the last k_median_window_frames completed
+  // frames; the spike trigger fires on a multiple of this rather than an
+  // absolute threshold so it adapts to the machine it runs on.
+  [[nodiscard]] auto rollingMedianMs() const -> double;
+
+  // Labels this thread's buffer in exported traces ("sim worker",
+  // "pathfinding worker", ...). Must be a string literal.
+  void setCurrentThreadName(const char *name);
+
+  // Queues a GPU pass duration for the next frame snapshot. GPU clocks do
+  // not share an epoch with the CPU, so the zones are laid out
+  // back-to-back from the frame start on the synthetic GPU track; the
+  // durations are exact, the placement is approximate.
+  void submitGpuZone(const char *name, double durationMs);
+
+  // Writes the retained frame window as Chrome trace-event JSON
+  // (chrome://tracing / Perfetto). Returns false if nothing was captured
+  // or the file could not be written.
+  [[nodiscard]] auto writeChromeTrace(const QString &path) const -> bool;
+
+  // Zone primitives; prefer the SOI_PROFILE_ZONE macro. The push/pop pair
+  // exists for callback-style instrumentation (render pass hooks) where a
+  // scope object cannot span the zone.
+  static auto nowNs() -> std::uint64_t;
+  void recordZone(const char *name, std::uint64_t beginNs, std::uint64_t endNs,
+                  std::uint16_t depth);
+  void pushZone(const char *name);
+  void popZone();
+
+private:
+  struct Event {
+    const char *name = nullptr;
+    std::uint64_t beginNs = 0;
+    std::uint64_t endNs = 0;
+    std::uint16_t depth = 0;
+  };
+
+  // Single-producer ring; the owning thread bumps head, beginFrame()
+  // consumes from its own cursor and drops the oldest events on overrun.
+  struct ThreadBuffer {
+    std::array<Event, k_events_per_thread> events;
+    std::atomic<std::uint64_t> head{0};
+    std::uint64_t consumed = 0;
+    int index = 0;
+    const char *name = nullptr;
+  };
+
+  Profiler() = default;
+
+  auto threadBuffer() -> ThreadBuffer &;
+
+  std::atomic<bool> m_enabled{false};
+  std::atomic<bool> m_gpuTimingEnabled{false};
+  mutable std::mutex m_mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+  std::uint64_t m_frameBeginNs = 0;
+  std::uint64_t m_frameIndex = 0;
+  FrameSnapshot m_lastFrame;
+  FrameSnapshot m_worstFrame;
+  std::uint64_t m_worstExpiresAt = 0;
+  std::deque<FrameSnapshot> m_history;
+  std::deque<double> m_frameTotals;
+  std::vector<ZoneSample> m_pendingGpuZones;
+};
+
+// Scoped zone; depth tracking is per thread so nested zones reconstruct
+// the call hierarchy in the frame snapshot.
+class ProfileScope {
+public:
+  explicit ProfileScope(const char *name);
+  ~ProfileScope();
+
+  ProfileScope(const ProfileScope &) = delete;
+  auto operator=(const ProfileScope &) -> ProfileScope & = delete;
+  ProfileScope(ProfileScope &&) = delete;
+  auto operator=(ProfileScope &&) -> ProfileScope & = delete;
+
+private:
+  const char *m_name = nullptr;
+  std::uint64_t m_beginNs = 0;
+  std::uint16_t m_depth = 0;
+};
+
+#define SOI_PROFILE_CONCAT_INNER(a, b) a##b
+#define SOI_PROFILE_CONCAT(a, b) SOI_PROFILE_CONCAT_INNER(a, b)
+#define SOI_PROFILE_ZONE(name)                                                 \
+  Engine::Core::ProfileScope const SOI_PROFILE_CONCAT(profile_zone_,           \
+                                                      __LINE__)(name)
+
+} // namespace Engine::Core
@@ -4,6 +4,7 @@
 #include "../units/spawn_type.h"
 #include "../units/troop_type.h"
 #include "component.h"
+#include "component_reflection.h"
 #include "entity.h"
 #include "world.h"
 #include <QByteArray>
@@ -72,319 +73,215 @@ void deserializeColor(const QJsonArray &array, std::array<float, 3> &color) {
   }
 }
 
+// JSON sides of the component_reflection.h field descriptions. Write
+// emits one key per field; read substitutes the description's default
+// for missing keys, preserving the behavior of the old hand-written
+// mapping for saves from earlier versions.
+struct JsonWriteVisitor {
+  QJsonObject &obj;
+
+  void f32(const char *key, float value, float = 0.0F) { obj[key] = value; }
+  void i32(const char *key, int value, int = 0) { obj[key] = value; }
+  void boolean(const char *key, bool value, bool = false) { obj[key] = value; }
+  void u64(const char *key, std::uint64_t value) {
+    obj[key] = static_cast<qint64>(value);
+  }
+  void entityId(const char *key, EntityID value) {
+    obj[key] = static_cast<qint64>(value);
+  }
+  template <typename E> void enumI32(const char *key, E value, E) {
+    obj[key] = static_cast<int>(value);
+  }
+  void str(const char *key, const std::string &value) {
+    obj[key] = QString::fromStdString(value);
+  }
+  void combatMode(const char *key, AttackComponent::CombatMode value) {
+    obj[key] = combatModeToString(value);
+  }
+  void spawnType(const char *key, Game::Units::SpawnType value) {
+    obj[key] = QString::fromStdString(Game::Units::spawn_typeToString(value));
+  }
+  void troopType(const char *key, Game::Units::TroopType value) {
+    obj[key] = QString::fromStdString(Game::Units::troop_typeToString(value));
+  }
+  template <typename Queue>
+  void troopTypeQueue(const char *key, const Queue &queue) {
+    QJsonArray array;
+    for (const auto queued : queue) {
+      array.append(
+          QString::fromStdString(Game::Units::troop_typeToString(queued)));
+    }
+    obj[key] = array;
+  }
+  void color3(const char *key, const std::array<float, 3> &color) {
+    obj[key] = serializeColor(color);
+  }
+  template <typename List>
+  void waypointList(const char *key, const List &points) {
+    QJsonArray array;
+    for (const auto &point : points) {
+      QJsonObject point_obj;
+      point_obj["x"] = point.first;
+      point_obj["y"] = point.second;
+      array.append(point_obj);
+    }
+    obj[key] = array;
+  }
+  void indexU32(const char *key, std::size_t value) {
+    obj[key] = static_cast<int>(value);
+  }
+};
+
+struct JsonReadVisitor {
+  const QJsonObject &obj;
+
+  void f32(const char *key, float &value, float def = 0.0F) {
+    value = static_cast<float>(obj[key].toDouble(static_cast<double>(def)));
+  }
+  void i32(const char *key, int &value, int def = 0) {
+    value = obj[key].toInt(def);
+  }
+  void boolean(const char *key, bool &value, bool def = false) {
+    value = obj[key].toBool(def);
+  }
+  void u64(const char *key, std::uint64_t &value) {
+    value = static_cast<std::uint64_t>(obj[key].toVariant().toULongLong());
+  }
+  void entityId(const char *key, EntityID &value) {
+    value = static_cast<EntityID>(obj[key].toVariant().toULongLong());
+  }
+  template <typename E> void enumI32(const char *key, E &value, E def) {
+    value = static_cast<E>(obj[key].toInt(static_cast<int>(def)));
+  }
+  void str(const char *key, std::string &value) {
+    value = obj[key].toString().toStdString();
+  }
+  void combatMode(const char *key, AttackComponent::CombatMode &value) {
+    value = combatModeFromString(obj[key].toString());
+  }
+  void spawnType(const char *key, Game::Units::SpawnType &value) {
+    const QString text = obj[key].toString();
+    Game::Units::SpawnType parsed;
+    if (Game::Units::tryParseSpawnType(text, parsed)) {
+      value = parsed;
+    } else {
+      qWarning() << "Unknown spawn type in save file:" << text
+                 << "- defaulting to Archer";
+      value = Game::Units::SpawnType::Archer;
+    }
+  }
+  void troopType(const char *key, Game::Units::TroopType &value) {
+    value =
+        Game::Units::troop_typeFromString(obj[key].toString().toStdString());
+  }
+  template <typename Queue>
+  void troopTypeQueue(const char *key, Queue &queue) {
+    queue.clear();
+    const auto array = obj[key].toArray();
+    queue.reserve(array.size());
+    for (const auto &entry : array) {
+      queue.push_back(
+          Game::Units::troop_typeFromString(entry.toString().toStdString()));
+    }
+  }
+  void color3(const char *key, std::array<float, 3> &color) {
+    if (obj.contains(key)) {
+      deserializeColor(obj[key].toArray(), color);
+    }
+  }
+  template <typename List>
+  void waypointList(const char *key, List &points) {
+    points.clear();
+    const auto array = obj[key].toArray();
+    points.reserve(array.size());
+    for (const auto &entry : array) {
+      const auto point_obj = entry.toObject();
+      points.emplace_back(static_cast<float>(point_obj["x"].toDouble()),
+                          static_cast<float>(point_obj["y"].toDouble()));
+    }
+  }
+  void indexU32(const char *key, std::size_t &value) {
+    value = static_cast<std::size_t>(std::max(0, obj[key].toInt()));
+  }
+};
+
 } // namespace
 
 auto Serialization::serializeEntity(const Entity *entity) -> QJsonObject {
   QJsonObject entity_obj;
   entity_obj["id"] = static_cast<qint64>(entity->getId());
 
-  if (const auto *transform = entity->getComponent<TransformComponent>()) {
-    QJsonObject transform_obj;
-    transform_obj["posX"] = transform->position.x;
-    transform_obj["posY"] = transform->position.y;
-    transform_obj["posZ"] = transform->position.z;
-    transform_obj["rotX"] = transform->rotation.x;
-    transform_obj["rotY"] = transform->rotation.y;
-    transform_obj["rotZ"] = transform->rotation.z;
-    transform_obj["scale_x"] = transform->scale.x;
-    transform_obj["scaleY"] = transform->scale.y;
-    transform_obj["scale_z"] = transform->scale.z;
-    transform_obj["hasDesiredYaw"] = transform->hasDesiredYaw;
-    transform_obj["desiredYaw"] = transform->desiredYaw;
-    entity_obj["transform"] = transform_obj;
-  }
-
-  if (const auto *renderable = entity->getComponent<RenderableComponent>()) {
-    QJsonObject renderable_obj;
-    renderable_obj["meshPath"] = QString::fromStdString(renderable->meshPath);
-    renderable_obj["texturePath"] =
-        QString::fromStdString(renderable->texturePath);
-    renderable_obj["visible"] = renderable->visible;
-    renderable_obj["mesh"] = static_cast<int>(renderable->mesh);
-    renderable_obj["color"] = serializeColor(renderable->color);
-    entity_obj["renderable"] = renderable_obj;
-  }
-
-  if (const auto *unit = entity->getComponent<UnitComponent>()) {
-    QJsonObject unit_obj;
-    unit_obj["health"] = unit->health;
-    unit_obj["max_health"] = unit->max_health;
-    unit_obj["speed"] = unit->speed;
-    unit_obj["vision_range"] = unit->vision_range;
-    unit_obj["unit_type"] = QString::fromStdString(
-        Game::Units::spawn_typeToString(unit->spawn_type));
-    unit_obj["owner_id"] = unit->owner_id;
-    entity_obj["unit"] = unit_obj;
-  }
-
-  if (const auto *movement = entity->getComponent<MovementComponent>()) {
-    QJsonObject movement_obj;
-    movement_obj["hasTarget"] = movement->hasTarget;
-    movement_obj["target_x"] = movement->target_x;
-    movement_obj["target_y"] = movement->target_y;
-    movement_obj["goalX"] = movement->goalX;
-    movement_obj["goalY"] = movement->goalY;
-    movement_obj["vx"] = movement->vx;
-    movement_obj["vz"] = movement->vz;
-    movement_obj["pathPending"] = movement->pathPending;
-    movement_obj["pendingRequestId"] =
-        static_cast<qint64>(movement->pendingRequestId);
-    movement_obj["repathCooldown"] = movement->repathCooldown;
-    movement_obj["lastGoalX"] = movement->lastGoalX;
-    movement_obj["lastGoalY"] = movement->lastGoalY;
-    movement_obj["timeSinceLastPathRequest"] =
-        movement->timeSinceLastPathRequest;
-
-    QJsonArray path_array;
-    for (const auto &waypoint : movement->path) {
-      QJsonObject waypoint_obj;
-      waypoint_obj["x"] = waypoint.first;
-      waypoint_obj["y"] = waypoint.second;
-      path_array.append(waypoint_obj);
+  // Field lists live in component_reflection.h; this function only decides
+  // presence and the JSON key each component block lands under.
+  const auto write_component = [&](const char *key, const auto *component) {
+    if (component == nullptr) {
+      return;
     }
-    movement_obj["path"] = path_array;
-    entity_obj["movement"] = movement_obj;
-  }
-
-  if (const auto *attack = entity->getComponent<AttackComponent>()) {
-    QJsonObject attack_obj;
-    attack_obj["range"] = attack->range;
-    attack_obj["damage"] = attack->damage;
-    attack_obj["cooldown"] = attack->cooldown;
-    attack_obj["timeSinceLast"] = attack->timeSinceLast;
-    attack_obj["meleeRange"] = attack->meleeRange;
-    attack_obj["meleeDamage"] = attack->meleeDamage;
-    attack_obj["meleeCooldown"] = attack->meleeCooldown;
-    attack_obj["preferredMode"] = combatModeToString(attack->preferredMode);
-    attack_obj["currentMode"] = combatModeToString(attack->currentMode);
-    attack_obj["canMelee"] = attack->canMelee;
-    attack_obj["canRanged"] = attack->canRanged;
-    attack_obj["max_heightDifference"] = attack->max_heightDifference;
-    attack_obj["inMeleeLock"] = attack->inMeleeLock;
-    attack_obj["meleeLockTargetId"] =
-        static_cast<qint64>(attack->meleeLockTargetId);
-    entity_obj["attack"] = attack_obj;
-  }
-
-  if (const auto *attack_target =
-          entity->getComponent<AttackTargetComponent>()) {
-    QJsonObject attack_targetObj;
-    attack_targetObj["target_id"] =
-        static_cast<qint64>(attack_target->target_id);
-    attack_targetObj["shouldChase"] = attack_target->shouldChase;
-    entity_obj["attack_target"] = attack_targetObj;
-  }
-
-  if (const auto *patrol = entity->getComponent<PatrolComponent>()) {
-    QJsonObject patrol_obj;
-    patrol_obj["currentWaypoint"] = static_cast<int>(patrol->currentWaypoint);
-    patrol_obj["patrolling"] = patrol->patrolling;
-
-    QJsonArray waypoints_array;
-    for (const auto &waypoint : patrol->waypoints) {
-      QJsonObject waypoint_obj;
-      waypoint_obj["x"] = waypoint.first;
-      waypoint_obj["y"] = waypoint.second;
-      waypoints_array.append(waypoint_obj);
-    }
-    patrol_obj["waypoints"] = waypoints_array;
-    entity_obj["patrol"] = patrol_obj;
-  }
+    QJsonObject component_obj;
+    JsonWriteVisitor visitor{component_obj};
+    reflectConst(*component, visitor);
+    entity_obj[key] = component_obj;
+  };
+
+  write_component("transform", entity->getComponent<TransformComponent>());
+  write_component("renderable", entity->getComponent<RenderableComponent>());
+  write_component("unit", entity->getComponent<UnitComponent>());
+  write_component("movement", entity->getComponent<MovementComponent>());
+  write_component("attack", entity->getComponent<AttackComponent>());
+  write_component("attack_target",
+                  entity->getComponent<AttackTargetComponent>());
+  write_component("patrol", entity->getComponent<PatrolComponent>());
 
   if (entity->getComponent<BuildingComponent>() != nullptr) {
     entity_obj["building"] = true;
   }
 
-  if (const auto *production = entity->getComponent<ProductionComponent>()) {
-    QJsonObject production_obj;
-    production_obj["inProgress"] = production->inProgress;
-    production_obj["buildTime"] = production->buildTime;
-    production_obj["timeRemaining"] = production->timeRemaining;
-    production_obj["producedCount"] = production->producedCount;
-    production_obj["maxUnits"] = production->maxUnits;
-    production_obj["product_type"] = QString::fromStdString(
-        Game::Units::troop_typeToString(production->product_type));
-    production_obj["rallyX"] = production->rallyX;
-    production_obj["rallyZ"] = production->rallyZ;
-    production_obj["rallySet"] = production->rallySet;
-    production_obj["villagerCost"] = production->villagerCost;
-
-    QJsonArray queue_array;
-    for (const auto &queued : production->productionQueue) {
-      queue_array.append(
-          QString::fromStdString(Game::Units::troop_typeToString(queued)));
-    }
-    production_obj["queue"] = queue_array;
-    entity_obj["production"] = production_obj;
-  }
+  write_component("production", entity->getComponent<ProductionComponent>());
 
   if (entity->getComponent<AIControlledComponent>() != nullptr) {
     entity_obj["aiControlled"] = true;
   }
 
-  if (const auto *capture = entity->getComponent<CaptureComponent>()) {
-    QJsonObject capture_obj;
-    capture_obj["capturing_player_id"] = capture->capturing_player_id;
-    capture_obj["captureProgress"] =
-        static_cast<double>(capture->captureProgress);
-    capture_obj["requiredTime"] = static_cast<double>(capture->requiredTime);
-    capture_obj["isBeingCaptured"] = capture->isBeingCaptured;
-    entity_obj["capture"] = capture_obj;
-  }
+  write_component("capture", entity->getComponent<CaptureComponent>());
 
   return entity_obj;
 }
 
 void Serialization::deserializeEntity(Entity *entity, const QJsonObject &json) {
+  const auto read_component = [&](const char *key, auto *component) {
+    const auto component_obj = json[key].toObject();
+    JsonReadVisitor visitor{component_obj};
+    reflectComponent(*component, visitor);
+  };
+
   if (json.contains("transform")) {
-    const auto transform_obj = json["transform"].toObject();
-    auto *transform = entity->addComponent<TransformComponent>();
-    transform->position.x =
-        static_cast<float>(transform_obj["posX"].toDouble());
-    transform->position.y =
-        static_cast<float>(transform_obj["posY"].toDouble());
-    transform->position.z =
-        static_cast<float>(transform_obj["posZ"].toDouble());
-    transform->rotation.x =
-        static_cast<float>(transform_obj["rotX"].toDouble());
-    transform->rotation.y =
-        static_cast<float>(transform_obj["rotY"].toDouble());
-    transform->rotation.z =
-        static_cast<float>(transform_obj["rotZ"].toDouble());
-    transform->scale.x =
-        static_cast<float>(transform_obj["scale_x"].toDouble());
-    transform->scale.y = static_cast<float>(transform_obj["scaleY"].toDouble());
-    transform->scale.z =
-        static_cast<float>(transform_obj["scale_z"].toDouble());
-    transform->hasDesiredYaw = transform_obj["hasDesiredYaw"].toBool(false);
-    transform->desiredYaw =
-        static_cast<float>(transform_obj["desiredYaw"].toDouble());
+    read_component("transform", entity->addComponent<TransformComponent>());
   }
 
   if (json.contains("renderable")) {
-    const auto renderable_obj = json["renderable"].toObject();
-    auto *renderable = entity->addComponent<RenderableComponent>("", "");
-    renderable->meshPath = renderable_obj["meshPath"].toString().toStdString();
-    renderable->texturePath =
-        renderable_obj["texturePath"].toString().toStdString();
-    renderable->visible = renderable_obj["visible"].toBool(true);
-    renderable->mesh =
-        static_cast<RenderableComponent::MeshKind>(renderable_obj["mesh"].toInt(
-            static_cast<int>(RenderableComponent::MeshKind::Cube)));
-    if (renderable_obj.contains("color")) {
-      deserializeColor(renderable_obj["color"].toArray(), renderable->color);
-    }
+    read_component("renderable",
+                   entity->addComponent<RenderableComponent>("", ""));
   }
 
   if (json.contains("unit")) {
-    const auto unit_obj = json["unit"].toObject();
-    auto *unit = entity->addComponent<UnitComponent>();
-    unit->health = unit_obj["health"].toInt(Defaults::kUnitDefaultHealth);
-    unit->max_health =
-        unit_obj["max_health"].toInt(Defaults::kUnitDefaultHealth);
-    unit->speed = static_cast<float>(unit_obj["speed"].toDouble());
-    unit->vision_range = static_cast<float>(unit_obj["vision_range"].toDouble(
-        static_cast<double>(Defaults::kUnitDefaultVisionRange)));
-
-    QString const unit_type_str = unit_obj["unit_type"].toString();
-    Game::Units::SpawnType spawn_type;
-    if (Game::Units::tryParseSpawnType(unit_type_str, spawn_type)) {
-      unit->spawn_type = spawn_type;
-    } else {
-      qWarning() << "Unknown spawn type in save file:" << unit_type_str
-                 << "- defaulting to Archer";
-      unit->spawn_type = Game::Units::SpawnType::Archer;
-    }
-
-    unit->owner_id = unit_obj["owner_id"].toInt(0);
+    read_component("unit", entity->addComponent<UnitComponent>());
   }
 
   if (json.contains("movement")) {
-    const auto movement_obj = json["movement"].toObject();
-    auto *movement = entity->addComponent<MovementComponent>();
-    movement->hasTarget = movement_obj["hasTarget"].toBool(false);
-    movement->target_x =
-        static_cast<float>(movement_obj["target_x"].toDouble());
-    movement->target_y =
-        static_cast<float>(movement_obj["target_y"].toDouble());
-    movement->goalX = static_cast<float>(movement_obj["goalX"].toDouble());
-    movement->goalY = static_cast<float>(movement_obj["goalY"].toDouble());
-    movement->vx = static_cast<float>(movement_obj["vx"].toDouble());
-    movement->vz = static_cast<float>(movement_obj["vz"].toDouble());
-    movement->pathPending = movement_obj["pathPending"].toBool(false);
-    movement->pendingRequestId = static_cast<std::uint64_t>(
-        movement_obj["pendingRequestId"].toVariant().toULongLong());
-    movement->repathCooldown =
-        static_cast<float>(movement_obj["repathCooldown"].toDouble());
-    movement->lastGoalX =
-        static_cast<float>(movement_obj["lastGoalX"].toDouble());
-    movement->lastGoalY =
-        static_cast<float>(movement_obj["lastGoalY"].toDouble());
-    movement->timeSinceLastPathRequest =
-        static_cast<float>(movement_obj["timeSinceLastPathRequest"].toDouble());
-
-    movement->path.clear();
-    const auto path_array = movement_obj["path"].toArray();
-    movement->path.reserve(path_array.size());
-    for (const auto &value : path_array) {
-      const auto waypoint_obj = value.toObject();
-      movement->path.emplace_back(
-          static_cast<float>(waypoint_obj["x"].toDouble()),
-          static_cast<float>(waypoint_obj["y"].toDouble()));
-    }
+    read_component("movement", entity->addComponent<MovementComponent>());
   }
 
   if (json.contains("attack")) {
-    const auto attack_obj = json["attack"].toObject();
-    auto *attack = entity->addComponent<AttackComponent>();
-    attack->range = static_cast<float>(attack_obj["range"].toDouble());
-    attack->damage = attack_obj["damage"].toInt(0);
-    attack->cooldown = static_cast<float>(attack_obj["cooldown"].toDouble());
-    attack->timeSinceLast =
-        static_cast<float>(attack_obj["timeSinceLast"].toDouble());
-    attack->meleeRange = static_cast<float>(attack_obj["meleeRange"].toDouble(
-        static_cast<double>(Defaults::kAttackMeleeRange)));
-    attack->meleeDamage = attack_obj["meleeDamage"].toInt(0);
-    attack->meleeCooldown =
-        static_cast<float>(attack_obj["meleeCooldown"].toDouble());
-    attack->preferredMode =
-        combatModeFromString(attack_obj["preferredMode"].toString());
-    attack->currentMode =
-        combatModeFromString(attack_obj["currentMode"].toString());
-    attack->canMelee = attack_obj["canMelee"].toBool(true);
-    attack->canRanged = attack_obj["canRanged"].toBool(false);
-    attack->max_heightDifference =
-        static_cast<float>(attack_obj["max_heightDifference"].toDouble(
-            static_cast<double>(Defaults::kAttackHeightTolerance)));
-    attack->inMeleeLock = attack_obj["inMeleeLock"].toBool(false);
-    attack->meleeLockTargetId = static_cast<EntityID>(
-        attack_obj["meleeLockTargetId"].toVariant().toULongLong());
+    read_component("attack", entity->addComponent<AttackComponent>());
   }
 
   if (json.contains("attack_target")) {
-    const auto attack_targetObj = json["attack_target"].toObject();
-    auto *attack_target = entity->addComponent<AttackTargetComponent>();
-    attack_target->target_id = static_cast<EntityID>(
-        attack_targetObj["target_id"].toVariant().toULongLong());
-    attack_target->shouldChase = attack_targetObj["shouldChase"].toBool(false);
+    read_component("attack_target",
+                   entity->addComponent<AttackTargetComponent>());
   }
 
   if (json.contains("patrol")) {
-    const auto patrol_obj = json["patrol"].toObject();
-    auto *patrol = entity->addComponent<PatrolComponent>();
-    patrol->currentWaypoint =
-        static_cast<size_t>(std::max(0, patrol_obj["currentWaypoint"].toInt()));
-    patrol->patrolling = patrol_obj["patrolling"].toBool(false);
-
-    patrol->waypoints.clear();
-    const auto waypoints_array = patrol_obj["waypoints"].toArray();
-    patrol->waypoints.reserve(waypoints_array.size());
-    for (const auto &value : waypoints_array) {
-      const auto waypoint_obj = value.toObject();
-      patrol->waypoints.emplace_back(
-          static_cast<float>(waypoint_obj["x"].toDouble()),
-          static_cast<float>(waypoint_obj["y"].toDouble()));
-    }
+    read_component("patrol", entity->addComponent<PatrolComponent>());
   }
 
   if (json.contains("building") && json["building"].toBool()) {
@@ -392,31 +289,7 @@ void Serialization::deserializeEntity(Entity *entity, const QJsonObject &json) {
   }
 
   if (json.contains("production")) {
-    const auto production_obj = json["production"].toObject();
-    auto *production = entity->addComponent<ProductionComponent>();
-    production->inProgress = production_obj["inProgress"].toBool(false);
-    production->buildTime =
-        static_cast<float>(production_obj["buildTime"].toDouble());
-    production->timeRemaining =
-        static_cast<float>(production_obj["timeRemaining"].toDouble());
-    production->producedCount = production_obj["producedCount"].toInt(0);
-    production->maxUnits = production_obj["maxUnits"].toInt(0);
-    production->product_type = Game::Units::troop_typeFromString(
-        production_obj["product_type"].toString().toStdString());
-    production->rallyX =
-        static_cast<float>(production_obj["rallyX"].toDouble());
-    production->rallyZ =
-        static_cast<float>(production_obj["rallyZ"].toDouble());
-    production->rallySet = production_obj["rallySet"].toBool(false);
-    production->villagerCost = production_obj["villagerCost"].toInt(1);
-
-    production->productionQueue.clear();
-    const auto queue_array = production_obj["queue"].toArray();
-    production->productionQueue.reserve(queue_array.size());
-    for (const auto &value : queue_array) {
-      production->productionQueue.push_back(
-          Game::Units::troop_typeFromString(value.toString().toStdString()));
-    }
+    read_component("production", entity->addComponent<ProductionComponent>());
   }
 
   if (json.contains("aiControlled") && json["aiControlled"].toBool()) {
@@ -424,15 +297,7 @@ void Serialization::deserializeEntity(Entity *entity, const QJsonObject &json) {
   }
 
   if (json.contains("capture")) {
-    const auto capture_obj = json["capture"].toObject();
-    auto *capture = entity->addComponent<CaptureComponent>();
-    capture->capturing_player_id = capture_obj["capturing_player_id"].toInt(-1);
-    capture->captureProgress =
-        static_cast<float>(capture_obj["captureProgress"].toDouble(0.0));
-    capture->requiredTime =
-        static_cast<float>(capture_obj["requiredTime"].toDouble(
-            static_cast<double>(Defaults::kCaptureRequiredTime)));
-    capture->isBeingCaptured = capture_obj["isBeingCaptured"].toBool(false);
+    read_component("capture", entity->addComponent<CaptureComponent>());
   }
 }
 
@@ -718,9 +583,9 @@ auto Serialization::serializeWorld(const World *world) -> QJsonDocument {
   QJsonObject world_obj;
   QJsonArray entities_array;
 
-  const auto &entities = world->getEntities();
-  for (const auto &[id, entity] : entities) {
-    QJsonObject const entity_obj = serializeEntity(entity.get());
+  const auto &entities = world->entities();
+  for (const Entity *entity : entities) {
+    QJsonObject const entity_obj = serializeEntity(entity);
     entities_array.append(entity_obj);
   }
 
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Engine::Core {
+
+// Q40.24 fixed-point scalar built on integer arithmetic only, so the
+// same inputs produce bit-identical results on every conforming
+// compiler regardless of FMA contraction or x87/SSE settings. The
+// 24-bit fraction matches float precision over world-sized magnitudes
+// and survives the float round-trips at the component boundary.
+class Fixed64 {
+public:
+  constexpr Fixed64() = default;
+
+  static auto fromFloat(float value) -> Fixed64 {
+    // Scaling by a power of two is exact in double, and double holds
+    // every float times 2^24 exactly; the truncation to integer is then
+    // the only rounding step and is identical everywhere.
+    Fixed64 result;
+    result.m_raw =
+        static_cast<std::int64_t>(static_cast<double>(value) * k_one);
+    return result;
+  }
+
+  [[nodiscard]] auto toFloat() const -> float {
+    return static_cast<float>(static_cast<double>(m_raw) * (1.0 / k_one));
+  }
+
+  friend constexpr auto operator+(Fixed64 a, Fixed64 b) -> Fixed64 {
+    return fromRaw(a.m_raw + b.m_raw);
+  }
+  friend constexpr auto operator-(Fixed64 a, Fixed64 b) -> Fixed64 {
+    return fromRaw(a.m_raw - b.m_raw);
+  }
+  friend constexpr auto operator*(Fixed64 a, Fixed64 b) -> Fixed64 {
+    return fromRaw(mulRaw(a.m_raw, b.m_raw));
+  }
+  friend constexpr auto operator<(Fixed64 a, Fixed64 b) -> bool {
+    return a.m_raw < b.m_raw;
+  }
+
+private:
+  static constexpr unsigned k_frac_bits = 24U;
+  static constexpr double k_one = 16777216.0; // 2^24
+
+  static constexpr auto fromRaw(std::int64_t raw) -> Fixed64 {
+    Fixed64 result;
+    result.m_raw = raw;
+    return result;
+  }
+
+  // 64x64 -> 128-bit product assembled from 32-bit limbs (no __int128,
+  // which MSVC lacks), then shifted down by the fraction width.
+  static constexpr auto mulRaw(std::int64_t a, std::int64_t b)
+      -> std::int64_t {
+    bool const negative = (a < 0) != (b < 0);
+    auto const ua = static_cast<std::uint64_t>(a < 0 ? -a : a);
+    auto const ub = static_cast<std::uint64_t>(b < 0 ? -b : b);
+    std::uint64_t const a_hi = ua >> 32U;
+    std::uint64_t const a_lo = ua & 0xFFFFFFFFULL;
+    std::uint64_t const b_hi = ub >> 32U;
+    std::uint64_t const b_lo = ub & 0xFFFFFFFFULL;
+    std::uint64_t const lo_lo = a_lo * b_lo;
+    std::uint64_t const mid1 = a_hi * b_lo;
+    std::uint64_t const mid2 = a_lo * b_hi;
+    std::uint64_t const hi_hi = a_hi * b_hi;
+    std::uint64_t const lo1 = lo_lo + (mid1 << 32U);
+    std::uint64_t carry = (lo1 < lo_lo) ? 1U : 0U;
+    std::uint64_t const lo2 = lo1 + (mid2 << 32U);
+    carry += (lo2 < lo1) ? 1U : 0U;
+    std::uint64_t const hi = hi_hi + (mid1 >> 32U) + (mid2 >> 32U) + carry;
+    auto const magnitude = static_cast<std::int64_t>(
+        (lo2 >> k_frac_bits) | (hi << (64U - k_frac_bits)));
+    return negative ? -magnitude : magnitude;
+  }
+
+  std::int64_t m_raw = 0;
+};
+
+// Scalar type the sim's accumulation arithmetic runs through. The
+// default is plain float (zero overhead, current behavior); building
+// with SOI_FIXED_POINT_SIM routes the helpers below through Fixed64 so
+// position and timer integration is bit-identical across machines and
+// the per-tick checksum stream (computeWorldChecksum) from a replay
+// recorded on one platform verifies on another.
+#if defined(SOI_FIXED_POINT_SIM)
+using SimScalar = Fixed64;
+#else
+using SimScalar = float;
+#endif
+
+// Accumulation helpers for sim state that persists across ticks
+// (positions, velocities, cooldown timers). Float mode compiles to
+// exactly the expressions the call sites inlined before; fixed mode
+// rounds every product and sum through Q40.24.
+#if defined(SOI_FIXED_POINT_SIM)
+
+[[nodiscard]] inline auto simIntegrate(float value, float rate,
+                                       float dt) -> float {
+  return (Fixed64::fromFloat(value) +
+          Fixed64::fromFloat(rate) * Fixed64::fromFloat(dt))
+      .toFloat();
+}
+
+[[nodiscard]] inline auto simAccumulate(float accum, float dt) -> float {
+  return (Fixed64::fromFloat(accum) + Fixed64::fromFloat(dt)).toFloat();
+}
+
+[[nodiscard]] inline auto simScale(float value, float factor) -> float {
+  return (Fixed64::fromFloat(value) * Fixed64::fromFloat(factor)).toFloat();
+}
+
+#else
+
+[[nodiscard]] inline auto simIntegrate(float value, float rate,
+                                       float dt) -> float {
+  return value + rate * dt;
+}
+
+[[nodiscard]] inline auto simAccumulate(float accum, float dt) -> float {
+  return accum + dt;
+}
+
+[[nodiscard]] inline auto simScale(float value, float factor) -> float {
+  return value * factor;
+}
+
+#endif
+
+} // namespace Engine::Core
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Engine::Core {
+
+// Contiguous growable array with inline storage for the first N elements.
+// Per-entity collections — movement paths, patrol waypoints, production
+// queues — hold a handful of entries almost always, but std::vector puts
+// even a two-element list on the heap; with tens of thousands of entities
+// that churn dominates the tagged allocator's per-frame counts. Elements
+// live in the inline buffer until the N+1th push, then spill to a heap
+// block with the usual doubling growth, so long paths cost what they did
+// before.
+//
+// The API is the std::vector subset the component code uses; assignment
+// from std::vector is supported so producers (pathfinding results) can
+// keep returning plain vectors.
+template <typename T, std::size_t N> class SmallVector {
+public:
+  using value_type = T;
+  using iterator = T *;
+  using const_iterator = const T *;
+
+  SmallVector() = default;
+
+  SmallVector(const SmallVector &other) {
+    appendFrom(other.m_data, other.m_size);
+  }
+
+  SmallVector(SmallVector &&other) noexcept { stealOrMove(std::move(other)); }
+
+  auto operator=(const SmallVector &other) -> SmallVector & {
+    if (this != &other) {
+      clear();
+      appendFrom(other.m_data, other.m_size);
+    }
+    return *this;
+  }
+
+  auto operator=(SmallVector &&other) noexcept -> SmallVector & {
+    if (this != &other) {
+      releaseStorage();
+      stealOrMove(std::move(other));
+    }
+    return *this;
+  }
+
+  auto operator=(const std::vector<T> &other) -> SmallVector & {
+    clear();
+    appendFrom(other.data(), other.size());
+    return *this;
+  }
+
+  auto operator=(std::vector<T> &&other) -> SmallVector & {
+    clear();
+    reserve(other.size());
+    for (auto &value : other) {
+      new (m_data + m_size) T(std::move(value));
+      ++m_size;
+    }
+    other.clear();
+    return *this;
+  }
+
+  ~SmallVector() { releaseStorage(); }
+
+  [[nodiscard]] auto size() const -> std::size_t { return m_size; }
+  [[nodiscard]] auto empty() const -> bool { return m_size == 0; }
+  [[nodiscard]] auto capacity() const -> std::size_t { return m_capacity; }
+
+  [[nodiscard]] auto data() -> T * { return m_data; }
+  [[nodiscard]] auto data() const -> const T * { return m_data; }
+
+  [[nodiscard]] auto begin() -> iterator { return m_data; }
+  [[nodiscard]] auto begin() const -> const_iterator { return m_data; }
+  [[nodiscard]] auto end() -> iterator { return m_data + m_size; }
+  [[nodiscard]] auto end() const -> const_iterator { return m_data + m_size; }
+
+  auto operator[](std::size_t index) -> T & { return m_data[index]; }
+  auto operator[](std::size_t index) const -> const T & {
+    return m_data[index];
+  }
+
+  [[nodiscard]] auto front() -> T & { return m_data[0]; }
+  [[nodiscard]] auto front() const -> const T & { return m_data[0]; }
+  [[nodiscard]] auto back() -> T & { return m_data[m_size - 1]; }
+  [[nodiscard]] auto back() const -> const T & { return m_data[m_size - 1]; }
+
+  void reserve(std::size_t wanted) {
+    if (wanted > m_capacity) {
+      grow(wanted);
+    }
+  }
+
+  void clear() {
+    std::destroy_n(m_data, m_size);
+    m_size = 0;
+  }
+
+  void push_back(const T &value) { emplace_back(value); }
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+
+  template <typename... Args> auto emplace_back(Args &&...args) -> T & {
+    if (m_size == m_capacity) {
+      grow(m_capacity * 2);
+    }
+    T *slot = new (m_data + m_size) T(std::forward<Args>(args)...);
+    ++m_size;
+    return *slot;
+  }
+
+  void pop_back() {
+    --m_size;
+    std::destroy_at(m_data + m_size);
+  }
+
+  auto erase(const_iterator pos) -> iterator {
+    auto *target = m_data + (pos - m_data);
+    std::move(target + 1, m_data + m_size, target);
+    pop_back();
+    return target;
+  }
+
+  void resize(std::size_t wanted) {
+    if (wanted < m_size) {
+      std::destroy_n(m_data + wanted, m_size - wanted);
+      m_size = wanted;
+      return;
+    }
+    reserve(wanted);
+    while (m_size < wanted) {
+      new (m_data + m_size) T();
+      ++m_size;
+    }
+  }
+
+private:
+  [[nodiscard]] auto inlineData() -> T * {
+    return reinterpret_cast<T *>(m_inline);
+  }
+
+  [[nodiscard]] auto onHeap() const -> bool {
+    return m_data != reinterpret_cast<const T *>(m_inline);
+  }
+
+  void grow(std::size_t wanted) {
+    const std::size_t new_capacity = wanted > m_capacity ? wanted : m_capacity;
+    T *block = std::allocator<T>().allocate(new_capacity);
+    std::uninitialized_move_n(m_data, m_size, block);
+    std::destroy_n(m_data, m_size);
+    if (onHeap()) {
+      std::allocator<T>().deallocate(m_data, m_capacity);
+    }
+    m_data = block;
+    m_capacity = new_capacity;
+  }
+
+  void appendFrom(const T *source, std::size_t count) {
+    reserve(count);
+    std::uninitialized_copy_n(source, count, m_data);
+    m_size = count;
+  }
+
+  // Heap blocks transfer by pointer; inline contents have to move
+  // element-wise. Either way the source ends up empty and inline.
+  void stealOrMove(SmallVector &&other) {
+    m_data = inlineData();
+    m_size = 0;
+    m_capacity = N;
+    if (other.onHeap()) {
+      m_data = other.m_data;
+      m_size = other.m_size;
+      m_capacity = other.m_capacity;
+    } else {
+      std::uninitialized_move_n(other.m_data, other.m_size, m_data);
+      m_size = other.m_size;
+      std::destroy_n(other.m_data, other.m_size);
+    }
+    other.m_data = other.inlineData();
+    other.m_size = 0;
+    other.m_capacity = N;
+  }
+
+  void releaseStorage() {
+    clear();
+    if (onHeap()) {
+      std::allocator<T>().deallocate(m_data, m_capacity);
+    }
+  }
+
+  alignas(T) std::byte m_inline[N * sizeof(T)];
+  T *m_data = reinterpret_cast<T *>(m_inline);
+  std::size_t m_size = 0;
+  std::size_t m_capacity = N;
+};
+
+} // namespace Engine::Core
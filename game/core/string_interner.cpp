@@ -0,0 +1,45 @@
+#include "string_interner.h"
+
+namespace Engine::Core {
+
+namespace {
+const std::string k_empty;
+} // namespace
+
+auto StringInterner::instance() -> StringInterner & {
+  static StringInterner inst;
+  return inst;
+}
+
+auto StringInterner::intern(const std::string &name) -> StringId {
+  std::lock_guard<std::mutex> const lock(m_mutex);
+  auto it = m_idsByName.find(name);
+  if (it != m_idsByName.end()) {
+    return it->second;
+  }
+  m_names.push_back(name);
+  auto const id = static_cast<StringId>(m_names.size());
+  m_idsByName.emplace(name, id);
+  return id;
+}
+
+auto StringInterner::find(const std::string &name) const -> StringId {
+  std::lock_guard<std::mutex> const lock(m_mutex);
+  auto it = m_idsByName.find(name);
+  return it != m_idsByName.end() ? it->second : 0;
+}
+
+auto StringInterner::resolve(StringId id) const -> const std::string & {
+  std::lock_guard<std::mutex> const lock(m_mutex);
+  if (id == 0 || id > m_names.size()) {
+    return k_empty;
+  }
+  return m_names[id - 1];
+}
+
+auto StringInterner::size() const -> std::size_t {
+  std::lock_guard<std::mutex> const lock(m_mutex);
+  return m_names.size();
+}
+
+} // namespace Engine::Core
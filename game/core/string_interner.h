@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace Engine::Core {
+
+// Stable 32-bit symbol for an interned string. 0 is never assigned and
+// means "no symbol".
+using StringId = std::uint32_t;
+
+// Global append-only intern table. Names are registered once (at startup
+// or load time) and map to stable ids, so registries can key their maps
+// by integer and compare names with == instead of rehashing string keys
+// in hot paths. Stored names live in a deque so references stay valid as
+// the table grows; ids are never reused.
+class StringInterner {
+public:
+  static auto instance() -> StringInterner &;
+
+  // Symbol for name, registering it on first use.
+  auto intern(const std::string &name) -> StringId;
+
+  // Symbol for an already-registered name, or 0 when unknown.
+  [[nodiscard]] auto find(const std::string &name) const -> StringId;
+
+  // Name behind a symbol; the empty string for 0 or unknown ids.
+  [[nodiscard]] auto resolve(StringId id) const -> const std::string &;
+
+  [[nodiscard]] auto size() const -> std::size_t;
+
+private:
+  StringInterner() = default;
+  ~StringInterner() = default;
+  StringInterner(const StringInterner &) = delete;
+  auto operator=(const StringInterner &) -> StringInterner & = delete;
+
+  mutable std::mutex m_mutex;
+  std::unordered_map<std::string, StringId> m_idsByName;
+  std::deque<std::string> m_names;
+};
+
+} // namespace Engine::Core
@@ -1,11 +1,22 @@
 #pragma once
 
+#include "component_type_id.h"
 #include <memory>
 
 namespace Engine::Core {
 
 class World;
 
+// Declared component access of a system. Systems whose read/write sets do
+// not conflict and that opt out of exclusive execution may be run
+// concurrently by the scheduler; the default keeps a system alone on the
+// sim thread in declaration order.
+struct SystemAccess {
+  ComponentMask reads = 0;
+  ComponentMask writes = 0;
+  bool exclusive = true;
+};
+
 class System {
 public:
   System() = default;
@@ -15,6 +26,15 @@ public:
   auto operator=(System &&) noexcept -> System & = default;
   virtual ~System() = default;
   virtual void update(World *world, float deltaTime) = 0;
+  [[nodiscard]] virtual auto access() const -> SystemAccess { return {}; }
+  // Display name for profiler zones and scheduler diagnostics.
+  [[nodiscard]] virtual auto name() const -> const char * { return "System"; }
+  // Number of sim ticks between runs. Systems returning N > 1 are skipped
+  // on off frames and receive the deltaTime accumulated since their last
+  // run, so time-integrating logic stays correct at any rate. World
+  // staggers due frames by declaration index so low-rate systems don't all
+  // land on the same tick.
+  [[nodiscard]] virtual auto tickInterval() const -> int { return 1; }
 };
 
 } // namespace Engine::Core
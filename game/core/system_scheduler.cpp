@@ -0,0 +1,116 @@
+#include "system_scheduler.h"
+#include "system.h"
+#include "profiler.h"
+#include "../../render/thread_topology.h"
+#include <algorithm>
+
+namespace Engine::Core {
+
+SystemScheduler::SystemScheduler() {
+  const unsigned hardware = std::thread::hardware_concurrency();
+  const std::size_t workers =
+      hardware > 1 ? std::min<std::size_t>(hardware - 1, 3) : 0;
+  m_workers.reserve(workers);
+  for (std::size_t i = 0; i < workers; ++i) {
+    m_workers.emplace_back([this] { workerLoop(); });
+  }
+}
+
+SystemScheduler::~SystemScheduler() {
+  {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_workCv.notify_all();
+  for (auto &worker : m_workers) {
+    worker.join();
+  }
+}
+
+void SystemScheduler::runBatch(const std::vector<System *> &batch,
+                               World *world, float deltaTime) {
+  if (batch.empty()) {
+    return;
+  }
+  if (batch.size() == 1 || m_workers.empty()) {
+    for (auto *system : batch) {
+      ProfileScope const system_zone(system->name());
+      system->update(world, deltaTime);
+    }
+    return;
+  }
+
+  {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    m_batch = &batch;
+    m_world = world;
+    m_deltaTime = deltaTime;
+    m_nextIndex.store(0, std::memory_order_relaxed);
+    m_remaining.store(batch.size(), std::memory_order_relaxed);
+    ++m_generation;
+  }
+  m_workCv.notify_all();
+
+  runPending(&batch);
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_doneCv.wait(lock, [this] {
+    return m_remaining.load(std::memory_order_acquire) == 0 &&
+           m_activeWorkers.load(std::memory_order_acquire) == 0;
+  });
+  m_batch = nullptr;
+}
+
+void SystemScheduler::runPending(const std::vector<System *> *batch) {
+  // A worker that was slow to wake can get here after runBatch has
+  // already drained and retired its generation; there is nothing left
+  // to claim.
+  if (batch == nullptr) {
+    return;
+  }
+  while (true) {
+    const std::size_t index =
+        m_nextIndex.fetch_add(1, std::memory_order_relaxed);
+    if (index >= batch->size()) {
+      return;
+    }
+    {
+      System *system = (*batch)[index];
+      ProfileScope const system_zone(system->name());
+      system->update(m_world, m_deltaTime);
+    }
+    if (m_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      m_doneCv.notify_all();
+    }
+  }
+}
+
+void SystemScheduler::workerLoop() {
+  Render::ThreadTopology::instance().registerCurrentThread(
+      Render::ThreadTopology::Role::Worker, "sim worker");
+  std::uint64_t seen_generation = 0;
+  while (true) {
+    const std::vector<System *> *batch = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_workCv.wait(lock, [this, seen_generation] {
+        return m_stop || m_generation != seen_generation;
+      });
+      if (m_stop) {
+        return;
+      }
+      seen_generation = m_generation;
+      // Snapshot the batch while the lock is held: runBatch nulls
+      // m_batch under the same lock once the batch is done, so a null
+      // here means this wake came too late to help.
+      batch = m_batch;
+      m_activeWorkers.fetch_add(1, std::memory_order_acq_rel);
+    }
+    runPending(batch);
+    if (m_activeWorkers.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      m_doneCv.notify_all();
+    }
+  }
+}
+
+} // namespace Engine::Core
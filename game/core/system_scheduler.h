@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Engine::Core {
+
+class System;
+class World;
+
+// Small persistent worker pool that runs one batch of non-conflicting
+// systems at a time. Batches are formed by World::update in system
+// declaration order, so scheduling stays deterministic for replay: a batch
+// only ever contains systems whose declared read/write sets are disjoint,
+// making the result independent of intra-batch execution order.
+class SystemScheduler {
+public:
+  SystemScheduler();
+  ~SystemScheduler();
+
+  SystemScheduler(const SystemScheduler &) = delete;
+  SystemScheduler(SystemScheduler &&) = delete;
+  auto operator=(const SystemScheduler &) -> SystemScheduler & = delete;
+  auto operator=(SystemScheduler &&) -> SystemScheduler & = delete;
+
+  // Runs every system in the batch; the calling thread participates.
+  // Returns when all of them have finished.
+  void runBatch(const std::vector<System *> &batch, World *world,
+                float deltaTime);
+
+  [[nodiscard]] auto workerCount() const -> std::size_t {
+    return m_workers.size();
+  }
+
+private:
+  void workerLoop();
+  void runPending(const std::vector<System *> *batch);
+
+  std::vector<std::thread> m_workers;
+  std::mutex m_mutex;
+  std::condition_variable m_workCv;
+  std::condition_variable m_doneCv;
+
+  const std::vector<System *> *m_batch = nullptr;
+  World *m_world = nullptr;
+  float m_deltaTime = 0.0F;
+  std::atomic<std::size_t> m_nextIndex{0};
+  std::atomic<std::size_t> m_remaining{0};
+  std::atomic<std::size_t> m_activeWorkers{0};
+  std::uint64_t m_generation = 0;
+  bool m_stop = false;
+};
+
+} // namespace Engine::Core
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace Engine::Core {
+
+using SystemTypeId = std::uint32_t;
+
+inline constexpr std::size_t kMaxSystemTypes = 32;
+
+namespace Detail {
+inline auto nextSystemTypeId() -> SystemTypeId {
+  static std::atomic<SystemTypeId> s_counter{0};
+  return s_counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename T>
+inline const SystemTypeId kSystemTypeId = nextSystemTypeId();
+} // namespace Detail
+
+// Sequential runtime ID per concrete system type, assigned on first use.
+// Same scheme as componentTypeId(); lets World::getSystem<T>() be a single
+// array load instead of a dynamic_cast scan.
+template <typename T> auto systemTypeId() -> SystemTypeId {
+  return Detail::kSystemTypeId<std::remove_cv_t<T>>;
+}
+
+} // namespace Engine::Core
@@ -1,10 +1,16 @@
 #include "world.h"
+#include "event_manager.h"
+#include "alloc_tracker.h"
+#include "frame_arena.h"
+#include "profiler.h"
 #include "../systems/owner_registry.h"
 #include "../systems/troop_count_registry.h"
 #include "component.h"
 #include "core/entity.h"
 #include "core/system.h"
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <utility>
@@ -12,128 +18,298 @@
 
 namespace Engine::Core {
 
-World::World() = default;
+World::World() {
+  m_slots.resize(1);
+  m_componentStorage.setStructuralListener(
+      [this](Entity *entity, ComponentTypeId type, bool added) {
+        if (type == componentTypeId<UnitComponent>()) {
+          ++m_ownerIndexVersion;
+        }
+        // The entity may be mid-destruction here; its id is a plain
+        // member and stays valid for the whole teardown.
+        m_changeRings.record(type, entity->getId(),
+                             added ? ComponentChangeRings::ChangeKind::Added
+                                   : ComponentChangeRings::ChangeKind::Removed);
+      });
+}
 World::~World() = default;
 
 auto World::createEntity() -> Entity * {
-  const std::lock_guard<std::recursive_mutex> lock(m_entityMutex);
-  EntityID const id = m_nextEntityId++;
-  auto entity = std::make_unique<Entity>(id);
-  auto *ptr = entity.get();
-  m_entities[id] = std::move(entity);
-  return ptr;
+  const std::lock_guard<std::recursive_mutex> lock(m_phaseMutex);
+  std::uint32_t index = 0;
+  if (!m_freeSlots.empty()) {
+    index = m_freeSlots.back();
+    m_freeSlots.pop_back();
+  } else {
+    index = static_cast<std::uint32_t>(m_slots.size());
+    m_slots.emplace_back();
+  }
+  auto &slot = m_slots[index];
+  const EntityID id = makeEntityId(index, slot.generation);
+  slot.entity = std::make_unique<Entity>(id, &m_componentStorage);
+  slot.denseIndex = static_cast<std::uint32_t>(m_denseEntities.size());
+  m_denseEntities.push_back(slot.entity.get());
+  return slot.entity.get();
 }
 
 auto World::createEntityWithId(EntityID entity_id) -> Entity * {
-  const std::lock_guard<std::recursive_mutex> lock(m_entityMutex);
-  if (entity_id == NULL_ENTITY) {
+  const std::lock_guard<std::recursive_mutex> lock(m_phaseMutex);
+  const std::uint32_t index = entityIndex(entity_id);
+  if (index == 0) {
     return nullptr;
   }
+  if (index >= m_slots.size()) {
+    m_slots.resize(index + 1);
+  }
+  auto &slot = m_slots[index];
+  if (slot.entity) {
+    removeFromDense(slot);
+    slot.entity.reset();
+  }
+  slot.generation = entityGeneration(entity_id);
+  slot.entity = std::make_unique<Entity>(entity_id, &m_componentStorage);
+  slot.denseIndex = static_cast<std::uint32_t>(m_denseEntities.size());
+  m_denseEntities.push_back(slot.entity.get());
+  return slot.entity.get();
+}
 
-  auto entity = std::make_unique<Entity>(entity_id);
-  auto *ptr = entity.get();
-  m_entities[entity_id] = std::move(entity);
-
-  if (entity_id >= m_nextEntityId) {
-    m_nextEntityId = entity_id + 1;
+void World::destroyEntity(EntityID entity_id) {
+  const std::lock_guard<std::recursive_mutex> lock(m_phaseMutex);
+  const std::uint32_t index = entityIndex(entity_id);
+  if (index == 0 || index >= m_slots.size()) {
+    return;
   }
+  auto &slot = m_slots[index];
+  if (!slot.entity || slot.generation != entityGeneration(entity_id)) {
+    return;
+  }
+  removeFromDense(slot);
+  slot.entity.reset();
+  ++slot.generation;
+  m_freeSlots.push_back(index);
+}
 
-  return ptr;
+void World::queueDestroy(EntityID entity_id) {
+  const std::lock_guard<std::recursive_mutex> lock(m_phaseMutex);
+  m_destroyQueue.push_back(entity_id);
 }
 
-void World::destroyEntity(EntityID entity_id) {
-  const std::lock_guard<std::recursive_mutex> lock(m_entityMutex);
-  m_entities.erase(entity_id);
+void World::flushDestroyQueue() {
+  // Duplicates and IDs invalidated earlier in the frame are harmless:
+  // destroyEntity rejects them through the generation check.
+  for (const EntityID entity_id : m_destroyQueue) {
+    destroyEntity(entity_id);
+  }
+  m_destroyQueue.clear();
+}
+
+void World::removeFromDense(EntitySlot &slot) {
+  const std::uint32_t dense_index = slot.denseIndex;
+  Entity *last = m_denseEntities.back();
+  if (last != slot.entity.get()) {
+    m_denseEntities[dense_index] = last;
+    m_slots[entityIndex(last->getId())].denseIndex = dense_index;
+  }
+  m_denseEntities.pop_back();
 }
 
 void World::clear() {
-  const std::lock_guard<std::recursive_mutex> lock(m_entityMutex);
-  m_entities.clear();
-  m_nextEntityId = 1;
+  const std::lock_guard<std::recursive_mutex> lock(m_phaseMutex);
+  m_denseEntities.clear();
+  m_freeSlots.clear();
+  m_slots.clear();
+  m_slots.resize(1);
 }
 
 auto World::getEntity(EntityID entity_id) -> Entity * {
-  const std::lock_guard<std::recursive_mutex> lock(m_entityMutex);
-  auto it = m_entities.find(entity_id);
-  return it != m_entities.end() ? it->second.get() : nullptr;
+  const std::uint32_t index = entityIndex(entity_id);
+  if (index == 0 || index >= m_slots.size()) {
+    return nullptr;
+  }
+  const auto &slot = m_slots[index];
+  if (!slot.entity || slot.generation != entityGeneration(entity_id)) {
+    return nullptr;
+  }
+  return slot.entity.get();
 }
 
-void World::addSystem(std::unique_ptr<System> system) {
-  m_systems.push_back(std::move(system));
+auto World::getEntity(EntityID entity_id) const -> const Entity * {
+  const std::uint32_t index = entityIndex(entity_id);
+  if (index == 0 || index >= m_slots.size()) {
+    return nullptr;
+  }
+  const auto &slot = m_slots[index];
+  if (!slot.entity || slot.generation != entityGeneration(entity_id)) {
+    return nullptr;
+  }
+  return slot.entity.get();
 }
 
-void World::update(float deltaTime) {
-  for (auto &system : m_systems) {
-    system->update(this, deltaTime);
+auto World::isAlive(EntityID entity_id) const -> bool {
+  const std::uint32_t index = entityIndex(entity_id);
+  if (index == 0 || index >= m_slots.size()) {
+    return false;
   }
+  const auto &slot = m_slots[index];
+  return slot.entity != nullptr &&
+         slot.generation == entityGeneration(entity_id);
 }
 
-auto World::getUnitsOwnedBy(int owner_id) const -> std::vector<Entity *> {
-  const std::lock_guard<std::recursive_mutex> lock(m_entityMutex);
-  std::vector<Entity *> result;
-  result.reserve(m_entities.size());
-  for (const auto &[entity_id, entity] : m_entities) {
-    auto *unit = entity->getComponent<UnitComponent>();
-    if (unit == nullptr) {
+namespace {
+auto conflicts(const SystemAccess &access, ComponentMask batch_reads,
+               ComponentMask batch_writes) -> bool {
+  return ((access.writes & (batch_reads | batch_writes)) != 0) ||
+         ((batch_writes & (access.reads | access.writes)) != 0);
+}
+} // namespace
+
+void World::update(float deltaTime) {
+  SOI_PROFILE_ZONE("World::update");
+  AllocTagScope const alloc_tag(AllocTag::Ecs);
+  const std::lock_guard<std::recursive_mutex> lock(m_phaseMutex);
+  m_phase.store(Phase::SimUpdate, std::memory_order_relaxed);
+
+  // Systems run in declaration order; consecutive systems with disjoint
+  // declared access are grouped into one concurrent batch. Batch boundaries
+  // depend only on the declarations, so scheduling is replay-deterministic.
+  ++m_frameIndex;
+  m_systemDtAccum.resize(m_systems.size(), 0.0F);
+  m_systemBatch.clear();
+  ComponentMask batch_reads = 0;
+  ComponentMask batch_writes = 0;
+  auto flush_batch = [&] {
+    m_scheduler.runBatch(m_systemBatch, this, deltaTime);
+    m_systemBatch.clear();
+    batch_reads = 0;
+    batch_writes = 0;
+  };
+
+  for (std::size_t i = 0; i < m_systems.size(); ++i) {
+    auto &system = m_systems[i];
+    const int interval = system->tickInterval();
+    if (interval > 1) {
+      // Low-rate systems are staggered by declaration index so they don't
+      // all come due on the same frame, and run inline with the deltaTime
+      // accumulated since their last tick. Due frames depend only on the
+      // frame counter and the declarations, so replay stays deterministic.
+      m_systemDtAccum[i] += deltaTime;
+      if ((m_frameIndex + i) % static_cast<std::uint64_t>(interval) != 0) {
+        continue;
+      }
+      flush_batch();
+      const float accumulated = m_systemDtAccum[i];
+      m_systemDtAccum[i] = 0.0F;
+      {
+        ProfileScope const system_zone(system->name());
+        system->update(this, accumulated);
+      }
       continue;
     }
-    if (unit->owner_id == owner_id) {
-      result.push_back(entity.get());
+    const SystemAccess access = system->access();
+    if (access.exclusive) {
+      flush_batch();
+      {
+        ProfileScope const system_zone(system->name());
+        system->update(this, deltaTime);
+      }
+      continue;
+    }
+    if (conflicts(access, batch_reads, batch_writes)) {
+      flush_batch();
     }
+    m_systemBatch.push_back(system.get());
+    batch_reads |= access.reads;
+    batch_writes |= access.writes;
   }
-  return result;
+  flush_batch();
+
+  flushDeferred();
+  flushDestroyQueue();
+  EventManager::instance().dispatchQueued();
+  EventManager::instance().dispatchLate();
+  FrameArena::instance().reset();
+  m_phase.store(Phase::Idle, std::memory_order_relaxed);
+}
+
+void World::deferStructural(std::function<void(World &)> command) {
+  const std::lock_guard<std::mutex> lock(m_deferredMutex);
+  m_deferredCommands.push_back(std::move(command));
+}
+
+void World::flushDeferred() {
+  std::vector<std::function<void(World &)>> commands;
+  {
+    const std::lock_guard<std::mutex> lock(m_deferredMutex);
+    commands.swap(m_deferredCommands);
+  }
+  for (auto &command : commands) {
+    command(*this);
+  }
+}
+
+auto World::acquireReadLock() -> std::unique_lock<std::recursive_mutex> {
+  std::unique_lock<std::recursive_mutex> lock(m_phaseMutex);
+  m_phase.store(Phase::Snapshot, std::memory_order_relaxed);
+  return lock;
+}
+
+void World::notifyUnitOwnerChanged() { ++m_ownerIndexVersion; }
+
+void World::refreshOwnerIndex() const {
+  if (m_ownerIndexBuiltVersion == m_ownerIndexVersion) {
+    return;
+  }
+  for (auto &[owner, units] : m_unitsByOwner) {
+    units.clear();
+  }
+  for (Entity *entity : m_componentStorage.entitiesWith<UnitComponent>()) {
+    const auto *unit = entity->getComponent<UnitComponent>();
+    m_unitsByOwner[unit->owner_id].push_back(entity);
+  }
+  m_ownerIndexBuiltVersion = m_ownerIndexVersion;
+}
+
+auto World::getUnitsOwnedBy(int owner_id) const
+    -> const std::vector<Entity *> & {
+  refreshOwnerIndex();
+  auto it = m_unitsByOwner.find(owner_id);
+  if (it != m_unitsByOwner.end()) {
+    return it->second;
+  }
+  static const std::vector<Entity *> s_empty;
+  return s_empty;
 }
 
 auto World::getUnitsNotOwnedBy(int owner_id) const -> std::vector<Entity *> {
-  const std::lock_guard<std::recursive_mutex> lock(m_entityMutex);
+  refreshOwnerIndex();
   std::vector<Entity *> result;
-  result.reserve(m_entities.size());
-  for (const auto &[entity_id, entity] : m_entities) {
-    auto *unit = entity->getComponent<UnitComponent>();
-    if (unit == nullptr) {
-      continue;
-    }
-    if (unit->owner_id != owner_id) {
-      result.push_back(entity.get());
+  for (const auto &[owner, units] : m_unitsByOwner) {
+    if (owner != owner_id) {
+      result.insert(result.end(), units.begin(), units.end());
     }
   }
   return result;
 }
 
 auto World::getAlliedUnits(int owner_id) const -> std::vector<Entity *> {
-  const std::lock_guard<std::recursive_mutex> lock(m_entityMutex);
-  std::vector<Entity *> result;
-  result.reserve(m_entities.size());
+  refreshOwnerIndex();
   auto &owner_registry = Game::Systems::OwnerRegistry::instance();
-
-  for (const auto &[entity_id, entity] : m_entities) {
-    auto *unit = entity->getComponent<UnitComponent>();
-    if (unit == nullptr) {
-      continue;
-    }
-
-    if (unit->owner_id == owner_id ||
-        owner_registry.areAllies(owner_id, unit->owner_id)) {
-      result.push_back(entity.get());
+  std::vector<Entity *> result;
+  for (const auto &[owner, units] : m_unitsByOwner) {
+    if (owner == owner_id || owner_registry.areAllies(owner_id, owner)) {
+      result.insert(result.end(), units.begin(), units.end());
     }
   }
   return result;
 }
 
 auto World::getEnemyUnits(int owner_id) const -> std::vector<Entity *> {
-  const std::lock_guard<std::recursive_mutex> lock(m_entityMutex);
-  std::vector<Entity *> result;
-  result.reserve(m_entities.size());
+  refreshOwnerIndex();
   auto &owner_registry = Game::Systems::OwnerRegistry::instance();
-
-  for (const auto &[entity_id, entity] : m_entities) {
-    auto *unit = entity->getComponent<UnitComponent>();
-    if (unit == nullptr) {
-      continue;
-    }
-
-    if (owner_registry.areEnemies(owner_id, unit->owner_id)) {
-      result.push_back(entity.get());
+  std::vector<Entity *> result;
+  for (const auto &[owner, units] : m_unitsByOwner) {
+    if (owner_registry.areEnemies(owner_id, owner)) {
+      result.insert(result.end(), units.begin(), units.end());
     }
   }
   return result;
@@ -144,13 +320,14 @@ int World::countTroopsForPlayer(int owner_id) {
 }
 
 auto World::getNextEntityId() const -> EntityID {
-  const std::lock_guard<std::recursive_mutex> lock(m_entityMutex);
-  return m_nextEntityId;
+  return makeEntityId(static_cast<std::uint32_t>(m_slots.size()), 0);
 }
 
 void World::setNextEntityId(EntityID next_id) {
-  const std::lock_guard<std::recursive_mutex> lock(m_entityMutex);
-  m_nextEntityId = std::max(next_id, m_nextEntityId);
+  const std::uint32_t index = entityIndex(next_id);
+  if (index > m_slots.size()) {
+    m_slots.resize(index);
+  }
 }
 
 } // namespace Engine::Core
@@ -1,7 +1,14 @@
 #pragma once
 
+#include "change_rings.h"
+#include "component_pool.h"
 #include "entity.h"
 #include "system.h"
+#include "system_scheduler.h"
+#include "system_type_id.h"
+#include <array>
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
@@ -11,6 +18,11 @@ namespace Engine::Core {
 
 class World {
 public:
+  // Frame phases. During SimUpdate the simulation thread holds the phase
+  // lock and is the single writer; during Snapshot a reader (render thread)
+  // holds it and the world must not change structurally.
+  enum class Phase { Idle, SimUpdate, Snapshot };
+
   World();
   ~World();
 
@@ -22,55 +34,130 @@ public:
   auto createEntity() -> Entity *;
   auto createEntityWithId(EntityID entity_id) -> Entity *;
   void destroyEntity(EntityID entity_id);
+
+  // Queues the entity for destruction at the end of the current frame,
+  // after every system has run and deferred commands have been applied.
+  // Stale IDs are ignored; component memory goes back to the per-type
+  // pools. Prefer this over destroyEntity from inside system updates.
+  void queueDestroy(EntityID entity_id);
   auto getEntity(EntityID entity_id) -> Entity *;
+  [[nodiscard]] auto getEntity(EntityID entity_id) const -> const Entity *;
+  [[nodiscard]] auto isAlive(EntityID entity_id) const -> bool;
   void clear();
 
-  void addSystem(std::unique_ptr<System> system);
+  // Registers the system under its concrete type so getSystem<T>() resolves
+  // through the type-indexed table. Adding a second system of the same type
+  // replaces the table entry (the old instance keeps running).
+  template <typename T> void addSystem(std::unique_ptr<T> system) {
+    static_assert(std::is_base_of_v<System, T>,
+                  "T must inherit from System");
+    m_systemTable[systemTypeId<T>()] = system.get();
+    m_systems.push_back(std::move(system));
+  }
+
   void update(float deltaTime);
 
+  // Defers a structural change (entity creation/destruction, component
+  // add/remove) to the end of the current sim phase, where it is applied
+  // after every system has run.
+  void deferStructural(std::function<void(World &)> command);
+
+  // Takes the phase lock for read-only access from another thread (render
+  // snapshot). Blocks while a sim update is in flight.
+  [[nodiscard]] auto acquireReadLock() -> std::unique_lock<std::recursive_mutex>;
+
+  [[nodiscard]] auto phase() const -> Phase {
+    return m_phase.load(std::memory_order_relaxed);
+  }
+
   auto systems() -> std::vector<std::unique_ptr<System>> & { return m_systems; }
 
   template <typename T> auto getSystem() -> T * {
-    for (auto &system : m_systems) {
-      if (auto *ptr = dynamic_cast<T *>(system.get())) {
-        return ptr;
-      }
-    }
-    return nullptr;
+    return static_cast<T *>(m_systemTable[systemTypeId<T>()]);
   }
 
   template <typename T> auto getEntitiesWith() -> std::vector<Entity *> {
-    const std::lock_guard<std::recursive_mutex> lock(m_entityMutex);
-    std::vector<Entity *> result;
-    for (auto &[entity_id, entity] : m_entities) {
-      if (entity->template hasComponent<T>()) {
-        result.push_back(entity.get());
-      }
-    }
-    return result;
+    return m_componentStorage.entitiesWith<T>();
   }
 
-  auto getUnitsOwnedBy(int owner_id) const -> std::vector<Entity *>;
+  // Allocation-free view over the dense per-type owner list, kept up to date
+  // incrementally as components are added and removed. The reference is
+  // invalidated by structural changes to the same component type (including
+  // entity destruction), so callers that mutate must use getEntitiesWith().
+  template <typename T> auto view() const -> const std::vector<Entity *> & {
+    return m_componentStorage.entitiesWith<T>();
+  }
+
+  auto getUnitsOwnedBy(int owner_id) const -> const std::vector<Entity *> &;
   auto getUnitsNotOwnedBy(int owner_id) const -> std::vector<Entity *>;
   auto getAlliedUnits(int owner_id) const -> std::vector<Entity *>;
   auto getEnemyUnits(int owner_id) const -> std::vector<Entity *>;
   static auto countTroopsForPlayer(int owner_id) -> int;
 
-  auto getEntities() const
-      -> const std::unordered_map<EntityID, std::unique_ptr<Entity>> & {
-    return m_entities;
+  // Must be called when a live unit changes owner (capture); structural
+  // add/remove of UnitComponent is tracked automatically.
+  void notifyUnitOwnerChanged();
+
+  // Dense array of live entities; iteration is a linear scan with no holes.
+  // Order changes on destruction (swap-with-last).
+  auto entities() const -> const std::vector<Entity *> & {
+    return m_denseEntities;
   }
 
   auto getNextEntityId() const -> EntityID;
   void setNextEntityId(EntityID next_id);
 
-  auto getEntityMutex() -> std::recursive_mutex & { return m_entityMutex; }
+  // Per-component-type change log written by the mutation path's
+  // structural listener. The AI snapshot mirror follows the
+  // UnitComponent ring with a private cursor to detect spawns and
+  // deaths; see ComponentChangeRings for the overflow contract.
+  [[nodiscard]] auto changeRings() -> ComponentChangeRings & {
+    return m_changeRings;
+  }
+  [[nodiscard]] auto changeRings() const -> const ComponentChangeRings & {
+    return m_changeRings;
+  }
 
 private:
-  EntityID m_nextEntityId = 1;
-  std::unordered_map<EntityID, std::unique_ptr<Entity>> m_entities;
+  struct EntitySlot {
+    std::unique_ptr<Entity> entity;
+    std::uint32_t generation = 0;
+    std::uint32_t denseIndex = 0;
+  };
+
+  void flushDeferred();
+  void flushDestroyQueue();
+  void removeFromDense(EntitySlot &slot);
+  void refreshOwnerIndex() const;
+
+  ComponentStorage m_componentStorage;
+  std::vector<EntitySlot> m_slots;
+  std::vector<Entity *> m_denseEntities;
+  std::vector<std::uint32_t> m_freeSlots;
+
+  // Per-owner unit index, rebuilt lazily at most once per structural change
+  // to UnitComponent (or an owner change) instead of scanning the world on
+  // every ownership query.
+  ComponentChangeRings m_changeRings;
+  mutable std::unordered_map<int, std::vector<Entity *>> m_unitsByOwner;
+  mutable std::uint64_t m_ownerIndexBuiltVersion = 0;
+  std::uint64_t m_ownerIndexVersion = 1;
   std::vector<std::unique_ptr<System>> m_systems;
-  mutable std::recursive_mutex m_entityMutex;
+  // Per-system deltaTime accumulated across skipped frames, indexed in
+  // parallel with m_systems; only entries for low-rate systems are used.
+  std::vector<float> m_systemDtAccum;
+  std::uint64_t m_frameIndex = 0;
+  std::array<System *, kMaxSystemTypes> m_systemTable{};
+  SystemScheduler m_scheduler;
+  std::vector<System *> m_systemBatch;
+  std::vector<std::function<void(World &)>> m_deferredCommands;
+  std::vector<EntityID> m_destroyQueue;
+  std::mutex m_deferredMutex;
+  std::atomic<Phase> m_phase{Phase::Idle};
+  // Phase lock: taken once per sim frame by update() and once per snapshot
+  // by acquireReadLock(), instead of per entity access. Recursive so
+  // structural calls made from within the sim phase remain valid.
+  mutable std::recursive_mutex m_phaseMutex;
 };
 
 } // namespace Engine::Core
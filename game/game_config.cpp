@@ -0,0 +1,118 @@
+#include "game_config.h"
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include <QJsonValue>
+
+namespace Game {
+
+namespace {
+
+void readFloat(const QJsonObject &section, const char *key, float &out) {
+  const QJsonValue value = section.value(QLatin1String(key));
+  if (value.isDouble()) {
+    out = static_cast<float>(value.toDouble());
+  }
+}
+
+void readInt(const QJsonObject &section, const char *key, int &out) {
+  const QJsonValue value = section.value(QLatin1String(key));
+  if (value.isDouble()) {
+    out = value.toInt();
+  }
+}
+
+} // namespace
+
+auto GameConfig::loadFromJsonFile(const QString &path,
+                                  QString *out_error) -> bool {
+  QFile f(path);
+  if (!f.open(QIODevice::ReadOnly)) {
+    if (out_error != nullptr) {
+      *out_error = QString("Failed to open tuning file: %1").arg(path);
+    }
+    return false;
+  }
+  const QByteArray data = f.readAll();
+  f.close();
+  QJsonParseError perr{};
+  const QJsonDocument doc = QJsonDocument::fromJson(data, &perr);
+  if (doc.isNull()) {
+    if (out_error != nullptr) {
+      *out_error = QString("JSON parse error at %1: %2")
+                       .arg(perr.offset)
+                       .arg(perr.errorString());
+    }
+    return false;
+  }
+  QJsonObject const root = doc.object();
+  mutate([&root](Tuning &t) {
+    QJsonObject const camera = root.value("camera").toObject();
+    readFloat(camera, "defaultDistance", t.camera.defaultDistance);
+    readFloat(camera, "defaultPitch", t.camera.defaultPitch);
+    readFloat(camera, "defaultYaw", t.camera.defaultYaw);
+    readFloat(camera, "orbitStepNormal", t.camera.orbitStepNormal);
+    readFloat(camera, "orbitStepShift", t.camera.orbitStepShift);
+
+    QJsonObject const arrow = root.value("arrow").toObject();
+    readFloat(arrow, "arcHeightMultiplier", t.arrow.arcHeightMultiplier);
+    readFloat(arrow, "arcHeightMin", t.arrow.arcHeightMin);
+    readFloat(arrow, "arcHeightMax", t.arrow.arcHeightMax);
+    readFloat(arrow, "speedDefault", t.arrow.speedDefault);
+    readFloat(arrow, "speedAttack", t.arrow.speedAttack);
+
+    QJsonObject const gameplay = root.value("gameplay").toObject();
+    readFloat(gameplay, "visibilityUpdateInterval",
+              t.gameplay.visibility_update_interval);
+    readFloat(gameplay, "formationSpacingDefault",
+              t.gameplay.formationSpacingDefault);
+    readInt(gameplay, "maxTroopsPerPlayer",
+            t.gameplay.max_troops_per_player);
+
+    QJsonObject const movement = root.value("movement").toObject();
+    readFloat(movement, "repathCooldownSeconds",
+              t.movement.repathCooldownSeconds);
+    readFloat(movement, "avoidNeighborRadius",
+              t.movement.avoidNeighborRadius);
+    readFloat(movement, "avoidCombinedRadius",
+              t.movement.avoidCombinedRadius);
+    readFloat(movement, "avoidTimeHorizon", t.movement.avoidTimeHorizon);
+
+    QJsonObject const combat = root.value("combat").toObject();
+    readFloat(combat, "engagementCooldown", t.combat.engagementCooldown);
+    readFloat(combat, "idealMeleeDistance", t.combat.idealMeleeDistance);
+  });
+  return true;
+}
+
+void GameConfig::setSourceFile(const QString &path) {
+  m_sourcePath = path;
+  QFileInfo const info(path);
+  if (!info.exists()) {
+    m_sourceStamp = 0;
+    return;
+  }
+  m_sourceStamp = info.lastModified().toMSecsSinceEpoch();
+  loadFromJsonFile(path);
+}
+
+auto GameConfig::reloadIfChanged() -> bool {
+  if (m_sourcePath.isEmpty()) {
+    return false;
+  }
+  QFileInfo const info(m_sourcePath);
+  if (!info.exists()) {
+    return false;
+  }
+  qint64 const stamp = info.lastModified().toMSecsSinceEpoch();
+  if (stamp == m_sourceStamp) {
+    return false;
+  }
+  m_sourceStamp = stamp;
+  return loadFromJsonFile(m_sourcePath);
+}
+
+} // namespace Game
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <QString>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
 namespace Game {
 
 struct CameraConfig {
@@ -24,6 +29,28 @@ struct GameplayConfig {
   int max_troops_per_player = 50;
 };
 
+struct MovementConfig {
+  float repathCooldownSeconds = 0.4F;
+  float avoidNeighborRadius = 3.0F;
+  float avoidCombinedRadius = 0.9F;
+  float avoidTimeHorizon = 1.5F;
+};
+
+struct CombatConfig {
+  float engagementCooldown = 0.5F;
+  float idealMeleeDistance = 0.6F;
+};
+
+// Runtime tuning values, double-buffered so a balancing reload never
+// stalls or tears a frame: every change is written into the inactive
+// slot and published with a single index store. Readers that need a
+// coherent multi-field view copy the struct they care about and refresh
+// the copy when version() moves; a reference into the active slot stays
+// valid until the next published change.
+//
+// Values can be overridden from a JSON tuning file on disk (see
+// loadFromJsonFile); reloadIfChanged polls the file's modification time
+// so edits apply mid-game.
 class GameConfig {
 public:
   static auto instance() noexcept -> GameConfig & {
@@ -32,113 +59,167 @@ public:
   }
 
   [[nodiscard]] auto camera() const noexcept -> const CameraConfig & {
-    return m_camera;
+    return active().camera;
   }
   [[nodiscard]] auto arrow() const noexcept -> const ArrowConfig & {
-    return m_arrow;
+    return active().arrow;
   }
   [[nodiscard]] auto gameplay() const noexcept -> const GameplayConfig & {
-    return m_gameplay;
+    return active().gameplay;
+  }
+  [[nodiscard]] auto movement() const noexcept -> const MovementConfig & {
+    return active().movement;
+  }
+  [[nodiscard]] auto combat() const noexcept -> const CombatConfig & {
+    return active().combat;
+  }
+
+  // Monotonic change counter; systems that keep a cached copy compare
+  // this once per tick to decide whether to refresh.
+  [[nodiscard]] auto version() const noexcept -> std::uint64_t {
+    return m_version.load(std::memory_order_acquire);
   }
 
+  // Reads overrides from a JSON tuning file; keys that are absent keep
+  // their current values, so partial files are fine.
+  auto loadFromJsonFile(const QString &path,
+                        QString *out_error = nullptr) -> bool;
+
+  // Remembers the file for reloadIfChanged and applies it once if it
+  // already exists. A missing file is not an error: defaults stay in
+  // effect until the file appears.
+  void setSourceFile(const QString &path);
+
+  // Re-reads the source file when its modification time moved since the
+  // last load. Cheap enough to poll at around 1 Hz; returns true when a
+  // reload was applied.
+  auto reloadIfChanged() -> bool;
+
   [[nodiscard]] auto getCameraDefaultDistance() const noexcept -> float {
-    return m_camera.defaultDistance;
+    return active().camera.defaultDistance;
   }
   [[nodiscard]] auto getCameraDefaultPitch() const noexcept -> float {
-    return m_camera.defaultPitch;
+    return active().camera.defaultPitch;
   }
   [[nodiscard]] auto getCameraDefaultYaw() const noexcept -> float {
-    return m_camera.defaultYaw;
+    return active().camera.defaultYaw;
   }
 
   [[nodiscard]] auto getArrowArcHeightMultiplier() const noexcept -> float {
-    return m_arrow.arcHeightMultiplier;
+    return active().arrow.arcHeightMultiplier;
   }
   [[nodiscard]] auto getArrowArcHeightMin() const noexcept -> float {
-    return m_arrow.arcHeightMin;
+    return active().arrow.arcHeightMin;
   }
   [[nodiscard]] auto getArrowArcHeightMax() const noexcept -> float {
-    return m_arrow.arcHeightMax;
+    return active().arrow.arcHeightMax;
   }
 
   [[nodiscard]] auto getArrowSpeedDefault() const noexcept -> float {
-    return m_arrow.speedDefault;
+    return active().arrow.speedDefault;
   }
   [[nodiscard]] auto getArrowSpeedAttack() const noexcept -> float {
-    return m_arrow.speedAttack;
+    return active().arrow.speedAttack;
   }
 
   [[nodiscard]] auto getVisibilityUpdateInterval() const noexcept -> float {
-    return m_gameplay.visibility_update_interval;
+    return active().gameplay.visibility_update_interval;
   }
 
   [[nodiscard]] auto getFormationSpacingDefault() const noexcept -> float {
-    return m_gameplay.formationSpacingDefault;
+    return active().gameplay.formationSpacingDefault;
   }
 
   [[nodiscard]] auto getCameraOrbitStepNormal() const noexcept -> float {
-    return m_camera.orbitStepNormal;
+    return active().camera.orbitStepNormal;
   }
   [[nodiscard]] auto getCameraOrbitStepShift() const noexcept -> float {
-    return m_camera.orbitStepShift;
+    return active().camera.orbitStepShift;
   }
 
   void setCameraDefaultDistance(float value) noexcept {
-    m_camera.defaultDistance = value;
+    mutate([value](Tuning &t) { t.camera.defaultDistance = value; });
   }
   void setCameraDefaultPitch(float value) noexcept {
-    m_camera.defaultPitch = value;
+    mutate([value](Tuning &t) { t.camera.defaultPitch = value; });
   }
   void setCameraDefaultYaw(float value) noexcept {
-    m_camera.defaultYaw = value;
+    mutate([value](Tuning &t) { t.camera.defaultYaw = value; });
   }
 
   void setArrowArcHeightMultiplier(float value) noexcept {
-    m_arrow.arcHeightMultiplier = value;
+    mutate([value](Tuning &t) { t.arrow.arcHeightMultiplier = value; });
   }
   void setArrowArcHeightMin(float value) noexcept {
-    m_arrow.arcHeightMin = value;
+    mutate([value](Tuning &t) { t.arrow.arcHeightMin = value; });
   }
   void setArrowArcHeightMax(float value) noexcept {
-    m_arrow.arcHeightMax = value;
+    mutate([value](Tuning &t) { t.arrow.arcHeightMax = value; });
   }
 
   void setArrowSpeedDefault(float value) noexcept {
-    m_arrow.speedDefault = value;
+    mutate([value](Tuning &t) { t.arrow.speedDefault = value; });
   }
   void setArrowSpeedAttack(float value) noexcept {
-    m_arrow.speedAttack = value;
+    mutate([value](Tuning &t) { t.arrow.speedAttack = value; });
   }
 
   void setVisibilityUpdateInterval(float value) noexcept {
-    m_gameplay.visibility_update_interval = value;
+    mutate(
+        [value](Tuning &t) { t.gameplay.visibility_update_interval = value; });
   }
 
   void setFormationSpacingDefault(float value) noexcept {
-    m_gameplay.formationSpacingDefault = value;
+    mutate([value](Tuning &t) { t.gameplay.formationSpacingDefault = value; });
   }
 
   void setCameraOrbitStepNormal(float value) noexcept {
-    m_camera.orbitStepNormal = value;
+    mutate([value](Tuning &t) { t.camera.orbitStepNormal = value; });
   }
   void setCameraOrbitStepShift(float value) noexcept {
-    m_camera.orbitStepShift = value;
+    mutate([value](Tuning &t) { t.camera.orbitStepShift = value; });
   }
 
   [[nodiscard]] auto getMaxTroopsPerPlayer() const noexcept -> int {
-    return m_gameplay.max_troops_per_player;
+    return active().gameplay.max_troops_per_player;
   }
 
   void setMaxTroopsPerPlayer(int value) noexcept {
-    m_gameplay.max_troops_per_player = value;
+    mutate([value](Tuning &t) { t.gameplay.max_troops_per_player = value; });
   }
 
 private:
+  struct Tuning {
+    CameraConfig camera;
+    ArrowConfig arrow;
+    GameplayConfig gameplay;
+    MovementConfig movement;
+    CombatConfig combat;
+  };
+
   GameConfig() = default;
 
-  CameraConfig m_camera;
-  ArrowConfig m_arrow;
-  GameplayConfig m_gameplay;
+  [[nodiscard]] auto active() const noexcept -> const Tuning & {
+    return m_slots[m_active.load(std::memory_order_acquire)];
+  }
+
+  // Copies the active slot into the inactive one, applies the change
+  // there and publishes with one index store. Mutations come from the
+  // main thread only (level load, UI, file reload), so there is a
+  // single writer and no writer-side lock.
+  template <typename Fn> void mutate(Fn &&fn) noexcept {
+    unsigned const next = m_active.load(std::memory_order_relaxed) ^ 1U;
+    m_slots[next] = m_slots[next ^ 1U];
+    fn(m_slots[next]);
+    m_active.store(next, std::memory_order_release);
+    m_version.fetch_add(1, std::memory_order_release);
+  }
+
+  std::array<Tuning, 2> m_slots;
+  std::atomic<unsigned> m_active{0};
+  std::atomic<std::uint64_t> m_version{1};
+  QString m_sourcePath;
+  qint64 m_sourceStamp = 0;
 };
 
 } // namespace Game
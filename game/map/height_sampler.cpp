@@ -0,0 +1,47 @@
+#include "height_sampler.h"
+
+#include "terrain.h"
+
+#include <algorithm>
+
+namespace Game::Map {
+
+namespace {
+constexpr float k_quant_steps = 65535.0F;
+} // namespace
+
+void TerrainHeightSampler::build(const TerrainHeightMap &map) {
+  m_width = map.getWidth();
+  m_height = map.getHeight();
+  if (m_width <= 0 || m_height <= 0) {
+    clear();
+    return;
+  }
+
+  m_invTileSize = 1.0F / map.getTileSize();
+  m_gridHalfWidth = static_cast<float>(m_width) * 0.5F - 0.5F;
+  m_gridHalfHeight = static_cast<float>(m_height) * 0.5F - 0.5F;
+
+  const std::vector<float> &heights = map.getHeightData();
+  auto const [min_it, max_it] =
+      std::minmax_element(heights.begin(), heights.end());
+  m_minHeight = *min_it;
+  float const range = *max_it - m_minHeight;
+  m_dequantScale = range / k_quant_steps;
+  float const quant_scale = range > 0.0F ? k_quant_steps / range : 0.0F;
+
+  m_cells.resize(heights.size());
+  for (std::size_t i = 0; i < heights.size(); ++i) {
+    m_cells[i] =
+        static_cast<std::uint16_t>((heights[i] - m_minHeight) * quant_scale +
+                                   0.5F);
+  }
+}
+
+void TerrainHeightSampler::clear() {
+  m_cells.clear();
+  m_width = 0;
+  m_height = 0;
+}
+
+} // namespace Game::Map
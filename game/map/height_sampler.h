@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Game::Map {
+
+class TerrainHeightMap;
+
+// Compact read-only copy of the terrain heights for the per-unit queries
+// the alignment and movement paths issue every frame. Heights are
+// quantized to 16 bits (a quarter of the float grid, two rows per cache
+// line) and the grid constants are precomputed, so a sample is a clamp,
+// two row pointers and a bilinear blend with no bounds re-derivation or
+// indirection through the full terrain object. Built once at load; never
+// mutated afterwards, so it is safe to read from any thread.
+class TerrainHeightSampler {
+public:
+  // Snapshots the height map after all load-time edits (rivers, bridges,
+  // biome variation) have been applied.
+  void build(const TerrainHeightMap &map);
+
+  void clear();
+
+  [[nodiscard]] auto isBuilt() const -> bool { return !m_cells.empty(); }
+
+  // Matches TerrainHeightMap::getHeightAt: bilinear in world space,
+  // 0 outside the grid.
+  [[nodiscard]] auto heightAt(float world_x, float world_z) const -> float {
+    float const gx = world_x * m_invTileSize + m_gridHalfWidth;
+    float const gz = world_z * m_invTileSize + m_gridHalfHeight;
+
+    int const x0 = static_cast<int>(std::floor(gx));
+    int const z0 = static_cast<int>(std::floor(gz));
+    if (x0 < 0 || z0 < 0 || x0 >= m_width || z0 >= m_height) {
+      return 0.0F;
+    }
+    int const x1 = x0 + 1 < m_width ? x0 + 1 : x0;
+    int const z1 = z0 + 1 < m_height ? z0 + 1 : z0;
+
+    float const tx = gx - static_cast<float>(x0);
+    float const tz = gz - static_cast<float>(z0);
+
+    const std::uint16_t *row0 =
+        m_cells.data() + static_cast<std::size_t>(z0) * m_width;
+    const std::uint16_t *row1 =
+        m_cells.data() + static_cast<std::size_t>(z1) * m_width;
+
+    float const h00 = static_cast<float>(row0[x0]);
+    float const h10 = static_cast<float>(row0[x1]);
+    float const h01 = static_cast<float>(row1[x0]);
+    float const h11 = static_cast<float>(row1[x1]);
+
+    float const h0 = h00 + (h10 - h00) * tx;
+    float const h1 = h01 + (h11 - h01) * tx;
+    return m_minHeight + (h0 + (h1 - h0) * tz) * m_dequantScale;
+  }
+
+  // Batched form for systems that already gathered positions; one call
+  // per tick instead of one service lookup per unit.
+  void heightsAt(std::span<const float> xs, std::span<const float> zs,
+                 std::span<float> outHeights) const {
+    std::size_t const count = outHeights.size();
+    for (std::size_t i = 0; i < count; ++i) {
+      outHeights[i] = heightAt(xs[i], zs[i]);
+    }
+  }
+
+private:
+  std::vector<std::uint16_t> m_cells;
+  int m_width = 0;
+  int m_height = 0;
+  float m_invTileSize = 1.0F;
+  float m_gridHalfWidth = 0.0F;
+  float m_gridHalfHeight = 0.0F;
+  float m_minHeight = 0.0F;
+  float m_dequantScale = 0.0F;
+};
+
+} // namespace Game::Map
@@ -51,7 +51,7 @@ auto LevelLoader::loadFromAssets(
 
   Game::Map::MapDefinition def;
   QString err;
-  if (Game::Map::MapLoader::loadFromJsonFile(resolved_map_path, def, &err)) {
+  if (Game::Map::MapLoader::loadFromFile(resolved_map_path, def, &err)) {
     res.ok = true;
     res.map_name = def.name;
 
@@ -0,0 +1,749 @@
+#include "map_binary_cache.h"
+#include "map_definition.h"
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QIODevice>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QVector3D>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace Game::Map {
+
+namespace {
+
+using std::uint32_t;
+using std::uint64_t;
+
+constexpr uint32_t k_magic = 0x4D49'4F53U; // "SOIM" on disk, little-endian
+constexpr uint32_t k_version = 1U;
+
+enum SectionId : uint32_t {
+  k_section_strings = 1U,
+  k_section_info = 2U,
+  k_section_spawns = 3U,
+  k_section_firecamps = 4U,
+  k_section_terrain = 5U,
+  k_section_entrances = 6U,
+  k_section_rivers = 7U,
+  k_section_bridges = 8U,
+  k_section_victory_strings = 9U,
+};
+
+// All records are 4-byte aligned and trivially copyable so a mapped file can
+// be decoded straight from the mapping without per-node allocation.
+struct BinHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t sourceSize;
+  uint64_t sourceMtimeMs;
+  uint32_t sectionCount;
+  uint32_t reserved;
+};
+
+struct BinSection {
+  uint32_t id;
+  uint32_t offset;
+  uint32_t count;
+  uint32_t byteSize;
+};
+
+struct BinStringRef {
+  uint32_t offset;
+  uint32_t length;
+};
+
+struct BinVec3 {
+  float x;
+  float y;
+  float z;
+};
+
+struct BinInfo {
+  uint32_t nameStr;
+  uint32_t coordSystem;
+  std::int32_t maxTroopsPerPlayer;
+  std::int32_t gridWidth;
+  std::int32_t gridHeight;
+  float tileSize;
+
+  BinVec3 cameraCenter;
+  float cameraDistance;
+  float cameraTiltDeg;
+  float cameraFovY;
+  float cameraNear;
+  float cameraFar;
+  float cameraYawDeg;
+
+  BinVec3 grassPrimary;
+  BinVec3 grassSecondary;
+  BinVec3 grassDry;
+  BinVec3 soilColor;
+  BinVec3 rockLow;
+  BinVec3 rockHigh;
+  float patchDensity;
+  float patchJitter;
+  float backgroundBladeDensity;
+  float bladeHeightMin;
+  float bladeHeightMax;
+  float bladeWidthMin;
+  float bladeWidthMax;
+  float swayStrength;
+  float swaySpeed;
+  float heightNoiseAmplitude;
+  float heightNoiseFrequency;
+  float terrainMacroNoiseScale;
+  float terrainDetailNoiseScale;
+  float terrainSoilHeight;
+  float terrainSoilSharpness;
+  float terrainRockThreshold;
+  float terrainRockSharpness;
+  float terrainAmbientBoost;
+  float terrainRockDetailStrength;
+  float backgroundSwayVariance;
+  float backgroundScatterRadius;
+  float plantDensity;
+  float spawnEdgePadding;
+  uint32_t biomeSeed;
+
+  uint32_t victoryTypeStr;
+  float surviveTimeDuration;
+  uint32_t keyStructureCount;
+  uint32_t defeatConditionCount;
+};
+
+struct BinSpawn {
+  uint32_t type;
+  float x;
+  float z;
+  std::int32_t player_id;
+  std::int32_t team_id;
+  std::int32_t maxPopulation;
+};
+
+struct BinFireCamp {
+  float x;
+  float z;
+  float intensity;
+  float radius;
+  uint32_t persistent;
+};
+
+struct BinTerrain {
+  uint32_t type;
+  float center_x;
+  float center_z;
+  float radius;
+  float width;
+  float depth;
+  float height;
+  float rotationDeg;
+  uint32_t entranceOffset;
+  uint32_t entranceCount;
+};
+
+struct BinRiver {
+  BinVec3 start;
+  BinVec3 end;
+  float width;
+};
+
+struct BinBridge {
+  BinVec3 start;
+  BinVec3 end;
+  float width;
+  float height;
+};
+
+auto toBinVec3(const QVector3D &vec) -> BinVec3 {
+  return {vec.x(), vec.y(), vec.z()};
+}
+
+auto fromBinVec3(const BinVec3 &vec) -> QVector3D {
+  return {vec.x, vec.y, vec.z};
+}
+
+// Accumulates UTF-8 string data; add() deduplicates exact repeats, which
+// victory structure lists hit often.
+class StringTableBuilder {
+public:
+  auto add(const QString &value) -> uint32_t {
+    const QByteArray utf8 = value.toUtf8();
+    for (uint32_t i = 0; i < m_refs.size(); ++i) {
+      const auto &ref = m_refs[i];
+      if (ref.length == static_cast<uint32_t>(utf8.size()) &&
+          std::memcmp(m_blob.constData() + ref.offset, utf8.constData(),
+                      utf8.size()) == 0) {
+        return i;
+      }
+    }
+    BinStringRef ref;
+    ref.offset = static_cast<uint32_t>(m_blob.size());
+    ref.length = static_cast<uint32_t>(utf8.size());
+    m_blob.append(utf8);
+    m_refs.push_back(ref);
+    return static_cast<uint32_t>(m_refs.size() - 1);
+  }
+
+  // Section payload: [BinStringRef x count][UTF-8 blob].
+  [[nodiscard]] auto payload() const -> QByteArray {
+    QByteArray out;
+    out.append(reinterpret_cast<const char *>(m_refs.data()),
+               static_cast<qsizetype>(m_refs.size() * sizeof(BinStringRef)));
+    out.append(m_blob);
+    return out;
+  }
+
+  [[nodiscard]] auto count() const -> uint32_t {
+    return static_cast<uint32_t>(m_refs.size());
+  }
+
+private:
+  std::vector<BinStringRef> m_refs;
+  QByteArray m_blob;
+};
+
+class StringTableReader {
+public:
+  StringTableReader(const unsigned char *payload, uint32_t count,
+                    uint32_t byteSize)
+      : m_payload(payload), m_count(count), m_byteSize(byteSize) {
+    m_blobOffset = count * static_cast<uint32_t>(sizeof(BinStringRef));
+    if (m_blobOffset > byteSize) {
+      m_count = 0;
+    }
+  }
+
+  [[nodiscard]] auto get(uint32_t index) const -> QString {
+    if (index >= m_count) {
+      return {};
+    }
+    BinStringRef ref;
+    std::memcpy(&ref, m_payload + index * sizeof(BinStringRef), sizeof(ref));
+    if (m_blobOffset + ref.offset + ref.length > m_byteSize) {
+      return {};
+    }
+    return QString::fromUtf8(
+        reinterpret_cast<const char *>(m_payload + m_blobOffset + ref.offset),
+        static_cast<qsizetype>(ref.length));
+  }
+
+private:
+  const unsigned char *m_payload;
+  uint32_t m_count;
+  uint32_t m_byteSize;
+  uint32_t m_blobOffset = 0;
+};
+
+template <typename T>
+void appendRecords(QByteArray &out, const std::vector<T> &records) {
+  out.append(reinterpret_cast<const char *>(records.data()),
+             static_cast<qsizetype>(records.size() * sizeof(T)));
+}
+
+auto cacheFilePath(const QString &jsonPath) -> QString {
+  const QString base =
+      QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+  if (base.isEmpty()) {
+    return {};
+  }
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  hash.addData(jsonPath.toUtf8());
+  return base + QStringLiteral("/maps/") +
+         QString::fromLatin1(hash.result().toHex()) +
+         QStringLiteral(".mapbin");
+}
+
+void sourceStamp(const QString &jsonPath, uint64_t &outSize,
+                 uint64_t &outMtimeMs) {
+  QFileInfo const info(jsonPath);
+  outSize = static_cast<uint64_t>(info.size());
+  const QDateTime modified = info.lastModified();
+  outMtimeMs = modified.isValid()
+                   ? static_cast<uint64_t>(modified.toMSecsSinceEpoch())
+                   : 0U;
+}
+
+} // namespace
+
+auto MapBinaryCache::store(const QString &jsonPath,
+                           const MapDefinition &map) -> bool {
+  const QString cache_path = cacheFilePath(jsonPath);
+  if (cache_path.isEmpty()) {
+    return false;
+  }
+
+  StringTableBuilder strings;
+
+  BinInfo info{};
+  info.nameStr = strings.add(map.name);
+  info.coordSystem = map.coordSystem == CoordSystem::World ? 1U : 0U;
+  info.maxTroopsPerPlayer = map.max_troops_per_player;
+  info.gridWidth = map.grid.width;
+  info.gridHeight = map.grid.height;
+  info.tileSize = map.grid.tile_size;
+
+  info.cameraCenter = toBinVec3(map.camera.center);
+  info.cameraDistance = map.camera.distance;
+  info.cameraTiltDeg = map.camera.tiltDeg;
+  info.cameraFovY = map.camera.fovY;
+  info.cameraNear = map.camera.near_plane;
+  info.cameraFar = map.camera.far_plane;
+  info.cameraYawDeg = map.camera.yaw_deg;
+
+  const BiomeSettings &biome = map.biome;
+  info.grassPrimary = toBinVec3(biome.grassPrimary);
+  info.grassSecondary = toBinVec3(biome.grassSecondary);
+  info.grassDry = toBinVec3(biome.grassDry);
+  info.soilColor = toBinVec3(biome.soilColor);
+  info.rockLow = toBinVec3(biome.rockLow);
+  info.rockHigh = toBinVec3(biome.rockHigh);
+  info.patchDensity = biome.patchDensity;
+  info.patchJitter = biome.patchJitter;
+  info.backgroundBladeDensity = biome.backgroundBladeDensity;
+  info.bladeHeightMin = biome.bladeHeightMin;
+  info.bladeHeightMax = biome.bladeHeightMax;
+  info.bladeWidthMin = biome.bladeWidthMin;
+  info.bladeWidthMax = biome.bladeWidthMax;
+  info.swayStrength = biome.sway_strength;
+  info.swaySpeed = biome.sway_speed;
+  info.heightNoiseAmplitude = biome.heightNoiseAmplitude;
+  info.heightNoiseFrequency = biome.heightNoiseFrequency;
+  info.terrainMacroNoiseScale = biome.terrainMacroNoiseScale;
+  info.terrainDetailNoiseScale = biome.terrainDetailNoiseScale;
+  info.terrainSoilHeight = biome.terrainSoilHeight;
+  info.terrainSoilSharpness = biome.terrainSoilSharpness;
+  info.terrainRockThreshold = biome.terrainRockThreshold;
+  info.terrainRockSharpness = biome.terrainRockSharpness;
+  info.terrainAmbientBoost = biome.terrainAmbientBoost;
+  info.terrainRockDetailStrength = biome.terrainRockDetailStrength;
+  info.backgroundSwayVariance = biome.backgroundSwayVariance;
+  info.backgroundScatterRadius = biome.backgroundScatterRadius;
+  info.plantDensity = biome.plant_density;
+  info.spawnEdgePadding = biome.spawnEdgePadding;
+  info.biomeSeed = biome.seed;
+
+  info.victoryTypeStr = strings.add(map.victory.victoryType);
+  info.surviveTimeDuration = map.victory.surviveTimeDuration;
+  info.keyStructureCount =
+      static_cast<uint32_t>(map.victory.keyStructures.size());
+  info.defeatConditionCount =
+      static_cast<uint32_t>(map.victory.defeatConditions.size());
+
+  std::vector<uint32_t> victory_strings;
+  victory_strings.reserve(map.victory.keyStructures.size() +
+                          map.victory.defeatConditions.size());
+  for (const auto &structure : map.victory.keyStructures) {
+    victory_strings.push_back(strings.add(structure));
+  }
+  for (const auto &condition : map.victory.defeatConditions) {
+    victory_strings.push_back(strings.add(condition));
+  }
+
+  std::vector<BinSpawn> spawns;
+  spawns.reserve(map.spawns.size());
+  for (const auto &spawn : map.spawns) {
+    BinSpawn record{};
+    record.type = static_cast<uint32_t>(spawn.type);
+    record.x = spawn.x;
+    record.z = spawn.z;
+    record.player_id = spawn.player_id;
+    record.team_id = spawn.team_id;
+    record.maxPopulation = spawn.maxPopulation;
+    spawns.push_back(record);
+  }
+
+  std::vector<BinFireCamp> firecamps;
+  firecamps.reserve(map.firecamps.size());
+  for (const auto &camp : map.firecamps) {
+    firecamps.push_back({camp.x, camp.z, camp.intensity, camp.radius,
+                         camp.persistent ? 1U : 0U});
+  }
+
+  std::vector<BinTerrain> terrain;
+  std::vector<BinVec3> entrances;
+  terrain.reserve(map.terrain.size());
+  for (const auto &feature : map.terrain) {
+    BinTerrain record{};
+    record.type = static_cast<uint32_t>(feature.type);
+    record.center_x = feature.center_x;
+    record.center_z = feature.center_z;
+    record.radius = feature.radius;
+    record.width = feature.width;
+    record.depth = feature.depth;
+    record.height = feature.height;
+    record.rotationDeg = feature.rotationDeg;
+    record.entranceOffset = static_cast<uint32_t>(entrances.size());
+    record.entranceCount = static_cast<uint32_t>(feature.entrances.size());
+    for (const auto &entrance : feature.entrances) {
+      entrances.push_back(toBinVec3(entrance));
+    }
+    terrain.push_back(record);
+  }
+
+  std::vector<BinRiver> rivers;
+  rivers.reserve(map.rivers.size());
+  for (const auto &segment : map.rivers) {
+    rivers.push_back(
+        {toBinVec3(segment.start), toBinVec3(segment.end), segment.width});
+  }
+
+  std::vector<BinBridge> bridges;
+  bridges.reserve(map.bridges.size());
+  for (const auto &bridge : map.bridges) {
+    bridges.push_back({toBinVec3(bridge.start), toBinVec3(bridge.end),
+                       bridge.width, bridge.height});
+  }
+
+  struct PendingSection {
+    uint32_t id;
+    uint32_t count;
+    QByteArray payload;
+  };
+
+  std::vector<PendingSection> sections;
+  sections.push_back({k_section_strings, strings.count(), strings.payload()});
+  {
+    QByteArray payload;
+    payload.append(reinterpret_cast<const char *>(&info), sizeof(info));
+    sections.push_back({k_section_info, 1U, payload});
+  }
+  {
+    QByteArray payload;
+    appendRecords(payload, spawns);
+    sections.push_back(
+        {k_section_spawns, static_cast<uint32_t>(spawns.size()), payload});
+  }
+  {
+    QByteArray payload;
+    appendRecords(payload, firecamps);
+    sections.push_back({k_section_firecamps,
+                        static_cast<uint32_t>(firecamps.size()), payload});
+  }
+  {
+    QByteArray payload;
+    appendRecords(payload, terrain);
+    sections.push_back(
+        {k_section_terrain, static_cast<uint32_t>(terrain.size()), payload});
+  }
+  {
+    QByteArray payload;
+    appendRecords(payload, entrances);
+    sections.push_back({k_section_entrances,
+                        static_cast<uint32_t>(entrances.size()), payload});
+  }
+  {
+    QByteArray payload;
+    appendRecords(payload, rivers);
+    sections.push_back(
+        {k_section_rivers, static_cast<uint32_t>(rivers.size()), payload});
+  }
+  {
+    QByteArray payload;
+    appendRecords(payload, bridges);
+    sections.push_back(
+        {k_section_bridges, static_cast<uint32_t>(bridges.size()), payload});
+  }
+  {
+    QByteArray payload;
+    appendRecords(payload, victory_strings);
+    sections.push_back({k_section_victory_strings,
+                        static_cast<uint32_t>(victory_strings.size()),
+                        payload});
+  }
+
+  BinHeader header{};
+  header.magic = k_magic;
+  header.version = k_version;
+  sourceStamp(jsonPath, header.sourceSize, header.sourceMtimeMs);
+  header.sectionCount = static_cast<uint32_t>(sections.size());
+
+  std::vector<BinSection> table(sections.size());
+  uint32_t offset = static_cast<uint32_t>(
+      sizeof(BinHeader) + sections.size() * sizeof(BinSection));
+  for (std::size_t i = 0; i < sections.size(); ++i) {
+    table[i].id = sections[i].id;
+    table[i].offset = offset;
+    table[i].count = sections[i].count;
+    table[i].byteSize = static_cast<uint32_t>(sections[i].payload.size());
+    offset += table[i].byteSize;
+    // Keep every section 4-byte aligned for in-place reads.
+    const uint32_t padding = (4U - (offset % 4U)) % 4U;
+    offset += padding;
+  }
+
+  QDir().mkpath(QFileInfo(cache_path).absolutePath());
+  QSaveFile file(cache_path);
+  if (!file.open(QIODevice::WriteOnly)) {
+    return false;
+  }
+
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char *>(table.data()),
+             static_cast<qint64>(table.size() * sizeof(BinSection)));
+  for (const auto &section : sections) {
+    file.write(section.payload);
+    const uint32_t padding =
+        (4U - (static_cast<uint32_t>(section.payload.size()) % 4U)) % 4U;
+    if (padding != 0U) {
+      static constexpr char k_zeros[4] = {};
+      file.write(k_zeros, padding);
+    }
+  }
+
+  return file.commit();
+}
+
+auto MapBinaryCache::tryLoad(const QString &jsonPath,
+                             MapDefinition &outMap) -> bool {
+  const QString cache_path = cacheFilePath(jsonPath);
+  if (cache_path.isEmpty()) {
+    return false;
+  }
+
+  QFile file(cache_path);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+
+  const qint64 total = file.size();
+  if (total < static_cast<qint64>(sizeof(BinHeader))) {
+    return false;
+  }
+
+  // Map the whole file; section payloads are decoded straight from the
+  // mapping. readAll() is the fallback for filesystems without mmap.
+  QByteArray fallback;
+  const unsigned char *base = file.map(0, total);
+  if (base == nullptr) {
+    fallback = file.readAll();
+    if (fallback.size() != total) {
+      return false;
+    }
+    base = reinterpret_cast<const unsigned char *>(fallback.constData());
+  }
+
+  BinHeader header;
+  std::memcpy(&header, base, sizeof(header));
+  if (header.magic != k_magic || header.version != k_version) {
+    return false;
+  }
+
+  uint64_t source_size = 0;
+  uint64_t source_mtime_ms = 0;
+  sourceStamp(jsonPath, source_size, source_mtime_ms);
+  if (header.sourceSize != source_size ||
+      header.sourceMtimeMs != source_mtime_ms) {
+    return false;
+  }
+
+  const uint64_t table_end =
+      sizeof(BinHeader) + header.sectionCount * sizeof(BinSection);
+  if (table_end > static_cast<uint64_t>(total)) {
+    return false;
+  }
+
+  BinSection sections_by_id[16] = {};
+  for (uint32_t i = 0; i < header.sectionCount; ++i) {
+    BinSection section;
+    std::memcpy(&section, base + sizeof(BinHeader) + i * sizeof(BinSection),
+                sizeof(section));
+    if (static_cast<uint64_t>(section.offset) + section.byteSize >
+        static_cast<uint64_t>(total)) {
+      return false;
+    }
+    if (section.id < 16U) {
+      sections_by_id[section.id] = section;
+    }
+  }
+
+  const BinSection &strings_section = sections_by_id[k_section_strings];
+  const BinSection &info_section = sections_by_id[k_section_info];
+  if (info_section.byteSize != sizeof(BinInfo)) {
+    return false;
+  }
+
+  StringTableReader strings(base + strings_section.offset,
+                            strings_section.count, strings_section.byteSize);
+
+  BinInfo info;
+  std::memcpy(&info, base + info_section.offset, sizeof(info));
+
+  outMap.name = strings.get(info.nameStr);
+  outMap.coordSystem =
+      info.coordSystem == 1U ? CoordSystem::World : CoordSystem::Grid;
+  outMap.max_troops_per_player = info.maxTroopsPerPlayer;
+  outMap.grid.width = info.gridWidth;
+  outMap.grid.height = info.gridHeight;
+  outMap.grid.tile_size = info.tileSize;
+
+  outMap.camera.center = fromBinVec3(info.cameraCenter);
+  outMap.camera.distance = info.cameraDistance;
+  outMap.camera.tiltDeg = info.cameraTiltDeg;
+  outMap.camera.fovY = info.cameraFovY;
+  outMap.camera.near_plane = info.cameraNear;
+  outMap.camera.far_plane = info.cameraFar;
+  outMap.camera.yaw_deg = info.cameraYawDeg;
+
+  BiomeSettings &biome = outMap.biome;
+  biome.grassPrimary = fromBinVec3(info.grassPrimary);
+  biome.grassSecondary = fromBinVec3(info.grassSecondary);
+  biome.grassDry = fromBinVec3(info.grassDry);
+  biome.soilColor = fromBinVec3(info.soilColor);
+  biome.rockLow = fromBinVec3(info.rockLow);
+  biome.rockHigh = fromBinVec3(info.rockHigh);
+  biome.patchDensity = info.patchDensity;
+  biome.patchJitter = info.patchJitter;
+  biome.backgroundBladeDensity = info.backgroundBladeDensity;
+  biome.bladeHeightMin = info.bladeHeightMin;
+  biome.bladeHeightMax = info.bladeHeightMax;
+  biome.bladeWidthMin = info.bladeWidthMin;
+  biome.bladeWidthMax = info.bladeWidthMax;
+  biome.sway_strength = info.swayStrength;
+  biome.sway_speed = info.swaySpeed;
+  biome.heightNoiseAmplitude = info.heightNoiseAmplitude;
+  biome.heightNoiseFrequency = info.heightNoiseFrequency;
+  biome.terrainMacroNoiseScale = info.terrainMacroNoiseScale;
+  biome.terrainDetailNoiseScale = info.terrainDetailNoiseScale;
+  biome.terrainSoilHeight = info.terrainSoilHeight;
+  biome.terrainSoilSharpness = info.terrainSoilSharpness;
+  biome.terrainRockThreshold = info.terrainRockThreshold;
+  biome.terrainRockSharpness = info.terrainRockSharpness;
+  biome.terrainAmbientBoost = info.terrainAmbientBoost;
+  biome.terrainRockDetailStrength = info.terrainRockDetailStrength;
+  biome.backgroundSwayVariance = info.backgroundSwayVariance;
+  biome.backgroundScatterRadius = info.backgroundScatterRadius;
+  biome.plant_density = info.plantDensity;
+  biome.spawnEdgePadding = info.spawnEdgePadding;
+  biome.seed = info.biomeSeed;
+
+  const BinSection &spawn_section = sections_by_id[k_section_spawns];
+  outMap.spawns.clear();
+  outMap.spawns.reserve(spawn_section.count);
+  for (uint32_t i = 0; i < spawn_section.count; ++i) {
+    BinSpawn record;
+    std::memcpy(&record, base + spawn_section.offset + i * sizeof(record),
+                sizeof(record));
+    UnitSpawn spawn;
+    spawn.type = static_cast<Game::Units::SpawnType>(record.type);
+    spawn.x = record.x;
+    spawn.z = record.z;
+    spawn.player_id = record.player_id;
+    spawn.team_id = record.team_id;
+    spawn.maxPopulation = record.maxPopulation;
+    outMap.spawns.push_back(spawn);
+  }
+
+  const BinSection &camp_section = sections_by_id[k_section_firecamps];
+  outMap.firecamps.clear();
+  outMap.firecamps.reserve(camp_section.count);
+  for (uint32_t i = 0; i < camp_section.count; ++i) {
+    BinFireCamp record;
+    std::memcpy(&record, base + camp_section.offset + i * sizeof(record),
+                sizeof(record));
+    FireCamp camp;
+    camp.x = record.x;
+    camp.z = record.z;
+    camp.intensity = record.intensity;
+    camp.radius = record.radius;
+    camp.persistent = record.persistent != 0U;
+    outMap.firecamps.push_back(camp);
+  }
+
+  const BinSection &terrain_section = sections_by_id[k_section_terrain];
+  const BinSection &entrance_section = sections_by_id[k_section_entrances];
+  outMap.terrain.clear();
+  outMap.terrain.reserve(terrain_section.count);
+  for (uint32_t i = 0; i < terrain_section.count; ++i) {
+    BinTerrain record;
+    std::memcpy(&record, base + terrain_section.offset + i * sizeof(record),
+                sizeof(record));
+    TerrainFeature feature;
+    feature.type = static_cast<TerrainType>(record.type);
+    feature.center_x = record.center_x;
+    feature.center_z = record.center_z;
+    feature.radius = record.radius;
+    feature.width = record.width;
+    feature.depth = record.depth;
+    feature.height = record.height;
+    feature.rotationDeg = record.rotationDeg;
+    if (record.entranceOffset + record.entranceCount <=
+        entrance_section.count) {
+      feature.entrances.reserve(record.entranceCount);
+      for (uint32_t j = 0; j < record.entranceCount; ++j) {
+        BinVec3 entrance;
+        std::memcpy(&entrance,
+                    base + entrance_section.offset +
+                        (record.entranceOffset + j) * sizeof(entrance),
+                    sizeof(entrance));
+        feature.entrances.push_back(fromBinVec3(entrance));
+      }
+    }
+    outMap.terrain.push_back(std::move(feature));
+  }
+
+  const BinSection &river_section = sections_by_id[k_section_rivers];
+  outMap.rivers.clear();
+  outMap.rivers.reserve(river_section.count);
+  for (uint32_t i = 0; i < river_section.count; ++i) {
+    BinRiver record;
+    std::memcpy(&record, base + river_section.offset + i * sizeof(record),
+                sizeof(record));
+    RiverSegment segment;
+    segment.start = fromBinVec3(record.start);
+    segment.end = fromBinVec3(record.end);
+    segment.width = record.width;
+    outMap.rivers.push_back(segment);
+  }
+
+  const BinSection &bridge_section = sections_by_id[k_section_bridges];
+  outMap.bridges.clear();
+  outMap.bridges.reserve(bridge_section.count);
+  for (uint32_t i = 0; i < bridge_section.count; ++i) {
+    BinBridge record;
+    std::memcpy(&record, base + bridge_section.offset + i * sizeof(record),
+                sizeof(record));
+    Bridge bridge;
+    bridge.start = fromBinVec3(record.start);
+    bridge.end = fromBinVec3(record.end);
+    bridge.width = record.width;
+    bridge.height = record.height;
+    outMap.bridges.push_back(bridge);
+  }
+
+  const BinSection &victory_section = sections_by_id[k_section_victory_strings];
+  if (info.keyStructureCount + info.defeatConditionCount >
+      victory_section.count) {
+    return false;
+  }
+  outMap.victory.victoryType = strings.get(info.victoryTypeStr);
+  outMap.victory.surviveTimeDuration = info.surviveTimeDuration;
+  outMap.victory.keyStructures.clear();
+  outMap.victory.defeatConditions.clear();
+  for (uint32_t i = 0; i < info.keyStructureCount; ++i) {
+    uint32_t index = 0;
+    std::memcpy(&index, base + victory_section.offset + i * sizeof(index),
+                sizeof(index));
+    outMap.victory.keyStructures.push_back(strings.get(index));
+  }
+  for (uint32_t i = 0; i < info.defeatConditionCount; ++i) {
+    uint32_t index = 0;
+    std::memcpy(&index,
+                base + victory_section.offset +
+                    (info.keyStructureCount + i) * sizeof(index),
+                sizeof(index));
+    outMap.victory.defeatConditions.push_back(strings.get(index));
+  }
+
+  return true;
+}
+
+} // namespace Game::Map
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <QString>
+
+namespace Game::Map {
+
+struct MapDefinition;
+
+// Compiled binary form of a JSON map: little-endian packed records, a string
+// table and offset-indexed sections, written once under the user cache dir
+// and memory-mapped on later loads so terrain and scatter settings are read
+// without DOM parsing or QString churn. JSON stays the authoring format
+// (tools/map_editor edits it); the cache is keyed by source path and
+// invalidated when the source file's size or mtime changes.
+class MapBinaryCache {
+public:
+  [[nodiscard]] static auto tryLoad(const QString &jsonPath,
+                                    MapDefinition &outMap) -> bool;
+
+  static auto store(const QString &jsonPath,
+                    const MapDefinition &map) -> bool;
+};
+
+} // namespace Game::Map
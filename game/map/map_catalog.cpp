@@ -1,6 +1,7 @@
 #include "map_catalog.h"
 #include "json_keys.h"
 #include "utils/resource_utils.h"
+#include <QDateTime>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
@@ -8,7 +9,9 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonParseError>
+#include <QSaveFile>
 #include <QSet>
+#include <QStandardPaths>
 #include <QStringList>
 #include <QTimer>
 #include <QVariantMap>
@@ -32,6 +35,31 @@ namespace Game::Map {
 
 using namespace JsonKeys;
 
+namespace {
+
+constexpr int k_catalog_cache_version = 1;
+
+// One sidecar file holds the catalog fields for every map, so opening the
+// skirmish menu is a single small read; full JSON parses only happen for
+// maps whose size or mtime no longer matches the cached stamp.
+auto catalogCachePath() -> QString {
+  const QString base =
+      QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+  if (base.isEmpty()) {
+    return {};
+  }
+  return base + QStringLiteral("/maps/catalog.json");
+}
+
+void sourceStamp(const QString &path, qint64 &outSize, qint64 &outMtimeMs) {
+  QFileInfo const info(path);
+  outSize = info.size();
+  const QDateTime modified = info.lastModified();
+  outMtimeMs = modified.isValid() ? modified.toMSecsSinceEpoch() : 0;
+}
+
+} // namespace
+
 MapCatalog::MapCatalog(QObject *parent) : QObject(parent) {}
 
 auto MapCatalog::availableMaps() -> QVariantList {
@@ -137,6 +165,8 @@ void MapCatalog::loadMapsAsync() {
   m_loading = true;
   emit loadingChanged(true);
 
+  loadCatalogCache();
+
   const QString mapsRoot =
       Utils::Resources::resolveResourcePath(QStringLiteral(":/assets/maps"));
   QDir const mapsDir(mapsRoot);
@@ -162,6 +192,7 @@ void MapCatalog::loadMapsAsync() {
 
 void MapCatalog::loadNextMap() {
   if (m_pendingFiles.isEmpty()) {
+    saveCatalogCache();
     m_loading = false;
     emit loadingChanged(false);
     emit allMapsLoaded();
@@ -184,6 +215,7 @@ void MapCatalog::loadNextMap() {
   if (!m_pendingFiles.isEmpty()) {
     QTimer::singleShot(10, this, &MapCatalog::loadNextMap);
   } else {
+    saveCatalogCache();
     m_loading = false;
     emit loadingChanged(false);
     emit allMapsLoaded();
@@ -192,9 +224,24 @@ void MapCatalog::loadNextMap() {
 
 auto MapCatalog::loadSingleMap(const QString &path) -> QVariantMap {
   const QString resolvedPath = Utils::Resources::resolveResourcePath(path);
+
+  qint64 source_size = 0;
+  qint64 source_mtime_ms = 0;
+  sourceStamp(resolvedPath, source_size, source_mtime_ms);
+
+  const QJsonObject cached = m_cacheEntries[resolvedPath].toObject();
+  if (!cached.isEmpty() &&
+      cached[QStringLiteral("size")].toDouble() ==
+          static_cast<double>(source_size) &&
+      cached[QStringLiteral("mtimeMs")].toDouble() ==
+          static_cast<double>(source_mtime_ms)) {
+    return cached[QStringLiteral("entry")].toObject().toVariantMap();
+  }
+
   QFile file(resolvedPath);
   QString name = QFileInfo(resolvedPath).fileName();
   QString desc;
+  QString thumbnail;
   QSet<int> player_ids;
 
   if (file.open(QIODevice::ReadOnly)) {
@@ -210,6 +257,9 @@ auto MapCatalog::loadSingleMap(const QString &path) -> QVariantMap {
       if (obj.contains(DESCRIPTION) && obj[DESCRIPTION].isString()) {
         desc = obj[DESCRIPTION].toString();
       }
+      if (obj.contains(THUMBNAIL) && obj[THUMBNAIL].isString()) {
+        thumbnail = obj[THUMBNAIL].toString();
+      }
 
       if (obj.contains(SPAWNS) && obj[SPAWNS].isArray()) {
         QJsonArray const spawns = obj[SPAWNS].toArray();
@@ -242,19 +292,6 @@ auto MapCatalog::loadSingleMap(const QString &path) -> QVariantMap {
   }
   entry["player_ids"] = player_idList;
 
-  QString thumbnail;
-  if (file.open(QIODevice::ReadOnly)) {
-    QByteArray const data = file.readAll();
-    file.close();
-    QJsonParseError err;
-    QJsonDocument const doc = QJsonDocument::fromJson(data, &err);
-    if (err.error == QJsonParseError::NoError && doc.isObject()) {
-      QJsonObject obj = doc.object();
-      if (obj.contains(THUMBNAIL) && obj[THUMBNAIL].isString()) {
-        thumbnail = obj[THUMBNAIL].toString();
-      }
-    }
-  }
   if (thumbnail.isEmpty()) {
     QString const baseName = QFileInfo(resolvedPath).baseName();
     QString const thumbCandidate = Utils::Resources::resolveResourcePath(
@@ -268,7 +305,58 @@ auto MapCatalog::loadSingleMap(const QString &path) -> QVariantMap {
   }
   entry["thumbnail"] = thumbnail;
 
+  QJsonObject record;
+  record[QStringLiteral("size")] = static_cast<double>(source_size);
+  record[QStringLiteral("mtimeMs")] = static_cast<double>(source_mtime_ms);
+  record[QStringLiteral("entry")] = QJsonObject::fromVariantMap(entry);
+  m_cacheEntries[resolvedPath] = record;
+  m_cacheDirty = true;
+
   return entry;
 }
 
+void MapCatalog::loadCatalogCache() {
+  m_cacheEntries = QJsonObject();
+  m_cacheDirty = false;
+  const QString cache_path = catalogCachePath();
+  if (cache_path.isEmpty()) {
+    return;
+  }
+  QFile file(cache_path);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return;
+  }
+  QJsonParseError err;
+  QJsonDocument const doc = QJsonDocument::fromJson(file.readAll(), &err);
+  if (err.error != QJsonParseError::NoError || !doc.isObject()) {
+    return;
+  }
+  QJsonObject const root = doc.object();
+  if (root[QStringLiteral("version")].toInt() != k_catalog_cache_version) {
+    return;
+  }
+  m_cacheEntries = root[QStringLiteral("entries")].toObject();
+}
+
+void MapCatalog::saveCatalogCache() {
+  if (!m_cacheDirty) {
+    return;
+  }
+  m_cacheDirty = false;
+  const QString cache_path = catalogCachePath();
+  if (cache_path.isEmpty()) {
+    return;
+  }
+  QDir().mkpath(QFileInfo(cache_path).absolutePath());
+  QSaveFile file(cache_path);
+  if (!file.open(QIODevice::WriteOnly)) {
+    return;
+  }
+  QJsonObject root;
+  root[QStringLiteral("version")] = k_catalog_cache_version;
+  root[QStringLiteral("entries")] = m_cacheEntries;
+  file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+  file.commit();
+}
+
 } // namespace Game::Map
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QJsonObject>
 #include <QObject>
 #include <QVariantList>
 #include <QVariantMap>
@@ -25,11 +26,16 @@ signals:
 
 private:
   void loadNextMap();
-  static auto loadSingleMap(const QString &filePath) -> QVariantMap;
+  auto loadSingleMap(const QString &filePath) -> QVariantMap;
+
+  void loadCatalogCache();
+  void saveCatalogCache();
 
   QStringList m_pendingFiles;
   QVariantList m_maps;
+  QJsonObject m_cacheEntries;
   bool m_loading = false;
+  bool m_cacheDirty = false;
 };
 
 } // namespace Game::Map
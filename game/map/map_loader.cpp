@@ -1,5 +1,6 @@
 #include "map_loader.h"
 #include "json_keys.h"
+#include "map/map_binary_cache.h"
 #include "map/map_definition.h"
 #include "map/terrain.h"
 #include "units/spawn_type.h"
@@ -479,6 +480,20 @@ void readBridges(const QJsonArray &arr, std::vector<Bridge> &out,
 
 } // namespace
 
+auto MapLoader::loadFromFile(const QString &path, MapDefinition &outMap,
+                             QString *out_error) -> bool {
+  if (MapBinaryCache::tryLoad(path, outMap)) {
+    return true;
+  }
+
+  if (!loadFromJsonFile(path, outMap, out_error)) {
+    return false;
+  }
+
+  MapBinaryCache::store(path, outMap);
+  return true;
+}
+
 auto MapLoader::loadFromJsonFile(const QString &path, MapDefinition &outMap,
                                  QString *out_error) -> bool {
   QFile map_file(path);
@@ -7,6 +7,11 @@ namespace Game::Map {
 
 class MapLoader {
 public:
+  // Preferred entry point: serves the compiled binary cache when it is
+  // current, otherwise parses the JSON and compiles the cache for next time.
+  static auto loadFromFile(const QString &path, MapDefinition &outMap,
+                           QString *out_error = nullptr) -> bool;
+
   static auto loadFromJsonFile(const QString &path, MapDefinition &outMap,
                                QString *out_error = nullptr) -> bool;
 };
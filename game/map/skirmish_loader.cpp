@@ -10,6 +10,7 @@
 #include "game/systems/command_service.h"
 #include "game/systems/global_stats_registry.h"
 #include "game/systems/owner_registry.h"
+#include "game/systems/production_service.h"
 #include "game/systems/selection_system.h"
 #include "game/systems/troop_count_registry.h"
 #include "game/visuals/team_colors.h"
@@ -21,6 +22,7 @@
 #include "render/ground/pine_renderer.h"
 #include "render/ground/plant_renderer.h"
 #include "render/ground/river_renderer.h"
+#include "render/ground/riverbank_asset_renderer.h"
 #include "render/ground/riverbank_renderer.h"
 #include "render/ground/stone_renderer.h"
 #include "render/ground/terrain_renderer.h"
@@ -34,7 +36,9 @@
 #include <QJsonObject>
 #include <QJsonParseError>
 #include <QSet>
+#include <QTimer>
 #include <algorithm>
+#include <memory>
 #include <qdir.h>
 #include <qfiledevice.h>
 #include <qglobal.h>
@@ -48,17 +52,50 @@
 #include <qvectornd.h>
 #include <set>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace Game::Map {
 
 using namespace JsonKeys;
 
+namespace {
+
+// Stage order for the pipelined load; each stage runs in its own event-loop
+// turn so the UI keeps painting between them.
+enum LoadStage : int {
+  k_stage_prepare = 0,
+  k_stage_level = 1,
+  k_stage_visuals = 2,
+  k_stage_finish = 3,
+};
+
+constexpr float k_progress_prepare = 0.05F;
+constexpr float k_progress_level = 0.25F;
+constexpr float k_progress_visuals = 0.65F;
+constexpr float k_progress_finish = 0.85F;
+
+} // namespace
+
+struct SkirmishLoader::PendingLoad {
+  QString map_path;
+  QVariantList playerConfigs;
+  int selectedPlayerId = 0;
+  int resolvedPlayerId = 0;
+  QVariantList saved_player_configs;
+  LevelLoadResult level_result;
+  SkirmishLoadResult result;
+  FinishedCallback onFinished;
+  int stage = k_stage_prepare;
+};
+
 SkirmishLoader::SkirmishLoader(Engine::Core::World &world,
                                Render::GL::Renderer &renderer,
                                Render::GL::Camera &camera)
     : m_world(world), m_renderer(renderer), m_camera(camera) {}
 
+SkirmishLoader::~SkirmishLoader() { *m_alive = false; }
+
 void SkirmishLoader::resetGameState() {
   if (auto *selection_system =
           m_world.getSystem<Game::Systems::SelectionSystem>()) {
@@ -96,16 +133,120 @@ void SkirmishLoader::resetGameState() {
   }
 }
 
+void SkirmishLoader::reportProgress(float progress, const QString &stage) {
+  if (m_onProgress) {
+    m_onProgress(progress, stage);
+  }
+}
+
 auto SkirmishLoader::start(const QString &map_path,
                            const QVariantList &playerConfigs,
                            int selectedPlayerId,
                            int &outSelectedPlayerId) -> SkirmishLoadResult {
-  SkirmishLoadResult result;
+  m_pending = std::make_unique<PendingLoad>();
+  m_pending->map_path = map_path;
+  m_pending->playerConfigs = playerConfigs;
+  m_pending->selectedPlayerId = selectedPlayerId;
+  m_pending->resolvedPlayerId = selectedPlayerId;
+
+  if (stagePrepare() && stageLoadLevel()) {
+    stageApplyVisuals();
+    stageFinish();
+  }
+
+  SkirmishLoadResult result = std::move(m_pending->result);
+  outSelectedPlayerId = m_pending->resolvedPlayerId;
+  m_pending.reset();
+  return result;
+}
+
+auto SkirmishLoader::startAsync(const QString &map_path,
+                                const QVariantList &playerConfigs,
+                                int selectedPlayerId,
+                                FinishedCallback onFinished) -> bool {
+  if (m_pending != nullptr) {
+    return false;
+  }
+
+  m_pending = std::make_unique<PendingLoad>();
+  m_pending->map_path = map_path;
+  m_pending->playerConfigs = playerConfigs;
+  m_pending->selectedPlayerId = selectedPlayerId;
+  m_pending->resolvedPlayerId = selectedPlayerId;
+  m_pending->onFinished = std::move(onFinished);
+
+  reportProgress(0.0F, QStringLiteral("Preparing"));
+  scheduleNextStage();
+  return true;
+}
+
+void SkirmishLoader::scheduleNextStage() {
+  auto alive = m_alive;
+  QTimer::singleShot(0, [this, alive]() {
+    if (!*alive) {
+      return;
+    }
+    runStage();
+  });
+}
+
+void SkirmishLoader::runStage() {
+  if (m_pending == nullptr) {
+    return;
+  }
+
+  switch (m_pending->stage) {
+  case k_stage_prepare:
+    if (!stagePrepare()) {
+      finishPending();
+      return;
+    }
+    reportProgress(k_progress_level, QStringLiteral("Loading map"));
+    break;
+
+  case k_stage_level:
+    if (!stageLoadLevel()) {
+      finishPending();
+      return;
+    }
+    reportProgress(k_progress_visuals, QStringLiteral("Building terrain"));
+    break;
+
+  case k_stage_visuals:
+    stageApplyVisuals();
+    reportProgress(k_progress_finish, QStringLiteral("Computing visibility"));
+    break;
+
+  case k_stage_finish:
+    stageFinish();
+    reportProgress(1.0F, QStringLiteral("Ready"));
+    finishPending();
+    return;
+
+  default:
+    finishPending();
+    return;
+  }
+
+  ++m_pending->stage;
+  scheduleNextStage();
+}
+
+void SkirmishLoader::finishPending() {
+  auto pending = std::move(m_pending);
+  if (pending != nullptr && pending->onFinished) {
+    pending->onFinished(pending->result, pending->resolvedPlayerId);
+  }
+}
+
+auto SkirmishLoader::stagePrepare() -> bool {
+  auto &pending = *m_pending;
 
   resetGameState();
+  reportProgress(k_progress_prepare, QStringLiteral("Reading players"));
 
   QSet<int> map_player_ids;
-  QFile map_file(map_path);
+  QFile map_file(pending.map_path);
   if (map_file.open(QIODevice::ReadOnly)) {
     const QByteArray data = map_file.readAll();
     map_file.close();
@@ -129,38 +270,38 @@ auto SkirmishLoader::start(const QString &map_path,
       }
     }
   } else {
-    qWarning() << "Could not open map file for reading player IDs:" << map_path;
+    qWarning() << "Could not open map file for reading player IDs:"
+               << pending.map_path;
   }
 
   auto &owner_registry = Game::Systems::OwnerRegistry::instance();
 
-  int player_owner_id = selectedPlayerId;
+  int player_owner_id = pending.selectedPlayerId;
 
   if (!map_player_ids.contains(player_owner_id)) {
     if (!map_player_ids.isEmpty()) {
       QList<int> sorted_ids = map_player_ids.values();
       std::sort(sorted_ids.begin(), sorted_ids.end());
       player_owner_id = sorted_ids.first();
-      qWarning() << "Selected player ID" << selectedPlayerId
+      qWarning() << "Selected player ID" << pending.selectedPlayerId
                  << "not found in map spawns. Using" << player_owner_id
                  << "instead.";
-      outSelectedPlayerId = player_owner_id;
     } else {
       qWarning() << "No valid player spawns found in map. Using default "
                     "player ID"
                  << player_owner_id;
     }
   }
+  pending.resolvedPlayerId = player_owner_id;
 
   owner_registry.setLocalPlayerId(player_owner_id);
 
   std::unordered_map<int, int> team_overrides;
-  QVariantList saved_player_configs;
   std::set<int> processed_player_ids;
 
-  if (!playerConfigs.isEmpty()) {
+  if (!pending.playerConfigs.isEmpty()) {
 
-    for (const QVariant &config_var : playerConfigs) {
+    for (const QVariant &config_var : pending.playerConfigs) {
       const QVariantMap config = config_var.toMap();
       int player_id = config.value("player_id", -1).toInt();
       const int team_id = config.value("team_id", 0).toInt();
@@ -181,7 +322,7 @@ auto SkirmishLoader::start(const QString &map_path,
 
         QVariantMap updated_config = config;
         updated_config["player_id"] = player_id;
-        saved_player_configs.append(updated_config);
+        pending.saved_player_configs.append(updated_config);
       }
     }
   }
@@ -192,33 +333,47 @@ auto SkirmishLoader::start(const QString &map_path,
   }
 
   if (team_overrides.size() >= 2 && unique_teams.size() < 2) {
-    result.errorMessage = "Invalid team configuration: At least two teams must "
-                          "be selected to start a match.";
+    pending.result.errorMessage =
+        "Invalid team configuration: At least two teams must "
+        "be selected to start a match.";
     m_renderer.unlockWorldForModification();
     m_renderer.resume();
-    qWarning() << "SkirmishLoader: " << result.errorMessage;
-    return result;
+    qWarning() << "SkirmishLoader: " << pending.result.errorMessage;
+    return false;
   }
 
   Game::Map::MapTransformer::setLocalOwnerId(player_owner_id);
   Game::Map::MapTransformer::setPlayerTeamOverrides(team_overrides);
+  return true;
+}
 
-  auto level_result = Game::Map::LevelLoader::loadFromAssets(
-      map_path, m_world, m_renderer, m_camera);
+auto SkirmishLoader::stageLoadLevel() -> bool {
+  auto &pending = *m_pending;
 
-  if (!level_result.ok && !level_result.errorMessage.isEmpty()) {
-    result.errorMessage = level_result.errorMessage;
+  pending.level_result = Game::Map::LevelLoader::loadFromAssets(
+      pending.map_path, m_world, m_renderer, m_camera);
+
+  if (!pending.level_result.ok && !pending.level_result.errorMessage.isEmpty()) {
+    pending.result.errorMessage = pending.level_result.errorMessage;
     m_renderer.unlockWorldForModification();
     m_renderer.resume();
-    return result;
+    return false;
   }
+  return true;
+}
+
+void SkirmishLoader::stageApplyVisuals() {
+  auto &pending = *m_pending;
+  const auto &level_result = pending.level_result;
+
+  auto &owner_registry = Game::Systems::OwnerRegistry::instance();
 
   constexpr float COLOR_SCALE = 255.0F;
   constexpr int HEX_COLOR_LENGTH = 7;
   constexpr int HEX_BASE = 16;
 
-  if (!saved_player_configs.isEmpty()) {
-    for (const QVariant &config_var : saved_player_configs) {
+  if (!pending.saved_player_configs.isEmpty()) {
+    for (const QVariant &config_var : pending.saved_player_configs) {
       const QVariantMap config = config_var.toMap();
       const int player_id = config.value("player_id", -1).toInt();
       const QString color_hex = config.value("colorHex", "#FFFFFF").toString();
@@ -301,6 +456,15 @@ auto SkirmishLoader::start(const QString &map_path,
     }
   }
 
+  if (m_riverbankAssets != nullptr) {
+    if (terrain_service.isInitialized() &&
+        (terrain_service.getHeightMap() != nullptr)) {
+      m_riverbankAssets->configure(
+          terrain_service.getHeightMap()->getRiverSegments(),
+          *terrain_service.getHeightMap(), terrain_service.biomeSettings());
+    }
+  }
+
   if (m_bridge != nullptr) {
     if (terrain_service.isInitialized() &&
         (terrain_service.getHeightMap() != nullptr)) {
@@ -368,6 +532,13 @@ auto SkirmishLoader::start(const QString &map_path,
       }
     }
   }
+}
+
+void SkirmishLoader::stageFinish() {
+  auto &pending = *m_pending;
+  const auto &level_result = pending.level_result;
+  const int player_owner_id = pending.resolvedPlayerId;
+  auto &result = pending.result;
 
   constexpr int default_map_size = 100;
   const int map_width =
@@ -375,6 +546,38 @@ auto SkirmishLoader::start(const QString &map_path,
   const int map_height =
       level_result.ok ? level_result.grid_height : default_map_size;
   Game::Systems::CommandService::initialize(map_width, map_height);
+  Game::Systems::ProductionService::resetScheduler();
+  Game::Systems::ProductionService::rescheduleAll(m_world);
+
+  {
+    // Every unit type this match can field: the map's initial spawns
+    // plus everything a barracks can train. Prewarming their renderers
+    // now fills the procedural mesh caches behind the loading screen,
+    // so the first spawn of each type never pays a first-use mesh
+    // build mid-battle.
+    std::set<std::string> prewarm_types;
+    bool has_barracks = false;
+    for (auto *entity :
+         m_world.getEntitiesWith<Engine::Core::UnitComponent>()) {
+      auto *unit = entity->getComponent<Engine::Core::UnitComponent>();
+      if (unit == nullptr) {
+        continue;
+      }
+      prewarm_types.insert(
+          Game::Units::spawn_typeToString(unit->spawn_type));
+      has_barracks |= unit->spawn_type == Game::Units::SpawnType::Barracks;
+    }
+    if (has_barracks) {
+      for (auto troop :
+           {Game::Units::TroopType::Archer, Game::Units::TroopType::Knight,
+            Game::Units::TroopType::Spearman,
+            Game::Units::TroopType::MountedKnight}) {
+        prewarm_types.insert(Game::Units::troop_typeToString(troop));
+      }
+    }
+    m_renderer.prewarmEntityAssets(
+        {prewarm_types.begin(), prewarm_types.end()});
+  }
 
   auto &visibility_service = Game::Map::VisibilityService::instance();
   visibility_service.initialize(map_width, map_height, level_result.tile_size);
@@ -439,8 +642,6 @@ auto SkirmishLoader::start(const QString &map_path,
   result.tile_size = level_result.tile_size;
   result.max_troops_per_player = level_result.max_troops_per_player;
   result.victoryConfig = level_result.victoryConfig;
-
-  return result;
 }
 
 } // namespace Game::Map
@@ -26,6 +26,7 @@ class PineRenderer;
 class FireCampRenderer;
 class RiverRenderer;
 class RiverbankRenderer;
+class RiverbankAssetRenderer;
 class BridgeRenderer;
 } // namespace Render::GL
 
@@ -52,9 +53,16 @@ class SkirmishLoader {
 public:
   using OwnersUpdatedCallback = std::function<void()>;
   using VisibilityMaskReadyCallback = std::function<void()>;
+  using ProgressCallback = std::function<void(float, const QString &)>;
+  using FinishedCallback =
+      std::function<void(const SkirmishLoadResult &, int selectedPlayerId)>;
 
   SkirmishLoader(Engine::Core::World &world, Render::GL::Renderer &renderer,
                  Render::GL::Camera &camera);
+  ~SkirmishLoader();
+
+  SkirmishLoader(const SkirmishLoader &) = delete;
+  auto operator=(const SkirmishLoader &) -> SkirmishLoader & = delete;
 
   void setGroundRenderer(Render::GL::GroundRenderer *ground) {
     m_ground = ground;
@@ -67,6 +75,10 @@ public:
   void setRiverbankRenderer(Render::GL::RiverbankRenderer *riverbank) {
     m_riverbank = riverbank;
   }
+  void setRiverbankAssetRenderer(
+      Render::GL::RiverbankAssetRenderer *riverbankAssets) {
+    m_riverbankAssets = riverbankAssets;
+  }
   void setBridgeRenderer(Render::GL::BridgeRenderer *bridge) {
     m_bridge = bridge;
   }
@@ -86,12 +98,37 @@ public:
     m_onVisibilityMaskReady = std::move(callback);
   }
 
+  // Reports stage progress in [0, 1] with a user-facing stage name; invoked
+  // on the main thread at each stage boundary.
+  void setProgressCallback(ProgressCallback callback) {
+    m_onProgress = std::move(callback);
+  }
+
   auto start(const QString &map_path, const QVariantList &playerConfigs,
              int selectedPlayerId,
              int &outSelectedPlayerId) -> SkirmishLoadResult;
 
+  // Runs the same stages as start() but spread across event-loop turns
+  // (the MapCatalog pattern), so the UI keeps painting between stages.
+  // Returns false when a load is already in flight.
+  auto startAsync(const QString &map_path, const QVariantList &playerConfigs,
+                  int selectedPlayerId, FinishedCallback onFinished) -> bool;
+
+  [[nodiscard]] auto isLoading() const -> bool { return m_pending != nullptr; }
+
 private:
+  struct PendingLoad;
+
   void resetGameState();
+  void reportProgress(float progress, const QString &stage);
+  void scheduleNextStage();
+  void runStage();
+  void finishPending();
+  auto stagePrepare() -> bool;
+  auto stageLoadLevel() -> bool;
+  void stageApplyVisuals();
+  void stageFinish();
+
   Engine::Core::World &m_world;
   Render::GL::Renderer &m_renderer;
   Render::GL::Camera &m_camera;
@@ -100,6 +137,7 @@ private:
   Render::GL::BiomeRenderer *m_biome = nullptr;
   Render::GL::RiverRenderer *m_river = nullptr;
   Render::GL::RiverbankRenderer *m_riverbank = nullptr;
+  Render::GL::RiverbankAssetRenderer *m_riverbankAssets = nullptr;
   Render::GL::BridgeRenderer *m_bridge = nullptr;
   Render::GL::FogRenderer *m_fog = nullptr;
   Render::GL::StoneRenderer *m_stone = nullptr;
@@ -108,6 +146,10 @@ private:
   Render::GL::FireCampRenderer *m_firecamp = nullptr;
   OwnersUpdatedCallback m_onOwnersUpdated;
   VisibilityMaskReadyCallback m_onVisibilityMaskReady;
+  ProgressCallback m_onProgress;
+  std::unique_ptr<PendingLoad> m_pending;
+  // Guards queued stage continuations against a destroyed loader.
+  std::shared_ptr<bool> m_alive = std::make_shared<bool>(true);
 };
 
 } // namespace Game::Map
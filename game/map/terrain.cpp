@@ -1,4 +1,5 @@
 #include "terrain.h"
+#include "utils/parallel_for.h"
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
@@ -66,273 +67,306 @@ void TerrainHeightMap::buildFromFeatures(
   std::fill(m_hillEntrances.begin(), m_hillEntrances.end(), false);
   std::fill(m_hillWalkable.begin(), m_hillWalkable.end(), false);
 
-  const float grid_half_width = m_width * 0.5F - 0.5F;
-  const float grid_half_height = m_height * 0.5F - 0.5F;
+  // Mountains and flat mounds are pure per-cell max-combines (the winner
+  // also takes the cell's terrain type), so they commute and every band
+  // can apply all of them to its own rows: one sweep over the grid
+  // instead of a serial full-box pass per feature, with bands never
+  // touching each other's cells. Hills run serially afterwards — their
+  // entrance ramps carve along lines with neighbour writes (and
+  // vector<bool> walkability bits) that cross band boundaries.
+  Utils::Parallel::forBands(m_height,
+                            [&](int /*band*/, int z_begin, int z_end) {
+                              for (const auto &feature : features) {
+                                if (feature.type == TerrainType::Mountain) {
+                                  applyMountainFeature(feature, z_begin,
+                                                       z_end);
+                                } else if (feature.type != TerrainType::Hill) {
+                                  applyFlatMoundFeature(feature, z_begin,
+                                                        z_end);
+                                }
+                              }
+                            });
 
   for (const auto &feature : features) {
+    if (feature.type == TerrainType::Hill) {
+      applyHillFeature(feature);
+    }
+  }
+}
 
-    const float grid_center_x =
-        (feature.center_x / m_tile_size) + grid_half_width;
-    const float grid_center_z =
-        (feature.center_z / m_tile_size) + grid_half_height;
-    const float grid_radius = std::max(feature.radius / m_tile_size, 1.0F);
-
-    if (feature.type == TerrainType::Mountain) {
-      const float major_radius =
-          std::max(grid_radius * 1.8F, grid_radius + 3.0F);
-      const float minor_radius = std::max(grid_radius * 0.22F, 0.8F);
-      const float bound = std::max(major_radius, minor_radius) + 2.0F;
-      const int minX = std::max(0, int(std::floor(grid_center_x - bound)));
-      const int maxX =
-          std::min(m_width - 1, int(std::ceil(grid_center_x + bound)));
-      const int minZ = std::max(0, int(std::floor(grid_center_z - bound)));
-      const int maxZ =
-          std::min(m_height - 1, int(std::ceil(grid_center_z + bound)));
-
-      const float angle_rad = feature.rotationDeg * k_deg_to_rad;
-      const float cosA = std::cos(angle_rad);
-      const float sinA = std::sin(angle_rad);
-
-      for (int z = minZ; z <= maxZ; ++z) {
-        for (int x = minX; x <= maxX; ++x) {
-          const float local_x = float(x) - grid_center_x;
-          const float local_z = float(z) - grid_center_z;
-
-          const float rotated_x = local_x * cosA + local_z * sinA;
-          const float rotated_z = -local_x * sinA + local_z * cosA;
-
-          const float norm = std::sqrt(
-              (rotated_x * rotated_x) / (major_radius * major_radius) +
-              (rotated_z * rotated_z) / (minor_radius * minor_radius));
-
-          if (norm <= 1.0F) {
-            float const blend = std::clamp(1.0F - norm, 0.0F, 1.0F);
+void TerrainHeightMap::applyMountainFeature(const TerrainFeature &feature,
+                                            int z_begin, int z_end) {
+  const float grid_half_width = m_width * 0.5F - 0.5F;
+  const float grid_half_height = m_height * 0.5F - 0.5F;
 
-            float height = feature.height * std::pow(blend, 3.5F);
-            if (blend > 0.92F) {
-              height = feature.height;
-            }
+  const float grid_center_x = (feature.center_x / m_tile_size) + grid_half_width;
+  const float grid_center_z =
+      (feature.center_z / m_tile_size) + grid_half_height;
+  const float grid_radius = std::max(feature.radius / m_tile_size, 1.0F);
+
+  const float major_radius = std::max(grid_radius * 1.8F, grid_radius + 3.0F);
+  const float minor_radius = std::max(grid_radius * 0.22F, 0.8F);
+  const float bound = std::max(major_radius, minor_radius) + 2.0F;
+  const int minX = std::max(0, int(std::floor(grid_center_x - bound)));
+  const int maxX = std::min(m_width - 1, int(std::ceil(grid_center_x + bound)));
+  const int minZ = std::max(z_begin, int(std::floor(grid_center_z - bound)));
+  const int maxZ = std::min(z_end - 1, int(std::ceil(grid_center_z + bound)));
+
+  const float angle_rad = feature.rotationDeg * k_deg_to_rad;
+  const float cosA = std::cos(angle_rad);
+  const float sinA = std::sin(angle_rad);
+
+  for (int z = minZ; z <= maxZ; ++z) {
+    for (int x = minX; x <= maxX; ++x) {
+      const float local_x = float(x) - grid_center_x;
+      const float local_z = float(z) - grid_center_z;
+
+      const float rotated_x = local_x * cosA + local_z * sinA;
+      const float rotated_z = -local_x * sinA + local_z * cosA;
+
+      const float norm =
+          std::sqrt((rotated_x * rotated_x) / (major_radius * major_radius) +
+                    (rotated_z * rotated_z) / (minor_radius * minor_radius));
+
+      if (norm <= 1.0F) {
+        float const blend = std::clamp(1.0F - norm, 0.0F, 1.0F);
+
+        float height = feature.height * std::pow(blend, 3.5F);
+        if (blend > 0.92F) {
+          height = feature.height;
+        }
 
-            if (height > 0.01F) {
-              int const idx = indexAt(x, z);
-              if (height > m_heights[idx]) {
-                m_heights[idx] = height;
-                m_terrain_types[idx] = TerrainType::Mountain;
-              }
-            }
+        if (height > 0.01F) {
+          int const idx = indexAt(x, z);
+          if (height > m_heights[idx]) {
+            m_heights[idx] = height;
+            m_terrain_types[idx] = TerrainType::Mountain;
           }
         }
       }
-      continue;
     }
+  }
+}
 
-    if (feature.type == TerrainType::Hill) {
-      const float grid_width = std::max(feature.width / m_tile_size, 1.0F);
-      const float grid_depth = std::max(feature.depth / m_tile_size, 1.0F);
-
-      const float plateau_width = std::max(1.5F, grid_width * 0.45F);
-      const float plateau_depth = std::max(1.5F, grid_depth * 0.45F);
-      const float slope_width = std::max(plateau_width + 1.5F, grid_width);
-      const float slope_depth = std::max(plateau_depth + 1.5F, grid_depth);
-
-      const float max_extent = std::max(slope_width, slope_depth);
-      const int minX =
-          std::max(0, int(std::floor(grid_center_x - max_extent - 1.0F)));
-      const int maxX = std::min(
-          m_width - 1, int(std::ceil(grid_center_x + max_extent + 1.0F)));
-      const int minZ =
-          std::max(0, int(std::floor(grid_center_z - max_extent - 1.0F)));
-      const int maxZ = std::min(
-          m_height - 1, int(std::ceil(grid_center_z + max_extent + 1.0F)));
-
-      std::vector<int> plateau_cells;
-      plateau_cells.reserve(int(M_PI * plateau_width * plateau_depth));
-
-      const float angle_rad = feature.rotationDeg * k_deg_to_rad;
-      const float cosA = std::cos(angle_rad);
-      const float sinA = std::sin(angle_rad);
+void TerrainHeightMap::applyFlatMoundFeature(const TerrainFeature &feature,
+                                             int z_begin, int z_end) {
+  const float grid_half_width = m_width * 0.5F - 0.5F;
+  const float grid_half_height = m_height * 0.5F - 0.5F;
 
-      for (int z = minZ; z <= maxZ; ++z) {
-        for (int x = minX; x <= maxX; ++x) {
-          const float dx = float(x) - grid_center_x;
-          const float dz = float(z) - grid_center_z;
+  const float grid_center_x = (feature.center_x / m_tile_size) + grid_half_width;
+  const float grid_center_z =
+      (feature.center_z / m_tile_size) + grid_half_height;
+  const float flat_radius = std::max(feature.radius / m_tile_size, 1.0F);
+
+  const int minX = std::max(0, int(std::floor(grid_center_x - flat_radius)));
+  const int maxX =
+      std::min(m_width - 1, int(std::ceil(grid_center_x + flat_radius)));
+  const int minZ = std::max(z_begin, int(std::floor(grid_center_z - flat_radius)));
+  const int maxZ =
+      std::min(z_end - 1, int(std::ceil(grid_center_z + flat_radius)));
+
+  for (int z = minZ; z <= maxZ; ++z) {
+    for (int x = minX; x <= maxX; ++x) {
+      const float dx = float(x) - grid_center_x;
+      const float dz = float(z) - grid_center_z;
+      const float dist = std::sqrt(dx * dx + dz * dz);
+      if (dist > flat_radius) {
+        continue;
+      }
 
-          const float rotated_x = dx * cosA + dz * sinA;
-          const float rotated_z = -dx * sinA + dz * cosA;
+      float const t = dist / std::max(flat_radius, 0.0001F);
+      float const height = feature.height * (1.0F - t);
+      if (height <= 0.0F) {
+        continue;
+      }
 
-          const float norm_plateau_dist = std::sqrt(
-              (rotated_x * rotated_x) / (plateau_width * plateau_width) +
-              (rotated_z * rotated_z) / (plateau_depth * plateau_depth));
-          const float norm_slope_dist =
-              std::sqrt((rotated_x * rotated_x) / (slope_width * slope_width) +
-                        (rotated_z * rotated_z) / (slope_depth * slope_depth));
+      int const idx = indexAt(x, z);
+      if (height > m_heights[idx]) {
+        m_heights[idx] = height;
+        m_terrain_types[idx] = TerrainType::Flat;
+      }
+    }
+  }
+}
 
-          if (norm_slope_dist > 1.0F) {
-            continue;
-          }
+void TerrainHeightMap::applyHillFeature(const TerrainFeature &feature) {
+  const float grid_half_width = m_width * 0.5F - 0.5F;
+  const float grid_half_height = m_height * 0.5F - 0.5F;
 
-          const int idx = indexAt(x, z);
-
-          float height = 0.0F;
-          if (norm_plateau_dist <= 1.0F) {
-            height = feature.height;
-            plateau_cells.push_back(idx);
-          } else {
-            float const t = std::clamp((norm_slope_dist - norm_plateau_dist) /
-                                           (1.0F - norm_plateau_dist),
-                                       0.0F, 1.0F);
-            float const smooth =
-                0.5F * (1.0F + std::cos(t * std::numbers::pi_v<float>));
-            height = feature.height * smooth;
-          }
+  const float grid_center_x = (feature.center_x / m_tile_size) + grid_half_width;
+  const float grid_center_z =
+      (feature.center_z / m_tile_size) + grid_half_height;
+
+  const float grid_width = std::max(feature.width / m_tile_size, 1.0F);
+  const float grid_depth = std::max(feature.depth / m_tile_size, 1.0F);
+  const float plateau_width = std::max(1.5F, grid_width * 0.45F);
+  const float plateau_depth = std::max(1.5F, grid_depth * 0.45F);
+  const float slope_width = std::max(plateau_width + 1.5F, grid_width);
+  const float slope_depth = std::max(plateau_depth + 1.5F, grid_depth);
+
+  const float max_extent = std::max(slope_width, slope_depth);
+  const int minX =
+      std::max(0, int(std::floor(grid_center_x - max_extent - 1.0F)));
+  const int maxX = std::min(
+      m_width - 1, int(std::ceil(grid_center_x + max_extent + 1.0F)));
+  const int minZ =
+      std::max(0, int(std::floor(grid_center_z - max_extent - 1.0F)));
+  const int maxZ = std::min(
+      m_height - 1, int(std::ceil(grid_center_z + max_extent + 1.0F)));
+
+  std::vector<int> plateau_cells;
+  plateau_cells.reserve(int(M_PI * plateau_width * plateau_depth));
+
+  const float angle_rad = feature.rotationDeg * k_deg_to_rad;
+  const float cosA = std::cos(angle_rad);
+  const float sinA = std::sin(angle_rad);
+
+  for (int z = minZ; z <= maxZ; ++z) {
+    for (int x = minX; x <= maxX; ++x) {
+      const float dx = float(x) - grid_center_x;
+      const float dz = float(z) - grid_center_z;
+
+      const float rotated_x = dx * cosA + dz * sinA;
+      const float rotated_z = -dx * sinA + dz * cosA;
+
+      const float norm_plateau_dist = std::sqrt(
+          (rotated_x * rotated_x) / (plateau_width * plateau_width) +
+          (rotated_z * rotated_z) / (plateau_depth * plateau_depth));
+      const float norm_slope_dist =
+          std::sqrt((rotated_x * rotated_x) / (slope_width * slope_width) +
+                    (rotated_z * rotated_z) / (slope_depth * slope_depth));
+
+      if (norm_slope_dist > 1.0F) {
+        continue;
+      }
 
-          if (height > m_heights[idx]) {
-            m_heights[idx] = height;
-            m_terrain_types[idx] = TerrainType::Hill;
-          }
-        }
+      const int idx = indexAt(x, z);
+
+      float height = 0.0F;
+      if (norm_plateau_dist <= 1.0F) {
+        height = feature.height;
+        plateau_cells.push_back(idx);
+      } else {
+        float const t = std::clamp((norm_slope_dist - norm_plateau_dist) /
+                                       (1.0F - norm_plateau_dist),
+                                   0.0F, 1.0F);
+        float const smooth =
+            0.5F * (1.0F + std::cos(t * std::numbers::pi_v<float>));
+        height = feature.height * smooth;
       }
 
-      for (int const idx : plateau_cells) {
-        m_hillWalkable[idx] = true;
+      if (height > m_heights[idx]) {
+        m_heights[idx] = height;
+        m_terrain_types[idx] = TerrainType::Hill;
       }
+    }
+  }
 
-      for (const auto &entrance : feature.entrances) {
-        int const ex = int(std::round(entrance.x()));
-        int const ez = int(std::round(entrance.z()));
-        if (!inBounds(ex, ez)) {
-          continue;
-        }
+  for (int const idx : plateau_cells) {
+    m_hillWalkable[idx] = true;
+  }
 
-        const int entrance_idx = indexAt(ex, ez);
-        m_hillEntrances[entrance_idx] = true;
-        m_hillWalkable[entrance_idx] = true;
+  for (const auto &entrance : feature.entrances) {
+    int const ex = int(std::round(entrance.x()));
+    int const ez = int(std::round(entrance.z()));
+    if (!inBounds(ex, ez)) {
+      continue;
+    }
 
-        float dirX = grid_center_x - float(ex);
-        float dirZ = grid_center_z - float(ez);
-        float const length = std::sqrt(dirX * dirX + dirZ * dirZ);
-        if (length < 0.001F) {
-          continue;
-        }
+    const int entrance_idx = indexAt(ex, ez);
+    m_hillEntrances[entrance_idx] = true;
+    m_hillWalkable[entrance_idx] = true;
 
-        dirX /= length;
-        dirZ /= length;
+    float dirX = grid_center_x - float(ex);
+    float dirZ = grid_center_z - float(ez);
+    float const length = std::sqrt(dirX * dirX + dirZ * dirZ);
+    if (length < 0.001F) {
+      continue;
+    }
 
-        auto curX = float(ex);
-        auto curZ = float(ez);
-        const int steps = int(length) + 3;
+    dirX /= length;
+    dirZ /= length;
 
-        for (int step = 0; step < steps; ++step) {
-          int const ix = int(std::round(curX));
-          int const iz = int(std::round(curZ));
-          if (!inBounds(ix, iz)) {
-            break;
-          }
+    auto curX = float(ex);
+    auto curZ = float(ez);
+    const int steps = int(length) + 3;
 
-          const int idx = indexAt(ix, iz);
+    for (int step = 0; step < steps; ++step) {
+      int const ix = int(std::round(curX));
+      int const iz = int(std::round(curZ));
+      if (!inBounds(ix, iz)) {
+        break;
+      }
 
-          const float cell_dx = float(ix) - grid_center_x;
-          const float cell_dz = float(iz) - grid_center_z;
-          const float cell_rot_x = cell_dx * cosA + cell_dz * sinA;
-          const float cell_rot_z = -cell_dx * sinA + cell_dz * cosA;
-          const float cell_norm_dist = std::sqrt(
-              (cell_rot_x * cell_rot_x) / (slope_width * slope_width) +
-              (cell_rot_z * cell_rot_z) / (slope_depth * slope_depth));
+      const int idx = indexAt(ix, iz);
 
-          if (cell_norm_dist > 1.1F) {
-            break;
-          }
+      const float cell_dx = float(ix) - grid_center_x;
+      const float cell_dz = float(iz) - grid_center_z;
+      const float cell_rot_x = cell_dx * cosA + cell_dz * sinA;
+      const float cell_rot_z = -cell_dx * sinA + cell_dz * cosA;
+      const float cell_norm_dist = std::sqrt(
+          (cell_rot_x * cell_rot_x) / (slope_width * slope_width) +
+          (cell_rot_z * cell_rot_z) / (slope_depth * slope_depth));
 
-          m_hillWalkable[idx] = true;
-          if (m_terrain_types[idx] != TerrainType::Mountain) {
-            m_terrain_types[idx] = TerrainType::Hill;
-          }
+      if (cell_norm_dist > 1.1F) {
+        break;
+      }
+
+      m_hillWalkable[idx] = true;
+      if (m_terrain_types[idx] != TerrainType::Mountain) {
+        m_terrain_types[idx] = TerrainType::Hill;
+      }
+
+      if (m_heights[idx] < feature.height * 0.25F) {
+        float const t = std::clamp(cell_norm_dist, 0.0F, 1.0F);
+        float const ramp_height = feature.height * (1.0F - t * 0.85F);
+        m_heights[idx] = std::max(m_heights[idx], ramp_height);
+      }
 
-          if (m_heights[idx] < feature.height * 0.25F) {
-            float const t = std::clamp(cell_norm_dist, 0.0F, 1.0F);
-            float const ramp_height = feature.height * (1.0F - t * 0.85F);
-            m_heights[idx] = std::max(m_heights[idx], ramp_height);
+      for (int oz = -1; oz <= 1; ++oz) {
+        for (int ox = -1; ox <= 1; ++ox) {
+          if (ox == 0 && oz == 0) {
+            continue;
+          }
+          int const nx = ix + ox;
+          int const nz = iz + oz;
+          if (!inBounds(nx, nz)) {
+            continue;
           }
 
-          for (int oz = -1; oz <= 1; ++oz) {
-            for (int ox = -1; ox <= 1; ++ox) {
-              if (ox == 0 && oz == 0) {
-                continue;
+          const float nDx = float(nx) - grid_center_x;
+          const float nDz = float(nz) - grid_center_z;
+          const float n_rot_x = nDx * cosA + nDz * sinA;
+          const float n_rot_z = -nDx * sinA + nDz * cosA;
+          const float neighbor_norm_dist =
+              std::sqrt((n_rot_x * n_rot_x) / (slope_width * slope_width) +
+                        (n_rot_z * n_rot_z) / (slope_depth * slope_depth));
+
+          if (neighbor_norm_dist <= 1.05F) {
+            int const nIdx = indexAt(nx, nz);
+            if (m_terrain_types[nIdx] != TerrainType::Mountain) {
+              m_hillWalkable[nIdx] = true;
+              if (m_terrain_types[nIdx] == TerrainType::Flat) {
+                m_terrain_types[nIdx] = TerrainType::Hill;
               }
-              int const nx = ix + ox;
-              int const nz = iz + oz;
-              if (!inBounds(nx, nz)) {
-                continue;
-              }
-
-              const float nDx = float(nx) - grid_center_x;
-              const float nDz = float(nz) - grid_center_z;
-              const float n_rot_x = nDx * cosA + nDz * sinA;
-              const float n_rot_z = -nDx * sinA + nDz * cosA;
-              const float neighbor_norm_dist =
-                  std::sqrt((n_rot_x * n_rot_x) / (slope_width * slope_width) +
-                            (n_rot_z * n_rot_z) / (slope_depth * slope_depth));
-
-              if (neighbor_norm_dist <= 1.05F) {
-                int const nIdx = indexAt(nx, nz);
-                if (m_terrain_types[nIdx] != TerrainType::Mountain) {
-                  m_hillWalkable[nIdx] = true;
-                  if (m_terrain_types[nIdx] == TerrainType::Flat) {
-                    m_terrain_types[nIdx] = TerrainType::Hill;
-                  }
-                  if (m_heights[nIdx] < m_heights[idx] * 0.8F) {
-                    m_heights[nIdx] =
-                        std::max(m_heights[nIdx], m_heights[idx] * 0.7F);
-                  }
-                }
+              if (m_heights[nIdx] < m_heights[idx] * 0.8F) {
+                m_heights[nIdx] =
+                    std::max(m_heights[nIdx], m_heights[idx] * 0.7F);
               }
             }
           }
-
-          const float plateau_norm_dist = std::sqrt(
-              (cell_rot_x * cell_rot_x) / (plateau_width * plateau_width) +
-              (cell_rot_z * cell_rot_z) / (plateau_depth * plateau_depth));
-          if (plateau_norm_dist <= 1.05F) {
-            break;
-          }
-
-          curX += dirX;
-          curZ += dirZ;
         }
       }
 
-      continue;
-    }
-
-    const float flat_radius = grid_radius;
-    const int minX = std::max(0, int(std::floor(grid_center_x - flat_radius)));
-    const int maxX =
-        std::min(m_width - 1, int(std::ceil(grid_center_x + flat_radius)));
-    const int minZ = std::max(0, int(std::floor(grid_center_z - flat_radius)));
-    const int maxZ =
-        std::min(m_height - 1, int(std::ceil(grid_center_z + flat_radius)));
-
-    for (int z = minZ; z <= maxZ; ++z) {
-      for (int x = minX; x <= maxX; ++x) {
-        const float dx = float(x) - grid_center_x;
-        const float dz = float(z) - grid_center_z;
-        const float dist = std::sqrt(dx * dx + dz * dz);
-        if (dist > flat_radius) {
-          continue;
-        }
-
-        float const t = dist / std::max(flat_radius, 0.0001F);
-        float const height = feature.height * (1.0F - t);
-        if (height <= 0.0F) {
-          continue;
-        }
-
-        int const idx = indexAt(x, z);
-        if (height > m_heights[idx]) {
-          m_heights[idx] = height;
-          m_terrain_types[idx] = TerrainType::Flat;
-        }
+      const float plateau_norm_dist = std::sqrt(
+          (cell_rot_x * cell_rot_x) / (plateau_width * plateau_width) +
+          (cell_rot_z * cell_rot_z) / (plateau_depth * plateau_depth));
+      if (plateau_norm_dist <= 1.05F) {
+        break;
       }
+
+      curX += dirX;
+      curZ += dirZ;
     }
   }
 }
@@ -478,33 +512,41 @@ void TerrainHeightMap::applyBiomeVariation(const BiomeSettings &settings) {
   const float half_width = m_width * 0.5F - 0.5F;
   const float half_height = m_height * 0.5F - 0.5F;
 
-  for (int z = 0; z < m_height; ++z) {
-    for (int x = 0; x < m_width; ++x) {
-      int const idx = indexAt(x, z);
-      TerrainType const type = m_terrain_types[idx];
-      if (type == TerrainType::Mountain) {
-        continue;
-      }
+  // The noise is a pure function of cell coordinates and the map seed, so
+  // row bands can run in parallel and still produce identical heights.
+  Utils::Parallel::forBands(m_height, [&](int /*band*/, int z_begin,
+                                          int z_end) {
+    for (int z = z_begin; z < z_end; ++z) {
+      for (int x = 0; x < m_width; ++x) {
+        int const idx = indexAt(x, z);
+        TerrainType const type = m_terrain_types[idx];
+        if (type == TerrainType::Mountain) {
+          continue;
+        }
 
-      float const world_x = (static_cast<float>(x) - half_width) * m_tile_size;
-      float const world_z = (static_cast<float>(z) - half_height) * m_tile_size;
-      float const sample_x = world_x * frequency;
-      float const sample_z = world_z * frequency;
+        float const world_x =
+            (static_cast<float>(x) - half_width) * m_tile_size;
+        float const world_z =
+            (static_cast<float>(z) - half_height) * m_tile_size;
+        float const sample_x = world_x * frequency;
+        float const sample_z = world_z * frequency;
 
-      float const base_noise = valueNoise2D(sample_x, sample_z, settings.seed);
-      float const detail_noise = valueNoise2D(sample_x * 2.0F, sample_z * 2.0F,
-                                              settings.seed ^ 0xA21C9E37U);
+        float const base_noise =
+            valueNoise2D(sample_x, sample_z, settings.seed);
+        float const detail_noise = valueNoise2D(
+            sample_x * 2.0F, sample_z * 2.0F, settings.seed ^ 0xA21C9E37U);
 
-      float const blended = 0.65F * base_noise + 0.35F * detail_noise;
-      float perturb = (blended - 0.5F) * 2.0F * amplitude;
+        float const blended = 0.65F * base_noise + 0.35F * detail_noise;
+        float perturb = (blended - 0.5F) * 2.0F * amplitude;
 
-      if (type == TerrainType::Hill) {
-        perturb *= 0.6F;
-      }
+        if (type == TerrainType::Hill) {
+          perturb *= 0.6F;
+        }
 
-      m_heights[idx] = std::max(0.0F, m_heights[idx] + perturb);
+        m_heights[idx] = std::max(0.0F, m_heights[idx] + perturb);
+      }
     }
-  }
+  });
 }
 
 void TerrainHeightMap::addRiverSegments(
@@ -186,6 +186,15 @@ private:
   [[nodiscard]] auto indexAt(int x, int z) const -> int;
   [[nodiscard]] auto inBounds(int x, int z) const -> bool;
 
+  // Per-cell max-combine features, applied band-parallel over [z_begin,
+  // z_end) rows; hills carve entrance ramps with cross-row writes and
+  // run serially on the whole grid.
+  void applyMountainFeature(const TerrainFeature &feature, int z_begin,
+                            int z_end);
+  void applyFlatMoundFeature(const TerrainFeature &feature, int z_begin,
+                             int z_end);
+  void applyHillFeature(const TerrainFeature &feature);
+
   [[nodiscard]] static auto
   calculateFeatureHeight(const TerrainFeature &feature, float world_x,
                          float world_z) -> float;
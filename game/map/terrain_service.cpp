@@ -25,16 +25,21 @@ void TerrainService::initialize(const MapDefinition &mapDef) {
   m_biomeSettings = mapDef.biome;
   m_height_map->applyBiomeVariation(m_biomeSettings);
   m_fire_camps = mapDef.firecamps;
+  m_heightSampler.build(*m_height_map);
 }
 
 void TerrainService::clear() {
   m_height_map.reset();
+  m_heightSampler.clear();
   m_biomeSettings = BiomeSettings();
   m_fire_camps.clear();
 }
 
 auto TerrainService::getTerrainHeight(float world_x,
                                       float world_z) const -> float {
+  if (m_heightSampler.isBuilt()) {
+    return m_heightSampler.heightAt(world_x, world_z);
+  }
   if (!m_height_map) {
     return 0.0F;
   }
@@ -129,6 +134,7 @@ void TerrainService::restoreFromSerialized(
   m_height_map = std::make_unique<TerrainHeightMap>(width, height, tile_size);
   m_height_map->restoreFromData(heights, terrain_types, rivers, bridges);
   m_biomeSettings = biome;
+  m_heightSampler.build(*m_height_map);
 }
 
 } // namespace Game::Map
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "height_sampler.h"
 #include "terrain.h"
 #include <memory>
 #include <vector>
@@ -39,6 +40,13 @@ public:
     return m_height_map.get();
   }
 
+  // Compact quantized height grid rebuilt whenever the height map is
+  // (re)loaded; systems issuing per-unit queries every frame should
+  // sample this instead of going through the full terrain object.
+  [[nodiscard]] auto heightSampler() const -> const TerrainHeightSampler & {
+    return m_heightSampler;
+  }
+
   [[nodiscard]] auto biomeSettings() const -> const BiomeSettings & {
     return m_biomeSettings;
   }
@@ -66,6 +74,7 @@ private:
   auto operator=(const TerrainService &) -> TerrainService & = delete;
 
   std::unique_ptr<TerrainHeightMap> m_height_map;
+  TerrainHeightSampler m_heightSampler;
   BiomeSettings m_biomeSettings;
   std::vector<FireCamp> m_fire_camps;
 };
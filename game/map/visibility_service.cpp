@@ -21,17 +21,10 @@ namespace Game::Map {
 namespace {
 
 constexpr float k_default_vision_range = 12.0F;
+constexpr std::size_t k_delta_history_limit = 8;
 constexpr float k_half_cell_offset = 0.5F;
 constexpr float k_min_tile_size = 0.0001F;
 
-auto inBoundsStatic(int grid_x, int grid_z, int width, int height) -> bool {
-  return grid_x >= 0 && grid_x < width && grid_z >= 0 && grid_z < height;
-}
-
-auto indexStatic(int grid_x, int grid_z, int width) -> int {
-  return grid_z * width + grid_x;
-}
-
 auto worldToGridStatic(float world_coord, float half, float tile_size) -> int {
   const float grid_coord = world_coord / tile_size + half;
   return static_cast<int>(std::floor(grid_coord + k_half_cell_offset));
@@ -56,6 +49,10 @@ void VisibilityService::initialize(int width, int height, float tile_size) {
 
   const int count = m_width * m_height;
   m_cells.assign(count, static_cast<std::uint8_t>(VisibilityState::Unseen));
+  m_refCounts.assign(count, 0U);
+  m_lastSources.clear();
+  m_deltaHistory.clear();
+  rebuildMipPyramid();
   m_version.store(1, std::memory_order_release);
   m_generation.store(0, std::memory_order_release);
   m_initialized = true;
@@ -68,6 +65,11 @@ void VisibilityService::reset() {
   std::unique_lock<std::shared_mutex> const lock(m_cellsMutex);
   std::fill(m_cells.begin(), m_cells.end(),
             static_cast<std::uint8_t>(VisibilityState::Unseen));
+  std::fill(m_refCounts.begin(), m_refCounts.end(),
+            static_cast<std::uint16_t>(0U));
+  m_lastSources.clear();
+  m_deltaHistory.clear();
+  rebuildMipPyramid();
   m_version.fetch_add(1, std::memory_order_release);
 }
 
@@ -97,24 +99,49 @@ void VisibilityService::computeImmediate(Engine::Core::World &world,
   const auto sources = gatherVisionSources(world, player_id);
   auto payload = composeJobPayload(sources);
   auto result = executeJob(std::move(payload));
+  m_refCounts = std::move(result.refCounts);
 
   if (result.changed) {
     std::unique_lock<std::shared_mutex> const lock(m_cellsMutex);
     m_cells = std::move(result.cells);
-    m_version.fetch_add(1, std::memory_order_release);
+    const auto new_version =
+        m_version.fetch_add(1, std::memory_order_release) + 1;
+    recordDelta(new_version, result.changedCells);
   }
 }
 
 auto VisibilityService::gatherVisionSources(Engine::Core::World &world,
-                                            int player_id) const
+                                            int player_id)
     -> std::vector<VisibilityService::VisionSource> {
   std::vector<VisionSource> sources;
+  m_worldSources.clear();
   const auto entities =
       world.getEntitiesWith<Engine::Core::TransformComponent>();
   const float range_padding = m_tile_size * k_half_cell_offset;
 
   auto &owner_registry = Game::Systems::OwnerRegistry::instance();
 
+  // The grid is the alliance's shared view: every owner on the player's
+  // team contributes sources. Resolve that alliance once here instead of
+  // paying two team lookups per entity — the per-unit test collapses to a
+  // scan of a handful of ids.
+  const int player_team = owner_registry.getOwnerTeam(player_id);
+  m_alliedOwners.clear();
+  m_alliedOwners.push_back(player_id);
+  for (const auto &owner : owner_registry.getAllOwners()) {
+    if (owner.owner_id != player_id && owner.team_id == player_team) {
+      m_alliedOwners.push_back(owner.owner_id);
+    }
+  }
+  const auto is_allied = [&](int owner_id) {
+    for (int const allied : m_alliedOwners) {
+      if (allied == owner_id) {
+        return true;
+      }
+    }
+    return false;
+  };
+
   for (auto *entity : entities) {
     auto *transform = entity->getComponent<Engine::Core::TransformComponent>();
     auto *unit = entity->getComponent<Engine::Core::UnitComponent>();
@@ -126,8 +153,7 @@ auto VisibilityService::gatherVisionSources(Engine::Core::World &world,
       continue;
     }
 
-    if (unit->owner_id != player_id &&
-        !owner_registry.areAllies(player_id, unit->owner_id)) {
+    if (!is_allied(unit->owner_id)) {
       continue;
     }
 
@@ -148,20 +174,56 @@ auto VisibilityService::gatherVisionSources(Engine::Core::World &world,
     const float expanded_range_sq =
         (vision_range + range_padding) * (vision_range + range_padding);
 
-    sources.push_back({center_x, center_z, cell_radius, expanded_range_sq});
+    sources.push_back(
+        {entity->getId(), center_x, center_z, cell_radius, expanded_range_sq});
+    m_worldSources.push_back(
+        {transform->position.x, transform->position.z, vision_range, 0.0F});
   }
 
   return sources;
 }
 
 auto VisibilityService::composeJobPayload(
-    const std::vector<VisionSource> &sources) const
+    const std::vector<VisionSource> &sources)
     -> VisibilityService::JobPayload {
-  std::shared_lock<std::shared_mutex> const lock(m_cellsMutex);
   const auto generation_value =
       m_generation.fetch_add(1ULL, std::memory_order_relaxed);
-  return JobPayload{m_width, m_height, m_tile_size,
-                    m_cells, sources,  generation_value};
+
+  // Diff against the discs of the previous job: a source contributes work
+  // only when it crossed a cell boundary, changed range, appeared, or died.
+  std::vector<VisionSource> removed;
+  std::vector<VisionSource> added;
+  std::unordered_map<std::uint32_t, VisionSource> current;
+  current.reserve(sources.size());
+  for (const auto &source : sources) {
+    current.emplace(source.id, source);
+    const auto it = m_lastSources.find(source.id);
+    if (it == m_lastSources.end()) {
+      added.push_back(source);
+    } else if (it->second.center_x != source.center_x ||
+               it->second.center_z != source.center_z ||
+               it->second.cell_radius != source.cell_radius ||
+               it->second.expanded_range_sq != source.expanded_range_sq) {
+      removed.push_back(it->second);
+      added.push_back(source);
+    }
+  }
+  for (const auto &[id, source] : m_lastSources) {
+    if (current.find(id) == current.end()) {
+      removed.push_back(source);
+    }
+  }
+  m_lastSources = std::move(current);
+
+  std::shared_lock<std::shared_mutex> const lock(m_cellsMutex);
+  return JobPayload{m_width,
+                    m_height,
+                    m_tile_size,
+                    m_cells,
+                    std::move(m_refCounts),
+                    std::move(removed),
+                    std::move(added),
+                    generation_value};
 }
 
 void VisibilityService::startAsyncJob(JobPayload &&payload) {
@@ -181,11 +243,14 @@ auto VisibilityService::integrateCompletedJob() -> bool {
 
   auto result = m_pendingJob.get();
   m_jobActive.store(false, std::memory_order_release);
+  m_refCounts = std::move(result.refCounts);
 
   if (result.changed) {
     std::unique_lock<std::shared_mutex> const lock(m_cellsMutex);
     m_cells = std::move(result.cells);
-    m_version.fetch_add(1, std::memory_order_release);
+    const auto new_version =
+        m_version.fetch_add(1, std::memory_order_release) + 1;
+    recordDelta(new_version, result.changedCells);
     return true;
   }
 
@@ -194,52 +259,329 @@ auto VisibilityService::integrateCompletedJob() -> bool {
 
 auto VisibilityService::executeJob(JobPayload payload)
     -> VisibilityService::JobResult {
-  const int cell_count = payload.width * payload.height;
-  std::vector<std::uint8_t> current_visible(cell_count, 0U);
-
-  for (const auto &source : payload.sources) {
+  constexpr auto visible_val = static_cast<std::uint8_t>(VisibilityState::Visible);
+  constexpr auto explored_val =
+      static_cast<std::uint8_t>(VisibilityState::Explored);
+  bool changed = false;
+  std::vector<int> changed_cells;
+
+  // Cell states follow the reference counts: a cell turns Visible when its
+  // count leaves zero and falls back to Explored when it returns to zero,
+  // so no full-grid rescan is needed. Each row's covered span is solved
+  // analytically from the circle equation, so the inner loop is a branch-
+  // free sweep over contiguous cells instead of a per-cell distance test.
+  const float inv_tile = 1.0F / payload.tile_size;
+  const auto sweep_disc = [&](const VisionSource &source, bool add) {
     for (int dz = -source.cell_radius; dz <= source.cell_radius; ++dz) {
       const int grid_z = source.center_z + dz;
-      if (!inBoundsStatic(source.center_x, grid_z, payload.width,
-                          payload.height)) {
+      if (grid_z < 0 || grid_z >= payload.height) {
         continue;
       }
       const float world_dz = static_cast<float>(dz) * payload.tile_size;
-      for (int dx = -source.cell_radius; dx <= source.cell_radius; ++dx) {
-        const int grid_x = source.center_x + dx;
-        if (!inBoundsStatic(grid_x, grid_z, payload.width, payload.height)) {
-          continue;
+      const float rem_sq = source.expanded_range_sq - world_dz * world_dz;
+      if (rem_sq < 0.0F) {
+        continue;
+      }
+      const int span = std::min(
+          source.cell_radius, static_cast<int>(std::sqrt(rem_sq) * inv_tile));
+      const int first_x = std::max(0, source.center_x - span);
+      const int last_x = std::min(payload.width - 1, source.center_x + span);
+      const int row = grid_z * payload.width;
+      for (int grid_x = first_x; grid_x <= last_x; ++grid_x) {
+        const int idx = row + grid_x;
+        auto &refs = payload.refCounts[idx];
+        if (add) {
+          if (refs++ == 0U && payload.cells[idx] != visible_val) {
+            payload.cells[idx] = visible_val;
+            changed = true;
+            changed_cells.push_back(idx);
+          }
+        } else if (refs > 0U && --refs == 0U &&
+                   payload.cells[idx] == visible_val) {
+          payload.cells[idx] = explored_val;
+          changed = true;
+          changed_cells.push_back(idx);
         }
-        const float world_dx = static_cast<float>(dx) * payload.tile_size;
-        const float dist_sq = world_dx * world_dx + world_dz * world_dz;
-        if (dist_sq <= source.expanded_range_sq) {
-          const int idx = indexStatic(grid_x, grid_z, payload.width);
-          current_visible[idx] = 1U;
+      }
+    }
+  };
+
+  // Vacated discs first, so the overlap of a moved source's old and new
+  // discs settles back to Visible when the new disc is applied.
+  for (const auto &source : payload.removed) {
+    sweep_disc(source, false);
+  }
+  for (const auto &source : payload.added) {
+    sweep_disc(source, true);
+  }
+
+  return JobResult{std::move(payload.cells), std::move(payload.refCounts),
+                   std::move(changed_cells), payload.generation, changed};
+}
+
+void VisibilityService::recordDelta(std::uint64_t version,
+                                    std::vector<int> &changedCells) {
+  std::sort(changedCells.begin(), changedCells.end());
+  changedCells.erase(std::unique(changedCells.begin(), changedCells.end()),
+                     changedCells.end());
+
+  VersionDelta delta;
+  delta.version = version;
+  for (const int idx : changedCells) {
+    if (!delta.runs.empty() &&
+        delta.runs.back().start + delta.runs.back().count == idx) {
+      ++delta.runs.back().count;
+    } else {
+      delta.runs.push_back({idx, 1});
+    }
+  }
+  m_deltaHistory.push_back(std::move(delta));
+  while (m_deltaHistory.size() > k_delta_history_limit) {
+    m_deltaHistory.pop_front();
+  }
+
+  for (const int idx : changedCells) {
+    propagateMipCell(idx % m_width, idx / m_width);
+  }
+}
+
+void VisibilityService::rebuildMipPyramid() {
+  m_mipLevels.clear();
+  m_mipWidths.clear();
+  m_mipHeights.clear();
+
+  const std::vector<std::uint8_t> *below = &m_cells;
+  int below_w = m_width;
+  int below_h = m_height;
+  while (below_w > 1 || below_h > 1) {
+    const int level_w = (below_w + 1) / 2;
+    const int level_h = (below_h + 1) / 2;
+    std::vector<std::uint8_t> level(
+        static_cast<std::size_t>(level_w) * level_h, 0U);
+    for (int z = 0; z < level_h; ++z) {
+      for (int x = 0; x < level_w; ++x) {
+        std::uint8_t value = 0U;
+        for (int dz = 0; dz < 2; ++dz) {
+          const int child_z = z * 2 + dz;
+          if (child_z >= below_h) {
+            continue;
+          }
+          for (int dx = 0; dx < 2; ++dx) {
+            const int child_x = x * 2 + dx;
+            if (child_x >= below_w) {
+              continue;
+            }
+            value = std::max(value, (*below)[child_z * below_w + child_x]);
+          }
         }
+        level[z * level_w + x] = value;
       }
     }
+    m_mipLevels.push_back(std::move(level));
+    m_mipWidths.push_back(level_w);
+    m_mipHeights.push_back(level_h);
+    below = &m_mipLevels.back();
+    below_w = level_w;
+    below_h = level_h;
   }
+}
 
-  bool changed = false;
-  for (int idx = 0; idx < cell_count; ++idx) {
-    const std::uint8_t now_visible = current_visible[idx];
-    const auto visible_val =
-        static_cast<std::uint8_t>(VisibilityState::Visible);
-    const auto explored_val =
-        static_cast<std::uint8_t>(VisibilityState::Explored);
-
-    if (now_visible != 0U) {
-      if (payload.cells[idx] != visible_val) {
-        payload.cells[idx] = visible_val;
-        changed = true;
+void VisibilityService::propagateMipCell(int grid_x, int grid_z) {
+  const std::vector<std::uint8_t> *below = &m_cells;
+  int below_w = m_width;
+  int below_h = m_height;
+  int cell_x = grid_x;
+  int cell_z = grid_z;
+
+  for (std::size_t level = 0; level < m_mipLevels.size(); ++level) {
+    cell_x /= 2;
+    cell_z /= 2;
+    std::uint8_t value = 0U;
+    for (int dz = 0; dz < 2; ++dz) {
+      const int child_z = cell_z * 2 + dz;
+      if (child_z >= below_h) {
+        continue;
+      }
+      for (int dx = 0; dx < 2; ++dx) {
+        const int child_x = cell_x * 2 + dx;
+        if (child_x >= below_w) {
+          continue;
+        }
+        value = std::max(value, (*below)[child_z * below_w + child_x]);
+      }
+    }
+    auto &slot = m_mipLevels[level][cell_z * m_mipWidths[level] + cell_x];
+    if (slot == value) {
+      break;
+    }
+    slot = value;
+    below = &m_mipLevels[level];
+    below_w = m_mipWidths[level];
+    below_h = m_mipHeights[level];
+  }
+}
+
+auto VisibilityService::queryMipMax(int level, int cell_x, int cell_z,
+                                    int min_x, int min_z, int max_x,
+                                    int max_z) const -> std::uint8_t {
+  // A cell at stored level L covers a (2^(L+1))^2 block of base cells.
+  const int shift = level + 1;
+  const int cover_min_x = cell_x << shift;
+  const int cover_min_z = cell_z << shift;
+  const int cover_max_x = cover_min_x + (1 << shift) - 1;
+  const int cover_max_z = cover_min_z + (1 << shift) - 1;
+
+  if (cover_min_x > max_x || cover_max_x < min_x || cover_min_z > max_z ||
+      cover_max_z < min_z) {
+    return 0U;
+  }
+
+  const std::uint8_t value =
+      m_mipLevels[level][cell_z * m_mipWidths[level] + cell_x];
+  if (cover_min_x >= min_x && cover_max_x <= max_x && cover_min_z >= min_z &&
+      cover_max_z <= max_z) {
+    return value;
+  }
+  if (value == 0U) {
+    return 0U;
+  }
+
+  if (level == 0) {
+    std::uint8_t result = 0U;
+    const int first_x = std::max(cover_min_x, min_x);
+    const int last_x = std::min({cover_max_x, max_x, m_width - 1});
+    const int first_z = std::max(cover_min_z, min_z);
+    const int last_z = std::min({cover_max_z, max_z, m_height - 1});
+    for (int z = first_z; z <= last_z; ++z) {
+      for (int x = first_x; x <= last_x; ++x) {
+        result = std::max(result, m_cells[z * m_width + x]);
+      }
+    }
+    return result;
+  }
+
+  std::uint8_t result = 0U;
+  for (int dz = 0; dz < 2; ++dz) {
+    const int child_z = cell_z * 2 + dz;
+    if (child_z >= m_mipHeights[level - 1]) {
+      continue;
+    }
+    for (int dx = 0; dx < 2; ++dx) {
+      const int child_x = cell_x * 2 + dx;
+      if (child_x >= m_mipWidths[level - 1]) {
+        continue;
+      }
+      result = std::max(result, queryMipMax(level - 1, child_x, child_z, min_x,
+                                            min_z, max_x, max_z));
+    }
+  }
+  return result;
+}
+
+auto VisibilityService::maxStateInArea(int min_x, int min_z, int max_x,
+                                       int max_z) const -> VisibilityState {
+  if (!m_initialized) {
+    return VisibilityState::Visible;
+  }
+  std::shared_lock<std::shared_mutex> const lock(m_cellsMutex);
+  min_x = std::max(0, min_x);
+  min_z = std::max(0, min_z);
+  max_x = std::min(m_width - 1, max_x);
+  max_z = std::min(m_height - 1, max_z);
+  if (min_x > max_x || min_z > max_z) {
+    return VisibilityState::Unseen;
+  }
+
+  if (m_mipLevels.empty()) {
+    std::uint8_t result = 0U;
+    for (int z = min_z; z <= max_z; ++z) {
+      for (int x = min_x; x <= max_x; ++x) {
+        result = std::max(result, m_cells[z * m_width + x]);
       }
-    } else if (payload.cells[idx] == visible_val) {
-      payload.cells[idx] = explored_val;
-      changed = true;
+    }
+    return static_cast<VisibilityState>(result);
+  }
+
+  const int top = static_cast<int>(m_mipLevels.size()) - 1;
+  const int shift = top + 1;
+  std::uint8_t result = 0U;
+  for (int cz = min_z >> shift; cz <= (max_z >> shift); ++cz) {
+    for (int cx = min_x >> shift; cx <= (max_x >> shift); ++cx) {
+      result = std::max(
+          result, queryMipMax(top, cx, cz, min_x, min_z, max_x, max_z));
     }
   }
+  return static_cast<VisibilityState>(result);
+}
 
-  return JobResult{std::move(payload.cells), payload.generation, changed};
+auto VisibilityService::isAreaExploredWorld(float min_x, float min_z,
+                                            float max_x,
+                                            float max_z) const -> bool {
+  if (!m_initialized) {
+    return true;
+  }
+  const int grid_min_x = worldToGrid(std::min(min_x, max_x), m_half_width);
+  const int grid_max_x = worldToGrid(std::max(min_x, max_x), m_half_width);
+  const int grid_min_z = worldToGrid(std::min(min_z, max_z), m_half_height);
+  const int grid_max_z = worldToGrid(std::max(min_z, max_z), m_half_height);
+  return maxStateInArea(grid_min_x, grid_min_z, grid_max_x, grid_max_z) !=
+         VisibilityState::Unseen;
+}
+
+auto VisibilityService::isAreaVisibleWorld(float min_x, float min_z,
+                                           float max_x,
+                                           float max_z) const -> bool {
+  if (!m_initialized) {
+    return true;
+  }
+  const int grid_min_x = worldToGrid(std::min(min_x, max_x), m_half_width);
+  const int grid_max_x = worldToGrid(std::max(min_x, max_x), m_half_width);
+  const int grid_min_z = worldToGrid(std::min(min_z, max_z), m_half_height);
+  const int grid_max_z = worldToGrid(std::max(min_z, max_z), m_half_height);
+  return maxStateInArea(grid_min_x, grid_min_z, grid_max_x, grid_max_z) ==
+         VisibilityState::Visible;
+}
+
+auto VisibilityService::applyChangesSince(
+    std::uint64_t sinceVersion, std::vector<std::uint8_t> &cells,
+    int &firstChanged, int &lastChanged,
+    std::vector<std::pair<int, int>> *changedRuns) const -> bool {
+  firstChanged = -1;
+  lastChanged = -1;
+
+  std::shared_lock<std::shared_mutex> const lock(m_cellsMutex);
+  if (cells.size() != m_cells.size()) {
+    return false;
+  }
+  const auto current = m_version.load(std::memory_order_relaxed);
+  if (sinceVersion == current) {
+    return true;
+  }
+  // The window must cover every bump in (sinceVersion, current]; reset and
+  // initialize clear the history, which correctly forces the fallback.
+  if (sinceVersion > current || m_deltaHistory.empty() ||
+      m_deltaHistory.front().version > sinceVersion + 1 ||
+      m_deltaHistory.back().version != current) {
+    return false;
+  }
+
+  for (const auto &delta : m_deltaHistory) {
+    if (delta.version <= sinceVersion) {
+      continue;
+    }
+    for (const auto &run : delta.runs) {
+      std::copy_n(m_cells.begin() + run.start, run.count,
+                  cells.begin() + run.start);
+      if (firstChanged < 0 || run.start < firstChanged) {
+        firstChanged = run.start;
+      }
+      lastChanged = std::max(lastChanged, run.start + run.count - 1);
+      if (changedRuns != nullptr) {
+        changedRuns->emplace_back(run.start, run.count);
+      }
+    }
+  }
+  return true;
 }
 
 auto VisibilityService::stateAt(int grid_x,
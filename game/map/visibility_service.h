@@ -1,10 +1,14 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <cstdint>
+#include <deque>
 #include <future>
 #include <mutex>
 #include <shared_mutex>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace Engine::Core {
@@ -38,7 +42,44 @@ public:
   auto isVisibleWorld(float world_x, float world_z) const -> bool;
   auto isExploredWorld(float world_x, float world_z) const -> bool;
 
+  // Max state over an inclusive cell rectangle, resolved through the mip
+  // pyramid in O(log n) instead of sampling every cell. Unseen means no
+  // cell in the area has ever been revealed.
+  auto maxStateInArea(int min_x, int min_z, int max_x,
+                      int max_z) const -> VisibilityState;
+  // True when any cell of the world-space rectangle is explored or
+  // visible; AI scouting uses the negation to find dark regions.
+  auto isAreaExploredWorld(float min_x, float min_z, float max_x,
+                           float max_z) const -> bool;
+  // True when any cell of the world-space rectangle is currently visible;
+  // vegetation culling uses this to drop fully fogged cells.
+  auto isAreaVisibleWorld(float min_x, float min_z, float max_x,
+                          float max_z) const -> bool;
+
   auto snapshotCells() const -> std::vector<std::uint8_t>;
+
+  // Patches `cells` (a caller-tracked full-size copy) with the cell runs
+  // that changed after sinceVersion, writing current values, and reports
+  // the patched index range through firstChanged/lastChanged (-1 when
+  // nothing changed). When changedRuns is non-null every patched
+  // (start, count) run is appended to it, so consumers can aggregate the
+  // delta at their own granularity instead of re-walking the index range.
+  // Returns false when the delta history no longer covers sinceVersion or
+  // the buffer size does not match — the caller must fall back to
+  // snapshotCells().
+  auto applyChangesSince(std::uint64_t sinceVersion,
+                         std::vector<std::uint8_t> &cells, int &firstChanged,
+                         int &lastChanged,
+                         std::vector<std::pair<int, int>> *changedRuns =
+                             nullptr) const -> bool;
+
+  // World-space vision sources (x, z, range, 0) from the most recent
+  // gather, for the GPU fog mask. Refreshed on the same thread that calls
+  // update()/computeImmediate().
+  [[nodiscard]] auto snapshotVisionSourcesWorld() const
+      -> const std::vector<std::array<float, 4>> & {
+    return m_worldSources;
+  }
   auto version() const -> std::uint64_t {
     return m_version.load(std::memory_order_relaxed);
   }
@@ -49,34 +90,61 @@ private:
   auto worldToGrid(float world_coord, float half) const -> int;
 
   struct VisionSource {
+    std::uint32_t id;
     int center_x;
     int center_z;
     int cell_radius;
     float expanded_range_sq;
   };
 
+  // A job only carries the discs that changed since the previous one
+  // (sources that moved a cell, appeared, or disappeared) plus the
+  // reference-counted visible grid, so its cost scales with movement
+  // instead of army size.
   struct JobPayload {
     int width;
     int height;
     float tile_size;
     std::vector<std::uint8_t> cells;
-    std::vector<VisionSource> sources;
+    std::vector<std::uint16_t> refCounts;
+    std::vector<VisionSource> removed;
+    std::vector<VisionSource> added;
     std::uint64_t generation;
   };
 
   struct JobResult {
     std::vector<std::uint8_t> cells;
+    std::vector<std::uint16_t> refCounts;
+    std::vector<int> changedCells;
     std::uint64_t generation;
     bool changed;
   };
 
+  // Contiguous row-major run of cells that changed in one version bump.
+  struct CellRun {
+    int start = 0;
+    int count = 0;
+  };
+
+  struct VersionDelta {
+    std::uint64_t version = 0;
+    std::vector<CellRun> runs;
+  };
+
   auto gatherVisionSources(Engine::Core::World &world,
-                           int player_id) const -> std::vector<VisionSource>;
-  auto composeJobPayload(const std::vector<VisionSource> &sources) const
+                           int player_id) -> std::vector<VisionSource>;
+  auto composeJobPayload(const std::vector<VisionSource> &sources)
       -> JobPayload;
   void startAsyncJob(JobPayload &&payload);
   auto integrateCompletedJob() -> bool;
   static auto executeJob(JobPayload payload) -> JobResult;
+  // Must be called with m_cellsMutex held exclusively.
+  void recordDelta(std::uint64_t version, std::vector<int> &changedCells);
+  // Pyramid maintenance; both require m_cellsMutex held exclusively.
+  void rebuildMipPyramid();
+  void propagateMipCell(int grid_x, int grid_z);
+  auto queryMipMax(int level, int cell_x, int cell_z, int min_x, int min_z,
+                   int max_x, int max_z) const -> std::uint8_t;
 
   VisibilityService() = default;
 
@@ -89,6 +157,24 @@ private:
 
   mutable std::shared_mutex m_cellsMutex;
   std::vector<std::uint8_t> m_cells;
+  // How many live sources currently reveal each cell, and the disc each
+  // source revealed last job. Both are only touched while no job is in
+  // flight (the refcount grid travels with the job), so they need no lock.
+  std::vector<std::uint16_t> m_refCounts;
+  std::unordered_map<std::uint32_t, VisionSource> m_lastSources;
+  std::vector<std::array<float, 4>> m_worldSources;
+  // Alliance of the player the grid is computed for, resolved once per
+  // source gather; scratch reused across updates.
+  std::vector<int> m_alliedOwners;
+  // Bounded window of per-version change runs; consumers more than one
+  // window behind take the snapshotCells() fallback.
+  std::deque<VersionDelta> m_deltaHistory;
+  // Max-reduction pyramid: level 0 is half the base resolution, each cell
+  // holding the max state of its 2x2 children; updated incrementally from
+  // the per-version change sets.
+  std::vector<std::vector<std::uint8_t>> m_mipLevels;
+  std::vector<int> m_mipWidths;
+  std::vector<int> m_mipHeights;
   std::atomic<std::uint64_t> m_version{0};
   mutable std::atomic<std::uint64_t> m_generation{0};
   std::future<JobResult> m_pendingJob;
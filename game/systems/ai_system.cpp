@@ -1,4 +1,6 @@
 #include "ai_system.h"
+#include "../core/alloc_tracker.h"
+#include "../core/frame_governor.h"
 #include "../core/world.h"
 #include "ai_system/behaviors/attack_behavior.h"
 #include "ai_system/behaviors/defend_behavior.h"
@@ -9,11 +11,23 @@
 #include "owner_registry.h"
 #include "systems/ai_system/ai_types.h"
 #include "systems/ai_system/ai_worker.h"
+#include <QElapsedTimer>
 #include <cstdint>
 #include <memory>
 #include <queue>
 #include <utility>
 
+namespace {
+
+// Cadence of one AI think per instance, and the per-frame allowance for
+// the sim-thread half of AI work (snapshot build, job submit and command
+// application). The worker threads do the actual reasoning, so this caps
+// what a frame can lose to AI bookkeeping.
+constexpr float k_ai_update_interval = 0.3F;
+constexpr long long k_frame_budget_us = 500;
+
+} // namespace
+
 namespace Game::Systems {
 
 AISystem::AISystem() {
@@ -40,6 +54,7 @@ AISystem::AISystem() {
 
 void AISystem::reinitialize() {
   m_aiInstances.clear();
+  m_snapshotBuilder.invalidate();
 
   initializeAIPlayers();
 }
@@ -52,6 +67,8 @@ void AISystem::initializeAIPlayers() {
     return;
   }
 
+  const auto player_count = ai_owner_ids.size();
+  std::size_t player_index = 0;
   for (uint32_t const player_id : ai_owner_ids) {
     int const team_id = registry.getOwnerTeam(player_id);
     AIInstance instance;
@@ -60,6 +77,13 @@ void AISystem::initializeAIPlayers() {
     instance.worker = std::make_unique<AI::AIWorker>(m_reasoner, m_executor,
                                                      m_behaviorRegistry);
 
+    // Phase the timers so the players come due on different frames
+    // instead of all building snapshots in the same tick.
+    instance.updateTimer = k_ai_update_interval *
+                           static_cast<float>(player_index) /
+                           static_cast<float>(player_count);
+    ++player_index;
+
     m_aiInstances.push_back(std::move(instance));
   }
 }
@@ -70,18 +94,34 @@ void AISystem::update(Engine::Core::World *world, float deltaTime) {
   if (world == nullptr) {
     return;
   }
+  Engine::Core::AllocTagScope const alloc_tag(Engine::Core::AllocTag::Ai);
 
   m_totalGameTime += deltaTime;
 
   m_commandFilter.update(m_totalGameTime);
 
-  processResults(*world);
+  // Fixed per-frame allowance minus last frame's overshoot; an expensive
+  // item may run over, but the overrun is paid back before more work is
+  // scheduled. Timers keep accruing on skipped instances, so think
+  // cadence is preserved and no sim time is lost.
+  QElapsedTimer budget_timer;
+  budget_timer.start();
+  const long long budget_us = k_frame_budget_us - m_budgetCarryUs;
+
+  processResults(*world, budget_us, budget_timer);
+
+  // Under frame pressure the governor stretches the think interval; the
+  // timers keep accumulating, so postponed thinks run with the full elapsed
+  // deltaTime once submitted and no decision time is lost.
+  const float think_interval =
+      k_ai_update_interval *
+      Engine::Core::FrameGovernor::instance().aiIntervalScale();
 
   for (auto &ai : m_aiInstances) {
 
     ai.updateTimer += deltaTime;
 
-    if (ai.updateTimer < 0.3F) {
+    if (ai.updateTimer < think_interval) {
       continue;
     }
 
@@ -89,6 +129,10 @@ void AISystem::update(Engine::Core::World *world, float deltaTime) {
       continue;
     }
 
+    if (budget_timer.nsecsElapsed() / 1000 >= budget_us) {
+      continue;
+    }
+
     AI::AISnapshot snapshot =
         m_snapshotBuilder.build(*world, ai.context.player_id);
     snapshot.gameTime = m_totalGameTime;
@@ -102,17 +146,24 @@ void AISystem::update(Engine::Core::World *world, float deltaTime) {
       ai.updateTimer = 0.0F;
     }
   }
+
+  const long long spent_us = budget_timer.nsecsElapsed() / 1000;
+  m_budgetCarryUs = spent_us > budget_us ? spent_us - budget_us : 0;
 }
 
-void AISystem::processResults(Engine::Core::World &world) {
+void AISystem::processResults(Engine::Core::World &world, long long budget_us,
+                              const QElapsedTimer &timer) {
 
   for (auto &ai : m_aiInstances) {
 
-    std::queue<AI::AIResult> results;
-    ai.worker->drainResults(results);
+    ai.worker->drainResults(ai.pendingResults);
+
+    while (!ai.pendingResults.empty()) {
+      if (timer.nsecsElapsed() / 1000 >= budget_us) {
+        return;
+      }
 
-    while (!results.empty()) {
-      auto &result = results.front();
+      auto &result = ai.pendingResults.front();
 
       ai.context = result.context;
 
@@ -121,7 +172,7 @@ void AISystem::processResults(Engine::Core::World &world) {
 
       m_applier.apply(world, ai.context.player_id, filtered_commands);
 
-      results.pop();
+      ai.pendingResults.pop();
     }
   }
 }
@@ -14,6 +14,8 @@
 #include <memory>
 #include <queue>
 
+class QElapsedTimer;
+
 namespace Engine::Core {
 class World;
 }
@@ -26,6 +28,9 @@ public:
   ~AISystem() override;
 
   void update(Engine::Core::World *world, float deltaTime) override;
+  [[nodiscard]] auto name() const -> const char * override {
+    return "AISystem";
+  }
 
   void reinitialize();
 
@@ -34,6 +39,9 @@ private:
     AI::AIContext context;
     std::unique_ptr<AI::AIWorker> worker;
     float updateTimer = 0.0F;
+    // Results drained from the worker but not yet applied because the
+    // frame budget ran out; applied first on later frames.
+    std::queue<AI::AIResult> pendingResults;
   };
 
   std::vector<AIInstance> m_aiInstances;
@@ -46,13 +54,17 @@ private:
   AI::AICommandFilter m_commandFilter;
 
   float m_totalGameTime = 0.0F;
+  // Budget overshoot from the previous frame, deducted from the next
+  // frame's allowance so one expensive item cannot repeat back-to-back.
+  long long m_budgetCarryUs = 0;
 
   Engine::Core::ScopedEventSubscription<Engine::Core::BuildingAttackedEvent>
       m_buildingAttackedSubscription;
 
   void initializeAIPlayers();
 
-  void processResults(Engine::Core::World &world);
+  void processResults(Engine::Core::World &world, long long budget_us,
+                      const QElapsedTimer &timer);
 
   void onBuildingAttacked(const Engine::Core::BuildingAttackedEvent &event);
 };
@@ -4,20 +4,83 @@
 #include "../../game_config.h"
 #include "../../units/troop_config.h"
 #include "../command_service.h"
+#include "../production_service.h"
+#include "../replay_service.h"
 #include "ai_utils.h"
 #include "systems/ai_system/ai_types.h"
 #include "units/troop_type.h"
 
+#include <QString>
 #include <QVector3D>
 #include <cstddef>
 #include <qvectornd.h>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace Game::Systems::AI {
 
+namespace {
+
+// Resolves each entity once per batch; commands from different behaviors
+// frequently reference the same units within a tick.
+class OwnershipCache {
+public:
+  OwnershipCache(Engine::Core::World &world, int ownerId)
+      : m_world(world), m_ownerId(ownerId) {}
+
+  auto isOwnedUnit(Engine::Core::EntityID entity_id) -> bool {
+    auto found = m_cache.find(entity_id);
+    if (found != m_cache.end()) {
+      return found->second;
+    }
+
+    bool owned = false;
+    const auto *entity = m_world.getEntity(entity_id);
+    if (entity != nullptr) {
+      const auto *unit = entity->getComponent<Engine::Core::UnitComponent>();
+      owned = (unit != nullptr) && unit->owner_id == m_ownerId;
+    }
+    m_cache.emplace(entity_id, owned);
+    return owned;
+  }
+
+private:
+  Engine::Core::World &m_world;
+  int m_ownerId;
+  std::unordered_map<Engine::Core::EntityID, bool> m_cache;
+};
+
+} // namespace
+
 void AICommandApplier::apply(Engine::Core::World &world, int aiOwnerId,
                              const std::vector<AICommand> &commands) {
 
+  auto &replay = ReplayService::instance();
+  if (replay.isPlaybackActive()) {
+    // The replay log already carries this session's AI commands; issuing
+    // live ones on top would double them.
+    return;
+  }
+
+  OwnershipCache ownership(world, aiOwnerId);
+
+  // Move orders from every command merge into one CommandService call so
+  // groups headed for the same destination can share a flow field instead
+  // of issuing per-command path requests. When a unit appears in several
+  // move commands the later one wins, matching sequential application.
+  std::vector<Engine::Core::EntityID> move_units;
+  std::vector<QVector3D> move_targets;
+  std::unordered_map<Engine::Core::EntityID, std::size_t> move_slot;
+
+  struct AttackGroup {
+    std::vector<Engine::Core::EntityID> units;
+    bool shouldChase = true;
+  };
+  std::vector<std::pair<Engine::Core::EntityID, AttackGroup>> attack_groups;
+
+  std::vector<const AICommand *> production_commands;
+
   for (const auto &command : commands) {
     switch (command.type) {
 
@@ -44,37 +107,24 @@ void AICommandApplier::apply(Engine::Core::World &world, int aiOwnerId,
         break;
       }
 
-      std::vector<Engine::Core::EntityID> owned_units;
-      std::vector<QVector3D> owned_targets;
-      owned_units.reserve(command.units.size());
-      owned_targets.reserve(command.units.size());
-
       for (std::size_t idx = 0; idx < command.units.size(); ++idx) {
         auto entity_id = command.units[idx];
-        auto *entity = world.getEntity(entity_id);
-        if (entity == nullptr) {
+        if (!ownership.isOwnedUnit(entity_id)) {
           continue;
         }
 
-        auto *unit = entity->getComponent<Engine::Core::UnitComponent>();
-        if ((unit == nullptr) || unit->owner_id != aiOwnerId) {
+        QVector3D const target(expanded_x[idx], expanded_y[idx],
+                               expanded_z[idx]);
+        auto slot = move_slot.find(entity_id);
+        if (slot != move_slot.end()) {
+          move_targets[slot->second] = target;
           continue;
         }
 
-        owned_units.push_back(entity_id);
-        owned_targets.emplace_back(expanded_x[idx], expanded_y[idx],
-                                   expanded_z[idx]);
+        move_slot.emplace(entity_id, move_units.size());
+        move_units.push_back(entity_id);
+        move_targets.push_back(target);
       }
-
-      if (owned_units.empty()) {
-        break;
-      }
-
-      CommandService::MoveOptions opts;
-      opts.allowDirectFallback = true;
-      opts.clearAttackIntent = false;
-      opts.groupMove = owned_units.size() > 1;
-      CommandService::moveUnits(world, owned_units, owned_targets, opts);
       break;
     }
 
@@ -83,73 +133,95 @@ void AICommandApplier::apply(Engine::Core::World &world, int aiOwnerId,
         break;
       }
 
-      std::vector<Engine::Core::EntityID> owned_units;
-      owned_units.reserve(command.units.size());
-
-      for (auto entity_id : command.units) {
-        auto *entity = world.getEntity(entity_id);
-        if (entity == nullptr) {
-          continue;
+      AttackGroup *group = nullptr;
+      for (auto &[target_id, existing] : attack_groups) {
+        if (target_id == command.target_id &&
+            existing.shouldChase == command.shouldChase) {
+          group = &existing;
+          break;
         }
-
-        auto *unit = entity->getComponent<Engine::Core::UnitComponent>();
-        if ((unit == nullptr) || unit->owner_id != aiOwnerId) {
-          continue;
-        }
-
-        owned_units.push_back(entity_id);
       }
-
-      if (owned_units.empty()) {
-        break;
+      if (group == nullptr) {
+        attack_groups.emplace_back(command.target_id, AttackGroup{});
+        group = &attack_groups.back().second;
+        group->shouldChase = command.shouldChase;
       }
 
-      CommandService::attack_target(world, owned_units, command.target_id,
-                                    command.shouldChase);
+      for (auto entity_id : command.units) {
+        if (ownership.isOwnedUnit(entity_id)) {
+          group->units.push_back(entity_id);
+        }
+      }
       break;
     }
 
-    case AICommandType::StartProduction: {
-      auto *entity = world.getEntity(command.buildingId);
-      if (entity == nullptr) {
-        break;
-      }
+    case AICommandType::StartProduction:
+      production_commands.push_back(&command);
+      break;
+    }
+  }
 
-      auto *production =
-          entity->getComponent<Engine::Core::ProductionComponent>();
-      if (production == nullptr) {
-        break;
-      }
+  if (!move_units.empty()) {
+    CommandService::MoveOptions opts;
+    opts.allowDirectFallback = true;
+    opts.clearAttackIntent = false;
+    opts.groupMove = move_units.size() > 1;
+    opts.backgroundPriority = true;
+    CommandService::moveUnits(world, move_units, move_targets, opts);
+  }
 
-      if (production->inProgress) {
-        break;
-      }
+  for (const auto &[target_id, group] : attack_groups) {
+    if (group.units.empty()) {
+      continue;
+    }
+    CommandService::attack_target(world, group.units, target_id,
+                                  group.shouldChase);
+  }
 
-      auto *unit = entity->getComponent<Engine::Core::UnitComponent>();
-      if ((unit != nullptr) && unit->owner_id != aiOwnerId) {
-        break;
-      }
+  if (production_commands.empty()) {
+    return;
+  }
 
-      int const current_troops =
-          Engine::Core::World::countTroopsForPlayer(aiOwnerId);
-      int const max_troops =
-          Game::GameConfig::instance().getMaxTroopsPerPlayer();
-      Game::Units::TroopType const product_type = production->product_type;
-      int const individuals_per_unit =
-          Game::Units::TroopConfig::instance().getIndividualsPerUnit(
-              product_type);
-      if (current_troops + individuals_per_unit > max_troops) {
-        break;
-      }
+  int projected_troops = Engine::Core::World::countTroopsForPlayer(aiOwnerId);
+  int const max_troops = Game::GameConfig::instance().getMaxTroopsPerPlayer();
 
-      production->product_type = command.product_type;
+  for (const auto *command : production_commands) {
+    auto *entity = world.getEntity(command->buildingId);
+    if (entity == nullptr) {
+      continue;
+    }
 
-      production->timeRemaining = production->buildTime;
-      production->inProgress = true;
+    auto *production =
+        entity->getComponent<Engine::Core::ProductionComponent>();
+    if (production == nullptr || production->inProgress) {
+      continue;
+    }
 
-      break;
+    auto *unit = entity->getComponent<Engine::Core::UnitComponent>();
+    if ((unit != nullptr) && unit->owner_id != aiOwnerId) {
+      continue;
     }
+
+    Game::Units::TroopType const product_type = production->product_type;
+    int const individuals_per_unit =
+        Game::Units::TroopConfig::instance().getIndividualsPerUnit(
+            product_type);
+    if (projected_troops + individuals_per_unit > max_troops) {
+      continue;
     }
+    projected_troops += individuals_per_unit;
+
+    production->product_type = command->product_type;
+
+    production->timeRemaining = production->buildTime;
+    production->inProgress = true;
+    ProductionService::scheduleCompletion(command->buildingId,
+                                          production->buildTime);
+
+    replay.recordAIProduction(command->buildingId,
+                              QString::fromStdString(
+                                  Game::Units::troop_typeToString(
+                                      command->product_type)));
   }
 }
 
@@ -17,6 +17,10 @@ public:
   AICommandApplier(const AICommandApplier &) = delete;
   auto operator=(const AICommandApplier &) -> AICommandApplier & = delete;
 
+  // Applies a whole per-tick command buffer in grouped passes: moves are
+  // merged into a single CommandService call (sharing flow fields between
+  // commands with a common destination), attacks are grouped per target,
+  // and production starts run last under one troop-cap budget.
   static void apply(Engine::Core::World &world, int aiOwnerId,
                     const std::vector<AICommand> &commands);
 };
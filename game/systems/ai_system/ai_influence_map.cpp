@@ -0,0 +1,170 @@
+#include "ai_influence_map.h"
+#include "../../map/visibility_service.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace Game::Systems::AI {
+
+namespace {
+
+// World units per influence cell; coarse on purpose, the field guides
+// squad-level decisions rather than per-unit micro.
+constexpr float k_cell_world_size = 4.0F;
+
+// Exponential decay rate of stale influence, per second of game time.
+constexpr float k_decay_rate = 1.2F;
+
+// 3x3 stamp kernel: full strength in the center cell, half in the ring.
+constexpr float k_ring_weight = 0.5F;
+
+auto healthWeight(int health, int max_health) -> float {
+  if (max_health <= 0) {
+    return 1.0F;
+  }
+  return static_cast<float>(health) / static_cast<float>(max_health);
+}
+
+} // namespace
+
+void InfluenceMap::rebuild(const AISnapshot &snapshot, float gameTime) {
+  auto &visibility = Game::Map::VisibilityService::instance();
+  if (!visibility.isInitialized()) {
+    m_width = 0;
+    m_height = 0;
+    return;
+  }
+
+  const float tile_size = visibility.getTileSize();
+  const float world_x = static_cast<float>(visibility.getWidth()) * tile_size;
+  const float world_z = static_cast<float>(visibility.getHeight()) * tile_size;
+  const int width =
+      std::max(1, static_cast<int>(std::ceil(world_x / k_cell_world_size)));
+  const int height =
+      std::max(1, static_cast<int>(std::ceil(world_z / k_cell_world_size)));
+
+  if (width != m_width || height != m_height) {
+    m_width = width;
+    m_height = height;
+    m_cell_size = k_cell_world_size;
+    m_half_world_x = world_x * 0.5F;
+    m_half_world_z = world_z * 0.5F;
+    m_threat.assign(static_cast<std::size_t>(width) * height, 0.0F);
+    m_friendly.assign(static_cast<std::size_t>(width) * height, 0.0F);
+    m_lastTime = gameTime;
+  }
+
+  // One decay factor for the whole tick; the loops are flat multiplies
+  // over contiguous floats so they vectorize.
+  const float dt = std::max(0.0F, gameTime - m_lastTime);
+  m_lastTime = gameTime;
+  const float decay = std::exp(-k_decay_rate * dt);
+  for (float &value : m_threat) {
+    value *= decay;
+  }
+  for (float &value : m_friendly) {
+    value *= decay;
+  }
+
+  for (const auto &enemy : snapshot.visibleEnemies) {
+    if (enemy.isBuilding) {
+      continue;
+    }
+    stamp(m_threat, enemy.posX, enemy.posZ,
+          healthWeight(enemy.health, enemy.max_health));
+  }
+
+  for (const auto &entity : snapshot.friendlies) {
+    if (entity.isBuilding) {
+      continue;
+    }
+    stamp(m_friendly, entity.posX, entity.posZ,
+          healthWeight(entity.health, entity.max_health));
+  }
+}
+
+auto InfluenceMap::cellAt(float world_x, float world_z) const -> int {
+  const int gx =
+      static_cast<int>(std::floor((world_x + m_half_world_x) / m_cell_size));
+  const int gz =
+      static_cast<int>(std::floor((world_z + m_half_world_z) / m_cell_size));
+  if (gx < 0 || gx >= m_width || gz < 0 || gz >= m_height) {
+    return -1;
+  }
+  return gz * m_width + gx;
+}
+
+void InfluenceMap::stamp(std::vector<float> &grid, float world_x,
+                         float world_z, float strength) {
+  const int gx =
+      static_cast<int>(std::floor((world_x + m_half_world_x) / m_cell_size));
+  const int gz =
+      static_cast<int>(std::floor((world_z + m_half_world_z) / m_cell_size));
+
+  for (int dz = -1; dz <= 1; ++dz) {
+    for (int dx = -1; dx <= 1; ++dx) {
+      const int cx = gx + dx;
+      const int cz = gz + dz;
+      if (cx < 0 || cx >= m_width || cz < 0 || cz >= m_height) {
+        continue;
+      }
+      const float weight =
+          (dx == 0 && dz == 0) ? 1.0F : k_ring_weight;
+      grid[static_cast<std::size_t>(cz) * m_width + cx] += strength * weight;
+    }
+  }
+}
+
+auto InfluenceMap::threatAt(float world_x, float world_z) const -> float {
+  const int index = cellAt(world_x, world_z);
+  return index >= 0 ? m_threat[static_cast<std::size_t>(index)] : 0.0F;
+}
+
+auto InfluenceMap::friendlyAt(float world_x, float world_z) const -> float {
+  const int index = cellAt(world_x, world_z);
+  return index >= 0 ? m_friendly[static_cast<std::size_t>(index)] : 0.0F;
+}
+
+auto InfluenceMap::findSafestNear(float world_x, float world_z,
+                                  float radius) const -> SafePoint {
+  SafePoint result;
+  if (m_width == 0) {
+    return result;
+  }
+
+  const int cell_radius = std::max(
+      1, static_cast<int>(std::ceil(radius / m_cell_size)));
+  const int center_x =
+      static_cast<int>(std::floor((world_x + m_half_world_x) / m_cell_size));
+  const int center_z =
+      static_cast<int>(std::floor((world_z + m_half_world_z) / m_cell_size));
+
+  float best_score = 0.0F;
+  for (int dz = -cell_radius; dz <= cell_radius; ++dz) {
+    for (int dx = -cell_radius; dx <= cell_radius; ++dx) {
+      const int cx = center_x + dx;
+      const int cz = center_z + dz;
+      if (cx < 0 || cx >= m_width || cz < 0 || cz >= m_height) {
+        continue;
+      }
+      const float threat =
+          m_threat[static_cast<std::size_t>(cz) * m_width + cx];
+      // Small distance term breaks ties toward nearby ground so units
+      // don't sprint across the map for a marginally calmer cell.
+      const float dist =
+          std::sqrt(static_cast<float>(dx * dx + dz * dz)) * m_cell_size;
+      const float score = threat + dist * 0.02F;
+      if (!result.found || score < best_score) {
+        best_score = score;
+        result.found = true;
+        result.x = (static_cast<float>(cx) + 0.5F) * m_cell_size -
+                   m_half_world_x;
+        result.z = (static_cast<float>(cz) + 0.5F) * m_cell_size -
+                   m_half_world_z;
+      }
+    }
+  }
+  return result;
+}
+
+} // namespace Game::Systems::AI
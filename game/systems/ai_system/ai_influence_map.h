@@ -0,0 +1,58 @@
+#pragma once
+
+#include "ai_types.h"
+#include <vector>
+
+namespace Game::Systems::AI {
+
+// Coarse per-player influence grid rebuilt once per AI tick on the worker
+// thread. Enemy and friendly strength from the snapshot are stamped with a
+// small falloff kernel, and the previous tick's field is decayed first so
+// recently vacated ground stays "warm" for a few seconds. Behaviors sample
+// the field O(1) instead of re-scanning the enemy list per decision point;
+// the decay runs as one flat multiply over the contiguous grid so the
+// compiler can vectorize it.
+class InfluenceMap {
+public:
+  struct SafePoint {
+    bool found = false;
+    float x = 0.0F;
+    float z = 0.0F;
+  };
+
+  // Decays the previous field toward zero based on elapsed game time,
+  // then stamps every live unit in the snapshot. Grid bounds come from
+  // the visibility service; before the map is configured the samplers
+  // return zero and initialized() stays false.
+  void rebuild(const AISnapshot &snapshot, float gameTime);
+
+  [[nodiscard]] auto initialized() const -> bool { return m_width > 0; }
+
+  // Health-weighted enemy strength around a world position.
+  [[nodiscard]] auto threatAt(float world_x, float world_z) const -> float;
+
+  // Health-weighted friendly strength around a world position.
+  [[nodiscard]] auto friendlyAt(float world_x, float world_z) const -> float;
+
+  // Lowest-threat cell center within radius of a world position,
+  // preferring cells close to the query point on equal threat.
+  [[nodiscard]] auto findSafestNear(float world_x, float world_z,
+                                    float radius) const -> SafePoint;
+
+private:
+  [[nodiscard]] auto cellAt(float world_x, float world_z) const -> int;
+  void stamp(std::vector<float> &grid, float world_x, float world_z,
+             float strength);
+
+  int m_width = 0;
+  int m_height = 0;
+  float m_cell_size = 1.0F;
+  float m_half_world_x = 0.0F;
+  float m_half_world_z = 0.0F;
+  float m_lastTime = -1.0F;
+
+  std::vector<float> m_threat;
+  std::vector<float> m_friendly;
+};
+
+} // namespace Game::Systems::AI
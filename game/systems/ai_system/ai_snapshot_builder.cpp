@@ -1,38 +1,176 @@
 #include "ai_snapshot_builder.h"
 #include "../../core/component.h"
 #include "../../core/world.h"
+#include "../command_service.h"
+#include "../pathfinding.h"
 #include "systems/ai_system/ai_types.h"
+#include <cstddef>
 #include <utility>
 
 namespace Game::Systems::AI {
 
-AISnapshot AISnapshotBuilder::build(const Engine::Core::World &world,
-                                    int aiOwnerId) {
-  AISnapshot snapshot;
+namespace {
+
+void refreshMovement(const Engine::Core::Entity &entity,
+                     MovementSnapshot &movement) {
+  const auto *component =
+      entity.getComponent<Engine::Core::MovementComponent>();
+  movement.hasComponent = component != nullptr;
+  movement.hasTarget = (component != nullptr) && component->hasTarget;
+}
+
+void refreshProduction(const Engine::Core::Entity &entity,
+                       ProductionSnapshot &production) {
+  const auto *component =
+      entity.getComponent<Engine::Core::ProductionComponent>();
+  if (component == nullptr) {
+    production = ProductionSnapshot{};
+    return;
+  }
+  production.hasComponent = true;
+  production.inProgress = component->inProgress;
+  production.buildTime = component->buildTime;
+  production.timeRemaining = component->timeRemaining;
+  production.producedCount = component->producedCount;
+  production.maxUnits = component->maxUnits;
+  production.product_type = component->product_type;
+  production.rallySet = component->rallySet;
+  production.rallyX = component->rallyX;
+  production.rallyZ = component->rallyZ;
+  production.queueSize = static_cast<int>(component->productionQueue.size());
+}
+
+} // namespace
+
+AISnapshotBuilder::AISnapshotBuilder() {
+  // Captures swap the owner on a live UnitComponent, which never reaches
+  // the change rings, so they stay event-driven.
+  m_captureSubscription = Engine::Core::ScopedEventSubscription<
+      Engine::Core::BarrackCapturedEvent>(
+      [this](const Engine::Core::BarrackCapturedEvent &) {
+        for (auto &[owner_id, mirror] : m_mirrors) {
+          mirror.valid = false;
+        }
+      });
+}
+
+void AISnapshotBuilder::drainUnitChanges(const Engine::Core::World &world) {
+  // Spawns and deaths land in the UnitComponent ring as add/remove
+  // records; any of them can change the entity set of every mirror
+  // (friendlies of one owner are contacts of the others), so all of
+  // them go stale together. An overflow means records were dropped
+  // unseen, which the full rebuild a stale mirror forces covers anyway.
+  bool changed = false;
+  const bool intact = world.changeRings().consume(
+      Engine::Core::componentTypeId<Engine::Core::UnitComponent>(),
+      m_unitCursor,
+      [&changed](const Engine::Core::ComponentChangeRings::Record &) {
+        changed = true;
+      });
+  if (!intact || changed) {
+    for (auto &[owner_id, mirror] : m_mirrors) {
+      mirror.valid = false;
+    }
+  }
+}
+
+auto AISnapshotBuilder::build(const Engine::Core::World &world,
+                              int aiOwnerId) -> AISnapshot {
+  drainUnitChanges(world);
+  OwnerMirror &mirror = m_mirrors[aiOwnerId];
+  if (mirror.valid) {
+    refresh(world, mirror);
+  } else {
+    rebuild(world, aiOwnerId, mirror);
+    mirror.valid = true;
+  }
+  // Cheap when the obstacle version is unchanged: the same shared copy
+  // is handed out again.
+  if (auto *pathfinder = CommandService::getPathfinder()) {
+    mirror.snapshot.walkability = pathfinder->walkabilitySnapshot();
+  }
+  return mirror.snapshot;
+}
+
+void AISnapshotBuilder::invalidate() { m_mirrors.clear(); }
+
+void AISnapshotBuilder::refresh(const Engine::Core::World &world,
+                                OwnerMirror &mirror) {
+  // Entity set is unchanged since the last event, so only the mutable
+  // fields move; dead or vanished entries are swap-removed inline
+  // (deaths published deferred can land a tick after the fact).
+  auto &friendlies = mirror.snapshot.friendlies;
+  for (std::size_t i = 0; i < friendlies.size();) {
+    auto &data = friendlies[i];
+    const auto *entity = world.getEntity(data.id);
+    const auto *unit =
+        entity != nullptr
+            ? entity->getComponent<Engine::Core::UnitComponent>()
+            : nullptr;
+    if (unit == nullptr || unit->health <= 0) {
+      data = std::move(friendlies.back());
+      friendlies.pop_back();
+      continue;
+    }
+
+    data.health = unit->health;
+    data.max_health = unit->max_health;
+    if (const auto *transform =
+            entity->getComponent<Engine::Core::TransformComponent>()) {
+      data.posX = transform->position.x;
+      data.posZ = transform->position.z;
+    }
+    refreshMovement(*entity, data.movement);
+    refreshProduction(*entity, data.production);
+    ++i;
+  }
+
+  auto &enemies = mirror.snapshot.visibleEnemies;
+  for (std::size_t i = 0; i < enemies.size();) {
+    auto &contact = enemies[i];
+    const auto *entity = world.getEntity(contact.id);
+    const auto *unit =
+        entity != nullptr
+            ? entity->getComponent<Engine::Core::UnitComponent>()
+            : nullptr;
+    if (unit == nullptr || unit->health <= 0) {
+      contact = std::move(enemies.back());
+      enemies.pop_back();
+      continue;
+    }
+
+    contact.health = unit->health;
+    contact.max_health = unit->max_health;
+    if (const auto *transform =
+            entity->getComponent<Engine::Core::TransformComponent>()) {
+      contact.posX = transform->position.x;
+      contact.posZ = transform->position.z;
+    }
+    ++i;
+  }
+}
+
+void AISnapshotBuilder::rebuild(const Engine::Core::World &world,
+                                int aiOwnerId, OwnerMirror &mirror) {
+  AISnapshot &snapshot = mirror.snapshot;
+  snapshot.friendlies.clear();
+  snapshot.visibleEnemies.clear();
   snapshot.player_id = aiOwnerId;
 
   auto friendlies = world.getUnitsOwnedBy(aiOwnerId);
   snapshot.friendlies.reserve(friendlies.size());
 
-  int skipped_no_ai = 0;
-  int skipped_no_unit = 0;
-  int skipped_dead = 0;
-  int added = 0;
-
-  for (auto *entity : friendlies) {
+  for (const auto *entity : friendlies) {
     if (!entity->hasComponent<Engine::Core::AIControlledComponent>()) {
-      skipped_no_ai++;
       continue;
     }
 
-    auto *unit = entity->getComponent<Engine::Core::UnitComponent>();
+    const auto *unit = entity->getComponent<Engine::Core::UnitComponent>();
     if (unit == nullptr) {
-      skipped_no_unit++;
       continue;
     }
 
     if (unit->health <= 0) {
-      skipped_dead++;
       continue;
     }
 
@@ -44,49 +182,30 @@ AISnapshot AISnapshotBuilder::build(const Engine::Core::World &world,
     data.max_health = unit->max_health;
     data.isBuilding = entity->hasComponent<Engine::Core::BuildingComponent>();
 
-    if (auto *transform =
+    if (const auto *transform =
             entity->getComponent<Engine::Core::TransformComponent>()) {
       data.posX = transform->position.x;
       data.posY = 0.0F;
       data.posZ = transform->position.z;
     }
 
-    if (auto *movement =
-            entity->getComponent<Engine::Core::MovementComponent>()) {
-      data.movement.hasComponent = true;
-      data.movement.hasTarget = movement->hasTarget;
-    }
-
-    if (auto *production =
-            entity->getComponent<Engine::Core::ProductionComponent>()) {
-      data.production.hasComponent = true;
-      data.production.inProgress = production->inProgress;
-      data.production.buildTime = production->buildTime;
-      data.production.timeRemaining = production->timeRemaining;
-      data.production.producedCount = production->producedCount;
-      data.production.maxUnits = production->maxUnits;
-      data.production.product_type = production->product_type;
-      data.production.rallySet = production->rallySet;
-      data.production.rallyX = production->rallyX;
-      data.production.rallyZ = production->rallyZ;
-      data.production.queueSize =
-          static_cast<int>(production->productionQueue.size());
-    }
+    refreshMovement(*entity, data.movement);
+    refreshProduction(*entity, data.production);
 
     snapshot.friendlies.push_back(std::move(data));
-    added++;
   }
 
   auto enemies = world.getEnemyUnits(aiOwnerId);
   snapshot.visibleEnemies.reserve(enemies.size());
 
-  for (auto *entity : enemies) {
-    auto *unit = entity->getComponent<Engine::Core::UnitComponent>();
+  for (const auto *entity : enemies) {
+    const auto *unit = entity->getComponent<Engine::Core::UnitComponent>();
     if ((unit == nullptr) || unit->health <= 0) {
       continue;
     }
 
-    auto *transform = entity->getComponent<Engine::Core::TransformComponent>();
+    const auto *transform =
+        entity->getComponent<Engine::Core::TransformComponent>();
     if (transform == nullptr) {
       continue;
     }
@@ -105,8 +224,6 @@ AISnapshot AISnapshotBuilder::build(const Engine::Core::World &world,
 
     snapshot.visibleEnemies.push_back(std::move(contact));
   }
-
-  return snapshot;
 }
 
 } // namespace Game::Systems::AI
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "../../core/change_rings.h"
+#include "../../core/event_manager.h"
 #include "ai_types.h"
+#include <unordered_map>
 
 namespace Engine::Core {
 class World;
@@ -8,16 +11,49 @@ class World;
 
 namespace Game::Systems::AI {
 
+// Builds the world view handed to the AI worker. A persistent per-owner
+// mirror is kept between ticks: spawns and deaths are picked up from the
+// world's UnitComponent change ring through a private cursor and mark
+// every mirror stale, forcing a full component walk, while an unchanged
+// entity set only gets its mutable fields (position, health, movement and
+// production state) refreshed in place. The cost of a typical tick is
+// therefore a flat field refresh plus one contiguous copy instead of
+// re-deriving the entity set from scratch. Captures swap owners on a
+// live component without touching the rings, so those still arrive as
+// events. Entries whose entity has died between changes are dropped
+// inline during the refresh. All methods run on the simulation thread,
+// which is also where the rings are written and events are dispatched.
 class AISnapshotBuilder {
 public:
-  AISnapshotBuilder() = default;
+  AISnapshotBuilder();
   ~AISnapshotBuilder() = default;
 
   AISnapshotBuilder(const AISnapshotBuilder &) = delete;
   auto operator=(const AISnapshotBuilder &) -> AISnapshotBuilder & = delete;
 
-  [[nodiscard]] static auto build(const Engine::Core::World &world,
-                                  int aiOwnerId) -> AISnapshot;
+  [[nodiscard]] auto build(const Engine::Core::World &world,
+                           int aiOwnerId) -> AISnapshot;
+
+  // Drops every mirror so the next build per owner is a full rebuild.
+  // Call when the entity id space is reset (map load, reinitialize).
+  void invalidate();
+
+private:
+  struct OwnerMirror {
+    AISnapshot snapshot;
+    bool valid = false;
+  };
+
+  static void rebuild(const Engine::Core::World &world, int aiOwnerId,
+                      OwnerMirror &mirror);
+  static void refresh(const Engine::Core::World &world, OwnerMirror &mirror);
+  void drainUnitChanges(const Engine::Core::World &world);
+
+  std::unordered_map<int, OwnerMirror> m_mirrors;
+  Engine::Core::ComponentChangeRings::Cursor m_unitCursor;
+
+  Engine::Core::ScopedEventSubscription<Engine::Core::BarrackCapturedEvent>
+      m_captureSubscription;
 };
 
 } // namespace Game::Systems::AI
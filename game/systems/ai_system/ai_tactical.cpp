@@ -1,6 +1,8 @@
 #include "ai_tactical.h"
+#include "../../map/visibility_service.h"
 #include "../../units/troop_type.h"
 #include "../nation_registry.h"
+#include "ai_influence_map.h"
 #include "ai_utils.h"
 #include "systems/ai_system/ai_types.h"
 #include "units/spawn_type.h"
@@ -117,7 +119,18 @@ auto TacticalUtils::selectFocusFireTarget(
       score += 10.0F;
     }
 
-    bool const isolated = isTargetIsolated(*enemy, enemies, 8.0F);
+    // An isolated enemy has little allied strength stamped around it;
+    // the influence sample replaces the O(enemies) proximity scan when a
+    // field is available (threshold ~ one healthy unit's own stamp).
+    bool isolated = false;
+    if (context.influence != nullptr && context.influence->initialized()) {
+      constexpr float k_isolation_threat = 2.5F;
+      isolated =
+          context.influence->threatAt(enemy->posX, enemy->posZ) <
+          k_isolation_threat;
+    } else {
+      isolated = isTargetIsolated(*enemy, enemies, 8.0F);
+    }
     if (isolated) {
       score += 6.0F;
     }
@@ -232,4 +245,55 @@ auto TacticalUtils::getUnitTypePriority(const std::string &unit_type,
   return 1.5F;
 }
 
+auto TacticalUtils::selectScoutingTarget(float from_x,
+                                         float from_z) -> ScoutTarget {
+
+  ScoutTarget result;
+
+  auto &visibility = Game::Map::VisibilityService::instance();
+  if (!visibility.isInitialized()) {
+    return result;
+  }
+
+  constexpr int k_block_cells = 16;
+  const int width = visibility.getWidth();
+  const int height = visibility.getHeight();
+  const float tile_size = visibility.getTileSize();
+  const float half_width = static_cast<float>(width) * tile_size * 0.5F;
+  const float half_height = static_cast<float>(height) * tile_size * 0.5F;
+
+  float best_dist_sq = std::numeric_limits<float>::infinity();
+
+  for (int block_z = 0; block_z < height; block_z += k_block_cells) {
+    const int max_z = std::min(block_z + k_block_cells, height) - 1;
+    for (int block_x = 0; block_x < width; block_x += k_block_cells) {
+      const int max_x = std::min(block_x + k_block_cells, width) - 1;
+
+      if (visibility.maxStateInArea(block_x, block_z, max_x, max_z) !=
+          Game::Map::VisibilityState::Unseen) {
+        continue;
+      }
+
+      const float center_x =
+          (static_cast<float>(block_x + max_x + 1) * 0.5F) * tile_size -
+          half_width;
+      const float center_z =
+          (static_cast<float>(block_z + max_z + 1) * 0.5F) * tile_size -
+          half_height;
+
+      const float dx = center_x - from_x;
+      const float dz = center_z - from_z;
+      const float dist_sq = dx * dx + dz * dz;
+      if (dist_sq < best_dist_sq) {
+        best_dist_sq = dist_sq;
+        result.found = true;
+        result.x = center_x;
+        result.z = center_z;
+      }
+    }
+  }
+
+  return result;
+}
+
 } // namespace Game::Systems::AI
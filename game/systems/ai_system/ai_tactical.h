@@ -50,6 +50,17 @@ public:
   static auto
   getUnitTypePriority(const std::string &unit_type,
                       const Game::Systems::Nation *nation = nullptr) -> float;
+
+  struct ScoutTarget {
+    bool found = false;
+    float x = 0.0F;
+    float z = 0.0F;
+  };
+
+  // Picks the nearest map block the player has never seen, using the
+  // visibility service's area queries instead of scanning individual
+  // cells. Returns found=false once the whole map has been explored.
+  static auto selectScoutingTarget(float from_x, float from_z) -> ScoutTarget;
 };
 
 } // namespace Game::Systems::AI
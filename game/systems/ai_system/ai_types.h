@@ -2,6 +2,7 @@
 
 #include "../../units/spawn_type.h"
 #include "../../units/troop_type.h"
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -12,10 +13,13 @@ using EntityID = unsigned int;
 
 namespace Game::Systems {
 struct Nation;
+class WalkabilitySnapshot;
 }
 
 namespace Game::Systems::AI {
 
+class InfluenceMap;
+
 enum class AIState {
   Idle,
   Gathering,
@@ -88,6 +92,11 @@ struct AISnapshot {
   std::vector<EntitySnapshot> friendlies;
   std::vector<ContactSnapshot> visibleEnemies;
 
+  // Read-only walkability copy for feasibility probes; behaviors never
+  // touch the live pathfinder, whose queue is reserved for committed
+  // orders. May be null before the grid exists.
+  std::shared_ptr<const Game::Systems::WalkabilitySnapshot> walkability;
+
   float gameTime = 0.0F;
 };
 
@@ -99,6 +108,10 @@ struct AIContext {
 
   const Game::Systems::Nation *nation = nullptr;
 
+  // Per-player influence field owned by the worker; re-pointed at the
+  // start of every tick, only valid while behaviors run.
+  const InfluenceMap *influence = nullptr;
+
   std::vector<Engine::Core::EntityID> militaryUnits;
   std::vector<Engine::Core::EntityID> buildings;
   Engine::Core::EntityID primaryBarracks = 0;
@@ -1,4 +1,5 @@
 #include "ai_worker.h"
+#include "../../../render/thread_topology.h"
 #include "systems/ai_system/ai_behavior_registry.h"
 #include "systems/ai_system/ai_executor.h"
 #include "systems/ai_system/ai_reasoner.h"
@@ -58,6 +59,8 @@ void AIWorker::drainResults(std::queue<AIResult> &out) {
 void AIWorker::stop() { m_shouldStop.store(true, std::memory_order_release); }
 
 void AIWorker::workerLoop() {
+  Render::ThreadTopology::instance().registerCurrentThread(
+      Render::ThreadTopology::Role::Worker, "ai worker");
   while (true) {
     AIJob job;
 
@@ -79,6 +82,9 @@ void AIWorker::workerLoop() {
       AIResult result;
       result.context = job.context;
 
+      m_influence.rebuild(job.snapshot, job.snapshot.gameTime);
+      result.context.influence = &m_influence;
+
       Game::Systems::AI::AIReasoner::updateContext(job.snapshot,
                                                    result.context);
       Game::Systems::AI::AIReasoner::updateStateMachine(result.context,
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ai_executor.h"
+#include "ai_influence_map.h"
 #include "ai_reasoner.h"
 #include "ai_types.h"
 
@@ -41,6 +42,10 @@ private:
   AIExecutor &m_executor;
   AIBehaviorRegistry &m_registry;
 
+  // Rebuilt from the job snapshot at the start of every tick; behaviors
+  // reach it through AIContext::influence.
+  InfluenceMap m_influence;
+
   std::thread m_thread;
   std::atomic<bool> m_shouldStop{false};
   std::atomic<bool> m_workerBusy{false};
@@ -1,5 +1,7 @@
 #include "retreat_behavior.h"
 #include "../../formation_planner.h"
+#include "../../pathfinding.h"
+#include "../ai_influence_map.h"
 #include "../ai_utils.h"
 #include "systems/ai_system/ai_types.h"
 
@@ -61,9 +63,40 @@ void RetreatBehavior::execute(const AISnapshot &snapshot, AIContext &context,
 
   retreat_pos.setX(retreat_pos.x() - 8.0F);
 
-  auto retreat_targets = FormationPlanner::spreadFormation(
+  // Prefer the calmest ground near the base over the fixed offset, so
+  // wounded units do not rally straight into the attack lane.
+  if (context.influence != nullptr && context.influence->initialized()) {
+    constexpr float k_safe_search_radius = 20.0F;
+    const auto safe = context.influence->findSafestNear(
+        context.basePosX, context.basePosZ, k_safe_search_radius);
+    if (safe.found) {
+      retreat_pos.setX(safe.x);
+      retreat_pos.setZ(safe.z);
+    }
+  }
+
+  // Feasibility probe against the snapshot grid: the influence field
+  // knows threat, not terrain, and a rally point inside a building
+  // footprint would send every wounded unit through a failed path
+  // request. The live pathfinder is never touched from here.
+  if (snapshot.walkability != nullptr &&
+      !snapshot.walkability->isWalkableWorld(retreat_pos.x(),
+                                             retreat_pos.z())) {
+    retreat_pos.setX(context.basePosX - 8.0F);
+    retreat_pos.setZ(context.basePosZ);
+  }
+
+  auto retreat_slots = FormationPlanner::spreadFormation(
       static_cast<int>(retreating_units.size()), retreat_pos, 2.0F);
 
+  std::vector<QVector3D> unit_positions;
+  unit_positions.reserve(retreating_units.size());
+  for (const auto *unit : retreating_units) {
+    unit_positions.emplace_back(unit->posX, unit->posY, unit->posZ);
+  }
+  auto retreat_targets =
+      FormationPlanner::assignSlots(retreat_slots, unit_positions);
+
   std::vector<Engine::Core::EntityID> unit_ids;
   std::vector<float> target_x;
   std::vector<float> target_y;
@@ -6,43 +6,68 @@
 
 namespace Game::Systems {
 
-ArrowSystem::ArrowSystem() : m_config(GameConfig::instance().arrow()) {}
+ArrowSystem::ArrowSystem()
+    : m_config(GameConfig::instance().arrow()),
+      m_configVersion(GameConfig::instance().version()) {}
 
 void ArrowSystem::spawnArrow(const QVector3D &start, const QVector3D &end,
                              const QVector3D &color, float speed) {
-  ArrowInstance a;
-  a.start = start;
-  a.end = end;
-  a.color = color;
-  a.t = 0.0F;
-  a.speed = speed;
-  a.active = true;
   QVector3D const delta = end - start;
   float const dist = delta.length();
-  a.arcHeight = std::clamp(m_config.arcHeightMultiplier * dist,
-                           m_config.arcHeightMin, m_config.arcHeightMax);
 
-  a.invDist = (dist > 0.001F) ? (1.0F / dist) : 1.0F;
-  m_arrows.push_back(a);
+  m_start.push_back(start);
+  m_end.push_back(end);
+  m_color.push_back(color);
+  m_t.push_back(0.0F);
+  m_speed.push_back(speed);
+  m_arcHeight.push_back(std::clamp(m_config.arcHeightMultiplier * dist,
+                                   m_config.arcHeightMin,
+                                   m_config.arcHeightMax));
+  m_invDist.push_back((dist > 0.001F) ? (1.0F / dist) : 1.0F);
+}
+
+void ArrowSystem::removeArrow(std::size_t index) {
+  std::size_t const last = m_t.size() - 1;
+  if (index != last) {
+    m_start[index] = m_start[last];
+    m_end[index] = m_end[last];
+    m_color[index] = m_color[last];
+    m_t[index] = m_t[last];
+    m_speed[index] = m_speed[last];
+    m_arcHeight[index] = m_arcHeight[last];
+    m_invDist[index] = m_invDist[last];
+  }
+  m_start.pop_back();
+  m_end.pop_back();
+  m_color.pop_back();
+  m_t.pop_back();
+  m_speed.pop_back();
+  m_arcHeight.pop_back();
+  m_invDist.pop_back();
 }
 
 void ArrowSystem::update(Engine::Core::World *world, float deltaTime) {
-  for (auto &arrow : m_arrows) {
-    if (!arrow.active) {
-      continue;
-    }
+  if (auto &config = GameConfig::instance();
+      config.version() != m_configVersion) {
+    m_configVersion = config.version();
+    m_config = config.arrow();
+  }
+  // Integration sweep over contiguous floats; the compiler vectorizes
+  // this. Expiry handling is a separate compaction pass so the hot loop
+  // stays branch-free.
+  std::size_t const count = m_t.size();
+  for (std::size_t i = 0; i < count; ++i) {
+    m_t[i] += deltaTime * m_speed[i] * m_invDist[i];
+  }
 
-    arrow.t += deltaTime * arrow.speed * arrow.invDist;
-    if (arrow.t >= 1.0F) {
-      arrow.t = 1.0F;
-      arrow.active = false;
+  for (std::size_t i = 0; i < m_t.size();) {
+    if (m_t[i] >= 1.0F) {
+      m_impacts.push_back({m_end[i], m_color[i]});
+      removeArrow(i);
+    } else {
+      ++i;
     }
   }
-
-  m_arrows.erase(
-      std::remove_if(m_arrows.begin(), m_arrows.end(),
-                     [](const ArrowInstance &a) { return !a.active; }),
-      m_arrows.end());
 }
 
 } // namespace Game::Systems
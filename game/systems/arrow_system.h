@@ -3,34 +3,75 @@
 #include "../core/world.h"
 #include "../game_config.h"
 #include <QVector3D>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace Game::Systems {
 
-struct ArrowInstance {
-  QVector3D start;
-  QVector3D end;
-  QVector3D color;
-  float t{};
-  float speed{};
-  bool active{};
-  float arcHeight{};
-  float invDist{};
-};
-
+// Arrow flight state lives in SoA arrays kept dense by swap-remove:
+// update integrates every live arrow in one branch-free sweep over the
+// hot fields (t, speed, 1/dist) and compacts expired ones in place, so
+// there is no active flag to skip and the renderer reads the spans
+// directly without a per-frame repack.
 class ArrowSystem : public Engine::Core::System {
 public:
   ArrowSystem();
   void update(Engine::Core::World *world, float deltaTime) override;
+  [[nodiscard]] auto name() const -> const char * override {
+    return "ArrowSystem";
+  }
+  // Only advances the internal arrow pool; safe to overlap with systems
+  // that touch world components.
+  [[nodiscard]] auto access() const -> Engine::Core::SystemAccess override {
+    return {.reads = 0, .writes = 0, .exclusive = false};
+  }
   void spawnArrow(const QVector3D &start, const QVector3D &end,
                   const QVector3D &color, float speed = 8.0F);
-  [[nodiscard]] auto arrows() const -> const std::vector<ArrowInstance> & {
-    return m_arrows;
+
+  // Landing point and color of each arrow that completed its flight
+  // since the last drain; the render side empties this once per frame to
+  // drive impact VFX.
+  struct Impact {
+    QVector3D position;
+    QVector3D color;
+  };
+  [[nodiscard]] auto impacts() const -> const std::vector<Impact> & {
+    return m_impacts;
+  }
+  void clearImpacts() { m_impacts.clear(); }
+
+  [[nodiscard]] auto count() const -> std::size_t { return m_t.size(); }
+  [[nodiscard]] auto starts() const -> const std::vector<QVector3D> & {
+    return m_start;
+  }
+  [[nodiscard]] auto ends() const -> const std::vector<QVector3D> & {
+    return m_end;
+  }
+  [[nodiscard]] auto colors() const -> const std::vector<QVector3D> & {
+    return m_color;
+  }
+  [[nodiscard]] auto ts() const -> const std::vector<float> & { return m_t; }
+  [[nodiscard]] auto arcHeights() const -> const std::vector<float> & {
+    return m_arcHeight;
   }
 
 private:
-  std::vector<ArrowInstance> m_arrows;
+  void removeArrow(std::size_t index);
+
+  std::vector<QVector3D> m_start;
+  std::vector<QVector3D> m_end;
+  std::vector<QVector3D> m_color;
+  std::vector<float> m_t;
+  std::vector<float> m_speed;
+  std::vector<float> m_arcHeight;
+  std::vector<float> m_invDist;
+  std::vector<Impact> m_impacts;
+  // Cached copy of the arrow tuning, refreshed when the config version
+  // moves so a hot reload applies without re-reading the slots per
+  // arrow.
   ArrowConfig m_config;
+  std::uint64_t m_configVersion = 0;
 };
 
 } // namespace Game::Systems
@@ -0,0 +1,183 @@
+#include "benchmark_scenario.h"
+#include "../core/world.h"
+#include "../map/map_transformer.h"
+#include "../map/terrain_service.h"
+#include "../units/factory.h"
+#include "../units/spawn_type.h"
+#include <QVariantMap>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+
+namespace Game::Systems {
+
+namespace {
+
+constexpr int k_benchmark_team_a = 1;
+constexpr int k_benchmark_team_b = 2;
+
+// Distance of each army's front line from the map center, and spacing
+// inside the formation, in world units.
+constexpr float k_front_line_offset = 8.0F;
+constexpr float k_unit_spacing = 1.5F;
+
+constexpr std::array<Game::Units::SpawnType, 3> k_troop_cycle = {
+    Game::Units::SpawnType::Archer,
+    Game::Units::SpawnType::Spearman,
+    Game::Units::SpawnType::Knight,
+};
+
+auto isWalkableWorld(float world_x, float world_z) -> bool {
+  const auto *height_map = Game::Map::TerrainService::instance().getHeightMap();
+  if (height_map == nullptr) {
+    return true;
+  }
+  const float grid_half_width =
+      static_cast<float>(height_map->getWidth()) * 0.5F - 0.5F;
+  const float grid_half_height =
+      static_cast<float>(height_map->getHeight()) * 0.5F - 0.5F;
+  const int grid_x = static_cast<int>(
+      std::lround(world_x / height_map->getTileSize() + grid_half_width));
+  const int grid_z = static_cast<int>(
+      std::lround(world_z / height_map->getTileSize() + grid_half_height));
+  return height_map->isWalkable(grid_x, grid_z);
+}
+
+auto spawnArmy(Engine::Core::World &world,
+               Game::Units::UnitFactoryRegistry &registry, int player_id,
+               float direction, int count) -> int {
+  // Columns grow away from the center line so both formations face each
+  // other across the gap; rows spread symmetrically around z = 0.
+  const int rows =
+      std::max(1, static_cast<int>(std::ceil(std::sqrt(
+                      static_cast<float>(count)))));
+  int spawned = 0;
+  int index = 0;
+  while (spawned < count && index < count * 4) {
+    const int row = index % rows;
+    const int column = index / rows;
+    ++index;
+    const float world_x =
+        direction *
+        (k_front_line_offset + static_cast<float>(column) * k_unit_spacing);
+    const float world_z =
+        (static_cast<float>(row) - static_cast<float>(rows - 1) * 0.5F) *
+        k_unit_spacing;
+    if (!isWalkableWorld(world_x, world_z)) {
+      continue;
+    }
+    Game::Units::SpawnParams params;
+    params.position = QVector3D(world_x, 0.0F, world_z);
+    params.player_id = player_id;
+    params.spawn_type = k_troop_cycle[spawned % k_troop_cycle.size()];
+    params.aiControlled = true;
+    if (registry.create(params.spawn_type, world, params)) {
+      ++spawned;
+    }
+  }
+  return spawned;
+}
+
+auto percentile(std::vector<double> samples, double fraction) -> double {
+  if (samples.empty()) {
+    return 0.0;
+  }
+  std::sort(samples.begin(), samples.end());
+  const auto index = static_cast<std::size_t>(
+      fraction * static_cast<double>(samples.size() - 1));
+  return samples[index];
+}
+
+auto average(const std::vector<double> &samples) -> double {
+  if (samples.empty()) {
+    return 0.0;
+  }
+  double sum = 0.0;
+  for (double const sample : samples) {
+    sum += sample;
+  }
+  return sum / static_cast<double>(samples.size());
+}
+
+void appendStat(QByteArray &json, const char *key,
+                const std::vector<double> &samples) {
+  json += '"';
+  json += key;
+  json += "\":{\"avg\":";
+  json += QByteArray::number(average(samples), 'f', 3);
+  json += ",\"p99\":";
+  json += QByteArray::number(percentile(samples, 0.99), 'f', 3);
+  json += ",\"max\":";
+  json += QByteArray::number(
+      samples.empty() ? 0.0 : *std::max_element(samples.begin(), samples.end()),
+      'f', 3);
+  json += '}';
+}
+
+} // namespace
+
+auto BenchmarkScenario::playerConfigs() -> QVariantList {
+  QVariantList configs;
+  QVariantMap side_a;
+  side_a["player_id"] = k_benchmark_team_a;
+  side_a["team_id"] = k_benchmark_team_a;
+  side_a["colorHex"] = QStringLiteral("#C03A2B");
+  side_a["isHuman"] = false;
+  QVariantMap side_b;
+  side_b["player_id"] = k_benchmark_team_b;
+  side_b["team_id"] = k_benchmark_team_b;
+  side_b["colorHex"] = QStringLiteral("#2E86C1");
+  side_b["isHuman"] = false;
+  configs.append(side_a);
+  configs.append(side_b);
+  return configs;
+}
+
+auto BenchmarkScenario::spawnArmies(Engine::Core::World &world,
+                                    int unitsPerSide) -> int {
+  auto registry = Game::Map::MapTransformer::getFactoryRegistry();
+  if (!registry) {
+    registry = std::make_shared<Game::Units::UnitFactoryRegistry>();
+    Game::Units::registerBuiltInUnits(*registry);
+  }
+  int spawned = 0;
+  spawned += spawnArmy(world, *registry, k_benchmark_team_a, -1.0F,
+                       unitsPerSide);
+  spawned +=
+      spawnArmy(world, *registry, k_benchmark_team_b, 1.0F, unitsPerSide);
+  return spawned;
+}
+
+auto BenchmarkReport::toJson(int unitsPerSide, int unitsSpawned) const
+    -> QByteArray {
+  QByteArray json;
+  json += "{\"benchmark\":{\"units_per_side\":";
+  json += QByteArray::number(unitsPerSide);
+  json += ",\"units_spawned\":";
+  json += QByteArray::number(unitsSpawned);
+  json += ",\"frames\":";
+  json += QByteArray::number(static_cast<qulonglong>(m_frameMs.size()));
+  json += ',';
+  appendStat(json, "frame_ms", m_frameMs);
+  json += ',';
+  appendStat(json, "tick_ms", m_tickMs);
+  json += ",\"draw_commands\":{\"avg\":";
+  double draw_sum = 0.0;
+  std::size_t draw_max = 0;
+  for (std::size_t const count : m_drawCommands) {
+    draw_sum += static_cast<double>(count);
+    draw_max = std::max(draw_max, count);
+  }
+  json += QByteArray::number(
+      m_drawCommands.empty()
+          ? 0.0
+          : draw_sum / static_cast<double>(m_drawCommands.size()),
+      'f', 1);
+  json += ",\"max\":";
+  json += QByteArray::number(static_cast<qulonglong>(draw_max));
+  json += "}}}";
+  return json;
+}
+
+} // namespace Game::Systems
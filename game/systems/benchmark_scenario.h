@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QByteArray>
+#include <QVariantList>
+#include <cstddef>
+#include <vector>
+
+namespace Engine::Core {
+class World;
+}
+
+namespace Game::Systems {
+
+// Scripted stress scenario: two AI-controlled armies of mixed troops
+// spawned in opposing lines across the map center, left to fight under
+// normal AI control. Replaces the hand-built "huge army" test setups so
+// perf numbers are comparable across changes; launched with
+// --benchmark=<units-per-side> on both the GUI and headless targets.
+class BenchmarkScenario {
+public:
+  // Two AI players on opposing teams, in the shape startSkirmish and the
+  // SkirmishLoader expect.
+  [[nodiscard]] static auto playerConfigs() -> QVariantList;
+
+  // Spawns `unitsPerSide` troops for each army (cycling archer, spearman,
+  // knight) in facing column formations, skipping unwalkable tiles.
+  // Returns the number of units actually spawned.
+  static auto spawnArmies(Engine::Core::World &world, int unitsPerSide) -> int;
+};
+
+// Per-frame samples collected during a benchmark run, rendered as a
+// single-line JSON report so CI can diff avg/p99 numbers between
+// changes. Tick time is the sim update alone; frame time is the full
+// host frame; draw commands count the submitted queue (zero when
+// headless).
+class BenchmarkReport {
+public:
+  void addFrameMs(double ms) { m_frameMs.push_back(ms); }
+  void addTickMs(double ms) { m_tickMs.push_back(ms); }
+  void addDrawCommands(std::size_t count) { m_drawCommands.push_back(count); }
+
+  [[nodiscard]] auto frameCount() const -> std::size_t {
+    return m_frameMs.size();
+  }
+
+  [[nodiscard]] auto toJson(int unitsPerSide, int unitsSpawned) const
+      -> QByteArray;
+
+private:
+  std::vector<double> m_frameMs;
+  std::vector<double> m_tickMs;
+  std::vector<std::size_t> m_drawCommands;
+};
+
+} // namespace Game::Systems
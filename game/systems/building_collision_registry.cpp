@@ -51,6 +51,11 @@ void BuildingCollisionRegistry::registerBuilding(
 
   m_buildings.push_back(footprint);
   m_entityToIndex[entity_id] = m_buildings.size() - 1;
+  addToIndex(footprint);
+
+  if (m_placementListener) {
+    m_placementListener(footprint);
+  }
 
   if (auto *pf = CommandService::getPathfinder()) {
     pf->markObstaclesDirty();
@@ -64,6 +69,7 @@ void BuildingCollisionRegistry::unregisterBuilding(unsigned int entity_id) {
   }
 
   size_t const index = it->second;
+  removeFromIndex(m_buildings[index]);
 
   if (index != m_buildings.size() - 1) {
     std::swap(m_buildings[index], m_buildings.back());
@@ -88,8 +94,10 @@ void BuildingCollisionRegistry::updateBuildingPosition(unsigned int entity_id,
   }
 
   size_t const index = it->second;
+  removeFromIndex(m_buildings[index]);
   m_buildings[index].center_x = center_x;
   m_buildings[index].center_z = center_z;
+  addToIndex(m_buildings[index]);
 
   if (auto *pf = CommandService::getPathfinder()) {
     pf->markObstaclesDirty();
@@ -109,10 +117,21 @@ void BuildingCollisionRegistry::updateBuildingOwner(unsigned int entity_id,
 
 auto BuildingCollisionRegistry::isPointInBuilding(
     float x, float z, unsigned int ignoreEntityId) const -> bool {
-  for (const auto &building : m_buildings) {
-    if (ignoreEntityId != 0 && building.entity_id == ignoreEntityId) {
+  auto bucket = m_cellBuckets.find(indexKey(indexCoord(x), indexCoord(z)));
+  if (bucket == m_cellBuckets.end()) {
+    return false;
+  }
+
+  for (unsigned int const entity_id : bucket->second) {
+    if (ignoreEntityId != 0 && entity_id == ignoreEntityId) {
+      continue;
+    }
+
+    auto it = m_entityToIndex.find(entity_id);
+    if (it == m_entityToIndex.end()) {
       continue;
     }
+    const auto &building = m_buildings[it->second];
 
     float const half_width = building.width / 2.0F;
     float const half_depth = building.depth / 2.0F;
@@ -129,6 +148,87 @@ auto BuildingCollisionRegistry::isPointInBuilding(
   return false;
 }
 
+auto BuildingCollisionRegistry::overlapsBuilding(
+    float min_x, float min_z, float max_x, float max_z,
+    unsigned int ignoreEntityId) const -> bool {
+  int const min_cx = indexCoord(min_x);
+  int const max_cx = indexCoord(max_x);
+  int const min_cz = indexCoord(min_z);
+  int const max_cz = indexCoord(max_z);
+
+  for (int cz = min_cz; cz <= max_cz; ++cz) {
+    for (int cx = min_cx; cx <= max_cx; ++cx) {
+      auto bucket = m_cellBuckets.find(indexKey(cx, cz));
+      if (bucket == m_cellBuckets.end()) {
+        continue;
+      }
+      for (unsigned int const entity_id : bucket->second) {
+        if (ignoreEntityId != 0 && entity_id == ignoreEntityId) {
+          continue;
+        }
+        auto it = m_entityToIndex.find(entity_id);
+        if (it == m_entityToIndex.end()) {
+          continue;
+        }
+        const auto &building = m_buildings[it->second];
+
+        float const half_width = building.width / 2.0F;
+        float const half_depth = building.depth / 2.0F;
+        if (max_x >= building.center_x - half_width &&
+            min_x <= building.center_x + half_width &&
+            max_z >= building.center_z - half_depth &&
+            min_z <= building.center_z + half_depth) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+void BuildingCollisionRegistry::addToIndex(const BuildingFootprint &footprint) {
+  float const half_width = footprint.width / 2.0F;
+  float const half_depth = footprint.depth / 2.0F;
+  int const min_cx = indexCoord(footprint.center_x - half_width);
+  int const max_cx = indexCoord(footprint.center_x + half_width);
+  int const min_cz = indexCoord(footprint.center_z - half_depth);
+  int const max_cz = indexCoord(footprint.center_z + half_depth);
+
+  for (int cz = min_cz; cz <= max_cz; ++cz) {
+    for (int cx = min_cx; cx <= max_cx; ++cx) {
+      m_cellBuckets[indexKey(cx, cz)].push_back(footprint.entity_id);
+    }
+  }
+}
+
+void BuildingCollisionRegistry::removeFromIndex(
+    const BuildingFootprint &footprint) {
+  float const half_width = footprint.width / 2.0F;
+  float const half_depth = footprint.depth / 2.0F;
+  int const min_cx = indexCoord(footprint.center_x - half_width);
+  int const max_cx = indexCoord(footprint.center_x + half_width);
+  int const min_cz = indexCoord(footprint.center_z - half_depth);
+  int const max_cz = indexCoord(footprint.center_z + half_depth);
+
+  for (int cz = min_cz; cz <= max_cz; ++cz) {
+    for (int cx = min_cx; cx <= max_cx; ++cx) {
+      auto bucket = m_cellBuckets.find(indexKey(cx, cz));
+      if (bucket == m_cellBuckets.end()) {
+        continue;
+      }
+      auto &ids = bucket->second;
+      auto pos = std::find(ids.begin(), ids.end(), footprint.entity_id);
+      if (pos != ids.end()) {
+        std::swap(*pos, ids.back());
+        ids.pop_back();
+      }
+      if (ids.empty()) {
+        m_cellBuckets.erase(bucket);
+      }
+    }
+  }
+}
+
 std::vector<std::pair<int, int>>
 BuildingCollisionRegistry::getOccupiedGridCells(
     const BuildingFootprint &footprint, float gridCellSize) {
@@ -159,6 +259,7 @@ BuildingCollisionRegistry::getOccupiedGridCells(
 void BuildingCollisionRegistry::clear() {
   m_buildings.clear();
   m_entityToIndex.clear();
+  m_cellBuckets.clear();
 }
 
 void BuildingCollisionRegistry::setGridPadding(float padding) {
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <cmath>
+#include <cstdint>
+#include <functional>
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace Game::Systems {
@@ -35,6 +39,15 @@ public:
   void registerBuilding(unsigned int entity_id, const std::string &buildingType,
                         float center_x, float center_z, int owner_id);
 
+  // Invoked with the footprint of every newly registered building (not for
+  // position updates of known entities). Lets interested subsystems react
+  // to placement locally instead of polling or rebuilding wholesale; a
+  // single listener suffices, pass nullptr to detach.
+  using PlacementListener = std::function<void(const BuildingFootprint &)>;
+  void setPlacementListener(PlacementListener listener) {
+    m_placementListener = std::move(listener);
+  }
+
   void unregisterBuilding(unsigned int entity_id);
 
   void updateBuildingPosition(unsigned int entity_id, float center_x,
@@ -51,6 +64,43 @@ public:
   isPointInBuilding(float x, float z,
                     unsigned int ignoreEntityId = 0) const -> bool;
 
+  // AABB overlap test against the bucket index; touches only the buckets
+  // the rectangle covers.
+  [[nodiscard]] auto overlapsBuilding(float min_x, float min_z, float max_x,
+                                      float max_z,
+                                      unsigned int ignoreEntityId = 0) const
+      -> bool;
+
+  // Batched footprint stamp: visits every (gridX, gridZ) cell covered by
+  // any registered footprint (inclusive of the grid padding), so obstacle
+  // rebuilds write the walkability grid in one pass without allocating a
+  // cell list per building.
+  template <typename Visitor>
+  void forEachOccupiedCell(float gridCellSize, Visitor &&visit) const {
+    float const padding = s_gridPadding;
+    for (const auto &building : m_buildings) {
+      float const half_width = building.width / 2.0F;
+      float const half_depth = building.depth / 2.0F;
+      int const min_grid_x = static_cast<int>(
+          std::floor((building.center_x - half_width - padding) /
+                     gridCellSize));
+      int const max_grid_x = static_cast<int>(
+          std::ceil((building.center_x + half_width + padding) /
+                    gridCellSize));
+      int const min_grid_z = static_cast<int>(
+          std::floor((building.center_z - half_depth - padding) /
+                     gridCellSize));
+      int const max_grid_z = static_cast<int>(
+          std::ceil((building.center_z + half_depth + padding) /
+                    gridCellSize));
+      for (int gx = min_grid_x; gx < max_grid_x; ++gx) {
+        for (int gz = min_grid_z; gz < max_grid_z; ++gz) {
+          visit(gx, gz);
+        }
+      }
+    }
+  }
+
   [[nodiscard]] static auto getOccupiedGridCells(
       const BuildingFootprint &footprint,
       float gridCellSize = 1.0F) -> std::vector<std::pair<int, int>>;
@@ -68,8 +118,27 @@ private:
   auto operator=(const BuildingCollisionRegistry &)
       -> BuildingCollisionRegistry & = delete;
 
+  // Coarse bucket index over footprint AABBs: each building is entered in
+  // every bucket its rectangle overlaps, so point and AABB queries only
+  // look at local buckets instead of scanning the whole list. Buckets
+  // hold entity ids, which survive the swap-remove in unregister.
+  static constexpr float kIndexCellSize = 8.0F;
+
+  static auto indexCoord(float v) -> int {
+    return static_cast<int>(std::floor(v / kIndexCellSize));
+  }
+  static auto indexKey(int cx, int cz) -> std::uint64_t {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cx)) << 32U) |
+           static_cast<std::uint64_t>(static_cast<std::uint32_t>(cz));
+  }
+
+  void addToIndex(const BuildingFootprint &footprint);
+  void removeFromIndex(const BuildingFootprint &footprint);
+
   std::vector<BuildingFootprint> m_buildings;
   std::map<unsigned int, size_t> m_entityToIndex;
+  PlacementListener m_placementListener;
+  std::unordered_map<std::uint64_t, std::vector<unsigned int>> m_cellBuckets;
 
   static const std::map<std::string, BuildingSize> s_buildingSizes;
 
@@ -16,11 +16,12 @@ class SelectionSystem;
 
 namespace Game::Systems {
 
+// Per-frame follow smoothing lives on the render thread
+// (Renderer::updateFollowCamera), tracking interpolated snapshot
+// positions at display refresh rate; the sim side only snaps the camera
+// when following is engaged and publishes the enable flag.
 class CameraFollowSystem {
 public:
-  static void update(Engine::Core::World &world, SelectionSystem &selection,
-                     Render::GL::Camera &camera);
-
   static void snapToSelection(Engine::Core::World &world,
                               SelectionSystem &selection,
                               Render::GL::Camera &camera);
@@ -119,14 +119,4 @@ void CameraService::snapToEntity(Render::GL::Camera &camera,
   }
 }
 
-void CameraService::updateFollow(Render::GL::Camera &camera,
-                                 Engine::Core::World &world,
-                                 bool followEnabled) {
-  if (followEnabled) {
-    if (auto *selection_system = world.getSystem<SelectionSystem>()) {
-      m_followSystem->update(world, *selection_system, camera);
-    }
-  }
-}
-
 } // namespace Game::Systems
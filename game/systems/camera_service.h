@@ -37,8 +37,6 @@ public:
                    int localOwnerId, unsigned int playerUnitId);
   static void snapToEntity(Render::GL::Camera &camera,
                            Engine::Core::Entity &entity);
-  void updateFollow(Render::GL::Camera &camera, Engine::Core::World &world,
-                    bool followEnabled);
 
 private:
   std::unique_ptr<CameraController> m_controller;
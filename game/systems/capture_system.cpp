@@ -6,12 +6,13 @@
 #include "../units/troop_config.h"
 #include "../visuals/team_colors.h"
 #include "building_collision_registry.h"
+#include "spatial_grid.h"
+#include "troop_count_registry.h"
 #include "units/spawn_type.h"
 #include "units/troop_type.h"
-#include <algorithm>
 #include <cmath>
 #include <qvectornd.h>
-#include <vector>
+#include <unordered_map>
 
 namespace Game::Systems {
 
@@ -19,43 +20,6 @@ void CaptureSystem::update(Engine::Core::World *world, float deltaTime) {
   processBarrackCapture(world, deltaTime);
 }
 
-auto CaptureSystem::countNearbyTroops(Engine::Core::World *world,
-                                      float barrack_x, float barrack_z,
-                                      int owner_id, float radius) -> int {
-  int total_troops = 0;
-  auto entities = world->getEntitiesWith<Engine::Core::UnitComponent>();
-
-  for (auto *e : entities) {
-    auto *unit = e->getComponent<Engine::Core::UnitComponent>();
-    auto *transform = e->getComponent<Engine::Core::TransformComponent>();
-
-    if ((unit == nullptr) || (transform == nullptr) || unit->health <= 0) {
-      continue;
-    }
-
-    if (unit->owner_id != owner_id) {
-      continue;
-    }
-
-    if (unit->spawn_type == Game::Units::SpawnType::Barracks) {
-      continue;
-    }
-
-    float const dx = transform->position.x - barrack_x;
-    float const dz = transform->position.z - barrack_z;
-    float const dist_sq = dx * dx + dz * dz;
-
-    if (dist_sq <= radius * radius) {
-      int const individuals_per_unit =
-          Game::Units::TroopConfig::instance().getIndividualsPerUnit(
-              unit->spawn_type);
-      total_troops += individuals_per_unit;
-    }
-  }
-
-  return total_troops;
-}
-
 void CaptureSystem::transferBarrackOwnership(Engine::Core::World *world,
                                              Engine::Core::Entity *barrack,
                                              int newOwnerId) {
@@ -70,6 +34,9 @@ void CaptureSystem::transferBarrackOwnership(Engine::Core::World *world,
 
   int const previous_owner_id = unit->owner_id;
   unit->owner_id = newOwnerId;
+  world->notifyUnitOwnerChanged();
+  TroopCountRegistry::instance().onOwnerChanged(previous_owner_id, newOwnerId,
+                                                unit->spawn_type);
 
   QVector3D const tc = Game::Visuals::team_colorForOwner(newOwnerId);
   renderable->color[0] = tc.x();
@@ -109,7 +76,7 @@ void CaptureSystem::processBarrackCapture(Engine::Core::World *world,
   constexpr float capture_radius = 8.0F;
   constexpr int troop_advantage_multiplier = 3;
 
-  auto barracks = world->getEntitiesWith<Engine::Core::BuildingComponent>();
+  const auto &barracks = world->view<Engine::Core::BuildingComponent>();
 
   for (auto *barrack : barracks) {
     auto *unit = barrack->getComponent<Engine::Core::UnitComponent>();
@@ -132,37 +99,43 @@ void CaptureSystem::processBarrackCapture(Engine::Core::World *world,
     float const barrack_z = transform->position.z;
     int const barrack_owner_id = unit->owner_id;
 
+    // A single spatial-grid query tallies individuals per owner inside
+    // the capture radius, replacing the per-owner world scans. Health is
+    // re-checked against the live entity since the grid snapshot predates
+    // this tick's combat.
+    std::unordered_map<int, int> troops_by_owner;
+    SpatialGrid::instance().forEachInRadius(
+        barrack_x, barrack_z, capture_radius,
+        [&](const SpatialGrid::Entry &entry) {
+          if (entry.isBuilding) {
+            return;
+          }
+          auto *e = world->getEntity(entry.id);
+          if (e == nullptr) {
+            return;
+          }
+          auto *u = e->getComponent<Engine::Core::UnitComponent>();
+          if ((u == nullptr) || u->health <= 0 ||
+              Game::Core::isNeutralOwner(u->owner_id)) {
+            return;
+          }
+          troops_by_owner[u->owner_id] +=
+              Game::Units::TroopConfig::instance().getIndividualsPerUnit(
+                  u->spawn_type);
+        });
+
     int max_enemy_troops = 0;
     int capturing_player_id = -1;
-
-    auto entities = world->getEntitiesWith<Engine::Core::UnitComponent>();
-    std::vector<int> player_ids;
-    for (auto *e : entities) {
-      auto *u = e->getComponent<Engine::Core::UnitComponent>();
-      if ((u != nullptr) && u->owner_id != barrack_owner_id &&
-          !Game::Core::isNeutralOwner(u->owner_id)) {
-        if (std::find(player_ids.begin(), player_ids.end(), u->owner_id) ==
-            player_ids.end()) {
-          player_ids.push_back(u->owner_id);
-        }
-      }
-    }
-
-    for (int const player_id : player_ids) {
-      int const troop_count = countNearbyTroops(world, barrack_x, barrack_z,
-                                                player_id, capture_radius);
-      if (troop_count > max_enemy_troops) {
+    int defender_troops = 0;
+    for (const auto &[owner_id, troop_count] : troops_by_owner) {
+      if (owner_id == barrack_owner_id) {
+        defender_troops = troop_count;
+      } else if (troop_count > max_enemy_troops) {
         max_enemy_troops = troop_count;
-        capturing_player_id = player_id;
+        capturing_player_id = owner_id;
       }
     }
 
-    int defender_troops = 0;
-    if (!Game::Core::isNeutralOwner(barrack_owner_id)) {
-      defender_troops = countNearbyTroops(world, barrack_x, barrack_z,
-                                          barrack_owner_id, capture_radius);
-    }
-
     bool const can_capture =
         max_enemy_troops >= (defender_troops * troop_advantage_multiplier);
 
@@ -12,12 +12,15 @@ namespace Game::Systems {
 class CaptureSystem : public Engine::Core::System {
 public:
   void update(Engine::Core::World *world, float deltaTime) override;
+  [[nodiscard]] auto name() const -> const char * override {
+    return "CaptureSystem";
+  }
+  // Capture progress integrates over seconds; 5 Hz keeps it smooth while
+  // skipping the nearby-troop count on most frames.
+  [[nodiscard]] auto tickInterval() const -> int override { return 6; }
 
 private:
   void processBarrackCapture(Engine::Core::World *world, float deltaTime);
-  static auto countNearbyTroops(Engine::Core::World *world, float barrack_x,
-                                float barrack_z, int owner_id,
-                                float radius) -> int;
   static void transferBarrackOwnership(Engine::Core::World *world,
                                        Engine::Core::Entity *barrack,
                                        int newOwnerId);
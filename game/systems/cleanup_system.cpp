@@ -11,18 +11,11 @@ void CleanupSystem::update(Engine::Core::World *world, float deltaTime) {
 }
 
 void CleanupSystem::removeDeadEntities(Engine::Core::World *world) {
-  std::vector<Engine::Core::EntityID> entities_to_remove;
-
-  auto entities =
-      world->getEntitiesWith<Engine::Core::PendingRemovalComponent>();
-
-  entities_to_remove.reserve(entities.size());
-  for (auto *entity : entities) {
-    entities_to_remove.push_back(entity->getId());
-  }
-
-  for (auto entity_id : entities_to_remove) {
-    world->destroyEntity(entity_id);
+  // Queue instead of destroying in place: the world releases the whole
+  // batch at the end of the frame, so a mass die-off doesn't interleave
+  // pool churn with the systems still running this tick.
+  for (auto *entity : world->view<Engine::Core::PendingRemovalComponent>()) {
+    world->queueDestroy(entity->getId());
   }
 }
 
@@ -8,6 +8,9 @@ namespace Game::Systems {
 class CleanupSystem : public Engine::Core::System {
 public:
   void update(Engine::Core::World *world, float deltaTime) override;
+  [[nodiscard]] auto name() const -> const char * override {
+    return "CleanupSystem";
+  }
 
 private:
   static void removeDeadEntities(Engine::Core::World *world);
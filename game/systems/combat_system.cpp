@@ -1,6 +1,9 @@
 #include "combat_system.h"
+#include "../core/frame_arena.h"
 #include "../core/component.h"
+#include "../core/determinism.h"
 #include "../core/event_manager.h"
+#include "../core/sim_math.h"
 #include "../core/world.h"
 #include "../units/troop_config.h"
 #include "../visuals/team_colors.h"
@@ -8,24 +11,30 @@
 #include "building_collision_registry.h"
 #include "command_service.h"
 #include "owner_registry.h"
+#include "spatial_grid.h"
 #include "units/spawn_type.h"
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <cstdint>
 #include <numbers>
 #include <qvectornd.h>
-#include <random>
 #include <vector>
 
 namespace Game::Systems {
 
 void CombatSystem::update(Engine::Core::World *world, float deltaTime) {
+  m_tuning = GameConfig::instance().combat();
+
+  SpatialGrid::instance().rebuild(*world);
+
   processAttacks(world, deltaTime);
+  resolveQueuedDamage(world);
   processAutoEngagement(world, deltaTime);
 }
 
 void CombatSystem::processAttacks(Engine::Core::World *world, float deltaTime) {
-  auto units = world->getEntitiesWith<Engine::Core::UnitComponent>();
+  const auto &units = world->view<Engine::Core::UnitComponent>();
 
   auto *arrow_sys = world->getSystem<ArrowSystem>();
 
@@ -73,8 +82,8 @@ void CombatSystem::processAttacks(Engine::Core::World *world, float deltaTime) {
             float const dz = tgtT->position.z - attT->position.z;
             float const dist = std::sqrt(dx * dx + dz * dz);
 
-            const float ideal_melee_distance = 0.6F;
-            const float max_melee_separation = 0.9F;
+            const float ideal_melee_distance = m_tuning.idealMeleeDistance;
+            const float max_melee_separation = ideal_melee_distance + 0.3F;
 
             if (dist > max_melee_separation) {
               float const pull_amount =
@@ -139,7 +148,8 @@ void CombatSystem::processAttacks(Engine::Core::World *world, float deltaTime) {
         }
       }
 
-      attacker_atk->timeSinceLast += deltaTime;
+      attacker_atk->timeSinceLast =
+          Engine::Core::simAccumulate(attacker_atk->timeSinceLast, deltaTime);
       t_accum = &attacker_atk->timeSinceLast;
     } else {
       tmp_accum += deltaTime;
@@ -340,9 +350,11 @@ void CombatSystem::processAttacks(Engine::Core::World *world, float deltaTime) {
                       options.clearAttackIntent = false;
 
                       options.allowDirectFallback = true;
-                      std::vector<Engine::Core::EntityID> const unit_ids = {
+                      Engine::Core::FrameVector<Engine::Core::EntityID> const
+                          unit_ids = {
                           attacker->getId()};
-                      std::vector<QVector3D> const move_targets = {desired_pos};
+                      Engine::Core::FrameVector<QVector3D> const
+                          move_targets = {desired_pos};
                       CommandService::moveUnits(*world, unit_ids, move_targets,
                                                 options);
                     }
@@ -372,34 +384,49 @@ void CombatSystem::processAttacks(Engine::Core::World *world, float deltaTime) {
 
       auto &owner_registry = Game::Systems::OwnerRegistry::instance();
 
-      for (auto *target : units) {
-        if (target == attacker) {
-          continue;
-        }
-
-        auto *target_unit = target->getComponent<Engine::Core::UnitComponent>();
-        if ((target_unit == nullptr) || target_unit->health <= 0) {
-          continue;
-        }
+      Engine::Core::Entity *nearest_in_range = nullptr;
+      float nearest_dist_sq = std::numeric_limits<float>::max();
+
+      // Query slack covers the target radius isInRange adds on top of the
+      // raw attack range. Health and removal state can change mid-tick, so
+      // they are re-checked against the live entity.
+      SpatialGrid::instance().forEachInRadius(
+          attacker_transform->position.x, attacker_transform->position.z,
+          range + 3.0F, [&](const SpatialGrid::Entry &entry) {
+            if (entry.id == attacker->getId() || entry.isBuilding) {
+              return;
+            }
+            if (entry.ownerId == attacker_unit->owner_id ||
+                owner_registry.areAllies(attacker_unit->owner_id,
+                                         entry.ownerId)) {
+              return;
+            }
 
-        if (target_unit->owner_id == attacker_unit->owner_id) {
-          continue;
-        }
+            float const dx = entry.x - attacker_transform->position.x;
+            float const dz = entry.z - attacker_transform->position.z;
+            float const dist_sq = dx * dx + dz * dz;
+            if (dist_sq >= nearest_dist_sq) {
+              return;
+            }
 
-        if (owner_registry.areAllies(attacker_unit->owner_id,
-                                     target_unit->owner_id)) {
-          continue;
-        }
+            auto *target = world->getEntity(entry.id);
+            if ((target == nullptr) ||
+                target->hasComponent<Engine::Core::PendingRemovalComponent>()) {
+              return;
+            }
+            auto *target_unit =
+                target->getComponent<Engine::Core::UnitComponent>();
+            if ((target_unit == nullptr) || target_unit->health <= 0) {
+              return;
+            }
 
-        if (target->hasComponent<Engine::Core::BuildingComponent>()) {
-          continue;
-        }
+            if (isInRange(attacker, target, range)) {
+              nearest_dist_sq = dist_sq;
+              nearest_in_range = target;
+            }
+          });
 
-        if (isInRange(attacker, target, range)) {
-          best_target = target;
-          break;
-        }
-      }
+      best_target = nearest_in_range;
     }
 
     if (best_target != nullptr) {
@@ -476,6 +503,11 @@ void CombatSystem::processAttacks(Engine::Core::World *world, float deltaTime) {
                   ? Game::Visuals::team_colorForOwner(attU->owner_id)
                   : QVector3D(0.8F, 0.9F, 1.0F);
 
+          // Keyed by attacker so volley shapes replay identically for the
+          // same seed and tick regardless of which worker runs this system.
+          const auto &sim_rng = Engine::Core::SimRng::instance();
+          const auto rng_key = static_cast<std::uint32_t>(attacker->getId());
+
           int arrow_count = 1;
           if (attU != nullptr) {
             int const troop_size =
@@ -483,21 +515,22 @@ void CombatSystem::processAttacks(Engine::Core::World *world, float deltaTime) {
                     attU->spawn_type);
             int const max_arrows = std::max(1, troop_size / 3);
 
-            static thread_local std::mt19937 gen(std::random_device{}());
-            std::uniform_int_distribution<> dist(1, max_arrows);
-            arrow_count = dist(gen);
+            arrow_count = sim_rng.uniformInt(rng_key, 0, 1, max_arrows);
           }
 
           for (int i = 0; i < arrow_count; ++i) {
-            static thread_local std::mt19937 spread_gen(std::random_device{}());
-            std::uniform_real_distribution<float> spread_dist(-0.15F, 0.15F);
-
             QVector3D const perpendicular(-dir.z(), 0.0F, dir.x());
             QVector3D const up_vector(0.0F, 1.0F, 0.0F);
 
-            float const lateral_offset = spread_dist(spread_gen);
-            float const vertical_offset = spread_dist(spread_gen) * 1.5F;
-            float const depth_offset = spread_dist(spread_gen) * 1.3F;
+            const auto draw_base = static_cast<std::uint32_t>(3 * i);
+            float const lateral_offset =
+                sim_rng.uniformFloat(rng_key, draw_base + 1, -0.15F, 0.15F);
+            float const vertical_offset =
+                sim_rng.uniformFloat(rng_key, draw_base + 2, -0.15F, 0.15F) *
+                1.5F;
+            float const depth_offset =
+                sim_rng.uniformFloat(rng_key, draw_base + 3, -0.15F, 0.15F) *
+                1.3F;
 
             QVector3D const start_offset =
                 perpendicular * lateral_offset + up_vector * vertical_offset;
@@ -537,7 +570,7 @@ void CombatSystem::processAttacks(Engine::Core::World *world, float deltaTime) {
           float const dz = tgtT->position.z - attT->position.z;
           float const dist = std::sqrt(dx * dx + dz * dz);
 
-          const float ideal_melee_distance = 0.6F;
+          const float ideal_melee_distance = m_tuning.idealMeleeDistance;
 
           if (dist > ideal_melee_distance + 0.1F) {
 
@@ -556,7 +589,7 @@ void CombatSystem::processAttacks(Engine::Core::World *world, float deltaTime) {
         }
       }
 
-      dealDamage(world, best_target, damage, attacker->getId());
+      queueDamage(best_target, damage, attacker->getId());
       *t_accum = 0.0F;
     } else {
 
@@ -620,58 +653,85 @@ auto CombatSystem::isInRange(Engine::Core::Entity *attacker,
   return true;
 }
 
-void CombatSystem::dealDamage(Engine::Core::World *world,
-                              Engine::Core::Entity *target, int damage,
-                              Engine::Core::EntityID attackerId) {
+void CombatSystem::queueDamage(Engine::Core::Entity *target, int damage,
+                               Engine::Core::EntityID attackerId) {
   auto *unit = target->getComponent<Engine::Core::UnitComponent>();
-  if (unit != nullptr) {
-    unit->health = std::max(0, unit->health - damage);
-
-    int attacker_owner_id = 0;
-    if (attackerId != 0 && (world != nullptr)) {
-      auto *attacker = world->getEntity(attackerId);
-      if (attacker != nullptr) {
-        auto *attacker_unit =
-            attacker->getComponent<Engine::Core::UnitComponent>();
-        if (attacker_unit != nullptr) {
-          attacker_owner_id = attacker_unit->owner_id;
-        }
-      }
+  if (unit == nullptr) {
+    return;
+  }
+
+  auto [it, inserted] =
+      m_pendingDamageIndex.try_emplace(target->getId(), m_pendingDamage.size());
+  if (inserted) {
+    m_pendingDamage.push_back({target->getId(), 0, 0, 0});
+  }
+  auto &pending = m_pendingDamage[it->second];
+
+  bool const was_alive = unit->health - pending.total > 0;
+  pending.total += damage;
+  pending.lastAttackerId = attackerId;
+  if (was_alive && unit->health - pending.total <= 0) {
+    pending.killerAttackerId = attackerId;
+  }
+}
+
+void CombatSystem::resolveQueuedDamage(Engine::Core::World *world) {
+  auto owner_of = [world](Engine::Core::EntityID entity_id) {
+    if (entity_id == 0) {
+      return 0;
+    }
+    auto *entity = world->getEntity(entity_id);
+    if (entity == nullptr) {
+      return 0;
+    }
+    auto *unit = entity->getComponent<Engine::Core::UnitComponent>();
+    return unit != nullptr ? unit->owner_id : 0;
+  };
+
+  for (const auto &pending : m_pendingDamage) {
+    auto *target = world->getEntity(pending.targetId);
+    if (target == nullptr) {
+      continue;
     }
+    auto *unit = target->getComponent<Engine::Core::UnitComponent>();
+    if (unit == nullptr) {
+      continue;
+    }
+
+    unit->health = std::max(0, unit->health - pending.total);
 
     if (target->hasComponent<Engine::Core::BuildingComponent>() &&
         unit->health > 0) {
-      Engine::Core::EventManager::instance().publish(
-          Engine::Core::BuildingAttackedEvent(target->getId(), unit->owner_id,
-                                              unit->spawn_type, attackerId,
-                                              attacker_owner_id, damage));
+      Engine::Core::EventManager::instance().publishDeferred(
+          Engine::Core::BuildingAttackedEvent(
+              target->getId(), unit->owner_id, unit->spawn_type,
+              pending.lastAttackerId, owner_of(pending.lastAttackerId),
+              pending.total));
     }
 
     if (unit->health <= 0) {
+      Engine::Core::EntityID const killer_id = pending.killerAttackerId != 0
+                                                   ? pending.killerAttackerId
+                                                   : pending.lastAttackerId;
 
-      int const killer_owner_id = attacker_owner_id;
-
-      Engine::Core::EventManager::instance().publish(
+      Engine::Core::EventManager::instance().publishDeferred(
           Engine::Core::UnitDiedEvent(target->getId(), unit->owner_id,
-                                      unit->spawn_type, attackerId,
-                                      killer_owner_id));
+                                      unit->spawn_type, killer_id,
+                                      owner_of(killer_id)));
 
       auto *target_atk = target->getComponent<Engine::Core::AttackComponent>();
       if ((target_atk != nullptr) && target_atk->inMeleeLock &&
           target_atk->meleeLockTargetId != 0) {
-
-        if (world != nullptr) {
-          auto *lock_partner = world->getEntity(target_atk->meleeLockTargetId);
-          if ((lock_partner != nullptr) &&
-              !lock_partner
-                   ->hasComponent<Engine::Core::PendingRemovalComponent>()) {
-            auto *partner_atk =
-                lock_partner->getComponent<Engine::Core::AttackComponent>();
-            if ((partner_atk != nullptr) &&
-                partner_atk->meleeLockTargetId == target->getId()) {
-              partner_atk->inMeleeLock = false;
-              partner_atk->meleeLockTargetId = 0;
-            }
+        auto *lock_partner = world->getEntity(target_atk->meleeLockTargetId);
+        if ((lock_partner != nullptr) &&
+            !lock_partner
+                 ->hasComponent<Engine::Core::PendingRemovalComponent>()) {
+          auto *partner_atk =
+              lock_partner->getComponent<Engine::Core::AttackComponent>();
+          if ((partner_atk != nullptr) &&
+              partner_atk->meleeLockTargetId == target->getId()) {
+            partner_atk->inMeleeLock = false;
+            partner_atk->meleeLockTargetId = 0;
           }
         }
       }
@@ -697,6 +757,9 @@ void CombatSystem::dealDamage(Engine::Core::World *world,
       target->addComponent<Engine::Core::PendingRemovalComponent>();
     }
   }
+
+  m_pendingDamage.clear();
+  m_pendingDamageIndex.clear();
 }
 
 void CombatSystem::updateCombatMode(
@@ -723,48 +786,16 @@ void CombatSystem::updateCombatMode(
     return;
   }
 
-  auto &owner_registry = Game::Systems::OwnerRegistry::instance();
-  auto units = world->getEntitiesWith<Engine::Core::UnitComponent>();
+  // Any enemy beyond both attack ranges selects the same mode as no enemy
+  // at all, so the query can stop at the larger range instead of ranking
+  // every enemy on the map.
+  float const search_range =
+      std::max(attack_comp->range, attack_comp->meleeRange) + 1.0F;
+  const auto *closest_enemy = SpatialGrid::instance().nearestEnemy(
+      attacker_transform->position.x, attacker_transform->position.z,
+      search_range, attacker_unit->owner_id, attacker->getId(), true);
 
-  float closest_enemy_dist_sq = std::numeric_limits<float>::max();
-  float closest_height_diff = 0.0F;
-
-  for (auto *target : units) {
-    if (target == attacker) {
-      continue;
-    }
-
-    auto *target_unit = target->getComponent<Engine::Core::UnitComponent>();
-    if ((target_unit == nullptr) || target_unit->health <= 0) {
-      continue;
-    }
-
-    if (owner_registry.areAllies(attacker_unit->owner_id,
-                                 target_unit->owner_id)) {
-      continue;
-    }
-
-    auto *target_transform =
-        target->getComponent<Engine::Core::TransformComponent>();
-    if (target_transform == nullptr) {
-      continue;
-    }
-
-    float const dx =
-        target_transform->position.x - attacker_transform->position.x;
-    float const dz =
-        target_transform->position.z - attacker_transform->position.z;
-    float const dy =
-        target_transform->position.y - attacker_transform->position.y;
-    float const dist_sq = dx * dx + dz * dz;
-
-    if (dist_sq < closest_enemy_dist_sq) {
-      closest_enemy_dist_sq = dist_sq;
-      closest_height_diff = std::abs(dy);
-    }
-  }
-
-  if (closest_enemy_dist_sq == std::numeric_limits<float>::max()) {
+  if (closest_enemy == nullptr) {
     if (attack_comp->canRanged) {
       attack_comp->currentMode =
           Engine::Core::AttackComponent::CombatMode::Ranged;
@@ -775,7 +806,11 @@ void CombatSystem::updateCombatMode(
     return;
   }
 
-  float const closest_dist = std::sqrt(closest_enemy_dist_sq);
+  float const dx = closest_enemy->x - attacker_transform->position.x;
+  float const dz = closest_enemy->z - attacker_transform->position.z;
+  float const closest_dist = std::sqrt(dx * dx + dz * dz);
+  float const closest_height_diff =
+      std::abs(closest_enemy->y - attacker_transform->position.y);
 
   bool const in_melee_range =
       attack_comp->isInMeleeRange(closest_dist, closest_height_diff);
@@ -796,16 +831,13 @@ void CombatSystem::updateCombatMode(
 
 void CombatSystem::processAutoEngagement(Engine::Core::World *world,
                                          float deltaTime) {
-  auto units = world->getEntitiesWith<Engine::Core::UnitComponent>();
+  const auto &units = world->view<Engine::Core::UnitComponent>();
 
-  for (auto it = m_engagementCooldowns.begin();
-       it != m_engagementCooldowns.end();) {
-    it->second -= deltaTime;
-    if (it->second <= 0.0F) {
-      it = m_engagementCooldowns.erase(it);
-    } else {
-      ++it;
-    }
+  m_expiredEngagements.clear();
+  m_engagementTimers.advance(deltaTime, m_expiredEngagements);
+  for (std::uint64_t const payload : m_expiredEngagements) {
+    m_onEngagementCooldown.erase(
+        static_cast<Engine::Core::EntityID>(payload));
   }
 
   for (auto *unit : units) {
@@ -834,19 +866,38 @@ void CombatSystem::processAutoEngagement(Engine::Core::World *world,
       continue;
     }
 
-    if (m_engagementCooldowns.find(unit->getId()) !=
-        m_engagementCooldowns.end()) {
+    if (m_onEngagementCooldown.find(unit->getId()) !=
+        m_onEngagementCooldown.end()) {
       continue;
     }
 
     if (!isUnitIdle(unit)) {
+      m_restingUnits.erase(unit->getId());
       continue;
     }
 
     float const vision_range = unit_comp->vision_range;
+
+    // Units whose last scan found nothing rest until the grid reports an
+    // entity entering or leaving a cell near them; one extra cell of
+    // slack covers approaches that stay inside a single cell between
+    // boundary crossings.
+    auto *unit_transform =
+        unit->getComponent<Engine::Core::TransformComponent>();
+    if ((unit_transform != nullptr) &&
+        m_restingUnits.find(unit->getId()) != m_restingUnits.end() &&
+        !SpatialGrid::instance().isNeighborhoodDisturbed(
+            unit_transform->position.x, unit_transform->position.z,
+            vision_range + SpatialGrid::kCellSize)) {
+      continue;
+    }
+
     auto *nearest_enemy = findNearestEnemy(unit, world, vision_range);
 
-    if (nearest_enemy != nullptr) {
+    if (nearest_enemy == nullptr) {
+      m_restingUnits.insert(unit->getId());
+    } else {
+      m_restingUnits.erase(unit->getId());
 
       auto *attack_target =
           unit->getComponent<Engine::Core::AttackTargetComponent>();
@@ -858,7 +909,9 @@ void CombatSystem::processAutoEngagement(Engine::Core::World *world,
         attack_target->target_id = nearest_enemy->getId();
         attack_target->shouldChase = true;
 
-        m_engagementCooldowns[unit->getId()] = ENGAGEMENT_COOLDOWN;
+        m_onEngagementCooldown.insert(unit->getId());
+        m_engagementTimers.schedule(m_tuning.engagementCooldown,
+                                    unit->getId());
       }
     }
   }
@@ -901,50 +954,50 @@ auto CombatSystem::findNearestEnemy(Engine::Core::Entity *unit,
   }
 
   auto &owner_registry = Game::Systems::OwnerRegistry::instance();
-  auto units = world->getEntitiesWith<Engine::Core::UnitComponent>();
+  auto &grid = SpatialGrid::instance();
+
+  // Candidates come out of the grid as SoA arrays and the squared
+  // distances are computed in one vectorized pass; the filter loop then
+  // rejects most of them on the precomputed distance before touching
+  // owner relations or live entities.
+  grid.gatherInRadius(unit_transform->position.x, unit_transform->position.z,
+                      maxRange, m_candidateScratch);
+  SpatialGrid::computeDistancesSq(m_candidateScratch,
+                                  unit_transform->position.x,
+                                  unit_transform->position.z);
 
   Engine::Core::Entity *nearest_enemy = nullptr;
   float nearest_dist_sq = maxRange * maxRange;
 
-  for (auto *target : units) {
-    if (target == unit) {
-      continue;
-    }
-
-    if (target->hasComponent<Engine::Core::PendingRemovalComponent>()) {
-      continue;
-    }
-
-    auto *target_unit = target->getComponent<Engine::Core::UnitComponent>();
-    if ((target_unit == nullptr) || target_unit->health <= 0) {
+  std::size_t const count = m_candidateScratch.size();
+  for (std::size_t i = 0; i < count; ++i) {
+    if (m_candidateScratch.distancesSq[i] >= nearest_dist_sq) {
       continue;
     }
-
-    if (target_unit->owner_id == unit_comp->owner_id) {
+    if (m_candidateScratch.ids[i] == unit->getId() ||
+        m_candidateScratch.buildings[i] != 0U) {
       continue;
     }
-    if (owner_registry.areAllies(unit_comp->owner_id, target_unit->owner_id)) {
+    if (m_candidateScratch.owners[i] == unit_comp->owner_id ||
+        owner_registry.areAllies(unit_comp->owner_id,
+                                 m_candidateScratch.owners[i])) {
       continue;
     }
 
-    if (target->hasComponent<Engine::Core::BuildingComponent>()) {
+    // Grid entries are a start-of-tick snapshot; units killed earlier in
+    // this tick are filtered out against the live entity.
+    auto *target = world->getEntity(m_candidateScratch.ids[i]);
+    if ((target == nullptr) ||
+        target->hasComponent<Engine::Core::PendingRemovalComponent>()) {
       continue;
     }
-
-    auto *target_transform =
-        target->getComponent<Engine::Core::TransformComponent>();
-    if (target_transform == nullptr) {
+    auto *target_unit = target->getComponent<Engine::Core::UnitComponent>();
+    if ((target_unit == nullptr) || target_unit->health <= 0) {
       continue;
     }
 
-    float const dx = target_transform->position.x - unit_transform->position.x;
-    float const dz = target_transform->position.z - unit_transform->position.z;
-    float const dist_sq = dx * dx + dz * dz;
-
-    if (dist_sq < nearest_dist_sq) {
-      nearest_dist_sq = dist_sq;
-      nearest_enemy = target;
-    }
+    nearest_dist_sq = m_candidateScratch.distancesSq[i];
+    nearest_enemy = target;
   }
 
   return nearest_enemy;
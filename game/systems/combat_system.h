@@ -2,7 +2,13 @@
 
 #include "../core/entity.h"
 #include "../core/system.h"
+#include "../game_config.h"
+#include "spatial_grid.h"
+#include "timer_wheel.h"
+#include <cstdint>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace Engine::Core {
 class AttackComponent;
@@ -13,6 +19,9 @@ namespace Game::Systems {
 class CombatSystem : public Engine::Core::System {
 public:
   void update(Engine::Core::World *world, float deltaTime) override;
+  [[nodiscard]] auto name() const -> const char * override {
+    return "CombatSystem";
+  }
 
 private:
   void processAttacks(Engine::Core::World *world, float deltaTime);
@@ -21,17 +30,46 @@ private:
                                Engine::Core::AttackComponent *attack_comp);
   static auto isInRange(Engine::Core::Entity *attacker,
                         Engine::Core::Entity *target, float range) -> bool;
-  static void dealDamage(Engine::Core::World *world,
-                         Engine::Core::Entity *target, int damage,
-                         Engine::Core::EntityID attackerId = 0);
+  // Hits are accumulated per victim during the attack pass and resolved
+  // in one batch afterwards: a volley landing on the same target touches
+  // its components once instead of once per arrow, buildings publish a
+  // single attacked event with the tick's total, and deaths are
+  // processed together feeding the deferred-removal queue.
+  void queueDamage(Engine::Core::Entity *target, int damage,
+                   Engine::Core::EntityID attackerId);
+  void resolveQueuedDamage(Engine::Core::World *world);
   void processAutoEngagement(Engine::Core::World *world, float deltaTime);
   static auto isUnitIdle(Engine::Core::Entity *unit) -> bool;
-  static auto findNearestEnemy(Engine::Core::Entity *unit,
-                               Engine::Core::World *world,
-                               float maxRange) -> Engine::Core::Entity *;
+  auto findNearestEnemy(Engine::Core::Entity *unit, Engine::Core::World *world,
+                        float maxRange) -> Engine::Core::Entity *;
 
-  std::unordered_map<Engine::Core::EntityID, float> m_engagementCooldowns;
-  static constexpr float ENGAGEMENT_COOLDOWN = 0.5F;
+  // Engagement cooldowns live on a timer wheel: expiries pop in O(1)
+  // instead of decrementing every pending cooldown each update. The set
+  // mirrors which units are currently gated.
+  TimerWheel m_engagementTimers;
+  std::unordered_set<Engine::Core::EntityID> m_onEngagementCooldown;
+  std::vector<std::uint64_t> m_expiredEngagements;
+  // Idle units whose last enemy scan came up empty; they skip further
+  // scans until the spatial grid reports movement in their aggro
+  // neighborhood.
+  std::unordered_set<Engine::Core::EntityID> m_restingUnits;
+  // Per-tick damage buffer, resolved in attack order so event emission
+  // stays deterministic. killerAttackerId records the hit that pushed
+  // accumulated damage past the victim's remaining health.
+  struct PendingDamage {
+    Engine::Core::EntityID targetId = 0;
+    int total = 0;
+    Engine::Core::EntityID lastAttackerId = 0;
+    Engine::Core::EntityID killerAttackerId = 0;
+  };
+  std::vector<PendingDamage> m_pendingDamage;
+  std::unordered_map<Engine::Core::EntityID, std::size_t> m_pendingDamageIndex;
+  // SoA candidate scratch for enemy scans; the grid fills it and the
+  // squared-distance pass runs vectorized before any entity lookups.
+  SpatialGrid::CandidateBatch m_candidateScratch;
+  // Combat tuning cached once per tick from GameConfig so a hot reload
+  // applies without per-attacker reads of the double-buffered slots.
+  CombatConfig m_tuning;
 };
 
 } // namespace Game::Systems
\ No newline at end of file
@@ -1,12 +1,16 @@
 #include "command_service.h"
 #include "../core/component.h"
+#include "../core/frame_arena.h"
 #include "../core/world.h"
+#include "flow_field.h"
 #include "pathfinding.h"
+#include "replay_service.h"
 #include "units/spawn_type.h"
 #include <QDebug>
 #include <QVector3D>
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
@@ -26,6 +30,63 @@ constexpr float same_target_threshold_sq = 0.01F;
 constexpr float pathfinding_request_cooldown = 1.0F;
 
 constexpr float target_movement_threshold_sq = 4.0F;
+
+constexpr std::size_t max_cached_flow_fields = 16;
+
+// Pursuit re-paths splice onto the existing path when the goal moved by
+// at most this many cells; larger shifts re-path in full.
+constexpr int warm_splice_max_shift = 6;
+
+// Paths longer than this re-path in full instead of splicing, so a long
+// chase cannot accrete an ever-growing trail of stale detours.
+constexpr std::size_t warm_splice_max_waypoints = 96;
+
+auto flowFieldKeyFor(const Point &goal) -> std::uint64_t {
+  return (static_cast<std::uint64_t>(goal.x + 1) << 32U) |
+         static_cast<std::uint32_t>(goal.y + 1);
+}
+
+// Replay recording happens at the public entry points only; moveGroup and
+// attack_target re-enter moveUnits internally, and logging those nested
+// calls would double-apply the command on playback.
+thread_local int t_commandDepth = 0;
+
+struct CommandDepthScope {
+  CommandDepthScope() { ++t_commandDepth; }
+  ~CommandDepthScope() { --t_commandDepth; }
+  CommandDepthScope(const CommandDepthScope &) = delete;
+  auto operator=(const CommandDepthScope &) -> CommandDepthScope & = delete;
+  CommandDepthScope(CommandDepthScope &&) = delete;
+  auto operator=(CommandDepthScope &&) -> CommandDepthScope & = delete;
+  [[nodiscard]] auto isTopLevel() const -> bool { return t_commandDepth == 1; }
+};
+
+void haltMovement(Engine::Core::Entity *entity) {
+  auto *movement = entity->getComponent<Engine::Core::MovementComponent>();
+  if (movement == nullptr) {
+    return;
+  }
+
+  auto *transform = entity->getComponent<Engine::Core::TransformComponent>();
+  movement->hasTarget = false;
+  movement->path.clear();
+  movement->pathPending = false;
+  movement->pendingRequestId = 0;
+  movement->repathCooldown = 0.0F;
+  movement->vx = 0.0F;
+  movement->vz = 0.0F;
+  if (transform != nullptr) {
+    movement->target_x = transform->position.x;
+    movement->target_y = transform->position.z;
+    movement->goalX = transform->position.x;
+    movement->goalY = transform->position.z;
+  } else {
+    movement->target_x = 0.0F;
+    movement->target_y = 0.0F;
+    movement->goalX = 0.0F;
+    movement->goalY = 0.0F;
+  }
+}
 } // namespace
 
 std::unique_ptr<Pathfinding> CommandService::s_pathfinder = nullptr;
@@ -35,6 +96,11 @@ std::unordered_map<Engine::Core::EntityID, std::uint64_t>
     CommandService::s_entityToRequest;
 std::mutex CommandService::s_pendingMutex;
 std::atomic<std::uint64_t> CommandService::s_nextRequestId{1};
+std::unordered_map<std::uint64_t, std::shared_ptr<const FlowField>>
+    CommandService::s_flowFields;
+std::mutex CommandService::s_flowFieldMutex;
+std::vector<CommandService::QueuedCommand> CommandService::s_queuedCommands;
+std::mutex CommandService::s_queueMutex;
 
 void CommandService::initialize(int worldWidth, int worldHeight) {
   s_pathfinder = std::make_unique<Pathfinding>(worldWidth, worldHeight);
@@ -43,6 +109,14 @@ void CommandService::initialize(int worldWidth, int worldHeight) {
     s_pendingRequests.clear();
     s_entityToRequest.clear();
   }
+  {
+    std::lock_guard<std::mutex> const lock(s_flowFieldMutex);
+    s_flowFields.clear();
+  }
+  {
+    std::lock_guard<std::mutex> const lock(s_queueMutex);
+    s_queuedCommands.clear();
+  }
   s_nextRequestId.store(1, std::memory_order_release);
 
   float const offset_x = -(worldWidth * 0.5F - 0.5F);
@@ -53,6 +127,66 @@ void CommandService::initialize(int worldWidth, int worldHeight) {
 auto CommandService::getPathfinder() -> Pathfinding * {
   return s_pathfinder.get();
 }
+
+auto CommandService::getFlowField(std::uint64_t key)
+    -> std::shared_ptr<const FlowField> {
+  if (!s_pathfinder) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> const lock(s_flowFieldMutex);
+  auto it = s_flowFields.find(key);
+  if (it == s_flowFields.end()) {
+    return nullptr;
+  }
+  if (it->second->obstacleVersion() != s_pathfinder->obstacleVersion()) {
+    s_flowFields.erase(it);
+    return nullptr;
+  }
+  return it->second;
+}
+
+auto CommandService::requestFlowField(const Point &goal)
+    -> std::shared_ptr<const FlowField> {
+  if (!s_pathfinder) {
+    return nullptr;
+  }
+
+  std::uint64_t const key = flowFieldKeyFor(goal);
+  {
+    std::lock_guard<std::mutex> const lock(s_flowFieldMutex);
+    auto it = s_flowFields.find(key);
+    if (it != s_flowFields.end() &&
+        it->second->obstacleVersion() == s_pathfinder->obstacleVersion()) {
+      return it->second;
+    }
+  }
+
+  auto field = s_pathfinder->buildFlowField(goal);
+  if (!field) {
+    return nullptr;
+  }
+
+  {
+    std::lock_guard<std::mutex> const lock(s_flowFieldMutex);
+    if (s_flowFields.size() >= max_cached_flow_fields) {
+      // Drop stale entries first; units still steering off an evicted
+      // field keep it alive through their last getFlowField shared_ptr
+      // until they fall back to an individual path.
+      for (auto it = s_flowFields.begin(); it != s_flowFields.end();) {
+        if (it->second->obstacleVersion() != s_pathfinder->obstacleVersion()) {
+          it = s_flowFields.erase(it);
+        } else {
+          ++it;
+        }
+      }
+      if (s_flowFields.size() >= max_cached_flow_fields) {
+        s_flowFields.clear();
+      }
+    }
+    s_flowFields[key] = field;
+  }
+  return field;
+}
 auto CommandService::worldToGrid(float world_x, float world_z) -> Point {
   if (s_pathfinder) {
     int const grid_x =
@@ -76,46 +210,93 @@ auto CommandService::gridToWorld(const Point &gridPos) -> QVector3D {
 }
 
 void CommandService::clearPendingRequest(Engine::Core::EntityID entity_id) {
-  std::lock_guard<std::mutex> const lock(s_pendingMutex);
-  auto it = s_entityToRequest.find(entity_id);
-  if (it == s_entityToRequest.end()) {
-    return;
-  }
+  std::uint64_t request_id = 0;
+  {
+    std::lock_guard<std::mutex> const lock(s_pendingMutex);
+    auto it = s_entityToRequest.find(entity_id);
+    if (it == s_entityToRequest.end()) {
+      return;
+    }
 
-  std::uint64_t const request_id = it->second;
-  s_entityToRequest.erase(it);
+    request_id = it->second;
+    s_entityToRequest.erase(it);
 
-  auto pending_it = s_pendingRequests.find(request_id);
-  if (pending_it == s_pendingRequests.end()) {
-    return;
+    auto pending_it = s_pendingRequests.find(request_id);
+    if (pending_it != s_pendingRequests.end()) {
+      auto members = pending_it->second.groupMembers;
+      s_pendingRequests.erase(pending_it);
+
+      for (auto member_id : members) {
+        auto member_entry = s_entityToRequest.find(member_id);
+        if (member_entry != s_entityToRequest.end() &&
+            member_entry->second == request_id) {
+          s_entityToRequest.erase(member_entry);
+        }
+      }
+    }
   }
 
-  auto members = pending_it->second.groupMembers;
-  s_pendingRequests.erase(pending_it);
+  // Nothing maps to the request any more, so its result could only be
+  // discarded; stop it from computing if it is still queued.
+  if (s_pathfinder) {
+    s_pathfinder->cancelPathRequest(request_id);
+  }
+}
+
+void CommandService::clearPendingRequests(
+    std::span<const Engine::Core::EntityID> units) {
+  Engine::Core::FrameVector<std::uint64_t> cancelled;
+  {
+    std::lock_guard<std::mutex> const lock(s_pendingMutex);
+    for (auto entity_id : units) {
+      auto it = s_entityToRequest.find(entity_id);
+      if (it == s_entityToRequest.end()) {
+        continue;
+      }
+      std::uint64_t const request_id = it->second;
+      s_entityToRequest.erase(it);
+
+      auto pending_it = s_pendingRequests.find(request_id);
+      if (pending_it != s_pendingRequests.end()) {
+        auto members = std::move(pending_it->second.groupMembers);
+        s_pendingRequests.erase(pending_it);
 
-  for (auto member_id : members) {
-    auto member_entry = s_entityToRequest.find(member_id);
-    if (member_entry != s_entityToRequest.end() &&
-        member_entry->second == request_id) {
-      s_entityToRequest.erase(member_entry);
+        for (auto member_id : members) {
+          auto member_entry = s_entityToRequest.find(member_id);
+          if (member_entry != s_entityToRequest.end() &&
+              member_entry->second == request_id) {
+            s_entityToRequest.erase(member_entry);
+          }
+        }
+      }
+      cancelled.push_back(request_id);
     }
   }
+
+  if (s_pathfinder && !cancelled.empty()) {
+    s_pathfinder->cancelPathRequests({cancelled.data(), cancelled.size()});
+  }
 }
 
 void CommandService::moveUnits(Engine::Core::World &world,
-                               const std::vector<Engine::Core::EntityID> &units,
-                               const std::vector<QVector3D> &targets) {
+                               std::span<const Engine::Core::EntityID> units,
+                               std::span<const QVector3D> targets) {
   moveUnits(world, units, targets, MoveOptions{});
 }
 
 void CommandService::moveUnits(Engine::Core::World &world,
-                               const std::vector<Engine::Core::EntityID> &units,
-                               const std::vector<QVector3D> &targets,
+                               std::span<const Engine::Core::EntityID> units,
+                               std::span<const QVector3D> targets,
                                const MoveOptions &options) {
   if (units.size() != targets.size()) {
     return;
   }
 
+  CommandDepthScope const command_scope;
+  if (command_scope.isTopLevel()) {
+    ReplayService::instance().recordMove(units, targets, options);
+  }
+
   if (options.groupMove && units.size() > 1) {
     moveGroup(world, units, targets, options);
     return;
@@ -181,6 +362,7 @@ void CommandService::moveUnits(Engine::Core::World &world,
 
     mv->goalX = target_x;
     mv->goalY = target_z;
+    mv->flowFieldKey = 0;
 
     if (matched_pending) {
       continue;
@@ -265,7 +447,41 @@ void CommandService::moveUnits(Engine::Core::World &world,
         mv->lastGoalY = target_z;
       } else {
 
+        // Warm start for pursuit: a unit chasing a moving target
+        // re-paths every repath cooldown, but successive goals shift by
+        // only a few cells, so the corridor the previous search
+        // explored is almost all still right. When the unit has a live
+        // path whose tail lands near the new goal, splice a
+        // corridor-bounded search from the old tail to the new goal and
+        // keep the rest, instead of re-exploring from scratch. Long
+        // pursuits eventually re-path in full once the spliced path
+        // grows past the cap, which also sheds accumulated detours.
+        if (!mv->pathPending && !mv->path.empty() &&
+            mv->path.size() < warm_splice_max_waypoints) {
+          Point const old_tail =
+              worldToGrid(mv->path.back().first, mv->path.back().second);
+          int const shift = std::abs(end.x - old_tail.x) +
+                            std::abs(end.y - old_tail.y);
+          if (shift > 0 && shift <= warm_splice_max_shift) {
+            auto spliced = s_pathfinder->repairPath(old_tail, end);
+            if (spliced.size() >= 2) {
+              for (std::size_t j = 1; j < spliced.size(); ++j) {
+                mv->path.emplace_back(static_cast<float>(spliced[j].x) +
+                                          s_pathfinder->getGridOffsetX(),
+                                      static_cast<float>(spliced[j].y) +
+                                          s_pathfinder->getGridOffsetZ());
+              }
+              mv->hasTarget = true;
+              mv->timeSinceLastPathRequest = 0.0F;
+              mv->lastGoalX = target_x;
+              mv->lastGoalY = target_z;
+              continue;
+            }
+          }
+        }
+
         bool skip_new_request = false;
+        std::uint64_t superseded_request_id = 0;
         {
           std::lock_guard<std::mutex> const lock(s_pendingMutex);
           auto existing_it = s_entityToRequest.find(units[i]);
@@ -278,6 +494,7 @@ void CommandService::moveUnits(Engine::Core::World &world,
                 pending_it->second.options = options;
                 skip_new_request = true;
               } else {
+                superseded_request_id = existing_it->second;
                 s_pendingRequests.erase(pending_it);
                 s_entityToRequest.erase(existing_it);
               }
@@ -287,6 +504,12 @@ void CommandService::moveUnits(Engine::Core::World &world,
           }
         }
 
+        if (superseded_request_id != 0) {
+          // The old order's search would only be discarded on arrival;
+          // cancel it before a worker spends an A* run on it.
+          s_pathfinder->cancelPathRequest(superseded_request_id);
+        }
+
         if (skip_new_request) {
           continue;
         }
@@ -308,7 +531,10 @@ void CommandService::moveUnits(Engine::Core::World &world,
           s_entityToRequest[units[i]] = request_id;
         }
 
-        s_pathfinder->submitPathRequest(request_id, start, end);
+        s_pathfinder->submitPathRequest(request_id, start, end,
+                                        options.backgroundPriority
+                                            ? PathPriority::Normal
+                                            : PathPriority::High);
 
         mv->timeSinceLastPathRequest = 0.0F;
         mv->lastGoalX = target_x;
@@ -330,8 +556,8 @@ void CommandService::moveUnits(Engine::Core::World &world,
 }
 
 void CommandService::moveGroup(Engine::Core::World &world,
-                               const std::vector<Engine::Core::EntityID> &units,
-                               const std::vector<QVector3D> &targets,
+                               std::span<const Engine::Core::EntityID> units,
+                               std::span<const QVector3D> targets,
                                const MoveOptions &options) {
   struct MemberInfo {
     Engine::Core::EntityID id;
@@ -494,8 +720,8 @@ void CommandService::moveGroup(Engine::Core::World &world,
     MoveOptions direct_options = options;
     direct_options.groupMove = false;
 
-    std::vector<Engine::Core::EntityID> direct_ids;
-    std::vector<QVector3D> direct_targets;
+    Engine::Core::FrameVector<Engine::Core::EntityID> direct_ids;
+    Engine::Core::FrameVector<QVector3D> direct_targets;
     direct_ids.reserve(members.size());
     direct_targets.reserve(members.size());
 
@@ -546,8 +772,8 @@ void CommandService::moveGroup(Engine::Core::World &world,
     MoveOptions direct_options = options;
     direct_options.groupMove = false;
 
-    std::vector<Engine::Core::EntityID> direct_ids;
-    std::vector<QVector3D> direct_targets;
+    Engine::Core::FrameVector<Engine::Core::EntityID> direct_ids;
+    Engine::Core::FrameVector<QVector3D> direct_targets;
     direct_ids.reserve(direct_members.size());
     direct_targets.reserve(direct_members.size());
 
@@ -611,6 +837,7 @@ void CommandService::moveGroup(Engine::Core::World &world,
     mv->path.clear();
     mv->pathPending = false;
     mv->pendingRequestId = 0;
+    mv->flowFieldKey = 0;
     units_needing_new_path.push_back(&member);
   }
 
@@ -660,6 +887,21 @@ void CommandService::moveGroup(Engine::Core::World &world,
     return;
   }
 
+  // Large groups steer off one shared field keyed on the destination
+  // instead of filing a path request per unit through the A* worker.
+  if (units_needing_new_path.size() >= FLOW_FIELD_MIN_GROUP) {
+    if (requestFlowField(end) != nullptr) {
+      std::uint64_t const key = flowFieldKeyFor(end);
+      for (auto *member : units_needing_new_path) {
+        member->movement->flowFieldKey = key;
+        member->movement->timeSinceLastPathRequest = 0.0F;
+        member->movement->lastGoalX = member->target.x();
+        member->movement->lastGoalY = member->target.z();
+      }
+      return;
+    }
+  }
+
   std::uint64_t const request_id =
       s_nextRequestId.fetch_add(1, std::memory_order_relaxed);
 
@@ -691,7 +933,10 @@ void CommandService::moveGroup(Engine::Core::World &world,
     }
   }
 
-  s_pathfinder->submitPathRequest(request_id, start, end);
+  s_pathfinder->submitPathRequest(request_id, start, end,
+                                  options.backgroundPriority
+                                      ? PathPriority::Normal
+                                      : PathPriority::High);
 }
 
 void CommandService::processPathResults(Engine::Core::World &world) {
@@ -728,6 +973,11 @@ void CommandService::processPathResults(Engine::Core::World &world) {
     const float skip_threshold_sq = CommandService::WAYPOINT_SKIP_THRESHOLD_SQ;
     const bool has_path = path_points.size() > 1;
 
+    // Members whose offset corridor crosses an obstacle cannot ride the
+    // leader's path; they collect here and re-path individually below.
+    Engine::Core::FrameVector<Engine::Core::EntityID> corridor_fallback_ids;
+    Engine::Core::FrameVector<QVector3D> corridor_fallback_targets;
+
     auto apply_to_member = [&](Engine::Core::EntityID member_id,
                                const QVector3D &target,
                                const QVector3D &offset) {
@@ -771,6 +1021,27 @@ void CommandService::processPathResults(Engine::Core::World &world) {
                                                 world_pos.z() + offset.z());
         }
 
+        // The leader's corridor is known clear, but a member's lateral
+        // offset can shove waypoints into a building footprint. Those
+        // members fall back to their own A* request instead of walking
+        // an invalid path.
+        if (offset.x() != 0.0F || offset.z() != 0.0F) {
+          bool corridor_ok = true;
+          for (const auto &waypoint : movement_component->path) {
+            Point const cell = worldToGrid(waypoint.first, waypoint.second);
+            if (!s_pathfinder->isWalkable(cell.x, cell.y)) {
+              corridor_ok = false;
+              break;
+            }
+          }
+          if (!corridor_ok) {
+            movement_component->path.clear();
+            corridor_fallback_ids.push_back(member_id);
+            corridor_fallback_targets.push_back(target);
+            return;
+          }
+        }
+
         while (!movement_component->path.empty()) {
           float const dx = movement_component->path.front().first -
                            member_transform->position.x;
@@ -843,6 +1114,16 @@ void CommandService::processPathResults(Engine::Core::World &world) {
         add_member(member_id, target);
       }
     }
+
+    if (!corridor_fallback_ids.empty()) {
+      // The extra depth scope keeps these internally generated moves out
+      // of the replay log, same as moveGroup's nested calls.
+      CommandDepthScope const corridor_scope;
+      MoveOptions fallback_options = request_info.options;
+      fallback_options.groupMove = false;
+      moveUnits(world, corridor_fallback_ids, corridor_fallback_targets,
+                fallback_options);
+    }
   }
 }
 
@@ -853,6 +1134,11 @@ void CommandService::attack_target(
   if (target_id == 0) {
     return;
   }
+
+  CommandDepthScope const command_scope;
+  if (command_scope.isTopLevel()) {
+    ReplayService::instance().recordAttack(units, target_id, shouldChase);
+  }
   for (auto unit_id : units) {
     auto *e = world.getEntity(unit_id);
     if (e == nullptr) {
@@ -956,4 +1242,213 @@ void CommandService::attack_target(
   }
 }
 
+auto CommandService::stopUnits(Engine::Core::World &world,
+                               std::span<const Engine::Core::EntityID> units)
+    -> bool {
+  CommandDepthScope const command_scope;
+  if (command_scope.isTopLevel()) {
+    ReplayService::instance().recordStop(units);
+  }
+
+  clearPendingRequests(units);
+
+  bool hold_released = false;
+  for (auto unit_id : units) {
+    auto *entity = world.getEntity(unit_id);
+    if (entity == nullptr) {
+      continue;
+    }
+
+    haltMovement(entity);
+    entity->removeComponent<Engine::Core::AttackTargetComponent>();
+
+    if (auto *patrol = entity->getComponent<Engine::Core::PatrolComponent>()) {
+      patrol->patrolling = false;
+      patrol->waypoints.clear();
+    }
+
+    auto *hold_mode = entity->getComponent<Engine::Core::HoldModeComponent>();
+    if ((hold_mode != nullptr) && hold_mode->active) {
+      hold_mode->active = false;
+      hold_mode->exitCooldown = hold_mode->standUpDuration;
+      hold_released = true;
+    }
+  }
+
+  return hold_released;
+}
+
+auto CommandService::toggleHoldMode(
+    Engine::Core::World &world,
+    std::span<const Engine::Core::EntityID> units) -> std::optional<bool> {
+  CommandDepthScope const command_scope;
+  if (command_scope.isTopLevel()) {
+    ReplayService::instance().recordHoldToggle(units);
+  }
+
+  std::optional<bool> last_change;
+  // Only units entering hold cancel their in-flight paths; other
+  // selected units (or ones leaving hold) keep theirs. Collected here
+  // and cleared in one batch after the sweep.
+  Engine::Core::FrameVector<Engine::Core::EntityID> entering_hold;
+  for (auto unit_id : units) {
+    auto *entity = world.getEntity(unit_id);
+    if (entity == nullptr) {
+      continue;
+    }
+
+    auto *unit = entity->getComponent<Engine::Core::UnitComponent>();
+    if ((unit == nullptr) ||
+        (unit->spawn_type != Game::Units::SpawnType::Archer &&
+         unit->spawn_type != Game::Units::SpawnType::Spearman)) {
+      continue;
+    }
+
+    auto *hold_mode = entity->getComponent<Engine::Core::HoldModeComponent>();
+    if ((hold_mode != nullptr) && hold_mode->active) {
+      hold_mode->active = false;
+      hold_mode->exitCooldown = hold_mode->standUpDuration;
+      last_change = false;
+      continue;
+    }
+
+    haltMovement(entity);
+    entering_hold.push_back(unit_id);
+    entity->removeComponent<Engine::Core::AttackTargetComponent>();
+
+    if (auto *patrol = entity->getComponent<Engine::Core::PatrolComponent>()) {
+      patrol->patrolling = false;
+      patrol->waypoints.clear();
+    }
+
+    if (hold_mode == nullptr) {
+      hold_mode = entity->addComponent<Engine::Core::HoldModeComponent>();
+    }
+    hold_mode->active = true;
+    hold_mode->exitCooldown = 0.0F;
+    last_change = true;
+  }
+
+  clearPendingRequests({entering_hold.data(), entering_hold.size()});
+
+  return last_change;
+}
+
+void CommandService::startPatrol(Engine::Core::World &world,
+                                 std::span<const Engine::Core::EntityID> units,
+                                 const QVector3D &first,
+                                 const QVector3D &second) {
+  CommandDepthScope const command_scope;
+  if (command_scope.isTopLevel()) {
+    ReplayService::instance().recordPatrol(units, first, second);
+  }
+
+  for (auto unit_id : units) {
+    auto *entity = world.getEntity(unit_id);
+    if (entity == nullptr) {
+      continue;
+    }
+
+    if (entity->getComponent<Engine::Core::BuildingComponent>() != nullptr) {
+      continue;
+    }
+
+    auto *patrol = entity->getComponent<Engine::Core::PatrolComponent>();
+    if (patrol == nullptr) {
+      patrol = entity->addComponent<Engine::Core::PatrolComponent>();
+    }
+
+    if (patrol != nullptr) {
+      patrol->waypoints.clear();
+      patrol->waypoints.emplace_back(first.x(), first.z());
+      patrol->waypoints.emplace_back(second.x(), second.z());
+      patrol->currentWaypoint = 0;
+      patrol->patrolling = true;
+    }
+
+    haltMovement(entity);
+    entity->removeComponent<Engine::Core::AttackTargetComponent>();
+  }
+
+  clearPendingRequests(units);
+}
+
+void CommandService::enqueueCommand(QueuedCommand &&command) {
+  command.timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                            std::chrono::steady_clock::now().time_since_epoch())
+                            .count();
+  std::lock_guard<std::mutex> const lock(s_queueMutex);
+  // Latest same-kind command for the same unit set wins; earlier pending
+  // ones would only be overridden a tick later anyway.
+  s_queuedCommands.erase(
+      std::remove_if(s_queuedCommands.begin(), s_queuedCommands.end(),
+                     [&](const QueuedCommand &pending) {
+                       return pending.kind == command.kind &&
+                              pending.units == command.units;
+                     }),
+      s_queuedCommands.end());
+  s_queuedCommands.push_back(std::move(command));
+}
+
+void CommandService::queueMove(std::vector<Engine::Core::EntityID> units,
+                               std::vector<QVector3D> targets,
+                               const MoveOptions &options) {
+  QueuedCommand command;
+  command.kind = QueuedCommand::Kind::Move;
+  command.units = std::move(units);
+  command.targets = std::move(targets);
+  command.options = options;
+  enqueueCommand(std::move(command));
+}
+
+void CommandService::queueAttack(std::vector<Engine::Core::EntityID> units,
+                                 Engine::Core::EntityID target_id,
+                                 bool shouldChase) {
+  QueuedCommand command;
+  command.kind = QueuedCommand::Kind::Attack;
+  command.units = std::move(units);
+  command.target_id = target_id;
+  command.shouldChase = shouldChase;
+  enqueueCommand(std::move(command));
+}
+
+void CommandService::queuePatrol(std::vector<Engine::Core::EntityID> units,
+                                 const QVector3D &first,
+                                 const QVector3D &second) {
+  QueuedCommand command;
+  command.kind = QueuedCommand::Kind::Patrol;
+  command.units = std::move(units);
+  command.patrolFirst = first;
+  command.patrolSecond = second;
+  enqueueCommand(std::move(command));
+}
+
+void CommandService::flushQueuedCommands(Engine::Core::World &world) {
+  std::vector<QueuedCommand> commands;
+  {
+    std::lock_guard<std::mutex> const lock(s_queueMutex);
+    if (s_queuedCommands.empty()) {
+      return;
+    }
+    commands.swap(s_queuedCommands);
+  }
+
+  // Enqueue order is timestamp order; apply as-is.
+  for (const auto &command : commands) {
+    switch (command.kind) {
+    case QueuedCommand::Kind::Move:
+      moveUnits(world, command.units, command.targets, command.options);
+      break;
+    case QueuedCommand::Kind::Attack:
+      attack_target(world, command.units, command.target_id,
+                    command.shouldChase);
+      break;
+    case QueuedCommand::Kind::Patrol:
+      startPatrol(world, command.units, command.patrolFirst,
+                  command.patrolSecond);
+      break;
+    }
+  }
+}
+
 } // namespace Game::Systems
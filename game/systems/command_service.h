@@ -2,9 +2,12 @@
 
 #include <QVector3D>
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <span>
 #include <unordered_map>
 #include <vector>
 
@@ -16,6 +19,7 @@ struct MovementComponent;
 
 namespace Game::Systems {
 
+class FlowField;
 class Pathfinding;
 struct Point;
 
@@ -25,32 +29,77 @@ public:
     bool allowDirectFallback = true;
     bool clearAttackIntent = true;
     bool groupMove = false;
+    // AI batch moves go to the low-priority pathfinding queue so
+    // player-issued commands are always served first.
+    bool backgroundPriority = false;
   };
 
   static constexpr int DIRECT_PATH_THRESHOLD = 8;
 
   static constexpr float WAYPOINT_SKIP_THRESHOLD_SQ = 0.16F;
 
+  // Groups at least this large share one flow field per destination
+  // instead of issuing per-unit path requests; smaller groups keep the
+  // per-unit A* path.
+  static constexpr std::size_t FLOW_FIELD_MIN_GROUP = 12;
+
   static void initialize(int worldWidth, int worldHeight);
 
   static auto getPathfinder() -> Pathfinding *;
 
   static void moveUnits(Engine::Core::World &world,
-                        const std::vector<Engine::Core::EntityID> &units,
-                        const std::vector<QVector3D> &targets);
+                        std::span<const Engine::Core::EntityID> units,
+                        std::span<const QVector3D> targets);
 
   static void moveUnits(Engine::Core::World &world,
-                        const std::vector<Engine::Core::EntityID> &units,
-                        const std::vector<QVector3D> &targets,
+                        std::span<const Engine::Core::EntityID> units,
+                        std::span<const QVector3D> targets,
                         const MoveOptions &options);
 
   static void processPathResults(Engine::Core::World &world);
 
+  // Resolves a MovementComponent::flowFieldKey; returns nullptr when the
+  // field was evicted or went stale after an obstacle change.
+  static auto getFlowField(std::uint64_t key)
+      -> std::shared_ptr<const FlowField>;
+
   static void attack_target(Engine::Core::World &world,
                             const std::vector<Engine::Core::EntityID> &units,
                             Engine::Core::EntityID target_id,
                             bool shouldChase = true);
 
+  // Halts the units and clears attack/patrol/hold intent; returns whether
+  // any unit left hold mode so callers can update hold-dependent UI.
+  static auto stopUnits(Engine::Core::World &world,
+                        std::span<const Engine::Core::EntityID> units) -> bool;
+
+  // Toggles hold mode on the units that support it (archers and
+  // spearmen); returns the last state change, or nullopt when nothing
+  // toggled.
+  static auto toggleHoldMode(Engine::Core::World &world,
+                             std::span<const Engine::Core::EntityID> units)
+      -> std::optional<bool>;
+
+  static void startPatrol(Engine::Core::World &world,
+                          std::span<const Engine::Core::EntityID> units,
+                          const QVector3D &first, const QVector3D &second);
+
+  // UI-issued commands are queued (cheap, callable from the UI thread)
+  // and applied in timestamp order at the next tick boundary by
+  // flushQueuedCommands, so input never mutates the world mid-tick.
+  // Re-queueing the same kind of command for the same unit set replaces
+  // the pending one, collapsing drag-move and repeated right-click spam
+  // into a single pathfinding request.
+  static void queueMove(std::vector<Engine::Core::EntityID> units,
+                        std::vector<QVector3D> targets,
+                        const MoveOptions &options);
+  static void queueAttack(std::vector<Engine::Core::EntityID> units,
+                          Engine::Core::EntityID target_id,
+                          bool shouldChase = true);
+  static void queuePatrol(std::vector<Engine::Core::EntityID> units,
+                          const QVector3D &first, const QVector3D &second);
+  static void flushQueuedCommands(Engine::Core::World &world);
+
 private:
   struct PendingPathRequest {
     Engine::Core::EntityID entity_id{};
@@ -67,12 +116,37 @@ private:
       s_entityToRequest;
   static std::mutex s_pendingMutex;
   static std::atomic<std::uint64_t> s_nextRequestId;
+  static std::unordered_map<std::uint64_t, std::shared_ptr<const FlowField>>
+      s_flowFields;
+  static std::mutex s_flowFieldMutex;
+  static auto requestFlowField(const Point &goal)
+      -> std::shared_ptr<const FlowField>;
   static auto worldToGrid(float world_x, float world_z) -> Point;
   static auto gridToWorld(const Point &gridPos) -> QVector3D;
+  struct QueuedCommand {
+    enum class Kind : std::uint8_t { Move, Attack, Patrol };
+    Kind kind = Kind::Move;
+    std::vector<Engine::Core::EntityID> units;
+    std::vector<QVector3D> targets;
+    Engine::Core::EntityID target_id{0};
+    bool shouldChase{true};
+    QVector3D patrolFirst;
+    QVector3D patrolSecond;
+    MoveOptions options;
+    std::int64_t timestampMs{0};
+  };
+  static std::vector<QueuedCommand> s_queuedCommands;
+  static std::mutex s_queueMutex;
+  static void enqueueCommand(QueuedCommand &&command);
   static void clearPendingRequest(Engine::Core::EntityID entity_id);
+  // Batch form for multi-unit commands: takes the pending-request lock
+  // once for the whole selection and cancels the affected path requests
+  // in one pathfinder call, instead of a lock pair per unit.
+  static void
+  clearPendingRequests(std::span<const Engine::Core::EntityID> units);
   static void moveGroup(Engine::Core::World &world,
-                        const std::vector<Engine::Core::EntityID> &units,
-                        const std::vector<QVector3D> &targets,
+                        std::span<const Engine::Core::EntityID> units,
+                        std::span<const QVector3D> targets,
                         const MoveOptions &options);
 };
 
@@ -0,0 +1,101 @@
+#include "flow_field.h"
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <queue>
+
+namespace Game::Systems {
+
+namespace {
+constexpr int k_unreachable = std::numeric_limits<int>::max();
+} // namespace
+
+FlowField::FlowField(const Pathfinding &grid, int width, int height,
+                     const Point &goal, std::uint32_t obstacle_version)
+    : m_width(width), m_height(height), m_goal(goal),
+      m_version(obstacle_version) {
+  m_cost.assign(static_cast<std::size_t>(width) * height, k_unreachable);
+
+  if (!grid.isWalkable(goal.x, goal.y)) {
+    return;
+  }
+
+  std::queue<Point> frontier;
+  m_cost[static_cast<std::size_t>(toIndex(goal.x, goal.y))] = 0;
+  frontier.push(goal);
+
+  constexpr std::array<std::pair<int, int>, 8> offsets = {
+      {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}}};
+
+  while (!frontier.empty()) {
+    Point const current = frontier.front();
+    frontier.pop();
+    int const next_cost =
+        m_cost[static_cast<std::size_t>(toIndex(current.x, current.y))] + 1;
+
+    for (const auto &[dx, dy] : offsets) {
+      int const nx = current.x + dx;
+      int const ny = current.y + dy;
+      if (!grid.isWalkable(nx, ny)) {
+        continue;
+      }
+      if (dx != 0 && dy != 0 &&
+          (!grid.isWalkable(current.x + dx, current.y) ||
+           !grid.isWalkable(current.x, current.y + dy))) {
+        continue;
+      }
+      auto const neighbor_idx = static_cast<std::size_t>(toIndex(nx, ny));
+      if (m_cost[neighbor_idx] != k_unreachable) {
+        continue;
+      }
+      m_cost[neighbor_idx] = next_cost;
+      frontier.push({nx, ny});
+    }
+  }
+}
+
+auto FlowField::costAt(int x, int y) const -> int {
+  if (x < 0 || x >= m_width || y < 0 || y >= m_height) {
+    return k_unreachable;
+  }
+  return m_cost[static_cast<std::size_t>(toIndex(x, y))];
+}
+
+auto FlowField::isReachable(const Point &cell) const -> bool {
+  return costAt(cell.x, cell.y) != k_unreachable;
+}
+
+auto FlowField::nextStep(const Point &from, Point &out_next) const -> bool {
+  int const here = costAt(from.x, from.y);
+  if (here == k_unreachable || here == 0) {
+    return false;
+  }
+
+  constexpr std::array<std::pair<int, int>, 8> offsets = {
+      {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}}};
+
+  int best_cost = here;
+  Point best = from;
+  for (const auto &[dx, dy] : offsets) {
+    int const nx = from.x + dx;
+    int const ny = from.y + dy;
+    int const cost = costAt(nx, ny);
+    if (cost >= best_cost) {
+      continue;
+    }
+    if (dx != 0 && dy != 0 && (costAt(from.x + dx, from.y) == k_unreachable ||
+                               costAt(from.x, from.y + dy) == k_unreachable)) {
+      continue;
+    }
+    best_cost = cost;
+    best = {nx, ny};
+  }
+
+  if (best_cost >= here) {
+    return false;
+  }
+  out_next = best;
+  return true;
+}
+
+} // namespace Game::Systems
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "pathfinding.h"
+#include <cstdint>
+#include <vector>
+
+namespace Game::Systems {
+
+// Shared steering field for group move commands. One breadth-first
+// integration pass from the goal cell assigns every reachable cell its
+// step distance to the goal; units then steer by stepping toward the
+// cheapest neighbor instead of each running their own A* search. Movement
+// rules match the grid search (8-way, no corner cutting, uniform step
+// cost), so the greedy descent reproduces an optimal grid path.
+//
+// Immutable once built; safe to share across units and read without
+// locking. A field is only valid for the obstacle layout it was built
+// against — compare obstacleVersion() before reuse.
+class FlowField {
+public:
+  FlowField(const Pathfinding &grid, int width, int height, const Point &goal,
+            std::uint32_t obstacle_version);
+
+  auto goal() const -> const Point & { return m_goal; }
+  auto obstacleVersion() const -> std::uint32_t { return m_version; }
+
+  auto isReachable(const Point &cell) const -> bool;
+
+  // Writes the neighbor one step closer to the goal into out_next.
+  // Returns false when the cell is outside the grid, unreachable, or
+  // already the goal.
+  auto nextStep(const Point &from, Point &out_next) const -> bool;
+
+private:
+  auto toIndex(int x, int y) const -> int { return y * m_width + x; }
+  auto costAt(int x, int y) const -> int;
+
+  int m_width;
+  int m_height;
+  Point m_goal;
+  std::uint32_t m_version;
+  std::vector<int> m_cost;
+};
+
+} // namespace Game::Systems
@@ -2,6 +2,8 @@
 
 #include <QVector3D>
 #include <cmath>
+#include <cstddef>
+#include <limits>
 #include <vector>
 
 namespace Game::Systems {
@@ -25,6 +27,94 @@ public:
     }
     return out;
   }
+
+  // Reorders formation slots so slot assignSlots(...)[i] belongs to the
+  // unit at unitPositions[i]. Index-order assignment sends units across
+  // each other whenever the formation turns; a greedy auction on squared
+  // distance gets each unit a near-optimal slot, cutting path length and
+  // the avoidance churn of crossing moves. Bid rounds are capped so 300
+  // units stay well under a millisecond; leftovers after the cap fall
+  // back to nearest-free-slot.
+  static auto assignSlots(const std::vector<QVector3D> &slots,
+                          const std::vector<QVector3D> &unitPositions)
+      -> std::vector<QVector3D> {
+    std::size_t const n = slots.size();
+    if (n < 2 || unitPositions.size() != n) {
+      return slots;
+    }
+
+    auto slot_value = [&](std::size_t unit, std::size_t slot) -> float {
+      float const dx = slots[slot].x() - unitPositions[unit].x();
+      float const dz = slots[slot].z() - unitPositions[unit].z();
+      return -(dx * dx + dz * dz);
+    };
+
+    std::vector<float> price(n, 0.0F);
+    std::vector<int> slot_owner(n, -1);
+    std::vector<int> unit_slot(n, -1);
+    std::vector<std::size_t> unassigned;
+    unassigned.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      unassigned.push_back(i);
+    }
+
+    constexpr float k_bid_epsilon = 0.01F;
+    std::size_t bids_left = 8 * n;
+
+    while (!unassigned.empty() && bids_left > 0) {
+      --bids_left;
+      std::size_t const unit = unassigned.back();
+      unassigned.pop_back();
+
+      std::size_t best_slot = 0;
+      float best_net = std::numeric_limits<float>::lowest();
+      float second_net = std::numeric_limits<float>::lowest();
+      for (std::size_t slot = 0; slot < n; ++slot) {
+        float const net = slot_value(unit, slot) - price[slot];
+        if (net > best_net) {
+          second_net = best_net;
+          best_net = net;
+          best_slot = slot;
+        } else if (net > second_net) {
+          second_net = net;
+        }
+      }
+
+      price[best_slot] += best_net - second_net + k_bid_epsilon;
+      if (slot_owner[best_slot] >= 0) {
+        unit_slot[slot_owner[best_slot]] = -1;
+        unassigned.push_back(static_cast<std::size_t>(slot_owner[best_slot]));
+      }
+      slot_owner[best_slot] = static_cast<int>(unit);
+      unit_slot[unit] = static_cast<int>(best_slot);
+    }
+
+    // Bid cap reached with units still waiting: hand each the nearest
+    // slot nobody owns.
+    for (std::size_t const unit : unassigned) {
+      std::size_t best_slot = 0;
+      float best_value = std::numeric_limits<float>::lowest();
+      for (std::size_t slot = 0; slot < n; ++slot) {
+        if (slot_owner[slot] >= 0) {
+          continue;
+        }
+        float const value = slot_value(unit, slot);
+        if (value > best_value) {
+          best_value = value;
+          best_slot = slot;
+        }
+      }
+      slot_owner[best_slot] = static_cast<int>(unit);
+      unit_slot[unit] = static_cast<int>(best_slot);
+    }
+
+    std::vector<QVector3D> out;
+    out.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      out.push_back(slots[static_cast<std::size_t>(unit_slot[i])]);
+    }
+    return out;
+  }
 };
 
 } // namespace Game::Systems
@@ -6,7 +6,9 @@
 #include "owner_registry.h"
 #include "units/spawn_type.h"
 #include <chrono>
+#include <memory>
 #include <unordered_map>
+#include <utility>
 
 namespace Game::Systems {
 
@@ -33,7 +35,41 @@ void GlobalStatsRegistry::initialize() {
           });
 }
 
-void GlobalStatsRegistry::clear() { m_playerStats.clear(); }
+void GlobalStatsRegistry::clear() {
+  m_playerStats.clear();
+  publishSnapshot();
+}
+
+// All mutation happens on the simulation thread via the event
+// subscriptions above, so there is no write-side contention to shed; the
+// published snapshot exists for readers on other threads. Owner counts
+// are tiny, so the copy per mutation is a few cache lines.
+void GlobalStatsRegistry::publishSnapshot() {
+  auto snap = std::make_shared<StatsSnapshot>();
+  snap->version = ++m_snapshotVersion;
+  snap->players.reserve(m_playerStats.size());
+  for (const auto &[owner_id, stats] : m_playerStats) {
+    snap->players.emplace_back(owner_id, stats);
+  }
+  m_snapshot.store(std::move(snap), std::memory_order_release);
+}
+
+auto GlobalStatsRegistry::snapshot() const
+    -> std::shared_ptr<const StatsSnapshot> {
+  return m_snapshot.load(std::memory_order_acquire);
+}
+
+auto GlobalStatsRegistry::snapshotStats(int owner_id) const -> PlayerStats {
+  auto snap = snapshot();
+  if (snap) {
+    for (const auto &[id, stats] : snap->players) {
+      if (id == owner_id) {
+        return stats;
+      }
+    }
+  }
+  return {};
+}
 
 auto GlobalStatsRegistry::getStats(int owner_id) const -> const PlayerStats * {
   auto it = m_playerStats.find(owner_id);
@@ -56,6 +92,7 @@ void GlobalStatsRegistry::markGameStart(int owner_id) {
   stats.gameStartTime = std::chrono::steady_clock::now();
   stats.gameEnded = false;
   stats.playTimeSec = 0.0F;
+  publishSnapshot();
 }
 
 void GlobalStatsRegistry::markGameEnd(int owner_id) {
@@ -67,6 +104,7 @@ void GlobalStatsRegistry::markGameEnd(int owner_id) {
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
         it->second.gameEndTime - it->second.gameStartTime);
     it->second.playTimeSec = duration.count() / 1000.0F;
+    publishSnapshot();
   }
 }
 
@@ -84,6 +122,7 @@ void GlobalStatsRegistry::onUnitSpawned(
 
     stats.barracksOwned++;
   }
+  publishSnapshot();
 }
 
 void GlobalStatsRegistry::onUnitDied(const Engine::Core::UnitDiedEvent &event) {
@@ -113,6 +152,7 @@ void GlobalStatsRegistry::onUnitDied(const Engine::Core::UnitDiedEvent &event) {
       }
     }
   }
+  publishSnapshot();
 }
 
 void GlobalStatsRegistry::onBarrackCaptured(
@@ -128,6 +168,7 @@ void GlobalStatsRegistry::onBarrackCaptured(
 
   auto &new_stats = m_playerStats[event.newOwnerId];
   new_stats.barracksOwned++;
+  publishSnapshot();
 }
 
 void GlobalStatsRegistry::rebuildFromWorld(Engine::Core::World &world) {
@@ -161,6 +202,7 @@ void GlobalStatsRegistry::rebuildFromWorld(Engine::Core::World &world) {
       stats.troopsRecruited += individuals_per_unit;
     }
   }
+  publishSnapshot();
 }
 
 } // namespace Game::Systems
@@ -1,8 +1,13 @@
 #pragma once
 
 #include "../core/event_manager.h"
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <memory>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace Engine::Core {
 class World;
@@ -30,6 +35,20 @@ public:
   auto getStats(int owner_id) const -> const PlayerStats *;
   auto getStats(int owner_id) -> PlayerStats *;
 
+  // Immutable copy of all player stats, published by the simulation
+  // thread after every mutation. version increases monotonically so
+  // polling consumers can skip unchanged snapshots.
+  struct StatsSnapshot {
+    std::uint64_t version = 0;
+    std::vector<std::pair<int, PlayerStats>> players;
+  };
+
+  // Read side for other threads (QML stats panel): grabs the latest
+  // published snapshot without taking a lock, so readers never block the
+  // simulation thread. getStats() remains the cheap same-thread accessor.
+  [[nodiscard]] auto snapshot() const -> std::shared_ptr<const StatsSnapshot>;
+  [[nodiscard]] auto snapshotStats(int owner_id) const -> PlayerStats;
+
   void markGameStart(int owner_id);
 
   void markGameEnd(int owner_id);
@@ -46,7 +65,11 @@ private:
   GlobalStatsRegistry(const GlobalStatsRegistry &) = delete;
   auto operator=(const GlobalStatsRegistry &) -> GlobalStatsRegistry & = delete;
 
+  void publishSnapshot();
+
   std::unordered_map<int, PlayerStats> m_playerStats;
+  std::atomic<std::shared_ptr<const StatsSnapshot>> m_snapshot;
+  std::uint64_t m_snapshotVersion = 0;
 
   Engine::Core::ScopedEventSubscription<Engine::Core::UnitSpawnedEvent>
       m_unitSpawnedSubscription;
@@ -1,13 +1,20 @@
 #include "movement_system.h"
+#include "../core/frame_arena.h"
+#include "../core/sim_math.h"
+#include "../game_config.h"
 #include "../map/terrain_service.h"
 #include "building_collision_registry.h"
 #include "command_service.h"
 #include "core/component.h"
+#include "flow_field.h"
 #include "map/terrain.h"
 #include "pathfinding.h"
+#include "spatial_grid.h"
 #include <QVector3D>
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include <numbers>
 #include <qvectornd.h>
 #include <vector>
@@ -15,7 +22,15 @@
 namespace Game::Systems {
 
 static constexpr int max_waypoint_skip_count = 4;
-static constexpr float repath_cooldown_seconds = 0.4F;
+// Movement tuning cached once per tick from GameConfig (sim thread
+// only), so the steering loops read plain floats instead of going
+// through the double-buffered slots per neighbor.
+static MovementConfig s_tuning;
+// Sleeping units still get a full steering pass every this many ticks
+// (staggered by entity id) so stuck-recovery keeps its chance to fire.
+static constexpr std::uint64_t k_sleep_wake_period = 8;
+// Damped velocities decay asymptotically; below this they count as rest.
+static constexpr float k_sleep_velocity_epsilon = 1e-3F;
 
 namespace {
 
@@ -84,17 +99,360 @@ auto isSegmentWalkable(const QVector3D &from, const QVector3D &to,
   return end_allowed && exited_blocked_zone;
 }
 
+// Refreshes the segment target for a unit steering by a shared group flow
+// field. Clears flowFieldKey once the unit is near its own goal (direct
+// approach finishes the move) or when the field is gone or stale, in which
+// case the stuck-recovery repath below requests an individual path.
+void updateFlowFieldTarget(Engine::Core::MovementComponent *movement,
+                           const Engine::Core::TransformComponent *transform) {
+  auto field = CommandService::getFlowField(movement->flowFieldKey);
+  Pathfinding *pathfinder = CommandService::getPathfinder();
+  if (field == nullptr || pathfinder == nullptr) {
+    movement->flowFieldKey = 0;
+    return;
+  }
+
+  float const goal_dx = movement->goalX - transform->position.x;
+  float const goal_dz = movement->goalY - transform->position.z;
+  constexpr float k_handover_distance_sq = 2.0F * 2.0F;
+  if (goal_dx * goal_dx + goal_dz * goal_dz <= k_handover_distance_sq) {
+    movement->flowFieldKey = 0;
+    movement->target_x = movement->goalX;
+    movement->target_y = movement->goalY;
+    movement->hasTarget = true;
+    movement->path.clear();
+    return;
+  }
+
+  Point const cell{static_cast<int>(std::round(transform->position.x -
+                                               pathfinder->getGridOffsetX())),
+                   static_cast<int>(std::round(transform->position.z -
+                                               pathfinder->getGridOffsetZ()))};
+  Point next;
+  if (!field->nextStep(cell, next)) {
+    movement->flowFieldKey = 0;
+    return;
+  }
+
+  movement->target_x =
+      static_cast<float>(next.x) + pathfinder->getGridOffsetX();
+  movement->target_y =
+      static_cast<float>(next.y) + pathfinder->getGridOffsetZ();
+  movement->hasTarget = true;
+  movement->path.clear();
+}
+
+// Splices a corridor-bounded repair around a blocked stretch of the
+// current path: scan a few waypoints ahead for one that is still
+// walkable, re-search only the corridor between here and there, and keep
+// the rest of the path. Returns false when no corridor route exists and
+// the caller should fall back to a full path request.
+auto tryRepairPath(Engine::Core::MovementComponent *movement,
+                   const Engine::Core::TransformComponent *transform,
+                   Engine::Core::EntityID entityId) -> bool {
+  Pathfinding *pathfinder = CommandService::getPathfinder();
+  if (pathfinder == nullptr || movement->path.empty()) {
+    return false;
+  }
+
+  float const offset_x = pathfinder->getGridOffsetX();
+  float const offset_z = pathfinder->getGridOffsetZ();
+  Point const from{static_cast<int>(std::round(transform->position.x - offset_x)),
+                   static_cast<int>(
+                       std::round(transform->position.z - offset_z))};
+  if (!pathfinder->isWalkable(from.x, from.y)) {
+    return false;
+  }
+
+  constexpr std::size_t k_max_rejoin_scan = 12;
+  std::size_t const scan_limit =
+      std::min(movement->path.size(), k_max_rejoin_scan);
+  QVector3D const current_pos(transform->position.x, 0.0F,
+                              transform->position.z);
+
+  for (std::size_t i = 0; i < scan_limit; ++i) {
+    Point const rejoin{
+        static_cast<int>(std::round(movement->path[i].first - offset_x)),
+        static_cast<int>(std::round(movement->path[i].second - offset_z))};
+    if (rejoin == from || !pathfinder->isWalkable(rejoin.x, rejoin.y)) {
+      continue;
+    }
+
+    auto repaired = pathfinder->repairPath(from, rejoin);
+    if (repaired.size() < 2) {
+      continue;
+    }
+
+    QVector3D const first_waypoint(
+        static_cast<float>(repaired[1].x) + offset_x, 0.0F,
+        static_cast<float>(repaired[1].y) + offset_z);
+    if (!isSegmentWalkable(current_pos, first_waypoint, entityId)) {
+      continue;
+    }
+
+    std::vector<std::pair<float, float>> new_path;
+    new_path.reserve(repaired.size() - 1 + movement->path.size() - (i + 1));
+    for (std::size_t j = 1; j < repaired.size(); ++j) {
+      new_path.emplace_back(static_cast<float>(repaired[j].x) + offset_x,
+                            static_cast<float>(repaired[j].y) + offset_z);
+    }
+    new_path.insert(new_path.end(), movement->path.begin() + i + 1,
+                    movement->path.end());
+
+    movement->path = std::move(new_path);
+    movement->target_x = movement->path.front().first;
+    movement->target_y = movement->path.front().second;
+    movement->hasTarget = true;
+    return true;
+  }
+
+  return false;
+}
+
+// Reciprocal velocity-obstacle avoidance: each mover looks up its
+// neighbors in the spatial grid, predicts the closest approach against
+// their current velocities inside a short time horizon, and steers
+// sideways off predicted contacts before integration. Congestion then
+// resolves locally in O(neighbors) instead of through repeated global
+// re-paths. Standing units contribute as obstacles but do not steer;
+// moving pairs each take half the correction so they pass on opposite
+// sides. Radii and horizon come from the movement tuning cached in
+// s_tuning.
+
+void applyLocalAvoidance(Engine::Core::Entity *entity,
+                         Engine::Core::World *world,
+                         Engine::Core::MovementComponent *movement,
+                         const Engine::Core::TransformComponent *transform,
+                         float max_speed) {
+  float const speed_sq =
+      movement->vx * movement->vx + movement->vz * movement->vz;
+  if (speed_sq < 1e-4F) {
+    return;
+  }
+
+  float avoid_x = 0.0F;
+  float avoid_z = 0.0F;
+
+  SpatialGrid::instance().forEachInRadius(
+      transform->position.x, transform->position.z,
+      s_tuning.avoidNeighborRadius, [&](const SpatialGrid::Entry &entry) {
+        if (entry.id == entity->getId() || entry.isBuilding) {
+          return;
+        }
+
+        // Grid positions are a tick old; read the live transform and
+        // velocity for the actual prediction.
+        auto *other = world->getEntity(entry.id);
+        if (other == nullptr) {
+          return;
+        }
+        auto *other_transform =
+            other->getComponent<Engine::Core::TransformComponent>();
+        if (other_transform == nullptr) {
+          return;
+        }
+        auto *other_movement =
+            other->getComponent<Engine::Core::MovementComponent>();
+
+        float const px = other_transform->position.x - transform->position.x;
+        float const pz = other_transform->position.z - transform->position.z;
+        float const dist_sq = px * px + pz * pz;
+        if (dist_sq < 1e-6F || dist_sq > s_tuning.avoidNeighborRadius *
+                                             s_tuning.avoidNeighborRadius) {
+          return;
+        }
+
+        float rel_vx = movement->vx;
+        float rel_vz = movement->vz;
+        float weight = 1.0F;
+        if (other_movement != nullptr) {
+          rel_vx -= other_movement->vx;
+          rel_vz -= other_movement->vz;
+          float const other_speed_sq =
+              other_movement->vx * other_movement->vx +
+              other_movement->vz * other_movement->vz;
+          if (other_speed_sq > 1e-4F) {
+            weight = 0.5F;
+          }
+        }
+
+        float const closing = rel_vx * px + rel_vz * pz;
+        if (closing <= 0.0F) {
+          return;
+        }
+        float const rel_speed_sq = rel_vx * rel_vx + rel_vz * rel_vz;
+        if (rel_speed_sq < 1e-6F) {
+          return;
+        }
+
+        float const t_cpa = closing / rel_speed_sq;
+        if (t_cpa > s_tuning.avoidTimeHorizon) {
+          return;
+        }
+
+        float const cpa_x = px - rel_vx * t_cpa;
+        float const cpa_z = pz - rel_vz * t_cpa;
+        float const cpa_dist = std::sqrt(cpa_x * cpa_x + cpa_z * cpa_z);
+        if (cpa_dist >= s_tuning.avoidCombinedRadius) {
+          return;
+        }
+
+        float push_x = 0.0F;
+        float push_z = 0.0F;
+        if (cpa_dist > 1e-4F) {
+          push_x = -cpa_x / cpa_dist;
+          push_z = -cpa_z / cpa_dist;
+        } else {
+          // Dead-on collision course: both sides deterministically dodge
+          // to their own left, which mirrors to opposite sides.
+          float const inv_dist = 1.0F / std::sqrt(dist_sq);
+          push_x = -pz * inv_dist;
+          push_z = px * inv_dist;
+        }
+
+        float const urgency =
+            (1.0F - cpa_dist / s_tuning.avoidCombinedRadius) *
+            (1.0F - t_cpa / s_tuning.avoidTimeHorizon);
+        avoid_x += push_x * urgency * weight;
+        avoid_z += push_z * urgency * weight;
+      });
+
+  if (avoid_x == 0.0F && avoid_z == 0.0F) {
+    return;
+  }
+
+  float const avoid_sq = avoid_x * avoid_x + avoid_z * avoid_z;
+  if (avoid_sq > 1.0F) {
+    float const inv = 1.0F / std::sqrt(avoid_sq);
+    avoid_x *= inv;
+    avoid_z *= inv;
+  }
+
+  movement->vx += avoid_x * max_speed;
+  movement->vz += avoid_z * max_speed;
+
+  float const new_speed_sq =
+      movement->vx * movement->vx + movement->vz * movement->vz;
+  if (new_speed_sq > max_speed * max_speed) {
+    float const scale = max_speed / std::sqrt(new_speed_sq);
+    movement->vx *= scale;
+    movement->vz *= scale;
+  }
+}
+
 } // namespace
 
 void MovementSystem::update(Engine::Core::World *world, float deltaTime) {
+  s_tuning = GameConfig::instance().movement();
   CommandService::processPathResults(*world);
-  auto entities = world->getEntitiesWith<Engine::Core::MovementComponent>();
-
+  const auto &entities = world->view<Engine::Core::MovementComponent>();
+
+  // Steering pass: all the branchy per-unit work (waypoints, repaths,
+  // avoidance, yaw) runs here and leaves its result in the velocity
+  // fields; nobody integrates positions yet, so every unit sees the same
+  // start-of-frame positions regardless of iteration order.
+  m_batchTransforms.clear();
+  m_batchPosX.clear();
+  m_batchPosZ.clear();
+  m_batchVelX.clear();
+  m_batchVelZ.clear();
+  m_batchTransforms.reserve(entities.size());
+  m_batchPosX.reserve(entities.size());
+  m_batchPosZ.reserve(entities.size());
+  m_batchVelX.reserve(entities.size());
+  m_batchVelZ.reserve(entities.size());
+
+  ++m_tick;
   for (auto *entity : entities) {
+    // Sleep gate: idle garrisoned units skip the branchy steering work
+    // and the integration batch entirely. Eligibility reads only
+    // component fields, so a fresh order wakes the unit on the very next
+    // tick; the staggered periodic pass covers the slow paths (stuck
+    // recovery) that need an occasional full run even while idle.
+    auto *movement = entity->getComponent<Engine::Core::MovementComponent>();
+    if ((movement != nullptr) && isSleepEligible(entity, movement) &&
+        ((m_tick + entity->getId()) % k_sleep_wake_period) != 0) {
+      continue;
+    }
+
     moveUnit(entity, world, deltaTime);
+
+    auto *transform = entity->getComponent<Engine::Core::TransformComponent>();
+    if ((transform == nullptr) || (movement == nullptr)) {
+      continue;
+    }
+    m_batchTransforms.push_back(transform);
+    m_batchPosX.push_back(transform->position.x);
+    m_batchPosZ.push_back(transform->position.z);
+    m_batchVelX.push_back(movement->vx);
+    m_batchVelZ.push_back(movement->vz);
+  }
+
+  // Map bounds are hoisted out of the loop; the old per-unit terrain
+  // lookup dominated the integration cost.
+  float min_x = std::numeric_limits<float>::lowest();
+  float max_x = std::numeric_limits<float>::max();
+  float min_z = std::numeric_limits<float>::lowest();
+  float max_z = std::numeric_limits<float>::max();
+  auto &terrain = Game::Map::TerrainService::instance();
+  if (terrain.isInitialized()) {
+    const Game::Map::TerrainHeightMap *hm = terrain.getHeightMap();
+    if (hm != nullptr && hm->getWidth() > 0 && hm->getHeight() > 0) {
+      const float tile = hm->getTileSize();
+      const float half_w = hm->getWidth() * 0.5F - 0.5F;
+      const float half_h = hm->getHeight() * 0.5F - 0.5F;
+      min_x = -half_w * tile;
+      max_x = half_w * tile;
+      min_z = -half_h * tile;
+      max_z = half_h * tile;
+    }
+  }
+
+  // Integration sweep: contiguous float arrays, no branches, no pointer
+  // chasing — the compiler vectorizes this. simIntegrate inlines to the
+  // plain expression in the default float build; the fixed-point build
+  // trades the vectorization for cross-machine determinism.
+  std::size_t const count = m_batchTransforms.size();
+  for (std::size_t i = 0; i < count; ++i) {
+    m_batchPosX[i] = std::clamp(
+        Engine::Core::simIntegrate(m_batchPosX[i], m_batchVelX[i], deltaTime),
+        min_x, max_x);
+    m_batchPosZ[i] = std::clamp(
+        Engine::Core::simIntegrate(m_batchPosZ[i], m_batchVelZ[i], deltaTime),
+        min_z, max_z);
+  }
+
+  for (std::size_t i = 0; i < count; ++i) {
+    m_batchTransforms[i]->position.x = m_batchPosX[i];
+    m_batchTransforms[i]->position.z = m_batchPosZ[i];
   }
 }
 
+auto MovementSystem::isSleepEligible(
+    Engine::Core::Entity *entity,
+    const Engine::Core::MovementComponent *movement) -> bool {
+  if (movement->hasTarget || movement->pathPending ||
+      movement->flowFieldKey != 0) {
+    return false;
+  }
+  if (std::fabs(movement->vx) > k_sleep_velocity_epsilon ||
+      std::fabs(movement->vz) > k_sleep_velocity_epsilon) {
+    return false;
+  }
+  auto *transform = entity->getComponent<Engine::Core::TransformComponent>();
+  if ((transform == nullptr) || transform->hasDesiredYaw) {
+    return false;
+  }
+  if (auto *hold_mode =
+          entity->getComponent<Engine::Core::HoldModeComponent>()) {
+    // Hold mode ticks its own cooldown and yaw settling inside moveUnit.
+    if (hold_mode->active || hold_mode->exitCooldown > 0.0F) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void MovementSystem::moveUnit(Engine::Core::Entity *entity,
                               Engine::Core::World *world, float deltaTime) {
   auto *transform = entity->getComponent<Engine::Core::TransformComponent>();
@@ -166,6 +524,10 @@ void MovementSystem::moveUnit(Engine::Core::Entity *entity,
     return;
   }
 
+  if (movement->flowFieldKey != 0) {
+    updateFlowFieldTarget(movement, transform);
+  }
+
   QVector3D const final_goal(movement->goalX, 0.0F, movement->goalY);
   bool const destination_allowed = isPointAllowed(final_goal, entity->getId());
 
@@ -205,10 +567,11 @@ void MovementSystem::moveUnit(Engine::Core::Entity *entity,
       CommandService::MoveOptions opts;
       opts.clearAttackIntent = false;
       opts.allowDirectFallback = true;
-      std::vector<Engine::Core::EntityID> const ids = {entity->getId()};
-      std::vector<QVector3D> const targets = {final_goal};
+      Engine::Core::FrameVector<Engine::Core::EntityID> const ids = {
+          entity->getId()};
+      Engine::Core::FrameVector<QVector3D> const targets = {final_goal};
       CommandService::moveUnits(*world, ids, targets, opts);
-      movement->repathCooldown = repath_cooldown_seconds;
+      movement->repathCooldown = s_tuning.repathCooldownSeconds;
       requested_recovery_move = true;
     }
 
@@ -260,6 +623,8 @@ void MovementSystem::moveUnit(Engine::Core::Entity *entity,
     if (!isSegmentWalkable(current_pos, segment_target, entity->getId())) {
       if (try_advance_past_blocked_segment()) {
 
+      } else if (tryRepairPath(movement, transform, entity->getId())) {
+        refresh_segment_target();
       } else {
         bool issued_path_request = false;
         if (!movement->pathPending && movement->repathCooldown <= 0.0F) {
@@ -268,11 +633,12 @@ void MovementSystem::moveUnit(Engine::Core::Entity *entity,
             CommandService::MoveOptions opts;
             opts.clearAttackIntent = false;
             opts.allowDirectFallback = false;
-            std::vector<Engine::Core::EntityID> const ids = {entity->getId()};
-            std::vector<QVector3D> const targets = {
+            Engine::Core::FrameVector<Engine::Core::EntityID> const ids = {
+                entity->getId()};
+            Engine::Core::FrameVector<QVector3D> const targets = {
                 QVector3D(movement->goalX, 0.0F, movement->goalY)};
             CommandService::moveUnits(*world, ids, targets, opts);
-            movement->repathCooldown = repath_cooldown_seconds;
+            movement->repathCooldown = s_tuning.repathCooldownSeconds;
             issued_path_request = true;
           }
         }
@@ -337,37 +703,22 @@ void MovementSystem::moveUnit(Engine::Core::Entity *entity,
 
       float const ax = (desired_vx - movement->vx) * accel;
       float const az = (desired_vz - movement->vz) * accel;
-      movement->vx += ax * deltaTime;
-      movement->vz += az * deltaTime;
+      movement->vx = Engine::Core::simIntegrate(movement->vx, ax, deltaTime);
+      movement->vz = Engine::Core::simIntegrate(movement->vz, az, deltaTime);
 
-      movement->vx *= std::max(0.0F, 1.0F - 0.5F * damping * deltaTime);
-      movement->vz *= std::max(0.0F, 1.0F - 0.5F * damping * deltaTime);
+      float const decay = std::max(0.0F, 1.0F - 0.5F * damping * deltaTime);
+      movement->vx = Engine::Core::simScale(movement->vx, decay);
+      movement->vz = Engine::Core::simScale(movement->vz, decay);
     }
   }
 
-  transform->position.x += movement->vx * deltaTime;
-  transform->position.z += movement->vz * deltaTime;
-
-  auto &terrain = Game::Map::TerrainService::instance();
-  if (terrain.isInitialized()) {
-    const Game::Map::TerrainHeightMap *hm = terrain.getHeightMap();
-    if (hm != nullptr) {
-      const float tile = hm->getTileSize();
-      const int w = hm->getWidth();
-      const int h = hm->getHeight();
-      if (w > 0 && h > 0) {
-        const float half_w = w * 0.5F - 0.5F;
-        const float half_h = h * 0.5F - 0.5F;
-        const float minX = -half_w * tile;
-        const float maxX = half_w * tile;
-        const float minZ = -half_h * tile;
-        const float maxZ = half_h * tile;
-        transform->position.x = std::clamp(transform->position.x, minX, maxX);
-        transform->position.z = std::clamp(transform->position.z, minZ, maxZ);
-      }
-    }
+  if (!entity->hasComponent<Engine::Core::BuildingComponent>()) {
+    applyLocalAvoidance(entity, world, movement, transform, max_speed);
   }
 
+  // Position integration and bounds clamping happen in the SoA sweep in
+  // update() once every unit's steering has run.
+
   if (!entity->hasComponent<Engine::Core::BuildingComponent>()) {
     float const speed2 =
         movement->vx * movement->vx + movement->vz * movement->vz;
@@ -3,6 +3,8 @@
 #include "../core/component.h"
 #include "../core/system.h"
 #include "../core/world.h"
+#include <cstdint>
+#include <vector>
 
 namespace Engine::Core {
 class Entity;
@@ -13,13 +15,39 @@ namespace Game::Systems {
 class MovementSystem : public Engine::Core::System {
 public:
   void update(Engine::Core::World *world, float deltaTime) override;
+  [[nodiscard]] auto name() const -> const char * override {
+    return "MovementSystem";
+  }
 
 private:
   static void moveUnit(Engine::Core::Entity *entity, Engine::Core::World *world,
                        float deltaTime);
+  // True when the steering pass has nothing to do for this unit: no
+  // target, no pending path, no flow field, no residual velocity and no
+  // yaw settling. Reads only component fields, so any order wakes the
+  // unit instantly — commands flip hasTarget or pathPending and the next
+  // tick's test sees it.
+  static auto isSleepEligible(Engine::Core::Entity *entity,
+                              const Engine::Core::MovementComponent *movement)
+      -> bool;
   static auto
   hasReachedTarget(const Engine::Core::TransformComponent *transform,
                    const Engine::Core::MovementComponent *movement) -> bool;
+
+  // Per-frame SoA staging for the integration sweep: positions and
+  // velocities are gathered into contiguous float arrays after the
+  // per-unit steering pass, integrated and clamped in one vectorizable
+  // loop, then scattered back. Buffers are members so their capacity is
+  // reused across frames.
+  std::vector<Engine::Core::TransformComponent *> m_batchTransforms;
+  std::vector<float> m_batchPosX;
+  std::vector<float> m_batchPosZ;
+  std::vector<float> m_batchVelX;
+  std::vector<float> m_batchVelZ;
+
+  // Tick counter staggering the low-frequency wake pass for sleeping
+  // units; see update().
+  std::uint64_t m_tick = 0;
 };
 
 } // namespace Game::Systems
\ No newline at end of file
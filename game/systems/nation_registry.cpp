@@ -1,9 +1,11 @@
 #include "nation_registry.h"
+#include "core/string_interner.h"
 #include "systems/formation_system.h"
 #include "units/troop_type.h"
 #include <QDebug>
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
@@ -84,8 +86,9 @@ auto NationRegistry::instance() -> NationRegistry & {
 }
 
 void NationRegistry::registerNation(Nation nation) {
+  nation.idSymbol = Engine::Core::StringInterner::instance().intern(nation.id);
 
-  auto it = m_nationIndex.find(nation.id);
+  auto it = m_nationIndex.find(nation.idSymbol);
   if (it != m_nationIndex.end()) {
 
     m_nations[it->second] = std::move(nation);
@@ -94,11 +97,14 @@ void NationRegistry::registerNation(Nation nation) {
 
   size_t const index = m_nations.size();
   m_nations.push_back(std::move(nation));
-  m_nationIndex[m_nations.back().id] = index;
+  m_nationIndex[m_nations.back().idSymbol] = index;
 }
 
-auto NationRegistry::getNation(const std::string &nationId) const
+auto NationRegistry::getNation(Engine::Core::StringId nationId) const
     -> const Nation * {
+  if (nationId == 0) {
+    return nullptr;
+  }
   auto it = m_nationIndex.find(nationId);
   if (it == m_nationIndex.end()) {
     return nullptr;
@@ -106,23 +112,43 @@ auto NationRegistry::getNation(const std::string &nationId) const
   return &m_nations[it->second];
 }
 
-auto NationRegistry::getNationForPlayer(int player_id) const -> const Nation * {
+auto NationRegistry::getNation(const std::string &nationId) const
+    -> const Nation * {
+  return getNation(Engine::Core::StringInterner::instance().find(nationId));
+}
 
-  auto it = m_playerNations.find(player_id);
-  if (it != m_playerNations.end()) {
-    const auto *nation = getNation(it->second);
-    return nation;
+auto NationRegistry::getNationForPlayer(int player_id) const -> const Nation * {
+  if (player_id >= 0 &&
+      player_id < static_cast<int>(m_nationIndexByPlayer.size())) {
+    std::int32_t const index = m_nationIndexByPlayer[player_id];
+    if (index >= 0) {
+      return &m_nations[index];
+    }
   }
-
-  const auto *nation = getNation(m_defaultNation);
-  if (nation == nullptr) {
+  if (m_defaultNationIndex >= 0) {
+    return &m_nations[m_defaultNationIndex];
   }
-  return nation;
+  return nullptr;
 }
 
 void NationRegistry::setPlayerNation(int player_id,
                                      const std::string &nationId) {
-  m_playerNations[player_id] = nationId;
+  if (player_id < 0) {
+    return;
+  }
+  // String resolution happens here, at the load boundary; per-tick
+  // lookups then index the dense table.
+  auto symbol_it = m_nationIndex.find(
+      Engine::Core::StringInterner::instance().intern(nationId));
+  if (symbol_it == m_nationIndex.end()) {
+    return;
+  }
+  if (player_id >= static_cast<int>(m_nationIndexByPlayer.size())) {
+    m_nationIndexByPlayer.resize(static_cast<std::size_t>(player_id) + 1,
+                                 -1);
+  }
+  m_nationIndexByPlayer[player_id] =
+      static_cast<std::int32_t>(symbol_it->second);
 }
 
 void NationRegistry::initializeDefaults() {
@@ -172,13 +198,18 @@ void NationRegistry::initializeDefaults() {
 
   registerNation(std::move(kingdom_of_iron));
 
-  m_defaultNation = "kingdom_of_iron";
+  auto default_it = m_nationIndex.find(
+      Engine::Core::StringInterner::instance().intern("kingdom_of_iron"));
+  m_defaultNationIndex = default_it != m_nationIndex.end()
+                             ? static_cast<std::int32_t>(default_it->second)
+                             : -1;
 }
 
 void NationRegistry::clear() {
   m_nations.clear();
   m_nationIndex.clear();
-  m_playerNations.clear();
+  m_nationIndexByPlayer.clear();
+  m_defaultNationIndex = -1;
 }
 
 } // namespace Game::Systems
@@ -1,7 +1,9 @@
 #pragma once
 
+#include "../core/string_interner.h"
 #include "../units/troop_type.h"
 #include "formation_system.h"
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -20,6 +22,9 @@ struct TroopType {
 
 struct Nation {
   std::string id;
+  // Interned symbol for id, filled in by registerNation; registry
+  // lookups compare this integer instead of hashing the string.
+  Engine::Core::StringId idSymbol = 0;
   std::string displayName;
   std::vector<TroopType> availableTroops;
   std::string primaryBuilding = "barracks";
@@ -47,6 +52,7 @@ public:
 
   void registerNation(Nation nation);
 
+  auto getNation(Engine::Core::StringId nationId) const -> const Nation *;
   auto getNation(const std::string &nationId) const -> const Nation *;
 
   auto getNationForPlayer(int player_id) const -> const Nation *;
@@ -65,9 +71,15 @@ private:
   NationRegistry() = default;
 
   std::vector<Nation> m_nations;
-  std::unordered_map<std::string, size_t> m_nationIndex;
-  std::unordered_map<int, std::string> m_playerNations;
-  std::string m_defaultNation = "kingdom_of_iron";
+  // Keyed by interned symbol; string lookups resolve through the
+  // interner once and then compare integers. Only load/save boundaries
+  // go through this map.
+  std::unordered_map<Engine::Core::StringId, size_t> m_nationIndex;
+  // Player ids are small sequential ints, so the per-player nation link
+  // is a dense vector of nation indices (-1 for unset); the per-tick AI
+  // lookups index it directly instead of hashing.
+  std::vector<std::int32_t> m_nationIndexByPlayer;
+  std::int32_t m_defaultNationIndex = -1;
 };
 
 } // namespace Game::Systems
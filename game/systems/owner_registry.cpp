@@ -2,6 +2,7 @@
 #include <QDebug>
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <qjsonarray.h>
 #include <qjsonobject.h>
 #include <qjsonvalue.h>
@@ -63,9 +64,19 @@ auto OwnerRegistry::instance() -> OwnerRegistry & {
   return inst;
 }
 
+void OwnerRegistry::setOwnerIndex(int owner_id, std::size_t index) {
+  if (owner_id < 0) {
+    return;
+  }
+  if (owner_id >= static_cast<int>(m_denseIndex.size())) {
+    m_denseIndex.resize(static_cast<std::size_t>(owner_id) + 1, -1);
+  }
+  m_denseIndex[owner_id] = static_cast<std::int32_t>(index);
+}
+
 void OwnerRegistry::clear() {
   m_owners.clear();
-  m_owner_idToIndex.clear();
+  m_denseIndex.clear();
   m_nextOwnerId = 1;
   m_localPlayerId = 1;
 }
@@ -98,14 +109,14 @@ auto OwnerRegistry::registerOwner(OwnerType type,
 
   size_t const index = m_owners.size();
   m_owners.push_back(info);
-  m_owner_idToIndex[owner_id] = index;
+  setOwnerIndex(owner_id, index);
 
   return owner_id;
 }
 
 void OwnerRegistry::registerOwnerWithId(int owner_id, OwnerType type,
                                         const std::string &name) {
-  if (m_owner_idToIndex.find(owner_id) != m_owner_idToIndex.end()) {
+  if (ownerIndex(owner_id) >= 0) {
     return;
   }
 
@@ -134,7 +145,7 @@ void OwnerRegistry::registerOwnerWithId(int owner_id, OwnerType type,
 
   size_t const index = m_owners.size();
   m_owners.push_back(info);
-  m_owner_idToIndex[owner_id] = index;
+  setOwnerIndex(owner_id, index);
 
   if (owner_id >= m_nextOwnerId) {
     m_nextOwnerId = owner_id + 1;
@@ -148,35 +159,35 @@ void OwnerRegistry::setLocalPlayerId(int player_id) {
 auto OwnerRegistry::getLocalPlayerId() const -> int { return m_localPlayerId; }
 
 auto OwnerRegistry::isPlayer(int owner_id) const -> bool {
-  auto it = m_owner_idToIndex.find(owner_id);
-  if (it == m_owner_idToIndex.end()) {
+  std::ptrdiff_t const index = ownerIndex(owner_id);
+  if (index < 0) {
     return false;
   }
-  return m_owners[it->second].type == OwnerType::Player;
+  return m_owners[index].type == OwnerType::Player;
 }
 
 auto OwnerRegistry::isAI(int owner_id) const -> bool {
-  auto it = m_owner_idToIndex.find(owner_id);
-  if (it == m_owner_idToIndex.end()) {
+  std::ptrdiff_t const index = ownerIndex(owner_id);
+  if (index < 0) {
     return false;
   }
-  return m_owners[it->second].type == OwnerType::AI;
+  return m_owners[index].type == OwnerType::AI;
 }
 
 auto OwnerRegistry::getOwnerType(int owner_id) const -> OwnerType {
-  auto it = m_owner_idToIndex.find(owner_id);
-  if (it == m_owner_idToIndex.end()) {
+  std::ptrdiff_t const index = ownerIndex(owner_id);
+  if (index < 0) {
     return OwnerType::Neutral;
   }
-  return m_owners[it->second].type;
+  return m_owners[index].type;
 }
 
 auto OwnerRegistry::getOwnerName(int owner_id) const -> std::string {
-  auto it = m_owner_idToIndex.find(owner_id);
-  if (it == m_owner_idToIndex.end()) {
+  std::ptrdiff_t const index = ownerIndex(owner_id);
+  if (index < 0) {
     return "Unknown";
   }
-  return m_owners[it->second].name;
+  return m_owners[index].name;
 }
 
 auto OwnerRegistry::getAllOwners() const -> const std::vector<OwnerInfo> & {
@@ -204,18 +215,18 @@ auto OwnerRegistry::getAIOwnerIds() const -> std::vector<int> {
 }
 
 void OwnerRegistry::setOwnerTeam(int owner_id, int team_id) {
-  auto it = m_owner_idToIndex.find(owner_id);
-  if (it != m_owner_idToIndex.end()) {
-    m_owners[it->second].team_id = team_id;
+  std::ptrdiff_t const index = ownerIndex(owner_id);
+  if (index >= 0) {
+    m_owners[index].team_id = team_id;
   }
 }
 
 auto OwnerRegistry::getOwnerTeam(int owner_id) const -> int {
-  auto it = m_owner_idToIndex.find(owner_id);
-  if (it == m_owner_idToIndex.end()) {
+  std::ptrdiff_t const index = ownerIndex(owner_id);
+  if (index < 0) {
     return 0;
   }
-  return m_owners[it->second].team_id;
+  return m_owners[index].team_id;
 }
 
 auto OwnerRegistry::areAllies(int owner_id1, int owner_id2) const -> bool {
@@ -273,16 +284,16 @@ auto OwnerRegistry::getEnemiesOf(int owner_id) const -> std::vector<int> {
 }
 
 void OwnerRegistry::setOwnerColor(int owner_id, float r, float g, float b) {
-  auto it = m_owner_idToIndex.find(owner_id);
-  if (it != m_owner_idToIndex.end()) {
-    m_owners[it->second].color = {r, g, b};
+  std::ptrdiff_t const index = ownerIndex(owner_id);
+  if (index >= 0) {
+    m_owners[index].color = {r, g, b};
   }
 }
 
 auto OwnerRegistry::getOwnerColor(int owner_id) const -> std::array<float, 3> {
-  auto it = m_owner_idToIndex.find(owner_id);
-  if (it != m_owner_idToIndex.end()) {
-    return m_owners[it->second].color;
+  std::ptrdiff_t const index = ownerIndex(owner_id);
+  if (index >= 0) {
+    return m_owners[index].color;
   }
 
   return {0.8F, 0.9F, 1.0F};
@@ -329,7 +340,7 @@ void OwnerRegistry::fromJson(const QJsonObject &json) {
 
     const size_t index = m_owners.size();
     m_owners.push_back(info);
-    m_owner_idToIndex[info.owner_id] = index;
+    setOwnerIndex(info.owner_id, index);
   }
 
   for (const auto &owner : m_owners) {
@@ -3,8 +3,9 @@
 #include <QJsonArray>
 #include <QJsonObject>
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 namespace Game::Systems {
@@ -71,10 +72,23 @@ private:
   OwnerRegistry(const OwnerRegistry &) = delete;
   auto operator=(const OwnerRegistry &) -> OwnerRegistry & = delete;
 
+  // Owner ids are small sequential ints, so the id-to-slot table is a
+  // dense vector indexed by id (-1 for unknown) instead of a hash map;
+  // per-unit hot paths (team color, ally/enemy checks) resolve owners
+  // with one bounds check and one load.
+  [[nodiscard]] auto ownerIndex(int owner_id) const -> std::ptrdiff_t {
+    if (owner_id < 0 ||
+        owner_id >= static_cast<int>(m_denseIndex.size())) {
+      return -1;
+    }
+    return m_denseIndex[owner_id];
+  }
+  void setOwnerIndex(int owner_id, std::size_t index);
+
   int m_nextOwnerId = 1;
   int m_localPlayerId = 1;
   std::vector<OwnerInfo> m_owners;
-  std::unordered_map<int, size_t> m_owner_idToIndex;
+  std::vector<std::int32_t> m_denseIndex;
 };
 
 } // namespace Game::Systems
@@ -0,0 +1,390 @@
+#include "path_hierarchy.h"
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <queue>
+#include <utility>
+
+namespace Game::Systems {
+
+namespace {
+
+constexpr int kUnvisited = std::numeric_limits<int>::min();
+
+auto pathKey(int portal_a, int portal_b) -> std::uint64_t {
+  const int low = std::min(portal_a, portal_b);
+  const int high = std::max(portal_a, portal_b);
+  return (static_cast<std::uint64_t>(low) << 32U) |
+         static_cast<std::uint32_t>(high);
+}
+
+} // namespace
+
+PathHierarchy::PathHierarchy(const Pathfinding &grid, int width, int height)
+    : m_grid(grid), m_width(width), m_height(height),
+      m_clustersX((width + kClusterSize - 1) / kClusterSize),
+      m_clustersY((height + kClusterSize - 1) / kClusterSize) {}
+
+void PathHierarchy::invalidate() {
+  m_built = false;
+  m_clusters.clear();
+  m_portals.clear();
+}
+
+auto PathHierarchy::clusterOf(const Point &p) const -> int {
+  return (p.y / kClusterSize) * m_clustersX + (p.x / kClusterSize);
+}
+
+auto PathHierarchy::clusterBounds(int cluster_index) const
+    -> std::pair<Point, Point> {
+  const int cx = cluster_index % m_clustersX;
+  const int cy = cluster_index / m_clustersX;
+  const Point min{cx * kClusterSize, cy * kClusterSize};
+  const Point max{std::min(min.x + kClusterSize, m_width) - 1,
+                  std::min(min.y + kClusterSize, m_height) - 1};
+  return {min, max};
+}
+
+void PathHierarchy::buildBorderPortals(int cluster_a, int cluster_b,
+                                       bool vertical, int border_coord,
+                                       int run_begin, int run_end) {
+  const int mid = run_begin + (run_end - run_begin) / 2;
+  const Point cell_a =
+      vertical ? Point{border_coord, mid} : Point{mid, border_coord};
+  const Point cell_b = vertical ? Point{border_coord + 1, mid}
+                                : Point{mid, border_coord + 1};
+
+  const int node_a = static_cast<int>(m_portals.size());
+  const int node_b = node_a + 1;
+
+  m_portals.push_back({cell_a, cluster_a, node_b, {}});
+  m_portals.push_back({cell_b, cluster_b, node_a, {}});
+  m_clusters[cluster_a].portals.push_back(node_a);
+  m_clusters[cluster_b].portals.push_back(node_b);
+}
+
+void PathHierarchy::build() {
+  m_clusters.assign(static_cast<std::size_t>(m_clustersX) * m_clustersY, {});
+  m_portals.clear();
+
+  // Vertical borders: contiguous runs where both sides are walkable become
+  // one portal pair at the run midpoint.
+  for (int cy = 0; cy < m_clustersY; ++cy) {
+    for (int cx = 0; cx + 1 < m_clustersX; ++cx) {
+      const int x0 = (cx + 1) * kClusterSize - 1;
+      if (x0 + 1 >= m_width) {
+        continue;
+      }
+      const int cluster_a = cy * m_clustersX + cx;
+      const int cluster_b = cluster_a + 1;
+      const int y_begin = cy * kClusterSize;
+      const int y_end = std::min(y_begin + kClusterSize, m_height);
+      int run_begin = -1;
+      for (int y = y_begin; y <= y_end; ++y) {
+        const bool open = y < y_end && m_grid.isWalkable(x0, y) &&
+                          m_grid.isWalkable(x0 + 1, y);
+        if (open && run_begin < 0) {
+          run_begin = y;
+        } else if (!open && run_begin >= 0) {
+          buildBorderPortals(cluster_a, cluster_b, true, x0, run_begin, y - 1);
+          run_begin = -1;
+        }
+      }
+    }
+  }
+
+  // Horizontal borders.
+  for (int cy = 0; cy + 1 < m_clustersY; ++cy) {
+    for (int cx = 0; cx < m_clustersX; ++cx) {
+      const int y0 = (cy + 1) * kClusterSize - 1;
+      if (y0 + 1 >= m_height) {
+        continue;
+      }
+      const int cluster_a = cy * m_clustersX + cx;
+      const int cluster_b = cluster_a + m_clustersX;
+      const int x_begin = cx * kClusterSize;
+      const int x_end = std::min(x_begin + kClusterSize, m_width);
+      int run_begin = -1;
+      for (int x = x_begin; x <= x_end; ++x) {
+        const bool open = x < x_end && m_grid.isWalkable(x, y0) &&
+                          m_grid.isWalkable(x, y0 + 1);
+        if (open && run_begin < 0) {
+          run_begin = x;
+        } else if (!open && run_begin >= 0) {
+          buildBorderPortals(cluster_a, cluster_b, false, y0, run_begin, x - 1);
+          run_begin = -1;
+        }
+      }
+    }
+  }
+
+  for (std::size_t i = 0; i < m_clusters.size(); ++i) {
+    connectClusterPortals(m_clusters[i], static_cast<int>(i));
+  }
+  m_built = true;
+}
+
+void PathHierarchy::connectClusterPortals(Cluster &cluster,
+                                          int cluster_index) {
+  const auto [box_min, box_max] = clusterBounds(cluster_index);
+  for (std::size_t i = 0; i < cluster.portals.size(); ++i) {
+    for (std::size_t j = i + 1; j < cluster.portals.size(); ++j) {
+      const int node_a = cluster.portals[i];
+      const int node_b = cluster.portals[j];
+      auto path = localPath(m_portals[node_a].cell, m_portals[node_b].cell,
+                            box_min, box_max);
+      if (path.empty()) {
+        continue;
+      }
+      const int cost = static_cast<int>(path.size()) - 1;
+      m_portals[node_a].intraEdges.push_back({node_b, cost});
+      m_portals[node_b].intraEdges.push_back({node_a, cost});
+      cluster.paths.emplace(pathKey(node_a, node_b), std::move(path));
+    }
+  }
+}
+
+auto PathHierarchy::localPath(const Point &start, const Point &end,
+                              const Point &box_min,
+                              const Point &box_max) -> std::vector<Point> {
+  const int box_width = box_max.x - box_min.x + 1;
+  const int box_height = box_max.y - box_min.y + 1;
+  const std::size_t cells =
+      static_cast<std::size_t>(box_width) * static_cast<std::size_t>(box_height);
+  if (m_localGCost.size() < cells) {
+    m_localGCost.resize(cells);
+    m_localParent.resize(cells);
+  }
+  std::fill_n(m_localGCost.begin(), cells, kUnvisited);
+  std::fill_n(m_localParent.begin(), cells, -1);
+
+  const auto to_local = [&](const Point &p) -> int {
+    return (p.y - box_min.y) * box_width + (p.x - box_min.x);
+  };
+  const auto in_box = [&](int x, int y) -> bool {
+    return x >= box_min.x && x <= box_max.x && y >= box_min.y && y <= box_max.y;
+  };
+
+  // Uniform step cost, so breadth-first expansion already yields a shortest
+  // path under the same movement rules as the grid A*.
+  const int start_idx = to_local(start);
+  const int end_idx = to_local(end);
+  m_localGCost[start_idx] = 0;
+
+  std::vector<int> frontier;
+  frontier.push_back(start_idx);
+  std::size_t head = 0;
+  bool found = start_idx == end_idx;
+
+  while (!found && head < frontier.size()) {
+    const int current = frontier[head++];
+    const int cx = box_min.x + current % box_width;
+    const int cy = box_min.y + current / box_width;
+    const int g = m_localGCost[current];
+
+    for (int dx = -1; dx <= 1 && !found; ++dx) {
+      for (int dy = -1; dy <= 1; ++dy) {
+        if (dx == 0 && dy == 0) {
+          continue;
+        }
+        const int nx = cx + dx;
+        const int ny = cy + dy;
+        if (!in_box(nx, ny) || !m_grid.isWalkable(nx, ny)) {
+          continue;
+        }
+        if (dx != 0 && dy != 0 &&
+            (!m_grid.isWalkable(cx + dx, cy) ||
+             !m_grid.isWalkable(cx, cy + dy))) {
+          continue;
+        }
+        const int neighbor = (ny - box_min.y) * box_width + (nx - box_min.x);
+        if (m_localGCost[neighbor] != kUnvisited) {
+          continue;
+        }
+        m_localGCost[neighbor] = g + 1;
+        m_localParent[neighbor] = current;
+        if (neighbor == end_idx) {
+          found = true;
+          break;
+        }
+        frontier.push_back(neighbor);
+      }
+    }
+  }
+
+  if (!found) {
+    return {};
+  }
+
+  std::vector<Point> path;
+  path.reserve(static_cast<std::size_t>(m_localGCost[end_idx]) + 1);
+  for (int idx = end_idx; idx >= 0; idx = m_localParent[idx]) {
+    path.push_back(
+        {box_min.x + idx % box_width, box_min.y + idx / box_width});
+    if (idx == start_idx) {
+      break;
+    }
+  }
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+auto PathHierarchy::cachedClusterPath(int cluster_index, int portal_a,
+                                      int portal_b)
+    -> const std::vector<Point> * {
+  auto &cluster = m_clusters[cluster_index];
+  const auto key = pathKey(portal_a, portal_b);
+  auto it = cluster.paths.find(key);
+  if (it != cluster.paths.end()) {
+    return &it->second;
+  }
+  const auto [box_min, box_max] = clusterBounds(cluster_index);
+  const int low = std::min(portal_a, portal_b);
+  const int high = std::max(portal_a, portal_b);
+  auto path =
+      localPath(m_portals[low].cell, m_portals[high].cell, box_min, box_max);
+  if (path.empty()) {
+    return nullptr;
+  }
+  return &cluster.paths.emplace(key, std::move(path)).first->second;
+}
+
+auto PathHierarchy::searchAbstract(const Point &start, const Point &end,
+                                   std::vector<int> &out_portals) -> bool {
+  const int start_cluster = clusterOf(start);
+  const int end_cluster = clusterOf(end);
+  const auto [start_min, start_max] = clusterBounds(start_cluster);
+  const auto [end_min, end_max] = clusterBounds(end_cluster);
+
+  constexpr int kInfinity = std::numeric_limits<int>::max();
+  std::vector<int> dist(m_portals.size(), kInfinity);
+  std::vector<int> prev(m_portals.size(), -1);
+
+  using HeapEntry = std::pair<int, int>; // cost, portal
+  std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<>> open;
+
+  for (const int portal : m_clusters[start_cluster].portals) {
+    const auto entry =
+        localPath(start, m_portals[portal].cell, start_min, start_max);
+    if (entry.empty()) {
+      continue;
+    }
+    dist[portal] = static_cast<int>(entry.size()) - 1;
+    open.push({dist[portal], portal});
+  }
+
+  while (!open.empty()) {
+    const auto [cost, portal] = open.top();
+    open.pop();
+    if (cost > dist[portal]) {
+      continue;
+    }
+    const PortalNode &node = m_portals[portal];
+    const auto relax = [&](int target, int edge_cost) {
+      const int next_cost = cost + edge_cost;
+      if (next_cost < dist[target]) {
+        dist[target] = next_cost;
+        prev[target] = portal;
+        open.push({next_cost, target});
+      }
+    };
+    relax(node.twin, 1);
+    for (const PortalEdge &edge : node.intraEdges) {
+      relax(edge.target, edge.cost);
+    }
+  }
+
+  int best_portal = -1;
+  int best_total = kInfinity;
+  for (const int portal : m_clusters[end_cluster].portals) {
+    if (dist[portal] == kInfinity) {
+      continue;
+    }
+    const auto exit =
+        localPath(m_portals[portal].cell, end, end_min, end_max);
+    if (exit.empty()) {
+      continue;
+    }
+    const int total = dist[portal] + static_cast<int>(exit.size()) - 1;
+    if (total < best_total) {
+      best_total = total;
+      best_portal = portal;
+    }
+  }
+  if (best_portal < 0) {
+    return false;
+  }
+
+  out_portals.clear();
+  for (int portal = best_portal; portal >= 0; portal = prev[portal]) {
+    out_portals.push_back(portal);
+  }
+  std::reverse(out_portals.begin(), out_portals.end());
+  return true;
+}
+
+auto PathHierarchy::findPath(const Point &start,
+                             const Point &end) -> std::vector<Point> {
+  if (!m_built) {
+    build();
+  }
+
+  const int start_cluster = clusterOf(start);
+  const int end_cluster = clusterOf(end);
+  if (start_cluster == end_cluster) {
+    const auto [box_min, box_max] = clusterBounds(start_cluster);
+    return localPath(start, end, box_min, box_max);
+  }
+
+  std::vector<int> chain;
+  if (!searchAbstract(start, end, chain)) {
+    return {};
+  }
+
+  const auto append = [](std::vector<Point> &out,
+                         const std::vector<Point> &segment, bool reversed) {
+    const std::size_t count = segment.size();
+    for (std::size_t i = 1; i < count; ++i) {
+      out.push_back(reversed ? segment[count - 1 - i] : segment[i]);
+    }
+  };
+
+  std::vector<Point> path;
+  {
+    const auto [box_min, box_max] = clusterBounds(start_cluster);
+    auto entry = localPath(start, m_portals[chain.front()].cell, box_min,
+                           box_max);
+    if (entry.empty()) {
+      return {};
+    }
+    path = std::move(entry);
+  }
+
+  for (std::size_t i = 0; i + 1 < chain.size(); ++i) {
+    const int from = chain[i];
+    const int to = chain[i + 1];
+    if (m_portals[from].twin == to) {
+      path.push_back(m_portals[to].cell);
+      continue;
+    }
+    const std::vector<Point> *segment =
+        cachedClusterPath(m_portals[from].cluster, from, to);
+    if (segment == nullptr) {
+      return {};
+    }
+    append(path, *segment, from > to);
+  }
+
+  {
+    const auto [box_min, box_max] = clusterBounds(end_cluster);
+    const auto exit =
+        localPath(m_portals[chain.back()].cell, end, box_min, box_max);
+    if (exit.empty()) {
+      return {};
+    }
+    append(path, exit, false);
+  }
+  return path;
+}
+
+} // namespace Game::Systems
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "pathfinding.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Game::Systems {
+
+// Hierarchical (cluster/portal) layer over the Pathfinding grid. The map is
+// split into fixed-size clusters; contiguous walkable runs along each
+// cluster border become portal nodes, and intra-cluster paths between
+// portals are computed once and cached. Long-distance queries search the
+// abstract portal graph and only refine inside the clusters the abstract
+// path actually crosses, instead of touching the whole grid.
+//
+// Not thread-safe on its own: callers must hold the owning Pathfinding
+// grid mutex, which also guarantees the obstacle grid is stable.
+class PathHierarchy {
+public:
+  static constexpr int kClusterSize = 32;
+
+  PathHierarchy(const Pathfinding &grid, int width, int height);
+
+  // Drops clusters, portals and cached paths; the next query rebuilds.
+  void invalidate();
+
+  // Returns a full start-to-end path, or empty when the abstract graph
+  // finds no route (the caller falls back to plain grid A*).
+  auto findPath(const Point &start, const Point &end) -> std::vector<Point>;
+
+private:
+  struct PortalEdge {
+    int target = -1;
+    int cost = 0;
+  };
+
+  struct PortalNode {
+    Point cell;
+    int cluster = -1;
+    // Twin node on the other side of the border (crossing cost 1).
+    int twin = -1;
+    std::vector<PortalEdge> intraEdges;
+  };
+
+  struct Cluster {
+    std::vector<int> portals;
+    // Cached intra-cluster paths keyed by (portalA << 32 | portalB) with
+    // portalA < portalB; stored start-to-end in that order.
+    std::unordered_map<std::uint64_t, std::vector<Point>> paths;
+  };
+
+  void build();
+  void buildBorderPortals(int cluster_a, int cluster_b, bool vertical,
+                          int border_coord, int run_begin, int run_end);
+  void connectClusterPortals(Cluster &cluster, int cluster_index);
+
+  auto clusterOf(const Point &p) const -> int;
+  auto clusterBounds(int cluster_index) const
+      -> std::pair<Point, Point>; // inclusive min, max
+
+  // A* restricted to the given inclusive bounding box; same movement rules
+  // as the grid search (8-way, no corner cutting, uniform step cost).
+  auto localPath(const Point &start, const Point &end, const Point &box_min,
+                 const Point &box_max) -> std::vector<Point>;
+
+  auto cachedClusterPath(int cluster_index, int portal_a,
+                         int portal_b) -> const std::vector<Point> *;
+
+  auto searchAbstract(const Point &start, const Point &end,
+                      std::vector<int> &out_portals) -> bool;
+
+  const Pathfinding &m_grid;
+  int m_width;
+  int m_height;
+  int m_clustersX;
+  int m_clustersY;
+  bool m_built = false;
+
+  std::vector<Cluster> m_clusters;
+  std::vector<PortalNode> m_portals;
+
+  // Scratch buffers for the bounded local search, sized to one cluster
+  // pair; reused across calls.
+  std::vector<int> m_localGCost;
+  std::vector<int> m_localParent;
+};
+
+} // namespace Game::Systems
@@ -1,34 +1,61 @@
 #include "pathfinding.h"
+#include "../../render/thread_topology.h"
+#include "../core/alloc_tracker.h"
 #include "../map/terrain_service.h"
 #include "building_collision_registry.h"
+#include "flow_field.h"
 #include "map/terrain.h"
+#include "path_hierarchy.h"
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <bit>
+#include <chrono>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <future>
 #include <limits>
 #include <mutex>
+#include <shared_mutex>
+#include <span>
 #include <utility>
 #include <vector>
 
 namespace Game::Systems {
 
-Pathfinding::Pathfinding(int width, int height)
-    : m_width(width), m_height(height) {
-  m_obstacles.resize(height, std::vector<std::uint8_t>(width, 0));
-  ensureWorkingBuffers();
+Pathfinding::Pathfinding(int width, int height, unsigned workerCount)
+    : m_width(width), m_height(height), m_wordsPerRow((width + 63) / 64) {
+  resetWalkableBits();
+  m_hierarchy = std::make_unique<PathHierarchy>(*this, width, height);
+
+  if (workerCount == 0) {
+    unsigned const hardware = std::thread::hardware_concurrency();
+    workerCount = std::clamp(hardware / 2U, 1U, 4U);
+  }
+
+  m_contexts.reserve(workerCount + 1);
+  for (unsigned i = 0; i < workerCount + 1; ++i) {
+    m_contexts.push_back(std::make_unique<SearchContext>());
+    ensureWorkingBuffers(*m_contexts.back());
+  }
+
   m_obstaclesDirty.store(true, std::memory_order_release);
-  m_workerThread = std::thread(&Pathfinding::workerLoop, this);
+
+  m_workerThreads.reserve(workerCount);
+  for (unsigned i = 0; i < workerCount; ++i) {
+    m_workerThreads.emplace_back(&Pathfinding::workerLoop, this,
+                                 static_cast<std::size_t>(i) + 1);
+  }
 }
 
 Pathfinding::~Pathfinding() {
-  m_stopWorker.store(true, std::memory_order_release);
+  m_stopWorkers.store(true, std::memory_order_release);
   m_requestCondition.notify_all();
-  if (m_workerThread.joinable()) {
-    m_workerThread.join();
+  for (auto &worker : m_workerThreads) {
+    if (worker.joinable()) {
+      worker.join();
+    }
   }
 }
 
@@ -39,7 +66,39 @@ void Pathfinding::setGridOffset(float offset_x, float offset_z) {
 
 void Pathfinding::setObstacle(int x, int y, bool isObstacle) {
   if (x >= 0 && x < m_width && y >= 0 && y < m_height) {
-    m_obstacles[y][x] = static_cast<std::uint8_t>(isObstacle);
+    std::unique_lock<std::shared_mutex> const lock(m_gridMutex);
+    bool const was_blocked = !isWalkable(x, y);
+    setWalkableBit(x, y, !isObstacle);
+
+    if (isObstacle && !was_blocked) {
+      // Blocking may split a component; relabel lazily.
+      m_labelsDirty.store(true, std::memory_order_release);
+    } else if (!isObstacle && was_blocked &&
+               !m_labelsDirty.load(std::memory_order_acquire) &&
+               !m_componentParent.empty()) {
+      // Clearing only merges components, which union-find handles in
+      // place.
+      int const idx = toIndex(x, y);
+      m_componentParent[static_cast<std::size_t>(idx)] = idx;
+      constexpr std::array<std::pair<int, int>, 4> offsets = {
+          {{1, 0}, {-1, 0}, {0, 1}, {0, -1}}};
+      for (const auto &[dx, dy] : offsets) {
+        int const nx = x + dx;
+        int const ny = y + dy;
+        if (!isWalkable(nx, ny)) {
+          continue;
+        }
+        int const neighbor_root = componentRoot(toIndex(nx, ny));
+        int const own_root = componentRoot(idx);
+        if (neighbor_root >= 0 && neighbor_root != own_root) {
+          m_componentParent[static_cast<std::size_t>(own_root)] =
+              neighbor_root;
+        }
+      }
+    }
+
+    m_hierarchy->invalidate();
+    m_obstacleVersion.fetch_add(1, std::memory_order_acq_rel);
   }
 }
 
@@ -47,7 +106,143 @@ auto Pathfinding::isWalkable(int x, int y) const -> bool {
   if (x < 0 || x >= m_width || y < 0 || y >= m_height) {
     return false;
   }
-  return m_obstacles[y][x] == 0;
+  const std::size_t word =
+      static_cast<std::size_t>(y) * m_wordsPerRow + (x >> 6);
+  return ((m_walkable[word] >> (x & 63)) & 1ULL) != 0;
+}
+
+auto Pathfinding::isAreaWalkable(const Point &min,
+                                 const Point &max) const -> bool {
+  if (min.x < 0 || min.y < 0 || max.x >= m_width || max.y >= m_height ||
+      min.x > max.x || min.y > max.y) {
+    return false;
+  }
+
+  const int first_word = min.x >> 6;
+  const int last_word = max.x >> 6;
+
+  for (int y = min.y; y <= max.y; ++y) {
+    const std::size_t row =
+        static_cast<std::size_t>(y) * m_wordsPerRow;
+    for (int w = first_word; w <= last_word; ++w) {
+      std::uint64_t mask = ~0ULL;
+      if (w == first_word) {
+        mask &= ~0ULL << (min.x & 63);
+      }
+      if (w == last_word) {
+        int const high = max.x & 63;
+        mask &= (high == 63) ? ~0ULL : ((1ULL << (high + 1)) - 1);
+      }
+      if ((m_walkable[row + static_cast<std::size_t>(w)] & mask) != mask) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+auto Pathfinding::findFreeCellsNear(const Point &center, int radius,
+                                    int count) const -> std::vector<Point> {
+  std::vector<Point> found;
+  if (count <= 0 || radius < 0) {
+    return found;
+  }
+  const int x0 = std::max(0, center.x - radius);
+  const int x1 = std::min(m_width - 1, center.x + radius);
+  const int y0 = std::max(0, center.y - radius);
+  const int y1 = std::min(m_height - 1, center.y + radius);
+  if (x0 > x1 || y0 > y1) {
+    return found;
+  }
+
+  // One locked copy of the window's words; the scan below runs on the
+  // slice with the lock released.
+  const int first_word = x0 >> 6;
+  const int last_word = x1 >> 6;
+  const int words_per_window_row = last_word - first_word + 1;
+  std::vector<std::uint64_t> window(
+      static_cast<std::size_t>(y1 - y0 + 1) *
+      static_cast<std::size_t>(words_per_window_row));
+  {
+    std::shared_lock<std::shared_mutex> const lock(m_gridMutex);
+    for (int y = y0; y <= y1; ++y) {
+      const std::size_t src =
+          static_cast<std::size_t>(y) * m_wordsPerRow +
+          static_cast<std::size_t>(first_word);
+      const std::size_t dst = static_cast<std::size_t>(y - y0) *
+                              static_cast<std::size_t>(words_per_window_row);
+      std::copy_n(m_walkable.begin() + static_cast<std::ptrdiff_t>(src),
+                  words_per_window_row,
+                  window.begin() + static_cast<std::ptrdiff_t>(dst));
+    }
+  }
+
+  found.reserve(static_cast<std::size_t>(count));
+  for (int y = y0; y <= y1; ++y) {
+    const std::size_t row = static_cast<std::size_t>(y - y0) *
+                            static_cast<std::size_t>(words_per_window_row);
+    for (int w = first_word; w <= last_word; ++w) {
+      std::uint64_t bits =
+          window[row + static_cast<std::size_t>(w - first_word)];
+      // Mask the word down to [x0, x1].
+      if (w == first_word) {
+        bits &= ~0ULL << (x0 & 63);
+      }
+      if (w == last_word) {
+        int const high = x1 & 63;
+        bits &= (high == 63) ? ~0ULL : ((1ULL << (high + 1)) - 1);
+      }
+      while (bits != 0) {
+        const int bit = std::countr_zero(bits);
+        bits &= bits - 1;
+        found.push_back({(w << 6) + bit, y});
+      }
+    }
+  }
+
+  // Nearest-first: spawn and formation callers take the head of the
+  // list, so closer slots win ties deterministically.
+  std::sort(found.begin(), found.end(),
+            [&center](const Point &a, const Point &b) {
+              const int da = (a.x - center.x) * (a.x - center.x) +
+                             (a.y - center.y) * (a.y - center.y);
+              const int db = (b.x - center.x) * (b.x - center.x) +
+                             (b.y - center.y) * (b.y - center.y);
+              if (da != db) {
+                return da < db;
+              }
+              return a.y != b.y ? a.y < b.y : a.x < b.x;
+            });
+  if (found.size() > static_cast<std::size_t>(count)) {
+    found.resize(static_cast<std::size_t>(count));
+  }
+  return found;
+}
+
+void Pathfinding::setWalkableBit(int x, int y, bool walkable) {
+  const std::size_t word =
+      static_cast<std::size_t>(y) * m_wordsPerRow + (x >> 6);
+  const std::uint64_t bit = 1ULL << (x & 63);
+  if (walkable) {
+    m_walkable[word] |= bit;
+  } else {
+    m_walkable[word] &= ~bit;
+  }
+}
+
+void Pathfinding::resetWalkableBits() {
+  m_walkable.assign(
+      static_cast<std::size_t>(m_wordsPerRow) * m_height, ~0ULL);
+  // Keep the padding bits past m_width clear so whole-word area tests
+  // never read them as walkable cells.
+  int const tail = m_width & 63;
+  if (tail != 0) {
+    std::uint64_t const tail_mask = (1ULL << tail) - 1;
+    for (int y = 0; y < m_height; ++y) {
+      m_walkable[static_cast<std::size_t>(y) * m_wordsPerRow + m_wordsPerRow -
+                 1] &= tail_mask;
+    }
+  }
 }
 
 void Pathfinding::markObstaclesDirty() {
@@ -60,15 +255,13 @@ void Pathfinding::updateBuildingObstacles() {
     return;
   }
 
-  std::lock_guard<std::mutex> const lock(m_mutex);
+  std::unique_lock<std::shared_mutex> const lock(m_gridMutex);
 
   if (!m_obstaclesDirty.load(std::memory_order_acquire)) {
     return;
   }
 
-  for (auto &row : m_obstacles) {
-    std::fill(row.begin(), row.end(), static_cast<std::uint8_t>(0));
-  }
+  resetWalkableBits();
 
   auto &terrain_service = Game::Map::TerrainService::instance();
   if (terrain_service.isInitialized()) {
@@ -89,30 +282,138 @@ void Pathfinding::updateBuildingObstacles() {
         }
 
         if (blocked) {
-          m_obstacles[z][x] = static_cast<std::uint8_t>(1);
+          setWalkableBit(x, z, false);
         }
       }
     }
   }
 
   auto &registry = BuildingCollisionRegistry::instance();
-  const auto &buildings = registry.getAllBuildings();
-
-  for (const auto &building : buildings) {
-    auto cells = registry.getOccupiedGridCells(building, m_gridCellSize);
-    for (const auto &cell : cells) {
-      int const grid_x =
-          static_cast<int>(std::round(cell.first - m_gridOffsetX));
-      int const grid_z =
-          static_cast<int>(std::round(cell.second - m_gridOffsetZ));
-
-      if (grid_x >= 0 && grid_x < m_width && grid_z >= 0 && grid_z < m_height) {
-        m_obstacles[grid_z][grid_x] = static_cast<std::uint8_t>(1);
+  registry.forEachOccupiedCell(m_gridCellSize, [&](int cell_x, int cell_z) {
+    int const grid_x = static_cast<int>(std::round(cell_x - m_gridOffsetX));
+    int const grid_z = static_cast<int>(std::round(cell_z - m_gridOffsetZ));
+
+    if (grid_x >= 0 && grid_x < m_width && grid_z >= 0 && grid_z < m_height) {
+      setWalkableBit(grid_x, grid_z, false);
+    }
+  });
+
+  // Safe without m_hierarchyMutex: hierarchy queries only run under the
+  // shared grid lock, which the exclusive lock above excludes.
+  m_hierarchy->invalidate();
+  rebuildComponentLabels();
+  m_obstacleVersion.fetch_add(1, std::memory_order_acq_rel);
+  m_obstaclesDirty.store(false, std::memory_order_release);
+}
+
+void Pathfinding::rebuildComponentLabels() {
+  const std::size_t total_cells =
+      static_cast<std::size_t>(m_width) * static_cast<std::size_t>(m_height);
+  m_componentParent.assign(total_cells, -1);
+
+  auto find_root = [this](int idx) {
+    while (m_componentParent[static_cast<std::size_t>(idx)] != idx) {
+      idx = m_componentParent[static_cast<std::size_t>(idx)];
+    }
+    return idx;
+  };
+
+  // 4-connectivity matches the movement rules: a diagonal step requires
+  // both orthogonal neighbors to be walkable, so it never connects cells
+  // an orthogonal path could not.
+  for (int y = 0; y < m_height; ++y) {
+    for (int x = 0; x < m_width; ++x) {
+      if (!isWalkable(x, y)) {
+        continue;
+      }
+      int const idx = toIndex(x, y);
+      m_componentParent[static_cast<std::size_t>(idx)] = idx;
+      if (x > 0 && isWalkable(x - 1, y)) {
+        m_componentParent[static_cast<std::size_t>(find_root(idx))] =
+            find_root(toIndex(x - 1, y));
+      }
+      if (y > 0 && isWalkable(x, y - 1)) {
+        int const own_root = find_root(idx);
+        int const up_root = find_root(toIndex(x, y - 1));
+        if (own_root != up_root) {
+          m_componentParent[static_cast<std::size_t>(own_root)] = up_root;
+        }
       }
     }
   }
 
-  m_obstaclesDirty.store(false, std::memory_order_release);
+  // Flatten so shared-lock readers resolve roots without path
+  // compression writes.
+  for (std::size_t idx = 0; idx < total_cells; ++idx) {
+    if (m_componentParent[idx] >= 0) {
+      m_componentParent[idx] = find_root(static_cast<int>(idx));
+    }
+  }
+
+  m_labelsDirty.store(false, std::memory_order_release);
+}
+
+void Pathfinding::ensureComponentLabels() {
+  if (!m_labelsDirty.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  std::unique_lock<std::shared_mutex> const lock(m_gridMutex);
+  if (m_labelsDirty.load(std::memory_order_acquire)) {
+    rebuildComponentLabels();
+  }
+}
+
+auto Pathfinding::componentRoot(int index) const -> int {
+  if (index < 0 ||
+      static_cast<std::size_t>(index) >= m_componentParent.size()) {
+    return -1;
+  }
+  int root = m_componentParent[static_cast<std::size_t>(index)];
+  if (root < 0) {
+    return -1;
+  }
+  while (m_componentParent[static_cast<std::size_t>(root)] != root) {
+    root = m_componentParent[static_cast<std::size_t>(root)];
+  }
+  return root;
+}
+
+auto Pathfinding::nearestCellInComponent(const Point &around,
+                                         int root) const -> Point {
+  constexpr int k_max_search_radius = 24;
+  for (int radius = 1; radius <= k_max_search_radius; ++radius) {
+    for (int dy = -radius; dy <= radius; ++dy) {
+      for (int dx = -radius; dx <= radius; ++dx) {
+        if (std::max(std::abs(dx), std::abs(dy)) != radius) {
+          continue;
+        }
+        int const x = around.x + dx;
+        int const y = around.y + dy;
+        if (!isWalkable(x, y)) {
+          continue;
+        }
+        if (componentRoot(toIndex(x, y)) == root) {
+          return {x, y};
+        }
+      }
+    }
+  }
+  return {-1, -1};
+}
+
+auto Pathfinding::buildFlowField(const Point &goal)
+    -> std::shared_ptr<const FlowField> {
+  if (m_obstaclesDirty.load(std::memory_order_acquire)) {
+    updateBuildingObstacles();
+  }
+
+  std::shared_lock<std::shared_mutex> const lock(m_gridMutex);
+  if (!isWalkable(goal.x, goal.y)) {
+    return nullptr;
+  }
+  return std::make_shared<FlowField>(*this, m_width, m_height, goal,
+                                     obstacleVersion());
 }
 
 auto Pathfinding::findPath(const Point &start,
@@ -121,9 +422,11 @@ auto Pathfinding::findPath(const Point &start,
   if (m_obstaclesDirty.load(std::memory_order_acquire)) {
     updateBuildingObstacles();
   }
+  ensureComponentLabels();
 
-  std::lock_guard<std::mutex> const lock(m_mutex);
-  return findPathInternal(start, end);
+  std::lock_guard<std::mutex> const context_lock(m_syncContextMutex);
+  std::shared_lock<std::shared_mutex> const grid_lock(m_gridMutex);
+  return findPathInternal(*m_contexts.front(), start, end);
 }
 
 auto Pathfinding::findPathAsync(const Point &start, const Point &end)
@@ -133,14 +436,50 @@ auto Pathfinding::findPathAsync(const Point &start, const Point &end)
 }
 
 void Pathfinding::submitPathRequest(std::uint64_t request_id,
-                                    const Point &start, const Point &end) {
+                                    const Point &start, const Point &end,
+                                    PathPriority priority) {
+  // Backlog watermarks per priority: player commands get headroom, AI
+  // storms are shed oldest-first. A shed request completes immediately
+  // with an empty path, so its unit takes the direct-move fallback
+  // instead of waiting on a search that would land seconds stale.
+  static constexpr std::array<std::size_t, 2> k_queue_watermarks = {256, 512};
+
+  std::vector<std::uint64_t> shed;
   {
     std::lock_guard<std::mutex> const lock(m_requestMutex);
-    m_requestQueue.push({request_id, start, end});
+    auto &queue = m_requestQueues[static_cast<std::size_t>(priority)];
+    queue.push({request_id, start, end, std::chrono::steady_clock::now()});
+    std::size_t const cap =
+        k_queue_watermarks[static_cast<std::size_t>(priority)];
+    while (queue.size() > cap) {
+      shed.push_back(queue.front().request_id);
+      queue.pop();
+    }
+  }
+  if (!shed.empty()) {
+    m_droppedRequests.fetch_add(shed.size(), std::memory_order_relaxed);
+    std::lock_guard<std::mutex> const lock(m_resultMutex);
+    for (std::uint64_t const dropped_id : shed) {
+      m_resultQueue.push({dropped_id, {}});
+    }
   }
   m_requestCondition.notify_one();
 }
 
+void Pathfinding::cancelPathRequest(std::uint64_t request_id) {
+  std::lock_guard<std::mutex> const lock(m_requestMutex);
+  m_cancelledRequests.insert(request_id);
+}
+
+void Pathfinding::cancelPathRequests(
+    std::span<const std::uint64_t> request_ids) {
+  if (request_ids.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> const lock(m_requestMutex);
+  m_cancelledRequests.insert(request_ids.begin(), request_ids.end());
+}
+
 auto Pathfinding::fetchCompletedPaths()
     -> std::vector<Pathfinding::PathResult> {
   std::vector<PathResult> results;
@@ -152,9 +491,43 @@ auto Pathfinding::fetchCompletedPaths()
   return results;
 }
 
-auto Pathfinding::findPathInternal(const Point &start,
+auto Pathfinding::walkabilitySnapshot()
+    -> std::shared_ptr<const WalkabilitySnapshot> {
+  const std::uint32_t version = obstacleVersion();
+  std::lock_guard<std::mutex> const lock(m_walkSnapshotMutex);
+  if (m_walkSnapshot && m_walkSnapshot->version() == version) {
+    return m_walkSnapshot;
+  }
+  auto snapshot = std::make_shared<WalkabilitySnapshot>();
+  {
+    std::shared_lock<std::shared_mutex> const grid_lock(m_gridMutex);
+    snapshot->m_words = m_walkable;
+    // Re-read under the grid lock so the copied words and the stamped
+    // version cannot straddle an obstacle update.
+    snapshot->m_version = m_obstacleVersion.load(std::memory_order_acquire);
+  }
+  snapshot->m_width = m_width;
+  snapshot->m_height = m_height;
+  snapshot->m_wordsPerRow = m_wordsPerRow;
+  snapshot->m_offsetX = m_gridOffsetX;
+  snapshot->m_offsetZ = m_gridOffsetZ;
+  m_walkSnapshot = std::move(snapshot);
+  return m_walkSnapshot;
+}
+
+auto Pathfinding::queueDepths() const -> Pathfinding::QueueDepths {
+  std::lock_guard<std::mutex> const lock(m_requestMutex);
+  return {m_requestQueues[static_cast<std::size_t>(PathPriority::High)].size(),
+          m_requestQueues[static_cast<std::size_t>(PathPriority::Normal)]
+              .size(),
+          m_lastQueueWaitMs[0].load(std::memory_order_relaxed),
+          m_lastQueueWaitMs[1].load(std::memory_order_relaxed),
+          m_droppedRequests.load(std::memory_order_relaxed)};
+}
+
+auto Pathfinding::findPathInternal(SearchContext &ctx, const Point &start,
                                    const Point &end) -> std::vector<Point> {
-  ensureWorkingBuffers();
+  ensureWorkingBuffers(ctx);
 
   if (!isWalkable(start.x, start.y) || !isWalkable(end.x, end.y)) {
     return {};
@@ -167,34 +540,310 @@ auto Pathfinding::findPathInternal(const Point &start,
     return {start};
   }
 
-  const std::uint32_t generation = nextGeneration();
+  // Walled-off targets (one-bridge river maps) used to make A* exhaust
+  // the entire reachable region before failing. With current labels a
+  // cross-component query is rejected in O(1) and redirected to the
+  // nearest cell the unit can actually reach.
+  if (!m_labelsDirty.load(std::memory_order_acquire)) {
+    int const start_root = componentRoot(start_idx);
+    int const end_root = componentRoot(end_idx);
+    if (start_root >= 0 && end_root >= 0 && start_root != end_root) {
+      Point const fallback = nearestCellInComponent(end, start_root);
+      if (fallback.x < 0) {
+        return {};
+      }
+      return findPathInternal(ctx, start, fallback);
+    }
+  }
+
+  bool const long_query =
+      calculateHeuristic(start, end) >= 2 * PathHierarchy::kClusterSize;
+
+  if (long_query) {
+    // Units rallying from the same barracks repeat the same route;
+    // serve it from the cluster-keyed cache when possible.
+    auto cached = lookupCachedPath(ctx, start, end);
+    if (!cached.empty()) {
+      return cached;
+    }
+
+    // Long queries go through the cluster/portal abstraction first; a
+    // full grid search on a cross-map path touches tens of thousands of
+    // cells, the hierarchical one only the clusters the route crosses.
+    // Falls through to plain A* when the abstract graph finds no route.
+    std::lock_guard<std::mutex> const hierarchy_lock(m_hierarchyMutex);
+    auto hierarchical = m_hierarchy->findPath(start, end);
+    if (!hierarchical.empty()) {
+      auto smoothed = smoothPath(hierarchical);
+      storeCachedPath(start, end, smoothed);
+      return smoothed;
+    }
+  }
+
+  smoothInto(searchGrid(ctx, start, end, {0, 0}, {m_width - 1, m_height - 1}),
+             ctx.smoothedPath);
+  std::vector<Point> path(ctx.smoothedPath);
+  if (long_query && !path.empty()) {
+    storeCachedPath(start, end, path);
+  }
+  return path;
+}
 
-  m_openHeap.clear();
+auto Pathfinding::hasLineOfWalk(const Point &a, const Point &b) const -> bool {
+  int x0 = a.x;
+  int y0 = a.y;
+  int const x1 = b.x;
+  int const y1 = b.y;
+  int const dx = std::abs(x1 - x0);
+  int const dy = std::abs(y1 - y0);
+  int const sx = x0 < x1 ? 1 : -1;
+  int const sy = y0 < y1 ? 1 : -1;
+  int err = dx - dy;
 
-  setGCost(start_idx, generation, 0);
-  setParent(start_idx, generation, start_idx);
+  while (true) {
+    if (!isWalkable(x0, y0)) {
+      return false;
+    }
+    if (x0 == x1 && y0 == y1) {
+      return true;
+    }
+    int const e2 = 2 * err;
+    bool stepped_x = false;
+    bool stepped_y = false;
+    if (e2 > -dy) {
+      err -= dy;
+      x0 += sx;
+      stepped_x = true;
+    }
+    if (e2 < dx) {
+      err += dx;
+      y0 += sy;
+      stepped_y = true;
+    }
+    if (stepped_x && stepped_y) {
+      // Same no-corner-cutting rule as the searches themselves.
+      if (!isWalkable(x0 - sx, y0) || !isWalkable(x0, y0 - sy)) {
+        return false;
+      }
+    }
+  }
+}
 
-  pushOpenNode({start_idx, calculateHeuristic(start, end), 0});
+auto Pathfinding::smoothPath(const std::vector<Point> &path) const
+    -> std::vector<Point> {
+  std::vector<Point> out;
+  smoothInto(path, out);
+  return out;
+}
 
-  const int max_iterations = std::max(m_width * m_height, 1);
+void Pathfinding::smoothInto(const std::vector<Point> &path,
+                             std::vector<Point> &out) const {
+  out.clear();
+  if (path.size() <= 2) {
+    out.assign(path.begin(), path.end());
+    return;
+  }
+
+  out.push_back(path.front());
+
+  constexpr std::size_t k_max_lookahead = 48;
+  std::size_t anchor = 0;
+  while (anchor + 1 < path.size()) {
+    std::size_t best = anchor + 1;
+    std::size_t const limit =
+        std::min(path.size() - 1, anchor + k_max_lookahead);
+    for (std::size_t j = limit; j > anchor + 1; --j) {
+      if (hasLineOfWalk(path[anchor], path[j])) {
+        best = j;
+        break;
+      }
+    }
+    out.push_back(path[best]);
+    anchor = best;
+  }
+}
+
+auto Pathfinding::clusterKey(const Point &start,
+                             const Point &end) const -> std::uint64_t {
+  int const clusters_x =
+      (m_width + PathHierarchy::kClusterSize - 1) / PathHierarchy::kClusterSize;
+  auto cluster_of = [&](const Point &p) {
+    return static_cast<std::uint64_t>(p.y / PathHierarchy::kClusterSize) *
+               clusters_x +
+           static_cast<std::uint64_t>(p.x / PathHierarchy::kClusterSize);
+  };
+  return (cluster_of(start) << 32U) | cluster_of(end);
+}
+
+auto Pathfinding::lookupCachedPath(SearchContext &ctx, const Point &start,
+                                   const Point &end) -> std::vector<Point> {
+  std::vector<Point> base;
+  {
+    std::lock_guard<std::mutex> const lock(m_pathCacheMutex);
+    auto it = m_pathCache.find(clusterKey(start, end));
+    if (it == m_pathCache.end()) {
+      return {};
+    }
+    if (it->second.obstacleVersion != obstacleVersion()) {
+      m_pathCache.erase(it);
+      return {};
+    }
+    it->second.lastUse = ++m_pathCacheUseCounter;
+    base = it->second.path;
+  }
+
+  auto distance_sq = [](const Point &a, const Point &b) {
+    int const dx = a.x - b.x;
+    int const dy = a.y - b.y;
+    return dx * dx + dy * dy;
+  };
+
+  // Clip the cached route to the waypoints nearest our own endpoints,
+  // then splice short corridor searches onto both ends.
+  std::size_t entry_index = 0;
+  std::size_t exit_index = base.size() - 1;
+  int best_entry = distance_sq(base.front(), start);
+  int best_exit = distance_sq(base.back(), end);
+  for (std::size_t i = 1; i < base.size(); ++i) {
+    int const to_start = distance_sq(base[i], start);
+    if (to_start < best_entry) {
+      best_entry = to_start;
+      entry_index = i;
+    }
+    int const to_end = distance_sq(base[i], end);
+    if (to_end < best_exit) {
+      best_exit = to_end;
+      exit_index = i;
+    }
+  }
+  if (entry_index >= exit_index) {
+    return {};
+  }
+
+  auto corridor = [&](const Point &from, const Point &to) {
+    constexpr int k_splice_margin = 8;
+    Point const box_min{std::max(std::min(from.x, to.x) - k_splice_margin, 0),
+                        std::max(std::min(from.y, to.y) - k_splice_margin, 0)};
+    Point const box_max{
+        std::min(std::max(from.x, to.x) + k_splice_margin, m_width - 1),
+        std::min(std::max(from.y, to.y) + k_splice_margin, m_height - 1)};
+    smoothInto(searchGrid(ctx, from, to, box_min, box_max), ctx.smoothedPath);
+    return ctx.smoothedPath;
+  };
+
+  std::vector<Point> result;
+  result.reserve(base.size() + 2 * PathHierarchy::kClusterSize);
+
+  if (base[entry_index] == start) {
+    result.push_back(start);
+  } else {
+    auto entry_path = corridor(start, base[entry_index]);
+    if (entry_path.empty()) {
+      return {};
+    }
+    result = std::move(entry_path);
+  }
+
+  result.insert(result.end(), base.begin() + entry_index + 1,
+                base.begin() + exit_index + 1);
+
+  if (!(base[exit_index] == end)) {
+    auto exit_path = corridor(base[exit_index], end);
+    if (exit_path.empty()) {
+      return {};
+    }
+    result.insert(result.end(), exit_path.begin() + 1, exit_path.end());
+  }
+
+  return result;
+}
+
+void Pathfinding::storeCachedPath(const Point &start, const Point &end,
+                                  const std::vector<Point> &path) {
+  constexpr std::size_t k_max_cached_paths = 64;
+
+  std::lock_guard<std::mutex> const lock(m_pathCacheMutex);
+  if (m_pathCache.size() >= k_max_cached_paths) {
+    auto oldest = m_pathCache.begin();
+    for (auto it = m_pathCache.begin(); it != m_pathCache.end(); ++it) {
+      if (it->second.lastUse < oldest->second.lastUse) {
+        oldest = it;
+      }
+    }
+    m_pathCache.erase(oldest);
+  }
+  m_pathCache[clusterKey(start, end)] = {path, obstacleVersion(),
+                                         ++m_pathCacheUseCounter};
+}
+
+auto Pathfinding::repairPath(const Point &from, const Point &to,
+                             int margin) -> std::vector<Point> {
+  if (m_obstaclesDirty.load(std::memory_order_acquire)) {
+    updateBuildingObstacles();
+  }
+
+  std::lock_guard<std::mutex> const context_lock(m_syncContextMutex);
+  std::shared_lock<std::shared_mutex> const grid_lock(m_gridMutex);
+
+  if (!isWalkable(from.x, from.y) || !isWalkable(to.x, to.y)) {
+    return {};
+  }
+  if (from == to) {
+    return {from};
+  }
+
+  Point const box_min{std::max(std::min(from.x, to.x) - margin, 0),
+                      std::max(std::min(from.y, to.y) - margin, 0)};
+  Point const box_max{std::min(std::max(from.x, to.x) + margin, m_width - 1),
+                      std::min(std::max(from.y, to.y) + margin, m_height - 1)};
+
+  SearchContext &ctx = *m_contexts.front();
+  ensureWorkingBuffers(ctx);
+  smoothInto(searchGrid(ctx, from, to, box_min, box_max), ctx.smoothedPath);
+  return ctx.smoothedPath;
+}
+
+auto Pathfinding::searchGrid(SearchContext &ctx, const Point &start,
+                             const Point &end, const Point &box_min,
+                             const Point &box_max)
+    -> const std::vector<Point> & {
+  const int start_idx = toIndex(start);
+  const int end_idx = toIndex(end);
+
+  const std::uint32_t generation = nextGeneration(ctx);
+
+  for (int bucket_index : ctx.touchedBuckets) {
+    ctx.openBuckets[static_cast<std::size_t>(bucket_index)].clear();
+  }
+  ctx.touchedBuckets.clear();
+  ctx.openCount = 0;
+  ctx.openCursor = calculateHeuristic(start, end);
+
+  setGCost(ctx, start_idx, generation, 0);
+  setParent(ctx, start_idx, generation, start_idx);
+
+  pushOpenNode(ctx, {start_idx, calculateHeuristic(start, end), 0});
+
+  const int max_iterations = std::max(
+      (box_max.x - box_min.x + 1) * (box_max.y - box_min.y + 1), 1);
   int iterations = 0;
 
   int final_cost = -1;
 
-  while (!m_openHeap.empty() && iterations < max_iterations) {
+  while (ctx.openCount > 0 && iterations < max_iterations) {
     ++iterations;
 
-    QueueNode const current = popOpenNode();
+    QueueNode const current = popOpenNode(ctx);
 
-    if (current.gCost > getGCost(current.index, generation)) {
+    if (current.gCost > getGCost(ctx, current.index, generation)) {
       continue;
     }
 
-    if (isClosed(current.index, generation)) {
+    if (isClosed(ctx, current.index, generation)) {
       continue;
     }
 
-    setClosed(current.index, generation);
+    setClosed(ctx, current.index, generation);
 
     if (current.index == end_idx) {
       final_cost = current.gCost;
@@ -208,133 +857,145 @@ auto Pathfinding::findPathInternal(const Point &start,
 
     for (std::size_t i = 0; i < neighbor_count; ++i) {
       const Point &neighbor = neighbors[i];
+      if (neighbor.x < box_min.x || neighbor.x > box_max.x ||
+          neighbor.y < box_min.y || neighbor.y > box_max.y) {
+        continue;
+      }
       if (!isWalkable(neighbor.x, neighbor.y)) {
         continue;
       }
 
       const int neighbor_idx = toIndex(neighbor);
-      if (isClosed(neighbor_idx, generation)) {
+      if (isClosed(ctx, neighbor_idx, generation)) {
         continue;
       }
 
       const int tentative_gcost = current.gCost + 1;
-      if (tentative_gcost >= getGCost(neighbor_idx, generation)) {
+      if (tentative_gcost >= getGCost(ctx, neighbor_idx, generation)) {
         continue;
       }
 
-      setGCost(neighbor_idx, generation, tentative_gcost);
-      setParent(neighbor_idx, generation, current.index);
+      setGCost(ctx, neighbor_idx, generation, tentative_gcost);
+      setParent(ctx, neighbor_idx, generation, current.index);
 
       const int h_cost = calculateHeuristic(neighbor, end);
-      pushOpenNode({neighbor_idx, tentative_gcost + h_cost, tentative_gcost});
+      pushOpenNode(ctx,
+                   {neighbor_idx, tentative_gcost + h_cost, tentative_gcost});
     }
   }
 
   if (final_cost < 0) {
-    return {};
+    ctx.rawPath.clear();
+    return ctx.rawPath;
   }
 
-  std::vector<Point> path;
-  path.reserve(final_cost + 1);
-  buildPath(start_idx, end_idx, generation, final_cost + 1, path);
-  return path;
+  buildPath(ctx, start_idx, end_idx, generation, final_cost + 1, ctx.rawPath);
+  return ctx.rawPath;
 }
 
 int Pathfinding::calculateHeuristic(const Point &a, const Point &b) {
   return std::abs(a.x - b.x) + std::abs(a.y - b.y);
 }
 
-void Pathfinding::ensureWorkingBuffers() {
+void Pathfinding::ensureWorkingBuffers(SearchContext &ctx) const {
   const std::size_t total_cells =
       static_cast<std::size_t>(m_width) * static_cast<std::size_t>(m_height);
 
-  if (m_closedGeneration.size() != total_cells) {
-    m_closedGeneration.assign(total_cells, 0);
-    m_gCostGeneration.assign(total_cells, 0);
-    m_gCostValues.assign(total_cells, std::numeric_limits<int>::max());
-    m_parentGeneration.assign(total_cells, 0);
-    m_parentValues.assign(total_cells, -1);
+  if (ctx.closedGeneration.size() != total_cells) {
+    ctx.closedGeneration.assign(total_cells, 0);
+    ctx.gCostGeneration.assign(total_cells, 0);
+    ctx.gCostValues.assign(total_cells, std::numeric_limits<int>::max());
+    ctx.parentGeneration.assign(total_cells, 0);
+    ctx.parentValues.assign(total_cells, -1);
   }
 
-  const std::size_t min_open_capacity =
-      std::max<std::size_t>(total_cells / 8, 64);
-  if (m_openHeap.capacity() < min_open_capacity) {
-    m_openHeap.reserve(min_open_capacity);
+  // f-costs rarely exceed twice the grid perimeter heuristic; buckets
+  // grow on demand for pathological searches.
+  const std::size_t min_bucket_count =
+      static_cast<std::size_t>(m_width + m_height) * 2 + 8;
+  if (ctx.openBuckets.size() < min_bucket_count) {
+    ctx.openBuckets.resize(min_bucket_count);
   }
 }
 
-auto Pathfinding::nextGeneration() -> std::uint32_t {
-  auto next = ++m_generationCounter;
+auto Pathfinding::nextGeneration(SearchContext &ctx) -> std::uint32_t {
+  auto next = ++ctx.generationCounter;
   if (next == 0) {
-    resetGenerations();
-    next = ++m_generationCounter;
+    resetGenerations(ctx);
+    next = ++ctx.generationCounter;
   }
   return next;
 }
 
-void Pathfinding::resetGenerations() {
-  std::fill(m_closedGeneration.begin(), m_closedGeneration.end(), 0);
-  std::fill(m_gCostGeneration.begin(), m_gCostGeneration.end(), 0);
-  std::fill(m_parentGeneration.begin(), m_parentGeneration.end(), 0);
-  std::fill(m_gCostValues.begin(), m_gCostValues.end(),
+void Pathfinding::resetGenerations(SearchContext &ctx) {
+  std::fill(ctx.closedGeneration.begin(), ctx.closedGeneration.end(), 0);
+  std::fill(ctx.gCostGeneration.begin(), ctx.gCostGeneration.end(), 0);
+  std::fill(ctx.parentGeneration.begin(), ctx.parentGeneration.end(), 0);
+  std::fill(ctx.gCostValues.begin(), ctx.gCostValues.end(),
             std::numeric_limits<int>::max());
-  std::fill(m_parentValues.begin(), m_parentValues.end(), -1);
-  m_generationCounter = 0;
+  std::fill(ctx.parentValues.begin(), ctx.parentValues.end(), -1);
+  ctx.generationCounter = 0;
 }
 
-auto Pathfinding::isClosed(int index, std::uint32_t generation) const -> bool {
+auto Pathfinding::isClosed(const SearchContext &ctx, int index,
+                           std::uint32_t generation) -> bool {
   return index >= 0 &&
-         static_cast<std::size_t>(index) < m_closedGeneration.size() &&
-         m_closedGeneration[static_cast<std::size_t>(index)] == generation;
+         static_cast<std::size_t>(index) < ctx.closedGeneration.size() &&
+         ctx.closedGeneration[static_cast<std::size_t>(index)] == generation;
 }
 
-void Pathfinding::setClosed(int index, std::uint32_t generation) {
+void Pathfinding::setClosed(SearchContext &ctx, int index,
+                            std::uint32_t generation) {
   if (index >= 0 &&
-      static_cast<std::size_t>(index) < m_closedGeneration.size()) {
-    m_closedGeneration[static_cast<std::size_t>(index)] = generation;
+      static_cast<std::size_t>(index) < ctx.closedGeneration.size()) {
+    ctx.closedGeneration[static_cast<std::size_t>(index)] = generation;
   }
 }
 
-auto Pathfinding::getGCost(int index, std::uint32_t generation) const -> int {
+auto Pathfinding::getGCost(const SearchContext &ctx, int index,
+                           std::uint32_t generation) -> int {
   if (index < 0 ||
-      static_cast<std::size_t>(index) >= m_gCostGeneration.size()) {
+      static_cast<std::size_t>(index) >= ctx.gCostGeneration.size()) {
     return std::numeric_limits<int>::max();
   }
-  if (m_gCostGeneration[static_cast<std::size_t>(index)] == generation) {
-    return m_gCostValues[static_cast<std::size_t>(index)];
+  if (ctx.gCostGeneration[static_cast<std::size_t>(index)] == generation) {
+    return ctx.gCostValues[static_cast<std::size_t>(index)];
   }
   return std::numeric_limits<int>::max();
 }
 
-void Pathfinding::setGCost(int index, std::uint32_t generation, int cost) {
+void Pathfinding::setGCost(SearchContext &ctx, int index,
+                           std::uint32_t generation, int cost) {
   if (index >= 0 &&
-      static_cast<std::size_t>(index) < m_gCostGeneration.size()) {
+      static_cast<std::size_t>(index) < ctx.gCostGeneration.size()) {
     const auto idx = static_cast<std::size_t>(index);
-    m_gCostGeneration[idx] = generation;
-    m_gCostValues[idx] = cost;
+    ctx.gCostGeneration[idx] = generation;
+    ctx.gCostValues[idx] = cost;
   }
 }
 
-auto Pathfinding::hasParent(int index, std::uint32_t generation) const -> bool {
+auto Pathfinding::hasParent(const SearchContext &ctx, int index,
+                            std::uint32_t generation) -> bool {
   return index >= 0 &&
-         static_cast<std::size_t>(index) < m_parentGeneration.size() &&
-         m_parentGeneration[static_cast<std::size_t>(index)] == generation;
+         static_cast<std::size_t>(index) < ctx.parentGeneration.size() &&
+         ctx.parentGeneration[static_cast<std::size_t>(index)] == generation;
 }
 
-auto Pathfinding::getParent(int index, std::uint32_t generation) const -> int {
-  if (hasParent(index, generation)) {
-    return m_parentValues[static_cast<std::size_t>(index)];
+auto Pathfinding::getParent(const SearchContext &ctx, int index,
+                            std::uint32_t generation) -> int {
+  if (hasParent(ctx, index, generation)) {
+    return ctx.parentValues[static_cast<std::size_t>(index)];
   }
   return -1;
 }
 
-void Pathfinding::setParent(int index, std::uint32_t generation,
-                            int parentIndex) {
+void Pathfinding::setParent(SearchContext &ctx, int index,
+                            std::uint32_t generation, int parentIndex) {
   if (index >= 0 &&
-      static_cast<std::size_t>(index) < m_parentGeneration.size()) {
+      static_cast<std::size_t>(index) < ctx.parentGeneration.size()) {
     const auto idx = static_cast<std::size_t>(index);
-    m_parentGeneration[idx] = generation;
-    m_parentValues[idx] = parentIndex;
+    ctx.parentGeneration[idx] = generation;
+    ctx.parentValues[idx] = parentIndex;
   }
 }
 
@@ -367,8 +1028,9 @@ auto Pathfinding::collectNeighbors(
   return count;
 }
 
-void Pathfinding::buildPath(int startIndex, int endIndex,
-                            std::uint32_t generation, int expectedLength,
+void Pathfinding::buildPath(const SearchContext &ctx, int startIndex,
+                            int endIndex, std::uint32_t generation,
+                            int expectedLength,
                             std::vector<Point> &outPath) const {
   outPath.clear();
   if (expectedLength > 0) {
@@ -383,12 +1045,12 @@ void Pathfinding::buildPath(int startIndex, int endIndex,
       return;
     }
 
-    if (!hasParent(current, generation)) {
+    if (!hasParent(ctx, current, generation)) {
       outPath.clear();
       return;
     }
 
-    const int parent = getParent(current, generation);
+    const int parent = getParent(ctx, current, generation);
     if (parent == current || parent < 0) {
       outPath.clear();
       return;
@@ -399,75 +1061,90 @@ void Pathfinding::buildPath(int startIndex, int endIndex,
   outPath.clear();
 }
 
-bool Pathfinding::heapLess(const QueueNode &lhs, const QueueNode &rhs) {
-  if (lhs.fCost != rhs.fCost) {
-    return lhs.fCost < rhs.fCost;
+void Pathfinding::pushOpenNode(SearchContext &ctx, const QueueNode &node) {
+  if (static_cast<std::size_t>(node.fCost) >= ctx.openBuckets.size()) {
+    ctx.openBuckets.resize(static_cast<std::size_t>(node.fCost) + 1);
   }
-  return lhs.gCost < rhs.gCost;
-}
-
-void Pathfinding::pushOpenNode(const QueueNode &node) {
-  m_openHeap.push_back(node);
-  std::size_t index = m_openHeap.size() - 1;
-  while (index > 0) {
-    std::size_t const parent = (index - 1) / 2;
-    if (heapLess(m_openHeap[parent], m_openHeap[index])) {
-      break;
-    }
-    std::swap(m_openHeap[parent], m_openHeap[index]);
-    index = parent;
+  auto &bucket = ctx.openBuckets[static_cast<std::size_t>(node.fCost)];
+  if (bucket.empty()) {
+    ctx.touchedBuckets.push_back(node.fCost);
+  }
+  bucket.push_back(node);
+  ++ctx.openCount;
+  if (node.fCost < ctx.openCursor) {
+    ctx.openCursor = node.fCost;
   }
 }
 
-auto Pathfinding::popOpenNode() -> Pathfinding::QueueNode {
-  QueueNode top = m_openHeap.front();
-  QueueNode const last = m_openHeap.back();
-  m_openHeap.pop_back();
-  if (!m_openHeap.empty()) {
-    m_openHeap[0] = last;
-    std::size_t index = 0;
-    const std::size_t size = m_openHeap.size();
-    while (true) {
-      std::size_t const left = index * 2 + 1;
-      std::size_t const right = left + 1;
-      std::size_t smallest = index;
-
-      if (left < size && !heapLess(m_openHeap[smallest], m_openHeap[left])) {
-        smallest = left;
-      }
-      if (right < size && !heapLess(m_openHeap[smallest], m_openHeap[right])) {
-        smallest = right;
-      }
-      if (smallest == index) {
-        break;
-      }
-      std::swap(m_openHeap[index], m_openHeap[smallest]);
-      index = smallest;
-    }
+auto Pathfinding::popOpenNode(SearchContext &ctx) -> Pathfinding::QueueNode {
+  // Callers guarantee openCount > 0, so the cursor always lands on a
+  // non-empty bucket.
+  while (ctx.openBuckets[static_cast<std::size_t>(ctx.openCursor)].empty()) {
+    ++ctx.openCursor;
   }
-  return top;
+  auto &bucket = ctx.openBuckets[static_cast<std::size_t>(ctx.openCursor)];
+  QueueNode const node = bucket.back();
+  bucket.pop_back();
+  --ctx.openCount;
+  return node;
 }
 
-void Pathfinding::workerLoop() {
+void Pathfinding::workerLoop(std::size_t contextIndex) {
+  Render::ThreadTopology::instance().registerCurrentThread(
+      Render::ThreadTopology::Role::Worker, "pathfinding");
+  Engine::Core::AllocTagScope const alloc_tag(
+      Engine::Core::AllocTag::Pathfinding);
+  SearchContext &ctx = *m_contexts[contextIndex];
+
   while (true) {
     PathRequest request;
     {
       std::unique_lock<std::mutex> lock(m_requestMutex);
       m_requestCondition.wait(lock, [this]() {
-        return m_stopWorker.load(std::memory_order_acquire) ||
-               !m_requestQueue.empty();
+        return m_stopWorkers.load(std::memory_order_acquire) ||
+               !m_requestQueues[0].empty() || !m_requestQueues[1].empty();
       });
 
-      if (m_stopWorker.load(std::memory_order_acquire) &&
-          m_requestQueue.empty()) {
-        break;
+      bool const stopping = m_stopWorkers.load(std::memory_order_acquire);
+      if (m_requestQueues[0].empty() && m_requestQueues[1].empty()) {
+        // Every queued request has been popped by now, so leftover
+        // tombstones can only refer to requests that already ran.
+        m_cancelledRequests.clear();
+        if (stopping) {
+          break;
+        }
+        continue;
       }
 
-      request = m_requestQueue.front();
-      m_requestQueue.pop();
+      std::size_t const priority_index = !m_requestQueues[0].empty() ? 0 : 1;
+      auto &queue = m_requestQueues[priority_index];
+      request = queue.front();
+      queue.pop();
+      m_lastQueueWaitMs[priority_index].store(
+          std::chrono::duration<float, std::milli>(
+              std::chrono::steady_clock::now() - request.enqueueTime)
+              .count(),
+          std::memory_order_relaxed);
+
+      auto const cancelled = m_cancelledRequests.find(request.request_id);
+      if (cancelled != m_cancelledRequests.end()) {
+        // Superseded before it ran; skip the search entirely.
+        m_cancelledRequests.erase(cancelled);
+        continue;
+      }
+    }
+
+    if (m_obstaclesDirty.load(std::memory_order_acquire)) {
+      updateBuildingObstacles();
     }
+    ensureComponentLabels();
 
-    auto path = findPath(request.start, request.end);
+    std::vector<Point> path;
+    {
+      SOI_PROFILE_ZONE("Pathfinding::request");
+      std::shared_lock<std::shared_mutex> const grid_lock(m_gridMutex);
+      path = findPathInternal(ctx, request.start, request.end);
+    }
 
     {
       std::lock_guard<std::mutex> const lock(m_resultMutex);
@@ -476,4 +1153,4 @@ void Pathfinding::workerLoop() {
   }
 }
 
-} // namespace Game::Systems
\ No newline at end of file
+} // namespace Game::Systems
@@ -2,17 +2,26 @@
 
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
 #include <cstdint>
 #include <future>
+#include <memory>
 #include <mutex>
 #include <queue>
+#include <shared_mutex>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
 #include <thread>
 #include <vector>
 
 namespace Game::Systems {
 
 class BuildingCollisionRegistry;
+class FlowField;
+class PathHierarchy;
 
 struct Point {
   int x = 0;
@@ -26,9 +35,56 @@ struct Point {
   }
 };
 
+// Priority class for async path requests. High is for player-initiated
+// commands; Normal is for AI batch traffic, which must never starve the
+// player queue.
+enum class PathPriority : std::uint8_t { High = 0, Normal = 1 };
+
+// Immutable copy of the walkability bit grid, for feasibility probes off
+// the game thread (the AI worker). Readers never touch the live grid, so
+// AI probes cannot contend with searches or obstacle updates; the copy is
+// refreshed only when the obstacle version moves.
+class WalkabilitySnapshot {
+public:
+  [[nodiscard]] auto isWalkable(int x, int y) const -> bool {
+    if (x < 0 || x >= m_width || y < 0 || y >= m_height) {
+      return false;
+    }
+    const std::uint64_t word =
+        m_words[static_cast<std::size_t>(y) *
+                    static_cast<std::size_t>(m_wordsPerRow) +
+                static_cast<std::size_t>(x >> 6)];
+    return ((word >> (x & 63)) & 1ULL) != 0;
+  }
+
+  // World-space probe using the grid offset the live pathfinder applies.
+  [[nodiscard]] auto isWalkableWorld(float world_x, float world_z) const
+      -> bool {
+    const int x = static_cast<int>(world_x - m_offsetX + 0.5F);
+    const int y = static_cast<int>(world_z - m_offsetZ + 0.5F);
+    return isWalkable(x, y);
+  }
+
+  [[nodiscard]] auto version() const -> std::uint32_t { return m_version; }
+  [[nodiscard]] auto width() const -> int { return m_width; }
+  [[nodiscard]] auto height() const -> int { return m_height; }
+
+private:
+  friend class Pathfinding;
+
+  std::vector<std::uint64_t> m_words;
+  int m_width = 0;
+  int m_height = 0;
+  int m_wordsPerRow = 0;
+  float m_offsetX = 0.0F;
+  float m_offsetZ = 0.0F;
+  std::uint32_t m_version = 0;
+};
+
 class Pathfinding {
 public:
-  Pathfinding(int width, int height);
+  // workerCount == 0 picks a count from the hardware concurrency.
+  Pathfinding(int width, int height, unsigned workerCount = 0);
   ~Pathfinding();
 
   void setGridOffset(float offset_x, float offset_z);
@@ -39,17 +95,67 @@ public:
   void setObstacle(int x, int y, bool isObstacle);
   auto isWalkable(int x, int y) const -> bool;
 
+  // Tests a whole rectangle of cells (inclusive corners) with word-wide
+  // bit masks — 64 cells per compare — instead of per-cell lookups; for
+  // formation footprints and path corridors.
+  auto isAreaWalkable(const Point &min, const Point &max) const -> bool;
+
+  // Batched placement solver: copies the walkability window around
+  // center once under a single shared lock, then bit-scans it for up to
+  // count free cells, nearest first. One grid read replaces a per-cell
+  // locked query for every candidate slot. Cells are not reserved —
+  // units do not occupy grid cells, only building footprints do.
+  auto findFreeCellsNear(const Point &center, int radius,
+                         int count) const -> std::vector<Point>;
+
   void updateBuildingObstacles();
 
   void markObstaclesDirty();
 
   auto findPath(const Point &start, const Point &end) -> std::vector<Point>;
 
+  // Localized re-search for repairing a path cut by a new obstacle:
+  // searches only inside the bounding box of from/to inflated by margin
+  // cells, so one building placement doesn't trigger full-map A* runs
+  // for every unit walking past it. Returns empty when no route exists
+  // inside the corridor (callers fall back to a full re-path).
+  auto repairPath(const Point &from, const Point &to,
+                  int margin = 8) -> std::vector<Point>;
+
+  // One shared steering field per group destination; returns nullptr when
+  // the goal cell is blocked. Fields are immutable snapshots of the
+  // current obstacle layout (see obstacleVersion()).
+  auto buildFlowField(const Point &goal) -> std::shared_ptr<const FlowField>;
+
+  // Bumped whenever the obstacle grid changes; lets cached flow fields
+  // detect that they are stale.
+  auto obstacleVersion() const -> std::uint32_t {
+    return m_obstacleVersion.load(std::memory_order_acquire);
+  }
+
+  // Shared read-only copy of the walkability grid, rebuilt lazily when
+  // the obstacle version changes. AI feasibility probes run against this
+  // instead of the live grid, keeping the pathfinder's queue and lock
+  // free for committed orders.
+  auto walkabilitySnapshot() -> std::shared_ptr<const WalkabilitySnapshot>;
+
   auto findPathAsync(const Point &start,
                      const Point &end) -> std::future<std::vector<Point>>;
 
   void submitPathRequest(std::uint64_t request_id, const Point &start,
-                         const Point &end);
+                         const Point &end,
+                         PathPriority priority = PathPriority::High);
+
+  // Marks a submitted request as cancelled; a worker that pops it skips
+  // the search instead of computing a result nobody will read. Re-issued
+  // move orders supersede their predecessor this way, so micro spam costs
+  // one search per unit instead of one per click. No-op for requests that
+  // already ran (their result is discarded downstream as before).
+  void cancelPathRequest(std::uint64_t request_id);
+
+  // Batch form: one lock acquisition for a whole selection's worth of
+  // cancellations (multi-unit stance/stop/patrol commands).
+  void cancelPathRequests(std::span<const std::uint64_t> request_ids);
 
   struct PathResult {
     std::uint64_t request_id;
@@ -57,15 +163,79 @@ public:
   };
   auto fetchCompletedPaths() -> std::vector<PathResult>;
 
+  // Pending request counts per priority class plus backpressure
+  // signals, for perf overlays and logging. Wait times are the queue
+  // ages of the most recently dispatched request per class; dropped
+  // counts requests shed at the backlog cap since startup.
+  struct QueueDepths {
+    std::size_t high = 0;
+    std::size_t normal = 0;
+    float highWaitMs = 0.0F;
+    float normalWaitMs = 0.0F;
+    std::uint64_t dropped = 0;
+  };
+  auto queueDepths() const -> QueueDepths;
+
 private:
-  auto findPathInternal(const Point &start,
+  struct QueueNode {
+    int index;
+    int fCost;
+    int gCost;
+  };
+
+  // Per-thread scratch state for one grid search. Each worker owns a
+  // context, plus one shared by synchronous findPath callers, so searches
+  // can run in parallel under a shared grid lock.
+  struct SearchContext {
+    std::vector<std::uint32_t> closedGeneration;
+    std::vector<std::uint32_t> gCostGeneration;
+    std::vector<int> gCostValues;
+    std::vector<std::uint32_t> parentGeneration;
+    std::vector<int> parentValues;
+    // Dial-style open list: one bucket per f-cost (grid costs are small
+    // bounded integers), giving O(1) push/pop with no comparator in the
+    // inner loop. touchedBuckets records which buckets a search dirtied
+    // so the next search only clears those.
+    std::vector<std::vector<QueueNode>> openBuckets;
+    std::vector<int> touchedBuckets;
+    int openCursor{0};
+    std::size_t openCount{0};
+    std::uint32_t generationCounter{0};
+    // Path output scratch reused across searches: the dense per-cell
+    // reconstruction and the smoothing result keep their capacity, so a
+    // steady-state request's only allocation is the right-sized vector
+    // handed to the caller through PathResult.
+    std::vector<Point> rawPath;
+    std::vector<Point> smoothedPath;
+  };
+
+  auto findPathInternal(SearchContext &ctx, const Point &start,
                         const Point &end) -> std::vector<Point>;
 
+  // A* over the obstacle grid restricted to an inclusive bounding box;
+  // findPathInternal passes the whole grid, repairPath a corridor.
+  // Returns ctx.rawPath (empty on failure), valid until the next search
+  // on the same context.
+  auto searchGrid(SearchContext &ctx, const Point &start, const Point &end,
+                  const Point &box_min,
+                  const Point &box_max) -> const std::vector<Point> &;
+
+  // String-pulling pass over a dense per-cell path: keeps only the turn
+  // points that are actually needed, so PathResult::path carries a
+  // handful of waypoints instead of one per cell and per-unit steering
+  // does that much less waypoint-reached bookkeeping. smoothInto writes
+  // into a caller-owned buffer (ctx.smoothedPath on the hot path);
+  // smoothPath is the allocating convenience wrapper.
+  void smoothInto(const std::vector<Point> &path,
+                  std::vector<Point> &out) const;
+  auto smoothPath(const std::vector<Point> &path) const -> std::vector<Point>;
+  auto hasLineOfWalk(const Point &a, const Point &b) const -> bool;
+
   static auto calculateHeuristic(const Point &a, const Point &b) -> int;
 
-  void ensureWorkingBuffers();
-  auto nextGeneration() -> std::uint32_t;
-  void resetGenerations();
+  void ensureWorkingBuffers(SearchContext &ctx) const;
+  static auto nextGeneration(SearchContext &ctx) -> std::uint32_t;
+  static void resetGenerations(SearchContext &ctx);
 
   auto toIndex(int x, int y) const -> int { return y * m_width + x; }
   auto toIndex(const Point &p) const -> int { return toIndex(p.x, p.y); }
@@ -73,59 +243,124 @@ private:
     return {index % m_width, index / m_width};
   }
 
-  auto isClosed(int index, std::uint32_t generation) const -> bool;
-  void setClosed(int index, std::uint32_t generation);
+  static auto isClosed(const SearchContext &ctx, int index,
+                       std::uint32_t generation) -> bool;
+  static void setClosed(SearchContext &ctx, int index,
+                        std::uint32_t generation);
+
+  static auto getGCost(const SearchContext &ctx, int index,
+                       std::uint32_t generation) -> int;
+  static void setGCost(SearchContext &ctx, int index, std::uint32_t generation,
+                       int cost);
+
+  static auto hasParent(const SearchContext &ctx, int index,
+                        std::uint32_t generation) -> bool;
+  static auto getParent(const SearchContext &ctx, int index,
+                        std::uint32_t generation) -> int;
+  static void setParent(SearchContext &ctx, int index,
+                        std::uint32_t generation, int parentIndex);
 
-  auto getGCost(int index, std::uint32_t generation) const -> int;
-  void setGCost(int index, std::uint32_t generation, int cost);
+  // LRU cache of long paths keyed by (start cluster, goal cluster), so
+  // rally and patrol routes repeated by every unit from the same
+  // barracks are served from cache and only spliced at the ends.
+  // Entries are stamped with the obstacle version and dropped when it
+  // moves on.
+  struct CachedPath {
+    std::vector<Point> path;
+    std::uint32_t obstacleVersion = 0;
+    std::uint64_t lastUse = 0;
+  };
+  auto lookupCachedPath(SearchContext &ctx, const Point &start,
+                        const Point &end) -> std::vector<Point>;
+  void storeCachedPath(const Point &start, const Point &end,
+                       const std::vector<Point> &path);
+  auto clusterKey(const Point &start, const Point &end) const -> std::uint64_t;
 
-  auto hasParent(int index, std::uint32_t generation) const -> bool;
-  auto getParent(int index, std::uint32_t generation) const -> int;
-  void setParent(int index, std::uint32_t generation, int parentIndex);
+  // Connected-component labels over the walkable grid, kept as a
+  // union-find parent forest (flattened on rebuild so queries resolve in
+  // one or two hops). Searches reject cross-component queries in O(1)
+  // instead of exhausting the whole reachable region. Blocking a cell
+  // may split a component, so it only marks the labels dirty; clearing a
+  // cell merges in place.
+  void rebuildComponentLabels();
+  void ensureComponentLabels();
+  auto componentRoot(int index) const -> int;
+  auto nearestCellInComponent(const Point &around, int root) const -> Point;
 
   auto collectNeighbors(const Point &point,
                         std::array<Point, 8> &buffer) const -> std::size_t;
-  void buildPath(int startIndex, int endIndex, std::uint32_t generation,
-                 int expectedLength, std::vector<Point> &outPath) const;
+  void buildPath(const SearchContext &ctx, int startIndex, int endIndex,
+                 std::uint32_t generation, int expectedLength,
+                 std::vector<Point> &outPath) const;
 
-  struct QueueNode {
-    int index;
-    int fCost;
-    int gCost;
-  };
+  static void pushOpenNode(SearchContext &ctx, const QueueNode &node);
+  static auto popOpenNode(SearchContext &ctx) -> QueueNode;
 
-  static auto heapLess(const QueueNode &lhs, const QueueNode &rhs) -> bool;
-  void pushOpenNode(const QueueNode &node);
-  auto popOpenNode() -> QueueNode;
+  void workerLoop(std::size_t contextIndex);
 
-  void workerLoop();
+  void setWalkableBit(int x, int y, bool walkable);
+  void resetWalkableBits();
 
   int m_width, m_height;
-  std::vector<std::vector<std::uint8_t>> m_obstacles;
+  // Walkability packed 1 bit/cell (1 = walkable), row-major with
+  // m_wordsPerRow 64-bit words per row; a cache line covers 512 cells.
+  std::vector<std::uint64_t> m_walkable;
+  int m_wordsPerRow;
   float m_gridCellSize{1.0F};
   float m_gridOffsetX{0.0F}, m_gridOffsetZ{0.0F};
   std::atomic<bool> m_obstaclesDirty;
-  mutable std::mutex m_mutex;
-  std::atomic<bool> m_stopWorker{false};
-  std::thread m_workerThread;
-  std::mutex m_requestMutex;
+  std::atomic<std::uint32_t> m_obstacleVersion{0};
+  // Readers (searches, flow-field builds) take this shared; obstacle
+  // mutation takes it exclusive.
+  mutable std::shared_mutex m_gridMutex;
+  // Cached walkability copy handed to off-thread probes; guarded by its
+  // own mutex so snapshot refreshes never hold the grid lock exclusively.
+  std::mutex m_walkSnapshotMutex;
+  std::shared_ptr<const WalkabilitySnapshot> m_walkSnapshot;
+  std::atomic<bool> m_stopWorkers{false};
+  std::vector<std::thread> m_workerThreads;
+  mutable std::mutex m_requestMutex;
   std::condition_variable m_requestCondition;
   struct PathRequest {
     std::uint64_t request_id{};
     Point start;
     Point end;
+    // Stamped at submit; the dispatch delta is the backpressure signal
+    // surfaced through queueDepths().
+    std::chrono::steady_clock::time_point enqueueTime;
   };
-  std::queue<PathRequest> m_requestQueue;
+  // One queue per PathPriority; workers always drain High before Normal.
+  // Each queue is bounded: past its watermark the oldest requests are
+  // shed with an empty result so consumers never wait on seconds-stale
+  // searches during AI command storms.
+  std::array<std::queue<PathRequest>, 2> m_requestQueues;
+  std::array<std::atomic<float>, 2> m_lastQueueWaitMs{};
+  std::atomic<std::uint64_t> m_droppedRequests{0};
+  // Tombstones for cancelled requests, consumed (or dropped wholesale
+  // once the queues drain) under m_requestMutex.
+  std::unordered_set<std::uint64_t> m_cancelledRequests;
   std::mutex m_resultMutex;
   std::queue<PathResult> m_resultQueue;
 
-  mutable std::vector<std::uint32_t> m_closedGeneration;
-  mutable std::vector<std::uint32_t> m_gCostGeneration;
-  mutable std::vector<int> m_gCostValues;
-  mutable std::vector<std::uint32_t> m_parentGeneration;
-  mutable std::vector<int> m_parentValues;
-  mutable std::vector<QueueNode> m_openHeap;
-  mutable std::uint32_t m_generationCounter{0};
+  std::unordered_map<std::uint64_t, CachedPath> m_pathCache;
+  std::uint64_t m_pathCacheUseCounter{0};
+  std::mutex m_pathCacheMutex;
+
+  // Union-find parents per cell; -1 for blocked cells. Mutated only
+  // under the exclusive grid lock.
+  std::vector<int> m_componentParent;
+  std::atomic<bool> m_labelsDirty{true};
+
+  // Context 0 serves synchronous findPath callers (guarded by
+  // m_syncContextMutex); contexts 1..N belong to the workers.
+  std::vector<std::unique_ptr<SearchContext>> m_contexts;
+  std::mutex m_syncContextMutex;
+
+  // Cluster/portal abstraction for long-distance queries. Its lazy
+  // rebuild and scratch buffers need exclusive access, so abstract
+  // queries serialize on this mutex even though the grid lock is shared.
+  std::unique_ptr<PathHierarchy> m_hierarchy;
+  std::mutex m_hierarchyMutex;
 };
 
-} // namespace Game::Systems
\ No newline at end of file
+} // namespace Game::Systems
@@ -1,8 +1,11 @@
 #include "patrol_system.h"
 #include "../core/component.h"
 #include "../core/world.h"
+#include "command_service.h"
+#include "pathfinding.h"
 #include <QVector3D>
 #include <cmath>
+#include <cstdint>
 
 namespace Game::Systems {
 
@@ -11,7 +14,7 @@ void PatrolSystem::update(Engine::Core::World *world, float deltaTime) {
     return;
   }
 
-  auto entities = world->getEntitiesWith<Engine::Core::PatrolComponent>();
+  const auto &entities = world->view<Engine::Core::PatrolComponent>();
 
   for (auto *entity : entities) {
     auto *patrol = entity->getComponent<Engine::Core::PatrolComponent>();
@@ -40,7 +43,7 @@ void PatrolSystem::update(Engine::Core::World *world, float deltaTime) {
     }
 
     bool enemy_nearby = false;
-    auto all_entities = world->getEntitiesWith<Engine::Core::UnitComponent>();
+    const auto &all_entities = world->view<Engine::Core::UnitComponent>();
     for (auto *other : all_entities) {
       auto *other_unit = other->getComponent<Engine::Core::UnitComponent>();
       auto *other_transform =
@@ -79,10 +82,41 @@ void PatrolSystem::update(Engine::Core::World *world, float deltaTime) {
       continue;
     }
 
+    auto &routes = m_routes[entity->getId()];
+    if (routes.legs.size() != patrol->waypoints.size()) {
+      routes.legs.assign(patrol->waypoints.size(), {});
+      routes.hasActiveLeg = false;
+    }
+
+    auto *pathfinder = CommandService::getPathfinder();
+    std::uint32_t const obstacle_version =
+        pathfinder != nullptr ? pathfinder->obstacleVersion() : 0;
+
+    if (!routes.hasActiveLeg || routes.activeLeg != patrol->currentWaypoint) {
+      routes.activeLeg = patrol->currentWaypoint;
+      routes.hasActiveLeg = true;
+      routes.captured = false;
+    }
+
     auto waypoint = patrol->waypoints[patrol->currentWaypoint];
     float target_x = waypoint.first;
     float target_z = waypoint.second;
 
+    // Blocked legs are resolved by the movement system with an async A*
+    // path; capture it the first time it shows up (only when it really
+    // routes to this leg's waypoint) so later loops replay it instead of
+    // searching again.
+    if (!routes.captured && !movement->pathPending &&
+        !movement->path.empty() &&
+        std::abs(movement->goalX - target_x) < 0.5F &&
+        std::abs(movement->goalY - target_z) < 0.5F) {
+      auto &leg = routes.legs[routes.activeLeg];
+      leg.path = movement->path;
+      leg.obstacleVersion = obstacle_version;
+      leg.valid = true;
+      routes.captured = true;
+    }
+
     float const dx = target_x - transform->position.x;
     float const dz = target_z - transform->position.z;
     float const dist_sq = dx * dx + dz * dz;
@@ -94,6 +128,43 @@ void PatrolSystem::update(Engine::Core::World *world, float deltaTime) {
       waypoint = patrol->waypoints[patrol->currentWaypoint];
       target_x = waypoint.first;
       target_z = waypoint.second;
+
+      routes.activeLeg = patrol->currentWaypoint;
+      routes.hasActiveLeg = true;
+      routes.captured = false;
+
+      auto &leg = routes.legs[patrol->currentWaypoint];
+      if (leg.valid && leg.obstacleVersion != obstacle_version) {
+        leg.valid = false;
+      }
+      if (leg.valid) {
+        // Replay the captured route, trimming waypoints already behind
+        // us the same way processPathResults does.
+        movement->path = leg.path;
+        while (!movement->path.empty()) {
+          float const wx =
+              movement->path.front().first - transform->position.x;
+          float const wz =
+              movement->path.front().second - transform->position.z;
+          if (wx * wx + wz * wz <=
+              CommandService::WAYPOINT_SKIP_THRESHOLD_SQ) {
+            movement->path.erase(movement->path.begin());
+          } else {
+            break;
+          }
+        }
+        movement->pathPending = false;
+        movement->pendingRequestId = 0;
+        movement->goalX = target_x;
+        movement->goalY = target_z;
+        routes.captured = true;
+        if (!movement->path.empty()) {
+          movement->hasTarget = true;
+          movement->target_x = movement->path.front().first;
+          movement->target_y = movement->path.front().second;
+          continue;
+        }
+      }
     }
 
     movement->hasTarget = true;
@@ -102,6 +173,12 @@ void PatrolSystem::update(Engine::Core::World *world, float deltaTime) {
     movement->goalX = target_x;
     movement->goalY = target_z;
   }
+
+  // Routes for entities that died or stopped patrolling are pruned
+  // wholesale once the map clearly outgrows the live set.
+  if (m_routes.size() > entities.size() * 2 + 64) {
+    m_routes.clear();
+  }
 }
 
 } // namespace Game::Systems
@@ -1,7 +1,15 @@
 #pragma once
 
+#include "../core/entity.h"
+#include "../core/small_vector.h"
 #include "../core/system.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 namespace Game::Systems {
 
 class PatrolSystem : public Engine::Core::System {
@@ -10,6 +18,31 @@ public:
   ~PatrolSystem() override = default;
 
   void update(Engine::Core::World *world, float deltaTime) override;
+  [[nodiscard]] auto name() const -> const char * override {
+    return "PatrolSystem";
+  }
+  // Waypoint advancement tolerances are coarse; 10 Hz is plenty.
+  [[nodiscard]] auto tickInterval() const -> int override { return 3; }
+
+private:
+  // One captured route per patrol leg, replayed on later loops so a
+  // steady-state perimeter costs no pathfinding. Entries are stamped
+  // with the pathfinder's obstacle version; a building placed across a
+  // leg invalidates it and the next traversal recomputes.
+  struct CachedLeg {
+    Engine::Core::SmallVector<std::pair<float, float>, 8> path;
+    std::uint32_t obstacleVersion = 0;
+    bool valid = false;
+  };
+  struct PatrolRoutes {
+    std::vector<CachedLeg> legs;
+    // Leg being traversed, keyed by the waypoint it approaches, and
+    // whether its route was already captured this traversal.
+    std::size_t activeLeg = 0;
+    bool hasActiveLeg = false;
+    bool captured = false;
+  };
+  std::unordered_map<Engine::Core::EntityID, PatrolRoutes> m_routes;
 };
 
 } // namespace Game::Systems
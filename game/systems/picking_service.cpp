@@ -2,7 +2,9 @@
 #include "../../render/gl/camera.h"
 #include "../core/component.h"
 #include "../core/world.h"
+#include "spatial_grid.h"
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <qglobal.h>
 #include <qpoint.h>
@@ -11,6 +13,44 @@
 
 namespace Game::Systems {
 
+namespace {
+
+// World-space radius around the picked ground point that safely covers the
+// screen-space pick radii at any supported zoom, with building footprints on
+// top.
+constexpr float kPickCullRadius = 40.0F;
+
+// Pickable candidates near a screen point, culled through the spatial grid
+// when a ground unprojection is available; falls back to every entity when
+// the cursor is off the terrain (e.g. above the horizon) or the grid has not
+// been built yet.
+auto collectPickCandidates(float sx, float sy, Engine::Core::World &world,
+                           const Render::GL::Camera &camera, int viewW,
+                           int viewH) -> std::vector<Engine::Core::Entity *> {
+  std::vector<Engine::Core::Entity *> candidates;
+
+  auto &grid = SpatialGrid::instance();
+  QVector3D ground;
+  if (grid.entryCount() > 0 &&
+      PickingService::screenToGround(camera, viewW, viewH, QPointF(sx, sy),
+                                     ground)) {
+    grid.forEachInRadius(ground.x(), ground.z(), kPickCullRadius,
+                         [&](const SpatialGrid::Entry &entry) {
+                           auto *entity = world.getEntity(entry.id);
+                           if (entity != nullptr) {
+                             candidates.push_back(entity);
+                           }
+                         });
+    return candidates;
+  }
+
+  auto ents = world.getEntitiesWith<Engine::Core::TransformComponent>();
+  candidates.assign(ents.begin(), ents.end());
+  return candidates;
+}
+
+} // namespace
+
 bool PickingService::worldToScreen(const Render::GL::Camera &cam, int viewW,
                                    int viewH, const QVector3D &world,
                                    QPointF &out) {
@@ -56,6 +96,28 @@ auto PickingService::projectBounds(const Render::GL::Camera &cam,
   return true;
 }
 
+void PickingService::setResolvedPick(Engine::Core::EntityID id,
+                                     const QPointF &screenPt, bool valid) {
+  m_resolvedPickId = id;
+  m_resolvedPickPt = screenPt;
+  m_resolvedPickValid = valid;
+}
+
+auto PickingService::resolvedPickFor(float sx, float sy) const
+    -> std::optional<Engine::Core::EntityID> {
+  // The ID buffer is sampled at the hover cursor; only answer queries for
+  // effectively the same pixel so picks at other positions still scan.
+  constexpr float k_resolved_pick_slop = 2.0F;
+  if (!m_resolvedPickValid) {
+    return std::nullopt;
+  }
+  if (std::abs(sx - float(m_resolvedPickPt.x())) > k_resolved_pick_slop ||
+      std::abs(sy - float(m_resolvedPickPt.y())) > k_resolved_pick_slop) {
+    return std::nullopt;
+  }
+  return m_resolvedPickId;
+}
+
 auto PickingService::updateHover(float sx, float sy, Engine::Core::World &world,
                                  const Render::GL::Camera &camera, int viewW,
                                  int viewH) -> Engine::Core::EntityID {
@@ -85,11 +147,29 @@ auto PickingService::updateHover(float sx, float sy, Engine::Core::World &world,
   return current_hover;
 }
 
-Engine::Core::EntityID
-PickingService::pickSingle(float sx, float sy, Engine::Core::World &world,
-                           const Render::GL::Camera &camera, int viewW,
-                           int viewH, int ownerFilter,
-                           bool preferBuildingsFirst) {
+auto PickingService::pickSingle(float sx, float sy, Engine::Core::World &world,
+                                const Render::GL::Camera &camera, int viewW,
+                                int viewH, int ownerFilter,
+                                bool preferBuildingsFirst) const
+    -> Engine::Core::EntityID {
+  // Fresh ID-buffer result for this position: validate the filters against
+  // the single candidate instead of scanning the world.
+  if (auto resolved = resolvedPickFor(sx, sy)) {
+    Engine::Core::EntityID const id = *resolved;
+    if (id == 0) {
+      return 0;
+    }
+    auto *entity = world.getEntity(id);
+    if (entity == nullptr ||
+        !entity->hasComponent<Engine::Core::UnitComponent>()) {
+      return 0;
+    }
+    auto *unit = entity->getComponent<Engine::Core::UnitComponent>();
+    if (ownerFilter != 0 && unit->owner_id != ownerFilter) {
+      return 0;
+    }
+    return id;
+  }
 
   const float base_unit_pick_radius = 30.0F;
   const float base_building_pick_radius = 30.0F;
@@ -97,7 +177,7 @@ PickingService::pickSingle(float sx, float sy, Engine::Core::World &world,
   float best_building_dist2 = std::numeric_limits<float>::max();
   Engine::Core::EntityID best_unit_id = 0;
   Engine::Core::EntityID best_building_id = 0;
-  auto ents = world.getEntitiesWith<Engine::Core::TransformComponent>();
+  auto ents = collectPickCandidates(sx, sy, world, camera, viewW, viewH);
   for (auto *e : ents) {
     if (!e->hasComponent<Engine::Core::UnitComponent>()) {
       continue;
@@ -227,15 +307,79 @@ auto PickingService::pickUnitFirst(
   return pickSingle(sx, sy, world, camera, viewW, viewH, ownerFilter, true);
 }
 
+auto PickingService::cachedWorldToScreen(const Render::GL::Camera &camera,
+                                         Engine::Core::EntityID id,
+                                         const QVector3D &world, int viewW,
+                                         int viewH,
+                                         QPointF &outScreen) const -> bool {
+  if (camera.version() != m_projectionCacheCameraVersion ||
+      viewW != m_projectionCacheViewW || viewH != m_projectionCacheViewH) {
+    m_projectionCache.clear();
+    m_projectionCacheCameraVersion = camera.version();
+    m_projectionCacheViewW = viewW;
+    m_projectionCacheViewH = viewH;
+  }
+
+  auto it = m_projectionCache.find(id);
+  if (it != m_projectionCache.end() && it->second.worldPos == world) {
+    outScreen = it->second.screen;
+    return it->second.onScreen;
+  }
+
+  bool const on_screen = camera.worldToScreen(world, viewW, viewH, outScreen);
+  m_projectionCache[id] = {world, outScreen, on_screen};
+  return on_screen;
+}
+
 std::vector<Engine::Core::EntityID> PickingService::pickInRect(
     float x1, float y1, float x2, float y2, Engine::Core::World &world,
-    const Render::GL::Camera &camera, int viewW, int viewH, int ownerFilter) {
+    const Render::GL::Camera &camera, int viewW, int viewH,
+    int ownerFilter) const {
   float const minX = std::min(x1, x2);
   float const maxX = std::max(x1, x2);
   float const minY = std::min(y1, y2);
   float const maxY = std::max(y1, y2);
   std::vector<Engine::Core::EntityID> picked;
-  auto ents = world.getEntitiesWith<Engine::Core::TransformComponent>();
+
+  // Unproject the rect corners onto the ground and cull through the spatial
+  // grid: only entities inside the covering circle can project into the
+  // rect. Falls back to the full entity list when a corner misses the
+  // terrain.
+  std::vector<Engine::Core::Entity *> ents;
+  auto &grid = SpatialGrid::instance();
+  QVector3D corners[4];
+  bool const corners_ok =
+      grid.entryCount() > 0 &&
+      screenToGround(camera, viewW, viewH, QPointF(minX, minY), corners[0]) &&
+      screenToGround(camera, viewW, viewH, QPointF(maxX, minY), corners[1]) &&
+      screenToGround(camera, viewW, viewH, QPointF(maxX, maxY), corners[2]) &&
+      screenToGround(camera, viewW, viewH, QPointF(minX, maxY), corners[3]);
+  if (corners_ok) {
+    float center_x = 0.0F;
+    float center_z = 0.0F;
+    for (const auto &corner : corners) {
+      center_x += corner.x() * 0.25F;
+      center_z += corner.z() * 0.25F;
+    }
+    float radius_sq = 0.0F;
+    for (const auto &corner : corners) {
+      float const dx = corner.x() - center_x;
+      float const dz = corner.z() - center_z;
+      radius_sq = std::max(radius_sq, dx * dx + dz * dz);
+    }
+    float const cull_radius = std::sqrt(radius_sq) + 2.0F;
+    grid.forEachInRadius(center_x, center_z, cull_radius,
+                         [&](const SpatialGrid::Entry &entry) {
+                           auto *entity = world.getEntity(entry.id);
+                           if (entity != nullptr) {
+                             ents.push_back(entity);
+                           }
+                         });
+  } else {
+    auto all = world.getEntitiesWith<Engine::Core::TransformComponent>();
+    ents.assign(all.begin(), all.end());
+  }
+
   for (auto *e : ents) {
     if (!e->hasComponent<Engine::Core::UnitComponent>()) {
       continue;
@@ -249,7 +393,8 @@ std::vector<Engine::Core::EntityID> PickingService::pickInRect(
     }
     auto *t = e->getComponent<Engine::Core::TransformComponent>();
     QPointF sp;
-    if (!camera.worldToScreen(
+    if (!cachedWorldToScreen(
+            camera, e->getId(),
             QVector3D(t->position.x, t->position.y, t->position.z), viewW,
             viewH, sp)) {
       continue;
@@ -3,7 +3,10 @@
 #include <QPointF>
 #include <QRectF>
 #include <QVector3D>
+#include <cstdint>
 #include <limits>
+#include <optional>
+#include <unordered_map>
 #include <vector>
 
 namespace Engine::Core {
@@ -25,6 +28,12 @@ public:
                    const Render::GL::Camera &camera, int viewW,
                    int viewH) -> Engine::Core::EntityID;
 
+  // GPU ID-buffer result for the current cursor, injected by the app once
+  // per frame. While fresh, single picks at that position resolve from it
+  // directly instead of scanning world entities.
+  void setResolvedPick(Engine::Core::EntityID id, const QPointF &screenPt,
+                       bool valid);
+
   static auto screenToGround(const Render::GL::Camera &camera, int viewW,
                              int viewH, const QPointF &screenPt,
                              QVector3D &outWorld) -> bool;
@@ -36,23 +45,51 @@ public:
                             int viewH, const QVector3D &world,
                             QPointF &outScreen) -> bool;
 
-  static auto pickSingle(float sx, float sy, Engine::Core::World &world,
-                         const Render::GL::Camera &camera, int viewW, int viewH,
-                         int ownerFilter,
-                         bool preferBuildingsFirst) -> Engine::Core::EntityID;
+  auto pickSingle(float sx, float sy, Engine::Core::World &world,
+                  const Render::GL::Camera &camera, int viewW, int viewH,
+                  int ownerFilter,
+                  bool preferBuildingsFirst) const -> Engine::Core::EntityID;
 
   auto pickUnitFirst(float sx, float sy, Engine::Core::World &world,
                      const Render::GL::Camera &camera, int viewW, int viewH,
                      int ownerFilter) const -> Engine::Core::EntityID;
 
-  static auto
-  pickInRect(float x1, float y1, float x2, float y2, Engine::Core::World &world,
-             const Render::GL::Camera &camera, int viewW, int viewH,
-             int ownerFilter) -> std::vector<Engine::Core::EntityID>;
+  auto pickInRect(float x1, float y1, float x2, float y2,
+                  Engine::Core::World &world, const Render::GL::Camera &camera,
+                  int viewW, int viewH,
+                  int ownerFilter) const -> std::vector<Engine::Core::EntityID>;
 
 private:
+  // Resolved ID-buffer pick, only trusted for queries at (or within a
+  // couple of pixels of) the position it was sampled at.
+  [[nodiscard]] auto resolvedPickFor(float sx, float sy) const
+      -> std::optional<Engine::Core::EntityID>;
+
+  // Screen projections computed for box-selection tests, valid for one
+  // camera pose (keyed on Camera::version() and the viewport) and only
+  // reused while the unit has not moved. Repeated drag-select updates
+  // over a static camera then skip the worldToScreen math entirely.
+  struct ProjectionCacheEntry {
+    QVector3D worldPos;
+    QPointF screen;
+    bool onScreen = false;
+  };
+  auto cachedWorldToScreen(const Render::GL::Camera &camera,
+                           Engine::Core::EntityID id, const QVector3D &world,
+                           int viewW, int viewH,
+                           QPointF &outScreen) const -> bool;
+  mutable std::unordered_map<Engine::Core::EntityID, ProjectionCacheEntry>
+      m_projectionCache;
+  mutable std::uint64_t m_projectionCacheCameraVersion =
+      ~static_cast<std::uint64_t>(0);
+  mutable int m_projectionCacheViewW = 0;
+  mutable int m_projectionCacheViewH = 0;
+
   Engine::Core::EntityID m_prev_hoverId = 0;
   int m_hoverGraceTicks = 0;
+  Engine::Core::EntityID m_resolvedPickId = 0;
+  QPointF m_resolvedPickPt;
+  bool m_resolvedPickValid = false;
   auto projectBounds(const Render::GL::Camera &cam, const QVector3D &center,
                      float hx, float hz, int viewW, int viewH,
                      QRectF &out) const -> bool;
@@ -1,15 +1,41 @@
 #include "production_service.h"
 #include "../core/component.h"
+#include "../core/ownership_constants.h"
 #include "../core/world.h"
 #include "../game_config.h"
+#include "../map/map_transformer.h"
+#include "../units/factory.h"
 #include "../units/troop_config.h"
+#include "command_service.h"
 #include "core/entity.h"
+#include "pathfinding.h"
+#include "replay_service.h"
+#include "timer_wheel.h"
 #include "units/spawn_type.h"
 #include "units/troop_type.h"
+#include "units/unit.h"
+#include <QString>
+#include <cmath>
+#include <cstdint>
+#include <qvectornd.h>
+#include <unordered_map>
 #include <vector>
 
 namespace Game::Systems {
 
+namespace {
+struct ScheduledProduction {
+  std::uint64_t timerId = 0;
+  double completionTime = 0.0;
+};
+} // namespace
+
+static TimerWheel s_productionTimers;
+static std::unordered_map<Engine::Core::EntityID, ScheduledProduction>
+    s_scheduledProductions;
+static double s_productionClock = 0.0;
+static std::vector<std::uint64_t> s_expiredProductions;
+
 static auto
 findFirstSelectedBarracks(Engine::Core::World &world,
                           const std::vector<Engine::Core::EntityID> &selected,
@@ -32,6 +58,10 @@ auto ProductionService::startProductionForFirstSelectedBarracks(
     Engine::Core::World &world,
     const std::vector<Engine::Core::EntityID> &selected, int owner_id,
     Game::Units::TroopType unit_type) -> ProductionResult {
+  ReplayService::instance().recordProduction(
+      selected, owner_id,
+      QString::fromStdString(Game::Units::troop_typeToString(unit_type)));
+
   auto *e = findFirstSelectedBarracks(world, selected, owner_id);
   if (e == nullptr) {
     return ProductionResult::NoBarracks;
@@ -72,6 +102,7 @@ auto ProductionService::startProductionForFirstSelectedBarracks(
     p->product_type = unit_type;
     p->timeRemaining = p->buildTime;
     p->inProgress = true;
+    scheduleCompletion(e->getId(), p->buildTime);
   }
 
   return ProductionResult::Success;
@@ -81,6 +112,8 @@ auto ProductionService::setRallyForFirstSelectedBarracks(
     Engine::Core::World &world,
     const std::vector<Engine::Core::EntityID> &selected, int owner_id, float x,
     float z) -> bool {
+  ReplayService::instance().recordRally(selected, owner_id, x, z);
+
   auto *e = findFirstSelectedBarracks(world, selected, owner_id);
   if (e == nullptr) {
     return false;
@@ -117,9 +150,162 @@ auto ProductionService::getSelectedBarracksState(
     outState.maxUnits = p->maxUnits;
     outState.villagerCost = p->villagerCost;
     outState.queueSize = static_cast<int>(p->productionQueue.size());
-    outState.productionQueue = p->productionQueue;
+    outState.productionQueue.assign(p->productionQueue.begin(),
+                                    p->productionQueue.end());
   }
   return true;
 }
 
+// Expiry re-validates everything against the live entity: the barrack may
+// have died, been captured to neutral (component removed) or hit a troop
+// cap since the timer was enqueued, so a stale timer simply fizzles.
+static void completeProduction(Engine::Core::World &world,
+                               Engine::Core::EntityID barrackId) {
+  auto *e = world.getEntity(barrackId);
+  if (e == nullptr) {
+    return;
+  }
+  auto *prod = e->getComponent<Engine::Core::ProductionComponent>();
+  auto *t = e->getComponent<Engine::Core::TransformComponent>();
+  auto *u = e->getComponent<Engine::Core::UnitComponent>();
+  if ((prod == nullptr) || (t == nullptr) || (u == nullptr) ||
+      !prod->inProgress || Game::Core::isNeutralOwner(u->owner_id)) {
+    return;
+  }
+
+  prod->inProgress = false;
+  prod->timeRemaining = 0.0F;
+
+  int const individuals_per_unit =
+      Game::Units::TroopConfig::instance().getIndividualsPerUnit(
+          prod->product_type);
+
+  if (prod->producedCount + individuals_per_unit > prod->maxUnits) {
+    return;
+  }
+
+  int const current_troops =
+      Engine::Core::World::countTroopsForPlayer(u->owner_id);
+  int const max_troops = Game::GameConfig::instance().getMaxTroopsPerPlayer();
+  if (current_troops + individuals_per_unit > max_troops) {
+    return;
+  }
+
+  // Closed-form exit slot around the barrack; spawn placement needs no
+  // per-unit walkability probe.
+  float const exit_offset = 2.5F + 0.2F * float(prod->producedCount % 5);
+  float const exit_angle = 0.5F * float(prod->producedCount % 8);
+  QVector3D exit_pos =
+      QVector3D(t->position.x + exit_offset * std::cos(exit_angle), 0.0F,
+                t->position.z + exit_offset * std::sin(exit_angle));
+
+  // The closed-form slot is blind to obstacles; snap it to the nearest
+  // free cell with one batched window read so a wall or an adjacent
+  // building cannot swallow the spawn. Nearest-first means an already
+  // free slot maps to itself.
+  if (auto *pathfinder = CommandService::getPathfinder()) {
+    const Point exit_cell{
+        static_cast<int>(
+            std::round(exit_pos.x() - pathfinder->getGridOffsetX())),
+        static_cast<int>(
+            std::round(exit_pos.z() - pathfinder->getGridOffsetZ()))};
+    constexpr int k_exit_search_radius = 4;
+    const auto free_cells =
+        pathfinder->findFreeCellsNear(exit_cell, k_exit_search_radius, 1);
+    if (!free_cells.empty() &&
+        (free_cells.front().x != exit_cell.x ||
+         free_cells.front().y != exit_cell.y)) {
+      exit_pos.setX(static_cast<float>(free_cells.front().x) +
+                    pathfinder->getGridOffsetX());
+      exit_pos.setZ(static_cast<float>(free_cells.front().y) +
+                    pathfinder->getGridOffsetZ());
+    }
+  }
+
+  auto reg = Game::Map::MapTransformer::getFactoryRegistry();
+  if (reg) {
+    Game::Units::SpawnParams sp;
+    sp.position = exit_pos;
+    sp.player_id = u->owner_id;
+    sp.spawn_type = Game::Units::spawn_typeFromTroopType(prod->product_type);
+    sp.aiControlled = e->hasComponent<Engine::Core::AIControlledComponent>();
+    auto unit = reg->create(sp.spawn_type, world, sp);
+
+    if (unit && prod->rallySet) {
+      unit->moveTo(prod->rallyX, prod->rallyZ);
+    }
+  }
+
+  prod->producedCount += individuals_per_unit;
+
+  if (!prod->productionQueue.empty()) {
+    prod->product_type = prod->productionQueue.front();
+    prod->productionQueue.erase(prod->productionQueue.begin());
+    prod->timeRemaining = prod->buildTime;
+    prod->inProgress = true;
+    ProductionService::scheduleCompletion(barrackId, prod->buildTime);
+  }
+}
+
+void ProductionService::scheduleCompletion(Engine::Core::EntityID barrackId,
+                                           float delaySeconds) {
+  auto it = s_scheduledProductions.find(barrackId);
+  if (it != s_scheduledProductions.end()) {
+    s_productionTimers.cancel(it->second.timerId);
+    s_scheduledProductions.erase(it);
+  }
+  std::uint64_t const timer_id =
+      s_productionTimers.schedule(delaySeconds, barrackId);
+  s_scheduledProductions[barrackId] = {timer_id,
+                                       s_productionClock + delaySeconds};
+}
+
+void ProductionService::advance(Engine::Core::World &world, float deltaTime) {
+  s_productionClock += deltaTime;
+
+  s_expiredProductions.clear();
+  s_productionTimers.advance(deltaTime, s_expiredProductions);
+  for (std::uint64_t const payload : s_expiredProductions) {
+    auto const barrack_id = static_cast<Engine::Core::EntityID>(payload);
+    s_scheduledProductions.erase(barrack_id);
+    completeProduction(world, barrack_id);
+  }
+
+  // Keep timeRemaining fresh for the HUD, AI snapshots and saves. Only
+  // active producers are touched; idle production buildings cost nothing.
+  for (auto it = s_scheduledProductions.begin();
+       it != s_scheduledProductions.end();) {
+    auto *e = world.getEntity(it->first);
+    auto *prod =
+        (e != nullptr) ? e->getComponent<Engine::Core::ProductionComponent>()
+                       : nullptr;
+    if ((prod == nullptr) || !prod->inProgress) {
+      s_productionTimers.cancel(it->second.timerId);
+      it = s_scheduledProductions.erase(it);
+      continue;
+    }
+    double const remaining = it->second.completionTime - s_productionClock;
+    prod->timeRemaining =
+        remaining > 0.0 ? static_cast<float>(remaining) : 0.0F;
+    ++it;
+  }
+}
+
+void ProductionService::resetScheduler() {
+  s_productionTimers.clear();
+  s_scheduledProductions.clear();
+  s_productionClock = 0.0;
+}
+
+void ProductionService::rescheduleAll(Engine::Core::World &world) {
+  for (auto *e : world.view<Engine::Core::ProductionComponent>()) {
+    auto *prod = e->getComponent<Engine::Core::ProductionComponent>();
+    if ((prod == nullptr) || !prod->inProgress) {
+      continue;
+    }
+    scheduleCompletion(e->getId(),
+                       prod->timeRemaining > 0.0F ? prod->timeRemaining : 0.0F);
+  }
+}
+
 } // namespace Game::Systems
@@ -58,6 +58,25 @@ public:
   getSelectedBarracksState(Engine::Core::World &world,
                            const std::vector<Engine::Core::EntityID> &selected,
                            int owner_id, ProductionState &outState) -> bool;
+
+  // Production completions run off a timer wheel instead of per-frame
+  // timer decrements over every production building. Call whenever an
+  // item starts building; replaces any timer already pending for the
+  // barrack.
+  static void scheduleCompletion(Engine::Core::EntityID barrackId,
+                                 float delaySeconds);
+
+  // Advances the wheel, spawns units for every production that came due
+  // and refreshes timeRemaining on active producers only. Driven once per
+  // simulation tick by ProductionSystem.
+  static void advance(Engine::Core::World &world, float deltaTime);
+
+  // Drops all pending completion timers; call when the world is rebuilt.
+  static void resetScheduler();
+
+  // Re-enqueues a completion timer for every in-progress production,
+  // e.g. after restoring a save. One scan, load-time only.
+  static void rescheduleAll(Engine::Core::World &world);
 };
 
 } // namespace Game::Systems
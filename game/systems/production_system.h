@@ -4,9 +4,14 @@
 
 namespace Game::Systems {
 
+// Drives the production timer wheel each tick; completion logic lives in
+// ProductionService so every site that starts an item can schedule it.
 class ProductionSystem : public Engine::Core::System {
 public:
   void update(Engine::Core::World *world, float deltaTime) override;
+  [[nodiscard]] auto name() const -> const char * override {
+    return "ProductionSystem";
+  }
 };
 
 } // namespace Game::Systems
@@ -0,0 +1,428 @@
+#include "replay_service.h"
+#include "../core/component.h"
+#include "../core/entity.h"
+#include "../core/world.h"
+#include "production_service.h"
+#include "units/troop_type.h"
+#include <QDebug>
+#include <QIODevice>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace Game::Systems {
+
+namespace {
+
+constexpr quint32 k_replay_magic = 0x52494F53;
+constexpr quint32 k_replay_version = 1;
+
+constexpr std::uint8_t k_flag_direct_fallback = 1U << 0U;
+constexpr std::uint8_t k_flag_clear_attack = 1U << 1U;
+constexpr std::uint8_t k_flag_group_move = 1U << 2U;
+constexpr std::uint8_t k_flag_background = 1U << 3U;
+
+auto packMoveOptions(const CommandService::MoveOptions &options)
+    -> std::uint8_t {
+  std::uint8_t flags = 0;
+  if (options.allowDirectFallback) {
+    flags |= k_flag_direct_fallback;
+  }
+  if (options.clearAttackIntent) {
+    flags |= k_flag_clear_attack;
+  }
+  if (options.groupMove) {
+    flags |= k_flag_group_move;
+  }
+  if (options.backgroundPriority) {
+    flags |= k_flag_background;
+  }
+  return flags;
+}
+
+auto unpackMoveOptions(std::uint8_t flags) -> CommandService::MoveOptions {
+  CommandService::MoveOptions options;
+  options.allowDirectFallback = (flags & k_flag_direct_fallback) != 0;
+  options.clearAttackIntent = (flags & k_flag_clear_attack) != 0;
+  options.groupMove = (flags & k_flag_group_move) != 0;
+  options.backgroundPriority = (flags & k_flag_background) != 0;
+  return options;
+}
+
+} // namespace
+
+auto ReplayService::instance() -> ReplayService & {
+  static ReplayService instance;
+  return instance;
+}
+
+auto ReplayService::isRecording() const -> bool {
+  std::lock_guard<std::mutex> const lock(m_mutex);
+  return m_mode == Mode::Recording;
+}
+
+auto ReplayService::isPlaybackActive() const -> bool {
+  std::lock_guard<std::mutex> const lock(m_mutex);
+  return m_mode == Mode::Playback;
+}
+
+auto ReplayService::isPlaybackPending() const -> bool {
+  std::lock_guard<std::mutex> const lock(m_mutex);
+  return m_mode == Mode::PlaybackPending;
+}
+
+auto ReplayService::startRecording(const QString &path, std::uint32_t seed,
+                                   const QString &map_path,
+                                   const QVariantList &playerConfigs) -> bool {
+  std::lock_guard<std::mutex> const lock(m_mutex);
+  if (m_mode != Mode::Idle) {
+    return false;
+  }
+
+  m_file.setFileName(path);
+  if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    qWarning() << "ReplayService: cannot open" << path << "for recording";
+    return false;
+  }
+
+  m_stream.setDevice(&m_file);
+  m_stream.setVersion(QDataStream::Qt_6_0);
+  m_stream << k_replay_magic << k_replay_version;
+  m_stream << static_cast<quint32>(seed);
+  m_stream << map_path;
+  m_stream << playerConfigs;
+
+  m_baseTick = m_currentTick;
+  m_mode = Mode::Recording;
+  return true;
+}
+
+void ReplayService::stopRecording() {
+  std::lock_guard<std::mutex> const lock(m_mutex);
+  if (m_mode != Mode::Recording) {
+    return;
+  }
+  m_stream.setDevice(nullptr);
+  m_file.close();
+  m_mode = Mode::Idle;
+}
+
+auto ReplayService::startPlayback(const QString &path) -> bool {
+  std::lock_guard<std::mutex> const lock(m_mutex);
+  if (m_mode != Mode::Idle) {
+    return false;
+  }
+
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly)) {
+    qWarning() << "ReplayService: cannot open" << path << "for playback";
+    return false;
+  }
+
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_6_0);
+
+  quint32 magic = 0;
+  quint32 version = 0;
+  stream >> magic >> version;
+  if (magic != k_replay_magic || version != k_replay_version) {
+    qWarning() << "ReplayService:" << path << "is not a valid replay file";
+    return false;
+  }
+
+  quint32 seed = 0;
+  stream >> seed;
+  stream >> m_playbackMapPath;
+  stream >> m_playbackPlayers;
+  m_playbackSeed = seed;
+
+  m_playbackCommands.clear();
+  while (!stream.atEnd()) {
+    Command command;
+    if (!readCommand(stream, command)) {
+      qWarning() << "ReplayService: truncated record in" << path
+                 << "- replaying up to it";
+      break;
+    }
+    m_playbackCommands.push_back(std::move(command));
+  }
+
+  m_playbackIndex = 0;
+  m_baseTickSet = false;
+  m_mode = Mode::PlaybackPending;
+  return true;
+}
+
+auto ReplayService::playbackSeed() const -> std::uint32_t {
+  std::lock_guard<std::mutex> const lock(m_mutex);
+  return m_playbackSeed;
+}
+
+auto ReplayService::playbackMapPath() const -> QString {
+  std::lock_guard<std::mutex> const lock(m_mutex);
+  return m_playbackMapPath;
+}
+
+auto ReplayService::playbackPlayerConfigs() const -> QVariantList {
+  std::lock_guard<std::mutex> const lock(m_mutex);
+  return m_playbackPlayers;
+}
+
+void ReplayService::armPlayback() {
+  std::lock_guard<std::mutex> const lock(m_mutex);
+  if (m_mode != Mode::PlaybackPending) {
+    return;
+  }
+  m_baseTickSet = false;
+  m_mode = Mode::Playback;
+}
+
+void ReplayService::stopPlayback() {
+  std::lock_guard<std::mutex> const lock(m_mutex);
+  if (m_mode != Mode::Playback && m_mode != Mode::PlaybackPending) {
+    return;
+  }
+  m_playbackCommands.clear();
+  m_playbackIndex = 0;
+  m_mode = Mode::Idle;
+}
+
+void ReplayService::beginTick(std::uint64_t tick) {
+  std::lock_guard<std::mutex> const lock(m_mutex);
+  m_currentTick = tick;
+  if (m_mode == Mode::Playback && !m_baseTickSet) {
+    m_baseTick = tick;
+    m_baseTickSet = true;
+  }
+}
+
+void ReplayService::playbackTick(Engine::Core::World &world) {
+  // Due commands are collected under the lock but dispatched outside it:
+  // dispatching re-enters the recording hooks through CommandService.
+  std::vector<Command> due;
+  {
+    std::lock_guard<std::mutex> const lock(m_mutex);
+    if (m_mode != Mode::Playback || !m_baseTickSet) {
+      return;
+    }
+    std::uint64_t const relative_tick = m_currentTick - m_baseTick;
+    while (m_playbackIndex < m_playbackCommands.size() &&
+           m_playbackCommands[m_playbackIndex].tick <= relative_tick) {
+      due.push_back(m_playbackCommands[m_playbackIndex]);
+      ++m_playbackIndex;
+    }
+    if (m_playbackIndex >= m_playbackCommands.size()) {
+      m_playbackCommands.clear();
+      m_playbackIndex = 0;
+      m_mode = Mode::Idle;
+    }
+  }
+
+  for (const auto &command : due) {
+    dispatch(world, command);
+  }
+}
+
+void ReplayService::recordMove(std::span<const Engine::Core::EntityID> units,
+                               std::span<const QVector3D> targets,
+                               const CommandService::MoveOptions &options) {
+  Command command;
+  command.type = CommandType::Move;
+  command.units.assign(units.begin(), units.end());
+  command.targets.assign(targets.begin(), targets.end());
+  command.moveFlags = packMoveOptions(options);
+  append(std::move(command));
+}
+
+void ReplayService::recordAttack(
+    const std::vector<Engine::Core::EntityID> &units,
+    Engine::Core::EntityID target_id, bool shouldChase) {
+  Command command;
+  command.type = CommandType::Attack;
+  command.units = units;
+  command.target_id = target_id;
+  command.shouldChase = shouldChase;
+  append(std::move(command));
+}
+
+void ReplayService::recordStop(std::span<const Engine::Core::EntityID> units) {
+  Command command;
+  command.type = CommandType::Stop;
+  command.units.assign(units.begin(), units.end());
+  append(std::move(command));
+}
+
+void ReplayService::recordHoldToggle(
+    std::span<const Engine::Core::EntityID> units) {
+  Command command;
+  command.type = CommandType::HoldToggle;
+  command.units.assign(units.begin(), units.end());
+  append(std::move(command));
+}
+
+void ReplayService::recordPatrol(std::span<const Engine::Core::EntityID> units,
+                                 const QVector3D &first,
+                                 const QVector3D &second) {
+  Command command;
+  command.type = CommandType::Patrol;
+  command.units.assign(units.begin(), units.end());
+  command.targets = {first, second};
+  append(std::move(command));
+}
+
+void ReplayService::recordProduction(
+    const std::vector<Engine::Core::EntityID> &selected, int owner_id,
+    const QString &product_type) {
+  Command command;
+  command.type = CommandType::Production;
+  command.units = selected;
+  command.owner_id = owner_id;
+  command.product_type = product_type;
+  append(std::move(command));
+}
+
+void ReplayService::recordAIProduction(Engine::Core::EntityID buildingId,
+                                       const QString &product_type) {
+  Command command;
+  command.type = CommandType::AIProduction;
+  command.target_id = buildingId;
+  command.product_type = product_type;
+  append(std::move(command));
+}
+
+void ReplayService::recordRally(
+    const std::vector<Engine::Core::EntityID> &selected, int owner_id, float x,
+    float z) {
+  Command command;
+  command.type = CommandType::Rally;
+  command.units = selected;
+  command.owner_id = owner_id;
+  command.targets = {QVector3D(x, 0.0F, z)};
+  append(std::move(command));
+}
+
+void ReplayService::append(Command command) {
+  std::lock_guard<std::mutex> const lock(m_mutex);
+  if (m_mode != Mode::Recording) {
+    return;
+  }
+  command.tick = m_currentTick - m_baseTick;
+  writeCommand(m_stream, command);
+}
+
+void ReplayService::dispatch(Engine::Core::World &world,
+                             const Command &command) {
+  switch (command.type) {
+  case CommandType::Move:
+    CommandService::moveUnits(world, command.units, command.targets,
+                              unpackMoveOptions(command.moveFlags));
+    break;
+  case CommandType::Attack:
+    CommandService::attack_target(world, command.units, command.target_id,
+                                  command.shouldChase);
+    break;
+  case CommandType::Stop:
+    CommandService::stopUnits(world, command.units);
+    break;
+  case CommandType::HoldToggle:
+    CommandService::toggleHoldMode(world, command.units);
+    break;
+  case CommandType::Patrol:
+    if (command.targets.size() >= 2) {
+      CommandService::startPatrol(world, command.units, command.targets[0],
+                                  command.targets[1]);
+    }
+    break;
+  case CommandType::Production:
+    ProductionService::startProductionForFirstSelectedBarracks(
+        world, command.units, command.owner_id,
+        command.product_type.toStdString());
+    break;
+  case CommandType::AIProduction:
+    // Mirrors AICommandApplier's direct application; the record was only
+    // written for productions whose guards passed in the original run.
+    if (auto *entity = world.getEntity(command.target_id)) {
+      auto *production =
+          entity->getComponent<Engine::Core::ProductionComponent>();
+      if (production != nullptr && !production->inProgress) {
+        production->product_type = Game::Units::troop_typeFromString(
+            command.product_type.toStdString());
+        production->timeRemaining = production->buildTime;
+        production->inProgress = true;
+        ProductionService::scheduleCompletion(command.target_id,
+                                              production->buildTime);
+      }
+    }
+    break;
+  case CommandType::Rally:
+    if (!command.targets.empty()) {
+      ProductionService::setRallyForFirstSelectedBarracks(
+          world, command.units, command.owner_id, command.targets[0].x(),
+          command.targets[0].z());
+    }
+    break;
+  }
+}
+
+void ReplayService::writeCommand(QDataStream &stream, const Command &command) {
+  stream << static_cast<quint64>(command.tick);
+  stream << static_cast<quint8>(command.type);
+  stream << static_cast<quint32>(command.units.size());
+  for (auto id : command.units) {
+    stream << static_cast<quint32>(id);
+  }
+  stream << static_cast<quint32>(command.targets.size());
+  for (const auto &target : command.targets) {
+    stream << target.x() << target.y() << target.z();
+  }
+  stream << static_cast<quint8>(command.moveFlags);
+  stream << static_cast<quint32>(command.target_id);
+  stream << command.shouldChase;
+  stream << command.product_type;
+  stream << static_cast<qint32>(command.owner_id);
+}
+
+auto ReplayService::readCommand(QDataStream &stream, Command &command) -> bool {
+  quint64 tick = 0;
+  quint8 type = 0;
+  stream >> tick >> type;
+  command.tick = tick;
+  command.type = static_cast<CommandType>(type);
+
+  quint32 unit_count = 0;
+  stream >> unit_count;
+  command.units.resize(unit_count);
+  for (quint32 i = 0; i < unit_count; ++i) {
+    quint32 id = 0;
+    stream >> id;
+    command.units[i] = id;
+  }
+
+  quint32 target_count = 0;
+  stream >> target_count;
+  command.targets.resize(target_count);
+  for (quint32 i = 0; i < target_count; ++i) {
+    float x = 0.0F;
+    float y = 0.0F;
+    float z = 0.0F;
+    stream >> x >> y >> z;
+    command.targets[i] = QVector3D(x, y, z);
+  }
+
+  quint8 flags = 0;
+  quint32 target_id = 0;
+  stream >> flags >> target_id;
+  command.moveFlags = flags;
+  command.target_id = target_id;
+  stream >> command.shouldChase;
+  stream >> command.product_type;
+  qint32 owner = 0;
+  stream >> owner;
+  command.owner_id = owner;
+
+  return stream.status() == QDataStream::Ok;
+}
+
+} // namespace Game::Systems
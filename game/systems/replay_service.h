@@ -0,0 +1,133 @@
+#pragma once
+
+#include "command_service.h"
+#include <QDataStream>
+#include <QFile>
+#include <QString>
+#include <QVariantList>
+#include <QVector3D>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace Engine::Core {
+class World;
+using EntityID = unsigned int;
+} // namespace Engine::Core
+
+namespace Game::Systems {
+
+// Append-only command log for replays. Every command entering
+// CommandService or ProductionService — player and AI alike — is recorded
+// with the sim tick it arrived on; playback re-feeds the log into a fresh
+// world loaded from the same map, players, and sim seed, which the file
+// header carries. Besides the gameplay feature this gives a fixed,
+// repeatable workload for benchmarking: a recorded battle can be replayed
+// headlessly to measure a perf change against identical inputs.
+//
+// Commands are re-issued at tick granularity: a command logged during
+// tick N is applied just before tick N's world update on playback, so
+// replays are self-consistent run to run even though intra-tick ordering
+// against the original session is not preserved.
+class ReplayService {
+public:
+  static auto instance() -> ReplayService &;
+
+  [[nodiscard]] auto isRecording() const -> bool;
+  // True once playback has been armed against a loaded world; used by the
+  // AI applier to mute live commands (the log already contains the AI's).
+  [[nodiscard]] auto isPlaybackActive() const -> bool;
+
+  auto startRecording(const QString &path, std::uint32_t seed,
+                      const QString &map_path,
+                      const QVariantList &playerConfigs) -> bool;
+  void stopRecording();
+
+  // Reads the whole log into memory and parks in a pending state; the
+  // caller restarts the recorded skirmish and calls armPlayback() once
+  // the fresh world is up. Header fields are exposed for that restart.
+  auto startPlayback(const QString &path) -> bool;
+  [[nodiscard]] auto isPlaybackPending() const -> bool;
+  [[nodiscard]] auto playbackSeed() const -> std::uint32_t;
+  [[nodiscard]] auto playbackMapPath() const -> QString;
+  [[nodiscard]] auto playbackPlayerConfigs() const -> QVariantList;
+  void armPlayback();
+  void stopPlayback();
+
+  // Called once per sim tick before the world update; during recording it
+  // timestamps subsequent commands, during playback it re-issues every
+  // logged command due at or before this tick.
+  void beginTick(std::uint64_t tick);
+  void playbackTick(Engine::Core::World &world);
+
+  // Recording hooks, called from the command entry points; no-ops unless
+  // a recording is in progress.
+  void recordMove(std::span<const Engine::Core::EntityID> units,
+                  std::span<const QVector3D> targets,
+                  const CommandService::MoveOptions &options);
+  void recordAttack(const std::vector<Engine::Core::EntityID> &units,
+                    Engine::Core::EntityID target_id, bool shouldChase);
+  void recordStop(std::span<const Engine::Core::EntityID> units);
+  void recordHoldToggle(std::span<const Engine::Core::EntityID> units);
+  void recordPatrol(std::span<const Engine::Core::EntityID> units,
+                    const QVector3D &first, const QVector3D &second);
+  void recordProduction(const std::vector<Engine::Core::EntityID> &selected,
+                        int owner_id, const QString &product_type);
+  // AI production is applied straight to the building component rather
+  // than through ProductionService, so it gets its own record.
+  void recordAIProduction(Engine::Core::EntityID buildingId,
+                          const QString &product_type);
+  void recordRally(const std::vector<Engine::Core::EntityID> &selected,
+                   int owner_id, float x, float z);
+
+private:
+  enum class Mode : std::uint8_t { Idle, Recording, PlaybackPending, Playback };
+
+  enum class CommandType : std::uint8_t {
+    Move,
+    Attack,
+    Stop,
+    HoldToggle,
+    Patrol,
+    Production,
+    AIProduction,
+    Rally
+  };
+
+  struct Command {
+    std::uint64_t tick = 0;
+    CommandType type = CommandType::Move;
+    std::vector<Engine::Core::EntityID> units;
+    std::vector<QVector3D> targets;
+    std::uint8_t moveFlags = 0;
+    Engine::Core::EntityID target_id = 0;
+    bool shouldChase = true;
+    QString product_type;
+    std::int32_t owner_id = 0;
+  };
+
+  ReplayService() = default;
+
+  void append(Command command);
+  void dispatch(Engine::Core::World &world, const Command &command);
+  static void writeCommand(QDataStream &stream, const Command &command);
+  static auto readCommand(QDataStream &stream, Command &command) -> bool;
+
+  mutable std::mutex m_mutex;
+  Mode m_mode = Mode::Idle;
+  std::uint64_t m_currentTick = 0;
+  std::uint64_t m_baseTick = 0;
+  bool m_baseTickSet = false;
+
+  QFile m_file;
+  QDataStream m_stream;
+
+  std::uint32_t m_playbackSeed = 0;
+  QString m_playbackMapPath;
+  QVariantList m_playbackPlayers;
+  std::vector<Command> m_playbackCommands;
+  std::size_t m_playbackIndex = 0;
+};
+
+} // namespace Game::Systems
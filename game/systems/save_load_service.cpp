@@ -1,8 +1,10 @@
 #include "save_load_service.h"
 
+#include "game/core/binary_serialization.h"
 #include "game/core/serialization.h"
 #include "game/core/world.h"
 #include "save_storage.h"
+#include "save_writer.h"
 
 #include <QCoreApplication>
 #include <QDateTime>
@@ -27,9 +29,37 @@
 
 namespace Game::Systems {
 
+namespace {
+
+// Full autosave checkpoint every N saves; deltas in between.
+constexpr int k_autosave_checkpoint_period = 8;
+
+auto deltaSlotName(const QString &slotName, int index) -> QString {
+  return QStringLiteral("%1.d%2").arg(slotName).arg(index);
+}
+
+auto buildCombinedMetadata(const QJsonObject &metadata, const QString &slotName,
+                           const QString &title,
+                           const QString &map_name) -> QJsonObject {
+  QJsonObject combined = metadata;
+  combined["slotName"] = slotName;
+  combined["title"] = title;
+  combined["timestamp"] =
+      QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs);
+  if (!combined.contains("map_name")) {
+    combined["map_name"] =
+        map_name.isEmpty() ? QStringLiteral("Unknown Map") : map_name;
+  }
+  combined["version"] = QStringLiteral("1.0");
+  return combined;
+}
+
+} // namespace
+
 SaveLoadService::SaveLoadService() {
   ensureSavesDirectoryExists();
   m_storage = std::make_unique<SaveStorage>(get_database_path());
+  m_writer = std::make_unique<SaveWriter>(get_database_path());
   QString init_error;
   if (!m_storage->initialize(&init_error)) {
     m_last_error = init_error;
@@ -37,7 +67,13 @@ SaveLoadService::SaveLoadService() {
   }
 }
 
-SaveLoadService::~SaveLoadService() = default;
+SaveLoadService::~SaveLoadService() { waitForPendingWrite(); }
+
+void SaveLoadService::waitForPendingWrite() const {
+  if (m_writer) {
+    m_writer->flush();
+  }
+}
 
 QString SaveLoadService::getSavesDirectory() {
   QString const savesPath =
@@ -72,20 +108,11 @@ auto SaveLoadService::saveGameToSlot(Engine::Core::World &world,
       return false;
     }
 
-    QJsonDocument const worldDoc =
-        Engine::Core::Serialization::serializeWorld(&world);
-    const QByteArray worldBytes = worldDoc.toJson(QJsonDocument::Compact);
-
-    QJsonObject combinedMetadata = metadata;
-    combinedMetadata["slotName"] = slotName;
-    combinedMetadata["title"] = title;
-    combinedMetadata["timestamp"] =
-        QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs);
-    if (!combinedMetadata.contains("map_name")) {
-      combinedMetadata["map_name"] =
-          map_name.isEmpty() ? QStringLiteral("Unknown Map") : map_name;
-    }
-    combinedMetadata["version"] = QStringLiteral("1.0");
+    waitForPendingWrite();
+
+    const QByteArray worldBytes = captureWorldState(world);
+    QJsonObject const combinedMetadata =
+        buildCombinedMetadata(metadata, slotName, title, map_name);
 
     QString storage_error;
     if (!m_storage->saveSlot(slotName, title, combinedMetadata, worldBytes,
@@ -108,11 +135,97 @@ auto SaveLoadService::saveGameToSlot(Engine::Core::World &world,
   }
 }
 
+auto SaveLoadService::captureWorldState(Engine::Core::World &world)
+    -> QByteArray {
+  // Binary is the shipping format; set SOI_SAVE_JSON to write the JSON
+  // form instead when a save needs to be inspected by hand.
+  if (qEnvironmentVariableIsSet("SOI_SAVE_JSON")) {
+    return Engine::Core::Serialization::serializeWorld(&world).toJson(
+        QJsonDocument::Compact);
+  }
+  return Engine::Core::BinarySerialization::serializeWorld(&world);
+}
+
+void SaveLoadService::saveSnapshotToSlotAsync(QByteArray worldState,
+                                              const QString &slotName,
+                                              const QString &title,
+                                              const QString &map_name,
+                                              const QJsonObject &metadata,
+                                              const QByteArray &screenshot) {
+  QJsonObject const combinedMetadata =
+      buildCombinedMetadata(metadata, slotName, title, map_name);
+  m_lastMetadata = combinedMetadata;
+  m_lastTitle = title;
+  m_lastScreenshot = screenshot;
+
+  if (!m_writer) {
+    return;
+  }
+  m_writer->enqueue({slotName, title, combinedMetadata, std::move(worldState),
+                     screenshot, false});
+}
+
+void SaveLoadService::saveAutosaveAsync(Engine::Core::World &world,
+                                        const QString &slotName,
+                                        const QString &title,
+                                        const QString &map_name,
+                                        const QJsonObject &metadata) {
+  if (!m_storage) {
+    return;
+  }
+
+  const bool checkpoint =
+      !m_autosaveTracker.hasBaseline() ||
+      m_autosaveDeltaIndex >= k_autosave_checkpoint_period - 1;
+
+  if (!checkpoint) {
+    const int delta_index = ++m_autosaveDeltaIndex;
+    QJsonObject meta = metadata;
+    meta["autosaveBase"] = m_autosaveGeneration;
+    meta["autosaveDelta"] = delta_index;
+    saveSnapshotToSlotAsync(m_autosaveTracker.serializeDelta(&world),
+                            deltaSlotName(slotName, delta_index), title,
+                            map_name, meta);
+    return;
+  }
+
+  // Generations are wall-clock stamped so deltas left behind by an earlier
+  // session can never match a checkpoint written after a restart.
+  m_autosaveGeneration =
+      static_cast<int>(QDateTime::currentSecsSinceEpoch() & 0x7FFFFFFF);
+  QJsonObject meta = metadata;
+  meta["autosaveGeneration"] = m_autosaveGeneration;
+  QByteArray snapshot = Engine::Core::BinarySerialization::serializeWorld(&world);
+  m_autosaveTracker.rebase(&world);
+  m_autosaveDeltaIndex = 0;
+
+  QJsonObject const combinedMetadata =
+      buildCombinedMetadata(meta, slotName, title, map_name);
+  m_lastMetadata = combinedMetadata;
+  m_lastTitle = title;
+  m_lastScreenshot.clear();
+
+  if (!m_writer) {
+    return;
+  }
+  // purgeDeltas: stale '<slot>.dN' slots are dropped on the writer thread
+  // once the checkpoint lands.
+  m_writer->enqueue({slotName, title, combinedMetadata, std::move(snapshot),
+                     QByteArray(), true});
+}
+
+void SaveLoadService::resetAutosaveBaseline() {
+  m_autosaveTracker.reset();
+  m_autosaveDeltaIndex = 0;
+}
+
 auto SaveLoadService::loadGameFromSlot(Engine::Core::World &world,
                                        const QString &slotName) -> bool {
   qInfo() << "Loading game from slot:" << slotName;
 
   try {
+    waitForPendingWrite();
+
     if (!m_storage) {
       m_last_error = QStringLiteral("Save storage unavailable");
       qWarning() << m_last_error;
@@ -132,17 +245,63 @@ auto SaveLoadService::loadGameFromSlot(Engine::Core::World &world,
       return false;
     }
 
-    QJsonParseError parse_error{};
-    QJsonDocument const doc = QJsonDocument::fromJson(worldBytes, &parse_error);
-    if (parse_error.error != QJsonParseError::NoError || doc.isNull()) {
-      m_last_error = QStringLiteral("Corrupted save data for slot '%1': %2")
-                         .arg(slotName, parse_error.errorString());
-      qWarning() << m_last_error;
-      return false;
+    if (Engine::Core::BinarySerialization::isBinaryWorldState(worldBytes)) {
+      world.clear();
+      if (!Engine::Core::BinarySerialization::deserializeWorld(&world,
+                                                               worldBytes)) {
+        m_last_error =
+            QStringLiteral("Corrupted binary save data for slot '%1'")
+                .arg(slotName);
+        qWarning() << m_last_error;
+        return false;
+      }
+    } else {
+      QJsonParseError parse_error{};
+      QJsonDocument const doc =
+          QJsonDocument::fromJson(worldBytes, &parse_error);
+      if (parse_error.error != QJsonParseError::NoError || doc.isNull()) {
+        m_last_error = QStringLiteral("Corrupted save data for slot '%1': %2")
+                           .arg(slotName, parse_error.errorString());
+        qWarning() << m_last_error;
+        return false;
+      }
+
+      world.clear();
+      Engine::Core::Serialization::deserializeWorld(&world, doc);
     }
 
-    world.clear();
-    Engine::Core::Serialization::deserializeWorld(&world, doc);
+    // Replay any autosave deltas recorded on top of this checkpoint. Each
+    // delta slot carries the full metadata from its own save, so the last
+    // one applied wins for camera/runtime restore.
+    const int generation = metadata.value("autosaveGeneration").toInt(-1);
+    if (generation >= 0) {
+      for (int i = 1;; ++i) {
+        QByteArray delta_bytes;
+        QJsonObject delta_metadata;
+        QByteArray delta_screenshot;
+        QString delta_title;
+        if (!m_storage->loadSlot(deltaSlotName(slotName, i), delta_bytes,
+                                 delta_metadata, delta_screenshot,
+                                 delta_title)) {
+          break;
+        }
+        if (delta_metadata.value("autosaveBase").toInt(-1) != generation) {
+          break;
+        }
+        if (!Engine::Core::BinarySerialization::isDeltaWorldState(
+                delta_bytes) ||
+            !Engine::Core::BinarySerialization::applyWorldDelta(&world,
+                                                                delta_bytes)) {
+          qWarning() << "SaveLoadService: ignoring corrupt autosave delta" << i
+                     << "for slot" << slotName;
+          break;
+        }
+        metadata = delta_metadata;
+        title = delta_title;
+      }
+    }
+
+    resetAutosaveBaseline();
 
     m_lastMetadata = metadata;
     m_lastTitle = title;
@@ -162,8 +321,22 @@ auto SaveLoadService::getSaveSlots() const -> QVariantList {
     return {};
   }
 
+  waitForPendingWrite();
+
   QString list_error;
   QVariantList slotList = m_storage->listSlots(&list_error);
+  // Delta slots are internal continuation records of their base autosave,
+  // not standalone saves the UI should offer.
+  for (auto it = slotList.begin(); it != slotList.end();) {
+    const QVariantMap slot = it->toMap();
+    if (slot.value(QStringLiteral("metadata"))
+            .toMap()
+            .contains(QStringLiteral("autosaveDelta"))) {
+      it = slotList.erase(it);
+    } else {
+      ++it;
+    }
+  }
   if (!list_error.isEmpty()) {
     m_last_error = list_error;
     qWarning() << "SaveLoadService: failed to enumerate slots" << list_error;
@@ -182,6 +355,8 @@ auto SaveLoadService::deleteSaveSlot(const QString &slotName) -> bool {
     return false;
   }
 
+  waitForPendingWrite();
+
   QString delete_error;
   if (!m_storage->deleteSlot(slotName, &delete_error)) {
     m_last_error = delete_error;
@@ -189,6 +364,9 @@ auto SaveLoadService::deleteSaveSlot(const QString &slotName) -> bool {
     return false;
   }
 
+  for (int i = 1; m_storage->deleteSlot(deltaSlotName(slotName, i)); ++i) {
+  }
+
   m_last_error.clear();
   return true;
 }
@@ -7,6 +7,8 @@
 
 #include <memory>
 
+#include "game/core/binary_serialization.h"
+
 namespace Engine::Core {
 class World;
 }
@@ -14,6 +16,7 @@ class World;
 namespace Game::Systems {
 
 class SaveStorage;
+class SaveWriter;
 
 class SaveLoadService {
 public:
@@ -28,6 +31,30 @@ public:
   auto loadGameFromSlot(Engine::Core::World &world,
                         const QString &slotName) -> bool;
 
+  // Packs the world into the save-game byte form on the calling (game)
+  // thread; the result is self-contained and safe to hand to another thread.
+  static auto captureWorldState(Engine::Core::World &world) -> QByteArray;
+
+  // Persists an already-captured world snapshot on the dedicated writer
+  // thread, so autosave only costs the game thread the snapshot capture.
+  // Rapid saves to the same slot coalesce in the writer queue; failures
+  // are logged, and pending writes are flushed before any later read.
+  void saveSnapshotToSlotAsync(QByteArray worldState, const QString &slotName,
+                               const QString &title, const QString &map_name,
+                               const QJsonObject &metadata = {},
+                               const QByteArray &screenshot = QByteArray());
+
+  // Autosave entry point: writes a full checkpoint every few saves and
+  // per-entity deltas in between ('<slot>.d1', '<slot>.d2', ...), all on the
+  // background writer thread. Loading the slot replays the delta chain.
+  void saveAutosaveAsync(Engine::Core::World &world, const QString &slotName,
+                         const QString &title, const QString &map_name,
+                         const QJsonObject &metadata = {});
+
+  // Forces the next autosave to be a full checkpoint; call whenever the
+  // world is replaced (level load, save load) so stale deltas never apply.
+  void resetAutosaveBaseline();
+
   auto getSaveSlots() const -> QVariantList;
 
   auto deleteSaveSlot(const QString &slotName) -> bool;
@@ -48,7 +75,12 @@ private:
   static auto getSavesDirectory() -> QString;
   auto get_database_path() const -> QString;
   void ensureSavesDirectoryExists() const;
+  void waitForPendingWrite() const;
 
+  std::unique_ptr<SaveWriter> m_writer;
+  Engine::Core::WorldDeltaTracker m_autosaveTracker;
+  int m_autosaveDeltaIndex = 0;
+  int m_autosaveGeneration = 0;
   mutable QString m_last_error;
   QJsonObject m_lastMetadata;
   QString m_lastTitle;
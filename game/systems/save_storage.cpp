@@ -17,6 +17,8 @@
 #include <qsqlquery.h>
 #include <qstringliteral.h>
 #include <qvariant.h>
+#include <algorithm>
+#include <cstring>
 #include <utility>
 
 namespace Game::Systems {
@@ -25,6 +27,95 @@ namespace {
 constexpr const char *k_driver_name = "QSQLITE";
 constexpr int k_current_schema_version = 1;
 
+// World-state blobs are stored deflate-compressed in independent chunks
+// ('SOIZ' framing), keeping on-disk saves a few times smaller while letting
+// a reader inflate chunk by chunk. Blobs without the magic (older saves)
+// pass through untouched.
+constexpr quint32 k_compressed_magic = 0x5A494F53U; // "SOIZ"
+constexpr qsizetype k_compression_chunk_size = 256 * 1024;
+constexpr int k_compression_level = 1; // favour speed over ratio
+
+void appendU32(QByteArray &out, quint32 value) {
+  out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+auto readU32(const QByteArray &data, qsizetype &pos, quint32 &value) -> bool {
+  if (pos + static_cast<qsizetype>(sizeof(value)) > data.size()) {
+    return false;
+  }
+  std::memcpy(&value, data.constData() + pos, sizeof(value));
+  pos += static_cast<qsizetype>(sizeof(value));
+  return true;
+}
+
+auto isCompressedWorldState(const QByteArray &blob) -> bool {
+  if (blob.size() < static_cast<qsizetype>(sizeof(quint32))) {
+    return false;
+  }
+  quint32 magic = 0;
+  std::memcpy(&magic, blob.constData(), sizeof(magic));
+  return magic == k_compressed_magic;
+}
+
+auto compressWorldState(const QByteArray &raw) -> QByteArray {
+  QByteArray out;
+  out.reserve(raw.size() / 3 + 64);
+  appendU32(out, k_compressed_magic);
+
+  const auto chunk_count = static_cast<quint32>(
+      raw.isEmpty() ? 0
+                    : (raw.size() + k_compression_chunk_size - 1) /
+                          k_compression_chunk_size);
+  appendU32(out, chunk_count);
+  appendU32(out, static_cast<quint32>(raw.size()));
+
+  for (quint32 i = 0; i < chunk_count; ++i) {
+    const qsizetype offset = static_cast<qsizetype>(i) *
+                             k_compression_chunk_size;
+    const qsizetype chunk_size =
+        std::min(k_compression_chunk_size, raw.size() - offset);
+    const QByteArray compressed =
+        qCompress(reinterpret_cast<const uchar *>(raw.constData() + offset),
+                  static_cast<int>(chunk_size), k_compression_level);
+    appendU32(out, static_cast<quint32>(compressed.size()));
+    out.append(compressed);
+  }
+
+  return out;
+}
+
+auto decompressWorldState(const QByteArray &blob,
+                          QByteArray &outRaw) -> bool {
+  qsizetype pos = 0;
+  quint32 magic = 0;
+  quint32 chunk_count = 0;
+  quint32 raw_size = 0;
+  if (!readU32(blob, pos, magic) || magic != k_compressed_magic ||
+      !readU32(blob, pos, chunk_count) || !readU32(blob, pos, raw_size)) {
+    return false;
+  }
+
+  outRaw.clear();
+  outRaw.reserve(static_cast<qsizetype>(raw_size));
+  for (quint32 i = 0; i < chunk_count; ++i) {
+    quint32 compressed_size = 0;
+    if (!readU32(blob, pos, compressed_size) ||
+        pos + static_cast<qsizetype>(compressed_size) > blob.size()) {
+      return false;
+    }
+    const QByteArray chunk = qUncompress(
+        reinterpret_cast<const uchar *>(blob.constData() + pos),
+        static_cast<int>(compressed_size));
+    if (chunk.isEmpty() && compressed_size != 0) {
+      return false;
+    }
+    outRaw.append(chunk);
+    pos += static_cast<qsizetype>(compressed_size);
+  }
+
+  return outRaw.size() == static_cast<qsizetype>(raw_size);
+}
+
 auto buildConnectionName(const SaveStorage *instance) -> QString {
   return QStringLiteral("SaveStorage_%1")
       .arg(reinterpret_cast<quintptr>(instance), 0, 16);
@@ -86,9 +177,9 @@ private:
 };
 } // namespace
 
-SaveStorage::SaveStorage(QString database_path)
+SaveStorage::SaveStorage(QString database_path, Durability durability)
     : m_database_path(std::move(database_path)),
-      m_connection_name(buildConnectionName(this)) {}
+      m_connection_name(buildConnectionName(this)), m_durability(durability) {}
 
 SaveStorage::~SaveStorage() {
   if (m_database.isValid()) {
@@ -166,7 +257,8 @@ auto SaveStorage::saveSlot(const QString &slotName, const QString &title,
   query.bindValue(QStringLiteral(":map_name"), map_name);
   query.bindValue(QStringLiteral(":timestamp"), now_iso);
   query.bindValue(QStringLiteral(":metadata"), metadata_bytes);
-  query.bindValue(QStringLiteral(":world_state"), worldState);
+  query.bindValue(QStringLiteral(":world_state"),
+                  compressWorldState(worldState));
   if (screenshot.isEmpty()) {
     query.bindValue(QStringLiteral(":screenshot"),
                     QVariant(QMetaType::fromType<QByteArray>()));
@@ -223,7 +315,19 @@ auto SaveStorage::loadSlot(const QString &slotName, QByteArray &worldState,
   title = query.value(0).toString();
   const QByteArray metadata_bytes = query.value(1).toByteArray();
   metadata = QJsonDocument::fromJson(metadata_bytes).object();
-  worldState = query.value(2).toByteArray();
+  const QByteArray stored_state = query.value(2).toByteArray();
+  if (isCompressedWorldState(stored_state)) {
+    if (!decompressWorldState(stored_state, worldState)) {
+      if (out_error != nullptr) {
+        *out_error =
+            QStringLiteral("Corrupted compressed world state in slot '%1'")
+                .arg(slotName);
+      }
+      return false;
+    }
+  } else {
+    worldState = stored_state;
+  }
   screenshot = query.value(3).toByteArray();
   return true;
 }
@@ -341,6 +445,11 @@ auto SaveStorage::open(QString *out_error) const -> bool {
   QSqlQuery journal_mode_query(m_database);
   journal_mode_query.exec(QStringLiteral("PRAGMA journal_mode=WAL"));
 
+  QSqlQuery synchronous_query(m_database);
+  synchronous_query.exec(m_durability == Durability::Normal
+                             ? QStringLiteral("PRAGMA synchronous=NORMAL")
+                             : QStringLiteral("PRAGMA synchronous=FULL"));
+
   return true;
 }
 
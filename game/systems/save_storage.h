@@ -6,13 +6,20 @@
 #include <QString>
 #include <QVariantList>
 
+#include <cstdint>
 #include <memory>
 
 namespace Game::Systems {
 
 class SaveStorage {
 public:
-  explicit SaveStorage(QString database_path);
+  // How eagerly commits are fsynced. Full forces a sync per commit (user
+  // saves); Normal lets WAL defer the sync to the checkpoint, so a power
+  // cut can cost at most the last commit but never tears a slot.
+  enum class Durability : std::uint8_t { Full, Normal };
+
+  explicit SaveStorage(QString database_path,
+                       Durability durability = Durability::Full);
   ~SaveStorage();
 
   auto initialize(QString *out_error = nullptr) -> bool;
@@ -43,6 +50,7 @@ private:
 
   QString m_database_path;
   QString m_connection_name;
+  Durability m_durability = Durability::Full;
   mutable bool m_initialized = false;
   mutable QSqlDatabase m_database;
 };
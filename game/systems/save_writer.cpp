@@ -0,0 +1,102 @@
+#include "save_writer.h"
+
+#include "../../render/thread_topology.h"
+#include "save_storage.h"
+
+#include <QDebug>
+
+#include <algorithm>
+#include <qstringliteral.h>
+#include <utility>
+
+namespace Game::Systems {
+
+namespace {
+
+auto deltaSlotName(const QString &slotName, int index) -> QString {
+  return QStringLiteral("%1.d%2").arg(slotName).arg(index);
+}
+
+} // namespace
+
+SaveWriter::SaveWriter(QString database_path)
+    : m_database_path(std::move(database_path)), m_thread([this] { run(); }) {}
+
+SaveWriter::~SaveWriter() {
+  {
+    std::lock_guard<std::mutex> const lock(m_mutex);
+    m_stop = true;
+  }
+  m_wake.notify_all();
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+}
+
+void SaveWriter::enqueue(Job job) {
+  {
+    std::lock_guard<std::mutex> const lock(m_mutex);
+    const auto queued =
+        std::find_if(m_queue.begin(), m_queue.end(), [&job](const Job &other) {
+          return other.slotName == job.slotName;
+        });
+    if (queued != m_queue.end()) {
+      // The newer snapshot supersedes the queued one; the slot would have
+      // been overwritten anyway, so the older write is pure waste.
+      *queued = std::move(job);
+    } else {
+      m_queue.push_back(std::move(job));
+    }
+  }
+  m_wake.notify_one();
+}
+
+void SaveWriter::flush() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_idle.wait(lock, [this] { return m_queue.empty() && !m_busy; });
+}
+
+void SaveWriter::run() {
+  Render::ThreadTopology::instance().registerCurrentThread(
+      Render::ThreadTopology::Role::Io, "save writer");
+  // The SQLite connection is thread-bound, so the worker owns one for its
+  // whole lifetime instead of reopening per write. Durability rides WAL
+  // with synchronous=NORMAL: commits stay atomic (a crash can never leave
+  // a torn slot) and at worst a power cut loses the last write, which is
+  // the right trade for autosave and quicksave traffic.
+  SaveStorage storage(m_database_path, SaveStorage::Durability::Normal);
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  for (;;) {
+    m_wake.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+    if (m_queue.empty()) {
+      // Stop only once the queue has drained so a save issued right
+      // before shutdown still lands on disk.
+      return;
+    }
+
+    Job job = std::move(m_queue.front());
+    m_queue.pop_front();
+    m_busy = true;
+    lock.unlock();
+
+    QString storage_error;
+    if (!storage.saveSlot(job.slotName, job.title, job.metadata, job.worldState,
+                          job.screenshot, &storage_error)) {
+      qWarning() << "SaveWriter: background save failed" << storage_error;
+    } else if (job.purgeDeltas) {
+      // Deltas from earlier generations are unreachable once the new
+      // checkpoint lands.
+      for (int i = 1; storage.deleteSlot(deltaSlotName(job.slotName, i)); ++i) {
+      }
+    }
+
+    lock.lock();
+    m_busy = false;
+    if (m_queue.empty()) {
+      m_idle.notify_all();
+    }
+  }
+}
+
+} // namespace Game::Systems
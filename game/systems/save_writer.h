@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QString>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace Game::Systems {
+
+// Dedicated save I/O thread. Writes are queued and executed on a single
+// long-lived worker that owns its own database connection, so durability
+// (the SQLite commit and its fsync) never blocks the game or
+// serialization thread. Queued writes are coalesced per slot: quicksave
+// spam replaces the not-yet-started write for that slot instead of
+// lining up full writes.
+class SaveWriter {
+public:
+  explicit SaveWriter(QString database_path);
+  ~SaveWriter();
+
+  SaveWriter(const SaveWriter &) = delete;
+  auto operator=(const SaveWriter &) -> SaveWriter & = delete;
+
+  struct Job {
+    QString slotName;
+    QString title;
+    QJsonObject metadata;
+    QByteArray worldState;
+    QByteArray screenshot;
+    // Checkpoint writes drop the now-unreachable '<slot>.dN' delta slots
+    // once the checkpoint has landed.
+    bool purgeDeltas = false;
+  };
+
+  // Queues a write and returns immediately, replacing any queued job for
+  // the same slot that the worker has not started yet.
+  void enqueue(Job job);
+
+  // Blocks until every queued and in-flight write has finished. Call
+  // before reads that must observe pending writes (load, list, delete).
+  void flush();
+
+private:
+  void run();
+
+  QString m_database_path;
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_idle;
+  std::deque<Job> m_queue;
+  bool m_busy = false;
+  bool m_stop = false;
+  std::thread m_thread;
+};
+
+} // namespace Game::Systems
@@ -95,12 +95,34 @@ void SelectionController::onClickSelect(qreal sx, qreal sy, bool additive,
                                           viewportHeight, hit)) {
       return;
     }
-    auto targets = Game::Systems::FormationPlanner::spreadFormation(
+    auto slots = Game::Systems::FormationPlanner::spreadFormation(
         int(selected.size()), hit,
         Game::GameConfig::instance().gameplay().formationSpacingDefault);
+
+    std::vector<QVector3D> unit_positions;
+    unit_positions.reserve(selected.size());
+    for (auto unit_id : selected) {
+      auto *entity = m_world->getEntity(unit_id);
+      auto *transform =
+          (entity != nullptr)
+              ? entity->getComponent<Engine::Core::TransformComponent>()
+              : nullptr;
+      if (transform != nullptr) {
+        unit_positions.emplace_back(transform->position.x,
+                                    transform->position.y,
+                                    transform->position.z);
+      } else {
+        unit_positions.push_back(hit);
+      }
+    }
+    auto targets =
+        Game::Systems::FormationPlanner::assignSlots(slots, unit_positions);
     Game::Systems::CommandService::MoveOptions opts;
     opts.groupMove = selected.size() > 1;
-    Game::Systems::CommandService::moveUnits(*m_world, selected, targets, opts);
+    // Queued rather than applied: the command lands at the next tick
+    // boundary, and re-issuing during a drag replaces the pending move.
+    Game::Systems::CommandService::queueMove(selected, std::move(targets),
+                                             opts);
     syncSelectionFlags();
     return;
   }
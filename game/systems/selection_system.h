@@ -18,6 +18,9 @@ class PickingService;
 class SelectionSystem : public Engine::Core::System {
 public:
   void update(Engine::Core::World *world, float deltaTime) override;
+  [[nodiscard]] auto name() const -> const char * override {
+    return "SelectionSystem";
+  }
 
   void selectUnit(Engine::Core::EntityID unit_id);
   void deselectUnit(Engine::Core::EntityID unit_id);
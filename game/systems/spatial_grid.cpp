@@ -0,0 +1,176 @@
+#include "spatial_grid.h"
+#include "../core/component.h"
+#include "../core/world.h"
+#include "owner_registry.h"
+#include <limits>
+
+namespace Game::Systems {
+
+auto SpatialGrid::instance() -> SpatialGrid & {
+  static SpatialGrid instance;
+  return instance;
+}
+
+void SpatialGrid::rebuild(Engine::Core::World &world) {
+  m_entries.clear();
+  for (auto &[key, bucket] : m_cells) {
+    bucket.clear();
+  }
+  m_disturbedCells.clear();
+
+  const auto &units = world.view<Engine::Core::UnitComponent>();
+  m_entries.reserve(units.size());
+
+  std::unordered_set<Engine::Core::EntityID> seen;
+  seen.reserve(units.size());
+
+  for (auto *entity : units) {
+    if (entity->hasComponent<Engine::Core::PendingRemovalComponent>()) {
+      continue;
+    }
+    auto *unit = entity->getComponent<Engine::Core::UnitComponent>();
+    auto *transform = entity->getComponent<Engine::Core::TransformComponent>();
+    if ((unit == nullptr) || (transform == nullptr) || unit->health <= 0) {
+      continue;
+    }
+
+    Entry entry;
+    entry.id = entity->getId();
+    entry.x = transform->position.x;
+    entry.y = transform->position.y;
+    entry.z = transform->position.z;
+    entry.ownerId = unit->owner_id;
+    entry.isBuilding = entity->hasComponent<Engine::Core::BuildingComponent>();
+
+    int const entry_index = static_cast<int>(m_entries.size());
+    std::uint64_t const key = cellKey(cellCoord(entry.x), cellCoord(entry.z));
+    m_entries.push_back(entry);
+    m_cells[key].push_back(entry_index);
+    seen.insert(entry.id);
+
+    auto last = m_lastCellOf.find(entry.id);
+    if (last == m_lastCellOf.end()) {
+      m_disturbedCells.insert(key);
+      m_lastCellOf.emplace(entry.id, key);
+    } else if (last->second != key) {
+      m_disturbedCells.insert(last->second);
+      m_disturbedCells.insert(key);
+      last->second = key;
+    }
+  }
+
+  // Entities that died or were removed since the previous rebuild disturb
+  // the cell they vacated.
+  for (auto it = m_lastCellOf.begin(); it != m_lastCellOf.end();) {
+    if (seen.find(it->first) == seen.end()) {
+      m_disturbedCells.insert(it->second);
+      it = m_lastCellOf.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void SpatialGrid::clear() {
+  m_entries.clear();
+  m_cells.clear();
+  m_lastCellOf.clear();
+  m_disturbedCells.clear();
+}
+
+auto SpatialGrid::isNeighborhoodDisturbed(float x, float z,
+                                          float radius) const -> bool {
+  if (m_disturbedCells.empty()) {
+    return false;
+  }
+  int const min_cx = cellCoord(x - radius);
+  int const max_cx = cellCoord(x + radius);
+  int const min_cz = cellCoord(z - radius);
+  int const max_cz = cellCoord(z + radius);
+  for (int cz = min_cz; cz <= max_cz; ++cz) {
+    for (int cx = min_cx; cx <= max_cx; ++cx) {
+      if (m_disturbedCells.find(cellKey(cx, cz)) != m_disturbedCells.end()) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void SpatialGrid::gatherInRadius(float x, float z, float radius,
+                                 CandidateBatch &out) const {
+  out.clear();
+  if (radius <= 0.0F) {
+    return;
+  }
+  int const min_cx = cellCoord(x - radius);
+  int const max_cx = cellCoord(x + radius);
+  int const min_cz = cellCoord(z - radius);
+  int const max_cz = cellCoord(z + radius);
+  for (int cz = min_cz; cz <= max_cz; ++cz) {
+    for (int cx = min_cx; cx <= max_cx; ++cx) {
+      auto it = m_cells.find(cellKey(cx, cz));
+      if (it == m_cells.end()) {
+        continue;
+      }
+      for (int const entry_index : it->second) {
+        const Entry &entry = m_entries[entry_index];
+        out.xs.push_back(entry.x);
+        out.zs.push_back(entry.z);
+        out.ids.push_back(entry.id);
+        out.owners.push_back(entry.ownerId);
+        out.buildings.push_back(entry.isBuilding ? 1U : 0U);
+        out.entryRows.push_back(entry_index);
+      }
+    }
+  }
+}
+
+void SpatialGrid::computeDistancesSq(CandidateBatch &batch, float x, float z) {
+  std::size_t const count = batch.xs.size();
+  batch.distancesSq.resize(count);
+  const float *xs = batch.xs.data();
+  const float *zs = batch.zs.data();
+  float *out = batch.distancesSq.data();
+  for (std::size_t i = 0; i < count; ++i) {
+    float const dx = xs[i] - x;
+    float const dz = zs[i] - z;
+    out[i] = dx * dx + dz * dz;
+  }
+}
+
+auto SpatialGrid::nearestEnemy(float x, float z, float maxRange, int ownerId,
+                               Engine::Core::EntityID excludeId,
+                               bool includeBuildings) const -> const Entry * {
+  gatherInRadius(x, z, maxRange, m_queryScratch);
+  computeDistancesSq(m_queryScratch, x, z);
+
+  auto &owner_registry = OwnerRegistry::instance();
+
+  // Distance leads the filter chain: it is already computed and rejects
+  // most candidates before any relation lookup runs.
+  float nearest_dist_sq = maxRange * maxRange;
+  int nearest_row = -1;
+  std::size_t const count = m_queryScratch.size();
+  for (std::size_t i = 0; i < count; ++i) {
+    if (m_queryScratch.distancesSq[i] >= nearest_dist_sq) {
+      continue;
+    }
+    if (m_queryScratch.ids[i] == excludeId) {
+      continue;
+    }
+    if ((m_queryScratch.buildings[i] != 0U) && !includeBuildings) {
+      continue;
+    }
+    if (m_queryScratch.owners[i] == ownerId ||
+        owner_registry.areAllies(ownerId, m_queryScratch.owners[i])) {
+      continue;
+    }
+    nearest_dist_sq = m_queryScratch.distancesSq[i];
+    nearest_row = m_queryScratch.entryRows[i];
+  }
+
+  return nearest_row >= 0 ? &m_entries[nearest_row] : nullptr;
+}
+
+} // namespace Game::Systems
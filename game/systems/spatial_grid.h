@@ -0,0 +1,152 @@
+#pragma once
+
+#include "../core/entity.h"
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Engine::Core {
+class World;
+}
+
+namespace Game::Systems {
+
+// Uniform hash grid over unit and building positions, rebuilt once per
+// simulation tick. Proximity queries (auto-engagement, target acquisition,
+// combat-mode selection, picking) walk only the cells a radius overlaps
+// instead of every entity in the world. Entries cache the fields those
+// queries filter on; anything mutated mid-tick (health, pending removal)
+// must be re-checked against the live entity by the caller. Not thread
+// safe: rebuild and queries both run on the simulation thread.
+class SpatialGrid {
+public:
+  static auto instance() -> SpatialGrid &;
+
+  // Sized to a typical vision range so radius queries touch a handful of
+  // cells.
+  static constexpr float kCellSize = 8.0F;
+
+  struct Entry {
+    Engine::Core::EntityID id = 0;
+    float x = 0.0F;
+    float y = 0.0F;
+    float z = 0.0F;
+    int ownerId = 0;
+    bool isBuilding = false;
+  };
+
+  // Drops dead and pending-removal entities; call once per tick after
+  // movement has integrated positions.
+  void rebuild(Engine::Core::World &world);
+
+  void clear();
+
+  // Visits every entry whose XZ position is within radius of (x, z).
+  template <typename Visitor>
+  void forEachInRadius(float x, float z, float radius, Visitor &&visit) const {
+    if (radius <= 0.0F) {
+      return;
+    }
+    int const min_cx = cellCoord(x - radius);
+    int const max_cx = cellCoord(x + radius);
+    int const min_cz = cellCoord(z - radius);
+    int const max_cz = cellCoord(z + radius);
+    float const radius_sq = radius * radius;
+    for (int cz = min_cz; cz <= max_cz; ++cz) {
+      for (int cx = min_cx; cx <= max_cx; ++cx) {
+        auto it = m_cells.find(cellKey(cx, cz));
+        if (it == m_cells.end()) {
+          continue;
+        }
+        for (int const entry_index : it->second) {
+          const Entry &entry = m_entries[entry_index];
+          float const dx = entry.x - x;
+          float const dz = entry.z - z;
+          if (dx * dx + dz * dz <= radius_sq) {
+            visit(entry);
+          }
+        }
+      }
+    }
+  }
+
+  // SoA batch of candidates gathered from the cells a radius overlaps.
+  // gatherInRadius copies positions and filter fields without per-entry
+  // distance tests; computeDistancesSq then runs as one straight-line
+  // pass over the packed floats that the compiler can vectorize, instead
+  // of interleaving distance math with hash lookups and relation checks
+  // per pair. Buffers keep their capacity across queries.
+  struct CandidateBatch {
+    std::vector<float> xs;
+    std::vector<float> zs;
+    std::vector<Engine::Core::EntityID> ids;
+    std::vector<int> owners;
+    std::vector<std::uint8_t> buildings;
+    // Row in the grid's entry array, for mapping a winner back to its
+    // Entry without a lookup.
+    std::vector<int> entryRows;
+    std::vector<float> distancesSq;
+
+    [[nodiscard]] auto size() const -> std::size_t { return xs.size(); }
+    void clear() {
+      xs.clear();
+      zs.clear();
+      ids.clear();
+      owners.clear();
+      buildings.clear();
+      entryRows.clear();
+      distancesSq.clear();
+    }
+  };
+  void gatherInRadius(float x, float z, float radius,
+                      CandidateBatch &out) const;
+  static void computeDistancesSq(CandidateBatch &batch, float x, float z);
+
+  // Nearest entry hostile to ownerId (per OwnerRegistry team relations)
+  // within maxRange, or nullptr. Filters on the cached snapshot only.
+  auto nearestEnemy(float x, float z, float maxRange, int ownerId,
+                    Engine::Core::EntityID excludeId = 0,
+                    bool includeBuildings = false) const -> const Entry *;
+
+  auto entryCount() const -> std::size_t { return m_entries.size(); }
+
+  // True when any cell overlapping the radius saw an entity enter or
+  // leave during the last rebuild. Lets resting units skip proximity
+  // queries entirely on ticks where nothing moved near them; callers
+  // should inflate the radius by one cell, since movement inside a single
+  // cell raises no event until the next boundary crossing.
+  auto isNeighborhoodDisturbed(float x, float z, float radius) const -> bool;
+
+  auto disturbedCellCount() const -> std::size_t {
+    return m_disturbedCells.size();
+  }
+
+private:
+  SpatialGrid() = default;
+  ~SpatialGrid() = default;
+  SpatialGrid(const SpatialGrid &) = delete;
+  auto operator=(const SpatialGrid &) -> SpatialGrid & = delete;
+
+  static auto cellCoord(float v) -> int {
+    return static_cast<int>(std::floor(v / kCellSize));
+  }
+  static auto cellKey(int cx, int cz) -> std::uint64_t {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cx)) << 32U) |
+           static_cast<std::uint64_t>(static_cast<std::uint32_t>(cz));
+  }
+
+  std::vector<Entry> m_entries;
+  std::unordered_map<std::uint64_t, std::vector<int>> m_cells;
+
+  // Cell each entity occupied after the previous rebuild, and the cells
+  // entities entered or left during the last one.
+  std::unordered_map<Engine::Core::EntityID, std::uint64_t> m_lastCellOf;
+  std::unordered_set<std::uint64_t> m_disturbedCells;
+
+  // Scratch for nearestEnemy; queries run on the simulation thread only.
+  mutable CandidateBatch m_queryScratch;
+};
+
+} // namespace Game::Systems
@@ -4,9 +4,18 @@
 #include "../core/world.h"
 #include "../map/terrain_service.h"
 #include "../units/troop_config.h"
+#include <cstddef>
 
 namespace Game::Systems {
 
+auto TerrainAlignmentSystem::access() const -> Engine::Core::SystemAccess {
+  // Writes unit heights from static terrain data; reads unit config only.
+  return {.reads = Engine::Core::componentBit<Engine::Core::UnitComponent>(),
+          .writes =
+              Engine::Core::componentBit<Engine::Core::TransformComponent>(),
+          .exclusive = false};
+}
+
 void TerrainAlignmentSystem::update(Engine::Core::World *world,
                                     float deltaTime) {
   auto &terrain_service = Game::Map::TerrainService::instance();
@@ -15,33 +24,57 @@ void TerrainAlignmentSystem::update(Engine::Core::World *world,
     return;
   }
 
-  auto entities = world->getEntitiesWith<Engine::Core::TransformComponent>();
+  const auto &entities = world->view<Engine::Core::TransformComponent>();
+
+  // Only entities that moved since their last alignment get sampled; the
+  // terrain is static, so a stationary unit's height cannot change.
+  // Positions come straight from the transform, so the movement system
+  // writing a new position is what re-enrolls a unit here.
+  m_xs.clear();
+  m_zs.clear();
+  m_pending.clear();
   for (auto *entity : entities) {
-    alignEntityToTerrain(entity);
+    auto *transform = entity->getComponent<Engine::Core::TransformComponent>();
+    auto it = m_lastAligned.find(entity->getId());
+    if (it != m_lastAligned.end() && it->second.x == transform->position.x &&
+        it->second.z == transform->position.z) {
+      continue;
+    }
+    m_pending.push_back(entity);
+    m_xs.push_back(transform->position.x);
+    m_zs.push_back(transform->position.z);
   }
-}
 
-void TerrainAlignmentSystem::alignEntityToTerrain(
-    Engine::Core::Entity *entity) {
-  auto *transform = entity->getComponent<Engine::Core::TransformComponent>();
-  if (transform == nullptr) {
+  if (m_lastAligned.size() > entities.size() * 2 + 64) {
+    // Entries for despawned entities linger; rebuild from scratch once
+    // the map clearly outgrows the live set.
+    m_lastAligned.clear();
+  }
+
+  if (m_pending.empty()) {
     return;
   }
 
-  auto &terrain_service = Game::Map::TerrainService::instance();
+  m_heights.resize(m_xs.size());
+  terrain_service.heightSampler().heightsAt(m_xs, m_zs, m_heights);
 
-  float const terrain_height = terrain_service.getTerrainHeight(
-      transform->position.x, transform->position.z);
+  std::size_t i = 0;
+  for (auto *entity : m_pending) {
+    auto *transform = entity->getComponent<Engine::Core::TransformComponent>();
+    m_lastAligned[entity->getId()] = {transform->position.x,
+                                      transform->position.z};
+    float const terrain_height = m_heights[i++];
 
-  float entity_base_offset = 0.0F;
-  if (auto *unit = entity->getComponent<Engine::Core::UnitComponent>()) {
-    entity_base_offset =
-        Game::Units::TroopConfig::instance().getSelectionRingGroundOffset(
-            unit->spawn_type);
-  }
+    float entity_base_offset = 0.0F;
+    if (auto *unit = entity->getComponent<Engine::Core::UnitComponent>()) {
+      entity_base_offset =
+          Game::Units::TroopConfig::instance().getSelectionRingGroundOffset(
+              unit->spawn_type);
+    }
 
-  transform->position.y =
-      terrain_height + entity_base_offset * transform->scale.y;
+    transform->position.y =
+        terrain_height + entity_base_offset * transform->scale.y;
+  }
 }
 
 } // namespace Game::Systems
@@ -1,19 +1,39 @@
 #pragma once
 
+#include "../core/entity.h"
 #include "../core/system.h"
-
-namespace Engine::Core {
-class Entity;
-}
+#include <unordered_map>
+#include <vector>
 
 namespace Game::Systems {
 
 class TerrainAlignmentSystem : public Engine::Core::System {
 public:
   void update(Engine::Core::World *world, float deltaTime) override;
+  [[nodiscard]] auto name() const -> const char * override {
+    return "TerrainAlignmentSystem";
+  }
+  [[nodiscard]] auto access() const -> Engine::Core::SystemAccess override;
+  // Slope alignment only drifts as fast as units move; 10 Hz is enough.
+  [[nodiscard]] auto tickInterval() const -> int override { return 3; }
 
 private:
-  static void alignEntityToTerrain(Engine::Core::Entity *entity);
+  // Gather/sample/write-back scratch, reused across ticks so the batched
+  // height query never reallocates in steady state.
+  std::vector<float> m_xs;
+  std::vector<float> m_zs;
+  std::vector<float> m_heights;
+  std::vector<Engine::Core::Entity *> m_pending;
+
+  // Last XZ each entity was aligned at. The terrain is static, so an
+  // entity that has not moved since its last alignment keeps its height;
+  // only the moved subset gets sampled, which is what makes a mostly-idle
+  // late game cheap here.
+  struct AlignedAt {
+    float x;
+    float z;
+  };
+  std::unordered_map<Engine::Core::EntityID, AlignedAt> m_lastAligned;
 };
 
 } // namespace Game::Systems
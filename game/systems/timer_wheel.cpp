@@ -0,0 +1,110 @@
+#include "timer_wheel.h"
+#include <cmath>
+#include <utility>
+
+namespace Game::Systems {
+
+TimerWheel::TimerWheel(float tickSeconds) : m_tickSeconds(tickSeconds) {}
+
+auto TimerWheel::schedule(float delaySeconds,
+                          std::uint64_t payload) -> std::uint64_t {
+  std::uint64_t ticks = 1;
+  if (delaySeconds > 0.0F) {
+    ticks = static_cast<std::uint64_t>(std::ceil(delaySeconds / m_tickSeconds));
+    if (ticks == 0) {
+      ticks = 1;
+    }
+  }
+
+  Timer timer;
+  timer.id = m_nextId++;
+  timer.expiryTick = m_currentTick + ticks;
+  timer.payload = payload;
+  place(timer);
+  ++m_pending;
+  return timer.id;
+}
+
+void TimerWheel::cancel(std::uint64_t timerId) { m_cancelled.insert(timerId); }
+
+void TimerWheel::advance(float deltaTime,
+                         std::vector<std::uint64_t> &expiredPayloads) {
+  if (deltaTime > 0.0F) {
+    m_accumulator += deltaTime;
+  }
+
+  while (m_accumulator >= m_tickSeconds) {
+    m_accumulator -= m_tickSeconds;
+    ++m_currentTick;
+
+    // Whenever a level's window wraps, the next level's current slot is
+    // re-placed one level down; timers due this very tick land in the
+    // level-0 slot expired below.
+    for (int level = 1; level < kLevels; ++level) {
+      std::uint64_t const window_mask =
+          (std::uint64_t{1} << (kSlotBits * level)) - 1;
+      if ((m_currentTick & window_mask) != 0) {
+        break;
+      }
+      auto const slot = static_cast<int>(
+          (m_currentTick >> (kSlotBits * level)) & kSlotMask);
+      auto timers = std::move(m_wheels[level][slot]);
+      m_wheels[level][slot].clear();
+      for (const auto &timer : timers) {
+        auto it = m_cancelled.find(timer.id);
+        if (it != m_cancelled.end()) {
+          m_cancelled.erase(it);
+          --m_pending;
+          continue;
+        }
+        place(timer);
+      }
+    }
+
+    expireSlot(m_wheels[0][m_currentTick & kSlotMask], expiredPayloads);
+  }
+}
+
+void TimerWheel::clear() {
+  for (auto &wheel : m_wheels) {
+    for (auto &slot : wheel) {
+      slot.clear();
+    }
+  }
+  m_cancelled.clear();
+  m_pending = 0;
+  m_accumulator = 0.0F;
+}
+
+void TimerWheel::place(const Timer &timer) {
+  std::uint64_t const delta =
+      timer.expiryTick > m_currentTick ? timer.expiryTick - m_currentTick : 0;
+  for (int level = 0; level < kLevels; ++level) {
+    std::uint64_t const span = std::uint64_t{1} << (kSlotBits * (level + 1));
+    if (delta < span || level == kLevels - 1) {
+      auto const slot = static_cast<int>(
+          (timer.expiryTick >> (kSlotBits * level)) & kSlotMask);
+      m_wheels[level][slot].push_back(timer);
+      return;
+    }
+  }
+}
+
+void TimerWheel::expireSlot(std::vector<Timer> &slot,
+                            std::vector<std::uint64_t> &expiredPayloads) {
+  if (slot.empty()) {
+    return;
+  }
+  for (const auto &timer : slot) {
+    --m_pending;
+    auto it = m_cancelled.find(timer.id);
+    if (it != m_cancelled.end()) {
+      m_cancelled.erase(it);
+      continue;
+    }
+    expiredPayloads.push_back(timer.payload);
+  }
+  slot.clear();
+}
+
+} // namespace Game::Systems
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+namespace Game::Systems {
+
+// Hierarchical timer wheel for one-shot gameplay delays (engagement
+// cooldowns, ability timers, delayed effects). Scheduling, cancelling and
+// popping a due timer are all O(1); advancing a tick touches only the slot
+// that came due plus an occasional cascade, so per-frame cost no longer
+// scales with the number of pending timers the way iterating a cooldown
+// map does. Each system owns its wheel; payloads are opaque to the wheel
+// and are handed back on expiry.
+class TimerWheel {
+public:
+  explicit TimerWheel(float tickSeconds = 1.0F / 30.0F);
+
+  // Returns a timer id usable with cancel(). Delays shorter than one tick
+  // fire on the next advance.
+  auto schedule(float delaySeconds, std::uint64_t payload) -> std::uint64_t;
+
+  void cancel(std::uint64_t timerId);
+
+  // Advances by deltaTime and appends the payloads of every timer that
+  // came due, in expiry order.
+  void advance(float deltaTime, std::vector<std::uint64_t> &expiredPayloads);
+
+  auto pendingCount() const -> std::size_t { return m_pending; }
+
+  void clear();
+
+private:
+  // Four levels of 32 slots: ~1 s, ~34 s, ~18 min, ~9.7 h of range at the
+  // default 30 Hz tick.
+  static constexpr int kSlotBits = 5;
+  static constexpr int kSlots = 1 << kSlotBits;
+  static constexpr int kLevels = 4;
+  static constexpr std::uint64_t kSlotMask = kSlots - 1;
+
+  struct Timer {
+    std::uint64_t id = 0;
+    std::uint64_t expiryTick = 0;
+    std::uint64_t payload = 0;
+  };
+
+  void place(const Timer &timer);
+  void expireSlot(std::vector<Timer> &slot,
+                  std::vector<std::uint64_t> &expiredPayloads);
+
+  std::array<std::array<std::vector<Timer>, kSlots>, kLevels> m_wheels;
+  std::uint64_t m_currentTick = 0;
+  float m_tickSeconds;
+  float m_accumulator = 0.0F;
+  std::uint64_t m_nextId = 1;
+  std::size_t m_pending = 0;
+  // Cancellation is lazy: ids land here and the timer is dropped when its
+  // slot is next visited.
+  std::unordered_set<std::uint64_t> m_cancelled;
+};
+
+} // namespace Game::Systems
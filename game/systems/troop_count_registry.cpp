@@ -4,9 +4,25 @@
 #include "../units/troop_config.h"
 #include "core/event_manager.h"
 #include "units/spawn_type.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
 
 namespace Game::Systems {
 
+namespace {
+
+// Owner ids are small non-negative integers; neutral (-1) and anything
+// past the tracked range never holds troops and maps to no slot.
+auto ownerSlot(int owner_id) -> int {
+  if (owner_id < 0 || owner_id >= TroopCountRegistry::k_max_tracked_owners) {
+    return -1;
+  }
+  return owner_id;
+}
+
+} // namespace
+
 auto TroopCountRegistry::instance() -> TroopCountRegistry & {
   static TroopCountRegistry inst;
   return inst;
@@ -24,14 +40,45 @@ void TroopCountRegistry::initialize() {
           [this](const Engine::Core::UnitDiedEvent &e) { onUnitDied(e); });
 }
 
-void TroopCountRegistry::clear() { m_troop_counts.clear(); }
+void TroopCountRegistry::clear() {
+  for (auto &count : m_troop_counts) {
+    count.store(0, std::memory_order_relaxed);
+  }
+  m_version.fetch_add(1, std::memory_order_release);
+}
 
 auto TroopCountRegistry::getTroopCount(int owner_id) const -> int {
-  auto it = m_troop_counts.find(owner_id);
-  if (it != m_troop_counts.end()) {
-    return it->second;
+  int const slot = ownerSlot(owner_id);
+  if (slot < 0) {
+    return 0;
   }
-  return 0;
+  return m_troop_counts[slot].load(std::memory_order_relaxed);
+}
+
+auto TroopCountRegistry::version() const -> std::uint64_t {
+  return m_version.load(std::memory_order_acquire);
+}
+
+auto TroopCountRegistry::snapshot() const -> CountsSnapshot {
+  CountsSnapshot snap;
+  snap.version = m_version.load(std::memory_order_acquire);
+  for (int i = 0; i < k_max_tracked_owners; ++i) {
+    snap.counts[i] = m_troop_counts[i].load(std::memory_order_relaxed);
+  }
+  return snap;
+}
+
+void TroopCountRegistry::add(int owner_id, int delta) {
+  int const slot = ownerSlot(owner_id);
+  if (slot < 0 || delta == 0) {
+    return;
+  }
+  int const updated =
+      m_troop_counts[slot].fetch_add(delta, std::memory_order_relaxed) + delta;
+  if (updated < 0) {
+    m_troop_counts[slot].store(0, std::memory_order_relaxed);
+  }
+  m_version.fetch_add(1, std::memory_order_release);
 }
 
 void TroopCountRegistry::onUnitSpawned(
@@ -40,10 +87,9 @@ void TroopCountRegistry::onUnitSpawned(
     return;
   }
 
-  int const individuals_per_unit =
+  add(event.owner_id,
       Game::Units::TroopConfig::instance().getIndividualsPerUnit(
-          event.spawn_type);
-  m_troop_counts[event.owner_id] += individuals_per_unit;
+          event.spawn_type));
 }
 
 void TroopCountRegistry::onUnitDied(const Engine::Core::UnitDiedEvent &event) {
@@ -51,17 +97,26 @@ void TroopCountRegistry::onUnitDied(const Engine::Core::UnitDiedEvent &event) {
     return;
   }
 
-  int const individuals_per_unit =
-      Game::Units::TroopConfig::instance().getIndividualsPerUnit(
-          event.spawn_type);
-  m_troop_counts[event.owner_id] -= individuals_per_unit;
-  if (m_troop_counts[event.owner_id] < 0) {
-    m_troop_counts[event.owner_id] = 0;
+  add(event.owner_id,
+      -Game::Units::TroopConfig::instance().getIndividualsPerUnit(
+          event.spawn_type));
+}
+
+void TroopCountRegistry::onOwnerChanged(int previousOwnerId, int newOwnerId,
+                                        Game::Units::SpawnType spawn_type) {
+  if (spawn_type == Game::Units::SpawnType::Barracks ||
+      previousOwnerId == newOwnerId) {
+    return;
   }
+
+  int const individuals_per_unit =
+      Game::Units::TroopConfig::instance().getIndividualsPerUnit(spawn_type);
+  add(previousOwnerId, -individuals_per_unit);
+  add(newOwnerId, individuals_per_unit);
 }
 
 void TroopCountRegistry::rebuildFromWorld(Engine::Core::World &world) {
-  m_troop_counts.clear();
+  std::array<int, k_max_tracked_owners> totals{};
 
   auto entities = world.getEntitiesWith<Engine::Core::UnitComponent>();
   for (auto *e : entities) {
@@ -74,11 +129,18 @@ void TroopCountRegistry::rebuildFromWorld(Engine::Core::World &world) {
       continue;
     }
 
-    int const individuals_per_unit =
-        Game::Units::TroopConfig::instance().getIndividualsPerUnit(
-            unit->spawn_type);
-    m_troop_counts[unit->owner_id] += individuals_per_unit;
+    int const slot = ownerSlot(unit->owner_id);
+    if (slot < 0) {
+      continue;
+    }
+    totals[slot] += Game::Units::TroopConfig::instance().getIndividualsPerUnit(
+        unit->spawn_type);
+  }
+
+  for (int i = 0; i < k_max_tracked_owners; ++i) {
+    m_troop_counts[i].store(totals[i], std::memory_order_relaxed);
   }
+  m_version.fetch_add(1, std::memory_order_release);
 }
 
 } // namespace Game::Systems
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "../core/event_manager.h"
-#include <unordered_map>
+#include <array>
+#include <atomic>
+#include <cstdint>
 
 namespace Engine::Core {
 class World;
@@ -9,18 +11,41 @@ class World;
 
 namespace Game::Systems {
 
+// Per-player troop totals kept fully incremental: spawn, death and
+// ownership-change events adjust lock-free per-owner counters, so the
+// production cap gate is one relaxed load instead of a unit-list scan.
+// A monotonic version stamps every mutation; UI bindings compare it and
+// refresh only when it moves.
 class TroopCountRegistry {
 public:
+  static constexpr int k_max_tracked_owners = 8;
+
+  struct CountsSnapshot {
+    std::uint64_t version = 0;
+    std::array<int, k_max_tracked_owners> counts{};
+  };
+
   static auto instance() -> TroopCountRegistry &;
 
   void initialize();
   void clear();
 
-  auto getTroopCount(int owner_id) const -> int;
+  [[nodiscard]] auto getTroopCount(int owner_id) const -> int;
+
+  // Bumped on every count mutation; an unchanged version guarantees an
+  // unchanged snapshot.
+  [[nodiscard]] auto version() const -> std::uint64_t;
+  [[nodiscard]] auto snapshot() const -> CountsSnapshot;
 
   void onUnitSpawned(const Engine::Core::UnitSpawnedEvent &event);
   void onUnitDied(const Engine::Core::UnitDiedEvent &event);
 
+  // Moves a unit's headcount between owners when it changes sides.
+  // Barracks carry no headcount, so today's only transfer — barrack
+  // capture — is a no-op; any future unit conversion stays exact.
+  void onOwnerChanged(int previousOwnerId, int newOwnerId,
+                      Game::Units::SpawnType spawn_type);
+
   void rebuildFromWorld(Engine::Core::World &world);
 
 private:
@@ -29,7 +54,10 @@ private:
   TroopCountRegistry(const TroopCountRegistry &) = delete;
   auto operator=(const TroopCountRegistry &) -> TroopCountRegistry & = delete;
 
-  std::unordered_map<int, int> m_troop_counts;
+  void add(int owner_id, int delta);
+
+  std::array<std::atomic<int>, k_max_tracked_owners> m_troop_counts{};
+  std::atomic<std::uint64_t> m_version{0};
 
   Engine::Core::ScopedEventSubscription<Engine::Core::UnitSpawnedEvent>
       m_unitSpawnedSubscription;
@@ -28,7 +28,7 @@ VictoryService::~VictoryService() = default;
 void VictoryService::reset() {
   m_victoryState = "";
   m_elapsedTime = 0.0F;
-  m_worldPtr = nullptr;
+  m_conditionsDirty = true;
   m_victoryCallback = nullptr;
 }
 
@@ -68,35 +68,38 @@ void VictoryService::update(Engine::Core::World &world, float deltaTime) {
     return;
   }
 
-  m_worldPtr = &world;
-
   if (m_victoryType == VictoryType::SurviveTime) {
+    // The survive timer is the only condition that advances without an
+    // event, and checking it is a float compare, not a scan.
     m_elapsedTime += deltaTime;
+    checkVictoryConditions(world);
+    if (!m_victoryState.isEmpty()) {
+      return;
+    }
   }
 
-  checkVictoryConditions(world);
-  if (!m_victoryState.isEmpty()) {
+  if (!m_conditionsDirty) {
     return;
   }
+  m_conditionsDirty = false;
+
+  if (m_victoryType != VictoryType::SurviveTime) {
+    checkVictoryConditions(world);
+    if (!m_victoryState.isEmpty()) {
+      return;
+    }
+  }
 
   checkDefeatConditions(world);
 }
 
-void VictoryService::onUnitDied(const Engine::Core::UnitDiedEvent &event) {}
+void VictoryService::onUnitDied(const Engine::Core::UnitDiedEvent &event) {
+  m_conditionsDirty = true;
+}
 
 void VictoryService::onBarrackCaptured(
     const Engine::Core::BarrackCapturedEvent &event) {
-
-  if ((m_worldPtr == nullptr) || !m_victoryState.isEmpty()) {
-    return;
-  }
-
-  checkVictoryConditions(*m_worldPtr);
-  if (!m_victoryState.isEmpty()) {
-    return;
-  }
-
-  checkDefeatConditions(*m_worldPtr);
+  m_conditionsDirty = true;
 }
 
 void VictoryService::checkVictoryConditions(Engine::Core::World &world) {
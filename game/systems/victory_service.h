@@ -76,7 +76,11 @@ private:
   Engine::Core::ScopedEventSubscription<Engine::Core::BarrackCapturedEvent>
       m_barrackCapturedSubscription;
 
-  Engine::Core::World *m_worldPtr = nullptr;
+  // Elimination and defeat conditions can only change when a unit dies or
+  // a barrack changes hands, so the entity scans run only on ticks where
+  // one of those events fired. Starts dirty so the initial state is
+  // evaluated once after configure().
+  bool m_conditionsDirty = true;
 
   Game::Systems::GlobalStatsRegistry &m_stats_registry;
   Game::Systems::OwnerRegistry &m_owner_registry;
@@ -1,12 +1,29 @@
 #include "unit.h"
 
 #include "../core/component.h"
+#include "../core/event_manager.h"
 #include "../core/world.h"
+#include "unit_def.h"
 #include "units/troop_type.h"
 #include <qvectornd.h>
 #include <string>
 #include <utility>
 
+static inline auto team_color(int owner_id) -> QVector3D {
+  switch (owner_id) {
+  case 1:
+    return {0.20F, 0.55F, 1.00F};
+  case 2:
+    return {1.00F, 0.30F, 0.30F};
+  case 3:
+    return {0.20F, 0.80F, 0.40F};
+  case 4:
+    return {1.00F, 0.80F, 0.20F};
+  default:
+    return {0.8F, 0.8F, 0.8F};
+  }
+}
+
 namespace Game::Units {
 
 Unit::Unit(Engine::Core::World &world, TroopType type)
@@ -42,6 +59,61 @@ void Unit::ensureCoreComponents() {
   }
 }
 
+void Unit::initFromDef(const SpawnParams &params, const UnitDef &def) {
+  auto *e = m_world->createEntity();
+  m_id = e->getId();
+
+  m_t = e->addComponent<Engine::Core::TransformComponent>();
+  m_t->position = {params.position.x(), params.position.y(),
+                   params.position.z()};
+  m_t->scale = {def.scale, def.scale, def.scale};
+
+  m_r = e->addComponent<Engine::Core::RenderableComponent>("", "");
+  m_r->visible = true;
+
+  m_u = e->addComponent<Engine::Core::UnitComponent>();
+  m_u->spawn_type = params.spawn_type;
+  m_u->health = def.maxHealth;
+  m_u->max_health = def.maxHealth;
+  m_u->speed = def.speed;
+  m_u->owner_id = params.player_id;
+  m_u->vision_range = def.visionRange;
+  m_u->unit_def_index = UnitDefTable::instance().indexFor(def.type);
+
+  if (params.aiControlled) {
+    e->addComponent<Engine::Core::AIControlledComponent>();
+  }
+
+  QVector3D const tc = team_color(m_u->owner_id);
+  m_r->color[0] = tc.x();
+  m_r->color[1] = tc.y();
+  m_r->color[2] = tc.z();
+
+  m_mv = e->addComponent<Engine::Core::MovementComponent>();
+  if (m_mv != nullptr) {
+    m_mv->goalX = params.position.x();
+    m_mv->goalY = params.position.z();
+    m_mv->target_x = params.position.x();
+    m_mv->target_y = params.position.z();
+  }
+
+  m_atk = e->addComponent<Engine::Core::AttackComponent>();
+  m_atk->range = def.rangedRange;
+  m_atk->damage = def.rangedDamage;
+  m_atk->cooldown = def.rangedCooldown;
+  m_atk->meleeRange = def.meleeRange;
+  m_atk->meleeDamage = def.meleeDamage;
+  m_atk->meleeCooldown = def.meleeCooldown;
+  m_atk->preferredMode = def.preferredMode;
+  m_atk->currentMode = def.initialMode;
+  m_atk->canRanged = def.canRanged;
+  m_atk->canMelee = def.canMelee;
+  m_atk->max_heightDifference = def.maxHeightDifference;
+
+  Engine::Core::EventManager::instance().publish(
+      Engine::Core::UnitSpawnedEvent(m_id, m_u->owner_id, m_u->spawn_type));
+}
+
 void Unit::moveTo(float x, float z) {
   ensureCoreComponents();
   if (m_mv == nullptr) {
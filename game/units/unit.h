@@ -20,6 +20,8 @@ struct AttackComponent;
 
 namespace Game::Units {
 
+struct UnitDef;
+
 struct SpawnParams {
 
   QVector3D position{0, 0, 0};
@@ -52,6 +54,10 @@ protected:
 
   void ensureCoreComponents();
 
+  // Creates the entity and stamps its components from the shared def
+  // row; the per-type factories only pick the row.
+  void initFromDef(const SpawnParams &params, const UnitDef &def);
+
   Engine::Core::World *m_world = nullptr;
   Engine::Core::EntityID m_id = 0;
   std::string m_type_string;
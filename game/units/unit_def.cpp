@@ -0,0 +1,107 @@
+#include "unit_def.h"
+
+namespace Game::Units {
+
+using CombatMode = Engine::Core::AttackComponent::CombatMode;
+
+auto UnitDefTable::instance() -> UnitDefTable & {
+  static UnitDefTable inst;
+  return inst;
+}
+
+UnitDefTable::UnitDefTable() {
+  auto add = [this](const UnitDef &def) {
+    m_defs.push_back(def);
+    m_indexByType[def.type] = static_cast<std::uint16_t>(m_defs.size());
+  };
+
+  {
+    UnitDef def;
+    def.type = TroopType::Archer;
+    def.maxHealth = 80;
+    def.speed = 3.0F;
+    def.visionRange = 16.0F;
+    def.scale = 0.5F;
+    def.rangedRange = 6.0F;
+    def.rangedDamage = 12;
+    def.rangedCooldown = 1.2F;
+    def.meleeRange = 1.5F;
+    def.meleeDamage = 5;
+    def.meleeCooldown = 0.8F;
+    def.canRanged = true;
+    def.canMelee = true;
+    def.preferredMode = CombatMode::Auto;
+    def.initialMode = CombatMode::Ranged;
+    add(def);
+  }
+
+  {
+    UnitDef def;
+    def.type = TroopType::Knight;
+    def.maxHealth = 150;
+    def.speed = 2.0F;
+    def.visionRange = 14.0F;
+    def.scale = 0.6F;
+    def.rangedRange = 1.5F;
+    def.rangedDamage = 5;
+    def.rangedCooldown = 2.0F;
+    def.meleeRange = 1.5F;
+    def.meleeDamage = 20;
+    def.meleeCooldown = 0.6F;
+    add(def);
+  }
+
+  {
+    UnitDef def;
+    def.type = TroopType::Spearman;
+    def.maxHealth = 120;
+    def.speed = 2.5F;
+    def.visionRange = 15.0F;
+    def.scale = 0.55F;
+    def.rangedRange = 2.5F;
+    def.rangedDamage = 8;
+    def.rangedCooldown = 1.5F;
+    def.meleeRange = 2.5F;
+    def.meleeDamage = 18;
+    def.meleeCooldown = 0.8F;
+    add(def);
+  }
+
+  {
+    UnitDef def;
+    def.type = TroopType::MountedKnight;
+    def.maxHealth = 200;
+    def.speed = 8.0F;
+    def.visionRange = 16.0F;
+    def.scale = 0.8F;
+    def.rangedRange = 1.5F;
+    def.rangedDamage = 5;
+    def.rangedCooldown = 2.0F;
+    def.meleeRange = 2.0F;
+    def.meleeDamage = 25;
+    def.meleeCooldown = 0.8F;
+    add(def);
+  }
+}
+
+auto UnitDefTable::defFor(TroopType type) const -> const UnitDef * {
+  auto it = m_indexByType.find(type);
+  if (it == m_indexByType.end()) {
+    return nullptr;
+  }
+  return &m_defs[it->second - 1];
+}
+
+auto UnitDefTable::indexFor(TroopType type) const -> std::uint16_t {
+  auto it = m_indexByType.find(type);
+  return it != m_indexByType.end() ? it->second : 0;
+}
+
+auto UnitDefTable::defAt(std::uint16_t index) const -> const UnitDef * {
+  if (index == 0 || index > m_defs.size()) {
+    return nullptr;
+  }
+  return &m_defs[index - 1];
+}
+
+} // namespace Game::Units
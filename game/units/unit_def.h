@@ -0,0 +1,57 @@
+#pragma once
+
+#include "../core/component.h"
+#include "troop_type.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Game::Units {
+
+// Immutable per-type unit stats shared by every spawned instance
+// (flyweight). The troop factories used to stamp these literals into each
+// entity at spawn, duplicating the same constants across thousands of
+// entities and four nearly identical init() bodies; they now live in one
+// table and entities point back at their row via
+// UnitComponent::unit_def_index.
+struct UnitDef {
+  TroopType type = TroopType::Archer;
+
+  int maxHealth = 0;
+  float speed = 0.0F;
+  float visionRange = 0.0F;
+  float scale = 1.0F;
+
+  float rangedRange = 0.0F;
+  int rangedDamage = 0;
+  float rangedCooldown = 0.0F;
+  float meleeRange = 0.0F;
+  int meleeDamage = 0;
+  float meleeCooldown = 0.0F;
+  bool canRanged = false;
+  bool canMelee = true;
+  Engine::Core::AttackComponent::CombatMode preferredMode =
+      Engine::Core::AttackComponent::CombatMode::Melee;
+  Engine::Core::AttackComponent::CombatMode initialMode =
+      Engine::Core::AttackComponent::CombatMode::Melee;
+  float maxHeightDifference = 2.0F;
+};
+
+class UnitDefTable {
+public:
+  static auto instance() -> UnitDefTable &;
+
+  [[nodiscard]] auto defFor(TroopType type) const -> const UnitDef *;
+
+  // 1-based row index as stored in UnitComponent::unit_def_index; 0 when
+  // the type has no def (buildings).
+  [[nodiscard]] auto indexFor(TroopType type) const -> std::uint16_t;
+  [[nodiscard]] auto defAt(std::uint16_t index) const -> const UnitDef *;
+
+private:
+  UnitDefTable();
+  std::vector<UnitDef> m_defs;
+  std::unordered_map<TroopType, std::uint16_t> m_indexByType;
+};
+
+} // namespace Game::Units
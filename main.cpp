@@ -24,6 +24,7 @@
 
 #include "app/core/game_engine.h"
 #include "app/core/language_manager.h"
+#include "app/models/minimap_provider.h"
 #include "ui/gl_view.h"
 #include "ui/theme.h"
 
@@ -60,6 +61,10 @@ auto main(int argc, char *argv[]) -> int {
   engine.rootContext()->setContextProperty("language_manager",
                                            language_manager);
   engine.rootContext()->setContextProperty("game", game_engine);
+  // The QML engine takes ownership of image providers.
+  auto *minimap_provider = new MinimapProvider();
+  engine.addImageProvider(QStringLiteral("minimap"), minimap_provider);
+  game_engine->setMinimapProvider(minimap_provider);
   engine.addImportPath("qrc:/StandardOfIron/ui/qml");
   qmlRegisterType<GLView>("StandardOfIron", 1, 0, "GLView");
 
@@ -67,6 +72,22 @@ auto main(int argc, char *argv[]) -> int {
   qmlRegisterSingletonType<Theme>("StandardOfIron.UI", 1, 0, "Theme",
                                   &Theme::create);
 
+  // --benchmark=<units-per-side>: skip the menu and run the scripted
+  // stress battle; the engine prints the JSON report when it completes.
+  for (const QString &arg : QGuiApplication::arguments()) {
+    if (arg.startsWith(QStringLiteral("--benchmark="))) {
+      bool ok = false;
+      const int units_per_side =
+          arg.mid(QStringLiteral("--benchmark=").size()).toInt(&ok);
+      if (ok && units_per_side > 0) {
+        game_engine->startBenchmark(units_per_side);
+      } else {
+        qWarning() << "Ignoring malformed" << arg
+                   << "(expected --benchmark=<units-per-side>)";
+      }
+    }
+  }
+
   engine.load(QUrl(QStringLiteral("qrc:/StandardOfIron/ui/qml/Main.qml")));
   if (engine.rootObjects().isEmpty()) {
     qWarning() << "Failed to load QML file";
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ground/firecamp_gpu.h"
+#include "particle_gpu.h"
 #include "ground/grass_gpu.h"
 #include "ground/pine_gpu.h"
 #include "ground/plant_gpu.h"
@@ -8,10 +9,11 @@
 #include "ground/terrain_gpu.h"
 #include <QMatrix4x4>
 #include <QVector3D>
+#include <QVector4D>
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
-#include <variant>
+#include <iterator>
 #include <vector>
 
 namespace Render::GL {
@@ -31,6 +33,8 @@ struct MeshCmd {
   QVector3D color{1, 1, 1};
   float alpha = 1.0F;
   class Shader *shader = nullptr;
+  // State key assigned at submit time; see DrawQueue::meshStateKey.
+  std::uint64_t sortKey = 0;
 };
 
 struct CylinderCmd {
@@ -53,6 +57,25 @@ struct FogBatchCmd {
   std::size_t count = 0;
 };
 
+// One map-covering quad whose fragment shader samples the visibility grid
+// texture and evaluates vision circles from a small source buffer; the
+// texture is only re-uploaded when `version` changes.
+struct FogMaskCmd {
+  const std::uint8_t *cells = nullptr;
+  int width = 0;
+  int height = 0;
+  float tile_size = 1.0F;
+  std::uint64_t version = 0;
+  // Rows touched since dirtyBaseVersion; when the GPU copy is exactly at
+  // dirtyBaseVersion the upload covers only these rows, otherwise the
+  // whole grid is re-uploaded. dirtyRowCount < 0 forces a full upload.
+  std::uint64_t dirtyBaseVersion = 0;
+  int dirtyRowStart = 0;
+  int dirtyRowCount = -1;
+  const QVector4D *sources = nullptr;
+  std::size_t sourceCount = 0;
+};
+
 struct GrassBatchCmd {
   Buffer *instanceBuffer = nullptr;
   std::size_t instance_count = 0;
@@ -83,6 +106,15 @@ struct FireCampBatchCmd {
   FireCampBatchParams params;
 };
 
+// Instances point at the particle pool buffer, which persists across
+// frames; instance_count covers the pool's live span, and expired slots
+// collapse to degenerate quads in the vertex shader.
+struct ParticleBatchCmd {
+  Buffer *instanceBuffer = nullptr;
+  std::size_t instance_count = 0;
+  ParticleBatchParams params;
+};
+
 struct TerrainChunkCmd {
   Mesh *mesh = nullptr;
   QMatrix4x4 model;
@@ -102,9 +134,10 @@ struct GridCmd {
   float extent = 50.0F;
 };
 
+// Ring and smoke models are translate+scale only; the instanced selection
+// pass extracts center and radius straight from the matrix.
 struct SelectionRingCmd {
   QMatrix4x4 model;
-  QMatrix4x4 mvp;
   QVector3D color{0, 0, 0};
   float alphaInner = 0.6F;
   float alphaOuter = 0.25F;
@@ -112,246 +145,218 @@ struct SelectionRingCmd {
 
 struct SelectionSmokeCmd {
   QMatrix4x4 model;
-  QMatrix4x4 mvp;
   QVector3D color{1, 1, 1};
   float baseAlpha = 0.15F;
 };
 
-using DrawCmd = std::variant<GridCmd, SelectionRingCmd, SelectionSmokeCmd,
-                             CylinderCmd, MeshCmd, FogBatchCmd, GrassBatchCmd,
-                             StoneBatchCmd, PlantBatchCmd, PineBatchCmd,
-                             FireCampBatchCmd, TerrainChunkCmd>;
-
-enum class DrawCmdType : std::uint8_t {
-  Grid = 0,
-  SelectionRing = 1,
-  SelectionSmoke = 2,
-  Cylinder = 3,
-  Mesh = 4,
-  FogBatch = 5,
-  GrassBatch = 6,
-  StoneBatch = 7,
-  PlantBatch = 8,
-  PineBatch = 9,
-  FireCampBatch = 10,
-  TerrainChunk = 11
+// One camera-facing bar billboarded at `anchor` by the instanced overlay
+// pass; `fill` is the health fraction, resolved against the bar's UVs in
+// the fragment shader, so backing and fill share the instance.
+struct HealthBarCmd {
+  QVector3D anchor;
+  float width = 0.9F;
+  QVector3D color{0.22F, 0.78F, 0.22F};
+  float fill = 1.0F;
 };
 
-constexpr std::size_t MeshCmdIndex =
-    static_cast<std::size_t>(DrawCmdType::Mesh);
-constexpr std::size_t GridCmdIndex =
-    static_cast<std::size_t>(DrawCmdType::Grid);
-constexpr std::size_t SelectionRingCmdIndex =
-    static_cast<std::size_t>(DrawCmdType::SelectionRing);
-constexpr std::size_t SelectionSmokeCmdIndex =
-    static_cast<std::size_t>(DrawCmdType::SelectionSmoke);
-constexpr std::size_t CylinderCmdIndex =
-    static_cast<std::size_t>(DrawCmdType::Cylinder);
-constexpr std::size_t FogBatchCmdIndex =
-    static_cast<std::size_t>(DrawCmdType::FogBatch);
-constexpr std::size_t GrassBatchCmdIndex =
-    static_cast<std::size_t>(DrawCmdType::GrassBatch);
-constexpr std::size_t StoneBatchCmdIndex =
-    static_cast<std::size_t>(DrawCmdType::StoneBatch);
-constexpr std::size_t PlantBatchCmdIndex =
-    static_cast<std::size_t>(DrawCmdType::PlantBatch);
-constexpr std::size_t PineBatchCmdIndex =
-    static_cast<std::size_t>(DrawCmdType::PineBatch);
-constexpr std::size_t FireCampBatchCmdIndex =
-    static_cast<std::size_t>(DrawCmdType::FireCampBatch);
-constexpr std::size_t TerrainChunkCmdIndex =
-    static_cast<std::size_t>(DrawCmdType::TerrainChunk);
-
-inline auto drawCmdType(const DrawCmd &cmd) -> DrawCmdType {
-  return static_cast<DrawCmdType>(cmd.index());
-}
-
+// Typed command arrays, one per pipeline. Submission appends to the array
+// for that command's type, so every pipeline receives a contiguous,
+// submission-ordered run with no per-command dispatch; the backend walks
+// the arrays in a fixed pass order (terrain, vegetation, meshes, effects).
+// Only terrain needs an explicit sort: the high byte of its sortKey layers
+// the ground plane under chunk overlays.
 class DrawQueue {
 public:
-  void clear() { m_items.clear(); }
-
-  void submit(const MeshCmd &c) { m_items.emplace_back(c); }
-  void submit(const GridCmd &c) { m_items.emplace_back(c); }
-  void submit(const SelectionRingCmd &c) { m_items.emplace_back(c); }
-  void submit(const SelectionSmokeCmd &c) { m_items.emplace_back(c); }
-  void submit(const CylinderCmd &c) { m_items.emplace_back(c); }
-  void submit(const FogBatchCmd &c) { m_items.emplace_back(c); }
-  void submit(const GrassBatchCmd &c) { m_items.emplace_back(c); }
-  void submit(const StoneBatchCmd &c) { m_items.emplace_back(c); }
-  void submit(const PlantBatchCmd &c) { m_items.emplace_back(c); }
-  void submit(const PineBatchCmd &c) { m_items.emplace_back(c); }
-  void submit(const FireCampBatchCmd &c) { m_items.emplace_back(c); }
-  void submit(const TerrainChunkCmd &c) { m_items.emplace_back(c); }
+  void clear() {
+    m_meshCmds.clear();
+    m_cylinderCmds.clear();
+    m_fogBatchCmds.clear();
+    m_fogMaskCmds.clear();
+    m_grassBatchCmds.clear();
+    m_stoneBatchCmds.clear();
+    m_plantBatchCmds.clear();
+    m_pineBatchCmds.clear();
+    m_fireCampBatchCmds.clear();
+    m_particleBatchCmds.clear();
+    m_terrainChunkCmds.clear();
+    m_gridCmds.clear();
+    m_selectionRingCmds.clear();
+    m_selectionSmokeCmds.clear();
+    m_healthBarCmds.clear();
+  }
 
-  [[nodiscard]] auto empty() const -> bool { return m_items.empty(); }
-  [[nodiscard]] auto size() const -> std::size_t { return m_items.size(); }
+  // Moves every command from `other` onto the end of this queue,
+  // preserving order within each typed array. Used to concatenate
+  // per-worker queues after parallel submission; `other` is left empty
+  // but keeps its capacity for the next frame.
+  void append(DrawQueue &other) {
+    const auto take = [](auto &dst, auto &src) {
+      dst.insert(dst.end(), std::make_move_iterator(src.begin()),
+                 std::make_move_iterator(src.end()));
+      src.clear();
+    };
+    take(m_meshCmds, other.m_meshCmds);
+    take(m_cylinderCmds, other.m_cylinderCmds);
+    take(m_fogBatchCmds, other.m_fogBatchCmds);
+    take(m_fogMaskCmds, other.m_fogMaskCmds);
+    take(m_grassBatchCmds, other.m_grassBatchCmds);
+    take(m_stoneBatchCmds, other.m_stoneBatchCmds);
+    take(m_plantBatchCmds, other.m_plantBatchCmds);
+    take(m_pineBatchCmds, other.m_pineBatchCmds);
+    take(m_fireCampBatchCmds, other.m_fireCampBatchCmds);
+    take(m_particleBatchCmds, other.m_particleBatchCmds);
+    take(m_terrainChunkCmds, other.m_terrainChunkCmds);
+    take(m_gridCmds, other.m_gridCmds);
+    take(m_selectionRingCmds, other.m_selectionRingCmds);
+    take(m_selectionSmokeCmds, other.m_selectionSmokeCmds);
+    take(m_healthBarCmds, other.m_healthBarCmds);
+  }
 
-  [[nodiscard]] auto getSorted(std::size_t i) const -> const DrawCmd & {
-    return m_items[m_sortIndices[i]];
+  void submit(const MeshCmd &c) {
+    MeshCmd &cmd = m_meshCmds.emplace_back(c);
+    cmd.sortKey = meshStateKey(cmd);
+  }
+  void submit(const GridCmd &c) { m_gridCmds.push_back(c); }
+  void submit(const SelectionRingCmd &c) { m_selectionRingCmds.push_back(c); }
+  void submit(const SelectionSmokeCmd &c) { m_selectionSmokeCmds.push_back(c); }
+  void submit(const HealthBarCmd &c) { m_healthBarCmds.push_back(c); }
+  void submit(const CylinderCmd &c) { m_cylinderCmds.push_back(c); }
+  void submit(const FogBatchCmd &c) { m_fogBatchCmds.push_back(c); }
+  void submit(const GrassBatchCmd &c) { m_grassBatchCmds.push_back(c); }
+  void submit(const StoneBatchCmd &c) { m_stoneBatchCmds.push_back(c); }
+  void submit(const PlantBatchCmd &c) { m_plantBatchCmds.push_back(c); }
+  void submit(const PineBatchCmd &c) { m_pineBatchCmds.push_back(c); }
+  void submit(const FireCampBatchCmd &c) { m_fireCampBatchCmds.push_back(c); }
+  void submit(const ParticleBatchCmd &c) { m_particleBatchCmds.push_back(c); }
+  void submit(const TerrainChunkCmd &c) { m_terrainChunkCmds.push_back(c); }
+  void submit(const FogMaskCmd &c) { m_fogMaskCmds.push_back(c); }
+
+  [[nodiscard]] auto empty() const -> bool { return size() == 0; }
+
+  [[nodiscard]] auto size() const -> std::size_t {
+    return m_meshCmds.size() + m_cylinderCmds.size() + m_fogBatchCmds.size() +
+           m_fogMaskCmds.size() + m_grassBatchCmds.size() +
+           m_stoneBatchCmds.size() + m_plantBatchCmds.size() +
+           m_pineBatchCmds.size() + m_fireCampBatchCmds.size() +
+           m_particleBatchCmds.size() + m_terrainChunkCmds.size() +
+           m_gridCmds.size() +
+           m_selectionRingCmds.size() + m_selectionSmokeCmds.size() +
+           m_healthBarCmds.size();
   }
 
-  [[nodiscard]] auto items() const -> const std::vector<DrawCmd> & {
-    return m_items;
+  [[nodiscard]] auto meshCmds() const -> const std::vector<MeshCmd> & {
+    return m_meshCmds;
+  }
+  [[nodiscard]] auto cylinderCmds() const -> const std::vector<CylinderCmd> & {
+    return m_cylinderCmds;
+  }
+  [[nodiscard]] auto fogBatchCmds() const -> const std::vector<FogBatchCmd> & {
+    return m_fogBatchCmds;
+  }
+  [[nodiscard]] auto fogMaskCmds() const -> const std::vector<FogMaskCmd> & {
+    return m_fogMaskCmds;
+  }
+  [[nodiscard]] auto
+  grassBatchCmds() const -> const std::vector<GrassBatchCmd> & {
+    return m_grassBatchCmds;
+  }
+  [[nodiscard]] auto
+  stoneBatchCmds() const -> const std::vector<StoneBatchCmd> & {
+    return m_stoneBatchCmds;
+  }
+  [[nodiscard]] auto
+  plantBatchCmds() const -> const std::vector<PlantBatchCmd> & {
+    return m_plantBatchCmds;
+  }
+  [[nodiscard]] auto
+  pineBatchCmds() const -> const std::vector<PineBatchCmd> & {
+    return m_pineBatchCmds;
+  }
+  [[nodiscard]] auto
+  fireCampBatchCmds() const -> const std::vector<FireCampBatchCmd> & {
+    return m_fireCampBatchCmds;
+  }
+  [[nodiscard]] auto
+  particleBatchCmds() const -> const std::vector<ParticleBatchCmd> & {
+    return m_particleBatchCmds;
+  }
+  [[nodiscard]] auto
+  terrainChunkCmds() const -> const std::vector<TerrainChunkCmd> & {
+    return m_terrainChunkCmds;
+  }
+  [[nodiscard]] auto gridCmds() const -> const std::vector<GridCmd> & {
+    return m_gridCmds;
+  }
+  [[nodiscard]] auto
+  selectionRingCmds() const -> const std::vector<SelectionRingCmd> & {
+    return m_selectionRingCmds;
+  }
+  [[nodiscard]] auto
+  selectionSmokeCmds() const -> const std::vector<SelectionSmokeCmd> & {
+    return m_selectionSmokeCmds;
+  }
+  [[nodiscard]] auto
+  healthBarCmds() const -> const std::vector<HealthBarCmd> & {
+    return m_healthBarCmds;
   }
 
+  // Orders terrain chunks by the high byte of their sortKey (ground plane
+  // first, overlays after) and mesh commands by their state key, so
+  // commands sharing shader, texture and mesh land adjacent and the
+  // backend's last-bound checks skip the redundant binds between them.
+  // Both sorts are stable so commands sharing a key keep submission
+  // order. Every other array already draws in submission order and needs
+  // no pass here.
   void sortForBatching() {
-    const std::size_t count = m_items.size();
-
-    m_sortKeys.resize(count);
-    m_sortIndices.resize(count);
-
-    for (std::size_t i = 0; i < count; ++i) {
-      m_sortIndices[i] = static_cast<uint32_t>(i);
-      m_sortKeys[i] = computeSortKey(m_items[i]);
-    }
-
-    if (count >= 2) {
-      radixSortTwoPass(count);
-    }
+    std::stable_sort(m_terrainChunkCmds.begin(), m_terrainChunkCmds.end(),
+                     [](const TerrainChunkCmd &a, const TerrainChunkCmd &b) {
+                       return (a.sortKey >> 8) < (b.sortKey >> 8);
+                     });
+    std::stable_sort(m_meshCmds.begin(), m_meshCmds.end(),
+                     [](const MeshCmd &a, const MeshCmd &b) {
+                       return a.sortKey < b.sortKey;
+                     });
   }
 
 private:
-  void radixSortTwoPass(std::size_t count) {
-    constexpr int BUCKETS = 256;
-
-    m_tempIndices.resize(count);
-
-    {
-      int histogram[BUCKETS] = {0};
-
-      for (std::size_t i = 0; i < count; ++i) {
-        auto const bucket = static_cast<uint8_t>(m_sortKeys[i] >> 56);
-        ++histogram[bucket];
-      }
-
-      int offsets[BUCKETS];
-      offsets[0] = 0;
-      for (int i = 1; i < BUCKETS; ++i) {
-        offsets[i] = offsets[i - 1] + histogram[i - 1];
-      }
-
-      for (std::size_t i = 0; i < count; ++i) {
-        auto const bucket =
-            static_cast<uint8_t>(m_sortKeys[m_sortIndices[i]] >> 56);
-        m_tempIndices[offsets[bucket]++] = m_sortIndices[i];
-      }
-    }
-
-    {
-      int histogram[BUCKETS] = {0};
-
-      for (std::size_t i = 0; i < count; ++i) {
-        uint8_t const bucket =
-            static_cast<uint8_t>(m_sortKeys[m_tempIndices[i]] >> 48) & 0xFF;
-        ++histogram[bucket];
-      }
-
-      int offsets[BUCKETS];
-      offsets[0] = 0;
-      for (int i = 1; i < BUCKETS; ++i) {
-        offsets[i] = offsets[i - 1] + histogram[i - 1];
-      }
-
-      for (std::size_t i = 0; i < count; ++i) {
-        uint8_t const bucket =
-            static_cast<uint8_t>(m_sortKeys[m_tempIndices[i]] >> 48) & 0xFF;
-        m_sortIndices[offsets[bucket]++] = m_tempIndices[i];
-      }
-    }
-  }
-
-  [[nodiscard]] static auto computeSortKey(const DrawCmd &cmd) -> uint64_t {
-
-    enum class RenderOrder : uint8_t {
-      TerrainChunk = 0,
-      GrassBatch = 1,
-      StoneBatch = 2,
-      PlantBatch = 3,
-      PineBatch = 4,
-      FireCampBatch = 5,
-      Mesh = 6,
-      Cylinder = 7,
-      FogBatch = 8,
-      SelectionSmoke = 9,
-      Grid = 10,
-      SelectionRing = 15
-    };
-
-    static constexpr uint8_t kTypeOrder[] = {
-        static_cast<uint8_t>(RenderOrder::Grid),
-        static_cast<uint8_t>(RenderOrder::SelectionRing),
-        static_cast<uint8_t>(RenderOrder::SelectionSmoke),
-        static_cast<uint8_t>(RenderOrder::Cylinder),
-        static_cast<uint8_t>(RenderOrder::Mesh),
-        static_cast<uint8_t>(RenderOrder::FogBatch),
-        static_cast<uint8_t>(RenderOrder::GrassBatch),
-        static_cast<uint8_t>(RenderOrder::StoneBatch),
-        static_cast<uint8_t>(RenderOrder::PlantBatch),
-        static_cast<uint8_t>(RenderOrder::PineBatch),
-        static_cast<uint8_t>(RenderOrder::FireCampBatch),
-        static_cast<uint8_t>(RenderOrder::TerrainChunk)};
-
-    const std::size_t typeIndex = cmd.index();
-    constexpr std::size_t typeCount =
-        sizeof(kTypeOrder) / sizeof(kTypeOrder[0]);
-    const uint8_t typeOrder = typeIndex < typeCount
-                                  ? kTypeOrder[typeIndex]
-                                  : static_cast<uint8_t>(typeIndex);
-
-    uint64_t key = static_cast<uint64_t>(typeOrder) << 56;
-
-    if (cmd.index() == MeshCmdIndex) {
-      const auto &mesh = std::get<MeshCmdIndex>(cmd);
-
-      uint64_t const texPtr =
-          reinterpret_cast<uintptr_t>(mesh.texture) & 0x0000FFFFFFFFFFFF;
-      key |= texPtr;
-    } else if (cmd.index() == GrassBatchCmdIndex) {
-      const auto &grass = std::get<GrassBatchCmdIndex>(cmd);
-      uint64_t const bufferPtr =
-          reinterpret_cast<uintptr_t>(grass.instanceBuffer) &
-          0x0000FFFFFFFFFFFF;
-      key |= bufferPtr;
-    } else if (cmd.index() == StoneBatchCmdIndex) {
-      const auto &stone = std::get<StoneBatchCmdIndex>(cmd);
-      uint64_t const bufferPtr =
-          reinterpret_cast<uintptr_t>(stone.instanceBuffer) &
-          0x0000FFFFFFFFFFFF;
-      key |= bufferPtr;
-    } else if (cmd.index() == PlantBatchCmdIndex) {
-      const auto &plant = std::get<PlantBatchCmdIndex>(cmd);
-      uint64_t const bufferPtr =
-          reinterpret_cast<uintptr_t>(plant.instanceBuffer) &
-          0x0000FFFFFFFFFFFF;
-      key |= bufferPtr;
-    } else if (cmd.index() == PineBatchCmdIndex) {
-      const auto &pine = std::get<PineBatchCmdIndex>(cmd);
-      uint64_t const bufferPtr =
-          reinterpret_cast<uintptr_t>(pine.instanceBuffer) & 0x0000FFFFFFFFFFFF;
-      key |= bufferPtr;
-    } else if (cmd.index() == FireCampBatchCmdIndex) {
-      const auto &firecamp = std::get<FireCampBatchCmdIndex>(cmd);
-      uint64_t const bufferPtr =
-          reinterpret_cast<uintptr_t>(firecamp.instanceBuffer) &
-          0x0000FFFFFFFFFFFF;
-      key |= bufferPtr;
-    } else if (cmd.index() == TerrainChunkCmdIndex) {
-      const auto &terrain = std::get<TerrainChunkCmdIndex>(cmd);
-      auto const sortByte =
-          static_cast<uint64_t>((terrain.sortKey >> 8) & 0xFFU);
-      key |= sortByte << 48;
-      uint64_t const meshPtr =
-          reinterpret_cast<uintptr_t>(terrain.mesh) & 0x0000FFFFFFFFFFFFU;
-      key |= meshPtr;
+  // Packs the opaque/translucent pass into the top bit and folds the
+  // shader, texture and mesh pointers below it. Only grouping matters,
+  // not a global order, so 21 bits of each pointer past the alignment
+  // bits are plenty. Translucent commands carry the pass bit alone:
+  // they sort after every opaque command but keep submission order
+  // among themselves, which blending depends on.
+  [[nodiscard]] static auto meshStateKey(const MeshCmd &c) -> std::uint64_t {
+    if (c.alpha < 1.0F) {
+      return 1ULL << 63;
     }
-
+    constexpr std::uint64_t kPtrMask = 0x1FFFFFULL;
+    const auto shader =
+        static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(c.shader));
+    const auto texture =
+        static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(c.texture));
+    const auto mesh =
+        static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(c.mesh));
+    std::uint64_t key = ((shader >> 4) & kPtrMask) << 42;
+    key |= ((texture >> 4) & kPtrMask) << 21;
+    key |= (mesh >> 4) & kPtrMask;
     return key;
   }
 
-  std::vector<DrawCmd> m_items;
-  std::vector<uint32_t> m_sortIndices;
-  std::vector<uint64_t> m_sortKeys;
-  std::vector<uint32_t> m_tempIndices;
+  std::vector<MeshCmd> m_meshCmds;
+  std::vector<CylinderCmd> m_cylinderCmds;
+  std::vector<FogBatchCmd> m_fogBatchCmds;
+  std::vector<FogMaskCmd> m_fogMaskCmds;
+  std::vector<GrassBatchCmd> m_grassBatchCmds;
+  std::vector<StoneBatchCmd> m_stoneBatchCmds;
+  std::vector<PlantBatchCmd> m_plantBatchCmds;
+  std::vector<PineBatchCmd> m_pineBatchCmds;
+  std::vector<FireCampBatchCmd> m_fireCampBatchCmds;
+  std::vector<ParticleBatchCmd> m_particleBatchCmds;
+  std::vector<TerrainChunkCmd> m_terrainChunkCmds;
+  std::vector<GridCmd> m_gridCmds;
+  std::vector<SelectionRingCmd> m_selectionRingCmds;
+  std::vector<SelectionSmokeCmd> m_selectionSmokeCmds;
+  std::vector<HealthBarCmd> m_healthBarCmds;
 };
 
 } // namespace Render::GL
@@ -1,6 +1,4 @@
 #include "archer_renderer.h"
-#include "../../game/core/component.h"
-#include "../../game/core/entity.h"
 #include "../geom/math_utils.h"
 #include "../geom/transforms.h"
 #include "../gl/backend.h"
@@ -10,16 +8,18 @@
 #include "../humanoid_math.h"
 #include "../humanoid_specs.h"
 #include "../palette.h"
-#include "../scene_renderer.h"
 #include "../submitter.h"
+#include "../world_snapshot.h"
 #include "registry.h"
 #include "renderer_constants.h"
 
 #include <QMatrix4x4>
 #include <QString>
 #include <QVector3D>
+#include <array>
 #include <cmath>
 #include <cstdint>
+#include <mutex>
 #include <numbers>
 #include <qmatrix4x4.h>
 #include <qstringliteral.h>
@@ -54,13 +54,16 @@ public:
   }
 
 private:
+  // Guarded by the base class's m_cacheMutex: one renderer instance
+  // serves every archer and parallel submission draws from several
+  // worker threads at once.
   mutable std::unordered_map<uint32_t, ArcherExtras> m_extrasCache;
 
 public:
   void getVariant(const DrawContext &ctx, uint32_t seed,
                   HumanoidVariant &v) const override {
     QVector3D const team_tint = resolveTeamTint(ctx);
-    v.palette = makeHumanoidPalette(team_tint, seed);
+    v.palette = cachedHumanoidPalette(team_tint, seed);
   }
 
   void customizePose(const DrawContext &ctx, const AnimationInputs &anim,
@@ -234,33 +237,36 @@ public:
 
     QVector3D team_tint = resolveTeamTint(ctx);
     uint32_t seed = 0U;
-    if (ctx.entity != nullptr) {
-      auto *unit = ctx.entity->getComponent<Engine::Core::UnitComponent>();
-      if (unit != nullptr) {
-        seed ^= uint32_t(unit->owner_id * 2654435761U);
+    if (ctx.snap != nullptr) {
+      if (ctx.snap->hasUnit) {
+        seed ^= uint32_t(ctx.snap->ownerId * 2654435761U);
       }
-      seed ^= uint32_t(reinterpret_cast<uintptr_t>(ctx.entity) & 0xFFFFFFFFU);
+      seed ^= uint32_t(ctx.snap->id);
     }
 
     ArcherExtras extras;
-    auto it = m_extrasCache.find(seed);
-    if (it != m_extrasCache.end()) {
-      extras = it->second;
-    } else {
-      extras.metalHead = Render::Geom::clampVec01(v.palette.metal * 1.15F);
-      extras.stringCol = QVector3D(0.30F, 0.30F, 0.32F);
-      auto tint = [&](float k) {
-        return QVector3D(clamp01(team_tint.x() * k), clamp01(team_tint.y() * k),
-                         clamp01(team_tint.z() * k));
-      };
-      extras.fletch = tint(0.9F);
-      extras.bowTopY = HP::SHOULDER_Y + 0.55F;
-      extras.bowBotY = HP::WAIST_Y - 0.25F;
-
-      m_extrasCache[seed] = extras;
-
-      if (m_extrasCache.size() > MAX_EXTRAS_CACHE_SIZE) {
-        m_extrasCache.clear();
+    {
+      const std::lock_guard<std::mutex> lock(m_cacheMutex);
+      auto it = m_extrasCache.find(seed);
+      if (it != m_extrasCache.end()) {
+        extras = it->second;
+      } else {
+        extras.metalHead = Render::Geom::clampVec01(v.palette.metal * 1.15F);
+        extras.stringCol = QVector3D(0.30F, 0.30F, 0.32F);
+        auto tint = [&](float k) {
+          return QVector3D(clamp01(team_tint.x() * k),
+                           clamp01(team_tint.y() * k),
+                           clamp01(team_tint.z() * k));
+        };
+        extras.fletch = tint(0.9F);
+        extras.bowTopY = HP::SHOULDER_Y + 0.55F;
+        extras.bowBotY = HP::WAIST_Y - 0.25F;
+
+        m_extrasCache[seed] = extras;
+
+        if (m_extrasCache.size() > MAX_EXTRAS_CACHE_SIZE) {
+          m_extrasCache.clear();
+        }
       }
     }
 
@@ -447,26 +453,37 @@ public:
         v.palette.metal * QVector3D(1.2F, 1.0F, 0.65F);
     ring(QVector3D(0, waist_y + 0.02F, 0), belt_r * 1.02F, 0.010F, brass_color);
 
-    auto draw_pteruge = [&](float angle, float yStart, float length) {
+    auto draw_pteruge = [&](float sin_a, float cos_a, float yStart,
+                            float length) {
       float const rad = torso_r * 1.15F;
-      float const x = rad * std::sin(angle);
-      float const z = rad * std::cos(angle);
+      float const x = rad * sin_a;
+      float const z = rad * cos_a;
       QVector3D const top(x, yStart, z);
       QVector3D const bot(x * 0.95F, yStart - length, z * 0.95F);
       out.mesh(getUnitCylinder(), cylinderBetween(ctx.model, top, bot, 0.018F),
                leather_trim * 0.85F, nullptr, 1.0F);
     };
 
+    // Both strap rings evaluated as one SoA sin/cos batch.
+    std::array<float, 18> angles{};
+    std::array<float, 18> sin_v{};
+    std::array<float, 18> cos_v{};
+    for (int i = 0; i < 8; ++i) {
+      angles[i] = (i / 8.0F) * 2.0F * std::numbers::pi_v<float>;
+    }
+    for (int i = 0; i < 10; ++i) {
+      angles[8 + i] = (i / 10.0F) * 2.0F * std::numbers::pi_v<float>;
+    }
+    sinCosBatch(angles.data(), sin_v.data(), cos_v.data(), 18);
+
     float const shoulder_pteruge_y = y_top_cover - 0.02F;
     for (int i = 0; i < 8; ++i) {
-      float const angle = (i / 8.0F) * 2.0F * std::numbers::pi_v<float>;
-      draw_pteruge(angle, shoulder_pteruge_y, 0.14F);
+      draw_pteruge(sin_v[i], cos_v[i], shoulder_pteruge_y, 0.14F);
     }
 
     float const waist_pteruge_y = waist_y - 0.04F;
     for (int i = 0; i < 10; ++i) {
-      float const angle = (i / 10.0F) * 2.0F * std::numbers::pi_v<float>;
-      draw_pteruge(angle, waist_pteruge_y, 0.18F);
+      draw_pteruge(sin_v[8 + i], cos_v[8 + i], waist_pteruge_y, 0.18F);
     }
 
     QVector3D const collar_top(0, y_top_cover + 0.018F, 0);
@@ -632,16 +649,17 @@ void registerArcherRenderer(Render::GL::EntityRendererRegistry &registry) {
         static ArcherRenderer const static_renderer;
         Shader *archer_shader = nullptr;
         if (ctx.backend != nullptr) {
-          archer_shader = ctx.backend->shader(QStringLiteral("archer"));
+          // Resolved once; the handle table lookup avoids hashing the
+          // shader name for every visible entity.
+          static const ShaderHandle k_handle =
+              ctx.backend->shaderHandle(QStringLiteral("archer"));
+          archer_shader = ctx.backend->shader(k_handle);
         }
-        auto *scene_renderer = dynamic_cast<Renderer *>(&out);
-        if ((scene_renderer != nullptr) && (archer_shader != nullptr)) {
-          scene_renderer->setCurrentShader(archer_shader);
+        if (archer_shader != nullptr) {
+          out.setShader(archer_shader);
         }
         static_renderer.render(ctx, out);
-        if (scene_renderer != nullptr) {
-          scene_renderer->setCurrentShader(nullptr);
-        }
+        out.setShader(nullptr);
       });
 }
 
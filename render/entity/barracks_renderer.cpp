@@ -1,19 +1,22 @@
 #include "barracks_renderer.h"
-#include "../../game/core/component.h"
 #include "../../game/visuals/team_colors.h"
 #include "../geom/flag.h"
 #include "../geom/math_utils.h"
 #include "../geom/transforms.h"
 #include "../gl/primitives.h"
 #include "../gl/resources.h"
+#include "../world_snapshot.h"
 #include "registry.h"
 #include "submitter.h"
 
 #include <QMatrix4x4>
 #include <QVector3D>
 #include <algorithm>
+#include <mutex>
 #include <qmatrix4x4.h>
 #include <qvectornd.h>
+#include <unordered_map>
+#include <vector>
 
 namespace Render::GL {
 namespace {
@@ -551,25 +554,21 @@ inline void drawBannerAndPole(const DrawContext &p, ISubmitter &out, Mesh *unit,
   QVector3D team_trim_color = C.teamTrim;
   float flag_y = pole_height - target_height / 2.0F;
 
-  if (p.entity != nullptr) {
-    auto *capture = p.entity->getComponent<Engine::Core::CaptureComponent>();
-    if ((capture != nullptr) && capture->isBeingCaptured) {
-      float const progress = std::clamp(
-          capture->captureProgress / capture->requiredTime, 0.0F, 1.0F);
-
-      QVector3D const new_team_color =
-          Game::Visuals::team_colorForOwner(capture->capturing_player_id);
-      team_color = lerp(C.team, clampVec01(new_team_color), progress);
-      team_trim_color = lerp(C.teamTrim,
-                             clampVec01(QVector3D(new_team_color.x() * 0.6F,
-                                                  new_team_color.y() * 0.6F,
-                                                  new_team_color.z() * 0.6F)),
-                             progress);
-
-      float const lowered_amount = progress * pole_height * 0.85F;
-      flag_y -= lowered_amount;
-      beam_y -= lowered_amount;
-    }
+  if ((p.snap != nullptr) && p.snap->isBeingCaptured) {
+    float const progress = std::clamp(p.snap->captureProgress, 0.0F, 1.0F);
+
+    QVector3D const new_team_color =
+        Game::Visuals::team_colorForOwner(p.snap->capturingOwnerId);
+    team_color = lerp(C.team, clampVec01(new_team_color), progress);
+    team_trim_color = lerp(C.teamTrim,
+                           clampVec01(QVector3D(new_team_color.x() * 0.6F,
+                                                new_team_color.y() * 0.6F,
+                                                new_team_color.z() * 0.6F)),
+                           progress);
+
+    float const lowered_amount = progress * pole_height * 0.85F;
+    flag_y -= lowered_amount;
+    beam_y -= lowered_amount;
   }
 
   QVector3D const beam_start(pole_x + 0.02F, beam_y, pole_z);
@@ -599,61 +598,15 @@ inline void drawBannerAndPole(const DrawContext &p, ISubmitter &out, Mesh *unit,
 
 inline void drawRallyFlagIfAny(const DrawContext &p, ISubmitter &out,
                                Texture *white, const BarracksPalette &C) {
-  if (auto *prod =
-          p.entity->getComponent<Engine::Core::ProductionComponent>()) {
-    if (prod->rallySet && (p.resources != nullptr)) {
-      auto flag = Render::Geom::Flag::create(prod->rallyX, prod->rallyZ,
-                                             QVector3D(1.0F, 0.9F, 0.2F),
-                                             C.woodDark, 1.0F);
-      Mesh *unit = p.resources->unit();
-      out.mesh(unit, flag.pole, flag.poleColor, white, 1.0F);
-      out.mesh(unit, flag.pennant, flag.pennantColor, white, 1.0F);
-      out.mesh(unit, flag.finial, flag.pennantColor, white, 1.0F);
-    }
-  }
-}
-
-inline void drawHealthBar(const DrawContext &p, ISubmitter &out, Mesh *unit,
-                          Texture *white) {
-  if (p.entity == nullptr) {
-    return;
-  }
-  auto *u = p.entity->getComponent<Engine::Core::UnitComponent>();
-  if (u == nullptr) {
-    return;
-  }
-
-  int const mh = std::max(1, u->max_health);
-  float const ratio = std::clamp(u->health / float(mh), 0.0F, 1.0F);
-  if (ratio <= 0.0F) {
-    return;
+  if (p.snap->rallySet && (p.resources != nullptr)) {
+    auto flag = Render::Geom::Flag::create(p.snap->rallyX, p.snap->rallyZ,
+                                           QVector3D(1.0F, 0.9F, 0.2F),
+                                           C.woodDark, 1.0F);
+    Mesh *unit = p.resources->unit();
+    out.mesh(unit, flag.pole, flag.poleColor, white, 1.0F);
+    out.mesh(unit, flag.pennant, flag.pennantColor, white, 1.0F);
+    out.mesh(unit, flag.finial, flag.pennantColor, white, 1.0F);
   }
-
-  constexpr float base_height = BuildingProportions::base_height;
-  constexpr float roof_pitch = BuildingProportions::roof_pitch;
-  float const roof_peak = base_height + roof_pitch;
-  float const barY = roof_peak + 0.12F;
-
-  constexpr float bar_width = BuildingProportions::base_width * 0.9F;
-  constexpr float bar_height = 0.08F;
-  constexpr float bar_depth = 0.12F;
-
-  QVector3D const bg_color(0.06F, 0.06F, 0.06F);
-  unitBox(out, unit, white, p.model, QVector3D(0.0F, barY, 0.0F),
-          QVector3D(bar_width / 2.0F, bar_height / 2.0F, bar_depth / 2.0F),
-          bg_color);
-
-  float const fill_width = bar_width * ratio;
-  float const fill_x = -(bar_width - fill_width) * 0.5F;
-
-  QVector3D const red(0.85F, 0.15F, 0.15F);
-  QVector3D const green(0.22F, 0.78F, 0.22F);
-  QVector3D const fg_color = green * ratio + red * (1.0F - ratio);
-
-  unitBox(out, unit, white, p.model, QVector3D(fill_x, barY + 0.005F, 0.0F),
-          QVector3D(fill_width / 2.0F, (bar_height / 2.0F) * 0.9F,
-                    (bar_depth / 2.0F) * 0.95F),
-          fg_color);
 }
 
 inline void drawSelectionFX(const DrawContext &p, ISubmitter &out) {
@@ -668,35 +621,111 @@ inline void drawSelectionFX(const DrawContext &p, ISubmitter &out) {
   }
 }
 
-void drawBarracks(const DrawContext &p, ISubmitter &out) {
-  if ((p.resources == nullptr) || (p.entity == nullptr)) {
-    return;
+// Static-part bake cache. A barracks never moves once placed, so the
+// several hundred part transforms assembled above are computed once per
+// building and replayed on later frames; the bake is invalidated when the
+// model transform or team palette changes (placement, capture hand-off).
+// Dynamic parts — banner, rally flag, selection FX — stay immediate-mode;
+// the health bar comes from the instanced overlay pass. Command generation
+// runs on worker threads, so the cache
+// is guarded by a mutex; bakes are rare and replay holds it only while
+// re-submitting one building's parts.
+struct BakedPart {
+  Mesh *mesh = nullptr;
+  QMatrix4x4 model;
+  QVector3D color;
+  Texture *texture = nullptr;
+  float alpha = 1.0F;
+};
+
+struct StaticBatch {
+  QMatrix4x4 model;
+  QVector3D team;
+  std::vector<BakedPart> parts;
+};
+
+// Records mesh submissions during a bake pass. The static part drawers
+// only use the mesh channel; the others are never hit.
+class BakeSubmitter final : public ISubmitter {
+public:
+  explicit BakeSubmitter(std::vector<BakedPart> &parts) : m_parts(&parts) {}
+
+  void setShader(Shader * /*shader*/) override {}
+  void mesh(Mesh *mesh, const QMatrix4x4 &model, const QVector3D &color,
+            Texture *tex, float alpha) override {
+    m_parts->push_back({mesh, model, color, tex, alpha});
+  }
+  void cylinder(const QVector3D & /*start*/, const QVector3D & /*end*/,
+                float /*radius*/, const QVector3D & /*color*/,
+                float /*alpha*/) override {}
+  void selectionRing(const QMatrix4x4 & /*model*/, float /*alphaInner*/,
+                     float /*alphaOuter*/, const QVector3D & /*color*/
+                     ) override {}
+  void grid(const QMatrix4x4 & /*model*/, const QVector3D & /*color*/,
+            float /*cellSize*/, float /*thickness*/,
+            float /*extent*/) override {}
+  void selectionSmoke(const QMatrix4x4 & /*model*/, const QVector3D & /*color*/,
+                      float /*baseAlpha*/) override {}
+  void healthBar(const QVector3D & /*anchor*/, float /*width*/,
+                 const QVector3D & /*color*/, float /*fill*/) override {}
+
+private:
+  std::vector<BakedPart> *m_parts;
+};
+
+constexpr std::size_t k_maxStaticBatches = 256;
+
+std::mutex g_staticBatchMutex;
+std::unordered_map<Engine::Core::EntityID, StaticBatch> g_staticBatches;
+
+void drawStaticParts(const DrawContext &p, ISubmitter &out, Mesh *unit,
+                     Texture *white, const QVector3D &team,
+                     const BarracksPalette &C) {
+  std::lock_guard<std::mutex> const lock(g_staticBatchMutex);
+
+  // Drop the cache outright once it clearly outgrows the live building
+  // set; survivors re-bake on their next draw.
+  if (g_staticBatches.size() > k_maxStaticBatches) {
+    g_staticBatches.clear();
+  }
+
+  auto [it, inserted] = g_staticBatches.try_emplace(p.snap->id);
+  StaticBatch &batch = it->second;
+  if (inserted || batch.model != p.model || batch.team != team) {
+    batch.model = p.model;
+    batch.team = team;
+    batch.parts.clear();
+    BakeSubmitter bake(batch.parts);
+    drawFoundation(p, bake, unit, white, C);
+    drawAnnex(p, bake, unit, white, C);
+    drawWalls(p, bake, unit, white, C);
+    ChimneyInfo const ch = drawChimney(p, bake, unit, white, C);
+    drawRoofs(p, bake, unit, white, C, ch);
+    drawDoor(p, bake, unit, white, C);
+    drawWindows(p, bake, unit, white, C);
+    drawProps(p, bake, unit, white, C);
   }
 
-  auto *t = p.entity->getComponent<Engine::Core::TransformComponent>();
-  auto *r = p.entity->getComponent<Engine::Core::RenderableComponent>();
-  if ((t == nullptr) || (r == nullptr)) {
+  for (const auto &part : batch.parts) {
+    out.mesh(part.mesh, part.model, part.color, part.texture, part.alpha);
+  }
+}
+
+void drawBarracks(const DrawContext &p, ISubmitter &out) {
+  if ((p.resources == nullptr) || (p.snap == nullptr)) {
     return;
   }
 
   Mesh *unit = p.resources->unit();
   Texture *white = p.resources->white();
 
-  QVector3D const team(r->color[0], r->color[1], r->color[2]);
+  QVector3D const team = p.snap->color;
   BarracksPalette const C = makePalette(team);
 
-  drawFoundation(p, out, unit, white, C);
-  drawAnnex(p, out, unit, white, C);
-  drawWalls(p, out, unit, white, C);
-  ChimneyInfo const ch = drawChimney(p, out, unit, white, C);
-  drawRoofs(p, out, unit, white, C, ch);
-  drawDoor(p, out, unit, white, C);
-  drawWindows(p, out, unit, white, C);
+  drawStaticParts(p, out, unit, white, team, C);
   drawBannerAndPole(p, out, unit, white, C);
-  drawProps(p, out, unit, white, C);
 
   drawRallyFlagIfAny(p, out, white, C);
-  drawHealthBar(p, out, unit, white);
   drawSelectionFX(p, out);
 }
 
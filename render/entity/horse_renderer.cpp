@@ -23,6 +23,7 @@ using Render::Geom::coneFromTo;
 using Render::Geom::cylinderBetween;
 using Render::Geom::lerp;
 using Render::Geom::smoothstep;
+using Render::Geom::translateScale;
 
 namespace {
 
@@ -80,10 +81,7 @@ inline auto lerp3(const QVector3D &a, const QVector3D &b,
 
 inline auto scaledSphere(const QMatrix4x4 &model, const QVector3D &center,
                          const QVector3D &scale) -> QMatrix4x4 {
-  QMatrix4x4 m = model;
-  m.translate(center);
-  m.scale(scale);
-  return m;
+  return translateScale(model, center, scale);
 }
 
 inline void drawCylinder(ISubmitter &out, const QMatrix4x4 &model,
@@ -267,31 +265,32 @@ void HorseRenderer::render(const DrawContext &ctx, const AnimationInputs &anim,
       QVector3D(0.0F, -d.bodyHeight * 0.35F, -d.bodyLength * 0.05F);
 
   {
-    QMatrix4x4 chest = ctx.model;
-    chest.translate(chest_center);
-    chest.scale(d.bodyWidth * 1.12F, d.bodyHeight * 0.95F,
-                d.bodyLength * 0.36F);
+    QMatrix4x4 const chest =
+        translateScale(ctx.model, chest_center,
+            QVector3D(d.bodyWidth * 1.12F, d.bodyHeight * 0.95F,
+                      d.bodyLength * 0.36F));
     QVector3D const chest_color =
         coatGradient(v.coatColor, 0.75F, 0.20F, coat_seed_a);
     out.mesh(getUnitSphere(), chest, chest_color, nullptr, 1.0F);
   }
 
   {
-    QMatrix4x4 withers = ctx.model;
-    withers.translate(chest_center + QVector3D(0.0F, d.bodyHeight * 0.55F,
-                                               -d.bodyLength * 0.03F));
-    withers.scale(d.bodyWidth * 0.75F, d.bodyHeight * 0.35F,
-                  d.bodyLength * 0.18F);
+    QMatrix4x4 const withers =
+        translateScale(ctx.model,
+            chest_center + QVector3D(0.0F, d.bodyHeight * 0.55F,
+                                     -d.bodyLength * 0.03F),
+            QVector3D(d.bodyWidth * 0.75F, d.bodyHeight * 0.35F,
+                      d.bodyLength * 0.18F));
     QVector3D const wither_color =
         coatGradient(v.coatColor, 0.88F, 0.35F, coat_seed_b);
     out.mesh(getUnitSphere(), withers, wither_color, nullptr, 1.0F);
   }
 
   {
-    QMatrix4x4 belly = ctx.model;
-    belly.translate(belly_center);
-    belly.scale(d.bodyWidth * 0.98F, d.bodyHeight * 0.64F,
-                d.bodyLength * 0.40F);
+    QMatrix4x4 const belly =
+        translateScale(ctx.model, belly_center,
+            QVector3D(d.bodyWidth * 0.98F, d.bodyHeight * 0.64F,
+                      d.bodyLength * 0.40F));
     QVector3D const belly_color =
         coatGradient(v.coatColor, 0.25F, -0.10F, coat_seed_c);
     out.mesh(getUnitSphere(), belly, belly_color, nullptr, 1.0F);
@@ -299,20 +298,23 @@ void HorseRenderer::render(const DrawContext &ctx, const AnimationInputs &anim,
 
   for (int i = 0; i < 2; ++i) {
     float const side = (i == 0) ? 1.0F : -1.0F;
-    QMatrix4x4 ribs = ctx.model;
-    ribs.translate(barrel_center + QVector3D(side * d.bodyWidth * 0.90F,
-                                             -d.bodyHeight * 0.10F,
-                                             -d.bodyLength * 0.05F));
-    ribs.scale(d.bodyWidth * 0.38F, d.bodyHeight * 0.42F, d.bodyLength * 0.30F);
+    QMatrix4x4 const ribs =
+        translateScale(ctx.model,
+            barrel_center + QVector3D(side * d.bodyWidth * 0.90F,
+                                      -d.bodyHeight * 0.10F,
+                                      -d.bodyLength * 0.05F),
+            QVector3D(d.bodyWidth * 0.38F, d.bodyHeight * 0.42F,
+                      d.bodyLength * 0.30F));
     QVector3D const rib_color =
         coatGradient(v.coatColor, 0.45F, 0.05F, coat_seed_d + side * 0.05F);
     out.mesh(getUnitSphere(), ribs, rib_color, nullptr, 1.0F);
   }
 
   {
-    QMatrix4x4 rump = ctx.model;
-    rump.translate(rump_center);
-    rump.scale(d.bodyWidth * 1.18F, d.bodyHeight * 1.00F, d.bodyLength * 0.36F);
+    QMatrix4x4 const rump =
+        translateScale(ctx.model, rump_center,
+            QVector3D(d.bodyWidth * 1.18F, d.bodyHeight * 1.00F,
+                      d.bodyLength * 0.36F));
     QVector3D const rump_color =
         coatGradient(v.coatColor, 0.62F, -0.28F, coat_seed_a * 0.7F);
     out.mesh(getUnitSphere(), rump, rump_color, nullptr, 1.0F);
@@ -320,21 +322,24 @@ void HorseRenderer::render(const DrawContext &ctx, const AnimationInputs &anim,
 
   for (int i = 0; i < 2; ++i) {
     float const side = (i == 0) ? 1.0F : -1.0F;
-    QMatrix4x4 hip = ctx.model;
-    hip.translate(rump_center + QVector3D(side * d.bodyWidth * 0.95F,
-                                          -d.bodyHeight * 0.10F,
-                                          -d.bodyLength * 0.08F));
-    hip.scale(d.bodyWidth * 0.45F, d.bodyHeight * 0.42F, d.bodyLength * 0.26F);
+    QMatrix4x4 const hip =
+        translateScale(ctx.model,
+            rump_center + QVector3D(side * d.bodyWidth * 0.95F,
+                                    -d.bodyHeight * 0.10F,
+                                    -d.bodyLength * 0.08F),
+            QVector3D(d.bodyWidth * 0.45F, d.bodyHeight * 0.42F,
+                      d.bodyLength * 0.26F));
     QVector3D const hip_color =
         coatGradient(v.coatColor, 0.58F, -0.18F, coat_seed_b + side * 0.06F);
     out.mesh(getUnitSphere(), hip, hip_color, nullptr, 1.0F);
 
-    QMatrix4x4 haunch = ctx.model;
-    haunch.translate(rump_center + QVector3D(side * d.bodyWidth * 0.88F,
-                                             d.bodyHeight * 0.24F,
-                                             -d.bodyLength * 0.20F));
-    haunch.scale(QVector3D(d.bodyWidth * 0.32F, d.bodyHeight * 0.28F,
-                           d.bodyLength * 0.18F));
+    QMatrix4x4 const haunch =
+        translateScale(ctx.model,
+            rump_center + QVector3D(side * d.bodyWidth * 0.88F,
+                                    d.bodyHeight * 0.24F,
+                                    -d.bodyLength * 0.20F),
+            QVector3D(d.bodyWidth * 0.32F, d.bodyHeight * 0.28F,
+                      d.bodyLength * 0.18F));
     QVector3D const haunch_color =
         coatGradient(v.coatColor, 0.72F, -0.26F, coat_seed_c + side * 0.04F);
     out.mesh(getUnitSphere(), haunch, lighten(haunch_color, 1.02F), nullptr,
@@ -347,10 +352,10 @@ void HorseRenderer::render(const DrawContext &ctx, const AnimationInputs &anim,
                                                  -d.bodyLength * 0.18F);
 
   {
-    QMatrix4x4 spine = ctx.model;
-    spine.translate(lerp(withers_peak, croup_peak, 0.42F));
-    spine.scale(QVector3D(d.bodyWidth * 0.50F, d.bodyHeight * 0.14F,
-                          d.bodyLength * 0.54F));
+    QMatrix4x4 const spine =
+        translateScale(ctx.model, lerp(withers_peak, croup_peak, 0.42F),
+            QVector3D(d.bodyWidth * 0.50F, d.bodyHeight * 0.14F,
+                      d.bodyLength * 0.54F));
     QVector3D const spine_color =
         coatGradient(v.coatColor, 0.74F, -0.06F, coat_seed_d * 0.92F);
     out.mesh(getUnitSphere(), spine, spine_color, nullptr, 1.0F);
@@ -369,11 +374,12 @@ void HorseRenderer::render(const DrawContext &ctx, const AnimationInputs &anim,
         out, ctx.model, scapula_top, scapula_mid, d.bodyWidth * 0.18F,
         coatGradient(v.coatColor, 0.82F, 0.16F, coat_seed_a + side * 0.05F));
 
-    QMatrix4x4 shoulder_cap = ctx.model;
-    shoulder_cap.translate(scapula_base + QVector3D(0.0F, d.bodyHeight * 0.04F,
-                                                    d.bodyLength * 0.02F));
-    shoulder_cap.scale(QVector3D(d.bodyWidth * 0.32F, d.bodyHeight * 0.24F,
-                                 d.bodyLength * 0.18F));
+    QMatrix4x4 const shoulder_cap =
+        translateScale(ctx.model,
+            scapula_base + QVector3D(0.0F, d.bodyHeight * 0.04F,
+                                     d.bodyLength * 0.02F),
+            QVector3D(d.bodyWidth * 0.32F, d.bodyHeight * 0.24F,
+                      d.bodyLength * 0.18F));
     out.mesh(
         getUnitSphere(), shoulder_cap,
         coatGradient(v.coatColor, 0.66F, 0.12F, coat_seed_b + side * 0.07F),
@@ -381,11 +387,12 @@ void HorseRenderer::render(const DrawContext &ctx, const AnimationInputs &anim,
   }
 
   {
-    QMatrix4x4 sternum = ctx.model;
-    sternum.translate(barrel_center + QVector3D(0.0F, -d.bodyHeight * 0.40F,
-                                                d.bodyLength * 0.28F));
-    sternum.scale(QVector3D(d.bodyWidth * 0.50F, d.bodyHeight * 0.14F,
-                            d.bodyLength * 0.12F));
+    QMatrix4x4 const sternum =
+        translateScale(ctx.model,
+            barrel_center + QVector3D(0.0F, -d.bodyHeight * 0.40F,
+                                      d.bodyLength * 0.28F),
+            QVector3D(d.bodyWidth * 0.50F, d.bodyHeight * 0.14F,
+                      d.bodyLength * 0.12F));
     out.mesh(getUnitSphere(), sternum,
              coatGradient(v.coatColor, 0.18F, 0.18F, coat_seed_a * 0.4F),
              nullptr, 1.0F);
@@ -442,11 +449,12 @@ void HorseRenderer::render(const DrawContext &ctx, const AnimationInputs &anim,
                            d.headLength * 0.40F);
 
   {
-    QMatrix4x4 skull = ctx.model;
-    skull.translate(head_center + QVector3D(0.0F, d.headHeight * 0.10F,
-                                            -d.headLength * 0.10F));
-    skull.scale(d.headWidth * 0.95F, d.headHeight * 0.90F,
-                d.headLength * 0.80F);
+    QMatrix4x4 const skull =
+        translateScale(ctx.model,
+            head_center + QVector3D(0.0F, d.headHeight * 0.10F,
+                                    -d.headLength * 0.10F),
+            QVector3D(d.headWidth * 0.95F, d.headHeight * 0.90F,
+                      d.headLength * 0.80F));
     QVector3D const skull_color =
         coatGradient(v.coatColor, 0.82F, 0.30F, coat_seed_d * 0.8F);
     out.mesh(getUnitSphere(), skull, skull_color, nullptr, 1.0F);
@@ -454,11 +462,12 @@ void HorseRenderer::render(const DrawContext &ctx, const AnimationInputs &anim,
 
   for (int i = 0; i < 2; ++i) {
     float const side = (i == 0) ? 1.0F : -1.0F;
-    QMatrix4x4 cheek = ctx.model;
-    cheek.translate(head_center + QVector3D(side * d.headWidth * 0.55F,
-                                            -d.headHeight * 0.15F, 0.0F));
-    cheek.scale(d.headWidth * 0.45F, d.headHeight * 0.50F,
-                d.headLength * 0.60F);
+    QMatrix4x4 const cheek =
+        translateScale(ctx.model,
+            head_center + QVector3D(side * d.headWidth * 0.55F,
+                                    -d.headHeight * 0.15F, 0.0F),
+            QVector3D(d.headWidth * 0.45F, d.headHeight * 0.50F,
+                      d.headLength * 0.60F));
     QVector3D const cheek_color =
         coatGradient(v.coatColor, 0.70F, 0.18F, coat_seed_a * 0.9F);
     out.mesh(getUnitSphere(), cheek, cheek_color, nullptr, 1.0F);
@@ -468,11 +477,11 @@ void HorseRenderer::render(const DrawContext &ctx, const AnimationInputs &anim,
       head_center +
       QVector3D(0.0F, -d.headHeight * 0.18F, d.headLength * 0.58F);
   {
-    QMatrix4x4 muzzle = ctx.model;
-    muzzle.translate(muzzle_center +
-                     QVector3D(0.0F, -d.headHeight * 0.05F, 0.0F));
-    muzzle.scale(d.headWidth * 0.68F, d.headHeight * 0.60F,
-                 d.muzzleLength * 1.05F);
+    QMatrix4x4 const muzzle =
+        translateScale(ctx.model,
+            muzzle_center + QVector3D(0.0F, -d.headHeight * 0.05F, 0.0F),
+            QVector3D(d.headWidth * 0.68F, d.headHeight * 0.60F,
+                      d.muzzleLength * 1.05F));
     out.mesh(getUnitSphere(), muzzle, v.muzzleColor, nullptr, 1.0F);
   }
 
@@ -535,25 +544,26 @@ void HorseRenderer::render(const DrawContext &ctx, const AnimationInputs &anim,
 
   auto draw_eye = [&](const QVector3D &pos) {
     {
-      QMatrix4x4 eye = ctx.model;
-      eye.translate(pos);
-      eye.scale(d.headWidth * 0.14F);
+      QMatrix4x4 const eye =
+          translateScale(ctx.model, pos, d.headWidth * 0.14F);
       out.mesh(getUnitSphere(), eye, eye_base_color, nullptr, 1.0F);
     }
     {
 
-      QMatrix4x4 pupil = ctx.model;
-      pupil.translate(pos + QVector3D(0.0F, 0.0F, d.headWidth * 0.04F));
-      pupil.scale(d.headWidth * 0.05F);
+      QMatrix4x4 const pupil =
+          translateScale(ctx.model,
+              pos + QVector3D(0.0F, 0.0F, d.headWidth * 0.04F),
+              d.headWidth * 0.05F);
       out.mesh(getUnitSphere(), pupil, QVector3D(0.03F, 0.03F, 0.03F), nullptr,
                1.0F);
     }
     {
 
-      QMatrix4x4 spec = ctx.model;
-      spec.translate(pos + QVector3D(d.headWidth * 0.03F, d.headWidth * 0.03F,
-                                     d.headWidth * 0.03F));
-      spec.scale(d.headWidth * 0.02F);
+      QMatrix4x4 const spec =
+          translateScale(ctx.model,
+              pos + QVector3D(d.headWidth * 0.03F, d.headWidth * 0.03F,
+                              d.headWidth * 0.03F),
+              d.headWidth * 0.02F);
       out.mesh(getUnitSphere(), spec, QVector3D(0.95F, 0.95F, 0.95F), nullptr,
                1.0F);
     }
@@ -562,11 +572,12 @@ void HorseRenderer::render(const DrawContext &ctx, const AnimationInputs &anim,
   draw_eye(eye_right);
 
   if (has_blaze) {
-    QMatrix4x4 blaze = ctx.model;
-    blaze.translate(head_center + QVector3D(0.0F, d.headHeight * 0.15F,
-                                            d.headLength * 0.10F));
-    blaze.scale(d.headWidth * 0.22F, d.headHeight * 0.32F,
-                d.headLength * 0.10F);
+    QMatrix4x4 const blaze =
+        translateScale(ctx.model,
+            head_center + QVector3D(0.0F, d.headHeight * 0.15F,
+                                    d.headLength * 0.10F),
+            QVector3D(d.headWidth * 0.22F, d.headHeight * 0.32F,
+                      d.headLength * 0.10F));
     out.mesh(getUnitSphere(), blaze, QVector3D(0.92F, 0.92F, 0.90F), nullptr,
              1.0F);
   }
@@ -647,11 +658,12 @@ void HorseRenderer::render(const DrawContext &ctx, const AnimationInputs &anim,
   }
 
   {
-    QMatrix4x4 tail_knot = ctx.model;
-    tail_knot.translate(tail_base + QVector3D(0.0F, -d.bodyHeight * 0.06F,
-                                              -d.bodyLength * 0.02F));
-    tail_knot.scale(QVector3D(d.bodyWidth * 0.24F, d.bodyWidth * 0.18F,
-                              d.bodyWidth * 0.20F));
+    QMatrix4x4 const tail_knot =
+        translateScale(ctx.model,
+            tail_base + QVector3D(0.0F, -d.bodyHeight * 0.06F,
+                                  -d.bodyLength * 0.02F),
+            QVector3D(d.bodyWidth * 0.24F, d.bodyWidth * 0.18F,
+                      d.bodyWidth * 0.20F));
     out.mesh(getUnitSphere(), tail_knot, lighten(tail_color, 0.92F), nullptr,
              1.0F);
   }
@@ -682,17 +694,18 @@ void HorseRenderer::render(const DrawContext &ctx, const AnimationInputs &anim,
              coneFromTo(ctx.model, toe, hoof_bottom, wallRadius * 0.90F),
              wall_tint * 0.96F, nullptr, 1.0F);
 
-    QMatrix4x4 sole = ctx.model;
-    sole.translate(lerp(hoof_top, hoof_bottom, 0.88F) +
-                   QVector3D(0.0F, -d.hoofHeight * 0.05F, 0.0F));
-    sole.scale(
-        QVector3D(wallRadius * 1.08F, wallRadius * 0.28F, wallRadius * 1.02F));
+    QMatrix4x4 const sole =
+        translateScale(ctx.model,
+            lerp(hoof_top, hoof_bottom, 0.88F) +
+                QVector3D(0.0F, -d.hoofHeight * 0.05F, 0.0F),
+            QVector3D(wallRadius * 1.08F, wallRadius * 0.28F,
+                      wallRadius * 1.02F));
     out.mesh(getUnitSphere(), sole, lighten(hoof_color, 1.12F), nullptr, 1.0F);
 
-    QMatrix4x4 coronet = ctx.model;
-    coronet.translate(lerp(hoof_top, hoof_bottom, 0.12F));
-    coronet.scale(
-        QVector3D(wallRadius * 1.05F, wallRadius * 0.24F, wallRadius * 1.05F));
+    QMatrix4x4 const coronet =
+        translateScale(ctx.model, lerp(hoof_top, hoof_bottom, 0.12F),
+            QVector3D(wallRadius * 1.05F, wallRadius * 0.24F,
+                      wallRadius * 1.05F));
     out.mesh(getUnitSphere(), coronet, lighten(hoof_color, 1.06F), nullptr,
              1.0F);
   };
@@ -765,12 +778,14 @@ void HorseRenderer::render(const DrawContext &ctx, const AnimationInputs &anim,
                               is_rear ? -0.20F : 0.22F,
                               coat_seed_b + lateralSign * 0.03F));
 
-    QMatrix4x4 socket_cap = ctx.model;
-    socket_cap.translate(socket + QVector3D(0.0F, -d.bodyWidth * 0.04F,
-                                            is_rear ? -d.bodyLength * 0.02F
-                                                    : d.bodyLength * 0.03F));
-    socket_cap.scale(QVector3D(d.bodyWidth * (is_rear ? 0.36F : 0.32F),
-                               d.bodyWidth * 0.28F, d.bodyLength * 0.18F));
+    QMatrix4x4 const socket_cap =
+        translateScale(ctx.model,
+            socket +
+                QVector3D(0.0F, -d.bodyWidth * 0.04F,
+                          is_rear ? -d.bodyLength * 0.02F
+                                  : d.bodyLength * 0.03F),
+            QVector3D(d.bodyWidth * (is_rear ? 0.36F : 0.32F),
+                      d.bodyWidth * 0.28F, d.bodyLength * 0.18F));
     out.mesh(getUnitSphere(), socket_cap,
              coatGradient(v.coatColor, is_rear ? 0.60F : 0.68F,
                           is_rear ? -0.24F : 0.18F,
@@ -824,10 +839,10 @@ void HorseRenderer::render(const DrawContext &ctx, const AnimationInputs &anim,
              thigh_color, nullptr, 1.0F);
 
     {
-      QMatrix4x4 muscle = ctx.model;
-      muscle.translate(thigh_belly +
-                       QVector3D(0.0F, 0.0F, is_rear ? -0.015F : 0.020F));
-      muscle.scale(thigh_belly_r * QVector3D(1.05F, 0.85F, 0.92F));
+      QMatrix4x4 const muscle =
+          translateScale(ctx.model,
+              thigh_belly + QVector3D(0.0F, 0.0F, is_rear ? -0.015F : 0.020F),
+              thigh_belly_r * QVector3D(1.05F, 0.85F, 0.92F));
       out.mesh(getUnitSphere(), muscle, lighten(thigh_color, 1.03F), nullptr,
                1.0F);
     }
@@ -849,22 +864,21 @@ void HorseRenderer::render(const DrawContext &ctx, const AnimationInputs &anim,
              darken(thigh_color, 0.93F), nullptr, 1.0F);
 
     {
-      QMatrix4x4 tendon = ctx.model;
-      tendon.translate(
-          lerp(knee, cannon, 0.55F) +
-          QVector3D(0.0F, 0.0F,
-                    is_rear ? -cannon_r * 0.35F : cannon_r * 0.35F));
-      tendon.scale(
-          QVector3D(cannon_r * 0.45F, cannon_r * 0.95F, cannon_r * 0.55F));
+      QMatrix4x4 const tendon =
+          translateScale(ctx.model,
+              lerp(knee, cannon, 0.55F) +
+                  QVector3D(0.0F, 0.0F,
+                            is_rear ? -cannon_r * 0.35F : cannon_r * 0.35F),
+              QVector3D(cannon_r * 0.45F, cannon_r * 0.95F, cannon_r * 0.55F));
       out.mesh(getUnitSphere(), tendon,
                darken(thigh_color, is_rear ? 0.88F : 0.90F), nullptr, 1.0F);
     }
 
     {
-      QMatrix4x4 joint = ctx.model;
-      joint.translate(fetlock);
-      joint.scale(
-          QVector3D(pastern_r * 1.12F, pastern_r * 1.05F, pastern_r * 1.26F));
+      QMatrix4x4 const joint =
+          translateScale(ctx.model, fetlock,
+              QVector3D(pastern_r * 1.12F, pastern_r * 1.05F,
+                        pastern_r * 1.26F));
       out.mesh(getUnitSphere(), joint, darken(thigh_color, 0.92F), nullptr,
                1.0F);
     }
@@ -911,51 +925,54 @@ void HorseRenderer::render(const DrawContext &ctx, const AnimationInputs &anim,
   QVector3D saddle_center(0.0F, saddle_top - d.saddleThickness * 0.35F,
                           -d.bodyLength * 0.05F + d.seatForwardOffset * 0.25F);
   {
-    QMatrix4x4 saddle = ctx.model;
-    saddle.translate(saddle_center);
-    saddle.scale(d.bodyWidth * 1.10F, d.saddleThickness * 1.05F,
-                 d.bodyLength * 0.34F);
+    QMatrix4x4 const saddle =
+        translateScale(ctx.model, saddle_center,
+            QVector3D(d.bodyWidth * 1.10F, d.saddleThickness * 1.05F,
+                      d.bodyLength * 0.34F));
     out.mesh(getUnitSphere(), saddle, v.saddleColor, nullptr, 1.0F);
   }
 
   QVector3D const blanket_center =
       saddle_center + QVector3D(0.0F, -d.saddleThickness, 0.0F);
   {
-    QMatrix4x4 blanket = ctx.model;
-    blanket.translate(blanket_center);
-    blanket.scale(d.bodyWidth * 1.26F, d.saddleThickness * 0.38F,
-                  d.bodyLength * 0.42F);
+    QMatrix4x4 const blanket =
+        translateScale(ctx.model, blanket_center,
+            QVector3D(d.bodyWidth * 1.26F, d.saddleThickness * 0.38F,
+                      d.bodyLength * 0.42F));
     out.mesh(getUnitSphere(), blanket, v.blanketColor * 1.02F, nullptr, 1.0F);
   }
 
   {
-    QMatrix4x4 cantle = ctx.model;
-    cantle.translate(saddle_center + QVector3D(0.0F, d.saddleThickness * 0.72F,
-                                               -d.bodyLength * 0.12F));
-    cantle.scale(QVector3D(d.bodyWidth * 0.52F, d.saddleThickness * 0.60F,
-                           d.bodyLength * 0.18F));
+    QMatrix4x4 const cantle =
+        translateScale(ctx.model,
+            saddle_center + QVector3D(0.0F, d.saddleThickness * 0.72F,
+                                      -d.bodyLength * 0.12F),
+            QVector3D(d.bodyWidth * 0.52F, d.saddleThickness * 0.60F,
+                      d.bodyLength * 0.18F));
     out.mesh(getUnitSphere(), cantle, lighten(v.saddleColor, 1.05F), nullptr,
              1.0F);
   }
 
   {
-    QMatrix4x4 pommel = ctx.model;
-    pommel.translate(saddle_center + QVector3D(0.0F, d.saddleThickness * 0.58F,
-                                               d.bodyLength * 0.16F));
-    pommel.scale(QVector3D(d.bodyWidth * 0.40F, d.saddleThickness * 0.48F,
-                           d.bodyLength * 0.14F));
+    QMatrix4x4 const pommel =
+        translateScale(ctx.model,
+            saddle_center + QVector3D(0.0F, d.saddleThickness * 0.58F,
+                                      d.bodyLength * 0.16F),
+            QVector3D(d.bodyWidth * 0.40F, d.saddleThickness * 0.48F,
+                      d.bodyLength * 0.14F));
     out.mesh(getUnitSphere(), pommel, darken(v.saddleColor, 0.92F), nullptr,
              1.0F);
   }
 
   for (int i = 0; i < 6; ++i) {
     float const t = static_cast<float>(i) / 5.0F;
-    QMatrix4x4 stitch = ctx.model;
-    stitch.translate(blanket_center + QVector3D(d.bodyWidth * (t - 0.5F) * 1.1F,
-                                                -d.saddleThickness * 0.35F,
-                                                d.bodyLength * 0.28F));
-    stitch.scale(QVector3D(d.bodyWidth * 0.05F, d.bodyWidth * 0.02F,
-                           d.bodyWidth * 0.12F));
+    QMatrix4x4 const stitch =
+        translateScale(ctx.model,
+            blanket_center + QVector3D(d.bodyWidth * (t - 0.5F) * 1.1F,
+                                       -d.saddleThickness * 0.35F,
+                                       d.bodyLength * 0.28F),
+            QVector3D(d.bodyWidth * 0.05F, d.bodyWidth * 0.02F,
+                      d.bodyWidth * 0.12F));
     out.mesh(getUnitSphere(), stitch, v.blanketColor * 0.75F, nullptr, 0.9F);
   }
 
@@ -973,11 +990,12 @@ void HorseRenderer::render(const DrawContext &ctx, const AnimationInputs &anim,
                              d.bodyWidth * 0.065F),
              v.tack_color * 0.94F, nullptr, 1.0F);
 
-    QMatrix4x4 buckle = ctx.model;
-    buckle.translate(lerp(strap_top, strap_bottom, 0.87F) +
-                     QVector3D(0.0F, 0.0F, -d.bodyLength * 0.02F));
-    buckle.scale(QVector3D(d.bodyWidth * 0.16F, d.bodyWidth * 0.12F,
-                           d.bodyWidth * 0.05F));
+    QMatrix4x4 const buckle =
+        translateScale(ctx.model,
+            lerp(strap_top, strap_bottom, 0.87F) +
+                QVector3D(0.0F, 0.0F, -d.bodyLength * 0.02F),
+            QVector3D(d.bodyWidth * 0.16F, d.bodyWidth * 0.12F,
+                      d.bodyWidth * 0.05F));
     out.mesh(getUnitSphere(), buckle, QVector3D(0.42F, 0.39F, 0.35F), nullptr,
              1.0F);
   }
@@ -1029,10 +1047,10 @@ void HorseRenderer::render(const DrawContext &ctx, const AnimationInputs &anim,
     QVector3D const neck_base =
         torso_top + QVector3D(0.0F, d.bodyHeight * 0.10F, 0.02F);
 
-    QMatrix4x4 pelvis = ctx.model;
-    pelvis.translate(pelvis_center);
-    pelvis.scale(QVector3D(d.bodyWidth * 0.52F, d.bodyWidth * 0.34F,
-                           d.bodyWidth * 0.48F));
+    QMatrix4x4 const pelvis =
+        translateScale(ctx.model, pelvis_center,
+            QVector3D(d.bodyWidth * 0.52F, d.bodyWidth * 0.34F,
+                      d.bodyWidth * 0.48F));
     out.mesh(getUnitSphere(), pelvis, rider_coat * 0.92F, nullptr, 1.0F);
 
     drawCylinder(out, ctx.model, pelvis_center, spine_mid, d.bodyWidth * 0.36F,
@@ -1041,21 +1059,22 @@ void HorseRenderer::render(const DrawContext &ctx, const AnimationInputs &anim,
                  rider_coat * 0.98F);
 
     {
-      QMatrix4x4 chest = ctx.model;
-      chest.translate(spine_mid + QVector3D(0.0F, d.bodyHeight * 0.20F, 0.0F));
-      chest.scale(QVector3D(d.bodyWidth * 0.60F, d.bodyWidth * 0.46F,
-                            d.bodyWidth * 0.32F));
+      QMatrix4x4 const chest =
+          translateScale(ctx.model,
+              spine_mid + QVector3D(0.0F, d.bodyHeight * 0.20F, 0.0F),
+              QVector3D(d.bodyWidth * 0.60F, d.bodyWidth * 0.46F,
+                        d.bodyWidth * 0.32F));
       out.mesh(getUnitSphere(), chest, rider_coat * 1.02F, nullptr, 1.0F);
     }
 
     for (int i = 0; i < 2; ++i) {
       float const side = (i == 0) ? 1.0F : -1.0F;
-      QMatrix4x4 shoulder_pad = ctx.model;
-      shoulder_pad.translate(torso_top + QVector3D(side * d.bodyWidth * 0.40F,
-                                                   -d.bodyWidth * 0.02F,
-                                                   0.02F));
-      shoulder_pad.scale(QVector3D(d.bodyWidth * 0.22F, d.bodyWidth * 0.16F,
-                                   d.bodyWidth * 0.18F));
+      QMatrix4x4 const shoulder_pad =
+          translateScale(ctx.model,
+              torso_top + QVector3D(side * d.bodyWidth * 0.40F,
+                                    -d.bodyWidth * 0.02F, 0.02F),
+              QVector3D(d.bodyWidth * 0.22F, d.bodyWidth * 0.16F,
+                        d.bodyWidth * 0.18F));
       out.mesh(getUnitSphere(), shoulder_pad, rider_cloth * 0.92F, nullptr,
                1.0F);
     }
@@ -1132,27 +1151,31 @@ void HorseRenderer::render(const DrawContext &ctx, const AnimationInputs &anim,
 
     QVector3D const helmet_top =
         neck_base + QVector3D(0.0F, d.bodyHeight * 0.32F, 0.04F);
-    QMatrix4x4 neck = ctx.model;
-    neck.translate(lerp(torso_top, neck_base, 0.6F));
-    neck.scale(QVector3D(d.bodyWidth * 0.22F, d.bodyWidth * 0.24F,
-                         d.bodyWidth * 0.20F));
+    QMatrix4x4 const neck =
+        translateScale(ctx.model, lerp(torso_top, neck_base, 0.6F),
+            QVector3D(d.bodyWidth * 0.22F, d.bodyWidth * 0.24F,
+                      d.bodyWidth * 0.20F));
     out.mesh(getUnitSphere(), neck, rider_skin * 0.88F, nullptr, 1.0F);
 
-    QMatrix4x4 head = ctx.model;
-    head.translate(helmet_top + QVector3D(0.0F, -d.bodyWidth * 0.12F, 0.0F));
-    head.scale(d.bodyWidth * 0.30F);
+    QMatrix4x4 const head =
+        translateScale(ctx.model,
+            helmet_top + QVector3D(0.0F, -d.bodyWidth * 0.12F, 0.0F),
+            d.bodyWidth * 0.30F);
     out.mesh(getUnitSphere(), head, rider_skin * 0.95F, nullptr, 1.0F);
 
-    QMatrix4x4 helm = ctx.model;
-    helm.translate(helmet_top + QVector3D(0.0F, d.bodyWidth * 0.08F, 0.0F));
-    helm.scale(d.bodyWidth * 0.34F, d.bodyWidth * 0.18F, d.bodyWidth * 0.34F);
+    QMatrix4x4 const helm =
+        translateScale(ctx.model,
+            helmet_top + QVector3D(0.0F, d.bodyWidth * 0.08F, 0.0F),
+            QVector3D(d.bodyWidth * 0.34F, d.bodyWidth * 0.18F,
+                      d.bodyWidth * 0.34F));
     out.mesh(getUnitSphere(), helm, rider_cloth * 0.82F, nullptr, 1.0F);
 
-    QMatrix4x4 visor = ctx.model;
-    visor.translate(helmet_top +
-                    QVector3D(0.0F, d.bodyWidth * 0.02F, d.bodyWidth * 0.15F));
-    visor.scale(QVector3D(d.bodyWidth * 0.32F, d.bodyWidth * 0.08F,
-                          d.bodyWidth * 0.16F));
+    QMatrix4x4 const visor =
+        translateScale(ctx.model,
+            helmet_top + QVector3D(0.0F, d.bodyWidth * 0.02F,
+                                   d.bodyWidth * 0.15F),
+            QVector3D(d.bodyWidth * 0.32F, d.bodyWidth * 0.08F,
+                      d.bodyWidth * 0.16F));
     out.mesh(getUnitSphere(), visor, rider_coat * 0.75F, nullptr, 1.0F);
 
     auto draw_leg = [&](float side_sign, const QVector3D &stirrupBottom) {
@@ -1174,27 +1197,28 @@ void HorseRenderer::render(const DrawContext &ctx, const AnimationInputs &anim,
       drawCylinder(out, ctx.model, knee, ankle, d.bodyWidth * 0.095F,
                    rider_cloth * 0.90F);
 
-      QMatrix4x4 knee_cap = ctx.model;
-      knee_cap.translate(knee);
-      knee_cap.scale(QVector3D(d.bodyWidth * 0.12F, d.bodyWidth * 0.10F,
-                               d.bodyWidth * 0.14F));
+      QMatrix4x4 const knee_cap =
+          translateScale(ctx.model, knee,
+              QVector3D(d.bodyWidth * 0.12F, d.bodyWidth * 0.10F,
+                        d.bodyWidth * 0.14F));
       out.mesh(getUnitSphere(), knee_cap, rider_cloth * 0.86F, nullptr, 1.0F);
 
       drawCylinder(out, ctx.model, ankle, toe, d.bodyWidth * 0.08F,
                    rider_coat * 0.75F);
 
-      QMatrix4x4 boot = ctx.model;
-      boot.translate(ankle + QVector3D(0.0F, -d.bodyWidth * 0.06F, 0.0F));
-      boot.scale(QVector3D(d.bodyWidth * 0.16F, d.bodyWidth * 0.14F,
-                           d.bodyWidth * 0.20F));
+      QMatrix4x4 const boot =
+          translateScale(ctx.model,
+              ankle + QVector3D(0.0F, -d.bodyWidth * 0.06F, 0.0F),
+              QVector3D(d.bodyWidth * 0.16F, d.bodyWidth * 0.14F,
+                        d.bodyWidth * 0.20F));
       out.mesh(getUnitSphere(), boot, rider_leather, nullptr, 1.0F);
 
-      QMatrix4x4 spur = ctx.model;
-      spur.translate(ankle + QVector3D(-side_sign * d.bodyWidth * 0.10F,
-                                       -d.bodyWidth * 0.01F,
-                                       -d.bodyWidth * 0.06F));
-      spur.scale(QVector3D(d.bodyWidth * 0.06F, d.bodyWidth * 0.06F,
-                           d.bodyWidth * 0.08F));
+      QMatrix4x4 const spur =
+          translateScale(ctx.model,
+              ankle + QVector3D(-side_sign * d.bodyWidth * 0.10F,
+                                -d.bodyWidth * 0.01F, -d.bodyWidth * 0.06F),
+              QVector3D(d.bodyWidth * 0.06F, d.bodyWidth * 0.06F,
+                        d.bodyWidth * 0.08F));
       out.mesh(getUnitSphere(), spur, QVector3D(0.62F, 0.62F, 0.64F), nullptr,
                1.0F);
     };
@@ -1216,9 +1240,8 @@ void HorseRenderer::render(const DrawContext &ctx, const AnimationInputs &anim,
     drawCylinder(out, ctx.model, sword_grip, sword_handle_top,
                  d.bodyWidth * 0.045F, rider_leather * 0.88F);
 
-    QMatrix4x4 pommel = ctx.model;
-    pommel.translate(sword_handle_bottom);
-    pommel.scale(d.bodyWidth * 0.12F);
+    QMatrix4x4 const pommel =
+        translateScale(ctx.model, sword_handle_bottom, d.bodyWidth * 0.12F);
     out.mesh(getUnitSphere(), pommel, rider_leather * 0.75F, nullptr, 1.0F);
 
     QVector3D const guard_center =
@@ -1233,9 +1256,8 @@ void HorseRenderer::render(const DrawContext &ctx, const AnimationInputs &anim,
              cylinderBetween(ctx.model, guard_l, guard_r, d.bodyWidth * 0.020F),
              rider_steel * 1.05F, nullptr, 1.0F);
 
-    QMatrix4x4 guard_core = ctx.model;
-    guard_core.translate(guard_center);
-    guard_core.scale(d.bodyWidth * 0.05F);
+    QMatrix4x4 const guard_core =
+        translateScale(ctx.model, guard_center, d.bodyWidth * 0.05F);
     out.mesh(getUnitSphere(), guard_core, rider_steel * 1.08F, nullptr, 1.0F);
 
     QVector3D const blade_base =
@@ -1278,18 +1300,20 @@ void HorseRenderer::render(const DrawContext &ctx, const AnimationInputs &anim,
              cylinderBetween(ctx.model, attach, bottom, d.bodyWidth * 0.048F),
              v.tack_color * 0.98F, nullptr, 1.0F);
 
-    QMatrix4x4 leather_loop = ctx.model;
-    leather_loop.translate(lerp(attach, bottom, 0.30F) +
-                           QVector3D(0.0F, 0.0F, d.bodyWidth * 0.02F));
-    leather_loop.scale(QVector3D(d.bodyWidth * 0.18F, d.bodyWidth * 0.05F,
-                                 d.bodyWidth * 0.10F));
+    QMatrix4x4 const leather_loop =
+        translateScale(ctx.model,
+            lerp(attach, bottom, 0.30F) + QVector3D(0.0F, 0.0F,
+                                                    d.bodyWidth * 0.02F),
+            QVector3D(d.bodyWidth * 0.18F, d.bodyWidth * 0.05F,
+                      d.bodyWidth * 0.10F));
     out.mesh(getUnitSphere(), leather_loop, v.tack_color * 0.92F, nullptr,
              1.0F);
 
-    QMatrix4x4 stirrup = ctx.model;
-    stirrup.translate(bottom + QVector3D(0.0F, -d.bodyWidth * 0.06F, 0.0F));
-    stirrup.scale(d.bodyWidth * 0.20F, d.bodyWidth * 0.07F,
-                  d.bodyWidth * 0.16F);
+    QMatrix4x4 const stirrup =
+        translateScale(ctx.model,
+            bottom + QVector3D(0.0F, -d.bodyWidth * 0.06F, 0.0F),
+            QVector3D(d.bodyWidth * 0.20F, d.bodyWidth * 0.07F,
+                      d.bodyWidth * 0.16F));
     out.mesh(getUnitSphere(), stirrup, QVector3D(0.66F, 0.65F, 0.62F), nullptr,
              1.0F);
   };
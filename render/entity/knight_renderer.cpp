@@ -8,8 +8,8 @@
 #include "../humanoid_math.h"
 #include "../humanoid_specs.h"
 #include "../palette.h"
-#include "../scene_renderer.h"
 #include "../submitter.h"
+#include "../world_snapshot.h"
 #include "registry.h"
 #include "renderer_constants.h"
 #include <numbers>
@@ -21,8 +21,10 @@
 #include <QMatrix4x4>
 #include <QString>
 #include <QVector3D>
+#include <array>
 #include <cmath>
 #include <cstdint>
+#include <mutex>
 
 namespace Render::GL {
 
@@ -59,13 +61,15 @@ public:
   }
 
 private:
+  // Guarded by the base's m_cacheMutex: parallel submission draws
+  // through the one shared instance from several workers.
   mutable std::unordered_map<uint32_t, KnightExtras> m_extrasCache;
 
 public:
   void getVariant(const DrawContext &ctx, uint32_t seed,
                   HumanoidVariant &v) const override {
     QVector3D const team_tint = resolveTeamTint(ctx);
-    v.palette = makeHumanoidPalette(team_tint, seed);
+    v.palette = cachedHumanoidPalette(team_tint, seed);
   }
 
   void customizePose(const DrawContext &ctx, const AnimationInputs &anim,
@@ -131,18 +135,22 @@ public:
   void addAttachments(const DrawContext &ctx, const HumanoidVariant &v,
                       const HumanoidPose &pose, const AnimationInputs &anim,
                       ISubmitter &out) const override {
-    uint32_t const seed = reinterpret_cast<uintptr_t>(ctx.entity) & 0xFFFFFFFFU;
+    uint32_t const seed =
+        (ctx.snap != nullptr) ? uint32_t(ctx.snap->id) : 0U;
 
     KnightExtras extras;
-    auto it = m_extrasCache.find(seed);
-    if (it != m_extrasCache.end()) {
-      extras = it->second;
-    } else {
-      extras = computeKnightExtras(seed, v);
-      m_extrasCache[seed] = extras;
+    {
+      const std::lock_guard<std::mutex> lock(m_cacheMutex);
+      auto it = m_extrasCache.find(seed);
+      if (it != m_extrasCache.end()) {
+        extras = it->second;
+      } else {
+        extras = computeKnightExtras(seed, v);
+        m_extrasCache[seed] = extras;
 
-      if (m_extrasCache.size() > MAX_EXTRAS_CACHE_SIZE) {
-        m_extrasCache.clear();
+        if (m_extrasCache.size() > MAX_EXTRAS_CACHE_SIZE) {
+          m_extrasCache.clear();
+        }
       }
     }
 
@@ -287,10 +295,16 @@ public:
       out.mesh(getUnitSphere(), m, brass_color, nullptr, 1.0F);
     };
 
+    std::array<float, 8> rivet_angles{};
+    std::array<float, 8> rivet_sin{};
+    std::array<float, 8> rivet_cos{};
+    for (int i = 0; i < 8; ++i) {
+      rivet_angles[i] = (i / 8.0F) * 2.0F * std::numbers::pi_v<float>;
+    }
+    sinCosBatch(rivet_angles.data(), rivet_sin.data(), rivet_cos.data(), 8);
     for (int i = 0; i < 8; ++i) {
-      float const angle = (i / 8.0F) * 2.0F * std::numbers::pi_v<float>;
-      float const x = r_chest * std::sin(angle) * 0.95F;
-      float const z = r_chest * std::cos(angle) * 0.95F;
+      float const x = r_chest * rivet_sin[i] * 0.95F;
+      float const z = r_chest * rivet_cos[i] * 0.95F;
       draw_rivet(QVector3D(x, bp_mid.y() + 0.08F, z));
     }
 
@@ -445,10 +459,16 @@ public:
     draw_pauldronRivet(pose.shoulderR, right_axis);
 
     QVector3D const gorget_top(0, y_top_cover + 0.045F, 0);
+    std::array<float, 6> stud_angles{};
+    std::array<float, 6> stud_sin{};
+    std::array<float, 6> stud_cos{};
     for (int i = 0; i < 6; ++i) {
-      float const angle = (i / 6.0F) * 2.0F * std::numbers::pi_v<float>;
-      float const x = HP::NECK_RADIUS * 2.58F * std::sin(angle);
-      float const z = HP::NECK_RADIUS * 2.58F * std::cos(angle);
+      stud_angles[i] = (i / 6.0F) * 2.0F * std::numbers::pi_v<float>;
+    }
+    sinCosBatch(stud_angles.data(), stud_sin.data(), stud_cos.data(), 6);
+    for (int i = 0; i < 6; ++i) {
+      float const x = HP::NECK_RADIUS * 2.58F * stud_sin[i];
+      float const z = HP::NECK_RADIUS * 2.58F * stud_cos[i];
       draw_stud(gorget_top + QVector3D(x, 0, z));
     }
 
@@ -696,14 +716,19 @@ private:
                              const QVector3D &color, ISubmitter &out) {
 
     const int segments = 12;
+    // One shared endpoint per segment pair: batch segments + 1 angles.
+    std::array<float, 13> angles{};
+    std::array<float, 13> sin_v{};
+    std::array<float, 13> cos_v{};
+    for (int i = 0; i <= segments; ++i) {
+      angles[i] = (float)i / segments * 2.0F * std::numbers::pi_v<float>;
+    }
+    sinCosBatch(angles.data(), sin_v.data(), cos_v.data(), segments + 1);
     for (int i = 0; i < segments; ++i) {
-      float const a0 = (float)i / segments * 2.0F * std::numbers::pi_v<float>;
-      float const a1 =
-          (float)(i + 1) / segments * 2.0F * std::numbers::pi_v<float>;
-      QVector3D const p0(center.x() + radius * std::cos(a0),
-                         center.y() + radius * std::sin(a0), center.z());
-      QVector3D const p1(center.x() + radius * std::cos(a1),
-                         center.y() + radius * std::sin(a1), center.z());
+      QVector3D const p0(center.x() + radius * cos_v[i],
+                         center.y() + radius * sin_v[i], center.z());
+      QVector3D const p1(center.x() + radius * cos_v[i + 1],
+                         center.y() + radius * sin_v[i + 1], center.z());
       out.mesh(getUnitCylinder(), cylinderBetween(ctx.model, p0, p1, thickness),
                color, nullptr, 1.0F);
     }
@@ -749,15 +774,18 @@ private:
     auto draw_ring_rotated = [&](float radius, float thickness,
                                  const QVector3D &color) {
       const int segments = 16;
+      std::array<float, 17> angles{};
+      std::array<float, 17> sin_v{};
+      std::array<float, 17> cos_v{};
+      for (int i = 0; i <= segments; ++i) {
+        angles[i] = (float)i / segments * 2.0F * std::numbers::pi_v<float>;
+      }
+      sinCosBatch(angles.data(), sin_v.data(), cos_v.data(), segments + 1);
       for (int i = 0; i < segments; ++i) {
-        float const a0 = (float)i / segments * 2.0F * std::numbers::pi_v<float>;
-        float const a1 =
-            (float)(i + 1) / segments * 2.0F * std::numbers::pi_v<float>;
-
         QVector3D const v0 =
-            QVector3D(radius * std::cos(a0), radius * std::sin(a0), 0.0F);
+            QVector3D(radius * cos_v[i], radius * sin_v[i], 0.0F);
         QVector3D const v1 =
-            QVector3D(radius * std::cos(a1), radius * std::sin(a1), 0.0F);
+            QVector3D(radius * cos_v[i + 1], radius * sin_v[i + 1], 0.0F);
 
         QVector3D const p0 = shield_center + rot.map(v0);
         QVector3D const p1 = shield_center + rot.map(v1);
@@ -839,16 +867,15 @@ void registerKnightRenderer(Render::GL::EntityRendererRegistry &registry) {
         static KnightRenderer const static_renderer;
         Shader *knight_shader = nullptr;
         if (ctx.backend != nullptr) {
-          knight_shader = ctx.backend->shader(QStringLiteral("knight"));
+          static const ShaderHandle k_handle =
+              ctx.backend->shaderHandle(QStringLiteral("knight"));
+          knight_shader = ctx.backend->shader(k_handle);
         }
-        auto *scene_renderer = dynamic_cast<Renderer *>(&out);
-        if ((scene_renderer != nullptr) && (knight_shader != nullptr)) {
-          scene_renderer->setCurrentShader(knight_shader);
+        if (knight_shader != nullptr) {
+          out.setShader(knight_shader);
         }
         static_renderer.render(ctx, out);
-        if (scene_renderer != nullptr) {
-          scene_renderer->setCurrentShader(nullptr);
-        }
+        out.setShader(nullptr);
       });
 }
 
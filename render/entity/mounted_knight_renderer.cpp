@@ -8,8 +8,8 @@
 #include "../humanoid_math.h"
 #include "../humanoid_specs.h"
 #include "../palette.h"
-#include "../scene_renderer.h"
 #include "../submitter.h"
+#include "../world_snapshot.h"
 #include "horse_renderer.h"
 #include "registry.h"
 #include "renderer_constants.h"
@@ -25,6 +25,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <mutex>
 
 namespace Render::GL {
 
@@ -37,6 +38,7 @@ using Render::Geom::lerp;
 using Render::Geom::nlerp;
 using Render::Geom::smoothstep;
 using Render::Geom::sphereAt;
+using Render::Geom::translateScale;
 
 struct MountedKnightExtras {
   QVector3D metalColor;
@@ -54,6 +56,8 @@ public:
   }
 
 private:
+  // Guarded by the base's m_cacheMutex: several submission workers can
+  // draw mounted knights through the one shared instance.
   mutable std::unordered_map<uint32_t, MountedKnightExtras> m_extrasCache;
   HorseRenderer m_horseRenderer;
 
@@ -61,7 +65,7 @@ public:
   void getVariant(const DrawContext &ctx, uint32_t seed,
                   HumanoidVariant &v) const override {
     QVector3D const team_tint = resolveTeamTint(ctx);
-    v.palette = makeHumanoidPalette(team_tint, seed);
+    v.palette = cachedHumanoidPalette(team_tint, seed);
   }
 
   void customizePose(const DrawContext &ctx, const AnimationInputs &anim,
@@ -72,9 +76,8 @@ public:
     const float arm_asymmetry = (hash_01(seed ^ 0xDEF0U) - 0.5F) * 0.04F;
 
     uint32_t horse_seed = seed;
-    if (ctx.entity != nullptr) {
-      horse_seed = static_cast<uint32_t>(
-          reinterpret_cast<uintptr_t>(ctx.entity) & 0xFFFFFFFFU);
+    if (ctx.snap != nullptr) {
+      horse_seed = static_cast<uint32_t>(ctx.snap->id);
     }
 
     const HorseDimensions dims = makeHorseDimensions(horse_seed);
@@ -194,21 +197,23 @@ public:
                       const HumanoidPose &pose, const AnimationInputs &anim,
                       ISubmitter &out) const override {
     uint32_t horse_seed = 0U;
-    if (ctx.entity != nullptr) {
-      horse_seed = static_cast<uint32_t>(
-          reinterpret_cast<uintptr_t>(ctx.entity) & 0xFFFFFFFFU);
+    if (ctx.snap != nullptr) {
+      horse_seed = static_cast<uint32_t>(ctx.snap->id);
     }
 
     MountedKnightExtras extras;
-    auto it = m_extrasCache.find(horse_seed);
-    if (it != m_extrasCache.end()) {
-      extras = it->second;
-    } else {
-      extras = computeMountedKnightExtras(horse_seed, v);
-      m_extrasCache[horse_seed] = extras;
+    {
+      const std::lock_guard<std::mutex> lock(m_cacheMutex);
+      auto it = m_extrasCache.find(horse_seed);
+      if (it != m_extrasCache.end()) {
+        extras = it->second;
+      } else {
+        extras = computeMountedKnightExtras(horse_seed, v);
+        m_extrasCache[horse_seed] = extras;
 
-      if (m_extrasCache.size() > MAX_EXTRAS_CACHE_SIZE) {
-        m_extrasCache.clear();
+        if (m_extrasCache.size() > MAX_EXTRAS_CACHE_SIZE) {
+          m_extrasCache.clear();
+        }
       }
     }
 
@@ -283,9 +288,8 @@ public:
 
     auto draw_breathing_hole = [&](float x, float y) {
       QVector3D const pos(x, pose.headPos.y() + y, helm_r * 0.70F);
-      QMatrix4x4 m = ctx.model;
-      m.translate(pos);
-      m.scale(0.010F);
+      QMatrix4x4 const m =
+          translateScale(ctx.model, pos, 0.010F);
       out.mesh(getUnitSphere(), m, QVector3D(0.1F, 0.1F, 0.1F), nullptr, 1.0F);
     };
 
@@ -300,9 +304,9 @@ public:
     const QVector3D plume_base(0, pose.headPos.y() + pose.headR * 1.50F, 0);
     const QVector3D brass_color = v.palette.metal * BRASS_TINT;
 
-    QMatrix4x4 plume = ctx.model;
-    plume.translate(plume_base);
-    plume.scale(0.030F, 0.015F, 0.030F);
+    QMatrix4x4 const plume =
+        translateScale(ctx.model, plume_base,
+            QVector3D(0.030F, 0.015F, 0.030F));
     out.mesh(getUnitSphere(), plume, brass_color * 1.2F, nullptr, 1.0F);
 
     for (int i = 0; i < 5; ++i) {
@@ -358,9 +362,8 @@ public:
              steel_color * 0.98F, nullptr, 1.0F);
 
     auto draw_rivet = [&](const QVector3D &pos) {
-      QMatrix4x4 m = ctx.model;
-      m.translate(pos);
-      m.scale(0.012F);
+      QMatrix4x4 const m =
+          translateScale(ctx.model, pos, 0.012F);
       out.mesh(getUnitSphere(), m, brass_color, nullptr, 1.0F);
     };
 
@@ -452,17 +455,16 @@ public:
     }
 
     auto draw_stud = [&](const QVector3D &pos) {
-      QMatrix4x4 m = ctx.model;
-      m.translate(pos);
-      m.scale(0.008F);
+      QMatrix4x4 const m =
+          translateScale(ctx.model, pos, 0.008F);
       out.mesh(getUnitSphere(), m, brass_color * 1.3F, nullptr, 1.0F);
     };
 
     QVector3D const belt_center(0, HP::WAIST_Y + 0.03F,
                                 HP::TORSO_BOT_R * 1.15F);
-    QMatrix4x4 buckle = ctx.model;
-    buckle.translate(belt_center);
-    buckle.scale(0.035F, 0.025F, 0.012F);
+    QMatrix4x4 const buckle =
+        translateScale(ctx.model, belt_center,
+            QVector3D(0.035F, 0.025F, 0.012F));
     out.mesh(getUnitSphere(), buckle, brass_color * 1.25F, nullptr, 1.0F);
 
     QVector3D const buckle_h1 = belt_center + QVector3D(-0.025F, 0, 0.005F);
@@ -720,9 +722,9 @@ private:
     }
 
     {
-      QMatrix4x4 m = ctx.model;
-      m.translate(shield_center + n * (0.015F * scale_factor));
-      m.scale(0.035F * scale_factor);
+      QMatrix4x4 const m =
+          translateScale(ctx.model, shield_center + n * (0.015F * scale_factor),
+              0.035F * scale_factor);
       out.mesh(getUnitSphere(), m, extras.metalColor, nullptr, 1.0F);
     }
 
@@ -744,17 +746,15 @@ void registerMountedKnightRenderer(
         static MountedKnightRenderer const static_renderer;
         Shader *mounted_knight_shader = nullptr;
         if (ctx.backend != nullptr) {
-          mounted_knight_shader =
-              ctx.backend->shader(QStringLiteral("mounted_knight"));
+          static const ShaderHandle k_handle =
+              ctx.backend->shaderHandle(QStringLiteral("mounted_knight"));
+          mounted_knight_shader = ctx.backend->shader(k_handle);
         }
-        auto *scene_renderer = dynamic_cast<Renderer *>(&out);
-        if ((scene_renderer != nullptr) && (mounted_knight_shader != nullptr)) {
-          scene_renderer->setCurrentShader(mounted_knight_shader);
+        if (mounted_knight_shader != nullptr) {
+          out.setShader(mounted_knight_shader);
         }
         static_renderer.render(ctx, out);
-        if (scene_renderer != nullptr) {
-          scene_renderer->setCurrentShader(nullptr);
-        }
+        out.setShader(nullptr);
       });
 }
 
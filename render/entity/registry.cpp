@@ -10,6 +10,44 @@
 
 namespace Render::GL {
 
+namespace {
+constexpr float k_reduced_distance = 45.0F;
+constexpr float k_minimal_distance = 95.0F;
+constexpr float k_impostor_distance = 160.0F;
+constexpr float k_lod_hysteresis = 4.0F;
+} // namespace
+
+auto selectLodTier(float distance, LodTier previous) -> LodTier {
+  float reduced_edge = k_reduced_distance;
+  float minimal_edge = k_minimal_distance;
+  float impostor_edge = k_impostor_distance;
+
+  // Push each boundary away from the previous tier so an entity has to
+  // travel through the dead zone before it switches.
+  if (previous == LodTier::Full) {
+    reduced_edge += k_lod_hysteresis;
+  } else if (previous == LodTier::Reduced) {
+    reduced_edge -= k_lod_hysteresis;
+    minimal_edge += k_lod_hysteresis;
+  } else if (previous == LodTier::Minimal) {
+    minimal_edge -= k_lod_hysteresis;
+    impostor_edge += k_lod_hysteresis;
+  } else {
+    impostor_edge -= k_lod_hysteresis;
+  }
+
+  if (distance >= impostor_edge) {
+    return LodTier::Impostor;
+  }
+  if (distance >= minimal_edge) {
+    return LodTier::Minimal;
+  }
+  if (distance >= reduced_edge) {
+    return LodTier::Reduced;
+  }
+  return LodTier::Full;
+}
+
 void EntityRendererRegistry::registerRenderer(const std::string &type,
                                               RenderFunc func) {
   m_map[type] = std::move(func);
@@ -23,6 +61,16 @@ auto EntityRendererRegistry::get(const std::string &type) const -> RenderFunc {
   return {};
 }
 
+auto EntityRendererRegistry::registeredTypes() const
+    -> std::vector<std::string> {
+  std::vector<std::string> types;
+  types.reserve(m_map.size());
+  for (const auto &[type, func] : m_map) {
+    types.push_back(type);
+  }
+  return types;
+}
+
 void registerBuiltInEntityRenderers(EntityRendererRegistry &registry) {
   registerArcherRenderer(registry);
   registerKnightRenderer(registry);
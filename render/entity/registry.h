@@ -3,34 +3,51 @@
 #include "../submitter.h"
 #include <QMatrix4x4>
 #include <QVector3D>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
-
-namespace Engine::Core {
-class Entity;
-class World;
-} // namespace Engine::Core
+#include <vector>
 
 namespace Render::GL {
 class ResourceManager;
 class Mesh;
 class Texture;
 class Backend;
+struct EntitySnapshot;
 } // namespace Render::GL
 
 namespace Render::GL {
 
+// Detail tier picked per entity from camera distance. Renderers that submit
+// many parts per individual drop optional geometry at Reduced and fall back
+// to a silhouette-only body at Minimal; beyond that the renderer swaps the
+// whole unit for a pre-baked camera-facing impostor quad.
+enum class LodTier : std::uint8_t {
+  Full = 0,
+  Reduced = 1,
+  Minimal = 2,
+  Impostor = 3,
+};
+
+// Maps a camera distance onto a tier with hysteresis: the boundaries shift
+// a few units away from the entity's previous tier, so units hovering near
+// a threshold do not pop between detail levels every frame.
+[[nodiscard]] auto selectLodTier(float distance, LodTier previous) -> LodTier;
+
+// Entity renderers read exclusively from the EntitySnapshot captured at the
+// end of the sim tick; they never see live components, so the registry can
+// run without holding the world lock.
 struct DrawContext {
   ResourceManager *resources = nullptr;
-  Engine::Core::Entity *entity = nullptr;
-  Engine::Core::World *world = nullptr;
+  const EntitySnapshot *snap = nullptr;
   QMatrix4x4 model;
   bool selected = false;
   bool hovered = false;
   float animationTime = 0.0F;
   class Backend *backend = nullptr;
+  LodTier lod = LodTier::Full;
 };
 
 using RenderFunc = std::function<void(const DrawContext &, ISubmitter &out)>;
@@ -39,6 +56,7 @@ class EntityRendererRegistry {
 public:
   void registerRenderer(const std::string &type, RenderFunc func);
   auto get(const std::string &type) const -> RenderFunc;
+  [[nodiscard]] auto registeredTypes() const -> std::vector<std::string>;
 
 private:
   std::unordered_map<std::string, RenderFunc> m_map;
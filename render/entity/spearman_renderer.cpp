@@ -8,8 +8,8 @@
 #include "../humanoid_math.h"
 #include "../humanoid_specs.h"
 #include "../palette.h"
-#include "../scene_renderer.h"
 #include "../submitter.h"
+#include "../world_snapshot.h"
 #include "registry.h"
 #include "renderer_constants.h"
 
@@ -18,6 +18,7 @@
 #include <QVector3D>
 #include <cmath>
 #include <cstdint>
+#include <mutex>
 #include <qstringliteral.h>
 #include <qvectornd.h>
 #include <unordered_map>
@@ -48,13 +49,15 @@ public:
   }
 
 private:
+  // Guarded by the base's m_cacheMutex; parallel submission workers
+  // share the one renderer instance.
   mutable std::unordered_map<uint32_t, SpearmanExtras> m_extrasCache;
 
 public:
   void getVariant(const DrawContext &ctx, uint32_t seed,
                   HumanoidVariant &v) const override {
     QVector3D const team_tint = resolveTeamTint(ctx);
-    v.palette = makeHumanoidPalette(team_tint, seed);
+    v.palette = cachedHumanoidPalette(team_tint, seed);
   }
 
   void customizePose(const DrawContext &ctx, const AnimationInputs &anim,
@@ -189,18 +192,22 @@ public:
   void addAttachments(const DrawContext &ctx, const HumanoidVariant &v,
                       const HumanoidPose &pose, const AnimationInputs &anim,
                       ISubmitter &out) const override {
-    uint32_t const seed = reinterpret_cast<uintptr_t>(ctx.entity) & 0xFFFFFFFFU;
+    uint32_t const seed =
+        (ctx.snap != nullptr) ? uint32_t(ctx.snap->id) : 0U;
 
     SpearmanExtras extras;
-    auto it = m_extrasCache.find(seed);
-    if (it != m_extrasCache.end()) {
-      extras = it->second;
-    } else {
-      extras = computeSpearmanExtras(seed, v);
-      m_extrasCache[seed] = extras;
+    {
+      const std::lock_guard<std::mutex> lock(m_cacheMutex);
+      auto it = m_extrasCache.find(seed);
+      if (it != m_extrasCache.end()) {
+        extras = it->second;
+      } else {
+        extras = computeSpearmanExtras(seed, v);
+        m_extrasCache[seed] = extras;
 
-      if (m_extrasCache.size() > MAX_EXTRAS_CACHE_SIZE) {
-        m_extrasCache.clear();
+        if (m_extrasCache.size() > MAX_EXTRAS_CACHE_SIZE) {
+          m_extrasCache.clear();
+        }
       }
     }
 
@@ -437,16 +444,15 @@ void registerSpearmanRenderer(Render::GL::EntityRendererRegistry &registry) {
         static SpearmanRenderer const static_renderer;
         Shader *spearman_shader = nullptr;
         if (ctx.backend != nullptr) {
-          spearman_shader = ctx.backend->shader(QStringLiteral("spearman"));
+          static const ShaderHandle k_handle =
+              ctx.backend->shaderHandle(QStringLiteral("spearman"));
+          spearman_shader = ctx.backend->shader(k_handle);
         }
-        auto *scene_renderer = dynamic_cast<Renderer *>(&out);
-        if ((scene_renderer != nullptr) && (spearman_shader != nullptr)) {
-          scene_renderer->setCurrentShader(spearman_shader);
+        if (spearman_shader != nullptr) {
+          out.setShader(spearman_shader);
         }
         static_renderer.render(ctx, out);
-        if (scene_renderer != nullptr) {
-          scene_renderer->setCurrentShader(nullptr);
-        }
+        out.setShader(nullptr);
       });
 }
 
@@ -3,6 +3,7 @@
 #include "../entity/registry.h"
 #include "../gl/mesh.h"
 #include "../gl/resources.h"
+#include "../particle_system.h"
 #include "../scene_renderer.h"
 
 #include <QMatrix4x4>
@@ -99,18 +100,48 @@ void renderArrows(Renderer *renderer, ResourceManager *resources,
     return;
   }
 
-  const auto &arrows = arrow_system.arrows();
-  for (const auto &arrow : arrows) {
-    if (!arrow.active) {
-      continue;
-    }
-
-    const QVector3D delta = arrow.end - arrow.start;
+  // The arrow pool is dense SoA — every index is a live arrow. Every
+  // submission below shares one mesh, the basic shader and no texture,
+  // so the backend folds the run into a single instanced draw; the CPU
+  // cost here is only the per-arrow matrix fill.
+  const auto &starts = arrow_system.starts();
+  const auto &ends = arrow_system.ends();
+  const auto &colors = arrow_system.colors();
+  const auto &ts = arrow_system.ts();
+  const auto &arc_heights = arrow_system.arcHeights();
+
+  // Trails ride the burst-particle pool: every other frame each arrow
+  // drops one short-lived point at its arc position. Consecutive spawns
+  // occupy adjacent ring slots, so the whole frame's worth of trail
+  // points uploads as one contiguous write and draws inside the pool's
+  // single instanced batch — no extra draw call per effect.
+  static bool emit_trails = false;
+  emit_trails = !emit_trails;
+  auto *particles = renderer->particles();
+  const float now = renderer->getAnimationTime();
+
+  std::size_t const count = arrow_system.count();
+  for (std::size_t i = 0; i < count; ++i) {
+    float const t = ts[i];
+    float const arc_height = arc_heights[i];
+
+    const QVector3D delta = ends[i] - starts[i];
     const float dist = std::max(0.001F, delta.length());
-    QVector3D pos = arrow.start + delta * arrow.t;
-    float const h = arrow.arcHeight * 4.0F * arrow.t * (1.0F - arrow.t);
+    QVector3D pos = starts[i] + delta * t;
+    float const h = arc_height * 4.0F * t * (1.0F - t);
     pos.setY(pos.y() + h);
 
+    if (emit_trails && particles != nullptr) {
+      ParticleSystem::BurstDesc trail;
+      trail.count = 1;
+      trail.speed = 0.15F;
+      trail.life = 0.22F;
+      trail.size = 0.06F;
+      trail.gravityScale = 0.0F;
+      trail.color = colors[i] * 0.85F;
+      particles->spawnBurst(pos, trail, now);
+    }
+
     QMatrix4x4 model;
     model.translate(pos.x(), pos.y(), pos.z());
 
@@ -119,10 +150,9 @@ void renderArrows(Renderer *renderer, ResourceManager *resources,
         std::atan2(dir.x(), dir.z()) * 180.0F / std::numbers::pi_v<float>;
     model.rotate(yaw_deg, QVector3D(0, 1, 0));
 
-    float const vy = (arrow.end.y() - arrow.start.y()) / dist;
+    float const vy = (ends[i].y() - starts[i].y()) / dist;
     float const pitch_deg =
-        -std::atan2(vy - (8.0F * arrow.arcHeight * (arrow.t - 0.5F) / dist),
-                    1.0F) *
+        -std::atan2(vy - (8.0F * arc_height * (t - 0.5F) / dist), 1.0F) *
         180.0F / std::numbers::pi_v<float>;
     model.rotate(pitch_deg, QVector3D(1, 0, 0));
 
@@ -132,7 +162,7 @@ void renderArrows(Renderer *renderer, ResourceManager *resources,
     model.translate(0.0F, 0.0F, -arrow_z_scale * arrow_z_translate_factor);
     model.scale(arrow_xy_scale, arrow_xy_scale, arrow_z_scale);
 
-    renderer->mesh(arrow_mesh, model, arrow.color, nullptr, 1.0F);
+    renderer->mesh(arrow_mesh, model, colors[i], nullptr, 1.0F);
   }
 }
 
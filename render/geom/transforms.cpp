@@ -138,4 +138,30 @@ auto capsuleBetween(const QMatrix4x4 &parent, const QVector3D &a,
   return cylinderBetween(parent, a, b, radius);
 }
 
+auto translateScale(const QMatrix4x4 &parent, const QVector3D &offset,
+                    const QVector3D &scale) -> QMatrix4x4 {
+  QMatrix4x4 M = parent;
+  float *m = M.data(); // column-major; data() marks the matrix generic
+  const float tx = offset.x();
+  const float ty = offset.y();
+  const float tz = offset.z();
+  for (int r = 0; r < 4; ++r) {
+    m[12 + r] += m[r] * tx + m[4 + r] * ty + m[8 + r] * tz;
+  }
+  const float sx = scale.x();
+  const float sy = scale.y();
+  const float sz = scale.z();
+  for (int r = 0; r < 4; ++r) {
+    m[r] *= sx;
+    m[4 + r] *= sy;
+    m[8 + r] *= sz;
+  }
+  return M;
+}
+
+auto translateScale(const QMatrix4x4 &parent, const QVector3D &offset,
+                    float scale) -> QMatrix4x4 {
+  return translateScale(parent, offset, QVector3D(scale, scale, scale));
+}
+
 } // namespace Render::Geom
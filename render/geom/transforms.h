@@ -26,6 +26,16 @@ auto capsuleBetween(const QVector3D &a, const QVector3D &b,
 auto capsuleBetween(const QMatrix4x4 &parent, const QVector3D &a,
                     const QVector3D &b, float radius) -> QMatrix4x4;
 
+// parent * translate(offset) * scale(scale) composed in one pass over
+// the raw columns. The multi-part renderers derive dozens of part
+// matrices per entity per frame from one cached parent; fusing the
+// copy-translate-scale chain avoids QMatrix4x4's per-call flag tracking
+// on every part.
+auto translateScale(const QMatrix4x4 &parent, const QVector3D &offset,
+                    const QVector3D &scale) -> QMatrix4x4;
+auto translateScale(const QMatrix4x4 &parent, const QVector3D &offset,
+                    float scale) -> QMatrix4x4;
+
 inline auto cylinderBetweenPOD(const Render::Math::Vec3 &a,
                                const Render::Math::Vec3 &b,
                                float radius) -> Render::Math::Mat3x4 {
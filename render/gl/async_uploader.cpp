@@ -0,0 +1,182 @@
+#include "async_uploader.h"
+#include "mesh.h"
+#include "render_constants.h"
+#include <QDebug>
+#include <cstring>
+
+namespace Render::GL {
+
+namespace {
+// Per-pump transfer budget; a 2048x2048 RGBA texture is 16 MiB, so large
+// maps spread across a handful of loading frames instead of one stall.
+constexpr std::size_t k_upload_budget_bytes = 8U * 1024U * 1024U;
+constexpr int k_mesh_warmups_per_pump = 4;
+} // namespace
+
+AsyncUploader::~AsyncUploader() {
+  m_shouldStop.store(true, std::memory_order_release);
+  m_jobCondition.notify_all();
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+  for (auto &upload : m_inFlight) {
+    if (upload.fence != nullptr) {
+      glDeleteSync(upload.fence);
+    }
+    if (upload.pbo != 0) {
+      glDeleteBuffers(1, &upload.pbo);
+    }
+  }
+}
+
+auto AsyncUploader::initialize() -> bool {
+  initializeOpenGLFunctions();
+  m_thread = std::thread([this] { loaderLoop(); });
+  return true;
+}
+
+auto AsyncUploader::requestTexture(const QString &path) -> Texture * {
+  auto texture = std::make_unique<Texture>();
+  Texture *raw = texture.get();
+  texture->createEmpty(1, 1, Texture::Format::RGBA);
+  unsigned char const white_pixel[4] = {RGBA::MaxValue, RGBA::MaxValue,
+                                        RGBA::MaxValue, RGBA::MaxValue};
+  texture->bind();
+  glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE,
+                  white_pixel);
+  texture->unbind();
+  m_ownedTextures.push_back(std::move(texture));
+
+  m_pendingDecodes.fetch_add(1, std::memory_order_acq_rel);
+  {
+    std::lock_guard<std::mutex> const lock(m_jobMutex);
+    m_decodeQueue.push_back({raw, path});
+  }
+  m_jobCondition.notify_one();
+  return raw;
+}
+
+void AsyncUploader::requestMeshWarmup(Mesh *mesh) {
+  if (mesh != nullptr) {
+    m_meshWarmups.push_back(mesh);
+  }
+}
+
+void AsyncUploader::loaderLoop() {
+  while (true) {
+    DecodeJob job;
+    {
+      std::unique_lock<std::mutex> lock(m_jobMutex);
+      m_jobCondition.wait(lock, [this] {
+        return m_shouldStop.load(std::memory_order_acquire) ||
+               !m_decodeQueue.empty();
+      });
+      if (m_shouldStop.load(std::memory_order_acquire)) {
+        return;
+      }
+      job = std::move(m_decodeQueue.front());
+      m_decodeQueue.pop_front();
+    }
+
+    QImage image;
+    if (!image.load(job.path)) {
+      qWarning() << "AsyncUploader: failed to load texture:" << job.path;
+      image = QImage();
+    } else {
+      image = image.convertToFormat(QImage::Format_RGBA8888).mirrored();
+    }
+
+    {
+      std::lock_guard<std::mutex> const lock(m_readyMutex);
+      m_ready.push_back({job.texture, std::move(image)});
+    }
+  }
+}
+
+void AsyncUploader::pump() {
+  reapInFlight();
+
+  for (int i = 0; i < k_mesh_warmups_per_pump && !m_meshWarmups.empty(); ++i) {
+    Mesh *mesh = m_meshWarmups.front();
+    m_meshWarmups.pop_front();
+    mesh->ensureUploaded();
+  }
+
+  std::size_t uploaded_bytes = 0;
+  while (uploaded_bytes < k_upload_budget_bytes) {
+    ReadyImage ready;
+    {
+      std::lock_guard<std::mutex> const lock(m_readyMutex);
+      if (m_ready.empty()) {
+        break;
+      }
+      ready = std::move(m_ready.front());
+      m_ready.pop_front();
+    }
+    m_pendingDecodes.fetch_sub(1, std::memory_order_acq_rel);
+    if (ready.image.isNull()) {
+      // Decode failed; the placeholder stays white.
+      continue;
+    }
+    uploaded_bytes += static_cast<std::size_t>(ready.image.sizeInBytes());
+    beginUpload(ready);
+  }
+}
+
+void AsyncUploader::beginUpload(ReadyImage &ready) {
+  int const width = ready.image.width();
+  int const height = ready.image.height();
+  auto const size = static_cast<GLsizeiptr>(ready.image.sizeInBytes());
+
+  ready.texture->createEmpty(width, height, Texture::Format::RGBA);
+  ready.texture->setWrap(Texture::Wrap::Repeat, Texture::Wrap::Repeat);
+
+  InFlightUpload upload;
+  glGenBuffers(1, &upload.pbo);
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, upload.pbo);
+  glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+  void *mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size,
+                                  GL_MAP_WRITE_BIT |
+                                      GL_MAP_INVALIDATE_BUFFER_BIT);
+  if (mapped == nullptr) {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glDeleteBuffers(1, &upload.pbo);
+    qWarning() << "AsyncUploader: failed to map staging buffer";
+    return;
+  }
+  std::memcpy(mapped, ready.image.constBits(),
+              static_cast<std::size_t>(size));
+  glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+  // Source is the bound unpack buffer, so this returns without touching
+  // client memory; the fence tells us when the staging buffer is free.
+  ready.texture->bind();
+  glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA,
+                  GL_UNSIGNED_BYTE, nullptr);
+  glGenerateMipmap(GL_TEXTURE_2D);
+  ready.texture->unbind();
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+  upload.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  m_inFlight.push_back(upload);
+}
+
+void AsyncUploader::reapInFlight() {
+  for (auto it = m_inFlight.begin(); it != m_inFlight.end();) {
+    GLenum const status = glClientWaitSync(it->fence, 0, 0);
+    if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED) {
+      glDeleteSync(it->fence);
+      glDeleteBuffers(1, &it->pbo);
+      it = m_inFlight.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+auto AsyncUploader::idle() const -> bool {
+  return m_pendingDecodes.load(std::memory_order_acquire) == 0 &&
+         m_meshWarmups.empty() && m_inFlight.empty();
+}
+
+} // namespace Render::GL
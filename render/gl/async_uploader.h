@@ -0,0 +1,92 @@
+#pragma once
+
+#include "texture.h"
+#include <QImage>
+#include <QOpenGLFunctions_3_3_Core>
+#include <QString>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Render::GL {
+
+class Mesh;
+
+// Streams texture and mesh uploads in the background so map loads don't
+// stall the first rendered frames. A loader thread does the file decode
+// (the CPU-expensive half); the render thread drains finished decodes in
+// pump(), pushing pixels through pixel-buffer-object staging so the
+// glTexSubImage2D call returns without a client-memory copy, with a fence
+// guarding each staging buffer until the transfer lands. pump() honours a
+// per-frame byte budget so the menu or loading screen keeps rendering
+// while a skirmish map streams in.
+class AsyncUploader : protected QOpenGLFunctions_3_3_Core {
+public:
+  AsyncUploader() = default;
+  ~AsyncUploader() override;
+
+  AsyncUploader(const AsyncUploader &) = delete;
+  auto operator=(const AsyncUploader &) -> AsyncUploader & = delete;
+  AsyncUploader(AsyncUploader &&) = delete;
+  auto operator=(AsyncUploader &&) -> AsyncUploader & = delete;
+
+  // GL-thread only; starts the loader thread.
+  auto initialize() -> bool;
+
+  // Returns a white-placeholder texture immediately; the real pixels
+  // stream in over the following frames. Ownership stays here.
+  auto requestTexture(const QString &path) -> Texture *;
+
+  // First draw of a mesh uploads its buffers synchronously; queueing it
+  // here warms them during loading frames instead.
+  void requestMeshWarmup(Mesh *mesh);
+
+  // Drains finished decodes within the frame budget; call once per frame
+  // with the GL context current.
+  void pump();
+
+  // True when nothing is decoding, queued, or in flight on the GPU.
+  [[nodiscard]] auto idle() const -> bool;
+
+private:
+  struct DecodeJob {
+    Texture *texture = nullptr;
+    QString path;
+  };
+
+  struct ReadyImage {
+    Texture *texture = nullptr;
+    QImage image;
+  };
+
+  struct InFlightUpload {
+    GLuint pbo = 0;
+    GLsync fence = nullptr;
+  };
+
+  void loaderLoop();
+  void beginUpload(ReadyImage &ready);
+  void reapInFlight();
+
+  std::vector<std::unique_ptr<Texture>> m_ownedTextures;
+
+  std::thread m_thread;
+  std::atomic<bool> m_shouldStop{false};
+  std::atomic<int> m_pendingDecodes{0};
+
+  std::mutex m_jobMutex;
+  std::condition_variable m_jobCondition;
+  std::deque<DecodeJob> m_decodeQueue;
+
+  std::mutex m_readyMutex;
+  std::deque<ReadyImage> m_ready;
+
+  std::deque<Mesh *> m_meshWarmups;
+  std::vector<InFlightUpload> m_inFlight;
+};
+
+} // namespace Render::GL
@@ -1,7 +1,6 @@
 #include "backend.h"
 #include "../draw_queue.h"
-#include "../geom/selection_disc.h"
-#include "../geom/selection_ring.h"
+#include <QVector2D>
 #include "backend/character_pipeline.h"
 #include "backend/cylinder_pipeline.h"
 #include "backend/effects_pipeline.h"
@@ -12,6 +11,7 @@
 #include "gl/camera.h"
 #include "gl/resources.h"
 #include "ground/firecamp_gpu.h"
+#include "particle_gpu.h"
 #include "ground/grass_gpu.h"
 #include "ground/pine_gpu.h"
 #include "ground/plant_gpu.h"
@@ -23,6 +23,8 @@
 #include "texture.h"
 #include <GL/gl.h>
 #include <QDebug>
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstddef>
 #include <memory>
@@ -41,11 +43,27 @@ using namespace Render::GL::ComponentCount;
 namespace {
 
 const QVector3D k_grid_line_color(0.22F, 0.25F, 0.22F);
-}
+
+// Every producer fills the same sun direction; with the shared frame block
+// it is uploaded once per frame instead of once per pass.
+const QVector3D k_sun_direction = QVector3D(0.35F, 0.8F, 0.45F).normalized();
+
+// CPU mirror of the std140 FrameUniforms block the pass shaders declare;
+// vec3 members are padded out to vec4 to match the std140 layout.
+struct FrameUniformsGpu {
+  std::array<float, 16> view_proj;
+  std::array<float, 4> light_direction;
+  std::array<float, 4> camera_right;
+  std::array<float, 4> camera_forward;
+  std::array<float, 4> frame_time;
+};
+
+} // namespace
 
 Backend::Backend() = default;
 
 Backend::~Backend() {
+  m_gpuTimers.shutdown();
   m_cylinderPipeline.reset();
   m_vegetationPipeline.reset();
   m_terrainPipeline.reset();
@@ -57,13 +75,14 @@ Backend::~Backend() {
 void Backend::initialize() {
   initializeOpenGLFunctions();
 
-  glEnable(GL_DEPTH_TEST);
+  m_stateCache.invalidate();
+  m_stateCache.setDepthTest(true);
   glDepthFunc(GL_LESS);
   glDepthRange(0.0, 1.0);
-  glDepthMask(GL_TRUE);
+  m_stateCache.setDepthMask(true);
 
-  glEnable(GL_BLEND);
-  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  m_stateCache.setBlend(true);
+  m_stateCache.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
   m_resources = std::make_unique<ResourceManager>();
   if (!m_resources->initialize()) {
@@ -96,6 +115,8 @@ void Backend::initialize() {
       this, m_shaderCache.get());
   m_effectsPipeline->initialize();
 
+  m_gpuTimers.initialize();
+
   m_basicShader = m_shaderCache->get(QStringLiteral("basic"));
   m_gridShader = m_shaderCache->get(QStringLiteral("grid"));
   if (m_basicShader == nullptr) {
@@ -104,6 +125,10 @@ void Backend::initialize() {
   if (m_gridShader == nullptr) {
     qWarning() << "Backend: grid shader missing";
   }
+
+  // Touch every program once while still inside initialization so driver
+  // first-use work does not hitch the first frame that needs a pipeline.
+  m_shaderCache->warmup();
 }
 
 void Backend::beginFrame() {
@@ -116,13 +141,22 @@ void Backend::beginFrame() {
   glClearDepth(1.0);
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-  glEnable(GL_DEPTH_TEST);
+  // Anything outside the backend may have touched the context between
+  // frames, so forget the shadow and re-assert the frame defaults.
+  m_stateCache.invalidate();
+  m_stateCache.setDepthTest(true);
   glDepthFunc(GL_LESS);
-  glDepthMask(GL_TRUE);
+  m_stateCache.setDepthMask(true);
 
   if (m_cylinderPipeline) {
     m_cylinderPipeline->beginFrame();
   }
+  if (m_characterPipeline) {
+    m_characterPipeline->beginFrame();
+  }
+  if (m_resources && (m_resources->uploader() != nullptr)) {
+    m_resources->uploader()->pump();
+  }
 }
 
 void Backend::setViewport(int w, int h) {
@@ -144,1020 +178,1214 @@ void Backend::execute(const DrawQueue &queue, const Camera &cam) {
 
   const QMatrix4x4 view_proj = cam.getProjectionMatrix() * cam.getViewMatrix();
 
+  uploadFrameUniforms(cam, view_proj);
+
   m_lastBoundShader = nullptr;
   m_lastBoundTexture = nullptr;
 
-  const std::size_t count = queue.size();
-  std::size_t i = 0;
-  while (i < count) {
-    const auto &cmd = queue.getSorted(i);
-    switch (cmd.index()) {
-    case CylinderCmdIndex: {
-      if (!m_cylinderPipeline) {
-        ++i;
-        continue;
-      }
-      m_cylinderPipeline->m_cylinderScratch.clear();
-      do {
-        const auto &cy = std::get<CylinderCmdIndex>(queue.getSorted(i));
-        BackendPipelines::CylinderPipeline::CylinderInstanceGpu gpu{};
-        gpu.start = cy.start;
-        gpu.end = cy.end;
-        gpu.radius = cy.radius;
-        gpu.alpha = cy.alpha;
-        gpu.color = cy.color;
-        m_cylinderPipeline->m_cylinderScratch.emplace_back(gpu);
-        ++i;
-      } while (i < count && queue.getSorted(i).index() == CylinderCmdIndex);
-
-      const std::size_t instance_count =
-          m_cylinderPipeline->m_cylinderScratch.size();
-      if (instance_count > 0 &&
-          (m_cylinderPipeline->cylinderShader() != nullptr)) {
-        glDepthMask(GL_TRUE);
-        if (glIsEnabled(GL_POLYGON_OFFSET_FILL) != 0u) {
-          glDisable(GL_POLYGON_OFFSET_FILL);
-        }
-        Shader *cylinderShader = m_cylinderPipeline->cylinderShader();
-        if (m_lastBoundShader != cylinderShader) {
-          cylinderShader->use();
-          m_lastBoundShader = cylinderShader;
-          m_lastBoundTexture = nullptr;
-        }
-        if (m_cylinderPipeline->m_cylinderUniforms.view_proj !=
-            Shader::InvalidUniform) {
-          cylinderShader->setUniform(
-              m_cylinderPipeline->m_cylinderUniforms.view_proj, view_proj);
-        }
-        m_cylinderPipeline->uploadCylinderInstances(instance_count);
-        m_cylinderPipeline->drawCylinders(instance_count);
-      }
+  m_gpuTimers.beginFrame();
+
+  // Each pass drains one typed array; the pass order reproduces the layer
+  // order the old sort keys encoded: terrain under vegetation, then unit
+  // meshes, effect volumes, fog and finally screen-space overlays. The
+  // timer sections group the sections by owning pipeline; water meshes
+  // draw interleaved with characters inside executeMeshes, so they share
+  // the meshes section rather than getting one of their own.
+  m_gpuTimers.beginPass("gpu:terrain");
+  executeTerrainChunks(queue, view_proj);
+  executeGrassBatches(queue);
+  m_gpuTimers.endPass();
+  m_gpuTimers.beginPass("gpu:vegetation");
+  executeStoneBatches(queue);
+  executePlantBatches(queue);
+  executePineBatches(queue);
+  executeFireCampBatches(queue);
+  m_gpuTimers.endPass();
+  m_gpuTimers.beginPass("gpu:meshes");
+  executeMeshes(queue, cam);
+  m_gpuTimers.endPass();
+  m_gpuTimers.beginPass("gpu:cylinders");
+  executeCylinders(queue);
+  m_gpuTimers.endPass();
+  m_gpuTimers.beginPass("gpu:effects");
+  executeParticleBatches(queue);
+  m_gpuTimers.endPass();
+  m_gpuTimers.beginPass("gpu:fog");
+  executeFogBatches(queue);
+  executeFogMasks(queue);
+  m_gpuTimers.endPass();
+  m_gpuTimers.beginPass("gpu:overlay");
+  executeSelectionSmoke(queue);
+  executeGrids(queue);
+  executeSelectionRings(queue);
+  executeHealthBars(queue);
+  m_gpuTimers.endPass();
+
+  if (m_lastBoundShader != nullptr) {
+    m_lastBoundShader->release();
+    m_lastBoundShader = nullptr;
+  }
+
+  // Fence this frame's ring slices so beginFrame can block if the GPU is
+  // still consuming them when the slice comes around again.
+  if (m_cylinderPipeline) {
+    m_cylinderPipeline->endFrame();
+  }
+  if (m_characterPipeline) {
+    m_characterPipeline->endFrame();
+  }
+}
+
+void Backend::uploadFrameUniforms(const Camera &cam,
+                                  const QMatrix4x4 &view_proj) {
+  FrameUniformsGpu frame{};
+  std::copy_n(view_proj.constData(), 16, frame.view_proj.begin());
+
+  frame.light_direction = {k_sun_direction.x(), k_sun_direction.y(),
+                           k_sun_direction.z(), 0.0F};
+
+  QVector3D camera_right = cam.getRightVector();
+  if (camera_right.lengthSquared() < 1e-6F) {
+    camera_right = QVector3D(1.0F, 0.0F, 0.0F);
+  } else {
+    camera_right.normalize();
+  }
+  frame.camera_right = {camera_right.x(), camera_right.y(), camera_right.z(),
+                        0.0F};
+
+  QVector3D camera_forward = cam.getForwardVector();
+  if (camera_forward.lengthSquared() < 1e-6F) {
+    camera_forward = QVector3D(0.0F, 0.0F, -1.0F);
+  } else {
+    camera_forward.normalize();
+  }
+  frame.camera_forward = {camera_forward.x(), camera_forward.y(),
+                          camera_forward.z(), 0.0F};
+
+  frame.frame_time = {m_animationTime, 0.0F, 0.0F, 0.0F};
+
+  if (!m_frameUbo) {
+    m_frameUbo = std::make_unique<Buffer>(Buffer::Type::Uniform);
+  }
+  m_frameUbo->setData(&frame, sizeof(frame), Buffer::Usage::Stream);
+  glBindBufferBase(GL_UNIFORM_BUFFER, UniformBlock::FrameBinding,
+                   m_frameUbo->id());
+}
+
+void Backend::executeCylinders(const DrawQueue &queue) {
+  if (!m_cylinderPipeline || queue.cylinderCmds().empty()) {
+    return;
+  }
+  // Convert straight into the destination span — the persistent-mapped
+  // ring slice when available — instead of staging in CPU scratch and
+  // copying a second time during upload.
+  const std::size_t instance_count = queue.cylinderCmds().size();
+  auto *gpu = m_cylinderPipeline->mapCylinderInstances(instance_count);
+  if (gpu == nullptr) {
+    return;
+  }
+  std::size_t idx = 0;
+  for (const auto &cy : queue.cylinderCmds()) {
+    gpu[idx].start = cy.start;
+    gpu[idx].radius = cy.radius;
+    gpu[idx].end = cy.end;
+    gpu[idx].alpha = cy.alpha;
+    gpu[idx].color = cy.color;
+    gpu[idx].padding = 0.0F;
+    ++idx;
+  }
+
+  if (m_cylinderPipeline->cylinderShader() != nullptr) {
+    m_stateCache.setDepthMask(true);
+    m_stateCache.setPolygonOffsetFill(false);
+    Shader *cylinderShader = m_cylinderPipeline->cylinderShader();
+    if (m_lastBoundShader != cylinderShader) {
+      cylinderShader->use();
+      m_lastBoundShader = cylinderShader;
+      m_lastBoundTexture = nullptr;
+    }
+    m_cylinderPipeline->commitCylinderInstances(instance_count);
+    m_cylinderPipeline->drawCylinders(instance_count);
+  }
+}
+
+void Backend::executeFogBatches(const DrawQueue &queue) {
+  if (!m_cylinderPipeline) {
+    return;
+  }
+  for (const auto &batch : queue.fogBatchCmds()) {
+    const FogInstanceData *instances = batch.instances;
+    const std::size_t instance_count = batch.count;
+    if ((instances == nullptr) || instance_count == 0 ||
+        (m_cylinderPipeline->fogShader() == nullptr)) {
       continue;
     }
-    case FogBatchCmdIndex: {
-      if (!m_cylinderPipeline) {
-        ++i;
-        continue;
-      }
-      const auto &batch = std::get<FogBatchCmdIndex>(cmd);
-      const FogInstanceData *instances = batch.instances;
-      const std::size_t instance_count = batch.count;
-      if ((instances != nullptr) && instance_count > 0 &&
-          (m_cylinderPipeline->fogShader() != nullptr)) {
-        m_cylinderPipeline->m_fogScratch.resize(instance_count);
-        for (std::size_t idx = 0; idx < instance_count; ++idx) {
-          BackendPipelines::CylinderPipeline::FogInstanceGpu gpu{};
-          gpu.center = instances[idx].center;
-          gpu.size = instances[idx].size;
-          gpu.color = instances[idx].color;
-          gpu.alpha = instances[idx].alpha;
-          m_cylinderPipeline->m_fogScratch[idx] = gpu;
-        }
-        glDepthMask(GL_TRUE);
-        if (glIsEnabled(GL_POLYGON_OFFSET_FILL) != 0u) {
-          glDisable(GL_POLYGON_OFFSET_FILL);
-        }
-        Shader *fogShader = m_cylinderPipeline->fogShader();
-        if (m_lastBoundShader != fogShader) {
-          fogShader->use();
-          m_lastBoundShader = fogShader;
-          m_lastBoundTexture = nullptr;
-        }
-        if (m_cylinderPipeline->m_fogUniforms.view_proj !=
-            Shader::InvalidUniform) {
-          fogShader->setUniform(m_cylinderPipeline->m_fogUniforms.view_proj,
-                                view_proj);
-        }
-        m_cylinderPipeline->uploadFogInstances(instance_count);
-        m_cylinderPipeline->drawFog(instance_count);
-      }
-      ++i;
+    // Convert straight into the destination span — the persistent-mapped
+    // ring slice when available — instead of staging in CPU scratch and
+    // copying a second time during upload.
+    auto *gpu = m_cylinderPipeline->mapFogInstances(instance_count);
+    if (gpu == nullptr) {
       continue;
     }
-    case GrassBatchCmdIndex: {
-      const auto &grass = std::get<GrassBatchCmdIndex>(cmd);
-      if ((grass.instanceBuffer == nullptr) || grass.instance_count == 0 ||
-          (m_terrainPipeline->m_grassShader == nullptr) ||
-          (m_terrainPipeline->m_grassVao == 0u) ||
-          m_terrainPipeline->m_grassVertexCount == 0) {
-        break;
-      }
+    for (std::size_t idx = 0; idx < instance_count; ++idx) {
+      gpu[idx].center = instances[idx].center;
+      gpu[idx].size = instances[idx].size;
+      gpu[idx].color = instances[idx].color;
+      gpu[idx].alpha = instances[idx].alpha;
+    }
+    m_stateCache.setDepthMask(true);
+    m_stateCache.setPolygonOffsetFill(false);
+    Shader *fogShader = m_cylinderPipeline->fogShader();
+    if (m_lastBoundShader != fogShader) {
+      fogShader->use();
+      m_lastBoundShader = fogShader;
+      m_lastBoundTexture = nullptr;
+    }
+    m_cylinderPipeline->commitFogInstances(instance_count);
+    m_cylinderPipeline->drawFog(instance_count);
+  }
+}
 
-      DepthMaskScope const depth_mask(false);
-      BlendScope const blend(true);
-      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-      GLboolean const prev_cull = glIsEnabled(GL_CULL_FACE);
-      if (prev_cull != 0u) {
-        glDisable(GL_CULL_FACE);
-      }
+void Backend::executeFogMasks(const DrawQueue &queue) {
+  if (!m_cylinderPipeline) {
+    return;
+  }
+  for (const auto &mask : queue.fogMaskCmds()) {
+    Shader *mask_shader = m_cylinderPipeline->fogMaskShader();
+    if ((mask.cells == nullptr) || mask.width <= 0 || mask.height <= 0 ||
+        (mask_shader == nullptr)) {
+      continue;
+    }
+    m_stateCache.setDepthMask(true);
+    m_stateCache.setPolygonOffsetFill(false);
+    if (m_lastBoundShader != mask_shader) {
+      mask_shader->use();
+      m_lastBoundShader = mask_shader;
+      m_lastBoundTexture = nullptr;
+    }
+    if (m_cylinderPipeline->m_fogMaskUniforms.world_size !=
+        Shader::InvalidUniform) {
+      mask_shader->setUniform(
+          m_cylinderPipeline->m_fogMaskUniforms.world_size,
+          QVector2D(static_cast<float>(mask.width) * mask.tile_size,
+                    static_cast<float>(mask.height) * mask.tile_size));
+    }
+    m_cylinderPipeline->drawFogMask(
+        mask.cells, mask.width, mask.height, mask.version,
+        mask.dirtyBaseVersion, mask.dirtyRowStart, mask.dirtyRowCount,
+        mask.sources, mask.sourceCount);
+    // The mask pass binds its own texture on unit 0.
+    m_lastBoundTexture = nullptr;
+  }
+}
 
-      if (m_lastBoundShader != m_terrainPipeline->m_grassShader) {
-        m_terrainPipeline->m_grassShader->use();
-        m_lastBoundShader = m_terrainPipeline->m_grassShader;
-        m_lastBoundTexture = nullptr;
-      }
+// The vegetation passes below set blend/depth state, bind the shader, and
+// upload the per-type uniforms once, then loop over the batches with only an
+// instance-attrib repoint and a draw each. View-proj, light and time come
+// from the shared frame block; every producer of a given type fills the same
+// wind and flicker parameters, so the rest comes from the first valid
+// command.
+void Backend::executeGrassBatches(const DrawQueue &queue) {
+  if (!m_terrainPipeline || queue.grassBatchCmds().empty() ||
+      (m_terrainPipeline->m_grassShader == nullptr) ||
+      (m_terrainPipeline->m_grassVao == 0u) ||
+      m_terrainPipeline->m_grassVertexCount == 0) {
+    return;
+  }
+  const GrassBatchCmd *first = nullptr;
+  for (const auto &grass : queue.grassBatchCmds()) {
+    if ((grass.instanceBuffer != nullptr) && grass.instance_count != 0) {
+      first = &grass;
+      break;
+    }
+  }
+  if (first == nullptr) {
+    return;
+  }
 
-      if (m_terrainPipeline->m_grassUniforms.view_proj !=
-          Shader::InvalidUniform) {
-        m_terrainPipeline->m_grassShader->setUniform(
-            m_terrainPipeline->m_grassUniforms.view_proj, view_proj);
-      }
-      if (m_terrainPipeline->m_grassUniforms.time != Shader::InvalidUniform) {
-        m_terrainPipeline->m_grassShader->setUniform(
-            m_terrainPipeline->m_grassUniforms.time, grass.params.time);
-      }
-      if (m_terrainPipeline->m_grassUniforms.windStrength !=
-          Shader::InvalidUniform) {
-        m_terrainPipeline->m_grassShader->setUniform(
-            m_terrainPipeline->m_grassUniforms.windStrength,
-            grass.params.windStrength);
-      }
-      if (m_terrainPipeline->m_grassUniforms.windSpeed !=
-          Shader::InvalidUniform) {
-        m_terrainPipeline->m_grassShader->setUniform(
-            m_terrainPipeline->m_grassUniforms.windSpeed,
-            grass.params.windSpeed);
-      }
-      if (m_terrainPipeline->m_grassUniforms.soilColor !=
-          Shader::InvalidUniform) {
-        m_terrainPipeline->m_grassShader->setUniform(
-            m_terrainPipeline->m_grassUniforms.soilColor,
-            grass.params.soilColor);
-      }
-      if (m_terrainPipeline->m_grassUniforms.light_dir !=
-          Shader::InvalidUniform) {
-        QVector3D light_dir = grass.params.light_direction;
-        if (!light_dir.isNull()) {
-          light_dir.normalize();
-        }
-        m_terrainPipeline->m_grassShader->setUniform(
-            m_terrainPipeline->m_grassUniforms.light_dir, light_dir);
-      }
+  DepthMaskScope const depth_mask(m_stateCache, false);
+  BlendScope const blend(m_stateCache, true);
+  m_stateCache.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  const bool prev_cull = m_stateCache.cullFace();
+  m_stateCache.setCullFace(false);
 
-      glBindVertexArray(m_terrainPipeline->m_grassVao);
-      grass.instanceBuffer->bind();
-      const auto stride = static_cast<GLsizei>(sizeof(GrassInstanceGpu));
-      glVertexAttribPointer(
-          TexCoord, Vec4, GL_FLOAT, GL_FALSE, stride,
-          reinterpret_cast<void *>(offsetof(GrassInstanceGpu, posHeight)));
-      glVertexAttribPointer(
-          InstancePosition, Vec4, GL_FLOAT, GL_FALSE, stride,
-          reinterpret_cast<void *>(offsetof(GrassInstanceGpu, colorWidth)));
-      glVertexAttribPointer(
-          InstanceScale, Vec4, GL_FLOAT, GL_FALSE, stride,
-          reinterpret_cast<void *>(offsetof(GrassInstanceGpu, swayParams)));
-      grass.instanceBuffer->unbind();
-
-      glDrawArraysInstanced(GL_TRIANGLES, 0,
-                            m_terrainPipeline->m_grassVertexCount,
-                            static_cast<GLsizei>(grass.instance_count));
-      glBindVertexArray(0);
-
-      if (prev_cull != 0u) {
-        glEnable(GL_CULL_FACE);
-      }
+  if (m_lastBoundShader != m_terrainPipeline->m_grassShader) {
+    m_terrainPipeline->m_grassShader->use();
+    m_lastBoundShader = m_terrainPipeline->m_grassShader;
+    m_lastBoundTexture = nullptr;
+  }
 
+  if (m_terrainPipeline->m_grassUniforms.windStrength !=
+      Shader::InvalidUniform) {
+    m_terrainPipeline->m_grassShader->setUniform(
+        m_terrainPipeline->m_grassUniforms.windStrength,
+        first->params.windStrength);
+  }
+  if (m_terrainPipeline->m_grassUniforms.windSpeed != Shader::InvalidUniform) {
+    m_terrainPipeline->m_grassShader->setUniform(
+        m_terrainPipeline->m_grassUniforms.windSpeed, first->params.windSpeed);
+  }
+  if (m_terrainPipeline->m_grassUniforms.soilColor != Shader::InvalidUniform) {
+    m_terrainPipeline->m_grassShader->setUniform(
+        m_terrainPipeline->m_grassUniforms.soilColor, first->params.soilColor);
+  }
+
+  glBindVertexArray(m_terrainPipeline->m_grassVao);
+  const auto stride = static_cast<GLsizei>(sizeof(GrassInstanceGpu));
+  for (const auto &grass : queue.grassBatchCmds()) {
+    if ((grass.instanceBuffer == nullptr) || grass.instance_count == 0) {
+      continue;
+    }
+    grass.instanceBuffer->bind();
+    glVertexAttribPointer(
+        TexCoord, Vec4, GL_FLOAT, GL_FALSE, stride,
+        reinterpret_cast<void *>(offsetof(GrassInstanceGpu, posHeight)));
+    glVertexAttribPointer(
+        InstancePosition, Vec4, GL_FLOAT, GL_FALSE, stride,
+        reinterpret_cast<void *>(offsetof(GrassInstanceGpu, colorWidth)));
+    glVertexAttribPointer(
+        InstanceScale, Vec4, GL_FLOAT, GL_FALSE, stride,
+        reinterpret_cast<void *>(offsetof(GrassInstanceGpu, swayParams)));
+    grass.instanceBuffer->unbind();
+
+    glDrawArraysInstanced(GL_TRIANGLES, 0,
+                          m_terrainPipeline->m_grassVertexCount,
+                          static_cast<GLsizei>(grass.instance_count));
+  }
+  glBindVertexArray(0);
+
+  m_stateCache.setCullFace(prev_cull);
+}
+
+void Backend::executeStoneBatches(const DrawQueue &queue) {
+  if (!m_vegetationPipeline || queue.stoneBatchCmds().empty() ||
+      (m_vegetationPipeline->stoneShader() == nullptr) ||
+      (m_vegetationPipeline->m_stoneVao == 0u) ||
+      m_vegetationPipeline->m_stoneIndexCount == 0) {
+    return;
+  }
+  bool has_work = false;
+  for (const auto &stone : queue.stoneBatchCmds()) {
+    if ((stone.instanceBuffer != nullptr) && stone.instance_count != 0) {
+      has_work = true;
       break;
     }
-    case StoneBatchCmdIndex: {
-      if (!m_vegetationPipeline) {
-        ++i;
-        continue;
-      }
-      const auto &stone = std::get<StoneBatchCmdIndex>(cmd);
-      if ((stone.instanceBuffer == nullptr) || stone.instance_count == 0 ||
-          (m_vegetationPipeline->stoneShader() == nullptr) ||
-          (m_vegetationPipeline->m_stoneVao == 0u) ||
-          m_vegetationPipeline->m_stoneIndexCount == 0) {
-        break;
-      }
+  }
+  if (!has_work) {
+    return;
+  }
 
-      DepthMaskScope const depth_mask(true);
-      BlendScope const blend(false);
+  DepthMaskScope const depth_mask(m_stateCache, true);
+  BlendScope const blend(m_stateCache, false);
 
-      Shader *stoneShader = m_vegetationPipeline->stoneShader();
-      if (m_lastBoundShader != stoneShader) {
-        stoneShader->use();
-        m_lastBoundShader = stoneShader;
-        m_lastBoundTexture = nullptr;
-      }
+  Shader *stoneShader = m_vegetationPipeline->stoneShader();
+  if (m_lastBoundShader != stoneShader) {
+    stoneShader->use();
+    m_lastBoundShader = stoneShader;
+    m_lastBoundTexture = nullptr;
+  }
 
-      if (m_vegetationPipeline->m_stoneUniforms.view_proj !=
-          Shader::InvalidUniform) {
-        stoneShader->setUniform(m_vegetationPipeline->m_stoneUniforms.view_proj,
-                                view_proj);
-      }
-      if (m_vegetationPipeline->m_stoneUniforms.light_direction !=
-          Shader::InvalidUniform) {
-        QVector3D light_dir = stone.params.light_direction;
-        if (!light_dir.isNull()) {
-          light_dir.normalize();
-        }
-        stoneShader->setUniform(
-            m_vegetationPipeline->m_stoneUniforms.light_direction, light_dir);
-      }
+  glBindVertexArray(m_vegetationPipeline->m_stoneVao);
+  const auto stride = static_cast<GLsizei>(sizeof(StoneInstanceGpu));
+  for (const auto &stone : queue.stoneBatchCmds()) {
+    if ((stone.instanceBuffer == nullptr) || stone.instance_count == 0) {
+      continue;
+    }
+    stone.instanceBuffer->bind();
+    glVertexAttribPointer(
+        TexCoord, Vec4, GL_FLOAT, GL_FALSE, stride,
+        reinterpret_cast<void *>(offsetof(StoneInstanceGpu, posScale)));
+    glVertexAttribPointer(
+        InstancePosition, Vec4, GL_FLOAT, GL_FALSE, stride,
+        reinterpret_cast<void *>(offsetof(StoneInstanceGpu, colorRot)));
+    stone.instanceBuffer->unbind();
+
+    glDrawElementsInstanced(GL_TRIANGLES,
+                            m_vegetationPipeline->m_stoneIndexCount,
+                            GL_UNSIGNED_SHORT, nullptr,
+                            static_cast<GLsizei>(stone.instance_count));
+  }
+  glBindVertexArray(0);
+}
+
+void Backend::executePlantBatches(const DrawQueue &queue) {
+  if (!m_vegetationPipeline || queue.plantBatchCmds().empty() ||
+      (m_vegetationPipeline->plantShader() == nullptr) ||
+      (m_vegetationPipeline->m_plantVao == 0u) ||
+      m_vegetationPipeline->m_plantIndexCount == 0) {
+    return;
+  }
+  const PlantBatchCmd *first = nullptr;
+  for (const auto &plant : queue.plantBatchCmds()) {
+    if ((plant.instanceBuffer != nullptr) && plant.instance_count != 0) {
+      first = &plant;
+      break;
+    }
+  }
+  if (first == nullptr) {
+    return;
+  }
 
-      glBindVertexArray(m_vegetationPipeline->m_stoneVao);
-      stone.instanceBuffer->bind();
-      const auto stride = static_cast<GLsizei>(sizeof(StoneInstanceGpu));
-      glVertexAttribPointer(
-          TexCoord, Vec4, GL_FLOAT, GL_FALSE, stride,
-          reinterpret_cast<void *>(offsetof(StoneInstanceGpu, posScale)));
-      glVertexAttribPointer(
-          InstancePosition, Vec4, GL_FLOAT, GL_FALSE, stride,
-          reinterpret_cast<void *>(offsetof(StoneInstanceGpu, colorRot)));
-      stone.instanceBuffer->unbind();
-
-      glDrawElementsInstanced(GL_TRIANGLES,
-                              m_vegetationPipeline->m_stoneIndexCount,
-                              GL_UNSIGNED_SHORT, nullptr,
-                              static_cast<GLsizei>(stone.instance_count));
-      glBindVertexArray(0);
+  DepthMaskScope const depth_mask(m_stateCache, true);
 
+  m_stateCache.setDepthTest(true);
+  BlendScope const blend(m_stateCache, true);
+  m_stateCache.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  const bool prev_cull = m_stateCache.cullFace();
+  m_stateCache.setCullFace(false);
+
+  Shader *plantShader = m_vegetationPipeline->plantShader();
+  if (m_lastBoundShader != plantShader) {
+    plantShader->use();
+    m_lastBoundShader = plantShader;
+    m_lastBoundTexture = nullptr;
+  }
+
+  if (m_vegetationPipeline->m_plantUniforms.windStrength !=
+      Shader::InvalidUniform) {
+    plantShader->setUniform(m_vegetationPipeline->m_plantUniforms.windStrength,
+                            first->params.windStrength);
+  }
+  if (m_vegetationPipeline->m_plantUniforms.windSpeed !=
+      Shader::InvalidUniform) {
+    plantShader->setUniform(m_vegetationPipeline->m_plantUniforms.windSpeed,
+                            first->params.windSpeed);
+  }
+
+  glBindVertexArray(m_vegetationPipeline->m_plantVao);
+  const auto stride = static_cast<GLsizei>(sizeof(PlantInstanceGpu));
+  for (const auto &plant : queue.plantBatchCmds()) {
+    if ((plant.instanceBuffer == nullptr) || plant.instance_count == 0) {
+      continue;
+    }
+    plant.instanceBuffer->bind();
+    glVertexAttribPointer(
+        InstancePosition, Vec4, GL_FLOAT, GL_FALSE, stride,
+        reinterpret_cast<void *>(offsetof(PlantInstanceGpu, posScale)));
+    glVertexAttribPointer(
+        InstanceScale, Vec4, GL_FLOAT, GL_FALSE, stride,
+        reinterpret_cast<void *>(offsetof(PlantInstanceGpu, colorSway)));
+    glVertexAttribPointer(
+        InstanceColor, Vec4, GL_FLOAT, GL_FALSE, stride,
+        reinterpret_cast<void *>(offsetof(PlantInstanceGpu, typeParams)));
+    plant.instanceBuffer->unbind();
+
+    glDrawElementsInstanced(GL_TRIANGLES,
+                            m_vegetationPipeline->m_plantIndexCount,
+                            GL_UNSIGNED_SHORT, nullptr,
+                            static_cast<GLsizei>(plant.instance_count));
+  }
+  glBindVertexArray(0);
+
+  m_stateCache.setCullFace(prev_cull);
+}
+
+void Backend::executePineBatches(const DrawQueue &queue) {
+  if (!m_vegetationPipeline || queue.pineBatchCmds().empty() ||
+      (m_vegetationPipeline->pineShader() == nullptr) ||
+      (m_vegetationPipeline->m_pineVao == 0u) ||
+      m_vegetationPipeline->m_pineIndexCount == 0) {
+    return;
+  }
+  const PineBatchCmd *first = nullptr;
+  for (const auto &pine : queue.pineBatchCmds()) {
+    if ((pine.instanceBuffer != nullptr) && pine.instance_count != 0) {
+      first = &pine;
       break;
     }
-    case PlantBatchCmdIndex: {
-      if (!m_vegetationPipeline) {
-        ++i;
-        continue;
-      }
-      const auto &plant = std::get<PlantBatchCmdIndex>(cmd);
+  }
+  if (first == nullptr) {
+    return;
+  }
 
-      if ((plant.instanceBuffer == nullptr) || plant.instance_count == 0 ||
-          (m_vegetationPipeline->plantShader() == nullptr) ||
-          (m_vegetationPipeline->m_plantVao == 0u) ||
-          m_vegetationPipeline->m_plantIndexCount == 0) {
-        break;
-      }
+  DepthMaskScope const depth_mask(m_stateCache, true);
+  m_stateCache.setDepthTest(true);
+  BlendScope const blend(m_stateCache, true);
+  m_stateCache.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  const bool prev_cull = m_stateCache.cullFace();
+  m_stateCache.setCullFace(false);
+
+  Shader *pineShader = m_vegetationPipeline->pineShader();
+  if (m_lastBoundShader != pineShader) {
+    pineShader->use();
+    m_lastBoundShader = pineShader;
+    m_lastBoundTexture = nullptr;
+  }
 
-      DepthMaskScope const depth_mask(true);
+  if (m_vegetationPipeline->m_pineUniforms.windStrength !=
+      Shader::InvalidUniform) {
+    pineShader->setUniform(m_vegetationPipeline->m_pineUniforms.windStrength,
+                           first->params.windStrength);
+  }
+  if (m_vegetationPipeline->m_pineUniforms.windSpeed !=
+      Shader::InvalidUniform) {
+    pineShader->setUniform(m_vegetationPipeline->m_pineUniforms.windSpeed,
+                           first->params.windSpeed);
+  }
 
-      glEnable(GL_DEPTH_TEST);
-      BlendScope const blend(true);
-      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-      GLboolean const prev_cull = glIsEnabled(GL_CULL_FACE);
-      if (prev_cull != 0u) {
-        glDisable(GL_CULL_FACE);
-      }
+  glBindVertexArray(m_vegetationPipeline->m_pineVao);
+  const auto stride = static_cast<GLsizei>(sizeof(PineInstanceGpu));
+  for (const auto &pine : queue.pineBatchCmds()) {
+    if ((pine.instanceBuffer == nullptr) || pine.instance_count == 0) {
+      continue;
+    }
+    pine.instanceBuffer->bind();
+    glVertexAttribPointer(
+        InstancePosition, Vec4, GL_FLOAT, GL_FALSE, stride,
+        reinterpret_cast<void *>(offsetof(PineInstanceGpu, posScale)));
+    glVertexAttribPointer(
+        InstanceScale, Vec4, GL_FLOAT, GL_FALSE, stride,
+        reinterpret_cast<void *>(offsetof(PineInstanceGpu, colorSway)));
+    glVertexAttribPointer(
+        InstanceColor, Vec4, GL_FLOAT, GL_FALSE, stride,
+        reinterpret_cast<void *>(offsetof(PineInstanceGpu, rotation)));
+    pine.instanceBuffer->unbind();
+
+    glDrawElementsInstanced(GL_TRIANGLES,
+                            m_vegetationPipeline->m_pineIndexCount,
+                            GL_UNSIGNED_SHORT, nullptr,
+                            static_cast<GLsizei>(pine.instance_count));
+  }
+  glBindVertexArray(0);
 
-      Shader *plantShader = m_vegetationPipeline->plantShader();
-      if (m_lastBoundShader != plantShader) {
-        plantShader->use();
-        m_lastBoundShader = plantShader;
-        m_lastBoundTexture = nullptr;
-      }
+  m_stateCache.setCullFace(prev_cull);
+}
 
-      if (m_vegetationPipeline->m_plantUniforms.view_proj !=
-          Shader::InvalidUniform) {
-        plantShader->setUniform(m_vegetationPipeline->m_plantUniforms.view_proj,
-                                view_proj);
+void Backend::executeFireCampBatches(const DrawQueue &queue) {
+  if (!m_vegetationPipeline || queue.fireCampBatchCmds().empty() ||
+      (m_vegetationPipeline->firecampShader() == nullptr) ||
+      (m_vegetationPipeline->m_firecampVao == 0u) ||
+      m_vegetationPipeline->m_firecampIndexCount == 0) {
+    return;
+  }
+  const FireCampBatchCmd *first = nullptr;
+  for (const auto &firecamp : queue.fireCampBatchCmds()) {
+    if ((firecamp.instanceBuffer != nullptr) && firecamp.instance_count != 0) {
+      first = &firecamp;
+      break;
+    }
+  }
+  if (first == nullptr) {
+    return;
+  }
+
+  DepthMaskScope const depth_mask(m_stateCache, true);
+  m_stateCache.setDepthTest(true);
+  BlendScope const blend(m_stateCache, true);
+  m_stateCache.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  const bool prev_cull = m_stateCache.cullFace();
+  m_stateCache.setCullFace(false);
+
+  Shader *firecampShader = m_vegetationPipeline->firecampShader();
+  if (m_lastBoundShader != firecampShader) {
+    firecampShader->use();
+    m_lastBoundShader = firecampShader;
+    m_lastBoundTexture = nullptr;
+  }
+
+  if (m_vegetationPipeline->m_firecampUniforms.flickerSpeed !=
+      Shader::InvalidUniform) {
+    firecampShader->setUniform(
+        m_vegetationPipeline->m_firecampUniforms.flickerSpeed,
+        first->params.flickerSpeed);
+  }
+  if (m_vegetationPipeline->m_firecampUniforms.flickerAmount !=
+      Shader::InvalidUniform) {
+    firecampShader->setUniform(
+        m_vegetationPipeline->m_firecampUniforms.flickerAmount,
+        first->params.flickerAmount);
+  }
+  if (m_vegetationPipeline->m_firecampUniforms.glowStrength !=
+      Shader::InvalidUniform) {
+    firecampShader->setUniform(
+        m_vegetationPipeline->m_firecampUniforms.glowStrength,
+        first->params.glowStrength);
+  }
+
+  if (m_vegetationPipeline->m_firecampUniforms.fireTexture !=
+      Shader::InvalidUniform) {
+    if (m_resources && (m_resources->white() != nullptr)) {
+      m_resources->white()->bind(0);
+      firecampShader->setUniform(
+          m_vegetationPipeline->m_firecampUniforms.fireTexture, 0);
+    }
+  }
+
+  glBindVertexArray(m_vegetationPipeline->m_firecampVao);
+  const auto stride = static_cast<GLsizei>(sizeof(FireCampInstanceGpu));
+  for (const auto &firecamp : queue.fireCampBatchCmds()) {
+    if ((firecamp.instanceBuffer == nullptr) || firecamp.instance_count == 0) {
+      continue;
+    }
+    firecamp.instanceBuffer->bind();
+    glVertexAttribPointer(InstancePosition, Vec4, GL_FLOAT, GL_FALSE, stride,
+                          reinterpret_cast<void *>(
+                              offsetof(FireCampInstanceGpu, pos_intensity)));
+    glVertexAttribPointer(InstanceScale, Vec4, GL_FLOAT, GL_FALSE, stride,
+                          reinterpret_cast<void *>(
+                              offsetof(FireCampInstanceGpu, radius_phase)));
+    firecamp.instanceBuffer->unbind();
+
+    glDrawElementsInstanced(GL_TRIANGLES,
+                            m_vegetationPipeline->m_firecampIndexCount,
+                            GL_UNSIGNED_SHORT, nullptr,
+                            static_cast<GLsizei>(firecamp.instance_count));
+  }
+  glBindVertexArray(0);
+
+  m_stateCache.setCullFace(prev_cull);
+}
+
+void Backend::executeParticleBatches(const DrawQueue &queue) {
+  if (!m_effectsPipeline || queue.particleBatchCmds().empty() ||
+      (m_effectsPipeline->m_particleShader == nullptr) ||
+      (m_effectsPipeline->m_particleVao == 0u) ||
+      m_effectsPipeline->m_particleIndexCount == 0) {
+    return;
+  }
+  const ParticleBatchCmd *first = nullptr;
+  for (const auto &batch : queue.particleBatchCmds()) {
+    if ((batch.instanceBuffer != nullptr) && batch.instance_count != 0) {
+      first = &batch;
+      break;
+    }
+  }
+  if (first == nullptr) {
+    return;
+  }
+
+  // Additive, depth-tested but not depth-written: particles glow over
+  // each other and never punch holes in later translucent draws.
+  DepthMaskScope const depth_mask(m_stateCache, false);
+  m_stateCache.setDepthTest(true);
+  BlendScope const blend(m_stateCache, true);
+  m_stateCache.setBlendFunc(GL_SRC_ALPHA, GL_ONE);
+  const bool prev_cull = m_stateCache.cullFace();
+  m_stateCache.setCullFace(false);
+
+  Shader *particle_shader = m_effectsPipeline->m_particleShader;
+  if (m_lastBoundShader != particle_shader) {
+    particle_shader->use();
+    m_lastBoundShader = particle_shader;
+    m_lastBoundTexture = nullptr;
+  }
+
+  if (m_effectsPipeline->m_particleUniforms.gravity !=
+      Shader::InvalidUniform) {
+    particle_shader->setUniform(m_effectsPipeline->m_particleUniforms.gravity,
+                                first->params.gravity);
+  }
+
+  glBindVertexArray(m_effectsPipeline->m_particleVao);
+  const auto stride = static_cast<GLsizei>(sizeof(ParticleInstanceGpu));
+  for (const auto &batch : queue.particleBatchCmds()) {
+    if ((batch.instanceBuffer == nullptr) || batch.instance_count == 0) {
+      continue;
+    }
+    batch.instanceBuffer->bind();
+    glVertexAttribPointer(InstancePosition, Vec4, GL_FLOAT, GL_FALSE, stride,
+                          reinterpret_cast<void *>(
+                              offsetof(ParticleInstanceGpu, origin_spawn)));
+    glVertexAttribPointer(InstanceScale, Vec4, GL_FLOAT, GL_FALSE, stride,
+                          reinterpret_cast<void *>(
+                              offsetof(ParticleInstanceGpu, velocity_life)));
+    glVertexAttribPointer(InstanceColor, Vec4, GL_FLOAT, GL_FALSE, stride,
+                          reinterpret_cast<void *>(
+                              offsetof(ParticleInstanceGpu, color_size)));
+    glVertexAttribPointer(
+        InstanceAlpha, Vec4, GL_FLOAT, GL_FALSE, stride,
+        reinterpret_cast<void *>(offsetof(ParticleInstanceGpu, misc)));
+    batch.instanceBuffer->unbind();
+
+    glDrawElementsInstanced(GL_TRIANGLES,
+                            m_effectsPipeline->m_particleIndexCount,
+                            GL_UNSIGNED_SHORT, nullptr,
+                            static_cast<GLsizei>(batch.instance_count));
+  }
+  glBindVertexArray(0);
+
+  m_stateCache.setCullFace(prev_cull);
+}
+
+void Backend::executeTerrainChunks(const DrawQueue &queue,
+                                   const QMatrix4x4 &view_proj) {
+  for (const auto &terrain : queue.terrainChunkCmds()) {
+    Shader *active_shader = terrain.params.isGroundPlane
+                                ? m_terrainPipeline->m_groundShader
+                                : m_terrainPipeline->m_terrainShader;
+
+    if ((terrain.mesh == nullptr) || (active_shader == nullptr)) {
+      continue;
+    }
+
+    if (m_lastBoundShader != active_shader) {
+      active_shader->use();
+      m_lastBoundShader = active_shader;
+      m_lastBoundTexture = nullptr;
+    }
+
+    const QMatrix4x4 mvp = view_proj * terrain.model;
+
+    if (terrain.params.isGroundPlane) {
+
+      if (m_terrainPipeline->m_groundUniforms.mvp != Shader::InvalidUniform) {
+        active_shader->setUniform(m_terrainPipeline->m_groundUniforms.mvp,
+                                  mvp);
       }
-      if (m_vegetationPipeline->m_plantUniforms.time !=
+      if (m_terrainPipeline->m_groundUniforms.model != Shader::InvalidUniform) {
+        active_shader->setUniform(m_terrainPipeline->m_groundUniforms.model,
+                                  terrain.model);
+      }
+      if (m_terrainPipeline->m_groundUniforms.grassPrimary !=
           Shader::InvalidUniform) {
-        plantShader->setUniform(m_vegetationPipeline->m_plantUniforms.time,
-                                plant.params.time);
+        active_shader->setUniform(
+            m_terrainPipeline->m_groundUniforms.grassPrimary,
+            terrain.params.grassPrimary);
       }
-      if (m_vegetationPipeline->m_plantUniforms.windStrength !=
+      if (m_terrainPipeline->m_groundUniforms.grassSecondary !=
           Shader::InvalidUniform) {
-        plantShader->setUniform(
-            m_vegetationPipeline->m_plantUniforms.windStrength,
-            plant.params.windStrength);
+        active_shader->setUniform(
+            m_terrainPipeline->m_groundUniforms.grassSecondary,
+            terrain.params.grassSecondary);
       }
-      if (m_vegetationPipeline->m_plantUniforms.windSpeed !=
+      if (m_terrainPipeline->m_groundUniforms.grassDry !=
           Shader::InvalidUniform) {
-        plantShader->setUniform(m_vegetationPipeline->m_plantUniforms.windSpeed,
-                                plant.params.windSpeed);
+        active_shader->setUniform(m_terrainPipeline->m_groundUniforms.grassDry,
+                                  terrain.params.grassDry);
       }
-      if (m_vegetationPipeline->m_plantUniforms.light_direction !=
+      if (m_terrainPipeline->m_groundUniforms.soilColor !=
           Shader::InvalidUniform) {
-        QVector3D light_dir = plant.params.light_direction;
-        if (!light_dir.isNull()) {
-          light_dir.normalize();
-        }
-        plantShader->setUniform(
-            m_vegetationPipeline->m_plantUniforms.light_direction, light_dir);
+        active_shader->setUniform(
+            m_terrainPipeline->m_groundUniforms.soilColor,
+            terrain.params.soilColor);
       }
-
-      glBindVertexArray(m_vegetationPipeline->m_plantVao);
-      plant.instanceBuffer->bind();
-      const auto stride = static_cast<GLsizei>(sizeof(PlantInstanceGpu));
-      glVertexAttribPointer(
-          InstancePosition, Vec4, GL_FLOAT, GL_FALSE, stride,
-          reinterpret_cast<void *>(offsetof(PlantInstanceGpu, posScale)));
-      glVertexAttribPointer(
-          InstanceScale, Vec4, GL_FLOAT, GL_FALSE, stride,
-          reinterpret_cast<void *>(offsetof(PlantInstanceGpu, colorSway)));
-      glVertexAttribPointer(
-          InstanceColor, Vec4, GL_FLOAT, GL_FALSE, stride,
-          reinterpret_cast<void *>(offsetof(PlantInstanceGpu, typeParams)));
-      plant.instanceBuffer->unbind();
-
-      glDrawElementsInstanced(GL_TRIANGLES,
-                              m_vegetationPipeline->m_plantIndexCount,
-                              GL_UNSIGNED_SHORT, nullptr,
-                              static_cast<GLsizei>(plant.instance_count));
-      glBindVertexArray(0);
-
-      if (prev_cull != 0u) {
-        glEnable(GL_CULL_FACE);
+      if (m_terrainPipeline->m_groundUniforms.tint != Shader::InvalidUniform) {
+        active_shader->setUniform(m_terrainPipeline->m_groundUniforms.tint,
+                                  terrain.params.tint);
       }
-
-      break;
-    }
-    case PineBatchCmdIndex: {
-      if (!m_vegetationPipeline) {
-        ++i;
-        continue;
-      }
-      const auto &pine = std::get<PineBatchCmdIndex>(cmd);
-
-      if ((pine.instanceBuffer == nullptr) || pine.instance_count == 0 ||
-          (m_vegetationPipeline->pineShader() == nullptr) ||
-          (m_vegetationPipeline->m_pineVao == 0u) ||
-          m_vegetationPipeline->m_pineIndexCount == 0) {
-        break;
+      if (m_terrainPipeline->m_groundUniforms.noiseOffset !=
+          Shader::InvalidUniform) {
+        active_shader->setUniform(
+            m_terrainPipeline->m_groundUniforms.noiseOffset,
+            terrain.params.noiseOffset);
       }
-
-      DepthMaskScope const depth_mask(true);
-      glEnable(GL_DEPTH_TEST);
-      BlendScope const blend(true);
-      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-      GLboolean const prev_cull = glIsEnabled(GL_CULL_FACE);
-      if (prev_cull != 0u) {
-        glDisable(GL_CULL_FACE);
+      if (m_terrainPipeline->m_groundUniforms.tile_size !=
+          Shader::InvalidUniform) {
+        active_shader->setUniform(
+            m_terrainPipeline->m_groundUniforms.tile_size,
+            terrain.params.tile_size);
       }
-
-      Shader *pineShader = m_vegetationPipeline->pineShader();
-      if (m_lastBoundShader != pineShader) {
-        pineShader->use();
-        m_lastBoundShader = pineShader;
-        m_lastBoundTexture = nullptr;
+      if (m_terrainPipeline->m_groundUniforms.macroNoiseScale !=
+          Shader::InvalidUniform) {
+        active_shader->setUniform(
+            m_terrainPipeline->m_groundUniforms.macroNoiseScale,
+            terrain.params.macroNoiseScale);
       }
-
-      if (m_vegetationPipeline->m_pineUniforms.view_proj !=
+      if (m_terrainPipeline->m_groundUniforms.detail_noiseScale !=
           Shader::InvalidUniform) {
-        pineShader->setUniform(m_vegetationPipeline->m_pineUniforms.view_proj,
-                               view_proj);
+        active_shader->setUniform(
+            m_terrainPipeline->m_groundUniforms.detail_noiseScale,
+            terrain.params.detail_noiseScale);
       }
-      if (m_vegetationPipeline->m_pineUniforms.time != Shader::InvalidUniform) {
-        pineShader->setUniform(m_vegetationPipeline->m_pineUniforms.time,
-                               pine.params.time);
+      if (m_terrainPipeline->m_groundUniforms.soilBlendHeight !=
+          Shader::InvalidUniform) {
+        active_shader->setUniform(
+            m_terrainPipeline->m_groundUniforms.soilBlendHeight,
+            terrain.params.soilBlendHeight);
       }
-      if (m_vegetationPipeline->m_pineUniforms.windStrength !=
+      if (m_terrainPipeline->m_groundUniforms.soilBlendSharpness !=
           Shader::InvalidUniform) {
-        pineShader->setUniform(
-            m_vegetationPipeline->m_pineUniforms.windStrength,
-            pine.params.windStrength);
+        active_shader->setUniform(
+            m_terrainPipeline->m_groundUniforms.soilBlendSharpness,
+            terrain.params.soilBlendSharpness);
       }
-      if (m_vegetationPipeline->m_pineUniforms.windSpeed !=
+      if (m_terrainPipeline->m_groundUniforms.ambientBoost !=
           Shader::InvalidUniform) {
-        pineShader->setUniform(m_vegetationPipeline->m_pineUniforms.windSpeed,
-                               pine.params.windSpeed);
+        active_shader->setUniform(
+            m_terrainPipeline->m_groundUniforms.ambientBoost,
+            terrain.params.ambientBoost);
       }
-      if (m_vegetationPipeline->m_pineUniforms.light_direction !=
+      if (m_terrainPipeline->m_groundUniforms.light_dir !=
           Shader::InvalidUniform) {
-        QVector3D light_dir = pine.params.light_direction;
+        QVector3D light_dir = terrain.params.light_direction;
         if (!light_dir.isNull()) {
           light_dir.normalize();
         }
-        pineShader->setUniform(
-            m_vegetationPipeline->m_pineUniforms.light_direction, light_dir);
+        active_shader->setUniform(m_terrainPipeline->m_groundUniforms.light_dir,
+                                  light_dir);
       }
+    } else {
 
-      glBindVertexArray(m_vegetationPipeline->m_pineVao);
-      pine.instanceBuffer->bind();
-      const auto stride = static_cast<GLsizei>(sizeof(PineInstanceGpu));
-      glVertexAttribPointer(
-          InstancePosition, Vec4, GL_FLOAT, GL_FALSE, stride,
-          reinterpret_cast<void *>(offsetof(PineInstanceGpu, posScale)));
-      glVertexAttribPointer(
-          InstanceScale, Vec4, GL_FLOAT, GL_FALSE, stride,
-          reinterpret_cast<void *>(offsetof(PineInstanceGpu, colorSway)));
-      glVertexAttribPointer(
-          InstanceColor, Vec4, GL_FLOAT, GL_FALSE, stride,
-          reinterpret_cast<void *>(offsetof(PineInstanceGpu, rotation)));
-      pine.instanceBuffer->unbind();
-
-      glDrawElementsInstanced(GL_TRIANGLES,
-                              m_vegetationPipeline->m_pineIndexCount,
-                              GL_UNSIGNED_SHORT, nullptr,
-                              static_cast<GLsizei>(pine.instance_count));
-      glBindVertexArray(0);
-
-      if (prev_cull != 0u) {
-        glEnable(GL_CULL_FACE);
+      if (m_terrainPipeline->m_terrainUniforms.mvp != Shader::InvalidUniform) {
+        active_shader->setUniform(m_terrainPipeline->m_terrainUniforms.mvp,
+                                  mvp);
       }
-
-      break;
-    }
-    case FireCampBatchCmdIndex: {
-      if (!m_vegetationPipeline) {
-        ++i;
-        continue;
+      if (m_terrainPipeline->m_terrainUniforms.model !=
+          Shader::InvalidUniform) {
+        active_shader->setUniform(m_terrainPipeline->m_terrainUniforms.model,
+                                  terrain.model);
       }
-      const auto &firecamp = std::get<FireCampBatchCmdIndex>(cmd);
-
-      if ((firecamp.instanceBuffer == nullptr) ||
-          firecamp.instance_count == 0 ||
-          (m_vegetationPipeline->firecampShader() == nullptr) ||
-          (m_vegetationPipeline->m_firecampVao == 0u) ||
-          m_vegetationPipeline->m_firecampIndexCount == 0) {
-        break;
+      if (m_terrainPipeline->m_terrainUniforms.grassPrimary !=
+          Shader::InvalidUniform) {
+        active_shader->setUniform(
+            m_terrainPipeline->m_terrainUniforms.grassPrimary,
+            terrain.params.grassPrimary);
       }
-
-      DepthMaskScope const depth_mask(true);
-      glEnable(GL_DEPTH_TEST);
-      BlendScope const blend(true);
-      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-      GLboolean const prev_cull = glIsEnabled(GL_CULL_FACE);
-      if (prev_cull != 0u) {
-        glDisable(GL_CULL_FACE);
+      if (m_terrainPipeline->m_terrainUniforms.grassSecondary !=
+          Shader::InvalidUniform) {
+        active_shader->setUniform(
+            m_terrainPipeline->m_terrainUniforms.grassSecondary,
+            terrain.params.grassSecondary);
       }
-
-      Shader *firecampShader = m_vegetationPipeline->firecampShader();
-      if (m_lastBoundShader != firecampShader) {
-        firecampShader->use();
-        m_lastBoundShader = firecampShader;
-        m_lastBoundTexture = nullptr;
+      if (m_terrainPipeline->m_terrainUniforms.grassDry !=
+          Shader::InvalidUniform) {
+        active_shader->setUniform(
+            m_terrainPipeline->m_terrainUniforms.grassDry,
+            terrain.params.grassDry);
       }
-
-      if (m_vegetationPipeline->m_firecampUniforms.view_proj !=
+      if (m_terrainPipeline->m_terrainUniforms.soilColor !=
           Shader::InvalidUniform) {
-        firecampShader->setUniform(
-            m_vegetationPipeline->m_firecampUniforms.view_proj, view_proj);
+        active_shader->setUniform(
+            m_terrainPipeline->m_terrainUniforms.soilColor,
+            terrain.params.soilColor);
       }
-      if (m_vegetationPipeline->m_firecampUniforms.time !=
+      if (m_terrainPipeline->m_terrainUniforms.rockLow !=
           Shader::InvalidUniform) {
-        firecampShader->setUniform(
-            m_vegetationPipeline->m_firecampUniforms.time,
-            firecamp.params.time);
+        active_shader->setUniform(m_terrainPipeline->m_terrainUniforms.rockLow,
+                                  terrain.params.rockLow);
       }
-      if (m_vegetationPipeline->m_firecampUniforms.flickerSpeed !=
+      if (m_terrainPipeline->m_terrainUniforms.rockHigh !=
           Shader::InvalidUniform) {
-        firecampShader->setUniform(
-            m_vegetationPipeline->m_firecampUniforms.flickerSpeed,
-            firecamp.params.flickerSpeed);
+        active_shader->setUniform(m_terrainPipeline->m_terrainUniforms.rockHigh,
+                                  terrain.params.rockHigh);
       }
-      if (m_vegetationPipeline->m_firecampUniforms.flickerAmount !=
+      if (m_terrainPipeline->m_terrainUniforms.tint != Shader::InvalidUniform) {
+        active_shader->setUniform(m_terrainPipeline->m_terrainUniforms.tint,
+                                  terrain.params.tint);
+      }
+      if (m_terrainPipeline->m_terrainUniforms.noiseOffset !=
           Shader::InvalidUniform) {
-        firecampShader->setUniform(
-            m_vegetationPipeline->m_firecampUniforms.flickerAmount,
-            firecamp.params.flickerAmount);
+        active_shader->setUniform(
+            m_terrainPipeline->m_terrainUniforms.noiseOffset,
+            terrain.params.noiseOffset);
       }
-      if (m_vegetationPipeline->m_firecampUniforms.glowStrength !=
+      if (m_terrainPipeline->m_terrainUniforms.tile_size !=
           Shader::InvalidUniform) {
-        firecampShader->setUniform(
-            m_vegetationPipeline->m_firecampUniforms.glowStrength,
-            firecamp.params.glowStrength);
+        active_shader->setUniform(
+            m_terrainPipeline->m_terrainUniforms.tile_size,
+            terrain.params.tile_size);
       }
-      if (m_vegetationPipeline->m_firecampUniforms.camera_right !=
+      if (m_terrainPipeline->m_terrainUniforms.macroNoiseScale !=
           Shader::InvalidUniform) {
-        QVector3D camera_right = cam.getRightVector();
-        if (camera_right.lengthSquared() < 1e-6F) {
-          camera_right = QVector3D(1.0F, 0.0F, 0.0F);
-        } else {
-          camera_right.normalize();
-        }
-        firecampShader->setUniform(
-            m_vegetationPipeline->m_firecampUniforms.camera_right,
-            camera_right);
+        active_shader->setUniform(
+            m_terrainPipeline->m_terrainUniforms.macroNoiseScale,
+            terrain.params.macroNoiseScale);
       }
-      if (m_vegetationPipeline->m_firecampUniforms.camera_forward !=
+      if (m_terrainPipeline->m_terrainUniforms.detail_noiseScale !=
           Shader::InvalidUniform) {
-        QVector3D camera_forward = cam.getForwardVector();
-        if (camera_forward.lengthSquared() < 1e-6F) {
-          camera_forward = QVector3D(0.0F, 0.0F, -1.0F);
-        } else {
-          camera_forward.normalize();
-        }
-        firecampShader->setUniform(
-            m_vegetationPipeline->m_firecampUniforms.camera_forward,
-            camera_forward);
+        active_shader->setUniform(
+            m_terrainPipeline->m_terrainUniforms.detail_noiseScale,
+            terrain.params.detail_noiseScale);
       }
-
-      if (m_vegetationPipeline->m_firecampUniforms.fireTexture !=
+      if (m_terrainPipeline->m_terrainUniforms.slopeRockThreshold !=
           Shader::InvalidUniform) {
-        if (m_resources && (m_resources->white() != nullptr)) {
-          m_resources->white()->bind(0);
-          firecampShader->setUniform(
-              m_vegetationPipeline->m_firecampUniforms.fireTexture, 0);
-        }
+        active_shader->setUniform(
+            m_terrainPipeline->m_terrainUniforms.slopeRockThreshold,
+            terrain.params.slopeRockThreshold);
       }
-
-      glBindVertexArray(m_vegetationPipeline->m_firecampVao);
-      firecamp.instanceBuffer->bind();
-      const auto stride = static_cast<GLsizei>(sizeof(FireCampInstanceGpu));
-      glVertexAttribPointer(InstancePosition, Vec4, GL_FLOAT, GL_FALSE, stride,
-                            reinterpret_cast<void *>(
-                                offsetof(FireCampInstanceGpu, pos_intensity)));
-      glVertexAttribPointer(InstanceScale, Vec4, GL_FLOAT, GL_FALSE, stride,
-                            reinterpret_cast<void *>(
-                                offsetof(FireCampInstanceGpu, radius_phase)));
-      firecamp.instanceBuffer->unbind();
-
-      glDrawElementsInstanced(GL_TRIANGLES,
-                              m_vegetationPipeline->m_firecampIndexCount,
-                              GL_UNSIGNED_SHORT, nullptr,
-                              static_cast<GLsizei>(firecamp.instance_count));
-      glBindVertexArray(0);
-
-      if (prev_cull != 0u) {
-        glEnable(GL_CULL_FACE);
+      if (m_terrainPipeline->m_terrainUniforms.slopeRockSharpness !=
+          Shader::InvalidUniform) {
+        active_shader->setUniform(
+            m_terrainPipeline->m_terrainUniforms.slopeRockSharpness,
+            terrain.params.slopeRockSharpness);
       }
+      if (m_terrainPipeline->m_terrainUniforms.soilBlendHeight !=
+          Shader::InvalidUniform) {
+        active_shader->setUniform(
+            m_terrainPipeline->m_terrainUniforms.soilBlendHeight,
+            terrain.params.soilBlendHeight);
+      }
+      if (m_terrainPipeline->m_terrainUniforms.soilBlendSharpness !=
+          Shader::InvalidUniform) {
+        active_shader->setUniform(
+            m_terrainPipeline->m_terrainUniforms.soilBlendSharpness,
+            terrain.params.soilBlendSharpness);
+      }
+      if (m_terrainPipeline->m_terrainUniforms.heightNoiseStrength !=
+          Shader::InvalidUniform) {
+        active_shader->setUniform(
+            m_terrainPipeline->m_terrainUniforms.heightNoiseStrength,
+            terrain.params.heightNoiseStrength);
+      }
+      if (m_terrainPipeline->m_terrainUniforms.heightNoiseFrequency !=
+          Shader::InvalidUniform) {
+        active_shader->setUniform(
+            m_terrainPipeline->m_terrainUniforms.heightNoiseFrequency,
+            terrain.params.heightNoiseFrequency);
+      }
+      if (m_terrainPipeline->m_terrainUniforms.ambientBoost !=
+          Shader::InvalidUniform) {
+        active_shader->setUniform(
+            m_terrainPipeline->m_terrainUniforms.ambientBoost,
+            terrain.params.ambientBoost);
+      }
+      if (m_terrainPipeline->m_terrainUniforms.rockDetailStrength !=
+          Shader::InvalidUniform) {
+        active_shader->setUniform(
+            m_terrainPipeline->m_terrainUniforms.rockDetailStrength,
+            terrain.params.rockDetailStrength);
+      }
+      if (m_terrainPipeline->m_terrainUniforms.light_dir !=
+          Shader::InvalidUniform) {
+        QVector3D light_dir = terrain.params.light_direction;
+        if (!light_dir.isNull()) {
+          light_dir.normalize();
+        }
+        active_shader->setUniform(
+            m_terrainPipeline->m_terrainUniforms.light_dir, light_dir);
+      }
+    }
 
-      break;
+    DepthMaskScope const depth_mask(m_stateCache, terrain.depthWrite);
+    std::unique_ptr<PolygonOffsetScope> poly_scope;
+    if (terrain.depthBias != 0.0F) {
+      poly_scope = std::make_unique<PolygonOffsetScope>(
+          m_stateCache, terrain.depthBias, terrain.depthBias);
     }
-    case TerrainChunkCmdIndex: {
-      const auto &terrain = std::get<TerrainChunkCmdIndex>(cmd);
 
-      Shader *active_shader = terrain.params.isGroundPlane
-                                  ? m_terrainPipeline->m_groundShader
-                                  : m_terrainPipeline->m_terrainShader;
+    terrain.mesh->draw();
+  }
+}
 
-      if ((terrain.mesh == nullptr) || (active_shader == nullptr)) {
+void Backend::executeMeshes(const DrawQueue &queue, const Camera &cam) {
+  const auto &cmds = queue.meshCmds();
+  if (cmds.empty()) {
+    return;
+  }
+
+  m_stateCache.setDepthMask(true);
+  m_stateCache.setPolygonOffsetFill(false);
+
+  // Bucket the array by (mesh, texture, shader): opaque unit parts
+  // sharing all three collapse into one instanced draw, while water
+  // meshes, translucent parts and shaders without an instanced
+  // variant keep the one-draw-per-command path in submission order.
+  m_meshBatches.clear();
+  m_meshSingles.clear();
+  for (std::size_t idx = 0; idx < cmds.size(); ++idx) {
+    const auto &mc = cmds[idx];
+    if (mc.mesh == nullptr) {
+      continue;
+    }
+    Shader *shader = (mc.shader != nullptr) ? mc.shader : m_basicShader;
+    if (shader == nullptr) {
+      continue;
+    }
+    if (mc.alpha < 1.0F ||
+        m_characterPipeline->instancedShaderFor(shader) == nullptr) {
+      m_meshSingles.push_back(static_cast<uint32_t>(idx));
+      continue;
+    }
+    MeshBatch *batch = nullptr;
+    for (auto &candidate : m_meshBatches) {
+      if (candidate.mesh == mc.mesh && candidate.texture == mc.texture &&
+          candidate.shader == shader) {
+        batch = &candidate;
         break;
       }
+    }
+    if (batch == nullptr) {
+      m_meshBatches.emplace_back();
+      batch = &m_meshBatches.back();
+      batch->mesh = mc.mesh;
+      batch->texture = mc.texture;
+      batch->shader = shader;
+    }
+    batch->indices.push_back(static_cast<uint32_t>(idx));
+  }
 
-      if (m_lastBoundShader != active_shader) {
-        active_shader->use();
-        m_lastBoundShader = active_shader;
-        m_lastBoundTexture = nullptr;
-      }
+  for (const auto &batch : m_meshBatches) {
+    Shader *instanced = m_characterPipeline->instancedShaderFor(batch.shader);
+    const auto *uniforms = m_characterPipeline->instancedUniformsFor(instanced);
+    if (batch.indices.size() < 2 || uniforms == nullptr) {
+      m_meshSingles.insert(m_meshSingles.end(), batch.indices.begin(),
+                           batch.indices.end());
+      continue;
+    }
 
-      const QMatrix4x4 mvp = view_proj * terrain.model;
+    auto &scratch = m_characterPipeline->m_meshInstanceScratch;
+    scratch.clear();
+    scratch.reserve(batch.indices.size());
+    for (uint32_t const idx : batch.indices) {
+      const auto &mc = cmds[idx];
+      BackendPipelines::CharacterPipeline::MeshInstanceGpu gpu{};
+      std::copy_n(mc.model.constData(), 16, gpu.model.begin());
+      gpu.color = mc.color;
+      gpu.alpha = mc.alpha;
+      scratch.emplace_back(gpu);
+    }
 
-      if (terrain.params.isGroundPlane) {
+    if (m_lastBoundShader != instanced) {
+      instanced->use();
+      m_lastBoundShader = instanced;
+    }
 
-        if (m_terrainPipeline->m_groundUniforms.mvp != Shader::InvalidUniform) {
-          active_shader->setUniform(m_terrainPipeline->m_groundUniforms.mvp,
-                                    mvp);
-        }
-        if (m_terrainPipeline->m_groundUniforms.model !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(m_terrainPipeline->m_groundUniforms.model,
-                                    terrain.model);
-        }
-        if (m_terrainPipeline->m_groundUniforms.grassPrimary !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_groundUniforms.grassPrimary,
-              terrain.params.grassPrimary);
-        }
-        if (m_terrainPipeline->m_groundUniforms.grassSecondary !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_groundUniforms.grassSecondary,
-              terrain.params.grassSecondary);
-        }
-        if (m_terrainPipeline->m_groundUniforms.grassDry !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_groundUniforms.grassDry,
-              terrain.params.grassDry);
-        }
-        if (m_terrainPipeline->m_groundUniforms.soilColor !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_groundUniforms.soilColor,
-              terrain.params.soilColor);
-        }
-        if (m_terrainPipeline->m_groundUniforms.tint !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(m_terrainPipeline->m_groundUniforms.tint,
-                                    terrain.params.tint);
-        }
-        if (m_terrainPipeline->m_groundUniforms.noiseOffset !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_groundUniforms.noiseOffset,
-              terrain.params.noiseOffset);
-        }
-        if (m_terrainPipeline->m_groundUniforms.tile_size !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_groundUniforms.tile_size,
-              terrain.params.tile_size);
-        }
-        if (m_terrainPipeline->m_groundUniforms.macroNoiseScale !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_groundUniforms.macroNoiseScale,
-              terrain.params.macroNoiseScale);
-        }
-        if (m_terrainPipeline->m_groundUniforms.detail_noiseScale !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_groundUniforms.detail_noiseScale,
-              terrain.params.detail_noiseScale);
-        }
-        if (m_terrainPipeline->m_groundUniforms.soilBlendHeight !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_groundUniforms.soilBlendHeight,
-              terrain.params.soilBlendHeight);
-        }
-        if (m_terrainPipeline->m_groundUniforms.soilBlendSharpness !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_groundUniforms.soilBlendSharpness,
-              terrain.params.soilBlendSharpness);
-        }
-        if (m_terrainPipeline->m_groundUniforms.ambientBoost !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_groundUniforms.ambientBoost,
-              terrain.params.ambientBoost);
-        }
-        if (m_terrainPipeline->m_groundUniforms.light_dir !=
-            Shader::InvalidUniform) {
-          QVector3D light_dir = terrain.params.light_direction;
-          if (!light_dir.isNull()) {
-            light_dir.normalize();
-          }
-          active_shader->setUniform(
-              m_terrainPipeline->m_groundUniforms.light_dir, light_dir);
-        }
-      } else {
+    Texture *tex_to_use = (batch.texture != nullptr)
+                              ? batch.texture
+                              : (m_resources ? m_resources->white() : nullptr);
+    if ((tex_to_use != nullptr) && tex_to_use != m_lastBoundTexture) {
+      tex_to_use->bind(0);
+      m_lastBoundTexture = tex_to_use;
+    }
+    instanced->setUniform(uniforms->texture, 0);
+    instanced->setUniform(uniforms->useTexture, batch.texture != nullptr);
 
-        if (m_terrainPipeline->m_terrainUniforms.mvp !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(m_terrainPipeline->m_terrainUniforms.mvp,
-                                    mvp);
-        }
-        if (m_terrainPipeline->m_terrainUniforms.model !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(m_terrainPipeline->m_terrainUniforms.model,
-                                    terrain.model);
-        }
-        if (m_terrainPipeline->m_terrainUniforms.grassPrimary !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_terrainUniforms.grassPrimary,
-              terrain.params.grassPrimary);
-        }
-        if (m_terrainPipeline->m_terrainUniforms.grassSecondary !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_terrainUniforms.grassSecondary,
-              terrain.params.grassSecondary);
-        }
-        if (m_terrainPipeline->m_terrainUniforms.grassDry !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_terrainUniforms.grassDry,
-              terrain.params.grassDry);
-        }
-        if (m_terrainPipeline->m_terrainUniforms.soilColor !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_terrainUniforms.soilColor,
-              terrain.params.soilColor);
-        }
-        if (m_terrainPipeline->m_terrainUniforms.rockLow !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_terrainUniforms.rockLow,
-              terrain.params.rockLow);
-        }
-        if (m_terrainPipeline->m_terrainUniforms.rockHigh !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_terrainUniforms.rockHigh,
-              terrain.params.rockHigh);
-        }
-        if (m_terrainPipeline->m_terrainUniforms.tint !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(m_terrainPipeline->m_terrainUniforms.tint,
-                                    terrain.params.tint);
-        }
-        if (m_terrainPipeline->m_terrainUniforms.noiseOffset !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_terrainUniforms.noiseOffset,
-              terrain.params.noiseOffset);
-        }
-        if (m_terrainPipeline->m_terrainUniforms.tile_size !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_terrainUniforms.tile_size,
-              terrain.params.tile_size);
-        }
-        if (m_terrainPipeline->m_terrainUniforms.macroNoiseScale !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_terrainUniforms.macroNoiseScale,
-              terrain.params.macroNoiseScale);
-        }
-        if (m_terrainPipeline->m_terrainUniforms.detail_noiseScale !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_terrainUniforms.detail_noiseScale,
-              terrain.params.detail_noiseScale);
-        }
-        if (m_terrainPipeline->m_terrainUniforms.slopeRockThreshold !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_terrainUniforms.slopeRockThreshold,
-              terrain.params.slopeRockThreshold);
-        }
-        if (m_terrainPipeline->m_terrainUniforms.slopeRockSharpness !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_terrainUniforms.slopeRockSharpness,
-              terrain.params.slopeRockSharpness);
-        }
-        if (m_terrainPipeline->m_terrainUniforms.soilBlendHeight !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_terrainUniforms.soilBlendHeight,
-              terrain.params.soilBlendHeight);
-        }
-        if (m_terrainPipeline->m_terrainUniforms.soilBlendSharpness !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_terrainUniforms.soilBlendSharpness,
-              terrain.params.soilBlendSharpness);
-        }
-        if (m_terrainPipeline->m_terrainUniforms.heightNoiseStrength !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_terrainUniforms.heightNoiseStrength,
-              terrain.params.heightNoiseStrength);
-        }
-        if (m_terrainPipeline->m_terrainUniforms.heightNoiseFrequency !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_terrainUniforms.heightNoiseFrequency,
-              terrain.params.heightNoiseFrequency);
-        }
-        if (m_terrainPipeline->m_terrainUniforms.ambientBoost !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_terrainUniforms.ambientBoost,
-              terrain.params.ambientBoost);
-        }
-        if (m_terrainPipeline->m_terrainUniforms.rockDetailStrength !=
-            Shader::InvalidUniform) {
-          active_shader->setUniform(
-              m_terrainPipeline->m_terrainUniforms.rockDetailStrength,
-              terrain.params.rockDetailStrength);
-        }
-        if (m_terrainPipeline->m_terrainUniforms.light_dir !=
-            Shader::InvalidUniform) {
-          QVector3D light_dir = terrain.params.light_direction;
-          if (!light_dir.isNull()) {
-            light_dir.normalize();
-          }
-          active_shader->setUniform(
-              m_terrainPipeline->m_terrainUniforms.light_dir, light_dir);
-        }
-      }
+    m_characterPipeline->drawMeshInstanced(batch.mesh, scratch.size());
+  }
 
-      DepthMaskScope const depth_mask(terrain.depthWrite);
-      std::unique_ptr<PolygonOffsetScope> poly_scope;
-      if (terrain.depthBias != 0.0F) {
-        poly_scope = std::make_unique<PolygonOffsetScope>(terrain.depthBias,
-                                                          terrain.depthBias);
-      }
+  // Singles run in array order: the state-key sort keeps opaque
+  // commands grouped by shader and texture, and leaves translucent
+  // parts last in submission order so they still blend the way they
+  // did before batching existed.
+  std::sort(m_meshSingles.begin(), m_meshSingles.end());
+  for (uint32_t const idx : m_meshSingles) {
+    drawMeshSingle(cmds[idx], cam);
+  }
+}
 
-      terrain.mesh->draw();
-      break;
+void Backend::executeGrids(const DrawQueue &queue) {
+  if (m_effectsPipeline->m_gridShader == nullptr) {
+    return;
+  }
+  for (const auto &gc : queue.gridCmds()) {
+    if (m_lastBoundShader != m_effectsPipeline->m_gridShader) {
+      m_effectsPipeline->m_gridShader->use();
+      m_lastBoundShader = m_effectsPipeline->m_gridShader;
     }
-    case MeshCmdIndex: {
-      const auto &it = std::get<MeshCmdIndex>(cmd);
-      if (it.mesh == nullptr) {
-        break;
-      }
 
-      glDepthMask(GL_TRUE);
-      if (glIsEnabled(GL_POLYGON_OFFSET_FILL) != 0u) {
-        glDisable(GL_POLYGON_OFFSET_FILL);
+    m_effectsPipeline->m_gridShader->setUniform(
+        m_effectsPipeline->m_gridUniforms.mvp, gc.mvp);
+    m_effectsPipeline->m_gridShader->setUniform(
+        m_effectsPipeline->m_gridUniforms.model, gc.model);
+    m_effectsPipeline->m_gridShader->setUniform(
+        m_effectsPipeline->m_gridUniforms.gridColor, gc.color);
+    m_effectsPipeline->m_gridShader->setUniform(
+        m_effectsPipeline->m_gridUniforms.lineColor, k_grid_line_color);
+    m_effectsPipeline->m_gridShader->setUniform(
+        m_effectsPipeline->m_gridUniforms.cellSize, gc.cellSize);
+    m_effectsPipeline->m_gridShader->setUniform(
+        m_effectsPipeline->m_gridUniforms.thickness, gc.thickness);
+
+    if (m_resources) {
+      if (auto *plane = m_resources->ground()) {
+        plane->draw();
       }
+    }
+  }
+}
 
-      Shader *active_shader =
-          (it.shader != nullptr) ? it.shader : m_basicShader;
-      if (active_shader == nullptr) {
-        break;
-      }
+void Backend::executeSelectionRings(const DrawQueue &queue) {
+  const auto &cmds = queue.selectionRingCmds();
+  if (cmds.empty() || m_effectsPipeline->m_selectionShader == nullptr) {
+    return;
+  }
 
-      if (active_shader == m_waterPipeline->m_riverShader) {
-        if (m_lastBoundShader != active_shader) {
-          active_shader->use();
-          m_lastBoundShader = active_shader;
-        }
+  // Two instances per ring: the outer halo first, then the inner ring on
+  // top, matching the order of the old per-draw path. Ring models are
+  // translate+scale only, so center and radius come straight out of the
+  // matrix.
+  auto &scratch = m_effectsPipeline->m_ringScratch;
+  scratch.clear();
+  scratch.reserve(cmds.size() * 2);
+  for (const auto &sc : cmds) {
+    const QVector3D center(sc.model(0, 3), sc.model(1, 3), sc.model(2, 3));
+    float const radius = sc.model(0, 0);
+    scratch.push_back({center, radius * 1.08F, sc.color, sc.alphaOuter});
+    scratch.push_back({center, radius, sc.color, sc.alphaInner});
+  }
 
-        active_shader->setUniform(m_waterPipeline->m_riverUniforms.model,
-                                  it.model);
-        active_shader->setUniform(m_waterPipeline->m_riverUniforms.view,
-                                  cam.getViewMatrix());
-        active_shader->setUniform(m_waterPipeline->m_riverUniforms.projection,
-                                  cam.getProjectionMatrix());
-        active_shader->setUniform(m_waterPipeline->m_riverUniforms.time,
-                                  m_animationTime);
+  if (m_lastBoundShader != m_effectsPipeline->m_selectionShader) {
+    m_effectsPipeline->m_selectionShader->use();
+    m_lastBoundShader = m_effectsPipeline->m_selectionShader;
+  }
 
-        it.mesh->draw();
-        break;
-      }
+  DepthMaskScope const depth_mask(m_stateCache, false);
+  DepthTestScope const depth_test(m_stateCache, true);
+  PolygonOffsetScope const poly(m_stateCache, -1.0F, -1.0F);
+  BlendScope const blend(m_stateCache, true);
+  m_stateCache.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-      if (active_shader == m_waterPipeline->m_riverbankShader) {
-        if (m_lastBoundShader != active_shader) {
-          active_shader->use();
-          m_lastBoundShader = active_shader;
-        }
+  m_effectsPipeline->uploadRingInstances(scratch.size());
+  m_effectsPipeline->drawRings(scratch.size());
+}
 
-        active_shader->setUniform(m_waterPipeline->m_riverbankUniforms.model,
-                                  it.model);
-        active_shader->setUniform(m_waterPipeline->m_riverbankUniforms.view,
-                                  cam.getViewMatrix());
-        active_shader->setUniform(
-            m_waterPipeline->m_riverbankUniforms.projection,
-            cam.getProjectionMatrix());
-        active_shader->setUniform(m_waterPipeline->m_riverbankUniforms.time,
-                                  m_animationTime);
+void Backend::executeHealthBars(const DrawQueue &queue) {
+  const auto &cmds = queue.healthBarCmds();
+  if (cmds.empty() || m_effectsPipeline->m_healthBarShader == nullptr) {
+    return;
+  }
 
-        it.mesh->draw();
-        break;
-      }
+  // One instance per bar; the instance layout is shared with the
+  // selection overlays, so width travels in the size slot and the fill
+  // fraction in the alpha slot.
+  auto &scratch = m_effectsPipeline->m_barScratch;
+  scratch.clear();
+  scratch.reserve(cmds.size());
+  for (const auto &hb : cmds) {
+    scratch.push_back({hb.anchor, hb.width, hb.color, hb.fill});
+  }
 
-      if (active_shader == m_waterPipeline->m_bridgeShader) {
-        if (m_lastBoundShader != active_shader) {
-          active_shader->use();
-          m_lastBoundShader = active_shader;
-        }
+  if (m_lastBoundShader != m_effectsPipeline->m_healthBarShader) {
+    m_effectsPipeline->m_healthBarShader->use();
+    m_lastBoundShader = m_effectsPipeline->m_healthBarShader;
+  }
 
-        active_shader->setUniform(m_waterPipeline->m_bridgeUniforms.mvp,
-                                  it.mvp);
-        active_shader->setUniform(m_waterPipeline->m_bridgeUniforms.model,
-                                  it.model);
-        active_shader->setUniform(m_waterPipeline->m_bridgeUniforms.color,
-                                  it.color);
+  DepthMaskScope const depth_mask(m_stateCache, false);
+  DepthTestScope const depth_test(m_stateCache, true);
+  BlendScope const blend(m_stateCache, true);
+  m_stateCache.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-        QVector3D const light_dir(0.35F, 0.8F, 0.45F);
-        active_shader->setUniform(
-            m_waterPipeline->m_bridgeUniforms.light_direction, light_dir);
+  m_effectsPipeline->uploadBarInstances(scratch.size());
+  m_effectsPipeline->drawBars(scratch.size());
+}
 
-        it.mesh->draw();
-        break;
-      }
+void Backend::executeSelectionSmoke(const DrawQueue &queue) {
+  const auto &cmds = queue.selectionSmokeCmds();
+  if (cmds.empty() || m_effectsPipeline->m_selectionShader == nullptr) {
+    return;
+  }
 
-      BackendPipelines::CharacterPipeline::BasicUniforms *uniforms =
-          &m_characterPipeline->m_basicUniforms;
-      if (active_shader == m_characterPipeline->m_archerShader) {
-        uniforms = &m_characterPipeline->m_archerUniforms;
-      } else if (active_shader == m_characterPipeline->m_knightShader) {
-        uniforms = &m_characterPipeline->m_knightUniforms;
-      } else if (active_shader == m_characterPipeline->m_spearmanShader) {
-        uniforms = &m_characterPipeline->m_spearmanUniforms;
-      }
+  // Seven fading, growing discs per command, flattened into one instanced
+  // draw. Smoke models are translate+scale only, so the per-layer scale
+  // folds into the instance size.
+  auto &scratch = m_effectsPipeline->m_discScratch;
+  scratch.clear();
+  scratch.reserve(cmds.size() * 7);
+  for (const auto &sm : cmds) {
+    const QVector3D center(sm.model(0, 3),
+                           sm.model(1, 3) + 0.02F * sm.model(1, 1),
+                           sm.model(2, 3));
+    float const base_scale = sm.model(0, 0);
+    for (int i = 0; i < 7; ++i) {
+      float const scale = base_scale * (1.35F + 0.12F * i);
+      float const alpha = sm.baseAlpha * (1.0F - 0.09F * i);
+      scratch.push_back({center, scale, sm.color, alpha});
+    }
+  }
 
-      if (m_lastBoundShader != active_shader) {
-        active_shader->use();
-        m_lastBoundShader = active_shader;
-      }
+  if (m_lastBoundShader != m_effectsPipeline->m_selectionShader) {
+    m_effectsPipeline->m_selectionShader->use();
+    m_lastBoundShader = m_effectsPipeline->m_selectionShader;
+  }
 
-      active_shader->setUniform(uniforms->mvp, it.mvp);
-      active_shader->setUniform(uniforms->model, it.model);
-
-      Texture *tex_to_use =
-          (it.texture != nullptr)
-              ? it.texture
-              : (m_resources ? m_resources->white() : nullptr);
-      if ((tex_to_use != nullptr) && tex_to_use != m_lastBoundTexture) {
-        tex_to_use->bind(0);
-        m_lastBoundTexture = tex_to_use;
-        active_shader->setUniform(uniforms->texture, 0);
-      }
+  DepthMaskScope const depth_mask(m_stateCache, false);
+  DepthTestScope const depth_test(m_stateCache, true);
+  PolygonOffsetScope const poly(m_stateCache, -1.0F, -1.0F);
+  BlendScope const blend(m_stateCache, true);
+  m_stateCache.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-      active_shader->setUniform(uniforms->useTexture, it.texture != nullptr);
-      active_shader->setUniform(uniforms->color, it.color);
-      active_shader->setUniform(uniforms->alpha, it.alpha);
-      it.mesh->draw();
-      break;
-    }
-    case GridCmdIndex: {
-      if (m_effectsPipeline->m_gridShader == nullptr) {
-        break;
-      }
-      const auto &gc = std::get<GridCmdIndex>(cmd);
+  m_effectsPipeline->uploadDiscInstances(scratch.size());
+  m_effectsPipeline->drawDiscs(scratch.size());
+}
 
-      if (m_lastBoundShader != m_effectsPipeline->m_gridShader) {
-        m_effectsPipeline->m_gridShader->use();
-        m_lastBoundShader = m_effectsPipeline->m_gridShader;
-      }
+void Backend::drawMeshSingle(const MeshCmd &it, const Camera &cam) {
+  Shader *active_shader = (it.shader != nullptr) ? it.shader : m_basicShader;
+  if (active_shader == nullptr) {
+    return;
+  }
 
-      m_effectsPipeline->m_gridShader->setUniform(
-          m_effectsPipeline->m_gridUniforms.mvp, gc.mvp);
-      m_effectsPipeline->m_gridShader->setUniform(
-          m_effectsPipeline->m_gridUniforms.model, gc.model);
-      m_effectsPipeline->m_gridShader->setUniform(
-          m_effectsPipeline->m_gridUniforms.gridColor, gc.color);
-      m_effectsPipeline->m_gridShader->setUniform(
-          m_effectsPipeline->m_gridUniforms.lineColor, k_grid_line_color);
-      m_effectsPipeline->m_gridShader->setUniform(
-          m_effectsPipeline->m_gridUniforms.cellSize, gc.cellSize);
-      m_effectsPipeline->m_gridShader->setUniform(
-          m_effectsPipeline->m_gridUniforms.thickness, gc.thickness);
-
-      if (m_resources) {
-        if (auto *plane = m_resources->ground()) {
-          plane->draw();
-        }
-      }
-      break;
+  if (const auto *river_uniforms =
+          m_waterPipeline->riverUniformsFor(active_shader)) {
+    if (m_lastBoundShader != active_shader) {
+      active_shader->use();
+      m_lastBoundShader = active_shader;
     }
-    case SelectionRingCmdIndex: {
-      const auto &sc = std::get<SelectionRingCmdIndex>(cmd);
-      Mesh *ring = Render::Geom::SelectionRing::get();
-      if (ring == nullptr) {
-        break;
-      }
 
-      if (m_lastBoundShader != m_effectsPipeline->m_basicShader) {
-        m_effectsPipeline->m_basicShader->use();
-        m_lastBoundShader = m_effectsPipeline->m_basicShader;
-      }
+    active_shader->setUniform(river_uniforms->model, it.model);
+    active_shader->setUniform(river_uniforms->view, cam.getViewMatrix());
+    active_shader->setUniform(river_uniforms->projection,
+                              cam.getProjectionMatrix());
+    active_shader->setUniform(river_uniforms->time, m_animationTime);
 
-      m_effectsPipeline->m_basicShader->use();
-      m_effectsPipeline->m_basicShader->setUniform(
-          m_effectsPipeline->m_basicUniforms.useTexture, false);
-      m_effectsPipeline->m_basicShader->setUniform(
-          m_effectsPipeline->m_basicUniforms.color, sc.color);
-
-      DepthMaskScope const depth_mask(false);
-      PolygonOffsetScope const poly(-1.0F, -1.0F);
-      BlendScope const blend(true);
-
-      {
-        QMatrix4x4 m = sc.model;
-        m.scale(1.08F, 1.0F, 1.08F);
-        const QMatrix4x4 mvp = view_proj * m;
-        m_effectsPipeline->m_basicShader->setUniform(
-            m_effectsPipeline->m_basicUniforms.mvp, mvp);
-        m_effectsPipeline->m_basicShader->setUniform(
-            m_effectsPipeline->m_basicUniforms.model, m);
-        m_effectsPipeline->m_basicShader->setUniform(
-            m_effectsPipeline->m_basicUniforms.alpha, sc.alphaOuter);
-        ring->draw();
-      }
+    it.mesh->draw();
+    return;
+  }
 
-      {
-        const QMatrix4x4 mvp = view_proj * sc.model;
-        m_effectsPipeline->m_basicShader->setUniform(
-            m_effectsPipeline->m_basicUniforms.mvp, mvp);
-        m_effectsPipeline->m_basicShader->setUniform(
-            m_effectsPipeline->m_basicUniforms.model, sc.model);
-        m_effectsPipeline->m_basicShader->setUniform(
-            m_effectsPipeline->m_basicUniforms.alpha, sc.alphaInner);
-        ring->draw();
-      }
-      break;
+  if (active_shader == m_waterPipeline->m_riverbankShader) {
+    if (m_lastBoundShader != active_shader) {
+      active_shader->use();
+      m_lastBoundShader = active_shader;
     }
-    case SelectionSmokeCmdIndex: {
-      const auto &sm = std::get<SelectionSmokeCmdIndex>(cmd);
-      Mesh *disc = Render::Geom::SelectionDisc::get();
-      if (disc == nullptr) {
-        break;
-      }
 
-      if (m_lastBoundShader != m_effectsPipeline->m_basicShader) {
-        m_effectsPipeline->m_basicShader->use();
-        m_lastBoundShader = m_effectsPipeline->m_basicShader;
-      }
-      m_effectsPipeline->m_basicShader->setUniform(
-          m_effectsPipeline->m_basicUniforms.useTexture, false);
-      m_effectsPipeline->m_basicShader->setUniform(
-          m_effectsPipeline->m_basicUniforms.color, sm.color);
-      DepthMaskScope const depth_mask(false);
-      DepthTestScope const depth_test(true);
-
-      PolygonOffsetScope const poly(-1.0F, -1.0F);
-      BlendScope const blend(true);
-      for (int i = 0; i < 7; ++i) {
-        float const scale = 1.35F + 0.12F * i;
-        float const a = sm.baseAlpha * (1.0F - 0.09F * i);
-        QMatrix4x4 m = sm.model;
-        m.translate(0.0F, 0.02F, 0.0F);
-        m.scale(scale, 1.0F, scale);
-        const QMatrix4x4 mvp = view_proj * m;
-        m_effectsPipeline->m_basicShader->setUniform(
-            m_effectsPipeline->m_basicUniforms.mvp, mvp);
-        m_effectsPipeline->m_basicShader->setUniform(
-            m_effectsPipeline->m_basicUniforms.model, m);
-        m_effectsPipeline->m_basicShader->setUniform(
-            m_effectsPipeline->m_basicUniforms.alpha, a);
-        disc->draw();
-      }
-      break;
-    }
-    default:
-      break;
+    active_shader->setUniform(m_waterPipeline->m_riverbankUniforms.model,
+                              it.model);
+    active_shader->setUniform(m_waterPipeline->m_riverbankUniforms.view,
+                              cam.getViewMatrix());
+    active_shader->setUniform(
+        m_waterPipeline->m_riverbankUniforms.projection,
+        cam.getProjectionMatrix());
+    active_shader->setUniform(m_waterPipeline->m_riverbankUniforms.time,
+                              m_animationTime);
+
+    it.mesh->draw();
+    return;
+  }
+
+  if (active_shader == m_waterPipeline->m_bridgeShader) {
+    if (m_lastBoundShader != active_shader) {
+      active_shader->use();
+      m_lastBoundShader = active_shader;
     }
-    ++i;
+
+    active_shader->setUniform(m_waterPipeline->m_bridgeUniforms.mvp,
+                              it.mvp);
+    active_shader->setUniform(m_waterPipeline->m_bridgeUniforms.model,
+                              it.model);
+    active_shader->setUniform(m_waterPipeline->m_bridgeUniforms.color,
+                              it.color);
+
+    QVector3D const light_dir(0.35F, 0.8F, 0.45F);
+    active_shader->setUniform(
+        m_waterPipeline->m_bridgeUniforms.light_direction, light_dir);
+
+    it.mesh->draw();
+    return;
   }
-  if (m_lastBoundShader != nullptr) {
-    m_lastBoundShader->release();
-    m_lastBoundShader = nullptr;
+
+  BackendPipelines::CharacterPipeline::BasicUniforms *uniforms =
+      &m_characterPipeline->m_basicUniforms;
+  if (active_shader == m_characterPipeline->m_archerShader) {
+    uniforms = &m_characterPipeline->m_archerUniforms;
+  } else if (active_shader == m_characterPipeline->m_knightShader) {
+    uniforms = &m_characterPipeline->m_knightUniforms;
+  } else if (active_shader == m_characterPipeline->m_spearmanShader) {
+    uniforms = &m_characterPipeline->m_spearmanUniforms;
+  } else if (active_shader == m_characterPipeline->m_impostorShader) {
+    uniforms = &m_characterPipeline->m_impostorUniforms;
+  }
+
+  if (m_lastBoundShader != active_shader) {
+    active_shader->use();
+    m_lastBoundShader = active_shader;
   }
+
+  active_shader->setUniform(uniforms->mvp, it.mvp);
+  active_shader->setUniform(uniforms->model, it.model);
+
+  Texture *tex_to_use =
+      (it.texture != nullptr)
+          ? it.texture
+          : (m_resources ? m_resources->white() : nullptr);
+  if ((tex_to_use != nullptr) && tex_to_use != m_lastBoundTexture) {
+    tex_to_use->bind(0);
+    m_lastBoundTexture = tex_to_use;
+    active_shader->setUniform(uniforms->texture, 0);
+  }
+
+  active_shader->setUniform(uniforms->useTexture, it.texture != nullptr);
+  active_shader->setUniform(uniforms->color, it.color);
+  active_shader->setUniform(uniforms->alpha, it.alpha);
+  it.mesh->draw();
 }
 
 } // namespace Render::GL
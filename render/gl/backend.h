@@ -6,10 +6,12 @@
 #include "../ground/stone_gpu.h"
 #include "../ground/terrain_gpu.h"
 #include "camera.h"
+#include "gpu_timers.h"
 #include "persistent_buffer.h"
 #include "resources.h"
 #include "shader.h"
 #include "shader_cache.h"
+#include "state_scopes.h"
 #include <QOpenGLFunctions_3_3_Core>
 #include <QVector2D>
 #include <QVector3D>
@@ -52,9 +54,23 @@ public:
     return m_resources.get();
   }
 
+  // Rolling GPU milliseconds per execute() section, one frame behind the
+  // draws (results are harvested without stalling).
+  [[nodiscard]] auto gpuTimings() const
+      -> const std::vector<GpuPassTimers::PassTiming> & {
+    return m_gpuTimers.timings();
+  }
+
   [[nodiscard]] auto shader(const QString &name) const -> Shader * {
     return m_shaderCache ? m_shaderCache->get(name) : nullptr;
   }
+  [[nodiscard]] auto shaderHandle(const QString &name) const -> ShaderHandle {
+    return m_shaderCache ? m_shaderCache->handleFor(name)
+                         : InvalidShaderHandle;
+  }
+  [[nodiscard]] auto shader(ShaderHandle handle) const -> Shader * {
+    return m_shaderCache ? m_shaderCache->get(handle) : nullptr;
+  }
   auto getOrLoadShader(const QString &name, const QString &vertPath,
                        const QString &fragPath) -> Shader * {
     if (!m_shaderCache) {
@@ -63,34 +79,20 @@ public:
     return m_shaderCache->load(name, vertPath, fragPath);
   }
 
-  void enableDepthTest(bool enable) {
-    if (enable) {
-      glEnable(GL_DEPTH_TEST);
-    } else {
-      glDisable(GL_DEPTH_TEST);
-    }
-  }
+  void enableDepthTest(bool enable) { m_stateCache.setDepthTest(enable); }
   void setDepthFunc(GLenum func) { glDepthFunc(func); }
-  void setDepthMask(bool write) { glDepthMask(write ? GL_TRUE : GL_FALSE); }
+  void setDepthMask(bool write) { m_stateCache.setDepthMask(write); }
 
-  void enableBlend(bool enable) {
-    if (enable) {
-      glEnable(GL_BLEND);
-    } else {
-      glDisable(GL_BLEND);
-    }
+  void enableBlend(bool enable) { m_stateCache.setBlend(enable); }
+  void setBlendFunc(GLenum src, GLenum dst) {
+    m_stateCache.setBlendFunc(src, dst);
   }
-  void setBlendFunc(GLenum src, GLenum dst) { glBlendFunc(src, dst); }
 
   void enablePolygonOffset(bool enable) {
-    if (enable) {
-      glEnable(GL_POLYGON_OFFSET_FILL);
-    } else {
-      glDisable(GL_POLYGON_OFFSET_FILL);
-    }
+    m_stateCache.setPolygonOffsetFill(enable);
   }
   void setPolygonOffset(float factor, float units) {
-    glPolygonOffset(factor, units);
+    m_stateCache.setPolygonOffset(factor, units);
   }
 
 private:
@@ -109,10 +111,53 @@ private:
   Shader *m_basicShader = nullptr;
   Shader *m_gridShader = nullptr;
 
+  // One bucket of mesh commands sharing (mesh, texture, shader) within a
+  // sorted span; two or more members draw as a single instanced call.
+  struct MeshBatch {
+    Mesh *mesh = nullptr;
+    Texture *texture = nullptr;
+    Shader *shader = nullptr;
+    std::vector<uint32_t> indices;
+  };
+
+  // One pass per typed command array; execute() runs them in the layer
+  // order the sort keys used to encode.
+  void executeTerrainChunks(const DrawQueue &queue,
+                            const QMatrix4x4 &view_proj);
+  void executeGrassBatches(const DrawQueue &queue);
+  void executeStoneBatches(const DrawQueue &queue);
+  void executePlantBatches(const DrawQueue &queue);
+  void executePineBatches(const DrawQueue &queue);
+  void executeFireCampBatches(const DrawQueue &queue);
+  void executeMeshes(const DrawQueue &queue, const Camera &cam);
+  void executeCylinders(const DrawQueue &queue);
+  void executeParticleBatches(const DrawQueue &queue);
+  void executeFogBatches(const DrawQueue &queue);
+  void executeFogMasks(const DrawQueue &queue);
+  void executeSelectionSmoke(const DrawQueue &queue);
+  void executeGrids(const DrawQueue &queue);
+  void executeSelectionRings(const DrawQueue &queue);
+  void executeHealthBars(const DrawQueue &queue);
+
+  void drawMeshSingle(const MeshCmd &it, const Camera &cam);
+
+  // Uploads the std140 FrameUniforms block (view-proj, sun direction,
+  // camera basis, time) and binds it at UniformBlock::FrameBinding for
+  // every pass of the frame.
+  void uploadFrameUniforms(const Camera &cam, const QMatrix4x4 &view_proj);
+
+  std::unique_ptr<Buffer> m_frameUbo;
+
+  std::vector<MeshBatch> m_meshBatches;
+  std::vector<uint32_t> m_meshSingles;
+
   Shader *m_lastBoundShader = nullptr;
   Texture *m_lastBoundTexture = nullptr;
-  bool m_depth_testEnabled = true;
-  bool m_blendEnabled = false;
+
+  // Shadows the toggled GL state so the scopes and passes only reach the
+  // driver on real transitions; invalidated at the top of every frame.
+  StateCache m_stateCache;
+  GpuPassTimers m_gpuTimers;
   float m_animationTime = 0.0F;
 };
 
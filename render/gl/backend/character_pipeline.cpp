@@ -1,11 +1,32 @@
 #include "character_pipeline.h"
 #include "../backend.h"
+#include "../mesh.h"
+#include "../render_constants.h"
 #include "../shader_cache.h"
 #include <QDebug>
+#include <algorithm>
+#include <cstddef>
 #include <qglobal.h>
 
 namespace Render::GL::BackendPipelines {
 
+namespace {
+constexpr std::size_t kInitialMeshInstanceCapacity = 1024;
+constexpr std::size_t kMeshInstanceRingCapacity = 16384;
+} // namespace
+
+void CharacterPipeline::beginFrame() {
+  if (m_meshInstanceRing.isValid()) {
+    m_meshInstanceRing.beginFrame();
+  }
+}
+
+void CharacterPipeline::endFrame() {
+  if (m_meshInstanceRing.isValid()) {
+    m_meshInstanceRing.endFrame();
+  }
+}
+
 auto CharacterPipeline::initialize() -> bool {
   if (m_shaderCache == nullptr) {
     qWarning() << "CharacterPipeline::initialize: null ShaderCache";
@@ -16,6 +37,7 @@ auto CharacterPipeline::initialize() -> bool {
   m_archerShader = m_shaderCache->get("archer");
   m_knightShader = m_shaderCache->get("knight");
   m_spearmanShader = m_shaderCache->get("spearman");
+  m_mountedKnightShader = m_shaderCache->get("mounted_knight");
 
   if (m_basicShader == nullptr) {
     qWarning() << "CharacterPipeline: Failed to load basic shader";
@@ -30,16 +52,39 @@ auto CharacterPipeline::initialize() -> bool {
     qWarning() << "CharacterPipeline: Failed to load spearman shader";
   }
 
+  m_impostorShader = m_shaderCache->get("impostor");
+
+  m_basicInstancedShader = m_shaderCache->get("basic_instanced");
+  m_archerInstancedShader = m_shaderCache->get("archer_instanced");
+  m_knightInstancedShader = m_shaderCache->get("knight_instanced");
+  m_spearmanInstancedShader = m_shaderCache->get("spearman_instanced");
+  m_mountedKnightInstancedShader =
+      m_shaderCache->get("mounted_knight_instanced");
+  m_impostorInstancedShader = m_shaderCache->get("impostor_instanced");
+  if (m_basicInstancedShader == nullptr) {
+    qWarning() << "CharacterPipeline: instanced unit shaders unavailable, "
+                  "falling back to per-part draws";
+  }
+
   cacheUniforms();
 
   return isInitialized();
 }
 
 void CharacterPipeline::shutdown() {
+  shutdownInstancedPipeline();
   m_basicShader = nullptr;
   m_archerShader = nullptr;
   m_knightShader = nullptr;
   m_spearmanShader = nullptr;
+  m_mountedKnightShader = nullptr;
+  m_impostorShader = nullptr;
+  m_basicInstancedShader = nullptr;
+  m_archerInstancedShader = nullptr;
+  m_knightInstancedShader = nullptr;
+  m_spearmanInstancedShader = nullptr;
+  m_mountedKnightInstancedShader = nullptr;
+  m_impostorInstancedShader = nullptr;
 }
 
 void CharacterPipeline::cacheUniforms() {
@@ -47,6 +92,16 @@ void CharacterPipeline::cacheUniforms() {
   cacheArcherUniforms();
   cacheKnightUniforms();
   cacheSpearmanUniforms();
+  cacheImpostorUniforms();
+  cacheInstancedUniforms(m_basicInstancedShader, m_basicInstancedUniforms);
+  cacheInstancedUniforms(m_archerInstancedShader, m_archerInstancedUniforms);
+  cacheInstancedUniforms(m_knightInstancedShader, m_knightInstancedUniforms);
+  cacheInstancedUniforms(m_spearmanInstancedShader,
+                         m_spearmanInstancedUniforms);
+  cacheInstancedUniforms(m_mountedKnightInstancedShader,
+                         m_mountedKnightInstancedUniforms);
+  cacheInstancedUniforms(m_impostorInstancedShader,
+                         m_impostorInstancedUniforms);
 }
 
 auto CharacterPipeline::isInitialized() const -> bool {
@@ -107,4 +162,272 @@ void CharacterPipeline::cacheSpearmanUniforms() {
   m_spearmanUniforms.alpha = m_spearmanShader->uniformHandle("u_alpha");
 }
 
+void CharacterPipeline::cacheImpostorUniforms() {
+  if (m_impostorShader == nullptr) {
+    return;
+  }
+
+  m_impostorUniforms.mvp = m_impostorShader->uniformHandle("u_mvp");
+  m_impostorUniforms.model = m_impostorShader->uniformHandle("u_model");
+  m_impostorUniforms.texture = m_impostorShader->uniformHandle("u_texture");
+  m_impostorUniforms.useTexture =
+      m_impostorShader->uniformHandle("u_useTexture");
+  m_impostorUniforms.color = m_impostorShader->uniformHandle("u_color");
+  m_impostorUniforms.alpha = m_impostorShader->uniformHandle("u_alpha");
+}
+
+void CharacterPipeline::cacheInstancedUniforms(GL::Shader *shader,
+                                               InstancedUniforms &uniforms) {
+  if (shader == nullptr) {
+    return;
+  }
+
+  shader->bindUniformBlock("FrameUniforms", UniformBlock::FrameBinding);
+  uniforms.texture = shader->uniformHandle("u_texture");
+  uniforms.useTexture = shader->uniformHandle("u_useTexture");
+}
+
+auto CharacterPipeline::instancedShaderFor(const GL::Shader *shader) const
+    -> GL::Shader * {
+  if (shader == m_basicShader) {
+    return m_basicInstancedShader;
+  }
+  if (shader == m_archerShader) {
+    return m_archerInstancedShader;
+  }
+  if (shader == m_knightShader) {
+    return m_knightInstancedShader;
+  }
+  if (shader == m_spearmanShader) {
+    return m_spearmanInstancedShader;
+  }
+  if (shader == m_mountedKnightShader) {
+    return m_mountedKnightInstancedShader;
+  }
+  if (shader == m_impostorShader) {
+    return m_impostorInstancedShader;
+  }
+  return nullptr;
+}
+
+auto CharacterPipeline::instancedUniformsFor(const GL::Shader *instanced) const
+    -> const InstancedUniforms * {
+  if (instanced == nullptr) {
+    return nullptr;
+  }
+  if (instanced == m_basicInstancedShader) {
+    return &m_basicInstancedUniforms;
+  }
+  if (instanced == m_archerInstancedShader) {
+    return &m_archerInstancedUniforms;
+  }
+  if (instanced == m_knightInstancedShader) {
+    return &m_knightInstancedUniforms;
+  }
+  if (instanced == m_spearmanInstancedShader) {
+    return &m_spearmanInstancedUniforms;
+  }
+  if (instanced == m_mountedKnightInstancedShader) {
+    return &m_mountedKnightInstancedUniforms;
+  }
+  if (instanced == m_impostorInstancedShader) {
+    return &m_impostorInstancedUniforms;
+  }
+  return nullptr;
+}
+
+auto CharacterPipeline::ensureMeshBuffers(Mesh *mesh) -> MeshGpuBuffers * {
+  auto it = m_meshBuffers.find(mesh);
+  if (it != m_meshBuffers.end()) {
+    return &it->second;
+  }
+
+  const auto &vertices = mesh->getVertices();
+  const auto &indices = mesh->getIndices();
+  if (vertices.empty() || indices.empty()) {
+    return nullptr;
+  }
+
+  initializeOpenGLFunctions();
+
+  if (!m_meshRingAttempted) {
+    m_meshRingAttempted = true;
+    m_meshInstanceRing.initialize(kMeshInstanceRingCapacity,
+                                  BufferCapacity::BuffersInFlight);
+  }
+
+  if (!m_meshInstanceRing.isValid() && m_meshInstanceBuffer == 0u) {
+    glGenBuffers(1, &m_meshInstanceBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, m_meshInstanceBuffer);
+    m_meshInstanceCapacity = kInitialMeshInstanceCapacity;
+    glBufferData(GL_ARRAY_BUFFER,
+                 m_meshInstanceCapacity * sizeof(MeshInstanceGpu), nullptr,
+                 GL_DYNAMIC_DRAW);
+  }
+
+  MeshGpuBuffers buffers;
+
+  glGenVertexArrays(1, &buffers.vao);
+  glBindVertexArray(buffers.vao);
+
+  glGenBuffers(1, &buffers.vertexBuffer);
+  glBindBuffer(GL_ARRAY_BUFFER, buffers.vertexBuffer);
+  glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex),
+               vertices.data(), GL_STATIC_DRAW);
+
+  glGenBuffers(1, &buffers.indexBuffer);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers.indexBuffer);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int),
+               indices.data(), GL_STATIC_DRAW);
+  buffers.indexCount = static_cast<GLsizei>(indices.size());
+
+  glEnableVertexAttribArray(VertexAttrib::Position);
+  glVertexAttribPointer(VertexAttrib::Position, ComponentCount::Vec3, GL_FLOAT,
+                        GL_FALSE, sizeof(Vertex),
+                        reinterpret_cast<void *>(offsetof(Vertex, position)));
+  glEnableVertexAttribArray(VertexAttrib::Normal);
+  glVertexAttribPointer(VertexAttrib::Normal, ComponentCount::Vec3, GL_FLOAT,
+                        GL_FALSE, sizeof(Vertex),
+                        reinterpret_cast<void *>(offsetof(Vertex, normal)));
+  glEnableVertexAttribArray(VertexAttrib::TexCoord);
+  glVertexAttribPointer(VertexAttrib::TexCoord, ComponentCount::Vec2, GL_FLOAT,
+                        GL_FALSE, sizeof(Vertex),
+                        reinterpret_cast<void *>(offsetof(Vertex, tex_coord)));
+
+  glBindBuffer(GL_ARRAY_BUFFER, m_meshInstanceRing.isValid()
+                                    ? m_meshInstanceRing.buffer()
+                                    : m_meshInstanceBuffer);
+  setMeshInstanceAttribPointers(0);
+
+  glBindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+  auto [inserted, ok] = m_meshBuffers.emplace(mesh, buffers);
+  Q_UNUSED(ok);
+  return &inserted->second;
+}
+
+void CharacterPipeline::setMeshInstanceAttribPointers(std::size_t baseOffset) {
+  const auto stride = static_cast<GLsizei>(sizeof(MeshInstanceGpu));
+  // The model matrix spans four consecutive vec4 attributes starting at
+  // VertexAttrib::InstancePosition; the last slot carries color + alpha.
+  for (int column = 0; column < 4; ++column) {
+    const int location = VertexAttrib::InstancePosition + column;
+    glEnableVertexAttribArray(location);
+    glVertexAttribPointer(
+        location, ComponentCount::Vec4, GL_FLOAT, GL_FALSE, stride,
+        reinterpret_cast<void *>(baseOffset + offsetof(MeshInstanceGpu, model) +
+                                 static_cast<std::size_t>(column) * 4 *
+                                     sizeof(float)));
+    glVertexAttribDivisor(location, 1);
+  }
+  glEnableVertexAttribArray(VertexAttrib::InstanceTint);
+  glVertexAttribPointer(VertexAttrib::InstanceTint, ComponentCount::Vec4,
+                        GL_FLOAT, GL_FALSE, stride,
+                        reinterpret_cast<void *>(
+                            baseOffset + offsetof(MeshInstanceGpu, color)));
+  glVertexAttribDivisor(VertexAttrib::InstanceTint, 1);
+}
+
+void CharacterPipeline::uploadMeshInstances(std::size_t count) {
+  if (count == 0 || m_meshInstanceBuffer == 0u) {
+    return;
+  }
+
+  initializeOpenGLFunctions();
+
+  glBindBuffer(GL_ARRAY_BUFFER, m_meshInstanceBuffer);
+  if (count > m_meshInstanceCapacity) {
+    m_meshInstanceCapacity = std::max<std::size_t>(
+        count, (m_meshInstanceCapacity != 0u)
+                   ? m_meshInstanceCapacity * Growth::CapacityMultiplier
+                   : count);
+    glBufferData(GL_ARRAY_BUFFER,
+                 m_meshInstanceCapacity * sizeof(MeshInstanceGpu), nullptr,
+                 GL_DYNAMIC_DRAW);
+    m_meshInstanceScratch.reserve(m_meshInstanceCapacity);
+  }
+  glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(MeshInstanceGpu),
+                  m_meshInstanceScratch.data());
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void CharacterPipeline::drawMeshInstanced(Mesh *mesh, std::size_t count) {
+  if (mesh == nullptr || count == 0) {
+    return;
+  }
+
+  MeshGpuBuffers *buffers = ensureMeshBuffers(mesh);
+  if (buffers == nullptr || buffers->vao == 0u || buffers->indexCount == 0) {
+    return;
+  }
+
+  if (m_meshInstanceRing.isValid()) {
+    std::size_t const remaining =
+        m_meshInstanceRing.capacity() - m_meshInstanceRing.count();
+    if (count > remaining) {
+      count = remaining;
+    }
+    if (count == 0) {
+      return;
+    }
+
+    std::size_t const element_offset =
+        m_meshInstanceRing.write(m_meshInstanceScratch.data(), count);
+    std::size_t const base_offset = m_meshInstanceRing.currentOffset() +
+                                    element_offset * sizeof(MeshInstanceGpu);
+
+    // Batches append within the frame's slice, so the attributes have to be
+    // re-pointed at this batch's byte offset before drawing.
+    glBindVertexArray(buffers->vao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_meshInstanceRing.buffer());
+    setMeshInstanceAttribPointers(base_offset);
+    glDrawElementsInstanced(GL_TRIANGLES, buffers->indexCount, GL_UNSIGNED_INT,
+                            nullptr, static_cast<GLsizei>(count));
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return;
+  }
+
+  uploadMeshInstances(count);
+
+  glBindVertexArray(buffers->vao);
+  glDrawElementsInstanced(GL_TRIANGLES, buffers->indexCount, GL_UNSIGNED_INT,
+                          nullptr, static_cast<GLsizei>(count));
+  glBindVertexArray(0);
+}
+
+void CharacterPipeline::shutdownInstancedPipeline() {
+  if (m_meshBuffers.empty() && m_meshInstanceBuffer == 0u &&
+      !m_meshInstanceRing.isValid()) {
+    return;
+  }
+
+  initializeOpenGLFunctions();
+
+  for (auto &[mesh, buffers] : m_meshBuffers) {
+    Q_UNUSED(mesh);
+    if (buffers.vertexBuffer != 0u) {
+      glDeleteBuffers(1, &buffers.vertexBuffer);
+    }
+    if (buffers.indexBuffer != 0u) {
+      glDeleteBuffers(1, &buffers.indexBuffer);
+    }
+    if (buffers.vao != 0u) {
+      glDeleteVertexArrays(1, &buffers.vao);
+    }
+  }
+  m_meshBuffers.clear();
+
+  if (m_meshInstanceBuffer != 0u) {
+    glDeleteBuffers(1, &m_meshInstanceBuffer);
+    m_meshInstanceBuffer = 0;
+  }
+  m_meshInstanceRing.destroy();
+  m_meshRingAttempted = false;
+  m_meshInstanceCapacity = 0;
+  m_meshInstanceScratch.clear();
+}
+
 } // namespace Render::GL::BackendPipelines
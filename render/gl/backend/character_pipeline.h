@@ -1,11 +1,18 @@
 #pragma once
 
+#include "../persistent_buffer.h"
 #include "../shader.h"
 #include "pipeline_interface.h"
+#include <QVector3D>
+#include <array>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
 
 namespace Render::GL {
 class ShaderCache;
 class Backend;
+class Mesh;
 
 namespace BackendPipelines {
 
@@ -29,24 +36,92 @@ public:
     GL::Shader::UniformHandle alpha{GL::Shader::InvalidUniform};
   };
 
+  // View-proj comes from the shared FrameUniforms block.
+  struct InstancedUniforms {
+    GL::Shader::UniformHandle texture{GL::Shader::InvalidUniform};
+    GL::Shader::UniformHandle useTexture{GL::Shader::InvalidUniform};
+  };
+
+  // Per-instance payload for the batched unit-part path: a column-major
+  // model matrix plus color and alpha, matching unit_instanced.vert.
+  struct MeshInstanceGpu {
+    std::array<float, 16> model;
+    QVector3D color;
+    float alpha;
+  };
+
+  // Returns the instanced variant of a per-unit shader (basic, archer,
+  // knight, spearman, mounted_knight), or nullptr when the shader has no
+  // instanced counterpart and its commands must be drawn one by one.
+  [[nodiscard]] auto instancedShaderFor(const GL::Shader *shader) const
+      -> GL::Shader *;
+  [[nodiscard]] auto instancedUniformsFor(const GL::Shader *instanced) const
+      -> const InstancedUniforms *;
+
+  void beginFrame();
+  void endFrame();
+
+  void uploadMeshInstances(std::size_t count);
+  void drawMeshInstanced(Mesh *mesh, std::size_t count);
+
   GL::Shader *m_basicShader = nullptr;
   GL::Shader *m_archerShader = nullptr;
   GL::Shader *m_knightShader = nullptr;
   GL::Shader *m_spearmanShader = nullptr;
+  GL::Shader *m_mountedKnightShader = nullptr;
+  GL::Shader *m_impostorShader = nullptr;
+
+  GL::Shader *m_basicInstancedShader = nullptr;
+  GL::Shader *m_archerInstancedShader = nullptr;
+  GL::Shader *m_knightInstancedShader = nullptr;
+  GL::Shader *m_spearmanInstancedShader = nullptr;
+  GL::Shader *m_mountedKnightInstancedShader = nullptr;
+  GL::Shader *m_impostorInstancedShader = nullptr;
 
   BasicUniforms m_basicUniforms;
   BasicUniforms m_archerUniforms;
   BasicUniforms m_knightUniforms;
   BasicUniforms m_spearmanUniforms;
+  BasicUniforms m_impostorUniforms;
+
+  InstancedUniforms m_basicInstancedUniforms;
+  InstancedUniforms m_archerInstancedUniforms;
+  InstancedUniforms m_knightInstancedUniforms;
+  InstancedUniforms m_spearmanInstancedUniforms;
+  InstancedUniforms m_mountedKnightInstancedUniforms;
+  InstancedUniforms m_impostorInstancedUniforms;
+
+  std::vector<MeshInstanceGpu> m_meshInstanceScratch;
 
 private:
+  // Instance-capable copy of a part mesh's buffers, built lazily the
+  // first time the mesh shows up in a batched draw.
+  struct MeshGpuBuffers {
+    GLuint vao = 0;
+    GLuint vertexBuffer = 0;
+    GLuint indexBuffer = 0;
+    GLsizei indexCount = 0;
+  };
+
   GL::Backend *m_backend = nullptr;
   GL::ShaderCache *m_shaderCache = nullptr;
 
+  std::unordered_map<const Mesh *, MeshGpuBuffers> m_meshBuffers;
+  GLuint m_meshInstanceBuffer = 0;
+  std::size_t m_meshInstanceCapacity = 0;
+  GL::PersistentRingBuffer<MeshInstanceGpu> m_meshInstanceRing;
+  bool m_meshRingAttempted = false;
+
   void cacheBasicUniforms();
   void cacheArcherUniforms();
   void cacheKnightUniforms();
   void cacheSpearmanUniforms();
+  void cacheImpostorUniforms();
+  void cacheInstancedUniforms(GL::Shader *shader, InstancedUniforms &uniforms);
+
+  auto ensureMeshBuffers(Mesh *mesh) -> MeshGpuBuffers *;
+  void setMeshInstanceAttribPointers(std::size_t baseOffset);
+  void shutdownInstancedPipeline();
 };
 
 } // namespace BackendPipelines
@@ -32,6 +32,7 @@ auto CylinderPipeline::initialize() -> bool {
 
   m_cylinderShader = m_shaderCache->get(QStringLiteral("cylinder_instanced"));
   m_fogShader = m_shaderCache->get(QStringLiteral("fog_instanced"));
+  m_fogMaskShader = m_shaderCache->get(QStringLiteral("fog_mask"));
 
   if ((m_cylinderShader == nullptr) || (m_fogShader == nullptr)) {
     return false;
@@ -39,6 +40,7 @@ auto CylinderPipeline::initialize() -> bool {
 
   initializeCylinderPipeline();
   initializeFogPipeline();
+  initializeFogMaskPipeline();
   cacheUniforms();
 
   m_initialized = true;
@@ -48,17 +50,29 @@ auto CylinderPipeline::initialize() -> bool {
 void CylinderPipeline::shutdown() {
   shutdownCylinderPipeline();
   shutdownFogPipeline();
+  shutdownFogMaskPipeline();
   m_initialized = false;
 }
 
 void CylinderPipeline::cacheUniforms() {
   if (m_cylinderShader != nullptr) {
-    m_cylinderUniforms.view_proj =
-        m_cylinderShader->uniformHandle("u_viewProj");
+    m_cylinderShader->bindUniformBlock("FrameUniforms",
+                                       UniformBlock::FrameBinding);
   }
 
   if (m_fogShader != nullptr) {
-    m_fogUniforms.view_proj = m_fogShader->uniformHandle("u_viewProj");
+    m_fogShader->bindUniformBlock("FrameUniforms", UniformBlock::FrameBinding);
+  }
+
+  if (m_fogMaskShader != nullptr) {
+    m_fogMaskShader->bindUniformBlock("FrameUniforms",
+                                      UniformBlock::FrameBinding);
+    m_fogMaskUniforms.world_size =
+        m_fogMaskShader->uniformHandle("u_worldSize");
+    m_fogMaskUniforms.cells = m_fogMaskShader->uniformHandle("u_cells");
+    m_fogMaskUniforms.source_count =
+        m_fogMaskShader->uniformHandle("u_sourceCount");
+    m_fogMaskUniforms.sources = m_fogMaskShader->uniformHandle("u_sources");
   }
 }
 
@@ -72,6 +86,16 @@ void CylinderPipeline::beginFrame() {
   }
 }
 
+void CylinderPipeline::endFrame() {
+  if (m_cylinderPersistentBuffer.isValid()) {
+    m_cylinderPersistentBuffer.endFrame();
+  }
+
+  if (m_fogPersistentBuffer.isValid()) {
+    m_fogPersistentBuffer.endFrame();
+  }
+}
+
 void CylinderPipeline::initializeCylinderPipeline() {
   initializeOpenGLFunctions();
   shutdownCylinderPipeline();
@@ -129,44 +153,54 @@ void CylinderPipeline::initializeCylinderPipeline() {
                  nullptr, GL_DYNAMIC_DRAW);
   }
 
+  setCylinderInstanceAttribPointers(0);
+
+  glBindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+  m_cylinderScratch.reserve(m_usePersistentBuffers
+                                ? persistent_capacity
+                                : m_cylinderInstanceCapacity);
+}
+
+void CylinderPipeline::setCylinderInstanceAttribPointers(
+    std::size_t baseOffset) {
   const auto stride = static_cast<GLsizei>(sizeof(CylinderInstanceGpu));
   glEnableVertexAttribArray(VertexAttrib::InstancePosition);
-  glVertexAttribPointer(
-      VertexAttrib::InstancePosition, ComponentCount::Vec3, GL_FLOAT, GL_FALSE,
-      stride, reinterpret_cast<void *>(offsetof(CylinderInstanceGpu, start)));
+  glVertexAttribPointer(VertexAttrib::InstancePosition, ComponentCount::Vec3,
+                        GL_FLOAT, GL_FALSE, stride,
+                        reinterpret_cast<void *>(
+                            baseOffset + offsetof(CylinderInstanceGpu, start)));
   glVertexAttribDivisor(VertexAttrib::InstancePosition, 1);
 
   glEnableVertexAttribArray(VertexAttrib::InstanceScale);
-  glVertexAttribPointer(
-      VertexAttrib::InstanceScale, ComponentCount::Vec3, GL_FLOAT, GL_FALSE,
-      stride, reinterpret_cast<void *>(offsetof(CylinderInstanceGpu, end)));
+  glVertexAttribPointer(VertexAttrib::InstanceScale, ComponentCount::Vec3,
+                        GL_FLOAT, GL_FALSE, stride,
+                        reinterpret_cast<void *>(
+                            baseOffset + offsetof(CylinderInstanceGpu, end)));
   glVertexAttribDivisor(VertexAttrib::InstanceScale, 1);
 
   glEnableVertexAttribArray(VertexAttrib::InstanceColor);
   glVertexAttribPointer(
       VertexAttrib::InstanceColor, 1, GL_FLOAT, GL_FALSE, stride,
-      reinterpret_cast<void *>(offsetof(CylinderInstanceGpu, radius)));
+      reinterpret_cast<void *>(baseOffset +
+                               offsetof(CylinderInstanceGpu, radius)));
   glVertexAttribDivisor(VertexAttrib::InstanceColor, 1);
 
   glEnableVertexAttribArray(VertexAttrib::InstanceAlpha);
-  glVertexAttribPointer(
-      VertexAttrib::InstanceAlpha, 1, GL_FLOAT, GL_FALSE, stride,
-      reinterpret_cast<void *>(offsetof(CylinderInstanceGpu, alpha)));
+  glVertexAttribPointer(VertexAttrib::InstanceAlpha, 1, GL_FLOAT, GL_FALSE,
+                        stride,
+                        reinterpret_cast<void *>(
+                            baseOffset + offsetof(CylinderInstanceGpu, alpha)));
   glVertexAttribDivisor(VertexAttrib::InstanceAlpha, 1);
 
   glEnableVertexAttribArray(VertexAttrib::InstanceTint);
-  glVertexAttribPointer(
-      VertexAttrib::InstanceTint, ComponentCount::Vec3, GL_FLOAT, GL_FALSE,
-      stride, reinterpret_cast<void *>(offsetof(CylinderInstanceGpu, color)));
+  glVertexAttribPointer(VertexAttrib::InstanceTint, ComponentCount::Vec3,
+                        GL_FLOAT, GL_FALSE, stride,
+                        reinterpret_cast<void *>(
+                            baseOffset + offsetof(CylinderInstanceGpu, color)));
   glVertexAttribDivisor(VertexAttrib::InstanceTint, 1);
-
-  glBindVertexArray(0);
-  glBindBuffer(GL_ARRAY_BUFFER, 0);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-  m_cylinderScratch.reserve(m_usePersistentBuffers
-                                ? persistent_capacity
-                                : m_cylinderInstanceCapacity);
 }
 
 void CylinderPipeline::shutdownCylinderPipeline() {
@@ -203,12 +237,26 @@ void CylinderPipeline::uploadCylinderInstances(std::size_t count) {
   initializeOpenGLFunctions();
 
   if (m_usePersistentBuffers && m_cylinderPersistentBuffer.isValid()) {
-    if (count > m_cylinderPersistentBuffer.capacity()) {
-      count = m_cylinderPersistentBuffer.capacity();
+    std::size_t const remaining = m_cylinderPersistentBuffer.capacity() -
+                                  m_cylinderPersistentBuffer.count();
+    if (count > remaining) {
+      count = remaining;
+    }
+    if (count == 0) {
+      return;
     }
 
-    m_cylinderPersistentBuffer.write(m_cylinderScratch.data(), count);
+    std::size_t const element_offset =
+        m_cylinderPersistentBuffer.write(m_cylinderScratch.data(), count);
+    std::size_t const base_offset =
+        m_cylinderPersistentBuffer.currentOffset() +
+        element_offset * sizeof(CylinderInstanceGpu);
+
+    // Point the instance attributes at this frame's slice of the ring.
+    glBindVertexArray(m_cylinderVao);
     glBindBuffer(GL_ARRAY_BUFFER, m_cylinderPersistentBuffer.buffer());
+    setCylinderInstanceAttribPointers(base_offset);
+    glBindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     return;
   }
@@ -233,6 +281,53 @@ void CylinderPipeline::uploadCylinderInstances(std::size_t count) {
   glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
+auto CylinderPipeline::mapCylinderInstances(std::size_t count)
+    -> CylinderInstanceGpu * {
+  m_cylinderMappedRange = nullptr;
+  if (count == 0) {
+    return nullptr;
+  }
+  if (m_usePersistentBuffers && m_cylinderPersistentBuffer.isValid()) {
+    m_cylinderMappedRange = m_cylinderPersistentBuffer.mapRange(count);
+    if (m_cylinderMappedRange != nullptr) {
+      return m_cylinderMappedRange;
+    }
+  }
+  m_cylinderScratch.resize(count);
+  return m_cylinderScratch.data();
+}
+
+void CylinderPipeline::commitCylinderInstances(std::size_t count) {
+  if (count == 0) {
+    m_cylinderMappedRange = nullptr;
+    return;
+  }
+
+  if (m_cylinderMappedRange == nullptr) {
+    // Scratch fallback: the existing upload path buffers the staged
+    // instances.
+    uploadCylinderInstances(count);
+    return;
+  }
+
+  initializeOpenGLFunctions();
+
+  // The instances already sit in the mapped slice; just advance the ring
+  // cursor and point the VAO at the committed range.
+  std::size_t const element_offset =
+      m_cylinderPersistentBuffer.commitWrite(count);
+  std::size_t const base_offset = m_cylinderPersistentBuffer.currentOffset() +
+                                  element_offset * sizeof(CylinderInstanceGpu);
+
+  glBindVertexArray(m_cylinderVao);
+  glBindBuffer(GL_ARRAY_BUFFER, m_cylinderPersistentBuffer.buffer());
+  setCylinderInstanceAttribPointers(base_offset);
+  glBindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  m_cylinderMappedRange = nullptr;
+}
+
 void CylinderPipeline::drawCylinders(std::size_t count) {
   if ((m_cylinderVao == 0u) || m_cylinderIndexCount == 0 || count == 0) {
     return;
@@ -284,47 +379,63 @@ void CylinderPipeline::initializeFogPipeline() {
                         GL_FALSE, sizeof(Vertex),
                         reinterpret_cast<void *>(offsetof(Vertex, tex_coord)));
 
-  glGenBuffers(1, &m_fogInstanceBuffer);
-  glBindBuffer(GL_ARRAY_BUFFER, m_fogInstanceBuffer);
-  m_fogInstanceCapacity = BufferCapacity::DefaultFogInstances;
-  glBufferData(GL_ARRAY_BUFFER, m_fogInstanceCapacity * sizeof(FogInstanceGpu),
-               nullptr, GL_DYNAMIC_DRAW);
+  const std::size_t persistent_capacity = 8192;
+  if (m_fogPersistentBuffer.initialize(persistent_capacity,
+                                       BufferCapacity::BuffersInFlight)) {
+    glBindBuffer(GL_ARRAY_BUFFER, m_fogPersistentBuffer.buffer());
+  } else {
+    glGenBuffers(1, &m_fogInstanceBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, m_fogInstanceBuffer);
+    m_fogInstanceCapacity = BufferCapacity::DefaultFogInstances;
+    glBufferData(GL_ARRAY_BUFFER,
+                 m_fogInstanceCapacity * sizeof(FogInstanceGpu), nullptr,
+                 GL_DYNAMIC_DRAW);
+  }
+
+  setFogInstanceAttribPointers(0);
 
+  glBindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+  m_fogScratch.reserve(m_fogPersistentBuffer.isValid() ? persistent_capacity
+                                                       : m_fogInstanceCapacity);
+}
+
+void CylinderPipeline::setFogInstanceAttribPointers(std::size_t baseOffset) {
   const auto stride = static_cast<GLsizei>(sizeof(FogInstanceGpu));
   glEnableVertexAttribArray(VertexAttrib::InstancePosition);
-  glVertexAttribPointer(
-      VertexAttrib::InstancePosition, ComponentCount::Vec3, GL_FLOAT, GL_FALSE,
-      stride, reinterpret_cast<void *>(offsetof(FogInstanceGpu, center)));
+  glVertexAttribPointer(VertexAttrib::InstancePosition, ComponentCount::Vec3,
+                        GL_FLOAT, GL_FALSE, stride,
+                        reinterpret_cast<void *>(
+                            baseOffset + offsetof(FogInstanceGpu, center)));
   glVertexAttribDivisor(VertexAttrib::InstancePosition, 1);
 
   glEnableVertexAttribArray(VertexAttrib::InstanceScale);
   glVertexAttribPointer(
       VertexAttrib::InstanceScale, 1, GL_FLOAT, GL_FALSE, stride,
-      reinterpret_cast<void *>(offsetof(FogInstanceGpu, size)));
+      reinterpret_cast<void *>(baseOffset + offsetof(FogInstanceGpu, size)));
   glVertexAttribDivisor(VertexAttrib::InstanceScale, 1);
 
   glEnableVertexAttribArray(VertexAttrib::InstanceColor);
   glVertexAttribPointer(
       VertexAttrib::InstanceColor, ComponentCount::Vec3, GL_FLOAT, GL_FALSE,
-      stride, reinterpret_cast<void *>(offsetof(FogInstanceGpu, color)));
+      stride,
+      reinterpret_cast<void *>(baseOffset + offsetof(FogInstanceGpu, color)));
   glVertexAttribDivisor(VertexAttrib::InstanceColor, 1);
 
   glEnableVertexAttribArray(VertexAttrib::InstanceAlpha);
   glVertexAttribPointer(
       VertexAttrib::InstanceAlpha, 1, GL_FLOAT, GL_FALSE, stride,
-      reinterpret_cast<void *>(offsetof(FogInstanceGpu, alpha)));
+      reinterpret_cast<void *>(baseOffset + offsetof(FogInstanceGpu, alpha)));
   glVertexAttribDivisor(VertexAttrib::InstanceAlpha, 1);
-
-  glBindVertexArray(0);
-  glBindBuffer(GL_ARRAY_BUFFER, 0);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-  m_fogScratch.reserve(m_fogInstanceCapacity);
 }
 
 void CylinderPipeline::shutdownFogPipeline() {
   initializeOpenGLFunctions();
 
+  m_fogPersistentBuffer.destroy();
+
   if (m_fogInstanceBuffer != 0u) {
     glDeleteBuffers(1, &m_fogInstanceBuffer);
     m_fogInstanceBuffer = 0;
@@ -347,11 +458,39 @@ void CylinderPipeline::shutdownFogPipeline() {
 }
 
 void CylinderPipeline::uploadFogInstances(std::size_t count) {
-  if ((m_fogInstanceBuffer == 0u) || count == 0) {
+  if (count == 0) {
     return;
   }
 
   initializeOpenGLFunctions();
+
+  if (m_fogPersistentBuffer.isValid()) {
+    std::size_t const remaining =
+        m_fogPersistentBuffer.capacity() - m_fogPersistentBuffer.count();
+    if (count > remaining) {
+      count = remaining;
+    }
+    if (count == 0) {
+      return;
+    }
+
+    std::size_t const element_offset =
+        m_fogPersistentBuffer.write(m_fogScratch.data(), count);
+    std::size_t const base_offset = m_fogPersistentBuffer.currentOffset() +
+                                    element_offset * sizeof(FogInstanceGpu);
+
+    glBindVertexArray(m_fogVao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_fogPersistentBuffer.buffer());
+    setFogInstanceAttribPointers(base_offset);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return;
+  }
+
+  if (m_fogInstanceBuffer == 0u) {
+    return;
+  }
+
   glBindBuffer(GL_ARRAY_BUFFER, m_fogInstanceBuffer);
   if (count > m_fogInstanceCapacity) {
     m_fogInstanceCapacity = std::max<std::size_t>(
@@ -368,6 +507,167 @@ void CylinderPipeline::uploadFogInstances(std::size_t count) {
   glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
+auto CylinderPipeline::mapFogInstances(std::size_t count) -> FogInstanceGpu * {
+  m_fogMappedRange = nullptr;
+  if (count == 0) {
+    return nullptr;
+  }
+  if (m_fogPersistentBuffer.isValid()) {
+    m_fogMappedRange = m_fogPersistentBuffer.mapRange(count);
+    if (m_fogMappedRange != nullptr) {
+      return m_fogMappedRange;
+    }
+  }
+  m_fogScratch.resize(count);
+  return m_fogScratch.data();
+}
+
+void CylinderPipeline::commitFogInstances(std::size_t count) {
+  if (count == 0) {
+    m_fogMappedRange = nullptr;
+    return;
+  }
+
+  if (m_fogMappedRange == nullptr) {
+    // Scratch fallback: the existing upload path memcpys or buffers the
+    // staged instances.
+    uploadFogInstances(count);
+    return;
+  }
+
+  initializeOpenGLFunctions();
+
+  // The instances already sit in the mapped slice; just advance the ring
+  // cursor and point the VAO at the committed range.
+  std::size_t const element_offset = m_fogPersistentBuffer.commitWrite(count);
+  std::size_t const base_offset = m_fogPersistentBuffer.currentOffset() +
+                                  element_offset * sizeof(FogInstanceGpu);
+
+  glBindVertexArray(m_fogVao);
+  glBindBuffer(GL_ARRAY_BUFFER, m_fogPersistentBuffer.buffer());
+  setFogInstanceAttribPointers(base_offset);
+  glBindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  m_fogMappedRange = nullptr;
+}
+
+void CylinderPipeline::initializeFogMaskPipeline() {
+  initializeOpenGLFunctions();
+  shutdownFogMaskPipeline();
+
+  if (m_fogVertexBuffer == 0u || m_fogIndexBuffer == 0u) {
+    return;
+  }
+
+  // The mask pass reuses the unit fog quad; only the position attribute is
+  // needed, the world extent comes from a uniform.
+  glGenVertexArrays(1, &m_fogMaskVao);
+  glBindVertexArray(m_fogMaskVao);
+  glBindBuffer(GL_ARRAY_BUFFER, m_fogVertexBuffer);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_fogIndexBuffer);
+  glEnableVertexAttribArray(VertexAttrib::Position);
+  glVertexAttribPointer(VertexAttrib::Position, ComponentCount::Vec3, GL_FLOAT,
+                        GL_FALSE, sizeof(Vertex),
+                        reinterpret_cast<void *>(offsetof(Vertex, position)));
+  glBindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+  glGenTextures(1, &m_fogMaskTexture);
+  glBindTexture(GL_TEXTURE_2D, m_fogMaskTexture);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void CylinderPipeline::shutdownFogMaskPipeline() {
+  initializeOpenGLFunctions();
+
+  if (m_fogMaskTexture != 0u) {
+    glDeleteTextures(1, &m_fogMaskTexture);
+    m_fogMaskTexture = 0;
+  }
+  if (m_fogMaskVao != 0u) {
+    glDeleteVertexArrays(1, &m_fogMaskVao);
+    m_fogMaskVao = 0;
+  }
+  m_fogMaskTexWidth = 0;
+  m_fogMaskTexHeight = 0;
+  m_fogMaskUploadedVersion = ~0ULL;
+}
+
+void CylinderPipeline::drawFogMask(const std::uint8_t *cells, int width,
+                                   int height, std::uint64_t version,
+                                   std::uint64_t dirtyBaseVersion,
+                                   int dirtyRowStart, int dirtyRowCount,
+                                   const QVector4D *sources,
+                                   std::size_t sourceCount) {
+  if ((m_fogMaskVao == 0u) || (m_fogMaskTexture == 0u) || (cells == nullptr) ||
+      width <= 0 || height <= 0) {
+    return;
+  }
+
+  initializeOpenGLFunctions();
+
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_2D, m_fogMaskTexture);
+
+  if (width != m_fogMaskTexWidth || height != m_fogMaskTexHeight) {
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width, height, 0, GL_RED,
+                 GL_UNSIGNED_BYTE, nullptr);
+    m_fogMaskTexWidth = width;
+    m_fogMaskTexHeight = height;
+    m_fogMaskUploadedVersion = ~0ULL;
+  }
+
+  if (version != m_fogMaskUploadedVersion) {
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    const bool partial = dirtyRowCount >= 0 &&
+                         m_fogMaskUploadedVersion == dirtyBaseVersion &&
+                         dirtyRowStart >= 0 &&
+                         dirtyRowStart + dirtyRowCount <= height;
+    if (partial) {
+      if (dirtyRowCount > 0) {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, dirtyRowStart, width,
+                        dirtyRowCount, GL_RED, GL_UNSIGNED_BYTE,
+                        cells + static_cast<std::size_t>(dirtyRowStart) *
+                                    static_cast<std::size_t>(width));
+      }
+    } else {
+      glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RED,
+                      GL_UNSIGNED_BYTE, cells);
+    }
+    m_fogMaskUploadedVersion = version;
+  }
+
+  const auto clamped = static_cast<GLsizei>(std::min<std::size_t>(
+      sourceCount, static_cast<std::size_t>(kMaxFogSources)));
+  if (m_fogMaskShader != nullptr) {
+    if (m_fogMaskUniforms.cells != Shader::InvalidUniform) {
+      m_fogMaskShader->setUniform(m_fogMaskUniforms.cells, 0);
+    }
+    if (m_fogMaskUniforms.source_count != Shader::InvalidUniform) {
+      m_fogMaskShader->setUniform(m_fogMaskUniforms.source_count,
+                                  static_cast<int>(clamped));
+    }
+  }
+  if (m_fogMaskUniforms.sources != Shader::InvalidUniform && clamped > 0 &&
+      (sources != nullptr)) {
+    glUniform4fv(m_fogMaskUniforms.sources, clamped,
+                 reinterpret_cast<const GLfloat *>(sources));
+  }
+
+  glBindVertexArray(m_fogMaskVao);
+  glDrawElements(GL_TRIANGLES, Geometry::QuadIndexCount, GL_UNSIGNED_INT,
+                 nullptr);
+  glBindVertexArray(0);
+  glBindTexture(GL_TEXTURE_2D, 0);
+}
+
 void CylinderPipeline::drawFog(std::size_t count) {
   if ((m_fogVao == 0u) || m_fogIndexCount == 0 || count == 0) {
     return;
@@ -4,6 +4,8 @@
 #include "../shader_cache.h"
 #include "pipeline_interface.h"
 #include <QVector3D>
+#include <QVector4D>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -22,6 +24,7 @@ public:
   }
 
   void beginFrame();
+  void endFrame();
 
   void uploadCylinderInstances(std::size_t count);
   void drawCylinders(std::size_t count);
@@ -29,17 +32,32 @@ public:
   void uploadFogInstances(std::size_t count);
   void drawFog(std::size_t count);
 
+  // Draws the fog mask quad: re-uploads the R8 cell texture only when
+  // `version` changed, uploads the vision-source uniform buffer (clamped
+  // to kMaxFogSources), and issues one quad draw. The shader must already
+  // be bound with the frame uniforms set.
+  void drawFogMask(const std::uint8_t *cells, int width, int height,
+                   std::uint64_t version, std::uint64_t dirtyBaseVersion,
+                   int dirtyRowStart, int dirtyRowCount,
+                   const QVector4D *sources, std::size_t sourceCount);
+
+  static constexpr int kMaxFogSources = 256;
+
   [[nodiscard]] auto cylinderShader() const -> GL::Shader * {
     return m_cylinderShader;
   }
   [[nodiscard]] auto fogShader() const -> GL::Shader * { return m_fogShader; }
+  [[nodiscard]] auto fogMaskShader() const -> GL::Shader * {
+    return m_fogMaskShader;
+  }
 
-  struct CylinderUniforms {
-    GL::Shader::UniformHandle view_proj{GL::Shader::InvalidUniform};
-  };
-
-  struct FogUniforms {
-    GL::Shader::UniformHandle view_proj{GL::Shader::InvalidUniform};
+  // View-proj comes from the shared FrameUniforms block; the cylinder and
+  // fog shaders need nothing beyond it, the mask keeps its own uniforms.
+  struct FogMaskUniforms {
+    GL::Shader::UniformHandle world_size{GL::Shader::InvalidUniform};
+    GL::Shader::UniformHandle cells{GL::Shader::InvalidUniform};
+    GL::Shader::UniformHandle source_count{GL::Shader::InvalidUniform};
+    GL::Shader::UniformHandle sources{GL::Shader::InvalidUniform};
   };
 
   struct CylinderInstanceGpu {
@@ -58,8 +76,18 @@ public:
     float alpha{1.0F};
   };
 
-  CylinderUniforms m_cylinderUniforms;
-  FogUniforms m_fogUniforms;
+  // Zero-copy instance upload, same contract for both shapes: map returns
+  // a writable span for the next `count` instances — the persistent-mapped ring slice when it is
+  // available and the range fits, CPU scratch otherwise — and
+  // commitFogInstances finalizes whichever destination was handed out.
+  // Pairs one-to-one; the span is only valid until the commit.
+  [[nodiscard]] auto
+  mapCylinderInstances(std::size_t count) -> CylinderInstanceGpu *;
+  void commitCylinderInstances(std::size_t count);
+  [[nodiscard]] auto mapFogInstances(std::size_t count) -> FogInstanceGpu *;
+  void commitFogInstances(std::size_t count);
+
+  FogMaskUniforms m_fogMaskUniforms;
   std::vector<CylinderInstanceGpu> m_cylinderScratch;
   std::vector<FogInstanceGpu> m_fogScratch;
 
@@ -68,6 +96,14 @@ private:
   void shutdownCylinderPipeline();
   void initializeFogPipeline();
   void shutdownFogPipeline();
+  void initializeFogMaskPipeline();
+  void shutdownFogMaskPipeline();
+
+  // Instance attribute pointers for the currently bound VAO/buffer, with
+  // the ring's frame slice folded into the byte offset. Ring-backed paths
+  // re-run this each frame; the fallback buffers use a base of zero.
+  void setCylinderInstanceAttribPointers(std::size_t baseOffset);
+  void setFogInstanceAttribPointers(std::size_t baseOffset);
 
   GL::ShaderCache *m_shaderCache;
   bool m_initialized{false};
@@ -81,6 +117,10 @@ private:
   GLsizei m_cylinderIndexCount{0};
   std::size_t m_cylinderInstanceCapacity{0};
   GL::PersistentRingBuffer<CylinderInstanceGpu> m_cylinderPersistentBuffer;
+  // Non-null between a mapCylinderInstances that handed out the mapped
+  // ring slice and its commitCylinderInstances; null means the scratch
+  // fallback.
+  CylinderInstanceGpu *m_cylinderMappedRange{nullptr};
 
   GL::Shader *m_fogShader{nullptr};
   GLuint m_fogVao{0};
@@ -90,6 +130,16 @@ private:
   GLsizei m_fogIndexCount{0};
   std::size_t m_fogInstanceCapacity{0};
   GL::PersistentRingBuffer<FogInstanceGpu> m_fogPersistentBuffer;
+  // Non-null between a mapFogInstances that handed out the mapped ring
+  // slice and its commitFogInstances; null means the scratch fallback.
+  FogInstanceGpu *m_fogMappedRange{nullptr};
+
+  GL::Shader *m_fogMaskShader{nullptr};
+  GLuint m_fogMaskVao{0};
+  GLuint m_fogMaskTexture{0};
+  int m_fogMaskTexWidth{0};
+  int m_fogMaskTexHeight{0};
+  std::uint64_t m_fogMaskUploadedVersion{~0ULL};
 };
 
 } // namespace Render::GL::BackendPipelines
@@ -1,11 +1,88 @@
 #include "effects_pipeline.h"
 #include "../backend.h"
+#include "../render_constants.h"
 #include "../shader_cache.h"
 #include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <qglobal.h>
 
 namespace Render::GL::BackendPipelines {
 
+namespace {
+// Segment counts mirror the Geom::SelectionRing / Geom::SelectionDisc
+// meshes the per-draw path used; the overlays stay visually identical.
+constexpr int k_ring_segments = 48;
+constexpr float k_ring_inner = 0.94F;
+constexpr float k_ring_outer = 1.0F;
+constexpr int k_disc_segments = 72;
+constexpr float k_two_pi = 6.2831853F;
+
+// Initial per-frame instance allocation; grows geometrically on demand.
+constexpr std::size_t k_initial_overlay_instances = 256;
+
+auto buildRingGeometry(std::vector<Vertex> &verts,
+                       std::vector<unsigned int> &idx) -> void {
+  for (int i = 0; i < k_ring_segments; ++i) {
+    float const a0 = (i / float(k_ring_segments)) * k_two_pi;
+    float const a1 = ((i + 1) / float(k_ring_segments)) * k_two_pi;
+    auto const base = static_cast<unsigned int>(verts.size());
+    verts.push_back({{k_ring_inner * std::cos(a0), 0.0F,
+                      k_ring_inner * std::sin(a0)},
+                     {0.0F, 1.0F, 0.0F},
+                     {0.0F, 0.0F}});
+    verts.push_back({{k_ring_outer * std::cos(a0), 0.0F,
+                      k_ring_outer * std::sin(a0)},
+                     {0.0F, 1.0F, 0.0F},
+                     {1.0F, 0.0F}});
+    verts.push_back({{k_ring_outer * std::cos(a1), 0.0F,
+                      k_ring_outer * std::sin(a1)},
+                     {0.0F, 1.0F, 0.0F},
+                     {1.0F, 1.0F}});
+    verts.push_back({{k_ring_inner * std::cos(a1), 0.0F,
+                      k_ring_inner * std::sin(a1)},
+                     {0.0F, 1.0F, 0.0F},
+                     {0.0F, 1.0F}});
+    idx.push_back(base + 0);
+    idx.push_back(base + 1);
+    idx.push_back(base + 2);
+    idx.push_back(base + 2);
+    idx.push_back(base + 3);
+    idx.push_back(base + 0);
+  }
+}
+
+// A unit quad for the health-bar overlay; the instanced vertex shader
+// billboards it toward the camera and sizes it per bar.
+auto buildBarGeometry(std::vector<Vertex> &verts,
+                      std::vector<unsigned int> &idx) -> void {
+  verts.push_back({{-0.5F, -0.5F, 0.0F}, {0.0F, 1.0F, 0.0F}, {0.0F, 0.0F}});
+  verts.push_back({{0.5F, -0.5F, 0.0F}, {0.0F, 1.0F, 0.0F}, {1.0F, 0.0F}});
+  verts.push_back({{0.5F, 0.5F, 0.0F}, {0.0F, 1.0F, 0.0F}, {1.0F, 1.0F}});
+  verts.push_back({{-0.5F, 0.5F, 0.0F}, {0.0F, 1.0F, 0.0F}, {0.0F, 1.0F}});
+  idx.insert(idx.end(), {0U, 1U, 2U, 2U, 3U, 0U});
+}
+
+auto buildDiscGeometry(std::vector<Vertex> &verts,
+                       std::vector<unsigned int> &idx) -> void {
+  verts.push_back({{0.0F, 0.0F, 0.0F}, {0.0F, 1.0F, 0.0F}, {0.5F, 0.5F}});
+  for (int i = 0; i <= k_disc_segments; ++i) {
+    float const a = (i / float(k_disc_segments)) * k_two_pi;
+    float const x = std::cos(a);
+    float const z = std::sin(a);
+    verts.push_back({{x, 0.0F, z},
+                     {0.0F, 1.0F, 0.0F},
+                     {0.5F + 0.5F * x, 0.5F + 0.5F * z}});
+  }
+  for (int i = 1; i <= k_disc_segments; ++i) {
+    idx.push_back(0);
+    idx.push_back(static_cast<unsigned int>(i));
+    idx.push_back(static_cast<unsigned int>(i + 1));
+  }
+}
+} // namespace
+
 auto EffectsPipeline::initialize() -> bool {
   if (m_shaderCache == nullptr) {
     qWarning() << "EffectsPipeline::initialize: null ShaderCache";
@@ -14,6 +91,9 @@ auto EffectsPipeline::initialize() -> bool {
 
   m_basicShader = m_shaderCache->get("basic");
   m_gridShader = m_shaderCache->get("grid");
+  m_selectionShader = m_shaderCache->get("selection_ring_instanced");
+  m_healthBarShader = m_shaderCache->get("health_bar_instanced");
+  m_particleShader = m_shaderCache->get("particle");
 
   if (m_basicShader == nullptr) {
     qWarning() << "EffectsPipeline: Failed to load basic shader";
@@ -21,20 +101,39 @@ auto EffectsPipeline::initialize() -> bool {
   if (m_gridShader == nullptr) {
     qWarning() << "EffectsPipeline: Failed to load grid shader";
   }
+  if (m_selectionShader == nullptr) {
+    qWarning() << "EffectsPipeline: Failed to load selection shader";
+  }
+  if (m_healthBarShader == nullptr) {
+    qWarning() << "EffectsPipeline: Failed to load health bar shader";
+  }
+  if (m_particleShader == nullptr) {
+    qWarning() << "EffectsPipeline: Failed to load particle shader";
+  }
 
+  initializeSelectionPipelines();
+  initializeParticlePipeline();
   cacheUniforms();
 
   return isInitialized();
 }
 
 void EffectsPipeline::shutdown() {
+  shutdownSelectionPipelines();
+  shutdownParticlePipeline();
   m_basicShader = nullptr;
   m_gridShader = nullptr;
+  m_selectionShader = nullptr;
+  m_healthBarShader = nullptr;
+  m_particleShader = nullptr;
 }
 
 void EffectsPipeline::cacheUniforms() {
   cacheBasicUniforms();
   cacheGridUniforms();
+  cacheSelectionUniforms();
+  cacheHealthBarUniforms();
+  cacheParticleUniforms();
 }
 
 auto EffectsPipeline::isInitialized() const -> bool {
@@ -67,4 +166,290 @@ void EffectsPipeline::cacheGridUniforms() {
   m_gridUniforms.thickness = m_gridShader->uniformHandle("u_thickness");
 }
 
+void EffectsPipeline::cacheSelectionUniforms() {
+  if (m_selectionShader == nullptr) {
+    return;
+  }
+  m_selectionShader->bindUniformBlock("FrameUniforms",
+                                      UniformBlock::FrameBinding);
+}
+
+void EffectsPipeline::cacheHealthBarUniforms() {
+  if (m_healthBarShader == nullptr) {
+    return;
+  }
+  m_healthBarShader->bindUniformBlock("FrameUniforms",
+                                      UniformBlock::FrameBinding);
+}
+
+void EffectsPipeline::cacheParticleUniforms() {
+  if (m_particleShader == nullptr) {
+    return;
+  }
+  m_particleShader->bindUniformBlock("FrameUniforms",
+                                     UniformBlock::FrameBinding);
+  m_particleUniforms.gravity = m_particleShader->uniformHandle("u_gravity");
+}
+
+void EffectsPipeline::initializeSelectionPipelines() {
+  initializeOpenGLFunctions();
+  shutdownSelectionPipelines();
+
+  std::vector<Vertex> verts;
+  std::vector<unsigned int> idx;
+  buildRingGeometry(verts, idx);
+  createOverlay(m_ring, verts, idx);
+
+  verts.clear();
+  idx.clear();
+  buildDiscGeometry(verts, idx);
+  createOverlay(m_disc, verts, idx);
+
+  verts.clear();
+  idx.clear();
+  buildBarGeometry(verts, idx);
+  createOverlay(m_bar, verts, idx);
+
+  m_ringScratch.reserve(k_initial_overlay_instances);
+  m_discScratch.reserve(k_initial_overlay_instances);
+  m_barScratch.reserve(k_initial_overlay_instances);
+}
+
+void EffectsPipeline::shutdownSelectionPipelines() {
+  initializeOpenGLFunctions();
+  destroyOverlay(m_ring);
+  destroyOverlay(m_disc);
+  destroyOverlay(m_bar);
+  m_ringScratch.clear();
+  m_discScratch.clear();
+  m_barScratch.clear();
+}
+
+void EffectsPipeline::initializeParticlePipeline() {
+  initializeOpenGLFunctions();
+  shutdownParticlePipeline();
+
+  // A unit billboard quad; the vertex shader orients it toward the
+  // camera and scales it per particle, mirroring the firecamp planes.
+  struct ParticleVertex {
+    QVector3D position;
+    float u;
+    float v;
+  };
+
+  const ParticleVertex particle_vertices[] = {
+      {{-0.5F, -0.5F, 0.0F}, 0.0F, 0.0F},
+      {{0.5F, -0.5F, 0.0F}, 1.0F, 0.0F},
+      {{0.5F, 0.5F, 0.0F}, 1.0F, 1.0F},
+      {{-0.5F, 0.5F, 0.0F}, 0.0F, 1.0F},
+  };
+  const unsigned short particle_indices[] = {0, 1, 2, 0, 2, 3};
+
+  glGenVertexArrays(1, &m_particleVao);
+  glBindVertexArray(m_particleVao);
+
+  glGenBuffers(1, &m_particleVertexBuffer);
+  glBindBuffer(GL_ARRAY_BUFFER, m_particleVertexBuffer);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(particle_vertices), particle_vertices,
+               GL_STATIC_DRAW);
+
+  glEnableVertexAttribArray(VertexAttrib::Position);
+  glVertexAttribPointer(
+      VertexAttrib::Position, ComponentCount::Vec3, GL_FLOAT, GL_FALSE,
+      sizeof(ParticleVertex),
+      reinterpret_cast<void *>(offsetof(ParticleVertex, position)));
+  glEnableVertexAttribArray(VertexAttrib::Normal);
+  glVertexAttribPointer(VertexAttrib::Normal, ComponentCount::Vec2, GL_FLOAT,
+                        GL_FALSE, sizeof(ParticleVertex),
+                        reinterpret_cast<void *>(offsetof(ParticleVertex, u)));
+
+  glGenBuffers(1, &m_particleIndexBuffer);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_particleIndexBuffer);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(particle_indices),
+               particle_indices, GL_STATIC_DRAW);
+  m_particleIndexCount = 6;
+
+  glEnableVertexAttribArray(VertexAttrib::InstancePosition);
+  glVertexAttribDivisor(VertexAttrib::InstancePosition, 1);
+  glEnableVertexAttribArray(VertexAttrib::InstanceScale);
+  glVertexAttribDivisor(VertexAttrib::InstanceScale, 1);
+  glEnableVertexAttribArray(VertexAttrib::InstanceColor);
+  glVertexAttribDivisor(VertexAttrib::InstanceColor, 1);
+  glEnableVertexAttribArray(VertexAttrib::InstanceAlpha);
+  glVertexAttribDivisor(VertexAttrib::InstanceAlpha, 1);
+
+  glBindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+void EffectsPipeline::shutdownParticlePipeline() {
+  initializeOpenGLFunctions();
+  if (m_particleIndexBuffer != 0u) {
+    glDeleteBuffers(1, &m_particleIndexBuffer);
+    m_particleIndexBuffer = 0;
+  }
+  if (m_particleVertexBuffer != 0u) {
+    glDeleteBuffers(1, &m_particleVertexBuffer);
+    m_particleVertexBuffer = 0;
+  }
+  if (m_particleVao != 0u) {
+    glDeleteVertexArrays(1, &m_particleVao);
+    m_particleVao = 0;
+  }
+  m_particleIndexCount = 0;
+}
+
+void EffectsPipeline::createOverlay(InstancedOverlay &overlay,
+                                    const std::vector<Vertex> &vertices,
+                                    const std::vector<unsigned int> &indices) {
+  glGenVertexArrays(1, &overlay.vao);
+  glBindVertexArray(overlay.vao);
+
+  glGenBuffers(1, &overlay.vertexBuffer);
+  glBindBuffer(GL_ARRAY_BUFFER, overlay.vertexBuffer);
+  glBufferData(GL_ARRAY_BUFFER,
+               static_cast<GLsizeiptr>(vertices.size() * sizeof(Vertex)),
+               vertices.data(), GL_STATIC_DRAW);
+
+  glGenBuffers(1, &overlay.indexBuffer);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, overlay.indexBuffer);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+               static_cast<GLsizeiptr>(indices.size() * sizeof(unsigned int)),
+               indices.data(), GL_STATIC_DRAW);
+  overlay.indexCount = static_cast<GLsizei>(indices.size());
+
+  glEnableVertexAttribArray(VertexAttrib::Position);
+  glVertexAttribPointer(VertexAttrib::Position, ComponentCount::Vec3, GL_FLOAT,
+                        GL_FALSE, sizeof(Vertex),
+                        reinterpret_cast<void *>(offsetof(Vertex, position)));
+  glEnableVertexAttribArray(VertexAttrib::Normal);
+  glVertexAttribPointer(VertexAttrib::Normal, ComponentCount::Vec3, GL_FLOAT,
+                        GL_FALSE, sizeof(Vertex),
+                        reinterpret_cast<void *>(offsetof(Vertex, normal)));
+  glEnableVertexAttribArray(VertexAttrib::TexCoord);
+  glVertexAttribPointer(VertexAttrib::TexCoord, ComponentCount::Vec2, GL_FLOAT,
+                        GL_FALSE, sizeof(Vertex),
+                        reinterpret_cast<void *>(offsetof(Vertex, tex_coord)));
+
+  glGenBuffers(1, &overlay.instanceBuffer);
+  glBindBuffer(GL_ARRAY_BUFFER, overlay.instanceBuffer);
+  overlay.capacity = k_initial_overlay_instances;
+  glBufferData(GL_ARRAY_BUFFER,
+               static_cast<GLsizeiptr>(overlay.capacity *
+                                       sizeof(SelectionInstanceGpu)),
+               nullptr, GL_DYNAMIC_DRAW);
+  setSelectionInstanceAttribPointers();
+
+  glBindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+void EffectsPipeline::destroyOverlay(InstancedOverlay &overlay) {
+  if (overlay.instanceBuffer != 0u) {
+    glDeleteBuffers(1, &overlay.instanceBuffer);
+    overlay.instanceBuffer = 0;
+  }
+  if (overlay.vertexBuffer != 0u) {
+    glDeleteBuffers(1, &overlay.vertexBuffer);
+    overlay.vertexBuffer = 0;
+  }
+  if (overlay.indexBuffer != 0u) {
+    glDeleteBuffers(1, &overlay.indexBuffer);
+    overlay.indexBuffer = 0;
+  }
+  if (overlay.vao != 0u) {
+    glDeleteVertexArrays(1, &overlay.vao);
+    overlay.vao = 0;
+  }
+  overlay.indexCount = 0;
+  overlay.capacity = 0;
+}
+
+void EffectsPipeline::setSelectionInstanceAttribPointers() {
+  const auto stride = static_cast<GLsizei>(sizeof(SelectionInstanceGpu));
+  glEnableVertexAttribArray(VertexAttrib::InstancePosition);
+  glVertexAttribPointer(
+      VertexAttrib::InstancePosition, ComponentCount::Vec3, GL_FLOAT, GL_FALSE,
+      stride,
+      reinterpret_cast<void *>(offsetof(SelectionInstanceGpu, center)));
+  glVertexAttribDivisor(VertexAttrib::InstancePosition, 1);
+
+  glEnableVertexAttribArray(VertexAttrib::InstanceScale);
+  glVertexAttribPointer(
+      VertexAttrib::InstanceScale, 1, GL_FLOAT, GL_FALSE, stride,
+      reinterpret_cast<void *>(offsetof(SelectionInstanceGpu, size)));
+  glVertexAttribDivisor(VertexAttrib::InstanceScale, 1);
+
+  glEnableVertexAttribArray(VertexAttrib::InstanceColor);
+  glVertexAttribPointer(
+      VertexAttrib::InstanceColor, ComponentCount::Vec3, GL_FLOAT, GL_FALSE,
+      stride, reinterpret_cast<void *>(offsetof(SelectionInstanceGpu, color)));
+  glVertexAttribDivisor(VertexAttrib::InstanceColor, 1);
+
+  glEnableVertexAttribArray(VertexAttrib::InstanceAlpha);
+  glVertexAttribPointer(
+      VertexAttrib::InstanceAlpha, 1, GL_FLOAT, GL_FALSE, stride,
+      reinterpret_cast<void *>(offsetof(SelectionInstanceGpu, alpha)));
+  glVertexAttribDivisor(VertexAttrib::InstanceAlpha, 1);
+}
+
+void EffectsPipeline::uploadOverlayInstances(
+    InstancedOverlay &overlay, const std::vector<SelectionInstanceGpu> &scratch,
+    std::size_t count) {
+  if (count == 0 || overlay.instanceBuffer == 0u) {
+    return;
+  }
+
+  glBindBuffer(GL_ARRAY_BUFFER, overlay.instanceBuffer);
+  if (count > overlay.capacity) {
+    overlay.capacity = std::max<std::size_t>(
+        count, overlay.capacity * Growth::CapacityMultiplier);
+    glBufferData(GL_ARRAY_BUFFER,
+                 static_cast<GLsizeiptr>(overlay.capacity *
+                                         sizeof(SelectionInstanceGpu)),
+                 nullptr, GL_DYNAMIC_DRAW);
+  }
+  glBufferSubData(GL_ARRAY_BUFFER, 0,
+                  static_cast<GLsizeiptr>(count * sizeof(SelectionInstanceGpu)),
+                  scratch.data());
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void EffectsPipeline::drawOverlay(const InstancedOverlay &overlay,
+                                  std::size_t count) {
+  if (count == 0 || overlay.vao == 0u || overlay.indexCount == 0) {
+    return;
+  }
+  glBindVertexArray(overlay.vao);
+  glDrawElementsInstanced(GL_TRIANGLES, overlay.indexCount, GL_UNSIGNED_INT,
+                          nullptr, static_cast<GLsizei>(count));
+  glBindVertexArray(0);
+}
+
+void EffectsPipeline::uploadRingInstances(std::size_t count) {
+  uploadOverlayInstances(m_ring, m_ringScratch, count);
+}
+
+void EffectsPipeline::drawRings(std::size_t count) {
+  drawOverlay(m_ring, count);
+}
+
+void EffectsPipeline::uploadDiscInstances(std::size_t count) {
+  uploadOverlayInstances(m_disc, m_discScratch, count);
+}
+
+void EffectsPipeline::drawDiscs(std::size_t count) {
+  drawOverlay(m_disc, count);
+}
+
+void EffectsPipeline::uploadBarInstances(std::size_t count) {
+  uploadOverlayInstances(m_bar, m_barScratch, count);
+}
+
+void EffectsPipeline::drawBars(std::size_t count) {
+  drawOverlay(m_bar, count);
+}
+
 } // namespace Render::GL::BackendPipelines
@@ -1,7 +1,11 @@
 #pragma once
 
+#include "../mesh.h"
 #include "../shader.h"
 #include "pipeline_interface.h"
+#include <QVector3D>
+#include <cstddef>
+#include <vector>
 
 namespace Render::GL {
 class ShaderCache;
@@ -38,18 +42,89 @@ public:
     GL::Shader::UniformHandle alpha{GL::Shader::InvalidUniform};
   };
 
+  // One instance per drawn ring or smoke disc; the attribute layout matches
+  // the fog instances so both overlay meshes share the instanced selection
+  // shader. View-proj comes from the shared FrameUniforms block.
+  struct SelectionInstanceGpu {
+    QVector3D center;
+    float size{1.0F};
+    QVector3D color;
+    float alpha{1.0F};
+  };
+
+  void uploadRingInstances(std::size_t count);
+  void drawRings(std::size_t count);
+  void uploadDiscInstances(std::size_t count);
+  void drawDiscs(std::size_t count);
+  // Health bars reuse the selection instance layout: size carries the
+  // bar width and alpha carries the fill fraction.
+  void uploadBarInstances(std::size_t count);
+  void drawBars(std::size_t count);
+
+  struct ParticleUniforms {
+    GL::Shader::UniformHandle gravity{GL::Shader::InvalidUniform};
+  };
+
   GL::Shader *m_basicShader = nullptr;
   GL::Shader *m_gridShader = nullptr;
+  GL::Shader *m_selectionShader = nullptr;
+  GL::Shader *m_healthBarShader = nullptr;
+  GL::Shader *m_particleShader = nullptr;
 
   BasicUniforms m_basicUniforms;
   GridUniforms m_gridUniforms;
+  ParticleUniforms m_particleUniforms;
+
+  // Billboard quad for the burst-particle pool; the instance buffer is
+  // owned by the ParticleSystem and bound per draw, so only the static
+  // geometry lives here.
+  GLuint m_particleVao{0};
+  GLuint m_particleVertexBuffer{0};
+  GLuint m_particleIndexBuffer{0};
+  GLsizei m_particleIndexCount{0};
+
+  std::vector<SelectionInstanceGpu> m_ringScratch;
+  std::vector<SelectionInstanceGpu> m_discScratch;
+  std::vector<SelectionInstanceGpu> m_barScratch;
 
 private:
+  // A small instanced overlay mesh: static geometry plus a growable
+  // per-frame instance buffer, all hanging off one VAO.
+  struct InstancedOverlay {
+    GLuint vao{0};
+    GLuint vertexBuffer{0};
+    GLuint indexBuffer{0};
+    GLuint instanceBuffer{0};
+    GLsizei indexCount{0};
+    std::size_t capacity{0};
+  };
+
   GL::Backend *m_backend = nullptr;
   GL::ShaderCache *m_shaderCache = nullptr;
 
+  InstancedOverlay m_ring;
+  InstancedOverlay m_disc;
+  InstancedOverlay m_bar;
+
   void cacheBasicUniforms();
   void cacheGridUniforms();
+  void cacheSelectionUniforms();
+  void cacheHealthBarUniforms();
+  void cacheParticleUniforms();
+
+  void initializeSelectionPipelines();
+  void shutdownSelectionPipelines();
+  void initializeParticlePipeline();
+  void shutdownParticlePipeline();
+  void createOverlay(InstancedOverlay &overlay,
+                     const std::vector<Vertex> &vertices,
+                     const std::vector<unsigned int> &indices);
+  void destroyOverlay(InstancedOverlay &overlay);
+  void setSelectionInstanceAttribPointers();
+  void uploadOverlayInstances(InstancedOverlay &overlay,
+                              const std::vector<SelectionInstanceGpu> &scratch,
+                              std::size_t count);
+  void drawOverlay(const InstancedOverlay &overlay, std::size_t count);
 };
 
 } // namespace BackendPipelines
@@ -68,12 +68,10 @@ void TerrainPipeline::cacheGrassUniforms() {
     return;
   }
 
-  m_grassUniforms.view_proj = m_grassShader->uniformHandle("u_viewProj");
-  m_grassUniforms.time = m_grassShader->uniformHandle("u_time");
+  m_grassShader->bindUniformBlock("FrameUniforms", UniformBlock::FrameBinding);
   m_grassUniforms.windStrength = m_grassShader->uniformHandle("u_windStrength");
   m_grassUniforms.windSpeed = m_grassShader->uniformHandle("u_windSpeed");
   m_grassUniforms.soilColor = m_grassShader->uniformHandle("u_soilColor");
-  m_grassUniforms.light_dir = m_grassShader->uniformHandle("u_lightDir");
 }
 
 void TerrainPipeline::cacheGroundUniforms() {
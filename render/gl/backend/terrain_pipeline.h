@@ -23,9 +23,9 @@ public:
   void cacheUniforms() override;
   [[nodiscard]] auto isInitialized() const -> bool override;
 
+  // View-proj, light and time come from the shared FrameUniforms block;
+  // only the per-type parameters remain as plain uniforms.
   struct GrassUniforms {
-    GL::Shader::UniformHandle view_proj{GL::Shader::InvalidUniform};
-    GL::Shader::UniformHandle time{GL::Shader::InvalidUniform};
     GL::Shader::UniformHandle windStrength{GL::Shader::InvalidUniform};
     GL::Shader::UniformHandle windSpeed{GL::Shader::InvalidUniform};
     GL::Shader::UniformHandle soilColor{GL::Shader::InvalidUniform};
@@ -68,34 +68,28 @@ void VegetationPipeline::shutdown() {
 
 void VegetationPipeline::cacheUniforms() {
   if (m_stoneShader != nullptr) {
-    m_stoneUniforms.view_proj = m_stoneShader->uniformHandle("uViewProj");
-    m_stoneUniforms.light_direction =
-        m_stoneShader->uniformHandle("uLightDirection");
+    m_stoneShader->bindUniformBlock("FrameUniforms",
+                                    UniformBlock::FrameBinding);
   }
 
   if (m_plantShader != nullptr) {
-    m_plantUniforms.view_proj = m_plantShader->uniformHandle("uViewProj");
-    m_plantUniforms.time = m_plantShader->uniformHandle("uTime");
+    m_plantShader->bindUniformBlock("FrameUniforms",
+                                    UniformBlock::FrameBinding);
     m_plantUniforms.windStrength =
         m_plantShader->uniformHandle("uWindStrength");
     m_plantUniforms.windSpeed = m_plantShader->uniformHandle("uWindSpeed");
-    m_plantUniforms.light_direction =
-        m_plantShader->uniformHandle("uLightDirection");
   }
 
   if (m_pineShader != nullptr) {
-    m_pineUniforms.view_proj = m_pineShader->uniformHandle("uViewProj");
-    m_pineUniforms.time = m_pineShader->uniformHandle("uTime");
+    m_pineShader->bindUniformBlock("FrameUniforms",
+                                   UniformBlock::FrameBinding);
     m_pineUniforms.windStrength = m_pineShader->uniformHandle("uWindStrength");
     m_pineUniforms.windSpeed = m_pineShader->uniformHandle("uWindSpeed");
-    m_pineUniforms.light_direction =
-        m_pineShader->uniformHandle("uLightDirection");
   }
 
   if (m_firecampShader != nullptr) {
-    m_firecampUniforms.view_proj =
-        m_firecampShader->uniformHandle("u_viewProj");
-    m_firecampUniforms.time = m_firecampShader->uniformHandle("u_time");
+    m_firecampShader->bindUniformBlock("FrameUniforms",
+                                       UniformBlock::FrameBinding);
     m_firecampUniforms.flickerSpeed =
         m_firecampShader->uniformHandle("u_flickerSpeed");
     m_firecampUniforms.flickerAmount =
@@ -104,10 +98,6 @@ void VegetationPipeline::cacheUniforms() {
         m_firecampShader->uniformHandle("u_glowStrength");
     m_firecampUniforms.fireTexture =
         m_firecampShader->uniformHandle("fireTexture");
-    m_firecampUniforms.camera_right =
-        m_firecampShader->uniformHandle("u_cameraRight");
-    m_firecampUniforms.camera_forward =
-        m_firecampShader->uniformHandle("u_cameraForward");
   }
 }
 
@@ -31,36 +31,24 @@ public:
     return m_firecampShader;
   }
 
-  struct StoneUniforms {
-    GL::Shader::UniformHandle view_proj{GL::Shader::InvalidUniform};
-    GL::Shader::UniformHandle light_direction{GL::Shader::InvalidUniform};
-  } m_stoneUniforms;
-
+  // View-proj, light, time and the camera basis come from the shared
+  // FrameUniforms block; only the per-type parameters remain as plain
+  // uniforms. The stone shader needs nothing beyond the block.
   struct PlantUniforms {
-    GL::Shader::UniformHandle view_proj{GL::Shader::InvalidUniform};
-    GL::Shader::UniformHandle time{GL::Shader::InvalidUniform};
     GL::Shader::UniformHandle windStrength{GL::Shader::InvalidUniform};
     GL::Shader::UniformHandle windSpeed{GL::Shader::InvalidUniform};
-    GL::Shader::UniformHandle light_direction{GL::Shader::InvalidUniform};
   } m_plantUniforms;
 
   struct PineUniforms {
-    GL::Shader::UniformHandle view_proj{GL::Shader::InvalidUniform};
-    GL::Shader::UniformHandle time{GL::Shader::InvalidUniform};
     GL::Shader::UniformHandle windStrength{GL::Shader::InvalidUniform};
     GL::Shader::UniformHandle windSpeed{GL::Shader::InvalidUniform};
-    GL::Shader::UniformHandle light_direction{GL::Shader::InvalidUniform};
   } m_pineUniforms;
 
   struct FireCampUniforms {
-    GL::Shader::UniformHandle view_proj{GL::Shader::InvalidUniform};
-    GL::Shader::UniformHandle time{GL::Shader::InvalidUniform};
     GL::Shader::UniformHandle flickerSpeed{GL::Shader::InvalidUniform};
     GL::Shader::UniformHandle flickerAmount{GL::Shader::InvalidUniform};
     GL::Shader::UniformHandle glowStrength{GL::Shader::InvalidUniform};
     GL::Shader::UniformHandle fireTexture{GL::Shader::InvalidUniform};
-    GL::Shader::UniformHandle camera_right{GL::Shader::InvalidUniform};
-    GL::Shader::UniformHandle camera_forward{GL::Shader::InvalidUniform};
   } m_firecampUniforms;
 
   GLuint m_stoneVao{0};
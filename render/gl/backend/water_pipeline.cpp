@@ -13,6 +13,8 @@ auto WaterPipeline::initialize() -> bool {
   }
 
   m_riverShader = m_shaderCache->get("river");
+  m_riverMediumShader = m_shaderCache->get("river_medium");
+  m_riverLowShader = m_shaderCache->get("river_low");
   m_riverbankShader = m_shaderCache->get("riverbank");
   m_bridgeShader = m_shaderCache->get("bridge");
 
@@ -33,6 +35,8 @@ auto WaterPipeline::initialize() -> bool {
 
 void WaterPipeline::shutdown() {
   m_riverShader = nullptr;
+  m_riverMediumShader = nullptr;
+  m_riverLowShader = nullptr;
   m_riverbankShader = nullptr;
   m_bridgeShader = nullptr;
 }
@@ -49,14 +53,18 @@ auto WaterPipeline::isInitialized() const -> bool {
 }
 
 void WaterPipeline::cacheRiverUniforms() {
-  if (m_riverShader == nullptr) {
-    return;
-  }
-
-  m_riverUniforms.model = m_riverShader->uniformHandle("model");
-  m_riverUniforms.view = m_riverShader->uniformHandle("view");
-  m_riverUniforms.projection = m_riverShader->uniformHandle("projection");
-  m_riverUniforms.time = m_riverShader->uniformHandle("time");
+  auto cache_tier = [](GL::Shader *shader, RiverUniforms &uniforms) {
+    if (shader == nullptr) {
+      return;
+    }
+    uniforms.model = shader->uniformHandle("model");
+    uniforms.view = shader->uniformHandle("view");
+    uniforms.projection = shader->uniformHandle("projection");
+    uniforms.time = shader->uniformHandle("time");
+  };
+  cache_tier(m_riverShader, m_riverUniforms);
+  cache_tier(m_riverMediumShader, m_riverMediumUniforms);
+  cache_tier(m_riverLowShader, m_riverLowUniforms);
 }
 
 void WaterPipeline::cacheRiverbankUniforms() {
@@ -42,13 +42,34 @@ public:
   };
 
   GL::Shader *m_riverShader = nullptr;
+  GL::Shader *m_riverMediumShader = nullptr;
+  GL::Shader *m_riverLowShader = nullptr;
   GL::Shader *m_riverbankShader = nullptr;
   GL::Shader *m_bridgeShader = nullptr;
 
   RiverUniforms m_riverUniforms;
+  RiverUniforms m_riverMediumUniforms;
+  RiverUniforms m_riverLowUniforms;
   RiverbankUniforms m_riverbankUniforms;
   BridgeUniforms m_bridgeUniforms;
 
+  // All river quality tiers share the same uniform interface; returns
+  // the handles for whichever tier `shader` is, or nullptr if it is not
+  // a river shader.
+  [[nodiscard]] auto riverUniformsFor(const GL::Shader *shader) const
+      -> const RiverUniforms * {
+    if (shader == m_riverShader) {
+      return &m_riverUniforms;
+    }
+    if (shader == m_riverMediumShader) {
+      return &m_riverMediumUniforms;
+    }
+    if (shader == m_riverLowShader) {
+      return &m_riverLowUniforms;
+    }
+    return nullptr;
+  }
+
 private:
   GL::Backend *m_backend = nullptr;
   GL::ShaderCache *m_shaderCache = nullptr;
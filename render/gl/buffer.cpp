@@ -29,6 +29,12 @@ void Buffer::setData(const void *data, size_t size, Usage usage) {
   glBufferData(getGLType(), size, data, getGLUsage(usage));
 }
 
+void Buffer::setSubData(const void *data, size_t offset, size_t size) {
+  bind();
+  glBufferSubData(getGLType(), static_cast<GLintptr>(offset),
+                  static_cast<GLsizeiptr>(size), data);
+}
+
 auto Buffer::getGLType() const -> GLenum {
   switch (m_type) {
   case Type::Vertex:
@@ -19,6 +19,13 @@ public:
 
   void setData(const void *data, size_t size, Usage usage = Usage::Static);
 
+  // Overwrites a byte range of already-allocated storage without
+  // re-specifying the buffer; the range must lie inside the last setData
+  // allocation.
+  void setSubData(const void *data, size_t offset, size_t size);
+
+  [[nodiscard]] auto id() const -> GLuint { return m_buffer; }
+
   template <typename T>
   void setData(const std::vector<T> &data, Usage usage = Usage::Static) {
     setData(data.data(), data.size() * sizeof(T), usage);
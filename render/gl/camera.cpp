@@ -18,6 +18,9 @@ using namespace Render::GL::FrustumPlane;
 namespace {
 constexpr float kEps = 1e-6F;
 constexpr float k_tiny = 1e-4F;
+// Update rate the per-update follow lerp was tuned against; the
+// display-rate updateFollow rescales against it.
+constexpr float k_follow_reference_hz = 60.0F;
 constexpr float k_min_dist = 1.0F;
 constexpr float k_max_dist = 200.0F;
 constexpr float k_min_fov = 1.0F;
@@ -142,6 +145,7 @@ void Camera::setUp(const QVector3D &up) {
   }
 
   orthonormalize(m_target - m_position, m_front, m_right, m_up);
+  markViewDirty();
 }
 
 void Camera::lookAt(const QVector3D &position, const QVector3D &target,
@@ -172,6 +176,7 @@ void Camera::setPerspective(float fov, float aspect, float near_plane,
   m_aspect = std::max(aspect, 1e-6F);
   m_near_plane = std::max(near_plane, 1e-4F);
   m_far_plane = std::max(far_plane, m_near_plane + 1e-3F);
+  markProjectionDirty();
 }
 
 void Camera::setOrthographic(float left, float right, float bottom, float top,
@@ -189,6 +194,7 @@ void Camera::setOrthographic(float left, float right, float bottom, float top,
   m_orthoTop = top;
   m_near_plane = std::min(near_plane, far_plane - 1e-3F);
   m_far_plane = std::max(far_plane, m_near_plane + 1e-3F);
+  markProjectionDirty();
 }
 
 void Camera::moveForward(float distance) {
@@ -238,6 +244,7 @@ void Camera::zoom(float delta) {
     m_orthoTop *= scale;
     clampOrthoBox(m_orthoLeft, m_orthoRight, m_orthoBottom, m_orthoTop);
   }
+  markProjectionDirty();
 }
 
 void Camera::zoomDistance(float delta) {
@@ -452,6 +459,18 @@ auto Camera::worldToScreen(const QVector3D &world, qreal screenW, qreal screenH,
 }
 
 void Camera::updateFollow(const QVector3D &targetCenter) {
+  followStep(targetCenter, m_followLerp);
+}
+
+void Camera::updateFollow(const QVector3D &targetCenter, float dtSeconds) {
+  float const base = std::clamp(m_followLerp, 0.0F, 0.999F);
+  float const alpha = 1.0F - std::pow(1.0F - base,
+                                      std::max(dtSeconds, 0.0F) *
+                                          k_follow_reference_hz);
+  followStep(targetCenter, alpha);
+}
+
+void Camera::followStep(const QVector3D &targetCenter, float alpha) {
   if (!m_followEnabled) {
     return;
   }
@@ -464,10 +483,10 @@ void Camera::updateFollow(const QVector3D &targetCenter) {
   }
   QVector3D const desired_pos = targetCenter + m_followOffset;
   QVector3D const new_pos =
-      (m_followLerp >= 0.999F)
+      (alpha >= 0.999F)
           ? desired_pos
           : (m_position +
-             (desired_pos - m_position) * std::clamp(m_followLerp, 0.0F, 1.0F));
+             (desired_pos - m_position) * std::clamp(alpha, 0.0F, 1.0F));
 
   if (!finite(new_pos)) {
     return;
@@ -522,29 +541,41 @@ void Camera::setTopDownView(const QVector3D &center, float distance) {
   applySoftBoundaries();
 }
 
-auto Camera::getViewMatrix() const -> QMatrix4x4 {
-  QMatrix4x4 view;
-  view.lookAt(m_position, m_target, m_up);
-  return view;
-}
-
-auto Camera::getProjectionMatrix() const -> QMatrix4x4 {
-  QMatrix4x4 projection;
-  if (m_isPerspective) {
-    projection.perspective(m_fov, m_aspect, m_near_plane, m_far_plane);
-  } else {
-    float left = m_orthoLeft;
-    float right = m_orthoRight;
-    float bottom = m_orthoBottom;
-    float top = m_orthoTop;
-    clampOrthoBox(left, right, bottom, top);
-    projection.ortho(left, right, bottom, top, m_near_plane, m_far_plane);
+auto Camera::getViewMatrix() const -> const QMatrix4x4 & {
+  if (m_viewDirty) {
+    m_cachedView.setToIdentity();
+    m_cachedView.lookAt(m_position, m_target, m_up);
+    m_viewDirty = false;
+  }
+  return m_cachedView;
+}
+
+auto Camera::getProjectionMatrix() const -> const QMatrix4x4 & {
+  if (m_projectionDirty) {
+    m_cachedProjection.setToIdentity();
+    if (m_isPerspective) {
+      m_cachedProjection.perspective(m_fov, m_aspect, m_near_plane,
+                                     m_far_plane);
+    } else {
+      float left = m_orthoLeft;
+      float right = m_orthoRight;
+      float bottom = m_orthoBottom;
+      float top = m_orthoTop;
+      clampOrthoBox(left, right, bottom, top);
+      m_cachedProjection.ortho(left, right, bottom, top, m_near_plane,
+                               m_far_plane);
+    }
+    m_projectionDirty = false;
   }
-  return projection;
+  return m_cachedProjection;
 }
 
-auto Camera::getViewProjectionMatrix() const -> QMatrix4x4 {
-  return getProjectionMatrix() * getViewMatrix();
+auto Camera::getViewProjectionMatrix() const -> const QMatrix4x4 & {
+  if (m_viewProjDirty) {
+    m_cachedViewProj = getProjectionMatrix() * getViewMatrix();
+    m_viewProjDirty = false;
+  }
+  return m_cachedViewProj;
 }
 
 auto Camera::getDistance() const -> float {
@@ -568,6 +599,11 @@ void Camera::updateVectors() {
 }
 
 void Camera::applySoftBoundaries(bool isPanning) {
+  // Every pose mutator funnels through here after touching
+  // position/target, so this is the single spot that invalidates the
+  // cached view-dependent state.
+  markViewDirty();
+
   if (!qIsFinite(m_position.y())) {
     return;
   }
@@ -683,6 +719,7 @@ void Camera::clampAboveGround() {
 
   if (m_position.y() < m_ground_y + m_min_height) {
     m_position.setY(m_ground_y + m_min_height);
+    markViewDirty();
   }
 }
 
@@ -701,9 +738,12 @@ void Camera::computeYawPitchFromOffset(const QVector3D &off, float &yaw_deg,
   pitch_deg = pitch;
 }
 
-auto Camera::isInFrustum(const QVector3D &center, float radius) const -> bool {
+auto Camera::extractFrustum() const -> const Frustum & {
+  if (!m_frustumDirty) {
+    return m_cachedFrustum;
+  }
 
-  QMatrix4x4 const vp = getViewProjectionMatrix();
+  const QMatrix4x4 &vp = getViewProjectionMatrix();
 
   float m[MatrixSize];
   const float *data = vp.constData();
@@ -711,42 +751,37 @@ auto Camera::isInFrustum(const QVector3D &center, float radius) const -> bool {
     m[i] = data[i];
   }
 
-  QVector3D const left_n(m[Index3] + m[Index0], m[Index7] + m[Index4],
-                         m[Index11] + m[Index8]);
-  float const left_d = m[15] + m[12];
-
-  QVector3D const right_n(m[Index3] - m[Index0], m[Index7] - m[Index4],
-                          m[Index11] - m[Index8]);
-  float const right_d = m[15] - m[12];
-
-  QVector3D const bottom_n(m[Index3] + m[Index1], m[Index7] + m[Index5],
-                           m[Index11] + m[Index9]);
-  float const bottom_d = m[15] + m[13];
-
-  QVector3D const topN(m[Index3] - m[Index1], m[Index7] - m[Index5],
-                       m[Index11] - m[Index9]);
-  float const topD = m[15] - m[13];
-
-  QVector3D const near_n(m[Index3] + m[Index2], m[Index7] + m[Index6],
-                         m[Index11] + m[Index10]);
-  float const near_d = m[15] + m[14];
-
-  QVector3D const farN(m[Index3] - m[Index2], m[Index7] - m[Index6],
-                       m[Index11] - m[Index10]);
-  float const farD = m[15] - m[14];
-
-  auto test_plane = [&center, radius](const QVector3D &n, float d) -> bool {
-    float const len = n.length();
-    if (len < 1e-6F) {
-      return true;
+  Frustum frustum;
+  frustum.planes[0] = QVector4D(m[Index3] + m[Index0], m[Index7] + m[Index4],
+                                m[Index11] + m[Index8], m[15] + m[12]);
+  frustum.planes[1] = QVector4D(m[Index3] - m[Index0], m[Index7] - m[Index4],
+                                m[Index11] - m[Index8], m[15] - m[12]);
+  frustum.planes[2] = QVector4D(m[Index3] + m[Index1], m[Index7] + m[Index5],
+                                m[Index11] + m[Index9], m[15] + m[13]);
+  frustum.planes[3] = QVector4D(m[Index3] - m[Index1], m[Index7] - m[Index5],
+                                m[Index11] - m[Index9], m[15] - m[13]);
+  frustum.planes[4] = QVector4D(m[Index3] + m[Index2], m[Index7] + m[Index6],
+                                m[Index11] + m[Index10], m[15] + m[14]);
+  frustum.planes[5] = QVector4D(m[Index3] - m[Index2], m[Index7] - m[Index6],
+                                m[Index11] - m[Index10], m[15] - m[14]);
+
+  for (auto &plane : frustum.planes) {
+    float const len = plane.toVector3D().length();
+    if (len > 1e-6F) {
+      plane /= len;
+    } else {
+      // Degenerate plane: make it pass everything.
+      plane = QVector4D(0.0F, 0.0F, 0.0F, 1.0F);
     }
-    float const dist = QVector3D::dotProduct(center, n) + d;
-    return dist >= -radius * len;
-  };
+  }
 
-  return test_plane(left_n, left_d) && test_plane(right_n, right_d) &&
-         test_plane(bottom_n, bottom_d) && test_plane(topN, topD) &&
-         test_plane(near_n, near_d) && test_plane(farN, farD);
+  m_cachedFrustum = frustum;
+  m_frustumDirty = false;
+  return m_cachedFrustum;
+}
+
+auto Camera::isInFrustum(const QVector3D &center, float radius) const -> bool {
+  return extractFrustum().intersectsSphere(center, radius);
 }
 
 } // namespace Render::GL
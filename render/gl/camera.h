@@ -3,9 +3,33 @@
 #include <QMatrix4x4>
 #include <QPointF>
 #include <QVector3D>
+#include <QVector4D>
+#include <array>
+#include <cstdint>
 
 namespace Render::GL {
 
+// The six camera planes captured once per frame. Callers that test many
+// entities extract this once and reuse it instead of re-deriving the planes
+// from the view-projection matrix per test.
+struct Frustum {
+  // xyz = plane normal, w = d; normalized so sphere tests compare against
+  // the radius directly.
+  std::array<QVector4D, 6> planes;
+
+  [[nodiscard]] auto intersectsSphere(const QVector3D &center,
+                                      float radius) const -> bool {
+    for (const auto &p : planes) {
+      float const dist = p.x() * center.x() + p.y() * center.y() +
+                         p.z() * center.z() + p.w();
+      if (dist < -radius) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
 class Camera {
   friend void solveConstraints(Render::GL::Camera *self, bool allowTargetShift);
 
@@ -49,15 +73,28 @@ public:
   void setFollowOffset(const QVector3D &off) { m_followOffset = off; }
   void captureFollowOffset() { m_followOffset = m_position - m_target; }
   void updateFollow(const QVector3D &targetCenter);
+  // Display-rate variant: rescales the per-update follow lerp (tuned
+  // against the 60 Hz engine update) to the elapsed frame time, so the
+  // smoothing speed stays refresh-rate independent.
+  void updateFollow(const QVector3D &targetCenter, float dtSeconds);
 
   void setRTSView(const QVector3D &center, float distance = 10.0F,
                   float angle = 45.0F, float yaw_deg = 45.0F);
   void setTopDownView(const QVector3D &center, float distance = 10.0F);
   void applySoftBoundaries(bool isPanning = false);
 
-  [[nodiscard]] auto getViewMatrix() const -> QMatrix4x4;
-  [[nodiscard]] auto getProjectionMatrix() const -> QMatrix4x4;
-  [[nodiscard]] auto getViewProjectionMatrix() const -> QMatrix4x4;
+  // Matrices and frustum planes are cached and rebuilt lazily when a
+  // mutator dirtied them, so per-consumer accessor calls on a static
+  // camera are cheap.
+  [[nodiscard]] auto getViewMatrix() const -> const QMatrix4x4 &;
+  [[nodiscard]] auto getProjectionMatrix() const -> const QMatrix4x4 &;
+  [[nodiscard]] auto getViewProjectionMatrix() const -> const QMatrix4x4 &;
+
+  // Bumped on every pose or projection change. Consumers that derive
+  // their own state from the camera (culling grids, billboard bases,
+  // fog volumes) can compare it against the value they last saw and
+  // skip recomputation while the camera is static.
+  [[nodiscard]] auto version() const -> std::uint64_t { return m_version; }
 
   [[nodiscard]] auto getPosition() const -> const QVector3D & {
     return m_position;
@@ -77,10 +114,14 @@ public:
   [[nodiscard]] auto getNear() const -> float { return m_near_plane; }
   [[nodiscard]] auto getFar() const -> float { return m_far_plane; }
 
+  [[nodiscard]] auto extractFrustum() const -> const Frustum &;
+
   [[nodiscard]] auto isInFrustum(const QVector3D &center,
                                  float radius) const -> bool;
 
 private:
+  void followStep(const QVector3D &targetCenter, float alpha);
+
   QVector3D m_position{0.0F, 0.0F, 0.0F};
   QVector3D m_target{0.0F, 0.0F, -1.0F};
   QVector3D m_up{0.0F, 1.0F, 0.0F};
@@ -118,6 +159,30 @@ private:
   float m_orbitTime = 0.0F;
   float m_orbitDuration = 0.12F;
 
+  // Lazy caches; the dirty flags are cleared by the const accessors.
+  mutable QMatrix4x4 m_cachedView;
+  mutable QMatrix4x4 m_cachedProjection;
+  mutable QMatrix4x4 m_cachedViewProj;
+  mutable Frustum m_cachedFrustum;
+  mutable bool m_viewDirty = true;
+  mutable bool m_projectionDirty = true;
+  mutable bool m_viewProjDirty = true;
+  mutable bool m_frustumDirty = true;
+  std::uint64_t m_version = 0;
+
+  void markViewDirty() {
+    m_viewDirty = true;
+    m_viewProjDirty = true;
+    m_frustumDirty = true;
+    ++m_version;
+  }
+  void markProjectionDirty() {
+    m_projectionDirty = true;
+    m_viewProjDirty = true;
+    m_frustumDirty = true;
+    ++m_version;
+  }
+
   void updateVectors();
 
   void clampAboveGround();
@@ -0,0 +1,110 @@
+#include "gpu_timers.h"
+#include "core/profiler.h"
+#include <cstring>
+
+namespace Render::GL {
+
+namespace {
+
+constexpr double k_ns_per_ms = 1.0e6;
+// Weight of the newest sample in the rolling average; ~10 frames of
+// history keeps the readout stable without hiding short regressions.
+constexpr double k_average_alpha = 0.1;
+
+} // namespace
+
+void GpuPassTimers::initialize() {
+  initializeOpenGLFunctions();
+  m_initialized = true;
+}
+
+void GpuPassTimers::shutdown() {
+  for (auto &pass : m_passes) {
+    glDeleteQueries(2, pass.queries.data());
+  }
+  m_passes.clear();
+  m_timings.clear();
+  m_initialized = false;
+}
+
+auto GpuPassTimers::passIndex(const char *name) -> int {
+  for (std::size_t i = 0; i < m_passes.size(); ++i) {
+    if (m_passes[i].name == name ||
+        std::strcmp(m_passes[i].name, name) == 0) {
+      return static_cast<int>(i);
+    }
+  }
+  Pass pass;
+  pass.name = name;
+  glGenQueries(2, pass.queries.data());
+  m_passes.push_back(pass);
+  m_timings.push_back({name, 0.0, 0.0});
+  return static_cast<int>(m_passes.size() - 1);
+}
+
+void GpuPassTimers::beginFrame() {
+  if (!m_initialized) {
+    return;
+  }
+
+  m_writeSlot = 1 - m_writeSlot;
+
+  // The slot we are about to write into holds the query issued two flips
+  // ago; harvest it now (it has had a full frame to complete).
+  const int read_slot = m_writeSlot;
+  for (std::size_t i = 0; i < m_passes.size(); ++i) {
+    auto &pass = m_passes[i];
+    if (!pass.pending[read_slot]) {
+      continue;
+    }
+    GLuint available = 0;
+    glGetQueryObjectuiv(pass.queries[read_slot], GL_QUERY_RESULT_AVAILABLE,
+                        &available);
+    pass.pending[read_slot] = false;
+    if (available == 0u) {
+      continue;
+    }
+    GLuint64 elapsed_ns = 0;
+    glGetQueryObjectui64v(pass.queries[read_slot], GL_QUERY_RESULT,
+                          &elapsed_ns);
+    auto &timing = m_timings[i];
+    timing.lastMs = static_cast<double>(elapsed_ns) / k_ns_per_ms;
+    timing.averageMs = timing.averageMs == 0.0
+                           ? timing.lastMs
+                           : timing.averageMs * (1.0 - k_average_alpha) +
+                                 timing.lastMs * k_average_alpha;
+    // Mirror the measurement onto the profiler's synthetic GPU track so
+    // the overlay and the Chrome trace export pick it up (one frame
+    // late, which is inherent to non-stalling queries).
+    Engine::Core::Profiler::instance().submitGpuZone(timing.name,
+                                                     timing.lastMs);
+  }
+
+  m_activePass = -1;
+}
+
+void GpuPassTimers::beginPass(const char *name) {
+  // Gated on the HUD toggle, not the always-on flight recorder, so a
+  // shipped build issues no queries until someone opens the HUD.
+  if (!m_initialized || m_activePass >= 0 ||
+      !Engine::Core::Profiler::instance().gpuTimingEnabled()) {
+    return;
+  }
+  const int index = passIndex(name);
+  // If the result from two flips ago never became available, re-issuing
+  // the query discards it — which beats blocking the render thread.
+  glBeginQuery(GL_TIME_ELAPSED,
+               m_passes[static_cast<std::size_t>(index)].queries[m_writeSlot]);
+  m_activePass = index;
+}
+
+void GpuPassTimers::endPass() {
+  if (!m_initialized || m_activePass < 0) {
+    return;
+  }
+  glEndQuery(GL_TIME_ELAPSED);
+  m_passes[static_cast<std::size_t>(m_activePass)].pending[m_writeSlot] = true;
+  m_activePass = -1;
+}
+
+} // namespace Render::GL
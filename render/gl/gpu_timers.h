@@ -0,0 +1,66 @@
+#pragma once
+
+#include <QOpenGLFunctions_3_3_Core>
+#include <array>
+#include <vector>
+
+namespace Render::GL {
+
+// GL_TIME_ELAPSED instrumentation for the backend's pass sections. Each
+// pass owns two query objects: the frame writes one set while the result
+// of the other (issued last frame) is collected, so readback never waits
+// on the GPU. A result that is still not available when its slot comes
+// around again is dropped rather than stalled on.
+//
+// Timer queries cannot nest, so passes must be strictly sequential —
+// which the backend's execute() sections already are.
+class GpuPassTimers : protected QOpenGLFunctions_3_3_Core {
+public:
+  struct PassTiming {
+    const char *name = nullptr;
+    // Exponential rolling average over collected frames.
+    double averageMs = 0.0;
+    double lastMs = 0.0;
+  };
+
+  GpuPassTimers() = default;
+  ~GpuPassTimers() override = default;
+
+  GpuPassTimers(const GpuPassTimers &) = delete;
+  auto operator=(const GpuPassTimers &) -> GpuPassTimers & = delete;
+  GpuPassTimers(GpuPassTimers &&) = delete;
+  auto operator=(GpuPassTimers &&) -> GpuPassTimers & = delete;
+
+  void initialize();
+  void shutdown();
+
+  // Collects last frame's results and flips the write set. Call once per
+  // frame before the first beginPass.
+  void beginFrame();
+
+  // Pass names must be string literals; a name seen for the first time
+  // allocates its query pair lazily.
+  void beginPass(const char *name);
+  void endPass();
+
+  [[nodiscard]] auto timings() const -> const std::vector<PassTiming> & {
+    return m_timings;
+  }
+
+private:
+  struct Pass {
+    const char *name = nullptr;
+    std::array<GLuint, 2> queries{0, 0};
+    std::array<bool, 2> pending{false, false};
+  };
+
+  auto passIndex(const char *name) -> int;
+
+  std::vector<Pass> m_passes;
+  std::vector<PassTiming> m_timings;
+  int m_writeSlot = 0;
+  int m_activePass = -1;
+  bool m_initialized = false;
+};
+
+} // namespace Render::GL
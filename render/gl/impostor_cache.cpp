@@ -0,0 +1,333 @@
+#include "impostor_cache.h"
+#include "../../game/units/spawn_type.h"
+#include "../../game/visuals/team_colors.h"
+#include "../geom/transforms.h"
+#include "../world_snapshot.h"
+#include "mesh.h"
+#include "primitives.h"
+#include "shader.h"
+#include <QDebug>
+#include <QMatrix4x4>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace Render::GL {
+
+namespace {
+constexpr int k_atlas_size = 1024;
+constexpr int k_cell_size = 128;
+constexpr float k_uv_inset_px = 1.5F;
+constexpr float k_bounds_margin = 1.1F;
+constexpr float k_rad_to_deg = 57.2957795131F;
+constexpr float k_deg_to_rad = 0.01745329252F;
+
+struct CapturedPart {
+  Mesh *mesh = nullptr;
+  QMatrix4x4 model;
+  QVector3D color;
+  float alpha = 1.0F;
+};
+
+// Records the opaque geometry a renderer submits for one unit; cylinders
+// come back as unit-cylinder meshes with the equivalent model matrix so
+// the bake pass only ever draws plain meshes.
+class CaptureSubmitter final : public ISubmitter {
+public:
+  std::vector<CapturedPart> parts;
+
+  void setShader(Shader * /*shader*/) override {}
+
+  void mesh(Mesh *mesh, const QMatrix4x4 &model, const QVector3D &color,
+            Texture * /*tex*/ = nullptr, float alpha = 1.0F) override {
+    // Translucent parts are contact shadows and overlays; they would
+    // pollute both the sprite and its bounds.
+    if (mesh != nullptr && alpha >= 1.0F) {
+      parts.push_back({mesh, model, color, alpha});
+    }
+  }
+
+  void cylinder(const QVector3D &start, const QVector3D &end, float radius,
+                const QVector3D &color, float alpha = 1.0F) override {
+    Mesh *unit_cylinder = getUnitCylinder();
+    if (unit_cylinder != nullptr && alpha >= 1.0F) {
+      parts.push_back(
+          {unit_cylinder, Geom::cylinderBetween(start, end, radius), color,
+           alpha});
+    }
+  }
+
+  void selectionRing(const QMatrix4x4 & /*model*/, float /*alphaInner*/,
+                     float /*alphaOuter*/,
+                     const QVector3D & /*color*/) override {}
+  void grid(const QMatrix4x4 & /*model*/, const QVector3D & /*color*/,
+            float /*cellSize*/, float /*thickness*/,
+            float /*extent*/) override {}
+  void selectionSmoke(const QMatrix4x4 & /*model*/,
+                      const QVector3D & /*color*/,
+                      float /*baseAlpha*/ = 0.15F) override {}
+  void healthBar(const QVector3D & /*anchor*/, float /*width*/,
+                 const QVector3D & /*color*/, float /*fill*/) override {}
+};
+
+auto meshLocalBounds(const Mesh *mesh) -> std::pair<QVector3D, QVector3D> {
+  QVector3D lo(1e9F, 1e9F, 1e9F);
+  QVector3D hi(-1e9F, -1e9F, -1e9F);
+  for (const auto &v : mesh->getVertices()) {
+    lo.setX(std::min(lo.x(), v.position[0]));
+    lo.setY(std::min(lo.y(), v.position[1]));
+    lo.setZ(std::min(lo.z(), v.position[2]));
+    hi.setX(std::max(hi.x(), v.position[0]));
+    hi.setY(std::max(hi.y(), v.position[1]));
+    hi.setZ(std::max(hi.z(), v.position[2]));
+  }
+  return {lo, hi};
+}
+
+} // namespace
+
+ImpostorCache::~ImpostorCache() { shutdown(); }
+
+auto ImpostorCache::initialize() -> bool {
+  initializeOpenGLFunctions();
+
+  m_atlas = std::make_unique<Texture>();
+  if (!m_atlas->createEmpty(k_atlas_size, k_atlas_size,
+                            Texture::Format::RGBA)) {
+    m_atlas.reset();
+    return false;
+  }
+
+  GLint prev_fbo = 0;
+  glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prev_fbo);
+
+  glGenFramebuffers(1, &m_fbo);
+  glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                         m_atlas->id(), 0);
+
+  glGenRenderbuffers(1, &m_depthRbo);
+  glBindRenderbuffer(GL_RENDERBUFFER, m_depthRbo);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, k_atlas_size,
+                        k_atlas_size);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+                            GL_RENDERBUFFER, m_depthRbo);
+  glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+  bool const complete =
+      glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+  glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(prev_fbo));
+  if (!complete) {
+    qWarning() << "ImpostorCache: atlas framebuffer incomplete";
+    shutdown();
+    return false;
+  }
+  return true;
+}
+
+void ImpostorCache::shutdown() {
+  m_ready.store(false, std::memory_order_release);
+  m_sprites.clear();
+  if (m_depthRbo != 0) {
+    glDeleteRenderbuffers(1, &m_depthRbo);
+    m_depthRbo = 0;
+  }
+  if (m_fbo != 0) {
+    glDeleteFramebuffers(1, &m_fbo);
+    m_fbo = 0;
+  }
+  m_atlas.reset();
+}
+
+void ImpostorCache::bake(const EntityRendererRegistry &registry,
+                         ResourceManager *resources, Backend *backend,
+                         Shader *bakeShader) {
+  if (m_fbo == 0 || bakeShader == nullptr) {
+    return;
+  }
+
+  auto types = registry.registeredTypes();
+  std::sort(types.begin(), types.end());
+
+  GLint prev_fbo = 0;
+  glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prev_fbo);
+  glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+  glEnable(GL_DEPTH_TEST);
+  glDepthMask(GL_TRUE);
+  glDisable(GL_BLEND);
+  glEnable(GL_SCISSOR_TEST);
+
+  auto const mvp_handle = bakeShader->uniformHandle("u_mvp");
+  auto const model_handle = bakeShader->uniformHandle("u_model");
+  auto const color_handle = bakeShader->uniformHandle("u_color");
+  auto const alpha_handle = bakeShader->uniformHandle("u_alpha");
+  auto const use_texture_handle = bakeShader->uniformHandle("u_useTexture");
+  bakeShader->use();
+  bakeShader->setUniform(use_texture_handle, false);
+
+  constexpr int k_max_rows = k_atlas_size / k_cell_size;
+  int row = 0;
+  for (const auto &type : types) {
+    if (row >= k_max_rows) {
+      qWarning() << "ImpostorCache: atlas full, skipping remaining types";
+      break;
+    }
+    auto fn = registry.get(type);
+    if (!fn) {
+      continue;
+    }
+
+    // Neutral snapshot at the origin: ownerId 0 keeps the palette off the
+    // team colours, so the sprite tints cleanly at draw time.
+    EntitySnapshot snap{};
+    snap.hasUnit = true;
+    if (auto spawn = Game::Units::spawn_typeFromString(type)) {
+      snap.spawnType = *spawn;
+    }
+
+    CaptureSubmitter capture;
+    DrawContext ctx{resources, &snap, QMatrix4x4()};
+    ctx.backend = backend;
+    ctx.lod = LodTier::Full;
+    fn(ctx, capture);
+    if (capture.parts.empty()) {
+      continue;
+    }
+
+    QVector3D lo(1e9F, 1e9F, 1e9F);
+    QVector3D hi(-1e9F, -1e9F, -1e9F);
+    for (const auto &part : capture.parts) {
+      auto const [mesh_lo, mesh_hi] = meshLocalBounds(part.mesh);
+      for (int corner = 0; corner < 8; ++corner) {
+        QVector3D const local(((corner & 1) != 0) ? mesh_hi.x() : mesh_lo.x(),
+                              ((corner & 2) != 0) ? mesh_hi.y() : mesh_lo.y(),
+                              ((corner & 4) != 0) ? mesh_hi.z()
+                                                  : mesh_lo.z());
+        QVector3D const world = part.model.map(local);
+        lo.setX(std::min(lo.x(), world.x()));
+        lo.setY(std::min(lo.y(), world.y()));
+        lo.setZ(std::min(lo.z(), world.z()));
+        hi.setX(std::max(hi.x(), world.x()));
+        hi.setY(std::max(hi.y(), world.y()));
+        hi.setZ(std::max(hi.z(), world.z()));
+      }
+    }
+
+    float const height = hi.y() - lo.y();
+    if (height < 0.01F) {
+      continue;
+    }
+    float const half_width =
+        std::max({std::abs(lo.x()), std::abs(hi.x()), std::abs(lo.z()),
+                  std::abs(hi.z())});
+    float const ext_x = half_width * k_bounds_margin;
+    float const center_y = (lo.y() + hi.y()) * 0.5F;
+    float const ext_y = height * 0.5F * k_bounds_margin;
+    float const eye_distance = 4.0F + 2.0F * height;
+
+    SpriteSet sprites;
+    for (int angle = 0; angle < YawSteps; ++angle) {
+      float const yaw =
+          static_cast<float>(angle) * (360.0F / YawSteps) * k_deg_to_rad;
+      QVector3D const eye(std::sin(yaw) * eye_distance, center_y,
+                          std::cos(yaw) * eye_distance);
+      QMatrix4x4 view;
+      view.lookAt(eye, QVector3D(0.0F, center_y, 0.0F),
+                  QVector3D(0.0F, 1.0F, 0.0F));
+      QMatrix4x4 proj;
+      proj.ortho(-ext_x, ext_x, -ext_y, ext_y, 0.1F, eye_distance * 2.0F);
+
+      int const cell_x = angle * k_cell_size;
+      int const cell_y = row * k_cell_size;
+      glViewport(cell_x, cell_y, k_cell_size, k_cell_size);
+      glScissor(cell_x, cell_y, k_cell_size, k_cell_size);
+      glClearColor(0.0F, 0.0F, 0.0F, 0.0F);
+      glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+      for (const auto &part : capture.parts) {
+        bakeShader->setUniform(mvp_handle, proj * view * part.model);
+        bakeShader->setUniform(model_handle, part.model);
+        bakeShader->setUniform(color_handle, part.color);
+        bakeShader->setUniform(alpha_handle, 1.0F);
+        part.mesh->draw();
+      }
+
+      float const u0 = (static_cast<float>(cell_x) + k_uv_inset_px) /
+                       static_cast<float>(k_atlas_size);
+      float const u1 =
+          (static_cast<float>(cell_x + k_cell_size) - k_uv_inset_px) /
+          static_cast<float>(k_atlas_size);
+      float const v0 = (static_cast<float>(cell_y) + k_uv_inset_px) /
+                       static_cast<float>(k_atlas_size);
+      float const v1 =
+          (static_cast<float>(cell_y + k_cell_size) - k_uv_inset_px) /
+          static_cast<float>(k_atlas_size);
+
+      // Quad spanning exactly the baked ortho window in unit-local space,
+      // so the sprite reprojects at the same world size it was baked at.
+      std::vector<Vertex> const vertices = {
+          {{-ext_x, center_y - ext_y, 0.0F}, {0.0F, 0.0F, 1.0F}, {u0, v0}},
+          {{ext_x, center_y - ext_y, 0.0F}, {0.0F, 0.0F, 1.0F}, {u1, v0}},
+          {{ext_x, center_y + ext_y, 0.0F}, {0.0F, 0.0F, 1.0F}, {u1, v1}},
+          {{-ext_x, center_y + ext_y, 0.0F}, {0.0F, 0.0F, 1.0F}, {u0, v1}}};
+      std::vector<unsigned int> const indices = {0, 1, 2, 2, 3, 0};
+      sprites.quads[angle] = std::make_unique<Mesh>(vertices, indices);
+    }
+
+    m_sprites.emplace(type, std::move(sprites));
+    ++row;
+  }
+
+  glDisable(GL_SCISSOR_TEST);
+  glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(prev_fbo));
+  m_ready.store(!m_sprites.empty(), std::memory_order_release);
+}
+
+auto ImpostorCache::submitImpostor(const std::string &type,
+                                   const EntitySnapshot &snap,
+                                   const QVector3D &cameraPos,
+                                   Shader *drawShader,
+                                   ISubmitter &out) const -> bool {
+  if (drawShader == nullptr) {
+    return false;
+  }
+  auto it = m_sprites.find(type);
+  if (it == m_sprites.end()) {
+    return false;
+  }
+
+  QVector3D const to_camera = cameraPos - snap.position;
+  float const camera_yaw_deg =
+      std::atan2(to_camera.x(), to_camera.z()) * k_rad_to_deg;
+
+  // The cell baked at local yaw a shows the unit as seen from that
+  // direction; pick the one matching where the camera sits relative to
+  // the unit's facing.
+  float relative = camera_yaw_deg - snap.yawDeg;
+  relative = std::fmod(relative, 360.0F);
+  if (relative < 0.0F) {
+    relative += 360.0F;
+  }
+  int const angle =
+      static_cast<int>(relative / (360.0F / YawSteps) + 0.5F) % YawSteps;
+  Mesh *quad = it->second.quads[static_cast<std::size_t>(angle)].get();
+  if (quad == nullptr) {
+    return false;
+  }
+
+  QMatrix4x4 model;
+  model.translate(snap.position);
+  model.rotate(camera_yaw_deg, 0.0F, 1.0F, 0.0F);
+  model.scale(snap.scale);
+
+  QVector3D const tint = (snap.ownerId > 0)
+                             ? Game::Visuals::team_colorForOwner(snap.ownerId)
+                             : snap.color;
+  out.setShader(drawShader);
+  out.mesh(quad, model, tint, m_atlas.get(), 1.0F);
+  out.setShader(nullptr);
+  return true;
+}
+
+} // namespace Render::GL
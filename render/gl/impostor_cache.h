@@ -0,0 +1,75 @@
+#pragma once
+
+#include "../entity/registry.h"
+#include "texture.h"
+#include <QOpenGLFunctions_3_3_Core>
+#include <QVector3D>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace Render::GL {
+
+class Backend;
+class Mesh;
+class ResourceManager;
+class Shader;
+struct EntitySnapshot;
+
+// Bakes each registered unit archetype into one row of an RGBA sprite
+// atlas — eight yaw angles of the idle pose, rendered once through the
+// normal entity renderer into an offscreen target — and then serves
+// camera-facing quads for units past the Impostor LOD ring. The quads go
+// through the regular mesh path with the alpha-tested impostor shader, so
+// a zoomed-out crowd of one type collapses into a handful of instanced
+// draws regardless of unit count. Team colour is applied at draw time as
+// a whole-sprite tint; the bake itself uses a neutral palette.
+class ImpostorCache : protected QOpenGLFunctions_3_3_Core {
+public:
+  static constexpr int YawSteps = 8;
+
+  ImpostorCache() = default;
+  ~ImpostorCache() override;
+
+  ImpostorCache(const ImpostorCache &) = delete;
+  auto operator=(const ImpostorCache &) -> ImpostorCache & = delete;
+  ImpostorCache(ImpostorCache &&) = delete;
+  auto operator=(ImpostorCache &&) -> ImpostorCache & = delete;
+
+  // GL-thread only; creates the atlas and its framebuffer.
+  auto initialize() -> bool;
+  void shutdown();
+
+  // Renders every registered type into the atlas. GL-thread only; runs
+  // once, after the shader cache and entity registry are up.
+  void bake(const EntityRendererRegistry &registry, ResourceManager *resources,
+            Backend *backend, Shader *bakeShader);
+
+  // True once the atlas holds pixels; safe to poll from the submit workers.
+  [[nodiscard]] auto ready() const -> bool {
+    return m_ready.load(std::memory_order_acquire);
+  }
+
+  // Submits the baked quad for one far unit. Returns false when the type
+  // was never baked so the caller can fall back to real geometry.
+  auto submitImpostor(const std::string &type, const EntitySnapshot &snap,
+                      const QVector3D &cameraPos, Shader *drawShader,
+                      ISubmitter &out) const -> bool;
+
+  [[nodiscard]] auto atlas() const -> Texture * { return m_atlas.get(); }
+
+private:
+  struct SpriteSet {
+    std::array<std::unique_ptr<Mesh>, YawSteps> quads;
+  };
+
+  std::unordered_map<std::string, SpriteSet> m_sprites;
+  std::unique_ptr<Texture> m_atlas;
+  GLuint m_fbo = 0;
+  GLuint m_depthRbo = 0;
+  std::atomic<bool> m_ready{false};
+};
+
+} // namespace Render::GL
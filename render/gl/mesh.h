@@ -22,6 +22,14 @@ public:
 
   void draw();
 
+  // Uploads the GPU buffers now instead of on first draw; used by the
+  // background streamer to warm meshes during loading frames.
+  void ensureUploaded() {
+    if (!m_vao) {
+      setupBuffers();
+    }
+  }
+
   [[nodiscard]] auto getVertices() const -> const std::vector<Vertex> & {
     return m_vertices;
   }
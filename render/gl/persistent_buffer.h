@@ -6,6 +6,7 @@
 #include <QOpenGLExtraFunctions>
 #include <cstddef>
 #include <cstring>
+#include <vector>
 
 namespace Render::GL {
 
@@ -37,6 +38,7 @@ public:
     m_totalSize = capacity * sizeof(T) * buffersInFlight;
     m_currentFrame = 0;
     m_frameOffset = 0;
+    m_fences.assign(static_cast<std::size_t>(buffersInFlight), nullptr);
 
     glGenBuffers(1, &m_buffer);
     glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
@@ -98,6 +100,14 @@ public:
 
     initializeOpenGLFunctions();
 
+    for (GLsync &fence : m_fences) {
+      if (fence != nullptr) {
+        glDeleteSync(fence);
+        fence = nullptr;
+      }
+    }
+    m_fences.clear();
+
     if (m_mappedPtr != nullptr) {
       glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
       glUnmapBuffer(GL_ARRAY_BUFFER);
@@ -111,14 +121,42 @@ public:
     m_totalSize = 0;
   }
 
+  // Rotates to the next slice, blocking on its fence if the GPU is still
+  // reading it. With BuffersInFlight slices the wait only triggers when the
+  // GPU falls more than that many frames behind.
   void beginFrame() {
     m_currentFrame = (m_currentFrame + 1) % m_buffersInFlight;
     m_frameOffset = m_currentFrame * m_capacity * sizeof(T);
     m_currentCount = 0;
+
+    if (m_fences.empty()) {
+      return;
+    }
+    GLsync &fence = m_fences[static_cast<std::size_t>(m_currentFrame)];
+    if (fence != nullptr) {
+      const GLuint64 timeout_ns = 1000000000ULL;
+      glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout_ns);
+      glDeleteSync(fence);
+      fence = nullptr;
+    }
+  }
+
+  // Call after the last draw sourcing this frame's slice; beginFrame waits
+  // on this fence before handing the slice out again.
+  void endFrame() {
+    if (m_buffer == 0 || m_fences.empty()) {
+      return;
+    }
+    GLsync &fence = m_fences[static_cast<std::size_t>(m_currentFrame)];
+    if (fence != nullptr) {
+      glDeleteSync(fence);
+    }
+    fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
   }
 
   auto write(const T *data, std::size_t count) -> std::size_t {
-    if ((m_mappedPtr == nullptr) || count == 0 || count > m_capacity) {
+    if ((m_mappedPtr == nullptr) || count == 0 ||
+        m_currentCount + count > m_capacity) {
       return 0;
     }
 
@@ -132,6 +170,28 @@ public:
     return elementOffset;
   }
 
+  // Hands out the next `count` elements of this frame's slice so callers
+  // can build instances directly in mapped memory instead of staging them
+  // in CPU scratch and memcpying through write(). Returns nullptr when the
+  // range does not fit; pair with commitWrite once the elements are filled.
+  [[nodiscard]] auto mapRange(std::size_t count) -> T * {
+    if ((m_mappedPtr == nullptr) || count == 0 ||
+        m_currentCount + count > m_capacity) {
+      return nullptr;
+    }
+    return reinterpret_cast<T *>(static_cast<char *>(m_mappedPtr) +
+                                 m_frameOffset) +
+           m_currentCount;
+  }
+
+  // Advances the cursor past a range previously handed out by mapRange and
+  // returns its element offset within the frame slice.
+  auto commitWrite(std::size_t count) -> std::size_t {
+    std::size_t const elementOffset = m_currentCount;
+    m_currentCount += count;
+    return elementOffset;
+  }
+
   [[nodiscard]] auto buffer() const -> GLuint { return m_buffer; }
 
   [[nodiscard]] auto currentOffset() const -> std::size_t {
@@ -155,6 +215,7 @@ private:
   std::size_t m_currentCount = 0;
   int m_buffersInFlight = BufferCapacity::BuffersInFlight;
   int m_currentFrame = 0;
+  std::vector<GLsync> m_fences;
 };
 
 } // namespace Render::GL
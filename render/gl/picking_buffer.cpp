@@ -0,0 +1,173 @@
+#include "picking_buffer.h"
+#include "mesh.h"
+#include "shader.h"
+#include <QDebug>
+#include <cstdint>
+
+namespace Render::GL {
+
+PickingBuffer::~PickingBuffer() {
+  destroyTarget();
+  if (m_pbos[0] != 0 || m_pbos[1] != 0) {
+    glDeleteBuffers(2, m_pbos.data());
+  }
+}
+
+auto PickingBuffer::initialize() -> bool {
+  if (m_initialized) {
+    return true;
+  }
+  if (!initializeOpenGLFunctions()) {
+    qWarning() << "PickingBuffer: failed to resolve GL functions";
+    return false;
+  }
+  glGenBuffers(2, m_pbos.data());
+  for (GLuint const pbo : m_pbos) {
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+    glBufferData(GL_PIXEL_PACK_BUFFER, sizeof(std::uint32_t), nullptr,
+                 GL_STREAM_READ);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  m_initialized = true;
+  return true;
+}
+
+auto PickingBuffer::ensureTarget(int width, int height) -> bool {
+  if (width <= 0 || height <= 0) {
+    return false;
+  }
+  if (m_fbo != 0 && width == m_width && height == m_height) {
+    return true;
+  }
+  destroyTarget();
+
+  glGenTextures(1, &m_idTexture);
+  glBindTexture(GL_TEXTURE_2D, m_idTexture);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_R32UI, width, height, 0, GL_RED_INTEGER,
+               GL_UNSIGNED_INT, nullptr);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  glGenRenderbuffers(1, &m_depthRbo);
+  glBindRenderbuffer(GL_RENDERBUFFER, m_depthRbo);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+  glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+  glGenFramebuffers(1, &m_fbo);
+  glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                         m_idTexture, 0);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+                            GL_RENDERBUFFER, m_depthRbo);
+  bool const complete =
+      glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+  if (!complete) {
+    qWarning() << "PickingBuffer: ID framebuffer incomplete";
+    destroyTarget();
+    return false;
+  }
+
+  m_width = width;
+  m_height = height;
+  // Target was recreated, so any in-flight readbacks refer to stale sizes.
+  m_pboPending = {false, false};
+  return true;
+}
+
+void PickingBuffer::destroyTarget() {
+  if (m_fbo != 0) {
+    glDeleteFramebuffers(1, &m_fbo);
+    m_fbo = 0;
+  }
+  if (m_idTexture != 0) {
+    glDeleteTextures(1, &m_idTexture);
+    m_idTexture = 0;
+  }
+  if (m_depthRbo != 0) {
+    glDeleteRenderbuffers(1, &m_depthRbo);
+    m_depthRbo = 0;
+  }
+  m_width = 0;
+  m_height = 0;
+}
+
+void PickingBuffer::resolvePending() {
+  int const read_index = 1 - m_writeIndex;
+  if (!m_pboPending[read_index]) {
+    return;
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, m_pbos[read_index]);
+  auto *mapped = static_cast<const std::uint32_t *>(glMapBufferRange(
+      GL_PIXEL_PACK_BUFFER, 0, sizeof(std::uint32_t), GL_MAP_READ_BIT));
+  if (mapped != nullptr) {
+    m_latestId = *mapped;
+    m_hasResult = true;
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  m_pboPending[read_index] = false;
+}
+
+void PickingBuffer::renderAndRead(const std::vector<DrawCmd> &cmds,
+                                  Shader *shader, const QMatrix4x4 &view_proj,
+                                  int width, int height, float sx, float sy) {
+  if (!m_initialized || shader == nullptr) {
+    return;
+  }
+
+  // The scene may render into a non-default framebuffer (e.g. under a
+  // QML compositor), so save and restore whatever is bound.
+  GLint prev_fbo = 0;
+  glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prev_fbo);
+
+  if (!ensureTarget(width, height)) {
+    return;
+  }
+
+  glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+  glViewport(0, 0, width, height);
+  GLuint const clear_id[4] = {0, 0, 0, 0};
+  glClearBufferuiv(GL_COLOR, 0, clear_id);
+  GLfloat const clear_depth = 1.0F;
+  glClearBufferfv(GL_DEPTH, 0, &clear_depth);
+
+  glEnable(GL_DEPTH_TEST);
+  glDepthMask(GL_TRUE);
+  glDisable(GL_BLEND);
+
+  shader->use();
+  Shader::UniformHandle const mvp_handle = shader->uniformHandle("u_mvp");
+  Shader::UniformHandle const id_handle = shader->uniformHandle("u_entityId");
+  for (const auto &cmd : cmds) {
+    if (cmd.mesh == nullptr || cmd.entityId == 0) {
+      continue;
+    }
+    shader->setUniform(mvp_handle, view_proj * cmd.model);
+    glUniform1ui(id_handle, cmd.entityId);
+    cmd.mesh->draw();
+  }
+  shader->release();
+
+  // Resolve the readback issued last frame before queueing a new one, so
+  // the map never waits on this frame's transfer.
+  resolvePending();
+
+  int const px = static_cast<int>(sx);
+  int const py = height - 1 - static_cast<int>(sy);
+  if (px >= 0 && px < width && py >= 0 && py < height) {
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_pbos[m_writeIndex]);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glReadPixels(px, py, 1, 1, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    m_pboPending[m_writeIndex] = true;
+    m_writeIndex = 1 - m_writeIndex;
+  } else {
+    m_latestId = 0;
+    m_hasResult = false;
+  }
+
+  glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(prev_fbo));
+}
+
+} // namespace Render::GL
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <QMatrix4x4>
+#include <QOpenGLFunctions_3_3_Core>
+#include <array>
+#include <vector>
+
+namespace Render::GL {
+
+class Mesh;
+class Shader;
+
+// Offscreen entity-ID target for GPU picking. Proxy volumes are drawn into
+// an R32UI attachment with the picking_id shader, then a single pixel under
+// the cursor is read back through a pair of pack PBOs so the result arrives
+// one frame later without stalling the pipeline. Id 0 means "nothing".
+class PickingBuffer : protected QOpenGLFunctions_3_3_Core {
+public:
+  struct DrawCmd {
+    unsigned int entityId = 0;
+    QMatrix4x4 model;
+    Mesh *mesh = nullptr;
+  };
+
+  PickingBuffer() = default;
+  ~PickingBuffer() override;
+
+  PickingBuffer(const PickingBuffer &) = delete;
+  auto operator=(const PickingBuffer &) -> PickingBuffer & = delete;
+  PickingBuffer(PickingBuffer &&) = delete;
+  auto operator=(PickingBuffer &&) -> PickingBuffer & = delete;
+
+  auto initialize() -> bool;
+
+  // Renders the proxy volumes into the ID target, resolves last frame's
+  // readback and queues a new one at (sx, sy) in window coordinates. Must
+  // run on the render thread with the GL context current.
+  void renderAndRead(const std::vector<DrawCmd> &cmds, Shader *shader,
+                     const QMatrix4x4 &view_proj, int width, int height,
+                     float sx, float sy);
+
+  // Latest resolved id; valid is false until the first readback completes
+  // or after the cursor leaves the viewport.
+  [[nodiscard]] auto latestId() const -> unsigned int { return m_latestId; }
+  [[nodiscard]] auto hasResult() const -> bool { return m_hasResult; }
+  void invalidateResult() { m_hasResult = false; }
+
+private:
+  auto ensureTarget(int width, int height) -> bool;
+  void destroyTarget();
+  void resolvePending();
+
+  GLuint m_fbo = 0;
+  GLuint m_idTexture = 0;
+  GLuint m_depthRbo = 0;
+  std::array<GLuint, 2> m_pbos{0, 0};
+  std::array<bool, 2> m_pboPending{false, false};
+  int m_writeIndex = 0;
+  int m_width = 0;
+  int m_height = 0;
+  unsigned int m_latestId = 0;
+  bool m_hasResult = false;
+  bool m_initialized = false;
+};
+
+} // namespace Render::GL
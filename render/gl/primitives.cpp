@@ -3,9 +3,12 @@
 #include <QVector3D>
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <memory>
 #include <numbers>
 #include <qvectornd.h>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace Render::GL {
@@ -566,35 +569,77 @@ auto createUnitTorsoMesh(int radialSegments, int heightSegments) -> Mesh * {
   return new Mesh(v, idx);
 }
 
+// Cache keyed by primitive kind plus its quantized generation
+// parameters. The previous per-function statics latched whatever
+// parameters the *first* caller passed and returned that mesh to every
+// later caller; keying by parameters makes distinct parametrizations
+// correct while identical parts across unit renderers still share one
+// GPU mesh, generated once. Radial/latitude counts snap to multiples of
+// four so near-identical requests (30 vs 32 segments) collapse to the
+// same entry instead of duplicating vertex buffers.
+enum class PrimitiveKind : std::uint32_t {
+  Cylinder,
+  Sphere,
+  Cone,
+  Capsule,
+  Torso
+};
+
+auto quantizeSegments(int segments) -> int {
+  int const snapped = ((segments + 2) / 4) * 4;
+  return std::clamp(snapped, 4, 64);
+}
+
+auto makeKey(PrimitiveKind kind, int a, int b) -> std::uint64_t {
+  return (static_cast<std::uint64_t>(kind) << 32U) |
+         (static_cast<std::uint64_t>(static_cast<std::uint32_t>(a)) << 16U) |
+         static_cast<std::uint64_t>(static_cast<std::uint32_t>(b));
+}
+
+// All primitive lookups happen on the render thread during mesh
+// emission, so the map needs no lock.
+template <typename Generate>
+auto cachedMesh(std::uint64_t key, Generate &&generate) -> Mesh * {
+  static std::unordered_map<std::uint64_t, std::unique_ptr<Mesh>> s_cache;
+  auto it = s_cache.find(key);
+  if (it == s_cache.end()) {
+    it = s_cache.emplace(key, std::unique_ptr<Mesh>(generate())).first;
+  }
+  return it->second.get();
+}
+
 } // namespace
 
 auto getUnitCylinder(int radialSegments) -> Mesh * {
-  static std::unique_ptr<Mesh> const s_mesh(
-      createUnitCylinderMesh(radialSegments));
-  return s_mesh.get();
+  int const radial = quantizeSegments(radialSegments);
+  return cachedMesh(makeKey(PrimitiveKind::Cylinder, radial, 0),
+                    [&] { return createUnitCylinderMesh(radial); });
 }
 
 auto getUnitSphere(int latSegments, int lonSegments) -> Mesh * {
-  static std::unique_ptr<Mesh> const s_mesh(
-      createUnitSphereMesh(latSegments, lonSegments));
-  return s_mesh.get();
+  int const lat = quantizeSegments(latSegments);
+  int const lon = quantizeSegments(lonSegments);
+  return cachedMesh(makeKey(PrimitiveKind::Sphere, lat, lon),
+                    [&] { return createUnitSphereMesh(lat, lon); });
 }
 
 auto getUnitCone(int radialSegments) -> Mesh * {
-  static std::unique_ptr<Mesh> const s_mesh(createUnitConeMesh(radialSegments));
-  return s_mesh.get();
+  int const radial = quantizeSegments(radialSegments);
+  return cachedMesh(makeKey(PrimitiveKind::Cone, radial, 0),
+                    [&] { return createUnitConeMesh(radial); });
 }
 
 auto getUnitCapsule(int radialSegments, int heightSegments) -> Mesh * {
-  static std::unique_ptr<Mesh> const s_mesh(
-      createCapsuleMesh(radialSegments, heightSegments));
-  return s_mesh.get();
+  int const radial = quantizeSegments(radialSegments);
+  return cachedMesh(makeKey(PrimitiveKind::Capsule, radial, heightSegments),
+                    [&] { return createCapsuleMesh(radial, heightSegments); });
 }
 
 auto getUnitTorso(int radialSegments, int heightSegments) -> Mesh * {
-  static std::unique_ptr<Mesh> const s_mesh(
-      createUnitTorsoMesh(radialSegments, heightSegments));
-  return s_mesh.get();
+  int const radial = quantizeSegments(radialSegments);
+  return cachedMesh(makeKey(PrimitiveKind::Torso, radial, heightSegments), [&] {
+    return createUnitTorsoMesh(radial, heightSegments);
+  });
 }
 
 } // namespace Render::GL
@@ -49,6 +49,12 @@ inline constexpr int MinLengthSteps = 8;
 inline constexpr int MinLengthSegments = 8;
 } // namespace Render::GL::Geometry
 
+namespace Render::GL::UniformBlock {
+// Binding point the shaders' shared FrameUniforms block is wired to at
+// link time; the backend binds the per-frame UBO here once per frame.
+inline constexpr unsigned int FrameBinding = 0;
+} // namespace Render::GL::UniformBlock
+
 namespace Render::GL::Growth {
 inline constexpr int CapacityMultiplier = 2;
 }
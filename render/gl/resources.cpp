@@ -25,6 +25,11 @@ auto ResourceManager::initialize() -> bool {
   m_whiteTexture->bind();
   glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE,
                   white_pixel);
+
+  m_uploader = std::make_unique<AsyncUploader>();
+  if (!m_uploader->initialize()) {
+    m_uploader.reset();
+  }
   return true;
 }
 
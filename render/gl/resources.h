@@ -1,5 +1,6 @@
 #pragma once
 
+#include "async_uploader.h"
 #include "mesh.h"
 #include "texture.h"
 #include <QOpenGLFunctions_3_3_Core>
@@ -24,12 +25,19 @@ public:
   }
   [[nodiscard]] auto white() const -> Texture * { return m_whiteTexture.get(); }
 
+  // Background streamer for texture/mesh uploads; the backend pumps it
+  // once per frame.
+  [[nodiscard]] auto uploader() const -> AsyncUploader * {
+    return m_uploader.get();
+  }
+
 private:
   std::unique_ptr<Mesh> m_quadMesh;
   std::unique_ptr<Mesh> m_groundMesh;
   std::unique_ptr<Mesh> m_unitMesh;
 
   std::unique_ptr<Texture> m_whiteTexture;
+  std::unique_ptr<AsyncUploader> m_uploader;
 };
 
 } // namespace Render::GL
@@ -3,9 +3,15 @@
 #include "utils/resource_utils.h"
 #include <GL/gl.h>
 #include <QByteArray>
+#include <QCryptographicHash>
 #include <QDebug>
+#include <QDir>
 #include <QFile>
+#include <QOpenGLContext>
+#include <QSaveFile>
+#include <QStandardPaths>
 #include <QTextStream>
+#include <cstring>
 #include <qdebug.h>
 #include <qdir.h>
 #include <qfiledevice.h>
@@ -16,6 +22,64 @@
 #include <qstringview.h>
 #include <qvectornd.h>
 
+namespace {
+
+// ARB_get_program_binary entry points; core only from GL 4.1, so they are
+// resolved at runtime and the cache quietly disables itself when absent.
+using GetProgramBinaryFn = void(QOPENGLF_APIENTRYP)(GLuint program,
+                                                    GLsizei bufSize,
+                                                    GLsizei *length,
+                                                    GLenum *binaryFormat,
+                                                    void *binary);
+using ProgramBinaryFn = void(QOPENGLF_APIENTRYP)(GLuint program,
+                                                 GLenum binaryFormat,
+                                                 const void *binary,
+                                                 GLsizei length);
+
+auto resolveGetProgramBinary() -> GetProgramBinaryFn {
+  auto *context = QOpenGLContext::currentContext();
+  if (context == nullptr) {
+    return nullptr;
+  }
+  return reinterpret_cast<GetProgramBinaryFn>(
+      context->getProcAddress("glGetProgramBinary"));
+}
+
+auto resolveProgramBinary() -> ProgramBinaryFn {
+  auto *context = QOpenGLContext::currentContext();
+  if (context == nullptr) {
+    return nullptr;
+  }
+  return reinterpret_cast<ProgramBinaryFn>(
+      context->getProcAddress("glProgramBinary"));
+}
+
+// GL_KHR_parallel_shader_compile tokens and entry point; the extension is
+// optional, so everything is resolved at runtime and the deferred-load
+// path quietly degrades to blocking finalization without it.
+constexpr GLenum kMaxShaderCompilerThreadsKhr = 0x91B0;
+constexpr GLenum kCompletionStatusKhr = 0x91B1;
+
+using MaxShaderCompilerThreadsFn = void(QOPENGLF_APIENTRYP)(GLuint count);
+
+auto hasParallelShaderCompile() -> bool {
+  auto *context = QOpenGLContext::currentContext();
+  return context != nullptr &&
+         context->hasExtension(
+             QByteArrayLiteral("GL_KHR_parallel_shader_compile"));
+}
+
+auto binaryCacheDir() -> QString {
+  const QString base =
+      QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+  if (base.isEmpty()) {
+    return {};
+  }
+  return base + QStringLiteral("/shader_binaries");
+}
+
+} // namespace
+
 namespace Render::GL {
 
 using namespace Render::GL::BufferCapacity;
@@ -23,13 +87,35 @@ using namespace Render::GL::BufferCapacity;
 Shader::Shader() = default;
 
 Shader::~Shader() {
+  if (m_pendingVert != 0) {
+    glDeleteShader(m_pendingVert);
+  }
+  if (m_pendingFrag != 0) {
+    glDeleteShader(m_pendingFrag);
+  }
   if (m_program != 0) {
     glDeleteProgram(m_program);
   }
 }
 
-auto Shader::loadFromFiles(const QString &vertexPath,
-                           const QString &fragmentPath) -> bool {
+void Shader::uncapCompilerThreads() {
+  auto *context = QOpenGLContext::currentContext();
+  if (context == nullptr || !hasParallelShaderCompile()) {
+    return;
+  }
+  auto max_threads = reinterpret_cast<MaxShaderCompilerThreadsFn>(
+      context->getProcAddress("glMaxShaderCompilerThreadsKHR"));
+  if (max_threads != nullptr) {
+    // 0xFFFFFFFF asks for the implementation's own maximum.
+    max_threads(0xFFFFFFFFU);
+  }
+}
+
+namespace {
+
+auto readShaderSources(const QString &vertexPath, const QString &fragmentPath,
+                       QString &vertex_source,
+                       QString &fragment_source) -> bool {
   const QString resolved_vert =
       Utils::Resources::resolveResourcePath(vertexPath);
   const QString resolved_frag =
@@ -58,16 +144,127 @@ auto Shader::loadFromFiles(const QString &vertexPath,
   QTextStream vertex_stream(&vertex_file);
   QTextStream fragment_stream(&fragment_file);
 
-  QString const vertex_source = vertex_stream.readAll();
-  QString const fragment_source = fragment_stream.readAll();
+  vertex_source = vertex_stream.readAll();
+  fragment_source = fragment_stream.readAll();
+  return true;
+}
 
+} // namespace
+
+auto Shader::loadFromFiles(const QString &vertexPath,
+                           const QString &fragmentPath) -> bool {
+  QString vertex_source;
+  QString fragment_source;
+  if (!readShaderSources(vertexPath, fragmentPath, vertex_source,
+                         fragment_source)) {
+    return false;
+  }
   return loadFromSource(vertex_source, fragment_source);
 }
 
+auto Shader::beginLoadFromFiles(const QString &vertexPath,
+                                const QString &fragmentPath) -> bool {
+  QString vertex_source;
+  QString fragment_source;
+  if (!readShaderSources(vertexPath, fragmentPath, vertex_source,
+                         fragment_source)) {
+    return false;
+  }
+
+  initializeOpenGLFunctions();
+  m_uniformCache.clear();
+
+  const QString cache_path = binaryCachePathFor(vertex_source, fragment_source);
+  if (!cache_path.isEmpty() && tryLoadCachedBinary(cache_path)) {
+    m_loadPending = false;
+    return true;
+  }
+
+  // Kick compilation and the link without any status query; checks would
+  // stall the driver's compiler threads, so they wait until finishLoad.
+  m_pendingVert = compileShaderDeferred(vertex_source, GL_VERTEX_SHADER);
+  m_pendingFrag = compileShaderDeferred(fragment_source, GL_FRAGMENT_SHADER);
+  m_program = glCreateProgram();
+  glAttachShader(m_program, m_pendingVert);
+  glAttachShader(m_program, m_pendingFrag);
+  glLinkProgram(m_program);
+
+  m_pendingCachePath = cache_path;
+  m_loadPending = true;
+  return true;
+}
+
+auto Shader::isReady() -> bool {
+  if (!m_loadPending) {
+    return true;
+  }
+  if (!hasParallelShaderCompile()) {
+    return true;
+  }
+  initializeOpenGLFunctions();
+  GLint done = 0;
+  glGetProgramiv(m_program, kCompletionStatusKhr, &done);
+  return done != 0;
+}
+
+auto Shader::finishLoad() -> bool {
+  if (!m_loadPending) {
+    return m_program != 0;
+  }
+  m_loadPending = false;
+
+  initializeOpenGLFunctions();
+
+  bool shaders_ok = true;
+  for (GLuint const shader : {m_pendingVert, m_pendingFrag}) {
+    GLint success = 0;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (success == 0) {
+      GLchar info_log[ShaderInfoLogSize];
+      glGetShaderInfoLog(shader, ShaderInfoLogSize, nullptr, info_log);
+      qWarning() << "Shader compilation failed:" << info_log;
+      shaders_ok = false;
+    }
+  }
+
+  GLint linked = 0;
+  glGetProgramiv(m_program, GL_LINK_STATUS, &linked);
+  if (linked == 0 && shaders_ok) {
+    GLchar info_log[ShaderInfoLogSize];
+    glGetProgramInfoLog(m_program, ShaderInfoLogSize, nullptr, info_log);
+    qWarning() << "Shader linking failed:" << info_log;
+  }
+
+  glDeleteShader(m_pendingVert);
+  glDeleteShader(m_pendingFrag);
+  m_pendingVert = 0;
+  m_pendingFrag = 0;
+
+  if (!shaders_ok || linked == 0) {
+    glDeleteProgram(m_program);
+    m_program = 0;
+    m_pendingCachePath.clear();
+    return false;
+  }
+
+  if (!m_pendingCachePath.isEmpty()) {
+    storeCachedBinary(m_pendingCachePath);
+    m_pendingCachePath.clear();
+  }
+  return true;
+}
+
 auto Shader::loadFromSource(const QString &vertex_source,
                             const QString &fragment_source) -> bool {
   initializeOpenGLFunctions();
   m_uniformCache.clear();
+
+  const QString cache_path =
+      binaryCachePathFor(vertex_source, fragment_source);
+  if (!cache_path.isEmpty() && tryLoadCachedBinary(cache_path)) {
+    return true;
+  }
+
   GLuint const vertex_shader = compileShader(vertex_source, GL_VERTEX_SHADER);
   GLuint const fragment_shader =
       compileShader(fragment_source, GL_FRAGMENT_SHADER);
@@ -81,9 +278,117 @@ auto Shader::loadFromSource(const QString &vertex_source,
   glDeleteShader(vertex_shader);
   glDeleteShader(fragment_shader);
 
+  if (success && !cache_path.isEmpty()) {
+    storeCachedBinary(cache_path);
+  }
+
   return success;
 }
 
+auto Shader::binaryCachePathFor(const QString &vertex_source,
+                                const QString &fragment_source) -> QString {
+  const QString dir = binaryCacheDir();
+  if (dir.isEmpty()) {
+    return {};
+  }
+
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  hash.addData(vertex_source.toUtf8());
+  hash.addData(QByteArrayLiteral("\0"));
+  hash.addData(fragment_source.toUtf8());
+  hash.addData(QByteArrayLiteral("\0"));
+  for (GLenum const name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+    const auto *str = reinterpret_cast<const char *>(glGetString(name));
+    if (str != nullptr) {
+      hash.addData(QByteArray(str));
+    }
+  }
+
+  return dir + QLatin1Char('/') + QString::fromLatin1(hash.result().toHex()) +
+         QStringLiteral(".bin");
+}
+
+auto Shader::tryLoadCachedBinary(const QString &cache_path) -> bool {
+  ProgramBinaryFn const program_binary = resolveProgramBinary();
+  if (program_binary == nullptr) {
+    return false;
+  }
+
+  GLint format_count = 0;
+  glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+  if (format_count <= 0) {
+    return false;
+  }
+
+  QFile file(cache_path);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+  const QByteArray blob = file.readAll();
+  if (blob.size() <= static_cast<int>(sizeof(GLenum))) {
+    return false;
+  }
+
+  GLenum format = 0;
+  std::memcpy(&format, blob.constData(), sizeof(GLenum));
+
+  m_program = glCreateProgram();
+  program_binary(m_program, format, blob.constData() + sizeof(GLenum),
+                 static_cast<GLsizei>(blob.size() - sizeof(GLenum)));
+
+  GLint success = 0;
+  glGetProgramiv(m_program, GL_LINK_STATUS, &success);
+  if (success == 0) {
+    // Stale entry (typically a driver update the identity strings did not
+    // reflect); fall back to a fresh compile, which rewrites the file.
+    glDeleteProgram(m_program);
+    m_program = 0;
+    return false;
+  }
+
+  return true;
+}
+
+void Shader::storeCachedBinary(const QString &cache_path) {
+  GetProgramBinaryFn const get_program_binary = resolveGetProgramBinary();
+  if (get_program_binary == nullptr || m_program == 0) {
+    return;
+  }
+
+  GLint format_count = 0;
+  glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+  if (format_count <= 0) {
+    return;
+  }
+
+  GLint binary_length = 0;
+  glGetProgramiv(m_program, GL_PROGRAM_BINARY_LENGTH, &binary_length);
+  if (binary_length <= 0) {
+    return;
+  }
+
+  QByteArray blob(static_cast<int>(sizeof(GLenum)) + binary_length, '\0');
+  GLenum format = 0;
+  GLsizei written = 0;
+  get_program_binary(m_program, binary_length, &written, &format,
+                     blob.data() + sizeof(GLenum));
+  if (written <= 0) {
+    return;
+  }
+  std::memcpy(blob.data(), &format, sizeof(GLenum));
+  blob.truncate(static_cast<int>(sizeof(GLenum)) + written);
+
+  if (!QDir().mkpath(binaryCacheDir())) {
+    return;
+  }
+  QSaveFile file(cache_path);
+  if (!file.open(QIODevice::WriteOnly)) {
+    return;
+  }
+  file.write(blob);
+  file.commit();
+}
+
 void Shader::use() {
   initializeOpenGLFunctions();
   glUseProgram(m_program);
@@ -116,6 +421,23 @@ auto Shader::uniformHandle(const char *name) -> Shader::UniformHandle {
   return location;
 }
 
+auto Shader::bindUniformBlock(const char *name, GLuint binding_point) -> bool {
+  if ((name == nullptr) || *name == '\0' || m_program == 0) {
+    return false;
+  }
+
+  initializeOpenGLFunctions();
+  GLuint const index = glGetUniformBlockIndex(m_program, name);
+  if (index == GL_INVALID_INDEX) {
+    qWarning() << "Shader uniform block not found:" << name
+               << "(program:" << m_program << ")";
+    return false;
+  }
+
+  glUniformBlockBinding(m_program, index, binding_point);
+  return true;
+}
+
 void Shader::setUniform(UniformHandle handle, float value) {
   initializeOpenGLFunctions();
   if (handle != InvalidUniform) {
@@ -230,6 +552,19 @@ auto Shader::compileShader(const QString &source, GLenum type) -> GLuint {
   return shader;
 }
 
+auto Shader::compileShaderDeferred(const QString &source,
+                                   GLenum type) -> GLuint {
+  initializeOpenGLFunctions();
+  GLuint const shader = glCreateShader(type);
+
+  QByteArray const source_bytes = source.toUtf8();
+  const char *source_ptr = source_bytes.constData();
+  glShaderSource(shader, 1, &source_ptr, nullptr);
+  glCompileShader(shader);
+  // Status check deferred to finishLoad.
+  return shader;
+}
+
 auto Shader::linkProgram(GLuint vertex_shader, GLuint fragment_shader) -> bool {
   initializeOpenGLFunctions();
   m_program = glCreateProgram();
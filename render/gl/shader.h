@@ -4,11 +4,18 @@
 #include <QOpenGLFunctions_3_3_Core>
 #include <QString>
 #include <QVector2D>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 
 namespace Render::GL {
 
+// Opaque handle to a named shader in the ShaderCache. Handles are
+// assigned at load time and resolve through a flat table, so per-frame
+// code that holds one never hashes a string; 0 is the invalid handle.
+using ShaderHandle = std::uint32_t;
+inline constexpr ShaderHandle InvalidShaderHandle = 0;
+
 class Shader : protected QOpenGLFunctions_3_3_Core {
 public:
   using UniformHandle = GLint;
@@ -22,11 +29,31 @@ public:
   auto loadFromSource(const QString &vertex_source,
                       const QString &fragment_source) -> bool;
 
+  // Two-phase load for batched startup compilation. beginLoadFromFiles
+  // compiles and links without querying any status, so a driver with
+  // GL_KHR_parallel_shader_compile can work the whole batch on its
+  // compiler threads; finishLoad performs the deferred status checks and
+  // the binary-cache store. isReady polls GL_COMPLETION_STATUS_KHR so the
+  // caller can finish programs in completion order instead of blocking on
+  // the first slow one. loadFromFiles stays the one-shot path.
+  auto beginLoadFromFiles(const QString &vertexPath,
+                          const QString &fragmentPath) -> bool;
+  [[nodiscard]] auto isReady() -> bool;
+  auto finishLoad() -> bool;
+
+  // Raises the driver's shader-compiler thread cap where
+  // GL_KHR_parallel_shader_compile is available; no-op otherwise.
+  static void uncapCompilerThreads();
+
   void use();
   void release();
 
   auto uniformHandle(const char *name) -> UniformHandle;
 
+  // Wires a named std140 uniform block to a binding point; returns false
+  // when the program does not declare the block.
+  auto bindUniformBlock(const char *name, GLuint binding_point) -> bool;
+
   void setUniform(UniformHandle handle, float value);
   void setUniform(UniformHandle handle, const QVector3D &value);
   void setUniform(UniformHandle handle, const QVector2D &value);
@@ -50,9 +77,26 @@ public:
 
 private:
   GLuint m_program = 0;
+
+  // Deferred-load state between beginLoadFromFiles and finishLoad.
+  GLuint m_pendingVert = 0;
+  GLuint m_pendingFrag = 0;
+  bool m_loadPending = false;
+  QString m_pendingCachePath;
+
   auto compileShader(const QString &source, GLenum type) -> GLuint;
+  auto compileShaderDeferred(const QString &source, GLenum type) -> GLuint;
   auto linkProgram(GLuint vertex_shader, GLuint fragment_shader) -> bool;
 
+  // On-disk program binary cache (ARB_get_program_binary where available).
+  // The key hashes both sources and the driver identity strings, so a
+  // driver update simply misses and recompiles.
+  [[nodiscard]] auto binaryCachePathFor(const QString &vertex_source,
+                                        const QString &fragment_source)
+      -> QString;
+  auto tryLoadCachedBinary(const QString &cache_path) -> bool;
+  void storeCachedBinary(const QString &cache_path);
+
   std::unordered_map<std::string, UniformHandle> m_uniformCache;
 };
 
@@ -6,6 +6,7 @@
 #include <QString>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace Render::GL {
 
@@ -28,6 +29,9 @@ public:
     }
     Shader *raw = sh.get();
     m_named.emplace(name, std::move(sh));
+    m_handleTable.push_back(raw);
+    m_handleByName.emplace(name,
+                           static_cast<ShaderHandle>(m_handleTable.size()));
     return raw;
   }
 
@@ -36,6 +40,20 @@ public:
     return (it != m_named.end()) ? it->second.get() : nullptr;
   }
 
+  // Load-time resolution of a name to its opaque handle; per-frame code
+  // should hold the handle and call get(ShaderHandle) instead of hashing
+  // the name every submit.
+  [[nodiscard]] auto handleFor(const QString &name) const -> ShaderHandle {
+    auto it = m_handleByName.find(name);
+    return (it != m_handleByName.end()) ? it->second : InvalidShaderHandle;
+  }
+
+  [[nodiscard]] auto get(ShaderHandle handle) const -> Shader * {
+    return (handle != InvalidShaderHandle && handle <= m_handleTable.size())
+               ? m_handleTable[handle - 1]
+               : nullptr;
+  }
+
   auto getOrLoad(const QString &vertPath, const QString &fragPath) -> Shader * {
     const QString resolved_vert =
         Utils::Resources::resolveResourcePath(vertPath);
@@ -58,6 +76,7 @@ public:
   }
 
   void initializeDefaults() {
+    Shader::uncapCompilerThreads();
     static const QString kShaderBase = QStringLiteral(":/assets/shaders/");
     auto resolve = [](const QString &path) {
       return Utils::Resources::resolveResourcePath(path);
@@ -68,116 +87,249 @@ public:
     const QString basicFrag =
         resolve(kShaderBase + QStringLiteral("basic.frag"));
     const QString gridFrag = resolve(kShaderBase + QStringLiteral("grid.frag"));
-    load(QStringLiteral("basic"), basicVert, basicFrag);
-    load(QStringLiteral("grid"), basicVert, gridFrag);
+    loadDeferred(QStringLiteral("basic"), basicVert, basicFrag);
+    loadDeferred(QStringLiteral("grid"), basicVert, gridFrag);
     const QString cylVert =
         resolve(kShaderBase + QStringLiteral("cylinder_instanced.vert"));
     const QString cylFrag =
         resolve(kShaderBase + QStringLiteral("cylinder_instanced.frag"));
-    load(QStringLiteral("cylinder_instanced"), cylVert, cylFrag);
+    loadDeferred(QStringLiteral("cylinder_instanced"), cylVert, cylFrag);
     const QString fogVert =
         resolve(kShaderBase + QStringLiteral("fog_instanced.vert"));
     const QString fogFrag =
         resolve(kShaderBase + QStringLiteral("fog_instanced.frag"));
-    load(QStringLiteral("fog_instanced"), fogVert, fogFrag);
+    loadDeferred(QStringLiteral("fog_instanced"), fogVert, fogFrag);
+    const QString fogMaskVert =
+        resolve(kShaderBase + QStringLiteral("fog_mask.vert"));
+    const QString fogMaskFrag =
+        resolve(kShaderBase + QStringLiteral("fog_mask.frag"));
+    loadDeferred(QStringLiteral("fog_mask"), fogMaskVert, fogMaskFrag);
     const QString grassVert =
         resolve(kShaderBase + QStringLiteral("grass_instanced.vert"));
     const QString grassFrag =
         resolve(kShaderBase + QStringLiteral("grass_instanced.frag"));
-    load(QStringLiteral("grass_instanced"), grassVert, grassFrag);
+    loadDeferred(QStringLiteral("grass_instanced"), grassVert, grassFrag);
 
     const QString stoneVert =
         resolve(kShaderBase + QStringLiteral("stone_instanced.vert"));
     const QString stoneFrag =
         resolve(kShaderBase + QStringLiteral("stone_instanced.frag"));
-    load(QStringLiteral("stone_instanced"), stoneVert, stoneFrag);
+    loadDeferred(QStringLiteral("stone_instanced"), stoneVert, stoneFrag);
 
     const QString plantVert =
         resolve(kShaderBase + QStringLiteral("plant_instanced.vert"));
     const QString plantFrag =
         resolve(kShaderBase + QStringLiteral("plant_instanced.frag"));
-    load(QStringLiteral("plant_instanced"), plantVert, plantFrag);
+    loadDeferred(QStringLiteral("plant_instanced"), plantVert, plantFrag);
 
     const QString pineVert =
         resolve(kShaderBase + QStringLiteral("pine_instanced.vert"));
     const QString pineFrag =
         resolve(kShaderBase + QStringLiteral("pine_instanced.frag"));
-    load(QStringLiteral("pine_instanced"), pineVert, pineFrag);
+    loadDeferred(QStringLiteral("pine_instanced"), pineVert, pineFrag);
 
     const QString firecampVert =
         resolve(kShaderBase + QStringLiteral("firecamp.vert"));
     const QString firecampFrag =
         resolve(kShaderBase + QStringLiteral("firecamp.frag"));
-    load(QStringLiteral("firecamp"), firecampVert, firecampFrag);
+    loadDeferred(QStringLiteral("firecamp"), firecampVert, firecampFrag);
+
+    const QString particleVert =
+        resolve(kShaderBase + QStringLiteral("particle.vert"));
+    const QString particleFrag =
+        resolve(kShaderBase + QStringLiteral("particle.frag"));
+    loadDeferred(QStringLiteral("particle"), particleVert, particleFrag);
+
+    const QString selRingVert =
+        resolve(kShaderBase + QStringLiteral("selection_ring_instanced.vert"));
+    const QString selRingFrag =
+        resolve(kShaderBase + QStringLiteral("selection_ring_instanced.frag"));
+    loadDeferred(QStringLiteral("selection_ring_instanced"), selRingVert, selRingFrag);
+
+    const QString healthBarVert =
+        resolve(kShaderBase + QStringLiteral("health_bar_instanced.vert"));
+    const QString healthBarFrag =
+        resolve(kShaderBase + QStringLiteral("health_bar_instanced.frag"));
+    loadDeferred(QStringLiteral("health_bar_instanced"), healthBarVert,
+                 healthBarFrag);
+
+    const QString pickingVert =
+        resolve(kShaderBase + QStringLiteral("picking_id.vert"));
+    const QString pickingFrag =
+        resolve(kShaderBase + QStringLiteral("picking_id.frag"));
+    loadDeferred(QStringLiteral("picking_id"), pickingVert, pickingFrag);
 
     const QString groundVert =
         resolve(kShaderBase + QStringLiteral("ground_plane.vert"));
     const QString groundFrag =
         resolve(kShaderBase + QStringLiteral("ground_plane.frag"));
-    load(QStringLiteral("ground_plane"), groundVert, groundFrag);
+    loadDeferred(QStringLiteral("ground_plane"), groundVert, groundFrag);
 
     const QString terrainVert =
         resolve(kShaderBase + QStringLiteral("terrain_chunk.vert"));
     const QString terrainFrag =
         resolve(kShaderBase + QStringLiteral("terrain_chunk.frag"));
-    load(QStringLiteral("terrain_chunk"), terrainVert, terrainFrag);
+    loadDeferred(QStringLiteral("terrain_chunk"), terrainVert, terrainFrag);
 
     const QString riverVert =
         resolve(kShaderBase + QStringLiteral("river.vert"));
     const QString riverFrag =
         resolve(kShaderBase + QStringLiteral("river.frag"));
-    load(QStringLiteral("river"), riverVert, riverFrag);
+    loadDeferred(QStringLiteral("river"), riverVert, riverFrag);
+    // Cheaper water-quality tiers sharing the vertex-wave stage.
+    loadDeferred(QStringLiteral("river_medium"), riverVert,
+         resolve(kShaderBase + QStringLiteral("river_medium.frag")));
+    loadDeferred(QStringLiteral("river_low"), riverVert,
+         resolve(kShaderBase + QStringLiteral("river_low.frag")));
 
     const QString riverbankVert =
         resolve(kShaderBase + QStringLiteral("riverbank.vert"));
     const QString riverbankFrag =
         resolve(kShaderBase + QStringLiteral("riverbank.frag"));
-    load(QStringLiteral("riverbank"), riverbankVert, riverbankFrag);
+    loadDeferred(QStringLiteral("riverbank"), riverbankVert, riverbankFrag);
 
     const QString bridgeVert =
         resolve(kShaderBase + QStringLiteral("bridge.vert"));
     const QString bridgeFrag =
         resolve(kShaderBase + QStringLiteral("bridge.frag"));
-    load(QStringLiteral("bridge"), bridgeVert, bridgeFrag);
+    loadDeferred(QStringLiteral("bridge"), bridgeVert, bridgeFrag);
 
     const QString archerVert =
         resolve(kShaderBase + QStringLiteral("archer.vert"));
     const QString archerFrag =
         resolve(kShaderBase + QStringLiteral("archer.frag"));
-    load(QStringLiteral("archer"), archerVert, archerFrag);
+    loadDeferred(QStringLiteral("archer"), archerVert, archerFrag);
 
     const QString knightVert =
         resolve(kShaderBase + QStringLiteral("knight.vert"));
     const QString knightFrag =
         resolve(kShaderBase + QStringLiteral("knight.frag"));
-    load(QStringLiteral("knight"), knightVert, knightFrag);
+    loadDeferred(QStringLiteral("knight"), knightVert, knightFrag);
 
     const QString mounted_knightVert =
         resolve(kShaderBase + QStringLiteral("mounted_knight.vert"));
     const QString mounted_knightFrag =
         resolve(kShaderBase + QStringLiteral("mounted_knight.frag"));
-    load(QStringLiteral("mounted_knight"), mounted_knightVert,
+    loadDeferred(QStringLiteral("mounted_knight"), mounted_knightVert,
          mounted_knightFrag);
 
     const QString spearmanVert =
         resolve(kShaderBase + QStringLiteral("spearman.vert"));
     const QString spearmanFrag =
         resolve(kShaderBase + QStringLiteral("spearman.frag"));
-    load(QStringLiteral("spearman"), spearmanVert, spearmanFrag);
+    loadDeferred(QStringLiteral("spearman"), spearmanVert, spearmanFrag);
+
+    const QString unitInstancedVert =
+        resolve(kShaderBase + QStringLiteral("unit_instanced.vert"));
+    loadDeferred(QStringLiteral("basic_instanced"), unitInstancedVert,
+         resolve(kShaderBase + QStringLiteral("basic_instanced.frag")));
+    loadDeferred(QStringLiteral("archer_instanced"), unitInstancedVert,
+         resolve(kShaderBase + QStringLiteral("archer_instanced.frag")));
+    loadDeferred(QStringLiteral("knight_instanced"), unitInstancedVert,
+         resolve(kShaderBase + QStringLiteral("knight_instanced.frag")));
+    loadDeferred(QStringLiteral("mounted_knight_instanced"), unitInstancedVert,
+         resolve(kShaderBase +
+                 QStringLiteral("mounted_knight_instanced.frag")));
+    loadDeferred(QStringLiteral("spearman_instanced"), unitInstancedVert,
+         resolve(kShaderBase + QStringLiteral("spearman_instanced.frag")));
+
+    const QString impostorVert =
+        resolve(kShaderBase + QStringLiteral("impostor.vert"));
+    const QString impostorFrag =
+        resolve(kShaderBase + QStringLiteral("impostor.frag"));
+    loadDeferred(QStringLiteral("impostor"), impostorVert, impostorFrag);
+    loadDeferred(QStringLiteral("impostor_instanced"), unitInstancedVert,
+         resolve(kShaderBase + QStringLiteral("impostor_instanced.frag")));
   }
 
   void clear() {
     m_named.clear();
     m_byPath.clear();
     m_cache.clear();
+    m_handleTable.clear();
+    m_handleByName.clear();
   }
 
 private:
+  // Deferred batch loading used by initializeDefaults: loadDeferred kicks
+  // compilation and linking without waiting, so drivers with
+  // GL_KHR_parallel_shader_compile chew through the whole set on their
+  // compiler threads; finalizeDeferred then finishes programs in
+  // completion order. Entries that fail to finalize are unregistered, so
+  // lookups return nullptr exactly as with the blocking load().
+  void loadDeferred(const QString &name, const QString &vertPath,
+                    const QString &fragPath) {
+    if (m_named.find(name) != m_named.end()) {
+      return;
+    }
+    auto sh = std::make_unique<Shader>();
+    if (!sh->beginLoadFromFiles(vertPath, fragPath)) {
+      qWarning() << "ShaderCache: Failed to load shader" << name;
+      return;
+    }
+    Shader *raw = sh.get();
+    m_named.emplace(name, std::move(sh));
+    m_handleTable.push_back(raw);
+    m_handleByName.emplace(name,
+                           static_cast<ShaderHandle>(m_handleTable.size()));
+    m_pendingLoads.push_back(name);
+  }
+
+  void finalizeDeferred() {
+    std::vector<QString> pending = std::move(m_pendingLoads);
+    m_pendingLoads.clear();
+    while (!pending.empty()) {
+      bool progressed = false;
+      for (auto it = pending.begin(); it != pending.end();) {
+        Shader *sh = get(*it);
+        if (sh == nullptr) {
+          it = pending.erase(it);
+          progressed = true;
+          continue;
+        }
+        if (!sh->isReady()) {
+          ++it;
+          continue;
+        }
+        finalizeOne(*it, sh);
+        it = pending.erase(it);
+        progressed = true;
+      }
+      // Nothing reported complete this pass; block on the oldest entry so
+      // the loop always terminates (also the no-extension path).
+      if (!progressed && !pending.empty()) {
+        if (Shader *sh = get(pending.front())) {
+          finalizeOne(pending.front(), sh);
+        }
+        pending.erase(pending.begin());
+      }
+    }
+  }
+
+  void finalizeOne(const QString &name, Shader *shader) {
+    if (shader->finishLoad()) {
+      return;
+    }
+    qWarning() << "ShaderCache: Failed to load shader" << name;
+    auto handle_it = m_handleByName.find(name);
+    if (handle_it != m_handleByName.end()) {
+      m_handleTable[handle_it->second - 1] = nullptr;
+      m_handleByName.erase(handle_it);
+    }
+    m_named.erase(name);
+  }
+
+  std::vector<QString> m_pendingLoads;
+
   std::unordered_map<QString, std::unique_ptr<Shader>> m_byPath;
 
   std::unordered_map<QString, std::unique_ptr<Shader>> m_named;
 
   std::unordered_map<QString, std::unique_ptr<Shader>> m_cache;
+
+  // Flat table indexed by handle - 1; rebuilt alongside m_named.
+  std::vector<Shader *> m_handleTable;
+  std::unordered_map<QString, ShaderHandle> m_handleByName;
 };
 
 } // namespace Render::GL
@@ -1,2 +1,101 @@
+#include "state_scopes.h"
 
-namespace Render::GL {}
+namespace Render::GL {
+
+void StateCache::invalidate() {
+  m_depthMask.reset();
+  m_depthTest.reset();
+  m_blend.reset();
+  m_polygonOffsetFill.reset();
+  m_cullFace.reset();
+  m_blendFunc.reset();
+  m_polygonOffset.reset();
+}
+
+void StateCache::setDepthMask(bool write) {
+  if (m_depthMask == write) {
+    return;
+  }
+  glDepthMask(write ? GL_TRUE : GL_FALSE);
+  m_depthMask = write;
+}
+
+void StateCache::setDepthTest(bool enable) {
+  setCapability(GL_DEPTH_TEST, m_depthTest, enable);
+}
+
+void StateCache::setBlend(bool enable) {
+  setCapability(GL_BLEND, m_blend, enable);
+}
+
+void StateCache::setBlendFunc(GLenum src, GLenum dst) {
+  const std::pair<GLenum, GLenum> func{src, dst};
+  if (m_blendFunc == func) {
+    return;
+  }
+  glBlendFunc(src, dst);
+  m_blendFunc = func;
+}
+
+void StateCache::setPolygonOffsetFill(bool enable) {
+  setCapability(GL_POLYGON_OFFSET_FILL, m_polygonOffsetFill, enable);
+}
+
+void StateCache::setPolygonOffset(float factor, float units) {
+  const std::pair<float, float> offset{factor, units};
+  if (m_polygonOffset == offset) {
+    return;
+  }
+  glPolygonOffset(factor, units);
+  m_polygonOffset = offset;
+}
+
+void StateCache::setCullFace(bool enable) {
+  setCapability(GL_CULL_FACE, m_cullFace, enable);
+}
+
+auto StateCache::depthMask() -> bool {
+  if (!m_depthMask.has_value()) {
+    GLboolean mask = GL_TRUE;
+    glGetBooleanv(GL_DEPTH_WRITEMASK, &mask);
+    m_depthMask = mask != 0U;
+  }
+  return *m_depthMask;
+}
+
+auto StateCache::depthTest() -> bool {
+  return queryCapability(GL_DEPTH_TEST, m_depthTest);
+}
+
+auto StateCache::blend() -> bool { return queryCapability(GL_BLEND, m_blend); }
+
+auto StateCache::polygonOffsetFill() -> bool {
+  return queryCapability(GL_POLYGON_OFFSET_FILL, m_polygonOffsetFill);
+}
+
+auto StateCache::cullFace() -> bool {
+  return queryCapability(GL_CULL_FACE, m_cullFace);
+}
+
+void StateCache::setCapability(GLenum cap, std::optional<bool> &shadow,
+                               bool enable) {
+  if (shadow == enable) {
+    return;
+  }
+  if (enable) {
+    glEnable(cap);
+  } else {
+    glDisable(cap);
+  }
+  shadow = enable;
+}
+
+auto StateCache::queryCapability(GLenum cap, std::optional<bool> &shadow)
+    -> bool {
+  if (!shadow.has_value()) {
+    shadow = glIsEnabled(cap) != 0U;
+  }
+  return *shadow;
+}
+
+} // namespace Render::GL
@@ -1,70 +1,95 @@
 #pragma once
 #include <QOpenGLFunctions_3_3_Core>
+#include <optional>
+#include <utility>
 
 namespace Render::GL {
 
+// Shadow copy of the GL state the render passes toggle. Setters compare
+// against the shadowed value and skip the driver call when nothing would
+// change; getters answer from the shadow and only fall back to a glGet /
+// glIsEnabled round-trip while a value is still unknown. invalidate()
+// forgets everything, so the first touch of each piece of state after it
+// re-queries and re-issues unconditionally.
+class StateCache {
+public:
+  void invalidate();
+
+  void setDepthMask(bool write);
+  void setDepthTest(bool enable);
+  void setBlend(bool enable);
+  void setBlendFunc(GLenum src, GLenum dst);
+  void setPolygonOffsetFill(bool enable);
+  void setPolygonOffset(float factor, float units);
+  void setCullFace(bool enable);
+
+  [[nodiscard]] auto depthMask() -> bool;
+  [[nodiscard]] auto depthTest() -> bool;
+  [[nodiscard]] auto blend() -> bool;
+  [[nodiscard]] auto polygonOffsetFill() -> bool;
+  [[nodiscard]] auto cullFace() -> bool;
+
+private:
+  static void setCapability(GLenum cap, std::optional<bool> &shadow,
+                            bool enable);
+  [[nodiscard]] static auto queryCapability(GLenum cap,
+                                            std::optional<bool> &shadow)
+      -> bool;
+
+  std::optional<bool> m_depthMask;
+  std::optional<bool> m_depthTest;
+  std::optional<bool> m_blend;
+  std::optional<bool> m_polygonOffsetFill;
+  std::optional<bool> m_cullFace;
+  std::optional<std::pair<GLenum, GLenum>> m_blendFunc;
+  std::optional<std::pair<float, float>> m_polygonOffset;
+};
+
+// The scopes below are declarative requests against the cache: they record
+// the shadowed value, ask for the state they need, and ask for the old
+// value back on destruction. Redundant transitions never reach the driver.
 struct DepthMaskScope {
-  GLboolean prev{};
-  explicit DepthMaskScope(bool enableWrite) {
-    glGetBooleanv(GL_DEPTH_WRITEMASK, &prev);
-    glDepthMask(enableWrite ? GL_TRUE : GL_FALSE);
+  StateCache &cache;
+  bool prev;
+  DepthMaskScope(StateCache &state, bool enableWrite)
+      : cache(state), prev(state.depthMask()) {
+    cache.setDepthMask(enableWrite);
   }
-  ~DepthMaskScope() { glDepthMask(prev); }
+  ~DepthMaskScope() { cache.setDepthMask(prev); }
 };
 
 struct PolygonOffsetScope {
-  GLboolean prevEnable;
-  float factor, units;
-  PolygonOffsetScope(float f, float u)
-      : prevEnable(glIsEnabled(GL_POLYGON_OFFSET_FILL)), factor(f), units(u) {
-
-    glEnable(GL_POLYGON_OFFSET_FILL);
-    glPolygonOffset(factor, units);
+  StateCache &cache;
+  bool prevEnable;
+  PolygonOffsetScope(StateCache &state, float factor, float units)
+      : cache(state), prevEnable(state.polygonOffsetFill()) {
+    cache.setPolygonOffsetFill(true);
+    cache.setPolygonOffset(factor, units);
   }
   ~PolygonOffsetScope() {
-    if (prevEnable == 0U) {
-      glDisable(GL_POLYGON_OFFSET_FILL);
-    }
-    glPolygonOffset(0.0F, 0.0F);
+    cache.setPolygonOffsetFill(prevEnable);
+    cache.setPolygonOffset(0.0F, 0.0F);
   }
 };
 
 struct BlendScope {
-  GLboolean prevEnable;
-  BlendScope(bool enable = true) : prevEnable(glIsEnabled(GL_BLEND)) {
-
-    if (enable) {
-      glEnable(GL_BLEND);
-    } else {
-      glDisable(GL_BLEND);
-    }
-  }
-  ~BlendScope() {
-    if (prevEnable != 0U) {
-      glEnable(GL_BLEND);
-    } else {
-      glDisable(GL_BLEND);
-    }
+  StateCache &cache;
+  bool prevEnable;
+  explicit BlendScope(StateCache &state, bool enable = true)
+      : cache(state), prevEnable(state.blend()) {
+    cache.setBlend(enable);
   }
+  ~BlendScope() { cache.setBlend(prevEnable); }
 };
 
 struct DepthTestScope {
-  GLboolean prevEnable;
-  explicit DepthTestScope(bool enable)
-      : prevEnable(glIsEnabled(GL_DEPTH_TEST)) {
-
-    if (enable) {
-      glEnable(GL_DEPTH_TEST);
-    } else {
-      glDisable(GL_DEPTH_TEST);
-    }
-  }
-  ~DepthTestScope() {
-    if (prevEnable != 0U) {
-      glEnable(GL_DEPTH_TEST);
-    } else {
-      glDisable(GL_DEPTH_TEST);
-    }
+  StateCache &cache;
+  bool prevEnable;
+  DepthTestScope(StateCache &state, bool enable)
+      : cache(state), prevEnable(state.depthTest()) {
+    cache.setDepthTest(enable);
   }
+  ~DepthTestScope() { cache.setDepthTest(prevEnable); }
 };
+
 } // namespace Render::GL
@@ -27,6 +27,7 @@ public:
 
   [[nodiscard]] auto getWidth() const -> int { return m_width; }
   [[nodiscard]] auto getHeight() const -> int { return m_height; }
+  [[nodiscard]] auto id() const -> GLuint { return m_texture; }
 
 private:
   GLuint m_texture = 0;
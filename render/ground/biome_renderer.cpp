@@ -7,13 +7,20 @@
 #include "ground/grass_gpu.h"
 #include "ground_utils.h"
 #include "map/terrain.h"
+#include "utils/parallel_for.h"
+#include <QCryptographicHash>
 #include <QDebug>
+#include <QDir>
 #include <QElapsedTimer>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
 #include <QVector2D>
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
-#include <memory>
+#include <cstring>
 #include <optional>
 #include <qelapsedtimer.h>
 #include <qglobal.h>
@@ -26,20 +33,17 @@ using std::uint32_t;
 using namespace Render::Ground;
 using namespace Render::GL::Geometry;
 
-inline auto valueNoise(float x, float z, uint32_t salt = 0U) -> float {
-  int x0 = int(std::floor(x));
-  int z0 = int(std::floor(z));
-  int x1 = x0 + 1;
-  int z1 = z0 + 1;
-  float tx = x - float(x0);
-  float tz = z - float(z0);
-  float const n00 = hash_to_01(hash_coords(x0, z0, salt));
-  float const n10 = hash_to_01(hash_coords(x1, z0, salt));
-  float const n01 = hash_to_01(hash_coords(x0, z1, salt));
-  float const n11 = hash_to_01(hash_coords(x1, z1, salt));
-  float const nx0 = n00 * (1 - tx) + n10 * tx;
-  float const nx1 = n01 * (1 - tx) + n11 * tx;
-  return nx0 * (1 - tz) + nx1 * tz;
+// Culling cell edge length and cell-bounds padding in world units.
+constexpr float k_cull_cell_size = 12.0F;
+constexpr float k_grass_bounds_padding = 1.5F;
+
+auto bakeCacheDir() -> QString {
+  const QString base =
+      QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+  if (base.isEmpty()) {
+    return {};
+  }
+  return base + QStringLiteral("/biome_bake");
 }
 
 inline auto sectionFor(Game::Map::TerrainType type) -> int {
@@ -72,9 +76,6 @@ void BiomeRenderer::configure(const Game::Map::TerrainHeightMap &height_map,
   m_noiseSeed = biomeSettings.seed;
 
   m_grassInstances.clear();
-  m_grassInstanceBuffer.reset();
-  m_grassInstanceCount = 0;
-  m_grassInstancesDirty = false;
 
   m_grassParams.soilColor = m_biomeSettings.soilColor;
   m_grassParams.windStrength = m_biomeSettings.sway_strength;
@@ -82,56 +83,169 @@ void BiomeRenderer::configure(const Game::Map::TerrainHeightMap &height_map,
   m_grassParams.light_direction = QVector3D(0.35F, 0.8F, 0.45F);
   m_grassParams.time = 0.0F;
 
-  generateGrassInstances();
+  // Scatter is deferred to refreshGrass(): both load paths call it once the
+  // buildings are registered, so generating here would be thrown away
+  // immediately and would double the load-time cost.
 }
 
-void BiomeRenderer::submit(Renderer &renderer, ResourceManager *resources) {
-  Q_UNUSED(resources);
-  if (m_grassInstanceCount > 0) {
-    if (!m_grassInstanceBuffer) {
-      m_grassInstanceBuffer = std::make_unique<Buffer>(Buffer::Type::Vertex);
-    }
-    if (m_grassInstancesDirty && m_grassInstanceBuffer) {
-      m_grassInstanceBuffer->setData(m_grassInstances, Buffer::Usage::Static);
-      m_grassInstancesDirty = false;
+void BiomeRenderer::invalidateFootprint(float min_x, float min_z, float max_x,
+                                        float max_z) {
+  std::lock_guard<std::mutex> const lock(m_pendingClearMutex);
+  m_pendingClears.emplace_back(min_x, min_z, max_x, max_z);
+}
+
+void BiomeRenderer::applyPendingClears() {
+  std::vector<QVector4D> clears;
+  {
+    std::lock_guard<std::mutex> const lock(m_pendingClearMutex);
+    if (m_pendingClears.empty()) {
+      return;
     }
-  } else {
-    m_grassInstanceBuffer.reset();
-    return;
+    clears.swap(m_pendingClears);
   }
 
-  if (m_grassInstanceBuffer && m_grassInstanceCount > 0) {
-    GrassBatchParams params = m_grassParams;
-    params.time = renderer.getAnimationTime();
-    renderer.grassBatch(m_grassInstanceBuffer.get(), m_grassInstanceCount,
-                        params);
+  auto &blades = m_grassInstances.instances();
+  const auto before = blades.size();
+  std::erase_if(blades, [&](const GrassInstanceGpu &blade) {
+    float const x = blade.posHeight.x();
+    float const z = blade.posHeight.z();
+    for (const auto &rect : clears) {
+      if (x >= rect.x() && x <= rect.z() && z >= rect.y() && z <= rect.w()) {
+        return true;
+      }
+    }
+    return false;
+  });
+  if (blades.size() != before) {
+    m_grassInstances.markDirty();
   }
 }
 
-void BiomeRenderer::clear() {
-  m_grassInstances.clear();
-  m_grassInstanceBuffer.reset();
-  m_grassInstanceCount = 0;
-  m_grassInstancesDirty = false;
+void BiomeRenderer::submit(Renderer &renderer, ResourceManager *resources) {
+  Q_UNUSED(resources);
+  applyPendingClears();
+  m_grassInstances.submitCulled(
+      renderer, k_cull_cell_size, k_grass_bounds_padding,
+      [](const GrassInstanceGpu &instance) {
+        return QVector3D(instance.posHeight.x(), instance.posHeight.y(),
+                         instance.posHeight.z());
+      },
+      [&](Buffer *buffer, std::size_t visible_count) {
+        GrassBatchParams params = m_grassParams;
+        params.time = renderer.getAnimationTime();
+        renderer.grassBatch(buffer, visible_count, params);
+      });
 }
 
+void BiomeRenderer::clear() { m_grassInstances.clear(); }
+
 void BiomeRenderer::refreshGrass() { generateGrassInstances(); }
 
+auto BiomeRenderer::bakedGrassCachePath() const -> QString {
+  const QString dir = bakeCacheDir();
+  if (dir.isEmpty()) {
+    return {};
+  }
+
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  const auto add_bytes = [&hash](const void *data, qsizetype size) {
+    hash.addData(QByteArrayView(static_cast<const char *>(data), size));
+  };
+  add_bytes(&m_width, sizeof(m_width));
+  add_bytes(&m_height, sizeof(m_height));
+  add_bytes(&m_tile_size, sizeof(m_tile_size));
+  add_bytes(&m_biomeSettings, sizeof(m_biomeSettings));
+  add_bytes(m_heightData.data(),
+            static_cast<qsizetype>(m_heightData.size() * sizeof(float)));
+  add_bytes(m_terrain_types.data(),
+            static_cast<qsizetype>(m_terrain_types.size() *
+                                   sizeof(Game::Map::TerrainType)));
+
+  // Building footprints gate blade placement, so they are part of the key;
+  // a different base layout bakes to a different file.
+  const auto &buildings =
+      Game::Systems::BuildingCollisionRegistry::instance().getAllBuildings();
+  for (const auto &building : buildings) {
+    const float footprint[4] = {building.center_x, building.center_z,
+                                building.width, building.depth};
+    add_bytes(footprint, sizeof(footprint));
+  }
+
+  return dir + QLatin1Char('/') + QString::fromLatin1(hash.result().toHex()) +
+         QStringLiteral(".grass");
+}
+
+auto BiomeRenderer::tryLoadBakedGrass(const QString &cache_path) -> bool {
+  if (cache_path.isEmpty()) {
+    return false;
+  }
+  QFile file(cache_path);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+  const QByteArray blob = file.readAll();
+  constexpr auto k_stride =
+      static_cast<qsizetype>(sizeof(GrassInstanceGpu));
+  if (blob.isEmpty() || blob.size() % k_stride != 0) {
+    return false;
+  }
+
+  auto &blades = m_grassInstances.instances();
+  blades.resize(static_cast<std::size_t>(blob.size() / k_stride));
+  std::memcpy(blades.data(), blob.constData(),
+              static_cast<std::size_t>(blob.size()));
+  return true;
+}
+
+void BiomeRenderer::storeBakedGrass(const QString &cache_path) const {
+  if (cache_path.isEmpty()) {
+    return;
+  }
+  const auto &blades = m_grassInstances.instances();
+  if (blades.empty()) {
+    return;
+  }
+  if (!QDir().mkpath(bakeCacheDir())) {
+    return;
+  }
+  QSaveFile file(cache_path);
+  if (!file.open(QIODevice::WriteOnly)) {
+    return;
+  }
+  file.write(reinterpret_cast<const char *>(blades.data()),
+             static_cast<qint64>(blades.size() * sizeof(GrassInstanceGpu)));
+  file.commit();
+}
+
 void BiomeRenderer::generateGrassInstances() {
   QElapsedTimer timer;
   timer.start();
 
-  m_grassInstances.clear();
+  auto &blades = m_grassInstances.instances();
+  blades.clear();
+
+  {
+    // A fresh scatter already excludes every registered footprint; stale
+    // queued clears would punch holes in the new set.
+    std::lock_guard<std::mutex> const lock(m_pendingClearMutex);
+    m_pendingClears.clear();
+  }
 
   if (m_width < 2 || m_height < 2 || m_heightData.empty()) {
-    m_grassInstanceCount = 0;
-    m_grassInstancesDirty = false;
     return;
   }
 
   if (m_biomeSettings.patchDensity < 0.01F) {
-    m_grassInstanceCount = 0;
-    m_grassInstancesDirty = false;
+    return;
+  }
+
+  // The blade layout is a pure function of the terrain, the biome settings
+  // and the building footprints, so the baked instance array — already in
+  // the GPU layout — is cached to disk keyed by those inputs. A hit
+  // replaces the whole scatter with one read.
+  const QString cache_path = bakedGrassCachePath();
+  if (tryLoadBakedGrass(cache_path)) {
+    m_grassInstances.markDirty();
     return;
   }
 
@@ -147,7 +261,7 @@ void BiomeRenderer::generateGrassInstances() {
   std::vector<QVector3D> normals(m_width * m_height,
                                  QVector3D(0.0F, 1.0F, 0.0F));
 
-  auto sample_height_at = [&](float gx, float gz) -> float {
+  const auto sample_height_at = [&](float gx, float gz) -> float {
     gx = std::clamp(gx, 0.0F, float(m_width - 1));
     gz = std::clamp(gz, 0.0F, float(m_height - 1));
     int const x0 = int(std::floor(gx));
@@ -165,32 +279,39 @@ void BiomeRenderer::generateGrassInstances() {
     return h0 * (1.0F - tz) + h1 * tz;
   };
 
-  for (int z = 0; z < m_height; ++z) {
-    for (int x = 0; x < m_width; ++x) {
-      int const idx = z * m_width + x;
-      float const gx0 = std::clamp(float(x) - 1.0F, 0.0F, float(m_width - 1));
-      float const gx1 = std::clamp(float(x) + 1.0F, 0.0F, float(m_width - 1));
-      float const gz0 = std::clamp(float(z) - 1.0F, 0.0F, float(m_height - 1));
-      float const gz1 = std::clamp(float(z) + 1.0F, 0.0F, float(m_height - 1));
-
-      float const hL = sample_height_at(gx0, float(z));
-      float const hR = sample_height_at(gx1, float(z));
-      float const hD = sample_height_at(float(x), gz0);
-      float const hU = sample_height_at(float(x), gz1);
-
-      QVector3D const dx(2.0F * m_tile_size, hR - hL, 0.0F);
-      QVector3D const dz(0.0F, hU - hD, 2.0F * m_tile_size);
-      QVector3D n = QVector3D::crossProduct(dz, dx);
-      if (n.lengthSquared() > 0.0F) {
-        n.normalize();
-      } else {
-        n = QVector3D(0, 1, 0);
+  // Normals are a pure function of the height grid; rows are independent.
+  Utils::Parallel::forBands(m_height, [&](int /*band*/, int z_begin,
+                                          int z_end) {
+    for (int z = z_begin; z < z_end; ++z) {
+      for (int x = 0; x < m_width; ++x) {
+        int const idx = z * m_width + x;
+        float const gx0 = std::clamp(float(x) - 1.0F, 0.0F, float(m_width - 1));
+        float const gx1 = std::clamp(float(x) + 1.0F, 0.0F, float(m_width - 1));
+        float const gz0 =
+            std::clamp(float(z) - 1.0F, 0.0F, float(m_height - 1));
+        float const gz1 =
+            std::clamp(float(z) + 1.0F, 0.0F, float(m_height - 1));
+
+        float const hL = sample_height_at(gx0, float(z));
+        float const hR = sample_height_at(gx1, float(z));
+        float const hD = sample_height_at(float(x), gz0);
+        float const hU = sample_height_at(float(x), gz1);
+
+        QVector3D const dx(2.0F * m_tile_size, hR - hL, 0.0F);
+        QVector3D const dz(0.0F, hU - hD, 2.0F * m_tile_size);
+        QVector3D n = QVector3D::crossProduct(dz, dx);
+        if (n.lengthSquared() > 0.0F) {
+          n.normalize();
+        } else {
+          n = QVector3D(0, 1, 0);
+        }
+        normals[idx] = n;
       }
-      normals[idx] = n;
     }
-  }
+  });
 
-  auto add_grass_blade = [&](float gx, float gz, uint32_t &state) {
+  const auto add_grass_blade = [&](float gx, float gz, uint32_t &state,
+                                   std::vector<GrassInstanceGpu> &out) {
     if (gx < edge_margin_x || gx > m_width - 1 - edge_margin_x ||
         gz < edge_margin_z || gz > m_height - 1 - edge_margin_z) {
       return false;
@@ -255,9 +376,9 @@ void BiomeRenderer::generateGrassInstances() {
     }
 
     float const lush_noise =
-        valueNoise(world_x * 0.06F, world_z * 0.06F, m_noiseSeed ^ 0x9235U);
+        value_noise(world_x * 0.06F, world_z * 0.06F, m_noiseSeed ^ 0x9235U);
     float const dryness_noise =
-        valueNoise(world_x * 0.12F, world_z * 0.12F, m_noiseSeed ^ 0x47d2U);
+        value_noise(world_x * 0.12F, world_z * 0.12F, m_noiseSeed ^ 0x47d2U);
     float const dryness =
         std::clamp(dryness_noise * 0.6F + slope * 0.4F, 0.0F, 1.0F);
     QVector3D const lush_mix =
@@ -283,7 +404,7 @@ void BiomeRenderer::generateGrassInstances() {
     instance.colorWidth = QVector4D(color.x(), color.y(), color.z(), width);
     instance.swayParams =
         QVector4D(sway_strength, sway_speed, sway_phase, orientation);
-    m_grassInstances.push_back(instance);
+    out.push_back(instance);
     return true;
   };
 
@@ -302,7 +423,12 @@ void BiomeRenderer::generateGrassInstances() {
 
   const int chunk_size = DefaultChunkSize;
 
-  for (int chunk_z = 0; chunk_z < m_height - 1; chunk_z += chunk_size) {
+  // One chunk row of cluster placement; every chunk re-seeds its RNG from
+  // its own coordinates, so chunk rows can run on any thread and still
+  // scatter identically. Output goes to a per-band vector that is appended
+  // in band order below to keep the final blade order deterministic.
+  const auto scatter_cluster_row = [&](int chunk_z,
+                                       std::vector<GrassInstanceGpu> &out) {
     int const chunk_max_z = std::min(chunk_z + chunk_size, m_height - 1);
     for (int chunk_x = 0; chunk_x < m_width - 1; chunk_x += chunk_size) {
       int const chunk_max_x = std::min(chunk_x + chunk_size, m_width - 1);
@@ -440,51 +566,74 @@ void BiomeRenderer::generateGrassInstances() {
             float const radius = scatter_radius * std::sqrt(rand_01(state));
             float const gx = center_gx + std::cos(angle) * radius / tile_safe;
             float const gz = center_gz + std::sin(angle) * radius / tile_safe;
-            add_grass_blade(gx, gz, state);
+            add_grass_blade(gx, gz, state, out);
           }
         }
       }
     }
+  };
+
+  const int chunk_rows = (m_height - 2) / chunk_size + 1;
+  std::vector<std::vector<GrassInstanceGpu>> cluster_bands(
+      static_cast<std::size_t>(Utils::Parallel::bandCount(chunk_rows)));
+  Utils::Parallel::forBands(
+      chunk_rows, [&](int band, int row_begin, int row_end) {
+        auto &out = cluster_bands[static_cast<std::size_t>(band)];
+        for (int row = row_begin; row < row_end; ++row) {
+          scatter_cluster_row(row * chunk_size, out);
+        }
+      });
+  for (const auto &band : cluster_bands) {
+    blades.insert(blades.end(), band.begin(), band.end());
   }
 
   const float background_density =
       std::max(0.0F, m_biomeSettings.backgroundBladeDensity);
   if (background_density > 0.0F) {
-    for (int z = 0; z < m_height; ++z) {
-      for (int x = 0; x < m_width; ++x) {
-        int const idx = z * m_width + x;
-
-        if (m_terrain_types[idx] == Game::Map::TerrainType::Mountain ||
-            m_terrain_types[idx] == Game::Map::TerrainType::Hill ||
-            m_terrain_types[idx] == Game::Map::TerrainType::River) {
-          continue;
-        }
+    // Background blades re-seed per cell, so rows parallelize the same way.
+    std::vector<std::vector<GrassInstanceGpu>> background_bands(
+        static_cast<std::size_t>(Utils::Parallel::bandCount(m_height)));
+    Utils::Parallel::forBands(m_height, [&](int band, int z_begin, int z_end) {
+      auto &out = background_bands[static_cast<std::size_t>(band)];
+      for (int z = z_begin; z < z_end; ++z) {
+        for (int x = 0; x < m_width; ++x) {
+          int const idx = z * m_width + x;
+
+          if (m_terrain_types[idx] == Game::Map::TerrainType::Mountain ||
+              m_terrain_types[idx] == Game::Map::TerrainType::Hill ||
+              m_terrain_types[idx] == Game::Map::TerrainType::River) {
+            continue;
+          }
 
-        QVector3D const normal = normals[idx];
-        float const slope = 1.0F - std::clamp(normal.y(), 0.0F, 1.0F);
-        if (slope > 0.95F) {
-          continue;
-        }
+          QVector3D const normal = normals[idx];
+          float const slope = 1.0F - std::clamp(normal.y(), 0.0F, 1.0F);
+          if (slope > 0.95F) {
+            continue;
+          }
 
-        uint32_t state = hash_coords(
-            x, z, m_noiseSeed ^ 0x51bda7U ^ static_cast<uint32_t>(idx));
-        int base_count = static_cast<int>(std::floor(background_density));
-        float const frac = background_density - float(base_count);
-        if (rand_01(state) < frac) {
-          base_count += 1;
-        }
+          uint32_t state = hash_coords(
+              x, z, m_noiseSeed ^ 0x51bda7U ^ static_cast<uint32_t>(idx));
+          int base_count = static_cast<int>(std::floor(background_density));
+          float const frac = background_density - float(base_count);
+          if (rand_01(state) < frac) {
+            base_count += 1;
+          }
 
-        for (int i = 0; i < base_count; ++i) {
-          float const gx = float(x) + rand_01(state);
-          float const gz = float(z) + rand_01(state);
-          add_grass_blade(gx, gz, state);
+          for (int i = 0; i < base_count; ++i) {
+            float const gx = float(x) + rand_01(state);
+            float const gz = float(z) + rand_01(state);
+            add_grass_blade(gx, gz, state, out);
+          }
         }
       }
+    });
+    for (const auto &band : background_bands) {
+      blades.insert(blades.end(), band.begin(), band.end());
     }
   }
 
-  m_grassInstanceCount = m_grassInstances.size();
-  m_grassInstancesDirty = m_grassInstanceCount > 0;
+  m_grassInstances.markDirty();
+  storeBakedGrass(cache_path);
 
   int debug_flat_count = 0;
   int debug_hill_count = 0;
@@ -3,13 +3,15 @@
 #include "../../game/map/terrain.h"
 #include "../i_render_pass.h"
 #include "grass_gpu.h"
+#include "vegetation_instances.h"
+#include <QString>
 #include <QVector3D>
+#include <QVector4D>
 #include <cstdint>
-#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace Render::GL {
-class Buffer;
 class Renderer;
 
 class BiomeRenderer : public IRenderPass {
@@ -24,10 +26,23 @@ public:
 
   void refreshGrass();
 
+  // Queues a localized clear: blades inside the XZ rectangle are erased
+  // from the instance set at the next submit(), without re-running the
+  // scatter. Safe to call from the game thread while rendering runs.
+  void invalidateFootprint(float min_x, float min_z, float max_x, float max_z);
+
   void clear();
 
 private:
   void generateGrassInstances();
+  void applyPendingClears();
+
+  // Disk bake of the generated blade array in its GPU instance layout,
+  // keyed by a hash of every generation input; repeat loads of the same
+  // map skip the scatter entirely.
+  [[nodiscard]] auto bakedGrassCachePath() const -> QString;
+  auto tryLoadBakedGrass(const QString &cache_path) -> bool;
+  void storeBakedGrass(const QString &cache_path) const;
 
   int m_width = 0;
   int m_height = 0;
@@ -38,11 +53,13 @@ private:
   Game::Map::BiomeSettings m_biomeSettings;
   std::uint32_t m_noiseSeed = 0U;
 
-  std::vector<GrassInstanceGpu> m_grassInstances;
-  std::unique_ptr<Buffer> m_grassInstanceBuffer;
-  std::size_t m_grassInstanceCount = 0;
+  Render::Ground::VegetationInstanceManager<GrassInstanceGpu> m_grassInstances;
   GrassBatchParams m_grassParams;
-  bool m_grassInstancesDirty = false;
+
+  // XZ clear rectangles (min_x, min_z, max_x, max_z) queued from the game
+  // thread and drained on the render thread at submit().
+  std::mutex m_pendingClearMutex;
+  std::vector<QVector4D> m_pendingClears;
 };
 
 } // namespace Render::GL
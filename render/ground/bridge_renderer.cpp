@@ -221,9 +221,13 @@ void BridgeRenderer::submit(Renderer &renderer, ResourceManager *resources) {
   auto &visibility = Game::Map::VisibilityService::instance();
   const bool use_visibility = visibility.isInitialized();
 
-  auto *shader = renderer.getShader("bridge");
+  if (m_shaderHandle == InvalidShaderHandle) {
+    m_shaderHandle = renderer.shaderHandle(QStringLiteral("bridge"));
+    m_fallbackShaderHandle = renderer.shaderHandle(QStringLiteral("basic"));
+  }
+  auto *shader = renderer.getShader(m_shaderHandle);
   if (shader == nullptr) {
-    shader = renderer.getShader("basic");
+    shader = renderer.getShader(m_fallbackShaderHandle);
     if (shader == nullptr) {
       return;
     }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../game/map/terrain.h"
+#include "../gl/shader.h"
 #include "../i_render_pass.h"
 #include <QMatrix4x4>
 #include <memory>
@@ -27,6 +28,8 @@ private:
   std::vector<Game::Map::Bridge> m_bridges;
   float m_tile_size = 1.0F;
   std::vector<std::unique_ptr<Mesh>> m_meshes;
+  ShaderHandle m_shaderHandle = InvalidShaderHandle;
+  ShaderHandle m_fallbackShaderHandle = InvalidShaderHandle;
 };
 
 } // namespace Render::GL
@@ -2,6 +2,7 @@
 #include "../../game/map/visibility_service.h"
 #include "../../game/systems/building_collision_registry.h"
 #include "../gl/buffer.h"
+#include "../particle_system.h"
 #include "../scene_renderer.h"
 #include "gl/resources.h"
 #include "ground/firecamp_gpu.h"
@@ -125,6 +126,34 @@ void FireCampRenderer::submit(Renderer &renderer, ResourceManager *resources) {
                         (0.85F + 0.2F * std::sin(params.time * 1.7F + 1.2F));
   renderer.firecampBatch(m_fireCampInstanceBuffer.get(), visible_count, params);
 
+  // Embers ride the shared burst-particle pool: a few spawns per
+  // interval per visible camp, then the GPU carries them for their whole
+  // lifetime.
+  constexpr float k_ember_interval = 0.4F;
+  constexpr std::size_t k_max_ember_camps = 12;
+  if (auto *particles = renderer.particles()) {
+    const float now = renderer.getAnimationTime();
+    if (now >= m_nextEmberTime) {
+      m_nextEmberTime = now + k_ember_interval;
+      std::size_t const ember_camps =
+          std::min<std::size_t>(visible_instances.size(), k_max_ember_camps);
+      for (std::size_t i = 0; i < ember_camps; ++i) {
+        const QVector4D pos_intensity = visible_instances[i].pos_intensity;
+        ParticleSystem::BurstDesc ember;
+        ember.count = 2;
+        ember.speed = 0.3F;
+        ember.life = 1.8F;
+        ember.size = 0.07F;
+        ember.gravityScale = -0.08F;
+        ember.velocityBias = QVector3D(0.0F, 0.9F, 0.0F);
+        ember.color = QVector3D(1.0F, 0.55F, 0.18F);
+        QVector3D const origin(pos_intensity.x(), pos_intensity.y() + 0.35F,
+                               pos_intensity.z());
+        particles->spawnBurst(origin, ember, now);
+      }
+    }
+  }
+
   const QVector3D log_color(0.26F, 0.15F, 0.08F);
   const QVector3D char_color(0.08F, 0.05F, 0.03F);
 
@@ -50,6 +50,10 @@ private:
   std::vector<QVector3D> m_explicitPositions;
   std::vector<float> m_explicitIntensities;
   std::vector<float> m_explicitRadii;
+
+  // Next animation-clock time at which visible camps emit ember bursts
+  // through the shared particle pool.
+  float m_nextEmberTime = 0.0F;
 };
 
 } // namespace Render::GL
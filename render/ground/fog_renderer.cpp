@@ -1,52 +1,70 @@
 #include "fog_renderer.h"
 
+#include "../../game/map/visibility_service.h"
 #include "../scene_renderer.h"
-#include <QElapsedTimer>
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
-#include <qelapsedtimer.h>
-#include <qmatrix4x4.h>
 #include <vector>
 
 namespace Render::GL {
 
-namespace {
-const QMatrix4x4 k_identity_matrix;
-}
-
 void FogRenderer::updateMask(int width, int height, float tile_size,
                              const std::vector<std::uint8_t> &cells) {
   m_width = std::max(0, width);
   m_height = std::max(0, height);
   m_tile_size = std::max(0.0001F, tile_size);
-  m_half_width = m_width * 0.5F - 0.5F;
-  m_half_height = m_height * 0.5F - 0.5F;
   m_cells = cells;
-  buildChunks();
+  ++m_maskVersion;
+  m_dirtyRowCount = -1;
 }
 
-void FogRenderer::submit(Renderer &renderer, ResourceManager *resources) {
-  if (!m_enabled) {
-    return;
+auto FogRenderer::patchMask(const Game::Map::VisibilityService &visibility,
+                            std::uint64_t sinceVersion) -> bool {
+  if (m_width <= 0 || m_height <= 0 || m_width != visibility.getWidth() ||
+      m_height != visibility.getHeight()) {
+    return false;
   }
-  if (m_width <= 0 || m_height <= 0) {
-    return;
+
+  int first_changed = -1;
+  int last_changed = -1;
+  if (!visibility.applyChangesSince(sinceVersion, m_cells, first_changed,
+                                    last_changed)) {
+    return false;
   }
-  if (static_cast<int>(m_cells.size()) != m_width * m_height) {
-    return;
+  if (first_changed < 0) {
+    return true;
   }
 
-  (void)resources;
-
-  if (!m_instances.empty()) {
-    renderer.fogBatch(m_instances.data(), m_instances.size());
+  const int first_row = first_changed / m_width;
+  const int last_row = last_changed / m_width;
+  if (m_dirtyRowCount == 0) {
+    m_dirtyRowStart = first_row;
+    m_dirtyRowCount = last_row - first_row + 1;
+  } else if (m_dirtyRowCount > 0) {
+    const int end_row =
+        std::max(m_dirtyRowStart + m_dirtyRowCount - 1, last_row);
+    m_dirtyRowStart = std::min(m_dirtyRowStart, first_row);
+    m_dirtyRowCount = end_row - m_dirtyRowStart + 1;
   }
+  ++m_maskVersion;
+  return true;
 }
 
-void FogRenderer::buildChunks() {
-  m_instances.clear();
+void FogRenderer::updateSources(
+    const std::vector<std::array<float, 4>> &sources) {
+  m_sources.clear();
+  m_sources.reserve(sources.size());
+  for (const auto &source : sources) {
+    m_sources.emplace_back(source[0], source[1], source[2], source[3]);
+  }
+}
 
+void FogRenderer::submit(Renderer &renderer, ResourceManager *resources) {
+  if (!m_enabled) {
+    return;
+  }
   if (m_width <= 0 || m_height <= 0) {
     return;
   }
@@ -54,34 +72,24 @@ void FogRenderer::buildChunks() {
     return;
   }
 
-  QElapsedTimer timer;
-  timer.start();
-
-  const float half_tile = m_tile_size * 0.5F;
-  m_instances.reserve(static_cast<std::size_t>(m_width) * m_height);
-
-  std::size_t total_quads = 0;
-
-  for (int z = 0; z < m_height; ++z) {
-    for (int x = 0; x < m_width; ++x) {
-      const std::uint8_t state = m_cells[z * m_width + x];
-      if (state >= 2) {
-        continue;
-      }
-
-      FogInstance instance;
-      const float world_x = (x - m_half_width) * m_tile_size;
-      const float world_z = (z - m_half_height) * m_tile_size;
-      instance.center = QVector3D(world_x, 0.25F, world_z);
-      instance.color = (state == 0) ? QVector3D(0.02F, 0.02F, 0.05F)
-                                    : QVector3D(0.05F, 0.05F, 0.05F);
-      instance.alpha = (state == 0) ? 0.9F : 0.45F;
-      instance.size = m_tile_size;
+  (void)resources;
 
-      m_instances.push_back(instance);
-      ++total_quads;
-    }
-  }
+  FogMaskCmd cmd;
+  cmd.cells = m_cells.data();
+  cmd.width = m_width;
+  cmd.height = m_height;
+  cmd.tile_size = m_tile_size;
+  cmd.version = m_maskVersion;
+  cmd.dirtyBaseVersion = m_submittedVersion;
+  cmd.dirtyRowStart = m_dirtyRowStart;
+  cmd.dirtyRowCount = m_dirtyRowCount;
+  cmd.sources = m_sources.data();
+  cmd.sourceCount = m_sources.size();
+  renderer.fogMask(cmd);
+
+  m_submittedVersion = m_maskVersion;
+  m_dirtyRowStart = 0;
+  m_dirtyRowCount = 0;
 }
 
 } // namespace Render::GL
@@ -2,16 +2,23 @@
 
 #include "../draw_queue.h"
 #include "../i_render_pass.h"
-#include <QMatrix4x4>
-#include <QVector3D>
+#include <QVector4D>
+#include <array>
 #include <cstdint>
-#include <memory>
 #include <vector>
 
+namespace Game::Map {
+class VisibilityService;
+}
+
 namespace Render::GL {
 class Renderer;
 class ResourceManager;
 
+// Fog of war is drawn as a single map-covering quad: the fragment shader
+// samples the visibility grid (uploaded as a texture only when the mask
+// version changes) and evaluates smooth vision circles from a small
+// per-frame source buffer, so no per-cell geometry is built on the CPU.
 class FogRenderer : public IRenderPass {
 public:
   FogRenderer() = default;
@@ -23,21 +30,34 @@ public:
   void updateMask(int width, int height, float tile_size,
                   const std::vector<std::uint8_t> &cells);
 
-  void submit(Renderer &renderer, ResourceManager *resources) override;
+  // Scatter-updates the local grid with only the cells changed since
+  // sinceVersion and widens the pending dirty row range for the next
+  // texture upload. Returns false when the service's delta window cannot
+  // serve the request (dimension change, missed versions) — the caller
+  // falls back to a full updateMask().
+  auto patchMask(const Game::Map::VisibilityService &visibility,
+                 std::uint64_t sinceVersion) -> bool;
 
-private:
-  void buildChunks();
+  // World-space vision sources (x, z, range) refreshed every frame; they
+  // keep the revealed area following units smoothly between the throttled
+  // CPU visibility updates.
+  void updateSources(const std::vector<std::array<float, 4>> &sources);
 
-  using FogInstance = FogInstanceData;
+  void submit(Renderer &renderer, ResourceManager *resources) override;
 
+private:
   bool m_enabled = true;
   int m_width = 0;
   int m_height = 0;
   float m_tile_size = 1.0F;
-  float m_half_width = 0.0F;
-  float m_half_height = 0.0F;
   std::vector<std::uint8_t> m_cells;
-  std::vector<FogInstance> m_instances;
+  std::vector<QVector4D> m_sources;
+  std::uint64_t m_maskVersion = 0;
+  // Version the last submitted command was based on, plus the rows dirtied
+  // since then; dirtyRowCount < 0 requests a full upload.
+  std::uint64_t m_submittedVersion = 0;
+  int m_dirtyRowStart = 0;
+  int m_dirtyRowCount = 0;
 };
 
 } // namespace Render::GL
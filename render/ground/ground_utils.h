@@ -62,6 +62,25 @@ inline auto hash_to_01(uint32_t h) -> float {
          ::Render::GL::BitShift::Mask24BitFloat;
 }
 
+// Bilinear value noise over the integer lattice, hashed per corner;
+// shared by the scatter generators so every vegetation type samples the
+// same field shape and only the salt and frequency differ.
+inline auto value_noise(float x, float z, uint32_t salt = 0U) -> float {
+  int const x0 = int(std::floor(x));
+  int const z0 = int(std::floor(z));
+  int const x1 = x0 + 1;
+  int const z1 = z0 + 1;
+  float const tx = x - float(x0);
+  float const tz = z - float(z0);
+  float const n00 = hash_to_01(hash_coords(x0, z0, salt));
+  float const n10 = hash_to_01(hash_coords(x1, z0, salt));
+  float const n01 = hash_to_01(hash_coords(x0, z1, salt));
+  float const n11 = hash_to_01(hash_coords(x1, z1, salt));
+  float const nx0 = n00 * (1 - tx) + n10 * tx;
+  float const nx1 = n01 * (1 - tx) + n11 * tx;
+  return nx0 * (1 - tz) + nx1 * tz;
+}
+
 inline auto noise_hash(float x, float y) -> float {
   float const n = std::sin(x * HashConstants::k_noise_frequency_x +
                            y * HashConstants::k_noise_frequency_y) *
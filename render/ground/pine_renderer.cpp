@@ -1,5 +1,4 @@
 #include "pine_renderer.h"
-#include "../../game/map/visibility_service.h"
 #include "../../game/systems/building_collision_registry.h"
 #include "../gl/buffer.h"
 #include "../scene_renderer.h"
@@ -11,7 +10,6 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
-#include <memory>
 #include <vector>
 
 namespace {
@@ -19,21 +17,11 @@ namespace {
 using std::uint32_t;
 using namespace Render::Ground;
 
-inline auto valueNoise(float x, float z, uint32_t salt = 0U) -> float {
-  int x0 = int(std::floor(x));
-  int z0 = int(std::floor(z));
-  int x1 = x0 + 1;
-  int z1 = z0 + 1;
-  float tx = x - float(x0);
-  float tz = z - float(z0);
-  float const n00 = hash_to_01(hash_coords(x0, z0, salt));
-  float const n10 = hash_to_01(hash_coords(x1, z0, salt));
-  float const n01 = hash_to_01(hash_coords(x0, z1, salt));
-  float const n11 = hash_to_01(hash_coords(x1, z1, salt));
-  float const nx0 = n00 * (1 - tx) + n10 * tx;
-  float const nx1 = n01 * (1 - tx) + n11 * tx;
-  return nx0 * (1 - tz) + nx1 * tz;
-}
+// Culling cell edge length and cell-bounds padding in world units; the
+// padding has to cover a full-grown tree so a canopy poking into view is
+// never culled with its cell.
+constexpr float k_cull_cell_size = 12.0F;
+constexpr float k_pine_bounds_padding = 8.0F;
 
 } // namespace
 
@@ -53,9 +41,6 @@ void PineRenderer::configure(const Game::Map::TerrainHeightMap &height_map,
   m_noiseSeed = biomeSettings.seed;
 
   m_pineInstances.clear();
-  m_pineInstanceBuffer.reset();
-  m_pineInstanceCount = 0;
-  m_pineInstancesDirty = false;
 
   m_pineParams.light_direction = QVector3D(0.35F, 0.8F, 0.45F);
   m_pineParams.time = 0.0F;
@@ -68,56 +53,24 @@ void PineRenderer::configure(const Game::Map::TerrainHeightMap &height_map,
 void PineRenderer::submit(Renderer &renderer, ResourceManager *resources) {
   (void)resources;
 
-  m_pineInstanceCount = static_cast<uint32_t>(m_pineInstances.size());
-
-  if (m_pineInstanceCount == 0) {
-    m_pineInstanceBuffer.reset();
-    return;
-  }
-
-  auto &visibility = Game::Map::VisibilityService::instance();
-  const bool use_visibility = visibility.isInitialized();
-
-  std::vector<PineInstanceGpu> visible_instances;
-  if (use_visibility) {
-    visible_instances.reserve(m_pineInstanceCount);
-    for (const auto &instance : m_pineInstances) {
-      float const world_x = instance.posScale.x();
-      float const world_z = instance.posScale.z();
-      if (visibility.isVisibleWorld(world_x, world_z)) {
-        visible_instances.push_back(instance);
-      }
-    }
-  } else {
-    visible_instances = m_pineInstances;
-  }
-
-  const auto visible_count = static_cast<uint32_t>(visible_instances.size());
-  if (visible_count == 0) {
-    m_pineInstanceBuffer.reset();
-    return;
-  }
-
-  if (!m_pineInstanceBuffer) {
-    m_pineInstanceBuffer = std::make_unique<Buffer>(Buffer::Type::Vertex);
-  }
-
-  m_pineInstanceBuffer->setData(visible_instances, Buffer::Usage::Static);
-
-  PineBatchParams params = m_pineParams;
-  params.time = renderer.getAnimationTime();
-  renderer.pineBatch(m_pineInstanceBuffer.get(), visible_count, params);
+  m_pineInstances.submitCulled(
+      renderer, k_cull_cell_size, k_pine_bounds_padding,
+      [](const PineInstanceGpu &instance) {
+        return QVector3D(instance.posScale.x(), instance.posScale.y(),
+                         instance.posScale.z());
+      },
+      [&](Buffer *buffer, std::size_t visible_count) {
+        PineBatchParams params = m_pineParams;
+        params.time = renderer.getAnimationTime();
+        renderer.pineBatch(buffer, visible_count, params);
+      });
 }
 
-void PineRenderer::clear() {
-  m_pineInstances.clear();
-  m_pineInstanceBuffer.reset();
-  m_pineInstanceCount = 0;
-  m_pineInstancesDirty = false;
-}
+void PineRenderer::clear() { m_pineInstances.clear(); }
 
 void PineRenderer::generatePineInstances() {
-  m_pineInstances.clear();
+  auto &pines = m_pineInstances.instances();
+  pines.clear();
 
   if (m_width < 2 || m_height < 2 || m_heightData.empty()) {
     return;
@@ -214,7 +167,7 @@ void PineRenderer::generatePineInstances() {
         QVector4D(tint_color.x(), tint_color.y(), tint_color.z(), sway_phase);
     instance.rotation =
         QVector4D(rotation, silhouette_seed, needle_seed, bark_seed);
-    m_pineInstances.push_back(instance);
+    pines.push_back(instance);
     return true;
   };
 
@@ -234,8 +187,8 @@ void PineRenderer::generatePineInstances() {
       float const world_x = (x - half_width) * m_tile_size;
       float const world_z = (z - half_height) * m_tile_size;
 
-      float const cluster_noise = valueNoise(world_x * 0.03F, world_z * 0.03F,
-                                             m_noiseSeed ^ 0x7F8E9D0AU);
+      float const cluster_noise = value_noise(world_x * 0.03F, world_z * 0.03F,
+                                              m_noiseSeed ^ 0x7F8E9D0AU);
 
       if (cluster_noise < 0.35F) {
         continue;
@@ -263,8 +216,7 @@ void PineRenderer::generatePineInstances() {
     }
   }
 
-  m_pineInstanceCount = m_pineInstances.size();
-  m_pineInstancesDirty = m_pineInstanceCount > 0;
+  m_pineInstances.markDirty();
 }
 
 } // namespace Render::GL
@@ -3,13 +3,12 @@
 #include "../../game/map/terrain.h"
 #include "../i_render_pass.h"
 #include "pine_gpu.h"
+#include "vegetation_instances.h"
 #include <QVector3D>
 #include <cstdint>
-#include <memory>
 #include <vector>
 
 namespace Render::GL {
-class Buffer;
 class Renderer;
 
 class PineRenderer : public IRenderPass {
@@ -36,11 +35,8 @@ private:
   Game::Map::BiomeSettings m_biomeSettings;
   std::uint32_t m_noiseSeed = 0U;
 
-  std::vector<PineInstanceGpu> m_pineInstances;
-  std::unique_ptr<Buffer> m_pineInstanceBuffer;
-  std::size_t m_pineInstanceCount = 0;
+  Render::Ground::VegetationInstanceManager<PineInstanceGpu> m_pineInstances;
   PineBatchParams m_pineParams;
-  bool m_pineInstancesDirty = false;
 };
 
 } // namespace Render::GL
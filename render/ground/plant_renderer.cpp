@@ -1,5 +1,4 @@
 #include "plant_renderer.h"
-#include "../../game/map/visibility_service.h"
 #include "../../game/systems/building_collision_registry.h"
 #include "../gl/buffer.h"
 #include "../scene_renderer.h"
@@ -11,7 +10,6 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
-#include <memory>
 #include <vector>
 
 namespace {
@@ -19,21 +17,9 @@ namespace {
 using std::uint32_t;
 using namespace Render::Ground;
 
-inline auto valueNoise(float x, float z, uint32_t salt = 0U) -> float {
-  int x0 = int(std::floor(x));
-  int z0 = int(std::floor(z));
-  int x1 = x0 + 1;
-  int z1 = z0 + 1;
-  float tx = x - float(x0);
-  float tz = z - float(z0);
-  float const n00 = hash_to_01(hash_coords(x0, z0, salt));
-  float const n10 = hash_to_01(hash_coords(x1, z0, salt));
-  float const n01 = hash_to_01(hash_coords(x0, z1, salt));
-  float const n11 = hash_to_01(hash_coords(x1, z1, salt));
-  float const nx0 = n00 * (1 - tx) + n10 * tx;
-  float const nx1 = n01 * (1 - tx) + n11 * tx;
-  return nx0 * (1 - tz) + nx1 * tz;
-}
+// Culling cell edge length and cell-bounds padding in world units.
+constexpr float k_cull_cell_size = 12.0F;
+constexpr float k_plant_bounds_padding = 2.0F;
 
 } // namespace
 
@@ -53,9 +39,6 @@ void PlantRenderer::configure(const Game::Map::TerrainHeightMap &height_map,
   m_noiseSeed = biomeSettings.seed;
 
   m_plantInstances.clear();
-  m_plantInstanceBuffer.reset();
-  m_plantInstanceCount = 0;
-  m_plantInstancesDirty = false;
 
   m_plantParams.light_direction = QVector3D(0.35F, 0.8F, 0.45F);
   m_plantParams.time = 0.0F;
@@ -68,77 +51,26 @@ void PlantRenderer::configure(const Game::Map::TerrainHeightMap &height_map,
 void PlantRenderer::submit(Renderer &renderer, ResourceManager *resources) {
   (void)resources;
 
-  m_plantInstanceCount = static_cast<uint32_t>(m_plantInstances.size());
-
-  if (m_plantInstanceCount > 0) {
-    if (!m_plantInstanceBuffer) {
-      m_plantInstanceBuffer = std::make_unique<Buffer>(Buffer::Type::Vertex);
-    }
-    if (m_plantInstancesDirty && m_plantInstanceBuffer) {
-      m_plantInstanceBuffer->setData(m_plantInstances, Buffer::Usage::Static);
-      m_plantInstancesDirty = false;
-    }
-  } else {
-    m_plantInstanceBuffer.reset();
-    return;
-  }
-
-  auto &visibility = Game::Map::VisibilityService::instance();
-  const bool use_visibility = visibility.isInitialized();
-
-  if (use_visibility) {
-
-    std::vector<PlantInstanceGpu> visible_instances;
-    visible_instances.reserve(m_plantInstances.size());
-
-    for (const auto &instance : m_plantInstances) {
-      float const world_x = instance.posScale.x();
-      float const world_z = instance.posScale.z();
-
-      if (visibility.isVisibleWorld(world_x, world_z)) {
-        visible_instances.push_back(instance);
-      }
-    }
-
-    if (visible_instances.empty()) {
-      return;
-    }
-
-    if (!m_visibleInstanceBuffer) {
-      m_visibleInstanceBuffer = std::make_unique<Buffer>(Buffer::Type::Vertex);
-    }
-    m_visibleInstanceBuffer->setData(visible_instances, Buffer::Usage::Stream);
-
-    PlantBatchParams params = m_plantParams;
-    params.time = renderer.getAnimationTime();
-    renderer.plantBatch(m_visibleInstanceBuffer.get(),
-                        static_cast<uint32_t>(visible_instances.size()),
-                        params);
-  } else {
-
-    if (m_plantInstanceBuffer && m_plantInstanceCount > 0) {
-      PlantBatchParams params = m_plantParams;
-      params.time = renderer.getAnimationTime();
-      renderer.plantBatch(m_plantInstanceBuffer.get(), m_plantInstanceCount,
-                          params);
-    }
-  }
+  m_plantInstances.submitCulled(
+      renderer, k_cull_cell_size, k_plant_bounds_padding,
+      [](const PlantInstanceGpu &instance) {
+        return QVector3D(instance.posScale.x(), instance.posScale.y(),
+                         instance.posScale.z());
+      },
+      [&](Buffer *buffer, std::size_t visible_count) {
+        PlantBatchParams params = m_plantParams;
+        params.time = renderer.getAnimationTime();
+        renderer.plantBatch(buffer, visible_count, params);
+      });
 }
 
-void PlantRenderer::clear() {
-  m_plantInstances.clear();
-  m_plantInstanceBuffer.reset();
-  m_visibleInstanceBuffer.reset();
-  m_plantInstanceCount = 0;
-  m_plantInstancesDirty = false;
-}
+void PlantRenderer::clear() { m_plantInstances.clear(); }
 
 void PlantRenderer::generatePlantInstances() {
-  m_plantInstances.clear();
+  auto &plants = m_plantInstances.instances();
+  plants.clear();
 
   if (m_width < 2 || m_height < 2 || m_heightData.empty()) {
-    m_plantInstanceCount = 0;
-    m_plantInstancesDirty = false;
     return;
   }
 
@@ -146,8 +78,6 @@ void PlantRenderer::generatePlantInstances() {
       std::clamp(m_biomeSettings.plant_density, 0.0F, 2.0F);
 
   if (plant_density < 0.01F) {
-    m_plantInstanceCount = 0;
-    m_plantInstancesDirty = false;
     return;
   }
 
@@ -288,7 +218,7 @@ void PlantRenderer::generatePlantInstances() {
         QVector4D(tint_color.x(), tint_color.y(), tint_color.z(), sway_phase);
     instance.typeParams =
         QVector4D(plant_type, rotation, sway_strength, sway_speed);
-    m_plantInstances.push_back(instance);
+    plants.push_back(instance);
     return true;
   };
 
@@ -318,8 +248,8 @@ void PlantRenderer::generatePlantInstances() {
       float const world_x = (x - half_width) * m_tile_size;
       float const world_z = (z - half_height) * m_tile_size;
 
-      float const cluster_noise = valueNoise(world_x * 0.05F, world_z * 0.05F,
-                                             m_noiseSeed ^ 0x4B9D2F1AU);
+      float const cluster_noise = value_noise(world_x * 0.05F, world_z * 0.05F,
+                                              m_noiseSeed ^ 0x4B9D2F1AU);
 
       if (cluster_noise < 0.45F) {
         continue;
@@ -349,8 +279,7 @@ void PlantRenderer::generatePlantInstances() {
     }
   }
 
-  m_plantInstanceCount = m_plantInstances.size();
-  m_plantInstancesDirty = m_plantInstanceCount > 0;
+  m_plantInstances.markDirty();
 }
 
 } // namespace Render::GL
@@ -3,13 +3,12 @@
 #include "../../game/map/terrain.h"
 #include "../i_render_pass.h"
 #include "plant_gpu.h"
+#include "vegetation_instances.h"
 #include <QVector3D>
 #include <cstdint>
-#include <memory>
 #include <vector>
 
 namespace Render::GL {
-class Buffer;
 class Renderer;
 
 class PlantRenderer : public IRenderPass {
@@ -36,12 +35,8 @@ private:
   Game::Map::BiomeSettings m_biomeSettings;
   std::uint32_t m_noiseSeed = 0U;
 
-  std::vector<PlantInstanceGpu> m_plantInstances;
-  std::unique_ptr<Buffer> m_plantInstanceBuffer;
-  std::unique_ptr<Buffer> m_visibleInstanceBuffer;
-  std::size_t m_plantInstanceCount = 0;
+  Render::Ground::VegetationInstanceManager<PlantInstanceGpu> m_plantInstances;
   PlantBatchParams m_plantParams;
-  bool m_plantInstancesDirty = false;
 };
 
 } // namespace Render::GL
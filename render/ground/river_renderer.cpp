@@ -162,7 +162,21 @@ void RiverRenderer::submit(Renderer &renderer, ResourceManager *resources) {
   auto &visibility = Game::Map::VisibilityService::instance();
   const bool use_visibility = visibility.isInitialized();
 
-  auto *shader = renderer.getShader("river");
+  if (m_shaderHandle == InvalidShaderHandle) {
+    m_shaderHandle = renderer.shaderHandle(QStringLiteral("river"));
+    m_mediumShaderHandle = renderer.shaderHandle(QStringLiteral("river_medium"));
+    m_lowShaderHandle = renderer.shaderHandle(QStringLiteral("river_low"));
+  }
+  ShaderHandle tier_handle = m_shaderHandle;
+  if (m_quality == WaterQuality::Medium) {
+    tier_handle = m_mediumShaderHandle;
+  } else if (m_quality == WaterQuality::Low) {
+    tier_handle = m_lowShaderHandle;
+  }
+  auto *shader = renderer.getShader(tier_handle);
+  if (shader == nullptr) {
+    shader = renderer.getShader(m_shaderHandle);
+  }
   if (shader == nullptr) {
     return;
   }
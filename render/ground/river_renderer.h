@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../game/map/terrain.h"
+#include "../gl/shader.h"
 #include "../i_render_pass.h"
 #include <QMatrix4x4>
 #include <memory>
@@ -11,6 +12,12 @@ class Mesh;
 class Renderer;
 class ResourceManager;
 
+// Runtime-selectable water shading cost. All tiers share river.vert's
+// vertex waves; High runs the full five-octave per-pixel field, Medium a
+// reduced-octave version at roughly a quarter of the fragment cost, and
+// Low shades with no per-pixel noise at all.
+enum class WaterQuality { High = 0, Medium = 1, Low = 2 };
+
 class RiverRenderer : public IRenderPass {
 public:
   RiverRenderer();
@@ -19,6 +26,9 @@ public:
   void configure(const std::vector<Game::Map::RiverSegment> &riverSegments,
                  float tile_size);
 
+  void setQuality(WaterQuality quality) { m_quality = quality; }
+  [[nodiscard]] auto quality() const -> WaterQuality { return m_quality; }
+
   void submit(Renderer &renderer, ResourceManager *resources) override;
 
 private:
@@ -27,6 +37,10 @@ private:
   std::vector<Game::Map::RiverSegment> m_riverSegments;
   float m_tile_size = 1.0F;
   std::vector<std::unique_ptr<Mesh>> m_meshes;
+  WaterQuality m_quality = WaterQuality::High;
+  ShaderHandle m_shaderHandle = InvalidShaderHandle;
+  ShaderHandle m_mediumShaderHandle = InvalidShaderHandle;
+  ShaderHandle m_lowShaderHandle = InvalidShaderHandle;
 };
 
 } // namespace Render::GL
@@ -1,18 +1,15 @@
 #include "riverbank_asset_renderer.h"
-#include "../../game/map/visibility_service.h"
 #include "../gl/buffer.h"
 #include "../scene_renderer.h"
-#include "gl/resources.h"
-#include "ground/riverbank_asset_gpu.h"
 #include "ground_utils.h"
 #include "map/terrain.h"
 #include <QDebug>
-#include <QVector2D>
+#include <QVector3D>
+#include <QVector4D>
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
-#include <memory>
 #include <qglobal.h>
 #include <vector>
 
@@ -21,21 +18,13 @@ namespace {
 using std::uint32_t;
 using namespace Render::Ground;
 
-inline auto valueNoise(float x, float z, uint32_t salt = 0U) -> float {
-  int x0 = int(std::floor(x));
-  int z0 = int(std::floor(z));
-  int x1 = x0 + 1;
-  int z1 = z0 + 1;
-  float tx = x - float(x0);
-  float tz = z - float(z0);
-  float const n00 = hash_to_01(hash_coords(x0, z0, salt));
-  float const n10 = hash_to_01(hash_coords(x1, z0, salt));
-  float const n01 = hash_to_01(hash_coords(x0, z1, salt));
-  float const n11 = hash_to_01(hash_coords(x1, z1, salt));
-  float const nx0 = n00 * (1 - tx) + n10 * tx;
-  float const nx1 = n01 * (1 - tx) + n11 * tx;
-  return nx0 * (1 - tz) + nx1 * tz;
-}
+// Culling cell edge length and cell-bounds padding in world units; same
+// grid granularity as the other ground scatter.
+constexpr float k_cull_cell_size = 12.0F;
+constexpr float k_bank_bounds_padding = 2.0F;
+
+// Plant-pipeline shape index used for reed tufts at the waterline.
+constexpr float k_reed_plant_type = 2.0F;
 
 } // namespace
 
@@ -57,13 +46,8 @@ void RiverbankAssetRenderer::configure(
   m_biomeSettings = biomeSettings;
   m_noiseSeed = biomeSettings.seed;
 
-  m_assetInstances.clear();
-  m_assetInstanceBuffer.reset();
-  m_assetInstanceCount = 0;
-  m_assetInstancesDirty = false;
-
-  m_assetParams.light_direction = QVector3D(0.35F, 0.8F, 0.45F);
-  m_assetParams.time = 0.0F;
+  m_rockParams.light_direction = StoneBatchParams::defaultLightDirection();
+  m_reedParams.light_direction = PlantBatchParams::defaultLightDirection();
 
   generateAssetInstances();
 }
@@ -72,61 +56,41 @@ void RiverbankAssetRenderer::submit(Renderer &renderer,
                                     ResourceManager *resources) {
   Q_UNUSED(resources);
 
-  if (m_assetInstanceCount == 0) {
-    return;
-  }
-
-  if (!m_assetInstanceBuffer) {
-    m_assetInstanceBuffer = std::make_unique<Buffer>(Buffer::Type::Vertex);
-  }
-  if (m_assetInstancesDirty && m_assetInstanceBuffer) {
-    m_assetInstanceBuffer->setData(m_assetInstances, Buffer::Usage::Static);
-    m_assetInstancesDirty = false;
-  }
-
-  auto &visibility = Game::Map::VisibilityService::instance();
-  const bool use_visibility = visibility.isInitialized();
-
-  std::vector<RiverbankAssetInstanceGpu> visible_instances;
-
-  for (const auto &instance : m_assetInstances) {
-    bool should_render = true;
-
-    if (use_visibility) {
-      float const world_x = instance.position[0];
-      float const world_z = instance.position[2];
-
-      if (!visibility.isVisibleWorld(world_x, world_z)) {
-        should_render = false;
-      }
-    }
-
-    if (should_render) {
-      visible_instances.push_back(instance);
-    }
-  }
-
-  if (!visible_instances.empty()) {
-
-    qDebug() << "RiverbankAssetRenderer: Would render"
-             << visible_instances.size() << "of" << m_assetInstanceCount
-             << "riverbank assets (fog of war applied)";
-  }
+  m_rockInstances.submitCulled(
+      renderer, k_cull_cell_size, k_bank_bounds_padding,
+      [](const StoneInstanceGpu &instance) {
+        return QVector3D(instance.posScale.x(), instance.posScale.y(),
+                         instance.posScale.z());
+      },
+      [&](Buffer *buffer, std::size_t visible_count) {
+        renderer.stoneBatch(buffer, visible_count, m_rockParams);
+      });
+
+  m_reedInstances.submitCulled(
+      renderer, k_cull_cell_size, k_bank_bounds_padding,
+      [](const PlantInstanceGpu &instance) {
+        return QVector3D(instance.posScale.x(), instance.posScale.y(),
+                         instance.posScale.z());
+      },
+      [&](Buffer *buffer, std::size_t visible_count) {
+        renderer.plantBatch(buffer, visible_count, m_reedParams);
+      });
 }
 
 void RiverbankAssetRenderer::clear() {
-  m_assetInstances.clear();
-  m_assetInstanceBuffer.reset();
-  m_assetInstanceCount = 0;
-  m_assetInstancesDirty = false;
+  m_rockInstances.clear();
+  m_reedInstances.clear();
 }
 
 void RiverbankAssetRenderer::generateAssetInstances() {
-  m_assetInstances.clear();
+  auto &rocks = m_rockInstances.instances();
+  auto &reeds = m_reedInstances.instances();
+  rocks.clear();
+  reeds.clear();
 
   if (m_riverSegments.empty() || m_width < 2 || m_height < 2) {
-    m_assetInstanceCount = 0;
-    m_assetInstancesDirty = false;
+    m_rockInstances.markDirty();
+    m_reedInstances.markDirty();
     return;
   }
 
@@ -205,69 +169,57 @@ void RiverbankAssetRenderer::generateAssetInstances() {
         }
 
         float const world_y = sample_height_at(gx, gz);
-
-        RiverbankAssetInstanceGpu instance{};
-        instance.position[0] = asset_pos.x();
-        instance.position[1] = world_y;
-        instance.position[2] = asset_pos.z();
+        float const rotation = rand_01(rng) * 6.28318F;
 
         float const type_rand = rand_01(rng);
         if (type_rand < 0.7F) {
-
-          instance.assetType = 0.0F;
+          // Pebble.
           float const size = 0.05F + rand_01(rng) * 0.1F;
-          instance.scale[0] = size * (0.8F + rand_01(rng) * 0.4F);
-          instance.scale[1] = size * (0.6F + rand_01(rng) * 0.3F);
-          instance.scale[2] = size * (0.8F + rand_01(rng) * 0.4F);
-
           float const color_var = 0.3F + rand_01(rng) * 0.4F;
-          instance.color[0] = color_var;
-          instance.color[1] = color_var * 0.9F;
-          instance.color[2] = color_var * 0.85F;
+          StoneInstanceGpu instance;
+          instance.posScale =
+              QVector4D(asset_pos.x(), world_y + 0.01F, asset_pos.z(), size);
+          instance.colorRot = QVector4D(color_var, color_var * 0.9F,
+                                        color_var * 0.85F, rotation);
+          rocks.push_back(instance);
         } else if (type_rand < 0.9F) {
-
-          instance.assetType = 1.0F;
+          // Larger bank rock.
           float const size = 0.1F + rand_01(rng) * 0.15F;
-          instance.scale[0] = size;
-          instance.scale[1] = size * (0.7F + rand_01(rng) * 0.4F);
-          instance.scale[2] = size;
-
           float const color_var = 0.35F + rand_01(rng) * 0.25F;
-          instance.color[0] = color_var;
-          instance.color[1] = color_var * 0.95F;
-          instance.color[2] = color_var * 0.9F;
+          StoneInstanceGpu instance;
+          instance.posScale =
+              QVector4D(asset_pos.x(), world_y + 0.01F, asset_pos.z(), size);
+          instance.colorRot = QVector4D(color_var, color_var * 0.95F,
+                                        color_var * 0.9F, rotation);
+          rocks.push_back(instance);
         } else {
-
+          // Reed tuft, only right at the waterline.
           if (dist_from_water > half_river_width + 0.5F) {
             continue;
           }
-
-          instance.assetType = 2.0F;
           float const size = 0.3F + rand_01(rng) * 0.4F;
-          instance.scale[0] = size * 0.3F;
-          instance.scale[1] = size;
-          instance.scale[2] = size * 0.3F;
-
-          instance.color[0] = 0.25F + rand_01(rng) * 0.15F;
-          instance.color[1] = 0.35F + rand_01(rng) * 0.25F;
-          instance.color[2] = 0.15F + rand_01(rng) * 0.1F;
+          QVector3D const color(0.25F + rand_01(rng) * 0.15F,
+                                0.35F + rand_01(rng) * 0.25F,
+                                0.15F + rand_01(rng) * 0.1F);
+          float const sway_phase = rand_01(rng) * 6.28318F;
+          PlantInstanceGpu instance;
+          instance.posScale =
+              QVector4D(asset_pos.x(), world_y + 0.02F, asset_pos.z(), size);
+          instance.colorSway =
+              QVector4D(color.x(), color.y(), color.z(), sway_phase);
+          instance.typeParams =
+              QVector4D(k_reed_plant_type, rotation, 1.1F, 1.2F);
+          reeds.push_back(instance);
         }
-
-        float const angle = rand_01(rng) * 6.28318F;
-        instance.rotation[0] = 0.0F;
-        instance.rotation[1] = std::sin(angle * 0.5F);
-        instance.rotation[2] = 0.0F;
-        instance.rotation[3] = std::cos(angle * 0.5F);
-
-        m_assetInstances.push_back(instance);
       }
     }
   }
 
-  m_assetInstanceCount = m_assetInstances.size();
-  m_assetInstancesDirty = true;
+  m_rockInstances.markDirty();
+  m_reedInstances.markDirty();
 
-  qDebug() << "Generated" << m_assetInstanceCount << "riverbank assets";
+  qDebug() << "Generated" << rocks.size() << "riverbank rocks and"
+           << reeds.size() << "reeds";
 }
 
 } // namespace Render::GL
@@ -2,16 +2,21 @@
 
 #include "../../game/map/terrain.h"
 #include "../i_render_pass.h"
-#include "riverbank_asset_gpu.h"
-#include <QVector3D>
+#include "plant_gpu.h"
+#include "stone_gpu.h"
+#include "vegetation_instances.h"
 #include <cstdint>
-#include <memory>
 #include <vector>
 
 namespace Render::GL {
-class Buffer;
 class Renderer;
 
+// Scatters shoreline decoration along river segments — pebbles and rocks
+// through the stone instanced pipeline, reeds through the plant pipeline —
+// so the whole pass costs a couple of instanced draws. Instances live in
+// the shared vegetation cell grid and are culled with the same frustum and
+// fog-of-war pass as the other ground scatter, so off-screen rivers cost
+// nothing per frame.
 class RiverbankAssetRenderer : public IRenderPass {
 public:
   RiverbankAssetRenderer();
@@ -38,11 +43,10 @@ private:
   Game::Map::BiomeSettings m_biomeSettings;
   std::uint32_t m_noiseSeed = 0U;
 
-  std::vector<RiverbankAssetInstanceGpu> m_assetInstances;
-  std::unique_ptr<Buffer> m_assetInstanceBuffer;
-  std::size_t m_assetInstanceCount = 0;
-  RiverbankAssetBatchParams m_assetParams;
-  bool m_assetInstancesDirty = false;
+  Render::Ground::VegetationInstanceManager<StoneInstanceGpu> m_rockInstances;
+  Render::Ground::VegetationInstanceManager<PlantInstanceGpu> m_reedInstances;
+  StoneBatchParams m_rockParams;
+  PlantBatchParams m_reedParams;
 };
 
 } // namespace Render::GL
@@ -250,7 +250,10 @@ void RiverbankRenderer::submit(Renderer &renderer, ResourceManager *resources) {
   auto &visibility = Game::Map::VisibilityService::instance();
   const bool use_visibility = visibility.isInitialized();
 
-  auto *shader = renderer.getShader("riverbank");
+  if (m_shaderHandle == InvalidShaderHandle) {
+    m_shaderHandle = renderer.shaderHandle(QStringLiteral("riverbank"));
+  }
+  auto *shader = renderer.getShader(m_shaderHandle);
   if (shader == nullptr) {
     return;
   }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../game/map/terrain.h"
+#include "../gl/shader.h"
 #include "../i_render_pass.h"
 #include <QMatrix4x4>
 #include <memory>
@@ -31,6 +32,7 @@ private:
   std::vector<float> m_heights;
   std::vector<std::unique_ptr<Mesh>> m_meshes;
   std::vector<std::vector<QVector3D>> m_visibilitySamples;
+  ShaderHandle m_shaderHandle = InvalidShaderHandle;
 };
 
 } // namespace Render::GL
@@ -12,7 +12,6 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
-#include <memory>
 #include <qelapsedtimer.h>
 #include <qglobal.h>
 #include <vector>
@@ -22,21 +21,9 @@ namespace {
 using std::uint32_t;
 using namespace Render::Ground;
 
-inline auto valueNoise(float x, float z, uint32_t salt = 0U) -> float {
-  int x0 = int(std::floor(x));
-  int z0 = int(std::floor(z));
-  int x1 = x0 + 1;
-  int z1 = z0 + 1;
-  float tx = x - float(x0);
-  float tz = z - float(z0);
-  float const n00 = hash_to_01(hash_coords(x0, z0, salt));
-  float const n10 = hash_to_01(hash_coords(x1, z0, salt));
-  float const n01 = hash_to_01(hash_coords(x0, z1, salt));
-  float const n11 = hash_to_01(hash_coords(x1, z1, salt));
-  float const nx0 = n00 * (1 - tx) + n10 * tx;
-  float const nx1 = n01 * (1 - tx) + n11 * tx;
-  return nx0 * (1 - tz) + nx1 * tz;
-}
+// Culling cell edge length and cell-bounds padding in world units.
+constexpr float k_cull_cell_size = 12.0F;
+constexpr float k_stone_bounds_padding = 2.5F;
 
 } // namespace
 
@@ -56,9 +43,6 @@ void StoneRenderer::configure(const Game::Map::TerrainHeightMap &height_map,
   m_noiseSeed = biomeSettings.seed;
 
   m_stoneInstances.clear();
-  m_stoneInstanceBuffer.reset();
-  m_stoneInstanceCount = 0;
-  m_stoneInstancesDirty = false;
 
   m_stoneParams.light_direction = QVector3D(0.35F, 0.8F, 0.45F);
   m_stoneParams.time = 0.0F;
@@ -68,39 +52,27 @@ void StoneRenderer::configure(const Game::Map::TerrainHeightMap &height_map,
 
 void StoneRenderer::submit(Renderer &renderer, ResourceManager *resources) {
   Q_UNUSED(resources);
-  if (m_stoneInstanceCount > 0) {
-    if (!m_stoneInstanceBuffer) {
-      m_stoneInstanceBuffer = std::make_unique<Buffer>(Buffer::Type::Vertex);
-    }
-    if (m_stoneInstancesDirty && m_stoneInstanceBuffer) {
-      m_stoneInstanceBuffer->setData(m_stoneInstances, Buffer::Usage::Static);
-      m_stoneInstancesDirty = false;
-    }
-  } else {
-    m_stoneInstanceBuffer.reset();
-    return;
-  }
-
-  renderer.stoneBatch(m_stoneInstanceBuffer.get(), m_stoneInstanceCount,
-                      m_stoneParams);
+  m_stoneInstances.submitCulled(
+      renderer, k_cull_cell_size, k_stone_bounds_padding,
+      [](const StoneInstanceGpu &instance) {
+        return QVector3D(instance.posScale.x(), instance.posScale.y(),
+                         instance.posScale.z());
+      },
+      [&](Buffer *buffer, std::size_t visible_count) {
+        renderer.stoneBatch(buffer, visible_count, m_stoneParams);
+      });
 }
 
-void StoneRenderer::clear() {
-  m_stoneInstances.clear();
-  m_stoneInstanceBuffer.reset();
-  m_stoneInstanceCount = 0;
-  m_stoneInstancesDirty = false;
-}
+void StoneRenderer::clear() { m_stoneInstances.clear(); }
 
 void StoneRenderer::generateStoneInstances() {
   QElapsedTimer timer;
   timer.start();
 
-  m_stoneInstances.clear();
+  auto &stones = m_stoneInstances.instances();
+  stones.clear();
 
   if (m_width < 2 || m_height < 2 || m_heightData.empty()) {
-    m_stoneInstanceCount = 0;
-    m_stoneInstancesDirty = false;
     return;
   }
 
@@ -223,7 +195,7 @@ void StoneRenderer::generateStoneInstances() {
     StoneInstanceGpu instance;
     instance.posScale = QVector4D(world_x, world_y + 0.01F, world_z, scale);
     instance.colorRot = QVector4D(color.x(), color.y(), color.z(), rotation);
-    m_stoneInstances.push_back(instance);
+    stones.push_back(instance);
     return true;
   };
 
@@ -248,8 +220,8 @@ void StoneRenderer::generateStoneInstances() {
 
       float const world_x = (x - half_width) * m_tile_size;
       float const world_z = (z - half_height) * m_tile_size;
-      float const cluster_noise = valueNoise(world_x * 0.03F, world_z * 0.03F,
-                                             m_noiseSeed ^ 0x7F3A9B2CU);
+      float const cluster_noise = value_noise(world_x * 0.03F, world_z * 0.03F,
+                                              m_noiseSeed ^ 0x7F3A9B2CU);
 
       if (cluster_noise < 0.6F) {
         continue;
@@ -269,8 +241,7 @@ void StoneRenderer::generateStoneInstances() {
     }
   }
 
-  m_stoneInstanceCount = m_stoneInstances.size();
-  m_stoneInstancesDirty = m_stoneInstanceCount > 0;
+  m_stoneInstances.markDirty();
 }
 
 } // namespace Render::GL
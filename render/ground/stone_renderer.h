@@ -3,13 +3,12 @@
 #include "../../game/map/terrain.h"
 #include "../i_render_pass.h"
 #include "stone_gpu.h"
+#include "vegetation_instances.h"
 #include <QVector3D>
 #include <cstdint>
-#include <memory>
 #include <vector>
 
 namespace Render::GL {
-class Buffer;
 class Renderer;
 
 class StoneRenderer : public IRenderPass {
@@ -36,11 +35,8 @@ private:
   Game::Map::BiomeSettings m_biomeSettings;
   std::uint32_t m_noiseSeed = 0U;
 
-  std::vector<StoneInstanceGpu> m_stoneInstances;
-  std::unique_ptr<Buffer> m_stoneInstanceBuffer;
-  std::size_t m_stoneInstanceCount = 0;
+  Render::Ground::VegetationInstanceManager<StoneInstanceGpu> m_stoneInstances;
   StoneBatchParams m_stoneParams;
-  bool m_stoneInstancesDirty = false;
 };
 
 } // namespace Render::GL
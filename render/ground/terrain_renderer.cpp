@@ -1,5 +1,6 @@
 #include "terrain_renderer.h"
 #include "../../game/map/visibility_service.h"
+#include "../gl/camera.h"
 #include "../gl/mesh.h"
 #include "../gl/render_constants.h"
 #include "../gl/resources.h"
@@ -36,6 +37,10 @@ using namespace Render::Ground;
 
 const QMatrix4x4 k_identity_matrix;
 
+// Chunks whose center is farther than this from the camera draw the
+// half-resolution mesh instead of the full one.
+constexpr float k_lod_distance = 80.0F;
+
 inline auto applyTint(const QVector3D &color, float tint) -> QVector3D {
   QVector3D const c = color * tint;
   return {std::clamp(c.x(), 0.0F, 1.0F), std::clamp(c.y(), 0.0F, 1.0F),
@@ -55,22 +60,6 @@ inline auto smooth(float a, float b, float x) -> float {
   return t * t * (3.0F - 2.0F * t);
 }
 
-inline auto valueNoise(float x, float z, uint32_t salt = 0U) -> float {
-  int x0 = int(std::floor(x));
-  int z0 = int(std::floor(z));
-  int x1 = x0 + 1;
-  int z1 = z0 + 1;
-  float tx = x - float(x0);
-  float tz = z - float(z0);
-  float const n00 = hash_to_01(hash_coords(x0, z0, salt));
-  float const n10 = hash_to_01(hash_coords(x1, z0, salt));
-  float const n01 = hash_to_01(hash_coords(x0, z1, salt));
-  float const n11 = hash_to_01(hash_coords(x1, z1, salt));
-  float const nx0 = n00 * (1 - tx) + n10 * tx;
-  float const nx1 = n01 * (1 - tx) + n11 * tx;
-  return nx0 * (1 - tz) + nx1 * tz;
-}
-
 } // namespace
 
 namespace Render::GL {
@@ -101,11 +90,23 @@ void TerrainRenderer::submit(Renderer &renderer, ResourceManager *resources) {
   auto &visibility = Game::Map::VisibilityService::instance();
   const bool use_visibility = visibility.isInitialized();
 
+  const Camera *camera = renderer.getCamera();
+  Frustum frustum;
+  const bool use_frustum = (camera != nullptr);
+  if (use_frustum) {
+    frustum = camera->extractFrustum();
+  }
+
   for (const auto &chunk : m_chunks) {
     if (!chunk.mesh) {
       continue;
     }
 
+    if (use_frustum && chunk.boundsRadius > 0.0F &&
+        !frustum.intersectsSphere(chunk.boundsCenter, chunk.boundsRadius)) {
+      continue;
+    }
+
     if (use_visibility) {
       bool any_visible = false;
       for (int gz = chunk.minZ; gz <= chunk.maxZ && !any_visible; ++gz) {
@@ -122,8 +123,15 @@ void TerrainRenderer::submit(Renderer &renderer, ResourceManager *resources) {
       }
     }
 
-    renderer.terrainChunk(chunk.mesh.get(), k_identity_matrix, chunk.params,
-                          0x0080U, true, 0.0F);
+    Mesh *mesh = chunk.mesh.get();
+    if (chunk.meshLow && camera != nullptr &&
+        (camera->getPosition() - chunk.boundsCenter).length() >
+            k_lod_distance) {
+      mesh = chunk.meshLow.get();
+    }
+
+    renderer.terrainChunk(mesh, k_identity_matrix, chunk.params, 0x0080U, true,
+                          0.0F);
   }
 }
 
@@ -481,6 +489,31 @@ void TerrainRenderer::buildMeshes() {
         }
       }
 
+      // The half-resolution meshes drop every second border vertex, so a
+      // coarse chunk next to a full-detail one can gap wherever the skipped
+      // midpoint deviates from the coarse edge. The skirt only has to cover
+      // the worst such deviation along this chunk's border.
+      float max_edge_dev = 0.0F;
+      auto edge_dev = [&](int idx_a, int idx_mid, int idx_b) {
+        float const d =
+            std::abs(m_heightData[idx_mid] -
+                     0.5F * (m_heightData[idx_a] + m_heightData[idx_b]));
+        max_edge_dev = std::max(max_edge_dev, d);
+      };
+      for (int x = chunk_x; x + 2 <= chunk_max_x; x += 2) {
+        edge_dev(chunk_z * m_width + x, chunk_z * m_width + x + 1,
+                 chunk_z * m_width + x + 2);
+        edge_dev(chunk_max_z * m_width + x, chunk_max_z * m_width + x + 1,
+                 chunk_max_z * m_width + x + 2);
+      }
+      for (int z = chunk_z; z + 2 <= chunk_max_z; z += 2) {
+        edge_dev(z * m_width + chunk_x, (z + 1) * m_width + chunk_x,
+                 (z + 2) * m_width + chunk_x);
+        edge_dev(z * m_width + chunk_max_x, (z + 1) * m_width + chunk_max_x,
+                 (z + 2) * m_width + chunk_max_x);
+      }
+      float const skirt_drop = max_edge_dev + 0.25F * m_tile_size;
+
       for (int i = 0; i < 3; ++i) {
         SectionData const &section = sections[i];
         if (section.indices.empty()) {
@@ -494,6 +527,106 @@ void TerrainRenderer::buildMeshes() {
 
         ChunkMesh chunk;
         chunk.mesh = std::move(mesh);
+
+        {
+          QVector3D bmin(std::numeric_limits<float>::infinity(),
+                         std::numeric_limits<float>::infinity(),
+                         std::numeric_limits<float>::infinity());
+          QVector3D bmax = -bmin;
+          for (const Vertex &v : section.vertices) {
+            bmin.setX(std::min(bmin.x(), v.position[0]));
+            bmin.setY(std::min(bmin.y(), v.position[1]));
+            bmin.setZ(std::min(bmin.z(), v.position[2]));
+            bmax.setX(std::max(bmax.x(), v.position[0]));
+            bmax.setY(std::max(bmax.y(), v.position[1]));
+            bmax.setZ(std::max(bmax.z(), v.position[2]));
+          }
+          bmin.setY(bmin.y() - skirt_drop);
+          chunk.boundsCenter = (bmin + bmax) * 0.5F;
+          chunk.boundsRadius = (bmax - bmin).length() * 0.5F;
+        }
+
+        // Half-resolution LOD: the same section rebuilt from every second
+        // grid vertex, skirted along the chunk border.
+        {
+          SectionData low;
+          low.rotationDeg = rotation_step;
+          low.flipU = flip;
+          low.tint = tint;
+
+          auto add_skirt = [&](unsigned int top_a, unsigned int top_b,
+                               bool flip_winding) {
+            Vertex a_low = low.vertices[top_a];
+            Vertex b_low = low.vertices[top_b];
+            a_low.position[1] -= skirt_drop;
+            b_low.position[1] -= skirt_drop;
+            auto const base = static_cast<unsigned int>(low.vertices.size());
+            low.vertices.push_back(a_low);
+            low.vertices.push_back(b_low);
+            if (flip_winding) {
+              low.indices.insert(low.indices.end(),
+                                 {top_a, top_b, base, top_b, base + 1, base});
+            } else {
+              low.indices.insert(low.indices.end(),
+                                 {top_a, base, top_b, top_b, base, base + 1});
+            }
+          };
+
+          for (int z = chunk_z; z < chunk_max_z; z += 2) {
+            int const z2 = std::min(z + 2, chunk_max_z);
+            for (int x = chunk_x; x < chunk_max_x; x += 2) {
+              int const x2 = std::min(x + 2, chunk_max_x);
+
+              // A coarse quad covers up to four fine quads; it belongs to
+              // the highest-priority section any of them used, so every fine
+              // quad of this section is covered by exactly one coarse quad.
+              int coarse_section = 0;
+              for (int fz = z; fz < z2; ++fz) {
+                for (int fx = x; fx < x2; ++fx) {
+                  int const f0 = fz * m_width + fx;
+                  int const f1 = f0 + 1;
+                  int const f2 = (fz + 1) * m_width + fx;
+                  int const f3 = f2 + 1;
+                  coarse_section = std::max(
+                      coarse_section,
+                      quad_section(m_terrain_types[f0], m_terrain_types[f1],
+                                   m_terrain_types[f2], m_terrain_types[f3]));
+                }
+              }
+              if (coarse_section != i) {
+                continue;
+              }
+
+              unsigned int const v0 = ensure_vertex(low, z * m_width + x);
+              unsigned int const v1 = ensure_vertex(low, z * m_width + x2);
+              unsigned int const v2 = ensure_vertex(low, z2 * m_width + x);
+              unsigned int const v3 = ensure_vertex(low, z2 * m_width + x2);
+              low.indices.push_back(v0);
+              low.indices.push_back(v1);
+              low.indices.push_back(v2);
+              low.indices.push_back(v2);
+              low.indices.push_back(v1);
+              low.indices.push_back(v3);
+
+              if (z == chunk_z) {
+                add_skirt(v0, v1, true);
+              }
+              if (z2 == chunk_max_z) {
+                add_skirt(v2, v3, false);
+              }
+              if (x == chunk_x) {
+                add_skirt(v0, v2, false);
+              }
+              if (x2 == chunk_max_x) {
+                add_skirt(v1, v3, true);
+              }
+            }
+          }
+
+          if (!low.indices.empty()) {
+            chunk.meshLow = std::make_unique<Mesh>(low.vertices, low.indices);
+          }
+        }
         chunk.minX = chunk_x;
         chunk.maxX = chunk_max_x - 1;
         chunk.minZ = chunk_z;
@@ -557,8 +690,8 @@ void TerrainRenderer::buildMeshes() {
 
         float const center_wx = (center_gx - half_width) * m_tile_size;
         float const center_wz = (center_gz - half_height) * m_tile_size;
-        float const macro = valueNoise(center_wx * 0.02F, center_wz * 0.02F,
-                                       m_noiseSeed ^ 0x51C3U);
+        float const macro = value_noise(center_wx * 0.02F, center_wz * 0.02F,
+                                        m_noiseSeed ^ 0x51C3U);
         float const macro_shade = 0.9F + 0.2F * macro;
 
         float const ao_avg = (section.aoCount > 0)
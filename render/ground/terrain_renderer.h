@@ -37,6 +37,12 @@ private:
                                      float height) const -> QVector3D;
   struct ChunkMesh {
     std::unique_ptr<Mesh> mesh;
+    // Half-resolution variant with a skirt dropped along the chunk border;
+    // used beyond the LOD distance so coarse chunks meeting full-detail
+    // neighbours do not open cracks.
+    std::unique_ptr<Mesh> meshLow;
+    QVector3D boundsCenter;
+    float boundsRadius = 0.0F;
     int minX = 0;
     int maxX = 0;
     int minZ = 0;
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "../gl/camera.h"
+#include <QVector3D>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace Render::Ground {
+
+// CPU stand-in for a GPU culling pass (the renderer targets GL 3.3 core, so
+// no compute): instances are bucketed into square world-space cells once at
+// build time, then each frame whole cells are tested against the frustum and
+// fog-of-war and the survivors compacted into one contiguous array. Per-frame
+// cost scales with the cell count rather than the instance count, and the
+// compacted array — and thus the GPU upload — only changes when the visible
+// cell set changes.
+template <typename InstanceT> class VegetationCuller {
+public:
+  template <typename PositionFn>
+  void build(const std::vector<InstanceT> &instances, float cell_size,
+             float bounds_padding, PositionFn position_of) {
+    m_cells.clear();
+    m_sorted.clear();
+    m_visibleCells.clear();
+    m_lastVisibleCells.clear();
+    m_visible.clear();
+    m_compactionStale = true;
+
+    if (instances.empty()) {
+      return;
+    }
+    cell_size = std::max(1.0F, cell_size);
+
+    std::unordered_map<std::uint64_t, std::vector<std::size_t>> buckets;
+    auto cell_key = [&](const QVector3D &p) -> std::uint64_t {
+      auto const cx =
+          static_cast<std::int32_t>(std::floor(p.x() / cell_size));
+      auto const cz =
+          static_cast<std::int32_t>(std::floor(p.z() / cell_size));
+      return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cx))
+              << 32U) |
+             static_cast<std::uint64_t>(static_cast<std::uint32_t>(cz));
+    };
+    for (std::size_t i = 0; i < instances.size(); ++i) {
+      buckets[cell_key(position_of(instances[i]))].push_back(i);
+    }
+
+    m_sorted.reserve(instances.size());
+    m_cells.reserve(buckets.size());
+    for (const auto &bucket : buckets) {
+      Cell cell;
+      cell.begin = m_sorted.size();
+      constexpr float k_inf = std::numeric_limits<float>::infinity();
+      QVector3D bmin(k_inf, k_inf, k_inf);
+      QVector3D bmax(-k_inf, -k_inf, -k_inf);
+      for (std::size_t const idx : bucket.second) {
+        const QVector3D p = position_of(instances[idx]);
+        bmin.setX(std::min(bmin.x(), p.x()));
+        bmin.setY(std::min(bmin.y(), p.y()));
+        bmin.setZ(std::min(bmin.z(), p.z()));
+        bmax.setX(std::max(bmax.x(), p.x()));
+        bmax.setY(std::max(bmax.y(), p.y()));
+        bmax.setZ(std::max(bmax.z(), p.z()));
+        m_sorted.push_back(instances[idx]);
+      }
+      cell.end = m_sorted.size();
+      bmin -= QVector3D(bounds_padding, bounds_padding, bounds_padding);
+      bmax += QVector3D(bounds_padding, bounds_padding, bounds_padding);
+      cell.boundsMin = bmin;
+      cell.boundsMax = bmax;
+      cell.center = (bmin + bmax) * 0.5F;
+      cell.radius = (bmax - bmin).length() * 0.5F;
+      m_cells.push_back(cell);
+    }
+  }
+
+  // Re-tests every cell; `area_visible(min_x, min_z, max_x, max_z)` answers
+  // whether any part of the rectangle is out of fog. `max_distance` caps
+  // how far from `eye` cells may draw (non-positive means uncapped; the
+  // frame governor tightens it under load). Returns true when the
+  // compacted array changed and needs re-uploading.
+  template <typename AreaVisibleFn>
+  auto cull(const Render::GL::Frustum *frustum, bool use_fog,
+            AreaVisibleFn area_visible, const QVector3D &eye,
+            float max_distance) -> bool {
+    m_visibleCells.clear();
+    for (std::size_t i = 0; i < m_cells.size(); ++i) {
+      const Cell &cell = m_cells[i];
+      if ((frustum != nullptr) &&
+          !frustum->intersectsSphere(cell.center, cell.radius)) {
+        continue;
+      }
+      if (max_distance > 0.0F &&
+          (cell.center - eye).length() - cell.radius > max_distance) {
+        continue;
+      }
+      if (use_fog &&
+          !area_visible(cell.boundsMin.x(), cell.boundsMin.z(),
+                        cell.boundsMax.x(), cell.boundsMax.z())) {
+        continue;
+      }
+      m_visibleCells.push_back(static_cast<std::uint32_t>(i));
+    }
+
+    if (!m_compactionStale && m_visibleCells == m_lastVisibleCells) {
+      return false;
+    }
+    m_lastVisibleCells = m_visibleCells;
+    m_compactionStale = false;
+
+    m_visible.clear();
+    for (std::uint32_t const cell_index : m_visibleCells) {
+      const Cell &cell = m_cells[cell_index];
+      m_visible.insert(m_visible.end(), m_sorted.begin() + cell.begin,
+                       m_sorted.begin() + cell.end);
+    }
+    return true;
+  }
+
+  [[nodiscard]] auto visible() const -> const std::vector<InstanceT> & {
+    return m_visible;
+  }
+  [[nodiscard]] auto built() const -> bool { return !m_cells.empty(); }
+
+  void clear() {
+    m_cells.clear();
+    m_sorted.clear();
+    m_visibleCells.clear();
+    m_lastVisibleCells.clear();
+    m_visible.clear();
+    m_compactionStale = true;
+  }
+
+private:
+  struct Cell {
+    QVector3D boundsMin;
+    QVector3D boundsMax;
+    QVector3D center;
+    float radius = 0.0F;
+    std::size_t begin = 0;
+    std::size_t end = 0;
+  };
+
+  std::vector<InstanceT> m_sorted;
+  std::vector<Cell> m_cells;
+  std::vector<std::uint32_t> m_visibleCells;
+  std::vector<std::uint32_t> m_lastVisibleCells;
+  std::vector<InstanceT> m_visible;
+  bool m_compactionStale = true;
+};
+
+} // namespace Render::Ground
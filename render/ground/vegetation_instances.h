@@ -0,0 +1,115 @@
+#pragma once
+
+#include "../../game/core/frame_governor.h"
+#include "../../game/map/visibility_service.h"
+#include "../gl/buffer.h"
+#include "../gl/camera.h"
+#include "../scene_renderer.h"
+#include "vegetation_culler.h"
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Render::Ground {
+
+/**
+ * Owns one vegetation type's packed instance array, spatial culler and
+ * GPU buffer, and runs the per-frame flow every ground scatter renderer
+ * shares: rebuild the culler when the instances changed, cull against
+ * the camera frustum and fog-of-war, and re-upload the compacted array
+ * only when the visible cell set differs from the previous frame.
+ *
+ * Generators fill instances() and call markDirty(); the per-type
+ * renderers keep only their scatter rules and batch parameters.
+ */
+template <typename InstanceT> class VegetationInstanceManager {
+public:
+  [[nodiscard]] auto instances() -> std::vector<InstanceT> & {
+    return m_instances;
+  }
+  [[nodiscard]] auto instances() const -> const std::vector<InstanceT> & {
+    return m_instances;
+  }
+  [[nodiscard]] auto count() const -> std::size_t {
+    return m_instances.size();
+  }
+
+  /// Marks the instance array as changed so the next submit rebuilds the
+  /// culler grid and re-uploads whatever survives culling.
+  void markDirty() { m_dirty = true; }
+
+  void clear() {
+    m_instances.clear();
+    m_culler.clear();
+    m_buffer.reset();
+    m_dirty = false;
+  }
+
+  /**
+   * Culls and uploads, then calls emit_batch(buffer, visible_count) so
+   * the caller can submit its typed batch command. position_of maps an
+   * instance to its world position for the culler grid; emit_batch only
+   * runs when at least one instance survived culling.
+   */
+  template <typename PositionFn, typename BatchFn>
+  void submitCulled(Render::GL::Renderer &renderer, float cell_size,
+                    float bounds_padding, PositionFn position_of,
+                    BatchFn emit_batch) {
+    if (m_instances.empty()) {
+      m_buffer.reset();
+      m_culler.clear();
+      return;
+    }
+
+    if (m_dirty || !m_culler.built()) {
+      m_culler.build(m_instances, cell_size, bounds_padding,
+                     std::move(position_of));
+      m_dirty = false;
+    }
+
+    auto &visibility = Game::Map::VisibilityService::instance();
+    const bool use_visibility = visibility.isInitialized();
+
+    const Render::GL::Frustum *frustum_ptr = nullptr;
+    QVector3D eye;
+    if (const Render::GL::Camera *camera = renderer.getCamera()) {
+      frustum_ptr = &camera->extractFrustum();
+      eye = camera->getPosition();
+    }
+    const float max_distance =
+        Engine::Core::FrameGovernor::instance().vegetationDrawDistance();
+
+    const bool created = !m_buffer;
+    if (created) {
+      m_buffer = std::make_unique<Render::GL::Buffer>(
+          Render::GL::Buffer::Type::Vertex);
+    }
+
+    const bool changed = m_culler.cull(
+        frustum_ptr, use_visibility,
+        [&](float min_x, float min_z, float max_x, float max_z) {
+          return visibility.isAreaVisibleWorld(min_x, min_z, max_x, max_z);
+        },
+        eye, max_distance);
+
+    const std::size_t visible_count = m_culler.visible().size();
+    if (visible_count == 0) {
+      return;
+    }
+
+    if (changed || created) {
+      m_buffer->setData(m_culler.visible(), Render::GL::Buffer::Usage::Stream);
+    }
+
+    emit_batch(m_buffer.get(), visible_count);
+  }
+
+private:
+  std::vector<InstanceT> m_instances;
+  VegetationCuller<InstanceT> m_culler;
+  std::unique_ptr<Render::GL::Buffer> m_buffer;
+  bool m_dirty = false;
+};
+
+} // namespace Render::Ground
@@ -1,7 +1,4 @@
 #include "humanoid_base.h"
-#include "../game/core/component.h"
-#include "../game/core/entity.h"
-#include "../game/core/world.h"
 #include "../game/units/troop_config.h"
 #include "../game/visuals/team_colors.h"
 #include "entity/registry.h"
@@ -14,9 +11,11 @@
 #include "palette.h"
 #include "submitter.h"
 #include "units/spawn_type.h"
+#include "world_snapshot.h"
 #include <QMatrix4x4>
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <numbers>
 #include <qmatrix4x4.h>
@@ -35,7 +34,7 @@ using Render::Geom::sphereAt;
 void HumanoidRendererBase::getVariant(const DrawContext &ctx, uint32_t seed,
                                       HumanoidVariant &v) const {
   QVector3D const team_tint = resolveTeamTint(ctx);
-  v.palette = makeHumanoidPalette(team_tint, seed);
+  v.palette = cachedHumanoidPalette(team_tint, seed);
 }
 
 void HumanoidRendererBase::customizePose(const DrawContext &ctx,
@@ -52,18 +51,13 @@ void HumanoidRendererBase::addAttachments(const DrawContext &ctx,
 auto HumanoidRendererBase::resolveTeamTint(const DrawContext &ctx)
     -> QVector3D {
   QVector3D tunic(0.8F, 0.9F, 1.0F);
-  Engine::Core::UnitComponent *unit = nullptr;
-  Engine::Core::RenderableComponent *rc = nullptr;
 
-  if (ctx.entity != nullptr) {
-    unit = ctx.entity->getComponent<Engine::Core::UnitComponent>();
-    rc = ctx.entity->getComponent<Engine::Core::RenderableComponent>();
-  }
-
-  if ((unit != nullptr) && unit->owner_id > 0) {
-    tunic = Game::Visuals::team_colorForOwner(unit->owner_id);
-  } else if (rc != nullptr) {
-    tunic = QVector3D(rc->color[0], rc->color[1], rc->color[2]);
+  if (ctx.snap != nullptr) {
+    if (ctx.snap->hasUnit && ctx.snap->ownerId > 0) {
+      tunic = Game::Visuals::team_colorForOwner(ctx.snap->ownerId);
+    } else {
+      tunic = ctx.snap->color;
+    }
   }
 
   return tunic;
@@ -76,18 +70,14 @@ auto HumanoidRendererBase::resolveFormation(const DrawContext &ctx)
   params.max_per_row = 1;
   params.spacing = 0.75F;
 
-  if (ctx.entity != nullptr) {
-    auto *unit = ctx.entity->getComponent<Engine::Core::UnitComponent>();
-    if (unit != nullptr) {
-      params.individuals_per_unit =
-          Game::Units::TroopConfig::instance().getIndividualsPerUnit(
-              unit->spawn_type);
-      params.max_per_row =
-          Game::Units::TroopConfig::instance().getMaxUnitsPerRow(
-              unit->spawn_type);
-      if (unit->spawn_type == Game::Units::SpawnType::MountedKnight) {
-        params.spacing = 1.35F;
-      }
+  if ((ctx.snap != nullptr) && ctx.snap->hasUnit) {
+    params.individuals_per_unit =
+        Game::Units::TroopConfig::instance().getIndividualsPerUnit(
+            ctx.snap->spawnType);
+    params.max_per_row = Game::Units::TroopConfig::instance().getMaxUnitsPerRow(
+        ctx.snap->spawnType);
+    if (ctx.snap->spawnType == Game::Units::SpawnType::MountedKnight) {
+      params.spacing = 1.35F;
     }
   }
 
@@ -105,77 +95,62 @@ auto HumanoidRendererBase::sampleAnimState(const DrawContext &ctx)
   anim.isExitingHold = false;
   anim.holdExitProgress = 0.0F;
 
-  if (ctx.entity == nullptr) {
+  if (ctx.snap == nullptr) {
     return anim;
   }
 
-  if (ctx.entity->hasComponent<Engine::Core::PendingRemovalComponent>()) {
-    return anim;
-  }
+  // The heavy lifting (target lookups, range tests, cooldown windows) now
+  // happens sim-side in captureWorldSnapshot; here we just copy the sampled
+  // state over.
+  anim.isMoving = ctx.snap->isMoving;
+  anim.is_attacking = ctx.snap->isAttacking;
+  anim.isMelee = ctx.snap->isMelee;
+  anim.isInHoldMode = ctx.snap->isInHoldMode;
+  anim.isExitingHold = ctx.snap->isExitingHold;
+  anim.holdExitProgress = ctx.snap->holdExitProgress;
 
-  auto *movement = ctx.entity->getComponent<Engine::Core::MovementComponent>();
-  auto *attack = ctx.entity->getComponent<Engine::Core::AttackComponent>();
-  auto *attack_target =
-      ctx.entity->getComponent<Engine::Core::AttackTargetComponent>();
-  auto *transform =
-      ctx.entity->getComponent<Engine::Core::TransformComponent>();
-  auto *hold_mode = ctx.entity->getComponent<Engine::Core::HoldModeComponent>();
-
-  anim.isInHoldMode = ((hold_mode != nullptr) && hold_mode->active);
-  if ((hold_mode != nullptr) && !hold_mode->active &&
-      hold_mode->exitCooldown > 0.0F) {
-    anim.isExitingHold = true;
-    anim.holdExitProgress =
-        1.0F - (hold_mode->exitCooldown / hold_mode->standUpDuration);
-  }
-  anim.isMoving = ((movement != nullptr) && movement->hasTarget);
-
-  if ((attack != nullptr) && (attack_target != nullptr) &&
-      attack_target->target_id > 0 && (transform != nullptr)) {
-    anim.isMelee = (attack->currentMode ==
-                    Engine::Core::AttackComponent::CombatMode::Melee);
-
-    bool const stationary = !anim.isMoving;
-    float const current_cooldown =
-        anim.isMelee ? attack->meleeCooldown : attack->cooldown;
-    bool const recently_fired =
-        attack->timeSinceLast < std::min(current_cooldown, 0.45F);
-    bool target_in_range = false;
-
-    if (ctx.world != nullptr) {
-      auto *target = ctx.world->getEntity(attack_target->target_id);
-      if (target != nullptr) {
-        auto *target_transform =
-            target->getComponent<Engine::Core::TransformComponent>();
-        if (target_transform != nullptr) {
-          float const dx = target_transform->position.x - transform->position.x;
-          float const dz = target_transform->position.z - transform->position.z;
-          float const dist_squared = dx * dx + dz * dz;
-          float target_radius = 0.0F;
-          if (target->hasComponent<Engine::Core::BuildingComponent>()) {
-            target_radius =
-                std::max(target_transform->scale.x, target_transform->scale.z) *
-                0.5F;
-          } else {
-            target_radius =
-                std::max(target_transform->scale.x, target_transform->scale.z) *
-                0.5F;
-          }
-          float const effective_range = attack->range + target_radius + 0.25F;
-          target_in_range = (dist_squared <= effective_range * effective_range);
-        }
-      }
+  return anim;
+}
+
+auto HumanoidRendererBase::gaitTable()
+    -> const std::array<GaitSample, GaitTableSize> & {
+  static const std::array<GaitSample, GaitTableSize> k_table = [] {
+    std::array<GaitSample, GaitTableSize> table{};
+    for (int i = 0; i < GaitTableSize; ++i) {
+      float const phase = float(i) / float(GaitTableSize);
+      float const lift = std::sin(phase * 2.0F * std::numbers::pi_v<float>);
+      table[i].lift = lift > 0.0F ? lift : 0.0F;
+      table[i].stride =
+          std::sin((phase - 0.25F) * 2.0F * std::numbers::pi_v<float>);
+      table[i].sway = std::sin(phase * 2.0F * std::numbers::pi_v<float>);
     }
+    return table;
+  }();
+  return k_table;
+}
 
-    anim.is_attacking = stationary && (target_in_range || recently_fired);
+auto HumanoidRendererBase::poseBasisFor(uint32_t seed) const -> PoseBasis {
+  const std::lock_guard<std::mutex> lock(m_cacheMutex);
+
+  auto it = m_poseBasisCache.find(seed);
+  if (it != m_poseBasisCache.end()) {
+    return it->second;
   }
 
-  return anim;
+  constexpr std::size_t k_max_cached_bases = 512;
+  if (m_poseBasisCache.size() > k_max_cached_bases) {
+    m_poseBasisCache.clear();
+  }
+
+  PoseBasis basis;
+  basis.variation = VariationParams::fromSeed(seed);
+  computeRestPose(seed, basis.variation, basis.restPose);
+  return m_poseBasisCache.emplace(seed, basis).first->second;
 }
 
-void HumanoidRendererBase::computeLocomotionPose(
-    uint32_t seed, float time, bool isMoving, const VariationParams &variation,
-    HumanoidPose &pose) {
+void HumanoidRendererBase::computeRestPose(uint32_t seed,
+                                           const VariationParams &variation,
+                                           HumanoidPose &pose) {
   using HP = HumanProportions;
 
   float const h_scale = variation.height_scale;
@@ -230,52 +205,56 @@ void HumanoidRendererBase::computeLocomotionPose(
       0.15F - arm_asymmetry * 0.5F,
       HP::SHOULDER_Y * h_scale + 0.15F + arm_height_jitter * 0.8F, 0.20F);
 
-  if (isMoving) {
+  QVector3D right_axis = pose.shoulderR - pose.shoulderL;
+  right_axis.setY(0.0F);
+  if (right_axis.lengthSquared() < 1e-8F) {
+    right_axis = QVector3D(1, 0, 0);
+  }
+  right_axis.normalize();
+  QVector3D const outward_l = -right_axis;
+  QVector3D const outward_r = right_axis;
 
-    float const walk_cycle_time = 0.8F / variation.walkSpeedMult;
-    float const walk_phase = std::fmod(time * (1.0F / walk_cycle_time), 1.0F);
-    float const left_phase = walk_phase;
-    float const right_phase = std::fmod(walk_phase + 0.5F, 1.0F);
+  pose.elbowL = elbowBendTorso(pose.shoulderL, pose.handL, outward_l, 0.45F,
+                               0.15F, -0.08F, +1.0F);
+  pose.elbowR = elbowBendTorso(pose.shoulderR, pose.hand_r, outward_r, 0.48F,
+                               0.12F, 0.02F, +1.0F);
+}
 
-    const float ground_y = HP::GROUND_Y;
+void HumanoidRendererBase::applyGaitOffsets(float time,
+                                            const VariationParams &variation,
+                                            HumanoidPose &pose) {
+  using HP = HumanProportions;
 
-    const float stride_length = 0.35F * variation.armSwingAmp;
+  float const walk_cycle_time = 0.8F / variation.walkSpeedMult;
+  float const walk_phase = std::fmod(time * (1.0F / walk_cycle_time), 1.0F);
 
-    auto animate_foot = [ground_y, &pose, stride_length](QVector3D &foot,
-                                                         float phase) {
-      float const lift = std::sin(phase * 2.0F * std::numbers::pi_v<float>);
-      if (lift > 0.0F) {
-        foot.setY(ground_y + pose.footYOffset + lift * 0.12F);
-      } else {
-        foot.setY(ground_y + pose.footYOffset);
-      }
-      foot.setZ(foot.z() +
-                std::sin((phase - 0.25F) * 2.0F * std::numbers::pi_v<float>) *
-                    stride_length);
-    };
+  const auto &table = gaitTable();
+  int const left_idx = int(walk_phase * GaitTableSize) & (GaitTableSize - 1);
+  int const right_idx = (left_idx + GaitTableSize / 2) & (GaitTableSize - 1);
 
-    animate_foot(pose.footL, left_phase);
-    animate_foot(pose.foot_r, right_phase);
+  const float ground_y = HP::GROUND_Y;
+  const float stride_length = 0.35F * variation.armSwingAmp;
 
-    float const hip_sway =
-        std::sin(walk_phase * 2.0F * std::numbers::pi_v<float>) * 0.02F *
-        variation.armSwingAmp;
-    pose.shoulderL.setX(pose.shoulderL.x() + hip_sway);
-    pose.shoulderR.setX(pose.shoulderR.x() + hip_sway);
-  }
+  pose.footL.setY(ground_y + pose.footYOffset + table[left_idx].lift * 0.12F);
+  pose.footL.setZ(pose.footL.z() + table[left_idx].stride * stride_length);
+  pose.foot_r.setY(ground_y + pose.footYOffset + table[right_idx].lift * 0.12F);
+  pose.foot_r.setZ(pose.foot_r.z() + table[right_idx].stride * stride_length);
+
+  float const hip_sway = table[left_idx].sway * 0.02F * variation.armSwingAmp;
+  pose.shoulderL.setX(pose.shoulderL.x() + hip_sway);
+  pose.shoulderR.setX(pose.shoulderR.x() + hip_sway);
 
+  // The sway moved the shoulders, so rebend the elbows off the new anchors.
   QVector3D right_axis = pose.shoulderR - pose.shoulderL;
   right_axis.setY(0.0F);
   if (right_axis.lengthSquared() < 1e-8F) {
     right_axis = QVector3D(1, 0, 0);
   }
   right_axis.normalize();
-  QVector3D const outward_l = -right_axis;
-  QVector3D const outward_r = right_axis;
 
-  pose.elbowL = elbowBendTorso(pose.shoulderL, pose.handL, outward_l, 0.45F,
+  pose.elbowL = elbowBendTorso(pose.shoulderL, pose.handL, -right_axis, 0.45F,
                                0.15F, -0.08F, +1.0F);
-  pose.elbowR = elbowBendTorso(pose.shoulderR, pose.hand_r, outward_r, 0.48F,
+  pose.elbowR = elbowBendTorso(pose.shoulderR, pose.hand_r, right_axis, 0.48F,
                                0.12F, 0.02F, +1.0F);
 }
 
@@ -312,6 +291,29 @@ void HumanoidRendererBase::drawCommonBody(const DrawContext &ctx,
            cylinderBetween(ctx.model, tunic_top, tunic_bot, torso_r),
            v.palette.cloth, nullptr, 1.0F);
 
+  if (ctx.lod == LodTier::Minimal) {
+    // Silhouette tier: head and one capsule per leg on top of the torso.
+    // Eyes, arms, feet and helmet detail are invisible at this range and
+    // only cost submissions.
+    out.mesh(getUnitSphere(),
+             sphereAt(ctx.model, pose.headPos, pose.headR * head_scale),
+             v.palette.skin, nullptr, 1.0F);
+
+    const float leg_half = HP::UPPER_LEG_R * width_scale * 1.7F;
+    const float leg_r = HP::UPPER_LEG_R * 1.40F * 3.0F * width_scale;
+    out.mesh(getUnitCapsule(DefaultCapsuleSegments, 1),
+             Render::Geom::capsuleBetween(
+                 ctx.model, pose.pelvisPos + QVector3D(-leg_half, 0.F, 0.F),
+                 pose.footL, leg_r),
+             v.palette.leather, nullptr, 1.0F);
+    out.mesh(getUnitCapsule(DefaultCapsuleSegments, 1),
+             Render::Geom::capsuleBetween(
+                 ctx.model, pose.pelvisPos + QVector3D(+leg_half, 0.F, 0.F),
+                 pose.foot_r, leg_r),
+             v.palette.leather, nullptr, 1.0F);
+    return;
+  }
+
   QVector3D const chin_pos{0.0F, pose.headPos.y() - pose.headR, 0.0F};
   out.mesh(getUnitCylinder(),
            cylinderBetween(ctx.model, pose.neck_base, chin_pos,
@@ -322,29 +324,35 @@ void HumanoidRendererBase::drawCommonBody(const DrawContext &ctx,
            sphereAt(ctx.model, pose.headPos, pose.headR * head_scale),
            v.palette.skin, nullptr, 1.0F);
 
-  QVector3D const iris(0.06F, 0.06F, 0.07F);
-  float const eyeZ = pose.headR * head_scale * 0.7F;
-  float const eyeY = pose.headPos.y() + pose.headR * head_scale * 0.1F;
-  float const eye_spacing = pose.headR * head_scale * 0.35F;
-  out.mesh(getUnitSphere(),
-           ctx.model * sphereAt(QVector3D(-eye_spacing, eyeY, eyeZ),
-                                pose.headR * head_scale * 0.15F),
-           iris, nullptr, 1.0F);
-  out.mesh(getUnitSphere(),
-           ctx.model * sphereAt(QVector3D(eye_spacing, eyeY, eyeZ),
-                                pose.headR * head_scale * 0.15F),
-           iris, nullptr, 1.0F);
+  if (ctx.lod == LodTier::Full) {
+    QVector3D const iris(0.06F, 0.06F, 0.07F);
+    float const eyeZ = pose.headR * head_scale * 0.7F;
+    float const eyeY = pose.headPos.y() + pose.headR * head_scale * 0.1F;
+    float const eye_spacing = pose.headR * head_scale * 0.35F;
+    out.mesh(getUnitSphere(),
+             ctx.model * sphereAt(QVector3D(-eye_spacing, eyeY, eyeZ),
+                                  pose.headR * head_scale * 0.15F),
+             iris, nullptr, 1.0F);
+    out.mesh(getUnitSphere(),
+             ctx.model * sphereAt(QVector3D(eye_spacing, eyeY, eyeZ),
+                                  pose.headR * head_scale * 0.15F),
+             iris, nullptr, 1.0F);
+  }
 
   const float upper_arm_r = HP::UPPER_ARM_R * width_scale;
   const float fore_arm_r = HP::FORE_ARM_R * width_scale;
   const float joint_r = HP::HAND_RADIUS * width_scale * 1.05F;
   const float hand_r = HP::HAND_RADIUS * width_scale * 0.95F;
 
+  bool const full_detail = (ctx.lod == LodTier::Full);
+
   out.mesh(getUnitCylinder(),
            cylinderBetween(ctx.model, pose.shoulderL, pose.elbowL, upper_arm_r),
            v.palette.cloth, nullptr, 1.0F);
-  out.mesh(getUnitSphere(), sphereAt(ctx.model, pose.elbowL, joint_r),
-           v.palette.cloth * 0.95F, nullptr, 1.0F);
+  if (full_detail) {
+    out.mesh(getUnitSphere(), sphereAt(ctx.model, pose.elbowL, joint_r),
+             v.palette.cloth * 0.95F, nullptr, 1.0F);
+  }
   out.mesh(getUnitCylinder(),
            cylinderBetween(ctx.model, pose.elbowL, pose.handL, fore_arm_r),
            v.palette.skin * 0.95F, nullptr, 1.0F);
@@ -354,8 +362,10 @@ void HumanoidRendererBase::drawCommonBody(const DrawContext &ctx,
   out.mesh(getUnitCylinder(),
            cylinderBetween(ctx.model, pose.shoulderR, pose.elbowR, upper_arm_r),
            v.palette.cloth, nullptr, 1.0F);
-  out.mesh(getUnitSphere(), sphereAt(ctx.model, pose.elbowR, joint_r),
-           v.palette.cloth * 0.95F, nullptr, 1.0F);
+  if (full_detail) {
+    out.mesh(getUnitSphere(), sphereAt(ctx.model, pose.elbowR, joint_r),
+             v.palette.cloth * 0.95F, nullptr, 1.0F);
+  }
   out.mesh(getUnitCylinder(),
            cylinderBetween(ctx.model, pose.elbowR, pose.hand_r, fore_arm_r),
            v.palette.skin * 0.95F, nullptr, 1.0F);
@@ -402,10 +412,13 @@ void HumanoidRendererBase::drawCommonBody(const DrawContext &ctx,
   const float ankle_up_frac = 0.50F;
   const float toe_splay_frac = 0.06F;
 
-  const QVector3D fwdL = rotY(FWD, -yaw_out_deg * DEG);
-  const QVector3D fwdR = rotY(FWD, +yaw_out_deg * DEG);
-  const QVector3D right_l = rightOf(fwdL);
-  const QVector3D right_r = rightOf(fwdR);
+  // The outward foot yaw is a fixed style constant, so its rotated basis
+  // vectors are identical for every individual; bake them once instead
+  // of paying four trig calls per body per frame.
+  static const QVector3D fwdL = rotY(FWD, -yaw_out_deg * DEG);
+  static const QVector3D fwdR = rotY(FWD, +yaw_out_deg * DEG);
+  static const QVector3D right_l = rightOf(fwdL);
+  static const QVector3D right_r = rightOf(fwdR);
 
   const float foot_cly_l = plant_l.y() + foot_r;
   const float foot_cly_r = plant_r.y() + foot_r;
@@ -487,19 +500,23 @@ void HumanoidRendererBase::drawCommonBody(const DrawContext &ctx,
       Render::Geom::capsuleBetween(ctx.model, heel_cen_r, ball_r, heel_rad),
       v.palette.leatherDark, nullptr, 1.0F);
 
-  out.mesh(getUnitCapsule(DefaultCapsuleSegments, 1),
-           Render::Geom::capsuleBetween(ctx.model, ball_l, toeL, toe_rad),
-           v.palette.leatherDark, nullptr, 1.0F);
-  out.mesh(getUnitCapsule(DefaultCapsuleSegments, 1),
-           Render::Geom::capsuleBetween(ctx.model, ball_r, toeR, toe_rad),
-           v.palette.leatherDark, nullptr, 1.0F);
+  if (full_detail) {
+    out.mesh(getUnitCapsule(DefaultCapsuleSegments, 1),
+             Render::Geom::capsuleBetween(ctx.model, ball_l, toeL, toe_rad),
+             v.palette.leatherDark, nullptr, 1.0F);
+    out.mesh(getUnitCapsule(DefaultCapsuleSegments, 1),
+             Render::Geom::capsuleBetween(ctx.model, ball_r, toeR, toe_rad),
+             v.palette.leatherDark, nullptr, 1.0F);
+  }
 
   drawHelmet(ctx, v, pose, out);
 
   draw_armorOverlay(ctx, v, pose, y_top_cover, torso_r, shoulder_half_span,
                     upper_arm_r, right_axis, out);
 
-  drawShoulderDecorations(ctx, v, pose, y_top_cover, y_neck, right_axis, out);
+  if (full_detail) {
+    drawShoulderDecorations(ctx, v, pose, y_top_cover, y_neck, right_axis, out);
+  }
 }
 
 void HumanoidRendererBase::drawHelmet(const DrawContext &ctx,
@@ -528,17 +545,12 @@ void HumanoidRendererBase::render(const DrawContext &ctx,
   FormationParams const formation = resolveFormation(ctx);
   AnimationInputs const anim = sampleAnimState(ctx);
 
-  Engine::Core::UnitComponent *unit_comp = nullptr;
-  if (ctx.entity != nullptr) {
-    unit_comp = ctx.entity->getComponent<Engine::Core::UnitComponent>();
-  }
-
   uint32_t seed = 0U;
-  if (unit_comp != nullptr) {
-    seed ^= uint32_t(unit_comp->owner_id * 2654435761U);
-  }
-  if (ctx.entity != nullptr) {
-    seed ^= uint32_t(reinterpret_cast<uintptr_t>(ctx.entity) & 0xFFFFFFFFU);
+  if (ctx.snap != nullptr) {
+    if (ctx.snap->hasUnit) {
+      seed ^= uint32_t(ctx.snap->ownerId * 2654435761U);
+    }
+    seed ^= uint32_t(ctx.snap->id);
   }
 
   const int rows =
@@ -547,20 +559,24 @@ void HumanoidRendererBase::render(const DrawContext &ctx,
   const int cols = formation.max_per_row;
 
   int visible_count = rows * cols;
-  if (unit_comp != nullptr) {
-    int const mh = std::max(1, unit_comp->max_health);
-    float const ratio = std::clamp(unit_comp->health / float(mh), 0.0F, 1.0F);
+  if ((ctx.snap != nullptr) && ctx.snap->hasUnit) {
+    int const mh = std::max(1, ctx.snap->maxHealth);
+    float const ratio = std::clamp(ctx.snap->health / float(mh), 0.0F, 1.0F);
     visible_count = std::max(1, (int)std::ceil(ratio * float(rows * cols)));
   }
 
   HumanoidVariant variant;
   getVariant(ctx, seed, variant);
 
-  if (!m_proportionScaleCached) {
-    m_cachedProportionScale = getProportionScaling();
-    m_proportionScaleCached = true;
+  QVector3D prop_scale;
+  {
+    const std::lock_guard<std::mutex> lock(m_cacheMutex);
+    if (!m_proportionScaleCached) {
+      m_cachedProportionScale = getProportionScaling();
+      m_proportionScaleCached = true;
+    }
+    prop_scale = m_cachedProportionScale;
   }
-  const QVector3D prop_scale = m_cachedProportionScale;
   const float height_scale = prop_scale.y();
   const bool needs_height_scaling = std::abs(height_scale - 1.0F) > 0.001F;
 
@@ -591,31 +607,26 @@ void HumanoidRendererBase::render(const DrawContext &ctx,
     offset_z += pos_jitter_z;
 
     QMatrix4x4 inst_model;
-    if (ctx.entity != nullptr) {
-      if (auto *entT =
-              ctx.entity->getComponent<Engine::Core::TransformComponent>()) {
-        QMatrix4x4 M = k_identity_matrix;
-        M.translate(entT->position.x, entT->position.y, entT->position.z);
-        float const base_yaw = entT->rotation.y;
-        float const applied_yaw = base_yaw + yaw_offset;
-        M.rotate(applied_yaw, 0.0F, 1.0F, 0.0F);
-        M.scale(entT->scale.x, entT->scale.y, entT->scale.z);
-        M.translate(offset_x, vertical_jitter, offset_z);
-        inst_model = M;
-      } else {
-        inst_model = ctx.model;
-        inst_model.rotate(yaw_offset, 0.0F, 1.0F, 0.0F);
-        inst_model.translate(offset_x, vertical_jitter, offset_z);
-      }
+    if (ctx.snap != nullptr) {
+      QMatrix4x4 M = k_identity_matrix;
+      M.translate(ctx.snap->position);
+      float const base_yaw = ctx.snap->yawDeg;
+      float const applied_yaw = base_yaw + yaw_offset;
+      M.rotate(applied_yaw, 0.0F, 1.0F, 0.0F);
+      M.scale(ctx.snap->scale);
+      M.translate(offset_x, vertical_jitter, offset_z);
+      inst_model = M;
     } else {
       inst_model = ctx.model;
       inst_model.rotate(yaw_offset, 0.0F, 1.0F, 0.0F);
       inst_model.translate(offset_x, vertical_jitter, offset_z);
     }
 
-    DrawContext inst_ctx{ctx.resources, ctx.entity, ctx.world, inst_model};
+    DrawContext inst_ctx{ctx.resources, ctx.snap, inst_model};
+    inst_ctx.lod = ctx.lod;
 
-    VariationParams const variation = VariationParams::fromSeed(inst_seed);
+    const PoseBasis basis = poseBasisFor(inst_seed);
+    const VariationParams &variation = basis.variation;
 
     float const combined_height_scale = height_scale * variation.height_scale;
     if (needs_height_scaling ||
@@ -625,15 +636,19 @@ void HumanoidRendererBase::render(const DrawContext &ctx,
       inst_ctx.model = inst_ctx.model * scale_matrix;
     }
 
-    HumanoidPose pose;
-    computeLocomotionPose(inst_seed, anim.time + phase_offset, anim.isMoving,
-                          variation, pose);
+    HumanoidPose pose = basis.restPose;
+    if (anim.isMoving) {
+      applyGaitOffsets(anim.time + phase_offset, variation, pose);
+    }
 
     customizePose(inst_ctx, anim, inst_seed, pose);
 
     drawCommonBody(inst_ctx, variant, pose, out);
 
-    addAttachments(inst_ctx, variant, pose, anim, out);
+    // Weapons and shields are unreadable at silhouette range.
+    if (inst_ctx.lod != LodTier::Minimal) {
+      addAttachments(inst_ctx, variant, pose, anim, out);
+    }
   }
 }
 
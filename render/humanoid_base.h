@@ -4,12 +4,10 @@
 #include "humanoid_specs.h"
 #include "palette.h"
 #include <QVector3D>
+#include <array>
 #include <cstdint>
-
-namespace Engine::Core {
-class Entity;
-class World;
-} // namespace Engine::Core
+#include <mutex>
+#include <unordered_map>
 
 namespace Render::GL {
 
@@ -122,11 +120,43 @@ protected:
   mutable QVector3D m_cachedProportionScale;
   mutable bool m_proportionScaleCached = false;
 
+  // Everything about an individual that depends only on its seed: the
+  // variation parameters and the standing pose they produce. Baked once per
+  // seed so the per-frame loop only has to layer gait offsets on top.
+  struct PoseBasis {
+    VariationParams variation;
+    HumanoidPose restPose;
+  };
+
+  // One sample of the walk cycle with unit amplitudes; scaled by each
+  // instance's VariationParams when applied.
+  struct GaitSample {
+    float lift;
+    float stride;
+    float sway;
+  };
+
+  static constexpr int GaitTableSize = 64;
+
+  // One renderer instance serves every entity of its type, and parallel
+  // submission renders entities from several worker threads at once, so
+  // both lazy caches below are guarded by m_cacheMutex.
+  mutable std::mutex m_cacheMutex;
+  mutable std::unordered_map<uint32_t, PoseBasis> m_poseBasisCache;
+
+  // Returns by value: the cache can be cleared on overflow while another
+  // worker is still using its result.
+  auto poseBasisFor(uint32_t seed) const -> PoseBasis;
+
   static auto resolveFormation(const DrawContext &ctx) -> FormationParams;
 
-  static void computeLocomotionPose(uint32_t seed, float time, bool isMoving,
-                                    const VariationParams &variation,
-                                    HumanoidPose &ioPose);
+  static auto gaitTable() -> const std::array<GaitSample, GaitTableSize> &;
+
+  static void computeRestPose(uint32_t seed, const VariationParams &variation,
+                              HumanoidPose &ioPose);
+
+  static void applyGaitOffsets(float time, const VariationParams &variation,
+                               HumanoidPose &ioPose);
 
   static auto sampleAnimState(const DrawContext &ctx) -> AnimationInputs;
 
@@ -4,6 +4,14 @@
 
 namespace Render::GL {
 
+void sinCosBatch(const float *angles, float *sines, float *cosines,
+                 int count) {
+  for (int i = 0; i < count; ++i) {
+    sines[i] = fastSin(angles[i]);
+    cosines[i] = fastCos(angles[i]);
+  }
+}
+
 auto elbowBendTorso(const QVector3D &shoulder, const QVector3D &hand,
                     const QVector3D &outwardDir, float alongFrac,
                     float lateral_offset, float yBias,
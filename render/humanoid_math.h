@@ -4,6 +4,7 @@
 #include <QVector3D>
 #include <cmath>
 #include <cstdint>
+#include <numbers>
 
 namespace Render::GL {
 
@@ -25,6 +26,38 @@ inline auto rightOf(const QVector3D &fwd) -> QVector3D {
   return QVector3D::crossProduct(UP, fwd).normalized();
 }
 
+// Refined-parabola sine approximation, accurate to about 1e-3 over the
+// full range — plenty for limb and decoration angles. Branch-free with
+// no libm call, so loops over many individuals stay in registers and
+// auto-vectorize.
+inline auto fastSin(float angle_rad) -> float {
+  constexpr float k_pi = std::numbers::pi_v<float>;
+  constexpr float k_two_pi = 2.0F * k_pi;
+  constexpr float k_inv_two_pi = 1.0F / k_two_pi;
+  constexpr float k_b = 4.0F / k_pi;
+  constexpr float k_c = -4.0F / (k_pi * k_pi);
+  constexpr float k_p = 0.225F;
+  float const wrapped =
+      angle_rad - k_two_pi * std::floor(angle_rad * k_inv_two_pi + 0.5F);
+  float const y = k_b * wrapped + k_c * wrapped * std::abs(wrapped);
+  return k_p * (y * std::abs(y) - y) + y;
+}
+
+inline auto fastCos(float angle_rad) -> float {
+  return fastSin(angle_rad + 0.5F * std::numbers::pi_v<float>);
+}
+
+inline void fastSinCos(float angle_rad, float &outSin, float &outCos) {
+  outSin = fastSin(angle_rad);
+  outCos = fastCos(angle_rad);
+}
+
+// SoA batch form: evaluates sin and cos for `count` angles into parallel
+// output arrays. The humanoid renderers fill an angle array per
+// decoration ring or limb set and evaluate it in one pass, which the
+// compiler vectorizes, instead of a libm round trip per joint.
+void sinCosBatch(const float *angles, float *sines, float *cosines, int count);
+
 auto elbowBendTorso(const QVector3D &shoulder, const QVector3D &hand,
                     const QVector3D &outwardDir, float alongFrac,
                     float lateral_offset, float yBias,
@@ -4,6 +4,12 @@
 #include <array>
 #include <cmath>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace Render::Math {
 
 struct alignas(16) Vec3 {
@@ -98,6 +104,29 @@ struct alignas(16) Mat3x4 {
 
   auto operator*(const Mat3x4 &o) const noexcept -> Mat3x4 {
     Mat3x4 result;
+#if defined(__SSE2__)
+    const __m128 o0 = _mm_load_ps(o.m[0].data());
+    const __m128 o1 = _mm_load_ps(o.m[1].data());
+    const __m128 o2 = _mm_load_ps(o.m[2].data());
+    for (int row = 0; row < 3; ++row) {
+      __m128 acc = _mm_mul_ps(_mm_set1_ps(m[row][0]), o0);
+      acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(m[row][1]), o1));
+      acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(m[row][2]), o2));
+      acc = _mm_add_ps(acc, _mm_set_ps(m[row][3], 0.0F, 0.0F, 0.0F));
+      _mm_store_ps(result.m[row].data(), acc);
+    }
+#elif defined(__ARM_NEON)
+    const float32x4_t o0 = vld1q_f32(o.m[0].data());
+    const float32x4_t o1 = vld1q_f32(o.m[1].data());
+    const float32x4_t o2 = vld1q_f32(o.m[2].data());
+    for (int row = 0; row < 3; ++row) {
+      float32x4_t acc = vmulq_n_f32(o0, m[row][0]);
+      acc = vmlaq_n_f32(acc, o1, m[row][1]);
+      acc = vmlaq_n_f32(acc, o2, m[row][2]);
+      acc = vsetq_lane_f32(vgetq_lane_f32(acc, 3) + m[row][3], acc, 3);
+      vst1q_f32(result.m[row].data(), acc);
+    }
+#else
     for (int row = 0; row < 3; ++row) {
       for (int col = 0; col < 3; ++col) {
         result.m[row][col] = m[row][0] * o.m[0][col] + m[row][1] * o.m[1][col] +
@@ -106,6 +135,7 @@ struct alignas(16) Mat3x4 {
       result.m[row][3] = m[row][0] * o.m[0][3] + m[row][1] * o.m[1][3] +
                          m[row][2] * o.m[2][3] + m[row][3];
     }
+#endif
     return result;
   }
 
@@ -120,6 +150,95 @@ struct alignas(16) Mat3x4 {
   }
 };
 
+struct alignas(16) Vec4 {
+  float x, y, z, w;
+
+  Vec4() noexcept : x(0), y(0), z(0), w(0) {}
+  Vec4(float x_, float y_, float z_, float w_) noexcept
+      : x(x_), y(y_), z(z_), w(w_) {}
+};
+
+// Column-major 4x4 with the same memory layout as QMatrix4x4::constData(),
+// so frame code can compose matrices here and copy straight into a command
+// or a uniform upload without a transpose pass.
+struct alignas(16) Mat4 {
+  std::array<float, 16> c{};
+
+  Mat4() noexcept { c[0] = c[5] = c[10] = c[15] = 1.0F; }
+
+  static auto fromColumnMajor(const float *values) noexcept -> Mat4 {
+    Mat4 result;
+    std::copy(values, values + 16, result.c.begin());
+    return result;
+  }
+
+  [[nodiscard]] auto data() const noexcept -> const float * {
+    return c.data();
+  }
+};
+
+// Promotes an affine Mat3x4 (row-major rows) to a full column-major Mat4
+// with an implicit (0, 0, 0, 1) bottom row.
+inline auto toMat4(const Mat3x4 &a) noexcept -> Mat4 {
+  Mat4 result;
+  for (int row = 0; row < 3; ++row) {
+    for (int col = 0; col < 4; ++col) {
+      result.c[(col * 4) + row] = a.m[row][col];
+    }
+  }
+  result.c[3] = result.c[7] = result.c[11] = 0.0F;
+  result.c[15] = 1.0F;
+  return result;
+}
+
+inline auto mul(const Mat4 &a, const Mat4 &b) noexcept -> Mat4 {
+  Mat4 result;
+#if defined(__SSE2__)
+  const __m128 a0 = _mm_load_ps(&a.c[0]);
+  const __m128 a1 = _mm_load_ps(&a.c[4]);
+  const __m128 a2 = _mm_load_ps(&a.c[8]);
+  const __m128 a3 = _mm_load_ps(&a.c[12]);
+  for (int col = 0; col < 4; ++col) {
+    const float *bc = &b.c[col * 4];
+    __m128 acc = _mm_mul_ps(a0, _mm_set1_ps(bc[0]));
+    acc = _mm_add_ps(acc, _mm_mul_ps(a1, _mm_set1_ps(bc[1])));
+    acc = _mm_add_ps(acc, _mm_mul_ps(a2, _mm_set1_ps(bc[2])));
+    acc = _mm_add_ps(acc, _mm_mul_ps(a3, _mm_set1_ps(bc[3])));
+    _mm_store_ps(&result.c[col * 4], acc);
+  }
+#elif defined(__ARM_NEON)
+  const float32x4_t a0 = vld1q_f32(&a.c[0]);
+  const float32x4_t a1 = vld1q_f32(&a.c[4]);
+  const float32x4_t a2 = vld1q_f32(&a.c[8]);
+  const float32x4_t a3 = vld1q_f32(&a.c[12]);
+  for (int col = 0; col < 4; ++col) {
+    const float *bc = &b.c[col * 4];
+    float32x4_t acc = vmulq_n_f32(a0, bc[0]);
+    acc = vmlaq_n_f32(acc, a1, bc[1]);
+    acc = vmlaq_n_f32(acc, a2, bc[2]);
+    acc = vmlaq_n_f32(acc, a3, bc[3]);
+    vst1q_f32(&result.c[col * 4], acc);
+  }
+#else
+  for (int col = 0; col < 4; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      result.c[(col * 4) + row] = a.c[row] * b.c[col * 4] +
+                                  a.c[4 + row] * b.c[(col * 4) + 1] +
+                                  a.c[8 + row] * b.c[(col * 4) + 2] +
+                                  a.c[12 + row] * b.c[(col * 4) + 3];
+    }
+  }
+#endif
+  return result;
+}
+
+inline auto transform(const Mat4 &m, const Vec4 &v) noexcept -> Vec4 {
+  return {m.c[0] * v.x + m.c[4] * v.y + m.c[8] * v.z + m.c[12] * v.w,
+          m.c[1] * v.x + m.c[5] * v.y + m.c[9] * v.z + m.c[13] * v.w,
+          m.c[2] * v.x + m.c[6] * v.y + m.c[10] * v.z + m.c[14] * v.w,
+          m.c[3] * v.x + m.c[7] * v.y + m.c[11] * v.z + m.c[15] * v.w};
+}
+
 struct CylinderTransform {
   Vec3 center;
   Vec3 axis;
@@ -1,8 +1,10 @@
 #include "palette.h"
 #include "geom/math_utils.h"
 #include "humanoid_math.h"
+#include <bit>
 #include <cstdint>
 #include <qvectornd.h>
+#include <unordered_map>
 
 namespace Render::GL {
 
@@ -39,4 +41,20 @@ auto makeHumanoidPalette(const QVector3D &team_tint,
   return p;
 }
 
+auto cachedHumanoidPalette(const QVector3D &team_tint,
+                           uint32_t seed) -> const HumanoidPalette & {
+  thread_local std::unordered_map<uint64_t, HumanoidPalette> cache;
+
+  uint64_t key = seed;
+  key = key * 0x9E3779B97F4A7C15ULL + std::bit_cast<uint32_t>(team_tint.x());
+  key = key * 0x9E3779B97F4A7C15ULL + std::bit_cast<uint32_t>(team_tint.y());
+  key = key * 0x9E3779B97F4A7C15ULL + std::bit_cast<uint32_t>(team_tint.z());
+
+  auto it = cache.find(key);
+  if (it == cache.end()) {
+    it = cache.emplace(key, makeHumanoidPalette(team_tint, seed)).first;
+  }
+  return it->second;
+}
+
 } // namespace Render::GL
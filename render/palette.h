@@ -17,4 +17,12 @@ struct HumanoidPalette {
 auto makeHumanoidPalette(const QVector3D &team_tint,
                          uint32_t seed) -> HumanoidPalette;
 
+// Memoized variant of makeHumanoidPalette. Palettes are pure functions
+// of (tint, seed) and the same handful of team tints recurs for every
+// individual every frame, so renderers should prefer this over deriving
+// the palette inline. The cache is thread-local: entity submission runs
+// on worker threads and this keeps the lookup lock-free.
+auto cachedHumanoidPalette(const QVector3D &team_tint,
+                           uint32_t seed) -> const HumanoidPalette &;
+
 } // namespace Render::GL
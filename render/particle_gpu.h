@@ -0,0 +1,24 @@
+#pragma once
+
+#include <QVector4D>
+
+namespace Render::GL {
+
+// One burst particle, written once at spawn and never touched again: the
+// vertex shader reconstructs the particle's position, size and fade
+// analytically from these fields and the shared frame clock, so a live
+// particle costs no CPU work and no upload after its spawn frame.
+struct ParticleInstanceGpu {
+  QVector4D origin_spawn; // xyz: spawn position, w: spawn time (seconds)
+  QVector4D velocity_life; // xyz: initial velocity, w: lifetime (seconds)
+  QVector4D color_size;    // rgb: color, w: base quad size
+  QVector4D misc;          // x: gravity scale, y: seed, zw: unused
+};
+
+struct ParticleBatchParams {
+  static constexpr float kDefaultGravity = 7.5F;
+
+  float gravity = kDefaultGravity;
+};
+
+} // namespace Render::GL
@@ -0,0 +1,121 @@
+#include "particle_system.h"
+#include "gl/buffer.h"
+#include "ground/ground_utils.h"
+#include "scene_renderer.h"
+#include <QVector4D>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <qvectornd.h>
+
+namespace {
+
+using namespace Render::Ground;
+
+// 4096 slots outlast any realistic burst rate: at the clamped per-burst
+// maximum the cursor needs hundreds of bursts to wrap, far longer than
+// the longest particle lifetime.
+constexpr std::size_t k_pool_capacity = 4096;
+constexpr int k_max_burst_count = 256;
+
+} // namespace
+
+namespace Render::GL {
+
+ParticleSystem::ParticleSystem() : m_pool(k_pool_capacity) {}
+
+ParticleSystem::~ParticleSystem() = default;
+
+void ParticleSystem::spawnBurst(const QVector3D &origin, const BurstDesc &desc,
+                                float now) {
+  int const count = std::clamp(desc.count, 0, k_max_burst_count);
+  if (count == 0) {
+    return;
+  }
+
+  std::size_t const first = m_cursor % k_pool_capacity;
+
+  for (int i = 0; i < count; ++i) {
+    std::size_t const slot = (first + static_cast<std::size_t>(i)) %
+                             k_pool_capacity;
+
+    // Uniform direction on the sphere from two uniform samples.
+    float const u = rand_01(m_rngState) * 2.0F - 1.0F;
+    float const azimuth = rand_01(m_rngState) * MathConstants::k_two_pi;
+    float const ring = std::sqrt(std::max(0.0F, 1.0F - u * u));
+    QVector3D const direction(ring * std::cos(azimuth), u,
+                              ring * std::sin(azimuth));
+
+    float const speed = desc.speed * remap(rand_01(m_rngState), 0.6F, 1.4F);
+    float const life =
+        std::max(0.05F, desc.life * remap(rand_01(m_rngState), 0.75F, 1.25F));
+
+    ParticleInstanceGpu &particle = m_pool[slot];
+    particle.origin_spawn = QVector4D(origin.x(), origin.y(), origin.z(), now);
+    QVector3D const velocity = direction * speed + desc.velocityBias;
+    particle.velocity_life =
+        QVector4D(velocity.x(), velocity.y(), velocity.z(), life);
+    particle.color_size = QVector4D(desc.color.x(), desc.color.y(),
+                                    desc.color.z(), desc.size);
+    particle.misc =
+        QVector4D(desc.gravityScale, rand_01(m_rngState), 0.0F, 0.0F);
+
+    m_latestExpiry = std::max(m_latestExpiry, now + life);
+  }
+
+  // A burst that wraps the ring splits into a tail range and a head range
+  // so each upload stays contiguous. Back-to-back spawns land on adjacent
+  // ring slots, so an adjoining range extends the previous one instead of
+  // adding another: a frame of per-arrow trail points flushes as a single
+  // setSubData no matter how many arrows are in flight.
+  auto const total = static_cast<std::size_t>(count);
+  std::size_t const tail = std::min(total, k_pool_capacity - first);
+  if (!m_dirtyRanges.empty() &&
+      m_dirtyRanges.back().first + m_dirtyRanges.back().count == first) {
+    m_dirtyRanges.back().count += tail;
+  } else {
+    m_dirtyRanges.push_back({first, tail});
+  }
+  if (tail < total) {
+    m_dirtyRanges.push_back({0, total - tail});
+  }
+
+  m_cursor += total;
+  m_highWater = std::min(std::max(m_highWater, first + tail), k_pool_capacity);
+  if (tail < total || m_cursor >= k_pool_capacity) {
+    m_highWater = k_pool_capacity;
+  }
+}
+
+void ParticleSystem::flush(Renderer &renderer) {
+  const bool anything_alive = renderer.getAnimationTime() < m_latestExpiry;
+  if (!anything_alive && m_dirtyRanges.empty()) {
+    return;
+  }
+
+  if (!m_instanceBuffer) {
+    m_instanceBuffer = std::make_unique<Buffer>(Buffer::Type::Vertex);
+  }
+
+  if (!m_bufferAllocated) {
+    // First spawn allocates the whole pool once; zeroed slots carry a
+    // zero lifetime, which the shader treats as dead.
+    m_instanceBuffer->setData(m_pool, Buffer::Usage::Dynamic);
+    m_bufferAllocated = true;
+  } else {
+    for (const auto &range : m_dirtyRanges) {
+      m_instanceBuffer->setSubData(
+          m_pool.data() + range.first,
+          range.first * sizeof(ParticleInstanceGpu),
+          range.count * sizeof(ParticleInstanceGpu));
+    }
+  }
+  m_dirtyRanges.clear();
+
+  if (m_highWater != 0) {
+    renderer.particleBatch(m_instanceBuffer.get(), m_highWater, m_params);
+  }
+}
+
+} // namespace Render::GL
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "particle_gpu.h"
+#include <QVector3D>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Render::GL {
+
+class Buffer;
+class Renderer;
+
+// Pooled emitter for short-lived burst effects (arrow impacts, fire
+// embers, future hit sparks). Particles are simulated entirely on the
+// GPU: spawnBurst writes each particle's record once into a fixed-size
+// pool, flush uploads only the slots touched since the last frame, and
+// the particle vertex shader integrates position and fade analytically
+// from the frame clock. A burst therefore costs CPU and bandwidth only
+// on its spawn frame; thousands of live particles are one instanced
+// draw with zero per-frame CPU work.
+//
+// Slots are recycled ring-fashion: the pool is sized so the oldest slot
+// has long expired before the cursor wraps back onto it. All calls must
+// come from the render thread, like every other submission path.
+class ParticleSystem {
+public:
+  struct BurstDesc {
+    int count = 8;
+    float speed = 2.0F;       // mean initial speed; jittered per particle
+    float life = 0.6F;        // mean lifetime in seconds
+    float size = 0.12F;       // base quad size in world units
+    float gravityScale = 1.0F; // multiplier on the shared gravity uniform
+    QVector3D velocityBias;   // added to every particle's velocity
+    QVector3D color{1.0F, 1.0F, 1.0F};
+  };
+
+  ParticleSystem();
+  ~ParticleSystem();
+
+  // Writes `desc.count` particle records at the ring cursor, directions
+  // drawn uniformly over the sphere and skewed by velocityBias. `now` is
+  // the renderer's animation clock, which the shader ages against.
+  void spawnBurst(const QVector3D &origin, const BurstDesc &desc, float now);
+
+  // Uploads the slots written since the last flush and submits one batch
+  // covering the live span of the pool. Skips the submit entirely once
+  // every particle has expired.
+  void flush(Renderer &renderer);
+
+private:
+  struct DirtyRange {
+    std::size_t first = 0;
+    std::size_t count = 0;
+  };
+
+  std::vector<ParticleInstanceGpu> m_pool;
+  std::vector<DirtyRange> m_dirtyRanges;
+  std::unique_ptr<Buffer> m_instanceBuffer;
+  std::size_t m_cursor = 0;
+  std::size_t m_highWater = 0;
+  float m_latestExpiry = 0.0F;
+  bool m_bufferAllocated = false;
+  std::uint32_t m_rngState = 0x51A7E9B3U;
+  ParticleBatchParams m_params;
+};
+
+} // namespace Render::GL
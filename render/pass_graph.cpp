@@ -0,0 +1,135 @@
+#include "pass_graph.h"
+#include <QDebug>
+#include <algorithm>
+
+namespace Render::GL {
+
+void PassGraph::addPass(std::string name, IRenderPass *pass,
+                        std::vector<std::string> inputs,
+                        std::vector<std::string> outputs, RunPolicy policy) {
+  if (pass == nullptr) {
+    return;
+  }
+  Node node;
+  node.name = std::move(name);
+  node.pass = pass;
+  node.inputs = std::move(inputs);
+  node.outputs = std::move(outputs);
+  node.policy = policy;
+  m_nodes.push_back(std::move(node));
+  m_orderDirty = true;
+}
+
+void PassGraph::invalidateResource(const std::string &name) {
+  ++m_versions[name];
+}
+
+auto PassGraph::resourceVersion(const std::string &name) const
+    -> std::uint64_t {
+  auto it = m_versions.find(name);
+  return (it != m_versions.end()) ? it->second : 0;
+}
+
+void PassGraph::rebuildOrderIfNeeded() {
+  if (!m_orderDirty) {
+    return;
+  }
+  m_orderDirty = false;
+  m_order.clear();
+  m_order.reserve(m_nodes.size());
+
+  // Map each resource to its producers, then run a Kahn walk that always
+  // picks the ready node registered earliest, so independent passes keep
+  // their registration order.
+  std::unordered_map<std::string, std::vector<std::size_t>> producers;
+  for (std::size_t i = 0; i < m_nodes.size(); ++i) {
+    for (const auto &out : m_nodes[i].outputs) {
+      producers[out].push_back(i);
+    }
+  }
+
+  std::vector<std::size_t> pending_inputs(m_nodes.size(), 0);
+  std::vector<std::vector<std::size_t>> consumers(m_nodes.size());
+  for (std::size_t i = 0; i < m_nodes.size(); ++i) {
+    for (const auto &input : m_nodes[i].inputs) {
+      auto it = producers.find(input);
+      if (it == producers.end()) {
+        // Inputs produced outside the graph (services, the camera) have
+        // no producing pass; they only participate in change tracking.
+        continue;
+      }
+      for (std::size_t const producer : it->second) {
+        consumers[producer].push_back(i);
+        ++pending_inputs[i];
+      }
+    }
+  }
+
+  std::vector<bool> emitted(m_nodes.size(), false);
+  while (m_order.size() < m_nodes.size()) {
+    std::size_t next = m_nodes.size();
+    for (std::size_t i = 0; i < m_nodes.size(); ++i) {
+      if (!emitted[i] && pending_inputs[i] == 0) {
+        next = i;
+        break;
+      }
+    }
+    if (next == m_nodes.size()) {
+      qWarning() << "PassGraph: dependency cycle; falling back to"
+                 << "registration order";
+      m_order.clear();
+      for (std::size_t i = 0; i < m_nodes.size(); ++i) {
+        m_order.push_back(i);
+      }
+      return;
+    }
+    emitted[next] = true;
+    m_order.push_back(next);
+    for (std::size_t const consumer : consumers[next]) {
+      --pending_inputs[consumer];
+    }
+  }
+}
+
+void PassGraph::submitAll(Renderer &renderer, ResourceManager *resources) {
+  rebuildOrderIfNeeded();
+
+  for (std::size_t const idx : m_order) {
+    Node &node = m_nodes[idx];
+
+    if (node.policy == RunPolicy::OnInputChange && !node.lastSeen.empty()) {
+      bool changed = false;
+      for (std::size_t i = 0; i < node.inputs.size(); ++i) {
+        if (resourceVersion(node.inputs[i]) != node.lastSeen[i]) {
+          changed = true;
+          break;
+        }
+      }
+      if (!changed) {
+        continue;
+      }
+    }
+
+    if (m_beforePass) {
+      m_beforePass(node.name);
+    }
+    node.pass->submit(renderer, resources);
+    if (m_afterPass) {
+      m_afterPass(node.name);
+    }
+
+    node.lastSeen.resize(node.inputs.size());
+    for (std::size_t i = 0; i < node.inputs.size(); ++i) {
+      node.lastSeen[i] = resourceVersion(node.inputs[i]);
+    }
+  }
+}
+
+void PassGraph::clear() {
+  m_nodes.clear();
+  m_order.clear();
+  m_versions.clear();
+  m_orderDirty = false;
+}
+
+} // namespace Render::GL
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "i_render_pass.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Render::GL {
+
+class Renderer;
+class ResourceManager;
+
+// Small render-graph layer over the submission passes. Passes declare the
+// logical resources they read and write; the graph derives a stable
+// submission order from those edges instead of a hand-maintained vector,
+// skips OnInputChange passes while their declared inputs are unchanged,
+// and runs before/after hooks around every pass as the insertion point
+// for per-pass timing instrumentation.
+//
+// The draw queue is rebuilt from scratch each frame, so only passes whose
+// output is retained outside the queue (GPU buffers or textures that
+// survive frames) may register OnInputChange; everything else resubmits
+// every frame and uses its declared edges for ordering alone.
+class PassGraph {
+public:
+  enum class RunPolicy : std::uint8_t {
+    EveryFrame,
+    OnInputChange,
+  };
+
+  void addPass(std::string name, IRenderPass *pass,
+               std::vector<std::string> inputs,
+               std::vector<std::string> outputs,
+               RunPolicy policy = RunPolicy::EveryFrame);
+
+  // Bumps a resource version; OnInputChange passes reading it re-run on
+  // the next submitAll.
+  void invalidateResource(const std::string &name);
+
+  // Runs the passes in dependency order, honouring each pass's run policy.
+  void submitAll(Renderer &renderer, ResourceManager *resources);
+
+  using PassHook = std::function<void(const std::string &name)>;
+  void setBeforePassHook(PassHook hook) { m_beforePass = std::move(hook); }
+  void setAfterPassHook(PassHook hook) { m_afterPass = std::move(hook); }
+
+  void clear();
+
+private:
+  struct Node {
+    std::string name;
+    IRenderPass *pass = nullptr;
+    std::vector<std::string> inputs;
+    std::vector<std::string> outputs;
+    RunPolicy policy = RunPolicy::EveryFrame;
+    // Input versions observed the last time the pass ran; empty until the
+    // first run, which is therefore never skipped.
+    std::vector<std::uint64_t> lastSeen;
+  };
+
+  [[nodiscard]] auto resourceVersion(const std::string &name) const
+      -> std::uint64_t;
+  void rebuildOrderIfNeeded();
+
+  std::vector<Node> m_nodes;
+  std::vector<std::size_t> m_order;
+  bool m_orderDirty = false;
+  std::unordered_map<std::string, std::uint64_t> m_versions;
+  PassHook m_beforePass;
+  PassHook m_afterPass;
+};
+
+} // namespace Render::GL
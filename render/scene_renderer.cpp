@@ -13,28 +13,38 @@
 #include "gl/primitives.h"
 #include "gl/resources.h"
 #include "ground/firecamp_gpu.h"
+#include "particle_system.h"
 #include "ground/grass_gpu.h"
 #include "ground/pine_gpu.h"
 #include "ground/plant_gpu.h"
 #include "ground/stone_gpu.h"
 #include "ground/terrain_gpu.h"
 #include "submitter.h"
+#include "world_snapshot.h"
 #include <QDebug>
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <qvectornd.h>
 #include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
 
 namespace Render::GL {
 
 namespace {
-const QVector3D k_axis_x(1.0F, 0.0F, 0.0F);
 const QVector3D k_axis_y(0.0F, 1.0F, 0.0F);
-const QVector3D k_axis_z(0.0F, 0.0F, 1.0F);
+
+// Below this many visible entities the task-spawn overhead outweighs the
+// parallel fill and submission stays on the render thread.
+constexpr std::size_t k_parallel_submit_min = 64;
 } // namespace
 
 Renderer::Renderer() { m_activeQueue = &m_queues[m_fillQueueIndex]; }
@@ -46,19 +56,42 @@ auto Renderer::initialize() -> bool {
     m_backend = std::make_shared<Backend>();
   }
   m_backend->initialize();
+  if (!m_particles) {
+    m_particles = std::make_unique<ParticleSystem>();
+  }
+  if (!m_pickingBuffer) {
+    m_pickingBuffer = std::make_unique<PickingBuffer>();
+    if (!m_pickingBuffer->initialize()) {
+      m_pickingBuffer.reset();
+    }
+  }
   m_entityRegistry = std::make_unique<EntityRendererRegistry>();
   registerBuiltInEntityRenderers(*m_entityRegistry);
+  if (!m_impostors) {
+    m_impostors = std::make_unique<ImpostorCache>();
+    if (!m_impostors->initialize()) {
+      m_impostors.reset();
+    }
+  }
   return true;
 }
 
-void Renderer::shutdown() { m_backend.reset(); }
+void Renderer::shutdown() {
+  m_particles.reset();
+  m_impostors.reset();
+  m_pickingBuffer.reset();
+  m_backend.reset();
+}
 
 void Renderer::beginFrame() {
   m_activeQueue = &m_queues[m_fillQueueIndex];
   m_activeQueue->clear();
 
+  updateFollowCamera();
+
   if (m_camera != nullptr) {
     m_view_proj = m_camera->getProjectionMatrix() * m_camera->getViewMatrix();
+    m_viewProjPod = detail::toMat4(m_view_proj);
   }
 
   if (m_backend) {
@@ -71,12 +104,134 @@ void Renderer::endFrame() {
     return;
   }
   if (m_backend && (m_camera != nullptr)) {
+    // Flush pending particle spawns into the fill queue before the swap
+    // so bursts spawned this frame draw this frame.
+    if (m_particles) {
+      m_particles->flush(*this);
+    }
     std::swap(m_fillQueueIndex, m_render_queueIndex);
     DrawQueue &render_queue = m_queues[m_render_queueIndex];
     render_queue.sortForBatching();
+    m_lastDrawCommandCount.store(render_queue.size(),
+                                 std::memory_order_relaxed);
     m_backend->setAnimationTime(m_accumulatedTime);
     m_backend->execute(render_queue, *m_camera);
+
+    if (m_impostors && !m_impostorsBaked && m_entityRegistry) {
+      m_impostors->bake(*m_entityRegistry, resources(), m_backend.get(),
+                        m_backend->shader(QStringLiteral("basic")));
+      m_impostorShader = m_backend->shader(QStringLiteral("impostor"));
+      m_impostorsBaked = true;
+    }
+
+    {
+      // Hand meshes collected by prewarmEntityAssets to the uploader;
+      // pump() spreads the actual buffer uploads across frames.
+      std::lock_guard<std::mutex> const lock(m_prewarmMutex);
+      if (!m_prewarmMeshes.empty() && (resources() != nullptr) &&
+          (resources()->uploader() != nullptr)) {
+        for (Mesh *mesh : m_prewarmMeshes) {
+          resources()->uploader()->requestMeshWarmup(mesh);
+        }
+        m_prewarmMeshes.clear();
+      }
+    }
+
+    if (m_pickingBuffer && m_pickCursorValid.load()) {
+      Shader *picking_shader = m_backend->shader(QStringLiteral("picking_id"));
+      m_pickingBuffer->renderAndRead(
+          m_pickCmds, picking_shader, m_view_proj, m_viewportWidth,
+          m_viewportHeight, m_pickCursorX.load(), m_pickCursorY.load());
+      m_pickResult.store(m_pickingBuffer->latestId());
+      m_pickResultValid.store(m_pickingBuffer->hasResult());
+    }
+  }
+}
+
+void Renderer::updateFollowCamera() {
+  if (!m_followSelection.load(std::memory_order_relaxed) ||
+      (m_camera == nullptr) || m_selectedIds.empty()) {
+    m_lastFollowNs = 0;
+    return;
+  }
+
+  const WorldSnapshot &snapshot = m_snapshots.acquireRead();
+  QVector3D sum(0.0F, 0.0F, 0.0F);
+  int count = 0;
+  for (const auto &snap : snapshot.entities) {
+    if (snap.hasUnit && m_selectedIds.count(snap.id) != 0) {
+      sum += snap.position;
+      ++count;
+    }
   }
+  if (count == 0) {
+    return;
+  }
+
+  auto const now = std::chrono::steady_clock::now().time_since_epoch();
+  auto const now_ns = static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+  float dt = 0.0F;
+  if (m_lastFollowNs != 0 && now_ns > m_lastFollowNs) {
+    // Clamp so a stalled frame cannot snap the camera across the map.
+    dt = std::min(static_cast<float>(now_ns - m_lastFollowNs) * 1e-9F, 0.1F);
+  }
+  m_lastFollowNs = now_ns;
+
+  m_camera->updateFollow(sum / static_cast<float>(count), dt);
+}
+
+void Renderer::prewarmEntityAssets(const std::vector<std::string> &types) {
+  if (!m_entityRegistry) {
+    return;
+  }
+
+  // Seeded renderers hash the entity id into cosmetic variants (shield
+  // decals, straps), so a few ids cover the distinct meshes a type can
+  // request; the tier loop reaches the silhouette-only geometry the
+  // lower detail levels swap in.
+  constexpr std::array<Engine::Core::EntityID, 3> k_seeds{1, 2, 3};
+  constexpr std::array<LodTier, 3> k_tiers{LodTier::Full, LodTier::Reduced,
+                                           LodTier::Minimal};
+
+  DrawQueue scratch;
+  QueueSubmitter collect(&scratch);
+
+  for (const auto &type : types) {
+    auto fn = m_entityRegistry->get(type);
+    if (!fn) {
+      continue;
+    }
+    EntitySnapshot snap{};
+    snap.hasUnit = true;
+    if (auto spawn = Game::Units::spawn_typeFromString(type)) {
+      snap.spawnType = *spawn;
+    }
+    for (auto seed : k_seeds) {
+      snap.id = seed;
+      for (int variant = 0; variant < 2; ++variant) {
+        snap.isMoving = variant == 1;
+        snap.isAttacking = variant == 1;
+        for (auto tier : k_tiers) {
+          DrawContext ctx{resources(), &snap, QMatrix4x4()};
+          ctx.backend = m_backend.get();
+          ctx.lod = tier;
+          fn(ctx, collect);
+        }
+      }
+    }
+  }
+
+  std::unordered_set<Mesh *> unique_meshes;
+  for (const auto &cmd : scratch.meshCmds()) {
+    if (cmd.mesh != nullptr) {
+      unique_meshes.insert(cmd.mesh);
+    }
+  }
+
+  std::lock_guard<std::mutex> const lock(m_prewarmMutex);
+  m_prewarmMeshes.insert(m_prewarmMeshes.end(), unique_meshes.begin(),
+                         unique_meshes.end());
 }
 
 void Renderer::setCamera(Camera *camera) { m_camera = camera; }
@@ -119,7 +274,7 @@ void Renderer::mesh(Mesh *mesh, const QMatrix4x4 &model, const QVector3D &color,
   cmd.mesh = mesh;
   cmd.texture = texture;
   cmd.model = model;
-  cmd.mvp = m_view_proj * model;
+  detail::composeMvp(m_viewProjPod, model, cmd.mvp);
   cmd.color = color;
   cmd.alpha = alpha;
   cmd.shader = m_currentShader;
@@ -151,6 +306,14 @@ void Renderer::fogBatch(const FogInstanceData *instances, std::size_t count) {
   m_activeQueue->submit(cmd);
 }
 
+void Renderer::fogMask(const FogMaskCmd &cmd) {
+  if ((cmd.cells == nullptr) || cmd.width <= 0 || cmd.height <= 0 ||
+      (m_activeQueue == nullptr)) {
+    return;
+  }
+  m_activeQueue->submit(cmd);
+}
+
 void Renderer::grassBatch(Buffer *instanceBuffer, std::size_t instance_count,
                           const GrassBatchParams &params) {
   if ((instanceBuffer == nullptr) || instance_count == 0 ||
@@ -220,6 +383,19 @@ void Renderer::firecampBatch(Buffer *instanceBuffer, std::size_t instance_count,
   m_activeQueue->submit(cmd);
 }
 
+void Renderer::particleBatch(Buffer *instanceBuffer, std::size_t instance_count,
+                             const ParticleBatchParams &params) {
+  if ((instanceBuffer == nullptr) || instance_count == 0 ||
+      (m_activeQueue == nullptr)) {
+    return;
+  }
+  ParticleBatchCmd cmd;
+  cmd.instanceBuffer = instanceBuffer;
+  cmd.instance_count = instance_count;
+  cmd.params = params;
+  m_activeQueue->submit(cmd);
+}
+
 void Renderer::terrainChunk(Mesh *mesh, const QMatrix4x4 &model,
                             const TerrainChunkParams &params,
                             std::uint16_t sortKey, bool depthWrite,
@@ -241,7 +417,6 @@ void Renderer::selectionRing(const QMatrix4x4 &model, float alphaInner,
                              float alphaOuter, const QVector3D &color) {
   SelectionRingCmd cmd;
   cmd.model = model;
-  cmd.mvp = m_view_proj * model;
   cmd.alphaInner = alphaInner;
   cmd.alphaOuter = alphaOuter;
   cmd.color = color;
@@ -254,7 +429,7 @@ void Renderer::grid(const QMatrix4x4 &model, const QVector3D &color,
                     float cellSize, float thickness, float extent) {
   GridCmd cmd;
   cmd.model = model;
-  cmd.mvp = m_view_proj * model;
+  detail::composeMvp(m_viewProjPod, model, cmd.mvp);
   cmd.color = color;
   cmd.cellSize = cellSize;
   cmd.thickness = thickness;
@@ -268,7 +443,6 @@ void Renderer::selectionSmoke(const QMatrix4x4 &model, const QVector3D &color,
                               float baseAlpha) {
   SelectionSmokeCmd cmd;
   cmd.model = model;
-  cmd.mvp = m_view_proj * model;
   cmd.color = color;
   cmd.baseAlpha = baseAlpha;
   if (m_activeQueue != nullptr) {
@@ -276,11 +450,21 @@ void Renderer::selectionSmoke(const QMatrix4x4 &model, const QVector3D &color,
   }
 }
 
-void Renderer::enqueueSelectionRing(Engine::Core::Entity *,
-                                    Engine::Core::TransformComponent *transform,
-                                    Engine::Core::UnitComponent *unit_comp,
-                                    bool selected, bool hovered) {
-  if ((!selected && !hovered) || (transform == nullptr)) {
+void Renderer::healthBar(const QVector3D &anchor, float width,
+                         const QVector3D &color, float fill) {
+  HealthBarCmd cmd;
+  cmd.anchor = anchor;
+  cmd.width = width;
+  cmd.color = color;
+  cmd.fill = fill;
+  if (m_activeQueue != nullptr) {
+    m_activeQueue->submit(cmd);
+  }
+}
+
+void Renderer::enqueueSelectionRing(const EntitySnapshot &snap, bool selected,
+                                    bool hovered, ISubmitter &out) {
+  if (!selected && !hovered) {
     return;
   }
 
@@ -288,21 +472,20 @@ void Renderer::enqueueSelectionRing(Engine::Core::Entity *,
   float ring_offset = 0.05F;
   float ground_offset = 0.0F;
 
-  if (unit_comp != nullptr) {
+  if (snap.hasUnit) {
     auto &config = Game::Units::TroopConfig::instance();
-    ring_size = config.getSelectionRingSize(unit_comp->spawn_type);
-    ring_offset += config.getSelectionRingYOffset(unit_comp->spawn_type);
-    ground_offset = config.getSelectionRingGroundOffset(unit_comp->spawn_type);
+    ring_size = config.getSelectionRingSize(snap.spawnType);
+    ring_offset += config.getSelectionRingYOffset(snap.spawnType);
+    ground_offset = config.getSelectionRingGroundOffset(snap.spawnType);
   }
 
-  QVector3D pos(transform->position.x, transform->position.y,
-                transform->position.z);
+  QVector3D pos = snap.position;
   auto &terrain_service = Game::Map::TerrainService::instance();
-  float terrain_y = transform->position.y;
+  float terrain_y = snap.position.y();
   if (terrain_service.isInitialized()) {
     terrain_y = terrain_service.getTerrainHeight(pos.x(), pos.z());
   } else {
-    terrain_y -= ground_offset * transform->scale.y;
+    terrain_y -= ground_offset * snap.scale.y();
   }
   pos.setY(terrain_y);
 
@@ -311,102 +494,263 @@ void Renderer::enqueueSelectionRing(Engine::Core::Entity *,
   ring_model.scale(ring_size, 1.0F, ring_size);
 
   if (selected) {
-    selectionRing(ring_model, 0.6F, 0.25F, QVector3D(0.2F, 0.4F, 1.0F));
+    out.selectionRing(ring_model, 0.6F, 0.25F, QVector3D(0.2F, 0.4F, 1.0F));
   } else if (hovered) {
-    selectionRing(ring_model, 0.35F, 0.15F, QVector3D(0.90F, 0.90F, 0.25F));
+    out.selectionRing(ring_model, 0.35F, 0.15F, QVector3D(0.90F, 0.90F, 0.25F));
   }
 }
 
-void Renderer::renderWorld(Engine::Core::World *world) {
-  if (m_paused.load()) {
+void Renderer::enqueueHealthBar(const EntitySnapshot &snap, ISubmitter &out) {
+  if (!snap.hasUnit) {
+    return;
+  }
+  int const mh = std::max(1, snap.maxHealth);
+  float const ratio = std::clamp(snap.health / float(mh), 0.0F, 1.0F);
+  // Undamaged units draw no bar; the overlay only marks damage, so a
+  // peaceful scene costs nothing here.
+  if (ratio <= 0.0F || ratio >= 1.0F) {
     return;
   }
+
+  float width = 0.9F;
+  float lift = 2.2F;
+  if (snap.spawnType == Game::Units::SpawnType::Barracks) {
+    // Above the roof peak, sized to the footprint, matching the old
+    // per-building mesh bar the overlay replaces.
+    width = snap.scale.x() * 2.16F;
+    lift = snap.scale.y() * 2.72F;
+  }
+
+  QVector3D const red(0.85F, 0.15F, 0.15F);
+  QVector3D const green(0.22F, 0.78F, 0.22F);
+  out.healthBar(snap.position + QVector3D(0.0F, lift, 0.0F), width,
+                green * ratio + red * (1.0F - ratio), ratio);
+}
+
+void Renderer::captureWorld(Engine::Core::World *world, std::uint64_t simTick,
+                            float tickAlpha) {
   if (world == nullptr) {
     return;
   }
+  const auto read_lock = world->acquireReadLock();
+  captureWorldSnapshot(*world, m_snapshots.beginWrite(), simTick, tickAlpha,
+                       m_transformHistory);
+  m_snapshots.publish();
+}
 
-  std::lock_guard<std::recursive_mutex> const guard(world->getEntityMutex());
+void Renderer::renderWorld() {
+  if (m_paused.load()) {
+    return;
+  }
 
   auto &vis = Game::Map::VisibilityService::instance();
   const bool visibility_enabled = vis.isInitialized();
 
-  auto renderable_entities =
-      world->getEntitiesWith<Engine::Core::RenderableComponent>();
-
-  for (auto *entity : renderable_entities) {
-
-    if (entity->hasComponent<Engine::Core::PendingRemovalComponent>()) {
-      continue;
-    }
+  const WorldSnapshot &snapshot = m_snapshots.acquireRead();
 
-    auto *renderable =
-        entity->getComponent<Engine::Core::RenderableComponent>();
-    auto *transform = entity->getComponent<Engine::Core::TransformComponent>();
+  // Drop tier history once it clearly outgrows the live entity set; the
+  // surviving entities re-settle on the right tier within a frame.
+  if (m_lodTiers.size() > snapshot.entities.size() * 2 + 64) {
+    m_lodTiers.clear();
+  }
 
-    if (!renderable->visible || (transform == nullptr)) {
-      continue;
-    }
+  // Extract the frustum planes once; every entity below tests against the
+  // cached planes instead of re-deriving them from the view-projection
+  // matrix per entity.
+  Frustum frustum;
+  const bool have_frustum = (m_camera != nullptr);
+  if (have_frustum) {
+    frustum = m_camera->extractFrustum();
+  }
 
-    auto *unit_comp = entity->getComponent<Engine::Core::UnitComponent>();
-    if ((unit_comp != nullptr) && unit_comp->health <= 0) {
-      continue;
-    }
+  // Serial prepass: cull, resolve fog visibility and LOD (the tier map
+  // mutates here, so it stays single-threaded) and collect the survivors
+  // for command generation.
+  m_visibleEntities.clear();
+  for (const auto &snap : snapshot.entities) {
 
-    if ((m_camera != nullptr) && (unit_comp != nullptr)) {
+    if (have_frustum) {
 
       float cull_radius = 3.0F;
 
-      if (unit_comp->spawn_type == Game::Units::SpawnType::MountedKnight) {
-        cull_radius = 4.0F;
-      } else if (unit_comp->spawn_type == Game::Units::SpawnType::Spearman ||
-                 unit_comp->spawn_type == Game::Units::SpawnType::Archer ||
-                 unit_comp->spawn_type == Game::Units::SpawnType::Knight) {
-        cull_radius = 2.5F;
+      if (snap.hasUnit) {
+        if (snap.spawnType == Game::Units::SpawnType::MountedKnight) {
+          cull_radius = 4.0F;
+        } else if (snap.spawnType == Game::Units::SpawnType::Spearman ||
+                   snap.spawnType == Game::Units::SpawnType::Archer ||
+                   snap.spawnType == Game::Units::SpawnType::Knight) {
+          cull_radius = 2.5F;
+        }
+      } else {
+        // Props and buildings: bound by the scaled model, with slack for
+        // the contact shadow quads drawn around the footprint.
+        cull_radius = 2.0F * std::max({snap.scale.x(), snap.scale.y(),
+                                       snap.scale.z(), 1.0F});
       }
 
-      QVector3D const unit_pos(transform->position.x, transform->position.y,
-                               transform->position.z);
-      if (!m_camera->isInFrustum(unit_pos, cull_radius)) {
+      if (!frustum.intersectsSphere(snap.position, cull_radius)) {
         continue;
       }
     }
 
-    if ((unit_comp != nullptr) && unit_comp->owner_id != m_localOwnerId) {
+    if (snap.hasUnit && snap.ownerId != m_localOwnerId) {
       if (visibility_enabled) {
-        if (!vis.isVisibleWorld(transform->position.x, transform->position.z)) {
+        if (!vis.isVisibleWorld(snap.position.x(), snap.position.z())) {
           continue;
         }
       }
     }
 
+    LodTier lod = LodTier::Full;
+    if ((m_camera != nullptr) && snap.hasUnit) {
+      float const camera_dist =
+          (snap.position - m_camera->getPosition()).length();
+      auto tier_it = m_lodTiers.try_emplace(snap.id, LodTier::Full).first;
+      lod = selectLodTier(camera_dist, tier_it->second);
+      tier_it->second = lod;
+    }
+
+    m_visibleEntities.push_back({&snap, lod});
+  }
+
+  // Proxy volumes for the ID-buffer pick pass: one box per pickable
+  // survivor, sized like the footprints the CPU picker tests. Entities
+  // hidden by fog never make it here, so they cannot be picked either.
+  m_pickCmds.clear();
+  Mesh *pick_proxy = nullptr;
+  if (ResourceManager *res = resources()) {
+    pick_proxy = res->unit();
+  }
+  if (pick_proxy != nullptr) {
+    for (const auto &visible : m_visibleEntities) {
+      const EntitySnapshot &snap = *visible.snap;
+      if (!snap.hasUnit || snap.id == Engine::Core::NULL_ENTITY) {
+        continue;
+      }
+      PickingBuffer::DrawCmd cmd;
+      cmd.entityId = snap.id;
+      cmd.mesh = pick_proxy;
+      // The proxy cube spans [-1, 1] on every axis.
+      if (snap.spawnType == Game::Units::SpawnType::Barracks) {
+        float const hx = std::max(0.6F, snap.scale.x() * 1.6F);
+        float const hz = std::max(0.6F, snap.scale.z() * 1.6F);
+        float const hy = std::max(0.5F, snap.scale.y() * 1.2F);
+        cmd.model.translate(snap.position.x(), snap.position.y() + hy * 0.5F,
+                            snap.position.z());
+        cmd.model.scale(hx, hy * 0.5F, hz);
+      } else {
+        cmd.model.translate(snap.position.x(), snap.position.y() + 1.1F,
+                            snap.position.z());
+        cmd.model.scale(0.8F, 1.1F, 0.8F);
+      }
+      m_pickCmds.push_back(cmd);
+    }
+  }
+
+  const std::size_t visible_count = m_visibleEntities.size();
+  if (visible_count == 0 || (m_activeQueue == nullptr)) {
+    return;
+  }
+
+  // Parallel phase: partition the visible entities across worker tasks,
+  // each filling its own DrawQueue, then concatenate the queues in chunk
+  // order so the combined command stream matches a serial submission.
+  const unsigned hardware = std::thread::hardware_concurrency();
+  const std::size_t extra_workers =
+      hardware > 1 ? std::min<std::size_t>(hardware - 1, 3) : 0;
+
+  if (extra_workers == 0 || visible_count < k_parallel_submit_min) {
+    QueueSubmitter submitter(m_activeQueue);
+    submitter.setViewProj(m_view_proj);
+    renderEntityRange(0, visible_count, submitter);
+    return;
+  }
+
+  const std::size_t chunk_count = extra_workers + 1;
+  const std::size_t per_chunk = (visible_count + chunk_count - 1) / chunk_count;
+  if (m_workerQueues.size() < extra_workers) {
+    m_workerQueues.resize(extra_workers);
+  }
+
+  std::vector<std::future<void>> pending;
+  pending.reserve(extra_workers);
+  for (std::size_t w = 1; w < chunk_count; ++w) {
+    const std::size_t begin = std::min(w * per_chunk, visible_count);
+    const std::size_t end = std::min(begin + per_chunk, visible_count);
+    DrawQueue &queue = m_workerQueues[w - 1];
+    queue.clear();
+    if (begin >= end) {
+      continue;
+    }
+    pending.push_back(
+        std::async(std::launch::async, [this, begin, end, &queue] {
+          QueueSubmitter submitter(&queue);
+          submitter.setViewProj(m_view_proj);
+          renderEntityRange(begin, end, submitter);
+        }));
+  }
+
+  {
+    QueueSubmitter submitter(m_activeQueue);
+    submitter.setViewProj(m_view_proj);
+    renderEntityRange(0, std::min(per_chunk, visible_count), submitter);
+  }
+
+  for (auto &task : pending) {
+    task.wait();
+  }
+  for (std::size_t w = 1; w < chunk_count; ++w) {
+    m_activeQueue->append(m_workerQueues[w - 1]);
+  }
+}
+
+void Renderer::renderEntityRange(std::size_t begin, std::size_t end,
+                                 QueueSubmitter &out) {
+  for (std::size_t entity_idx = begin; entity_idx < end; ++entity_idx) {
+    const EntitySnapshot &snap = *m_visibleEntities[entity_idx].snap;
+    LodTier const lod = m_visibleEntities[entity_idx].lod;
+
     bool const is_selected =
-        (m_selectedIds.find(entity->getId()) != m_selectedIds.end());
-    bool const is_hovered = (entity->getId() == m_hoveredEntityId);
+        (m_selectedIds.find(snap.id) != m_selectedIds.end());
+    bool const is_hovered = (snap.id == m_hoveredEntityId);
 
     QMatrix4x4 model_matrix;
-    model_matrix.translate(transform->position.x, transform->position.y,
-                           transform->position.z);
-    model_matrix.rotate(transform->rotation.x, k_axis_x);
-    model_matrix.rotate(transform->rotation.y, k_axis_y);
-    model_matrix.rotate(transform->rotation.z, k_axis_z);
-    model_matrix.scale(transform->scale.x, transform->scale.y,
-                       transform->scale.z);
+    model_matrix.translate(snap.position);
+    model_matrix.rotate(snap.yawDeg, k_axis_y);
+    model_matrix.scale(snap.scale);
+
+    // Entities here already survived the frustum and fog prepass, so the
+    // bar overlay inherits that filtering for free.
+    enqueueHealthBar(snap, out);
 
     bool drawn_by_registry = false;
-    if ((unit_comp != nullptr) && m_entityRegistry) {
+    if (snap.hasUnit && m_entityRegistry) {
       std::string const unit_type_str =
-          Game::Units::spawn_typeToString(unit_comp->spawn_type);
-      auto fn = m_entityRegistry->get(unit_type_str);
+          Game::Units::spawn_typeToString(snap.spawnType);
+
+      if (lod == LodTier::Impostor && m_impostors && m_impostors->ready() &&
+          (m_camera != nullptr) &&
+          m_impostors->submitImpostor(unit_type_str, snap,
+                                      m_camera->getPosition(),
+                                      m_impostorShader, out)) {
+        enqueueSelectionRing(snap, is_selected, is_hovered, out);
+        drawn_by_registry = true;
+      }
+
+      auto fn =
+          drawn_by_registry ? RenderFunc{} : m_entityRegistry->get(unit_type_str);
       if (fn) {
-        DrawContext ctx{resources(), entity, world, model_matrix};
+        DrawContext ctx{resources(), &snap, model_matrix};
 
         ctx.selected = is_selected;
         ctx.hovered = is_hovered;
         ctx.animationTime = m_accumulatedTime;
         ctx.backend = m_backend.get();
-        fn(ctx, *this);
-        enqueueSelectionRing(entity, transform, unit_comp, is_selected,
-                             is_hovered);
+        // The atlas may not be baked yet on the first frames; renderers
+        // only understand the three geometry tiers, so clamp.
+        ctx.lod = (lod == LodTier::Impostor) ? LodTier::Minimal : lod;
+        fn(ctx, out);
+        enqueueSelectionRing(snap, is_selected, is_hovered, out);
         drawn_by_registry = true;
       }
     }
@@ -416,7 +760,8 @@ void Renderer::renderWorld(Engine::Core::World *world) {
 
     Mesh *mesh_to_draw = nullptr;
     ResourceManager *res = resources();
-    switch (renderable->mesh) {
+    switch (static_cast<Engine::Core::RenderableComponent::MeshKind>(
+        snap.meshKind)) {
     case Engine::Core::RenderableComponent::MeshKind::Quad:
       mesh_to_draw = (res != nullptr) ? res->quad() : nullptr;
       break;
@@ -442,25 +787,23 @@ void Renderer::renderWorld(Engine::Core::World *world) {
     if ((mesh_to_draw == nullptr) && (res != nullptr)) {
       mesh_to_draw = res->quad();
     }
-    QVector3D const color = QVector3D(
-        renderable->color[0], renderable->color[1], renderable->color[2]);
+    QVector3D const color = snap.color;
 
     if (res != nullptr) {
       Mesh *contact_quad = res->quad();
       Texture *white = res->white();
       if ((contact_quad != nullptr) && (white != nullptr)) {
         QMatrix4x4 contact_base;
-        contact_base.translate(transform->position.x,
-                               transform->position.y + 0.03F,
-                               transform->position.z);
+        contact_base.translate(snap.position.x(), snap.position.y() + 0.03F,
+                               snap.position.z());
         contact_base.rotate(-90.0F, 1.0F, 0.0F, 0.0F);
         float const footprint =
-            std::max({transform->scale.x, transform->scale.z, 0.6F});
+            std::max({snap.scale.x(), snap.scale.z(), 0.6F});
 
         float size_ratio = 1.0F;
-        if (auto *unit = entity->getComponent<Engine::Core::UnitComponent>()) {
-          int const mh = std::max(1, unit->max_health);
-          size_ratio = std::clamp(unit->health / float(mh), 0.0F, 1.0F);
+        if (snap.hasUnit) {
+          int const mh = std::max(1, snap.maxHealth);
+          size_ratio = std::clamp(snap.health / float(mh), 0.0F, 1.0F);
         }
         float const eased = 0.25F + 0.75F * size_ratio;
 
@@ -474,20 +817,20 @@ void Renderer::renderWorld(Engine::Core::World *world) {
 
         QMatrix4x4 c0 = contact_base;
         c0.scale(base_scale_x * 0.60F, base_scale_y * 0.60F, 1.0F);
-        mesh(contact_quad, c0, col, white, center_alpha);
+        out.mesh(contact_quad, c0, col, white, center_alpha);
 
         QMatrix4x4 c1 = contact_base;
         c1.scale(base_scale_x * 0.95F, base_scale_y * 0.95F, 1.0F);
-        mesh(contact_quad, c1, col, white, mid_alpha);
+        out.mesh(contact_quad, c1, col, white, mid_alpha);
 
         QMatrix4x4 c2 = contact_base;
         c2.scale(base_scale_x * 1.35F, base_scale_y * 1.35F, 1.0F);
-        mesh(contact_quad, c2, col, white, outer_alpha);
+        out.mesh(contact_quad, c2, col, white, outer_alpha);
       }
     }
-    enqueueSelectionRing(entity, transform, unit_comp, is_selected, is_hovered);
-    mesh(mesh_to_draw, model_matrix, color,
-         (res != nullptr) ? res->white() : nullptr, 1.0F);
+    enqueueSelectionRing(snap, is_selected, is_hovered, out);
+    out.mesh(mesh_to_draw, model_matrix, color,
+             (res != nullptr) ? res->white() : nullptr, 1.0F);
   }
 }
 
@@ -1,25 +1,27 @@
 #pragma once
 
 #include "draw_queue.h"
+#include "entity/registry.h"
 #include "gl/backend.h"
 #include "gl/camera.h"
 #include "gl/mesh.h"
+#include "gl/impostor_cache.h"
+#include "gl/picking_buffer.h"
 #include "gl/resources.h"
 #include "gl/texture.h"
 #include "submitter.h"
+#include "world_snapshot.h"
 #include <atomic>
 #include <cstdint>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 namespace Engine::Core {
 class World;
-class Entity;
-class TransformComponent;
-class UnitComponent;
 } // namespace Engine::Core
 
 namespace Render::GL {
@@ -33,6 +35,7 @@ class ArrowSystem;
 namespace Render::GL {
 
 class Backend;
+class ParticleSystem;
 
 class Renderer : public ISubmitter {
 public:
@@ -47,6 +50,7 @@ public:
   void setViewport(int width, int height);
 
   void setCamera(Camera *camera);
+  [[nodiscard]] auto getCamera() const -> Camera * { return m_camera; }
   void setClearColor(float r, float g, float b, float a = 1.0F);
 
   void updateAnimationTime(float deltaTime) { m_accumulatedTime += deltaTime; }
@@ -58,6 +62,30 @@ public:
   void setHoveredEntityId(unsigned int id) { m_hoveredEntityId = id; }
   void setLocalOwnerId(int owner_id) { m_localOwnerId = owner_id; }
 
+  // Commands in the queue most recently handed to the backend; the
+  // benchmark report uses this as its draw-call proxy.
+  [[nodiscard]] auto lastDrawCommandCount() const -> std::size_t {
+    return m_lastDrawCommandCount.load(std::memory_order_relaxed);
+  }
+
+  // GPU picking: the entity-ID buffer is sampled at the cursor each frame
+  // and the result resolves one frame later. pickedEntityId returns false
+  // until a readback has completed (or after the cursor left the viewport);
+  // id 0 means nothing pickable is under the cursor.
+  void setPickCursor(float sx, float sy) {
+    m_pickCursorX = sx;
+    m_pickCursorY = sy;
+    m_pickCursorValid = true;
+  }
+  void clearPickCursor() {
+    m_pickCursorValid = false;
+    m_pickResultValid = false;
+  }
+  [[nodiscard]] auto pickedEntityId(unsigned int &outId) const -> bool {
+    outId = m_pickResult.load();
+    return m_pickResultValid.load();
+  }
+
   void setSelectedEntities(const std::vector<unsigned int> &ids) {
     m_selectedIds.clear();
     m_selectedIds.insert(ids.begin(), ids.end());
@@ -88,6 +116,14 @@ public:
   auto getShader(const QString &name) const -> Shader * {
     return m_backend ? m_backend->shader(name) : nullptr;
   }
+  // Handle-based pair for per-frame callers: resolve the name once at
+  // pass initialization, then fetch through the handle with no hashing.
+  auto shaderHandle(const QString &name) const -> ShaderHandle {
+    return m_backend ? m_backend->shaderHandle(name) : InvalidShaderHandle;
+  }
+  auto getShader(ShaderHandle handle) const -> Shader * {
+    return m_backend ? m_backend->shader(handle) : nullptr;
+  }
   auto loadShader(const QString &name, const QString &vertPath,
                   const QString &fragPath) -> Shader * {
     return m_backend ? m_backend->getOrLoadShader(name, vertPath, fragPath)
@@ -95,6 +131,7 @@ public:
   }
 
   void setCurrentShader(Shader *shader) { m_currentShader = shader; }
+  void setShader(Shader *shader) override { m_currentShader = shader; }
   auto getCurrentShader() const -> Shader * { return m_currentShader; }
 
   struct GridParams {
@@ -110,6 +147,22 @@ public:
   void resume() { m_paused = false; }
   auto isPaused() const -> bool { return m_paused; }
 
+  // Render-thread camera follow: while enabled, beginFrame() recenters
+  // the camera on the selected units' interpolated snapshot positions,
+  // so followed motion tracks at display refresh rate. The sim side
+  // only publishes the selection and this flag.
+  void setFollowSelection(bool enabled) {
+    m_followSelection.store(enabled, std::memory_order_relaxed);
+  }
+
+  // Runs each listed entity renderer off-screen so the procedural mesh
+  // caches fill during the loading screen instead of on the type's
+  // first battlefield draw, then hands the collected meshes to the
+  // async uploader for budgeted GPU upload. Safe to call from the
+  // loader thread; the uploads happen on the render thread over the
+  // following frames.
+  void prewarmEntityAssets(const std::vector<std::string> &types);
+
   void mesh(Mesh *mesh, const QMatrix4x4 &model, const QVector3D &color,
             Texture *texture = nullptr, float alpha = 1.0F) override;
   void cylinder(const QVector3D &start, const QVector3D &end, float radius,
@@ -122,17 +175,27 @@ public:
 
   void selectionSmoke(const QMatrix4x4 &model, const QVector3D &color,
                       float baseAlpha = 0.15F) override;
+  void healthBar(const QVector3D &anchor, float width, const QVector3D &color,
+                 float fill) override;
   void terrainChunk(Mesh *mesh, const QMatrix4x4 &model,
                     const TerrainChunkParams &params,
                     std::uint16_t sortKey = 0x8000U, bool depthWrite = true,
                     float depthBias = 0.0F);
 
-  void renderWorld(Engine::Core::World *world);
+  // Samples the render-relevant world state into the snapshot buffer. Runs
+  // on the sim side (after World::update); renderWorld never touches the
+  // live world. simTick/tickAlpha feed the per-entity transform history so
+  // captured transforms interpolate between fixed-rate sim ticks.
+  void captureWorld(Engine::Core::World *world, std::uint64_t simTick,
+                    float tickAlpha);
+
+  void renderWorld();
 
   void lockWorldForModification() { m_worldMutex.lock(); }
   void unlockWorldForModification() { m_worldMutex.unlock(); }
 
   void fogBatch(const FogInstanceData *instances, std::size_t count);
+  void fogMask(const FogMaskCmd &cmd);
   void grassBatch(Buffer *instanceBuffer, std::size_t instance_count,
                   const GrassBatchParams &params);
   void stoneBatch(Buffer *instanceBuffer, std::size_t instance_count,
@@ -143,12 +206,40 @@ public:
                  const PineBatchParams &params);
   void firecampBatch(Buffer *instanceBuffer, std::size_t instance_count,
                      const FireCampBatchParams &params);
+  void particleBatch(Buffer *instanceBuffer, std::size_t instance_count,
+                     const ParticleBatchParams &params);
+
+  // Shared burst-particle pool; arrow impacts, fire embers and any
+  // future effect spawn through it. Null until initialize().
+  [[nodiscard]] auto particles() -> ParticleSystem * {
+    return m_particles.get();
+  }
 
 private:
-  void enqueueSelectionRing(Engine::Core::Entity *entity,
-                            Engine::Core::TransformComponent *transform,
-                            Engine::Core::UnitComponent *unit_comp,
-                            bool selected, bool hovered);
+  // One culled, LOD-resolved entity from the prepass; the parallel phase
+  // renders these without touching the tier map or the visibility
+  // service again.
+  struct VisibleEntity {
+    const EntitySnapshot *snap = nullptr;
+    LodTier lod = LodTier::Full;
+  };
+
+  void enqueueSelectionRing(const EntitySnapshot &snap, bool selected,
+                            bool hovered, ISubmitter &out);
+
+  // Recenters the camera on the selected units' interpolated snapshot
+  // positions; runs at the top of beginFrame while follow is enabled.
+  void updateFollowCamera();
+
+  // Submits one bar command for a damaged unit; the backend draws every
+  // bar of the frame in a single instanced overlay call.
+  static void enqueueHealthBar(const EntitySnapshot &snap, ISubmitter &out);
+
+  // Renders m_visibleEntities[begin, end) into `out`. Safe to run on a
+  // worker thread: it only reads the snapshot, the prepass results and
+  // immutable resources, and writes through the submitter's queue.
+  void renderEntityRange(std::size_t begin, std::size_t end,
+                         QueueSubmitter &out);
 
   Camera *m_camera = nullptr;
   std::shared_ptr<Backend> m_backend;
@@ -156,11 +247,46 @@ private:
   DrawQueue *m_activeQueue = nullptr;
   int m_fillQueueIndex = 0;
   int m_render_queueIndex = 1;
+  std::atomic<std::size_t> m_lastDrawCommandCount{0};
 
   std::unique_ptr<EntityRendererRegistry> m_entityRegistry;
+  std::unique_ptr<ParticleSystem> m_particles;
+  std::unique_ptr<ImpostorCache> m_impostors;
+  Shader *m_impostorShader = nullptr;
+  bool m_impostorsBaked = false;
   unsigned int m_hoveredEntityId = 0;
   std::unordered_set<unsigned int> m_selectedIds;
 
+  // Last LOD tier chosen per entity; selectLodTier reads it to apply
+  // hysteresis across frames.
+  std::unordered_map<Engine::Core::EntityID, LodTier> m_lodTiers;
+
+  // Prepass output and per-worker queues for parallel submission; kept
+  // as members so their allocations survive across frames.
+  std::vector<VisibleEntity> m_visibleEntities;
+  std::vector<DrawQueue> m_workerQueues;
+
+  // Meshes collected by prewarmEntityAssets on the loader thread;
+  // endFrame drains them into the async uploader's warmup queue.
+  std::mutex m_prewarmMutex;
+  std::vector<Mesh *> m_prewarmMeshes;
+
+  // Camera-follow state consumed by updateFollowCamera(); the timestamp
+  // derives the per-frame dt for refresh-rate-independent smoothing.
+  std::atomic<bool> m_followSelection{false};
+  std::uint64_t m_lastFollowNs = 0;
+
+  // GPU picking: proxy volumes collected during the prepass and drawn
+  // into the ID buffer after the main frame. Cursor and result cross the
+  // game/render threads, hence the atomics.
+  std::unique_ptr<PickingBuffer> m_pickingBuffer;
+  std::vector<PickingBuffer::DrawCmd> m_pickCmds;
+  std::atomic<float> m_pickCursorX{-1.0F};
+  std::atomic<float> m_pickCursorY{-1.0F};
+  std::atomic<bool> m_pickCursorValid{false};
+  std::atomic<unsigned int> m_pickResult{0};
+  std::atomic<bool> m_pickResultValid{false};
+
   int m_viewportWidth = 0;
   int m_viewportHeight = 0;
   GridParams m_gridParams;
@@ -168,9 +294,14 @@ private:
   std::atomic<bool> m_paused{false};
 
   std::mutex m_worldMutex;
+  SnapshotBuffer m_snapshots;
+  // Writer-side state for the tick interpolation; only captureWorld
+  // touches it.
+  TransformHistoryMap m_transformHistory;
   int m_localOwnerId = 1;
 
   QMatrix4x4 m_view_proj;
+  Math::Mat4 m_viewProjPod;
   Shader *m_currentShader = nullptr;
 };
 
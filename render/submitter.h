@@ -2,8 +2,10 @@
 
 #include "draw_queue.h"
 #include "gl/primitives.h"
+#include "math/pod_math.h"
 #include <QMatrix4x4>
 #include <QVector3D>
+#include <cstring>
 
 namespace Render::GL {
 class Mesh;
@@ -15,6 +17,10 @@ namespace Render::GL {
 class ISubmitter {
 public:
   virtual ~ISubmitter() = default;
+  // Shader attached to subsequent mesh() submissions until reset with
+  // nullptr; entity renderers use this instead of downcasting to the
+  // concrete submitter.
+  virtual void setShader(Shader *shader) = 0;
   virtual void mesh(Mesh *mesh, const QMatrix4x4 &model, const QVector3D &color,
                     Texture *tex = nullptr, float alpha = 1.0F) = 0;
   virtual void cylinder(const QVector3D &start, const QVector3D &end,
@@ -26,6 +32,8 @@ public:
                     float cellSize, float thickness, float extent) = 0;
   virtual void selectionSmoke(const QMatrix4x4 &model, const QVector3D &color,
                               float baseAlpha = 0.15F) = 0;
+  virtual void healthBar(const QVector3D &anchor, float width,
+                         const QVector3D &color, float fill) = 0;
 };
 
 namespace detail {
@@ -38,13 +46,31 @@ inline auto decomposeUnitCylinder(const QMatrix4x4 &model, QVector3D &start,
   radius = 0.5F * (sx.length() + sz.length());
   return radius > 0.0F;
 }
+
+inline auto toMat4(const QMatrix4x4 &m) -> Math::Mat4 {
+  return Math::Mat4::fromColumnMajor(m.constData());
+}
+
+// Writes viewProj * model into out through the POD SIMD kernel;
+// QMatrix4x4 only reappears at the command boundary, as a plain store.
+inline void composeMvp(const Math::Mat4 &view_proj, const QMatrix4x4 &model,
+                       QMatrix4x4 &out) {
+  Math::Mat4 const mvp = Math::mul(view_proj, toMat4(model));
+  std::memcpy(out.data(), mvp.data(), sizeof(float) * 16);
+}
 } // namespace detail
 
 class QueueSubmitter : public ISubmitter {
 public:
   explicit QueueSubmitter(DrawQueue *queue) : m_queue(queue) {}
 
-  void setShader(Shader *shader) { m_shader = shader; }
+  void setShader(Shader *shader) override { m_shader = shader; }
+
+  // The view-projection matrix baked into submitted mvp fields; set it
+  // once per frame before handing the submitter to renderers.
+  void setViewProj(const QMatrix4x4 &view_proj) {
+    m_view_proj = detail::toMat4(view_proj);
+  }
 
   void mesh(Mesh *mesh, const QMatrix4x4 &model, const QVector3D &color,
             Texture *tex = nullptr, float alpha = 1.0F) override {
@@ -72,6 +98,7 @@ public:
     cmd.mesh = mesh;
     cmd.texture = tex;
     cmd.model = model;
+    detail::composeMvp(m_view_proj, model, cmd.mvp);
     cmd.color = color;
     cmd.alpha = alpha;
     cmd.shader = m_shader;
@@ -109,6 +136,7 @@ public:
     }
     GridCmd cmd;
     cmd.model = model;
+    detail::composeMvp(m_view_proj, model, cmd.mvp);
     cmd.color = color;
     cmd.cellSize = cellSize;
     cmd.thickness = thickness;
@@ -126,10 +154,23 @@ public:
     cmd.baseAlpha = baseAlpha;
     m_queue->submit(cmd);
   }
+  void healthBar(const QVector3D &anchor, float width, const QVector3D &color,
+                 float fill) override {
+    if (m_queue == nullptr) {
+      return;
+    }
+    HealthBarCmd cmd;
+    cmd.anchor = anchor;
+    cmd.width = width;
+    cmd.color = color;
+    cmd.fill = fill;
+    m_queue->submit(cmd);
+  }
 
 private:
   DrawQueue *m_queue = nullptr;
   Shader *m_shader = nullptr;
+  Math::Mat4 m_view_proj;
 };
 
 } // namespace Render::GL
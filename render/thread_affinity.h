@@ -2,6 +2,7 @@
 
 #include <QDebug>
 #include <QThread>
+#include <vector>
 
 #ifdef __linux__
 #include <pthread.h>
@@ -64,6 +65,33 @@ public:
 #endif
   }
 
+  static bool pinCurrentThreadToCores(const std::vector<int> &coreIds) {
+    if (coreIds.empty()) {
+      return false;
+    }
+
+#ifdef __linux__
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    for (int coreId : coreIds) {
+      CPU_SET(coreId, &cpuset);
+    }
+
+    int result =
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+
+    if (result == 0) {
+      return true;
+    } else {
+      qWarning() << "ThreadAffinity: Failed to pin current thread, error:"
+                 << result;
+      return false;
+    }
+#else
+    return false;
+#endif
+  }
+
   static bool pinToCores(QThread *thread, const std::vector<int> &coreIds) {
     if (!thread || coreIds.empty()) {
       qWarning() << "ThreadAffinity: invalid parameters";
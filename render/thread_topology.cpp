@@ -0,0 +1,121 @@
+#include "thread_topology.h"
+
+#include "../game/core/profiler.h"
+#include "thread_affinity.h"
+
+#include <cstring>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sys/resource.h>
+#endif
+
+namespace Render {
+
+namespace {
+
+// Nice value applied to Role::Io threads so a save or asset flush never
+// competes with the sim for a worker core's timeslice.
+constexpr int k_io_nice = 5;
+
+// pthread names are capped at 15 characters plus the terminator.
+void nameCurrentThread(const char *name) {
+#ifdef __linux__
+  char buf[16];
+  std::strncpy(buf, name, sizeof(buf) - 1);
+  buf[sizeof(buf) - 1] = '\0';
+  pthread_setname_np(pthread_self(), buf);
+#else
+  Q_UNUSED(name);
+#endif
+}
+
+void lowerCurrentThreadPriority() {
+#ifdef __linux__
+  // On Linux, PRIO_PROCESS with id 0 targets the calling thread.
+  setpriority(PRIO_PROCESS, 0, k_io_nice);
+#endif
+}
+
+} // namespace
+
+ThreadTopology::ThreadTopology() {
+  const auto strategy = ThreadAffinity::AffinityStrategy::autoDetect();
+  m_strategy.mainCore = strategy.mainCore;
+  m_strategy.renderCore = strategy.renderCore;
+  m_strategy.workerCores = strategy.workerCores;
+}
+
+auto ThreadTopology::instance() -> ThreadTopology & {
+  static ThreadTopology topology;
+  return topology;
+}
+
+void ThreadTopology::registerCurrentThread(Role role, const char *name) {
+  // Render registration sits on a per-frame path; the guard makes the
+  // repeat calls free.
+  thread_local bool registered = false;
+  if (registered) {
+    return;
+  }
+  registered = true;
+
+  std::vector<int> cores;
+  switch (role) {
+  case Role::Main:
+    if (m_strategy.mainCore >= 0) {
+      cores.push_back(m_strategy.mainCore);
+    }
+    break;
+  case Role::Render:
+    if (m_strategy.renderCore >= 0) {
+      cores.push_back(m_strategy.renderCore);
+    }
+    break;
+  case Role::Worker:
+  case Role::Audio:
+  case Role::Io:
+    // The worker set excludes the sim and render cores, so a background
+    // burst can never migrate either critical thread.
+    cores = m_strategy.workerCores;
+    break;
+  }
+
+  if (cores.size() == 1) {
+    ThreadAffinity::pinCurrentThreadToCore(cores.front());
+  } else if (cores.size() > 1) {
+    ThreadAffinity::pinCurrentThreadToCores(cores);
+  }
+  if (role == Role::Io) {
+    lowerCurrentThreadPriority();
+  }
+  nameCurrentThread(name);
+  Engine::Core::Profiler::instance().setCurrentThreadName(name);
+
+  std::lock_guard<std::mutex> const lock(m_mutex);
+  m_threads.push_back(
+      {QString::fromUtf8(name), role, std::move(cores)});
+}
+
+auto ThreadTopology::layout() const -> std::vector<ThreadInfo> {
+  std::lock_guard<std::mutex> const lock(m_mutex);
+  return m_threads;
+}
+
+auto ThreadTopology::roleName(Role role) -> const char * {
+  switch (role) {
+  case Role::Main:
+    return "main";
+  case Role::Render:
+    return "render";
+  case Role::Worker:
+    return "worker";
+  case Role::Audio:
+    return "audio";
+  case Role::Io:
+    return "io";
+  }
+  return "unknown";
+}
+
+} // namespace Render
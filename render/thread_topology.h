@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QString>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace Render {
+
+// Process-wide registry for the long-lived threads (sim, render, audio,
+// pathfinding, I/O). Each thread registers itself once from its entry
+// point; registration pins it according to the auto-detected core
+// strategy, names it for external profilers and hands the name to the
+// in-game profiler. Keeping the sim and render threads on dedicated
+// physical cores — and every worker off them — avoids the frame variance
+// scheduler migrations cause on hybrid-core CPUs.
+class ThreadTopology {
+public:
+  enum class Role : std::uint8_t {
+    Main,   // GUI/event-loop thread
+    Render, // Qt Quick render thread (runs the sim tick and the draw)
+    Worker, // sim/pathfinding/AI workers: pinned off the render core
+    Audio,  // latency-sensitive but light; shares the worker set
+    Io      // background writers: worker set plus a lowered priority
+  };
+
+  struct ThreadInfo {
+    QString name;
+    Role role;
+    std::vector<int> cores; // empty when the thread floats
+  };
+
+  static auto instance() -> ThreadTopology &;
+
+  ThreadTopology(const ThreadTopology &) = delete;
+  ThreadTopology(ThreadTopology &&) = delete;
+  auto operator=(const ThreadTopology &) -> ThreadTopology & = delete;
+  auto operator=(ThreadTopology &&) -> ThreadTopology & = delete;
+
+  // Pins, names and records the calling thread. Idempotent per thread,
+  // so it is safe to call from a per-frame path.
+  void registerCurrentThread(Role role, const char *name);
+
+  // Snapshot of every registered thread, for the debug overlay.
+  [[nodiscard]] auto layout() const -> std::vector<ThreadInfo>;
+
+  [[nodiscard]] static auto roleName(Role role) -> const char *;
+
+private:
+  ThreadTopology();
+  ~ThreadTopology() = default;
+
+  struct Strategy {
+    int mainCore = -1;
+    int renderCore = -1;
+    std::vector<int> workerCores;
+  };
+
+  Strategy m_strategy;
+  mutable std::mutex m_mutex;
+  std::vector<ThreadInfo> m_threads;
+};
+
+} // namespace Render
@@ -1,56 +1,93 @@
 #pragma once
 
 #include <QMatrix4x4>
+#include <cstddef>
 #include <cstdint>
-#include <unordered_map>
+#include <vector>
 
 namespace Render {
 
-template <typename KeyType = std::uint64_t> class TransformCache {
+// Dense per-entity transform cache. Entities acquire a stable slot once and
+// every subsequent lookup is a single indexed load; no hashing is involved.
+// Individual slots invalidate through a dirty bitset, and markAllDirty bumps
+// a global epoch instead of touching every entry.
+class TransformCache {
 public:
-  struct CachedTransform {
-    QMatrix4x4 transform;
-    std::uint32_t lastUpdateFrame{0};
-    bool dirty{true};
-  };
+  using Slot = std::uint32_t;
+  static constexpr Slot InvalidSlot = UINT32_MAX;
+
+  // Returns a stable slot for the caller to index with until released.
+  // Freed slots are recycled before the array grows.
+  Slot acquireSlot() {
+    if (!m_freeSlots.empty()) {
+      Slot slot = m_freeSlots.back();
+      m_freeSlots.pop_back();
+      m_entries[slot] = Entry{};
+      return slot;
+    }
+    Slot slot = static_cast<Slot>(m_entries.size());
+    m_entries.emplace_back();
+    if ((slot / 64) >= m_dirtyBits.size()) {
+      m_dirtyBits.push_back(0);
+    }
+    return slot;
+  }
 
-  void markDirty(KeyType key) {
-    auto it = m_cache.find(key);
-    if (it != m_cache.end()) {
-      it->second.dirty = true;
+  void releaseSlot(Slot slot) {
+    if (slot >= m_entries.size()) {
+      return;
     }
+    m_entries[slot].alive = false;
+    clearDirtyBit(slot);
+    m_freeSlots.push_back(slot);
   }
 
-  void markAllDirty() {
-    for (auto &entry : m_cache) {
-      entry.second.dirty = true;
+  void markDirty(Slot slot) {
+    if (slot < m_entries.size()) {
+      m_dirtyBits[slot / 64] |= (std::uint64_t{1} << (slot % 64));
     }
   }
 
-  const QMatrix4x4 *get(KeyType key, std::uint32_t currentFrame) const {
-    auto it = m_cache.find(key);
-    if (it == m_cache.end() || it->second.dirty) {
+  // Bumping the epoch makes every cached transform stale at once; no walk
+  // over the entries is needed.
+  void markAllDirty() { ++m_epoch; }
+
+  const QMatrix4x4 *get(Slot slot, std::uint32_t currentFrame) const {
+    if (slot >= m_entries.size()) {
       return nullptr;
     }
-
-    if (currentFrame - it->second.lastUpdateFrame > m_maxFrameAge) {
+    const Entry &entry = m_entries[slot];
+    if (!entry.alive || entry.epoch != m_epoch) {
       return nullptr;
     }
-
-    return &it->second.transform;
+    if ((m_dirtyBits[slot / 64] & (std::uint64_t{1} << (slot % 64))) != 0) {
+      return nullptr;
+    }
+    if (currentFrame - entry.lastUpdateFrame > m_maxFrameAge) {
+      return nullptr;
+    }
+    return &entry.transform;
   }
 
-  void set(KeyType key, const QMatrix4x4 &transform,
+  void set(Slot slot, const QMatrix4x4 &transform,
            std::uint32_t currentFrame) {
-    auto &entry = m_cache[key];
+    if (slot >= m_entries.size()) {
+      return;
+    }
+    Entry &entry = m_entries[slot];
     entry.transform = transform;
     entry.lastUpdateFrame = currentFrame;
-    entry.dirty = false;
+    entry.epoch = m_epoch;
+    entry.alive = true;
+    clearDirtyBit(slot);
   }
 
-  void remove(KeyType key) { m_cache.erase(key); }
-
-  void clear() { m_cache.clear(); }
+  void clear() {
+    m_entries.clear();
+    m_dirtyBits.clear();
+    m_freeSlots.clear();
+    m_epoch = 0;
+  }
 
   struct Stats {
     std::size_t totalEntries{0};
@@ -60,9 +97,16 @@ public:
 
   Stats getStats() const {
     Stats stats;
-    stats.totalEntries = m_cache.size();
-    for (const auto &entry : m_cache) {
-      if (entry.second.dirty) {
+    for (std::size_t slot = 0; slot < m_entries.size(); ++slot) {
+      const Entry &entry = m_entries[slot];
+      if (!entry.alive) {
+        continue;
+      }
+      ++stats.totalEntries;
+      bool dirty =
+          entry.epoch != m_epoch ||
+          (m_dirtyBits[slot / 64] & (std::uint64_t{1} << (slot % 64))) != 0;
+      if (dirty) {
         ++stats.dirtyEntries;
       } else {
         ++stats.validEntries;
@@ -73,19 +117,22 @@ public:
 
   void setMaxFrameAge(std::uint32_t frames) { m_maxFrameAge = frames; }
 
-  void cleanup(std::uint32_t currentFrame) {
-    auto it = m_cache.begin();
-    while (it != m_cache.end()) {
-      if (currentFrame - it->second.lastUpdateFrame > m_maxFrameAge * 2) {
-        it = m_cache.erase(it);
-      } else {
-        ++it;
-      }
-    }
+private:
+  struct Entry {
+    QMatrix4x4 transform;
+    std::uint32_t lastUpdateFrame{0};
+    std::uint32_t epoch{UINT32_MAX};
+    bool alive{true};
+  };
+
+  void clearDirtyBit(Slot slot) {
+    m_dirtyBits[slot / 64] &= ~(std::uint64_t{1} << (slot % 64));
   }
 
-private:
-  std::unordered_map<KeyType, CachedTransform> m_cache;
+  std::vector<Entry> m_entries;
+  std::vector<std::uint64_t> m_dirtyBits;
+  std::vector<Slot> m_freeSlots;
+  std::uint32_t m_epoch{0};
   std::uint32_t m_maxFrameAge{300};
 };
 
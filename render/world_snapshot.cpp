@@ -0,0 +1,179 @@
+#include "world_snapshot.h"
+#include "../game/core/component.h"
+#include "../game/core/world.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace Render::GL {
+
+namespace {
+
+void sampleAnimation(Engine::Core::World &world, Engine::Core::Entity *entity,
+                     EntitySnapshot &out) {
+  auto *movement = entity->getComponent<Engine::Core::MovementComponent>();
+  auto *attack = entity->getComponent<Engine::Core::AttackComponent>();
+  auto *attack_target =
+      entity->getComponent<Engine::Core::AttackTargetComponent>();
+  auto *transform = entity->getComponent<Engine::Core::TransformComponent>();
+  auto *hold_mode = entity->getComponent<Engine::Core::HoldModeComponent>();
+
+  out.isInHoldMode = (hold_mode != nullptr) && hold_mode->active;
+  if ((hold_mode != nullptr) && !hold_mode->active &&
+      hold_mode->exitCooldown > 0.0F) {
+    out.isExitingHold = true;
+    out.holdExitProgress =
+        1.0F - (hold_mode->exitCooldown / hold_mode->standUpDuration);
+  }
+  out.isMoving = (movement != nullptr) && movement->hasTarget;
+
+  if ((attack == nullptr) || (attack_target == nullptr) ||
+      attack_target->target_id == 0 || (transform == nullptr)) {
+    return;
+  }
+
+  out.isMelee =
+      attack->currentMode == Engine::Core::AttackComponent::CombatMode::Melee;
+
+  float const current_cooldown =
+      out.isMelee ? attack->meleeCooldown : attack->cooldown;
+  bool const recently_fired =
+      attack->timeSinceLast < std::min(current_cooldown, 0.45F);
+  bool target_in_range = false;
+
+  if (auto *target = world.getEntity(attack_target->target_id)) {
+    auto *target_transform =
+        target->getComponent<Engine::Core::TransformComponent>();
+    if (target_transform != nullptr) {
+      float const dx = target_transform->position.x - transform->position.x;
+      float const dz = target_transform->position.z - transform->position.z;
+      float const dist_squared = dx * dx + dz * dz;
+      float const target_radius =
+          std::max(target_transform->scale.x, target_transform->scale.z) *
+          0.5F;
+      float const effective_range = attack->range + target_radius + 0.25F;
+      target_in_range = dist_squared <= effective_range * effective_range;
+    }
+  }
+
+  out.isAttacking = !out.isMoving && (target_in_range || recently_fired);
+}
+
+// Teleport guard: a jump this large between consecutive ticks (waypoint
+// snaps, spawns) renders as a cut instead of a one-tick smear.
+constexpr float k_interp_snap_distance_sq = 4.0F * 4.0F;
+
+inline auto lerpAngleDeg(float a, float b, float t) -> float {
+  float const diff = std::fmod(b - a + 540.0F, 360.0F) - 180.0F;
+  return a + diff * t;
+}
+
+// Advances the entity's tick ring and returns the interpolated transform
+// for the current frame's alpha.
+void interpolateTransform(TransformHistory &hist, std::uint64_t simTick,
+                          float tickAlpha, QVector3D &position,
+                          float &yawDeg) {
+  if (hist.tick[1] == 0) {
+    hist.tick[0] = hist.tick[1] = simTick;
+    hist.position[0] = hist.position[1] = position;
+    hist.yawDeg[0] = hist.yawDeg[1] = yawDeg;
+    return;
+  }
+
+  if (hist.tick[1] != simTick) {
+    hist.tick[0] = hist.tick[1];
+    hist.position[0] = hist.position[1];
+    hist.yawDeg[0] = hist.yawDeg[1];
+    hist.tick[1] = simTick;
+  }
+  // Same tick: input handlers may mutate transforms between ticks; keep
+  // the newest entry current so those changes show up immediately.
+  hist.position[1] = position;
+  hist.yawDeg[1] = yawDeg;
+
+  if (hist.tick[0] == hist.tick[1]) {
+    return;
+  }
+  if ((hist.position[1] - hist.position[0]).lengthSquared() >
+      k_interp_snap_distance_sq) {
+    return;
+  }
+
+  position = hist.position[0] +
+             (hist.position[1] - hist.position[0]) * tickAlpha;
+  yawDeg = lerpAngleDeg(hist.yawDeg[0], yawDeg, tickAlpha);
+}
+
+} // namespace
+
+void captureWorldSnapshot(Engine::Core::World &world, WorldSnapshot &out,
+                          std::uint64_t simTick, float tickAlpha,
+                          TransformHistoryMap &history) {
+  out.entities.clear();
+  ++out.frame;
+
+  const auto &renderables =
+      world.view<Engine::Core::RenderableComponent>();
+  out.entities.reserve(renderables.size());
+
+  for (auto *entity : renderables) {
+    if (entity->hasComponent<Engine::Core::PendingRemovalComponent>()) {
+      continue;
+    }
+    auto *renderable =
+        entity->getComponent<Engine::Core::RenderableComponent>();
+    auto *transform = entity->getComponent<Engine::Core::TransformComponent>();
+    if (!renderable->visible || (transform == nullptr)) {
+      continue;
+    }
+    auto *unit = entity->getComponent<Engine::Core::UnitComponent>();
+    if ((unit != nullptr) && unit->health <= 0) {
+      continue;
+    }
+
+    EntitySnapshot snap;
+    snap.id = entity->getId();
+    snap.position = QVector3D(transform->position.x, transform->position.y,
+                              transform->position.z);
+    snap.yawDeg = transform->rotation.y;
+    interpolateTransform(history[snap.id], simTick, tickAlpha, snap.position,
+                         snap.yawDeg);
+    snap.scale =
+        QVector3D(transform->scale.x, transform->scale.y, transform->scale.z);
+    snap.meshKind = static_cast<int>(renderable->mesh);
+    snap.color = QVector3D(renderable->color[0], renderable->color[1],
+                           renderable->color[2]);
+    if (unit != nullptr) {
+      snap.hasUnit = true;
+      snap.ownerId = unit->owner_id;
+      snap.health = unit->health;
+      snap.maxHealth = unit->max_health;
+      snap.spawnType = unit->spawn_type;
+      sampleAnimation(world, entity, snap);
+    }
+    if (auto *capture =
+            entity->getComponent<Engine::Core::CaptureComponent>()) {
+      snap.isBeingCaptured = capture->isBeingCaptured;
+      snap.captureProgress = capture->requiredTime > 0.0F
+                                 ? capture->captureProgress /
+                                       capture->requiredTime
+                                 : 0.0F;
+      snap.capturingOwnerId = capture->capturing_player_id;
+    }
+    if (auto *production =
+            entity->getComponent<Engine::Core::ProductionComponent>()) {
+      snap.rallySet = production->rallySet;
+      snap.rallyX = production->rallyX;
+      snap.rallyZ = production->rallyZ;
+    }
+    out.entities.push_back(snap);
+  }
+
+  // History entries for despawned entities linger; drop the map once it
+  // clearly outgrows the live set and let survivors re-seed next capture.
+  if (history.size() > out.entities.size() * 2 + 64) {
+    history.clear();
+  }
+}
+
+} // namespace Render::GL
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "../game/core/entity.h"
+#include "../game/units/spawn_type.h"
+#include <QVector3D>
+#include <atomic>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine::Core {
+class World;
+}
+
+namespace Render::GL {
+
+// Compact per-entity record captured at the end of a sim tick. Everything
+// the render path needs is sampled here so the renderer never touches live
+// components: transform, renderable state, and the animation inputs the
+// humanoid renderers used to derive from component lookups.
+struct EntitySnapshot {
+  Engine::Core::EntityID id = Engine::Core::NULL_ENTITY;
+
+  QVector3D position;
+  // Units and buildings only ever rotate around Y, so the snapshot
+  // carries a single yaw instead of a full euler triple; per-axis scale
+  // stays because building footprints are legitimately non-uniform.
+  float yawDeg = 0.0F;
+  QVector3D scale{1.0F, 1.0F, 1.0F};
+
+  int meshKind = 0; // Engine::Core::RenderableComponent::MeshKind
+  QVector3D color{1.0F, 1.0F, 1.0F};
+
+  bool hasUnit = false;
+  int ownerId = 0;
+  int health = 0;
+  int maxHealth = 1;
+  Game::Units::SpawnType spawnType{};
+
+  // Sampled animation state (see HumanoidRendererBase::sampleAnimState).
+  bool isMoving = false;
+  bool isAttacking = false;
+  bool isMelee = false;
+  bool isInHoldMode = false;
+  bool isExitingHold = false;
+  float holdExitProgress = 0.0F;
+
+  // Building extras consumed by the barracks renderer.
+  bool isBeingCaptured = false;
+  float captureProgress = 0.0F; // normalized 0..1
+  int capturingOwnerId = -1;
+  bool rallySet = false;
+  float rallyX = 0.0F;
+  float rallyZ = 0.0F;
+};
+
+struct WorldSnapshot {
+  std::vector<EntitySnapshot> entities;
+  std::uint64_t frame = 0;
+};
+
+// Two-entry ring of tick transforms per entity: [0] is the previous sim
+// tick, [1] the current one. Capture advances the ring when it sees a new
+// tick index and emits transforms interpolated between the two entries, so
+// the renderer shows smooth motion between fixed-rate sim ticks no matter
+// how far the frame rate outruns the tick rate.
+struct TransformHistory {
+  std::uint64_t tick[2] = {0, 0};
+  QVector3D position[2];
+  float yawDeg[2] = {0.0F, 0.0F};
+};
+using TransformHistoryMap =
+    std::unordered_map<Engine::Core::EntityID, TransformHistory>;
+
+// Capture the render-relevant world state. Must run on the sim thread (or
+// while the sim is idle); the result is handed to the renderer through the
+// SnapshotBuffer below. `simTick` is the index of the last completed sim
+// tick and `tickAlpha` the accumulator's progress toward the next one;
+// together with `history` they drive the transform interpolation above.
+void captureWorldSnapshot(Engine::Core::World &world, WorldSnapshot &out,
+                          std::uint64_t simTick, float tickAlpha,
+                          TransformHistoryMap &history);
+
+// Triple buffer with a single writer (sim) and a single reader (render).
+// The writer always has a free slot to fill and publishes with one atomic
+// exchange; the reader picks up the latest published slot without blocking
+// either side.
+class SnapshotBuffer {
+public:
+  auto beginWrite() -> WorldSnapshot & { return m_slots[m_writeIndex]; }
+
+  void publish() {
+    const int published = m_writeIndex;
+    const int previous =
+        m_latest.exchange(published, std::memory_order_acq_rel);
+    // previous != -1: the reader never claimed the slot published last
+    // time, so it is free again. previous == -1: the reader claimed
+    // that slot and may be rendering from it, so the free slot is the
+    // one that is neither it nor the slot just published. Both cases
+    // use only writer-owned bookkeeping — reading m_readIndex here
+    // would race with acquireRead between its exchange and its index
+    // store, letting the writer overwrite the slot being rendered.
+    m_writeIndex =
+        previous != -1 ? previous : 3 - published - m_lastPublished;
+    m_lastPublished = published;
+  }
+
+  auto acquireRead() -> const WorldSnapshot & {
+    const int latest = m_latest.exchange(-1, std::memory_order_acq_rel);
+    if (latest != -1) {
+      m_readIndex = latest;
+    }
+    return m_slots[m_readIndex];
+  }
+
+private:
+  WorldSnapshot m_slots[3];
+  std::atomic<int> m_latest{-1};
+  int m_writeIndex = 0; // writer-owned
+  // Writer-owned: slot most recently handed to m_latest. Starts on the
+  // reader's initial slot so the first publish frees the third slot.
+  int m_lastPublished = 1;
+  int m_readIndex = 1; // reader-owned
+};
+
+} // namespace Render::GL
@@ -0,0 +1,238 @@
+#include "game/core/determinism.h"
+#include "game/core/world.h"
+#include "game/map/skirmish_loader.h"
+#include "game/systems/ai_system.h"
+#include "game/systems/arrow_system.h"
+#include "game/systems/benchmark_scenario.h"
+#include "game/systems/capture_system.h"
+#include "game/systems/cleanup_system.h"
+#include "game/systems/combat_system.h"
+#include "game/systems/global_stats_registry.h"
+#include "game/systems/movement_system.h"
+#include "game/systems/nation_registry.h"
+#include "game/systems/patrol_system.h"
+#include "game/systems/production_system.h"
+#include "game/systems/replay_service.h"
+#include "game/systems/selection_system.h"
+#include "game/systems/terrain_alignment_system.h"
+#include "game/systems/troop_count_registry.h"
+#include "render/gl/camera.h"
+#include "render/scene_renderer.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QString>
+#include <QTextStream>
+#include <QVariantList>
+#include <cstdint>
+#include <memory>
+
+#if !defined(Q_OS_WIN)
+#include <sys/resource.h>
+#endif
+
+// Headless simulation runner: loads a map (or a replay recorded in the
+// GUI), registers the same sim systems as GameEngine, and spins the
+// fixed-timestep update loop flat out with no window, GL context, or QML.
+// Reports ticks/second and peak memory, which CI uses as the throughput
+// and soak regression gate on boxes without a GPU or display.
+
+namespace {
+
+// Matches GameEngine::kSimTickDt; the headless loop runs the identical
+// fixed-timestep simulation without the render-frame pacing around it.
+constexpr float k_sim_tick_dt = 1.0F / 30.0F;
+
+// 30 minutes of sim time at 30 Hz.
+constexpr int k_default_ticks = 54000;
+
+// Map used when --benchmark is given without an explicit --map.
+constexpr const char *k_benchmark_map = "assets/maps/map_rivers.json";
+
+auto peakMemoryBytes() -> std::uint64_t {
+#if defined(Q_OS_WIN)
+  return 0;
+#elif defined(Q_OS_DARWIN)
+  struct rusage usage {};
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<std::uint64_t>(usage.ru_maxrss);
+#else
+  struct rusage usage {};
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024U;
+#endif
+}
+
+// Registration order must match GameEngine: the scheduler batches systems
+// in declaration order, and checksum parity with the GUI depends on it.
+void registerSimSystems(Engine::Core::World &world) {
+  world.addSystem(std::make_unique<Game::Systems::ArrowSystem>());
+  world.addSystem(std::make_unique<Game::Systems::MovementSystem>());
+  world.addSystem(std::make_unique<Game::Systems::PatrolSystem>());
+  world.addSystem(std::make_unique<Game::Systems::CombatSystem>());
+  world.addSystem(std::make_unique<Game::Systems::CaptureSystem>());
+  world.addSystem(std::make_unique<Game::Systems::AISystem>());
+  world.addSystem(std::make_unique<Game::Systems::ProductionSystem>());
+  world.addSystem(std::make_unique<Game::Systems::TerrainAlignmentSystem>());
+  world.addSystem(std::make_unique<Game::Systems::CleanupSystem>());
+  world.addSystem(std::make_unique<Game::Systems::SelectionSystem>());
+}
+
+} // namespace
+
+auto main(int argc, char *argv[]) -> int {
+  QCoreApplication const app(argc, argv);
+  QCoreApplication::setApplicationName(
+      QStringLiteral("standard_of_iron_headless"));
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(
+      QStringLiteral("Headless Standard of Iron simulation runner"));
+  parser.addHelpOption();
+  QCommandLineOption const map_option(
+      QStringLiteral("map"), QStringLiteral("Map JSON to load."),
+      QStringLiteral("path"));
+  QCommandLineOption const replay_option(
+      QStringLiteral("replay"),
+      QStringLiteral("Replay file to play back (overrides --map and --seed)."),
+      QStringLiteral("path"));
+  QCommandLineOption const ticks_option(
+      QStringLiteral("ticks"),
+      QStringLiteral("Number of sim ticks to run (default %1).")
+          .arg(k_default_ticks),
+      QStringLiteral("count"), QString::number(k_default_ticks));
+  QCommandLineOption const seed_option(QStringLiteral("seed"),
+                                       QStringLiteral("Simulation RNG seed."),
+                                       QStringLiteral("value"));
+  QCommandLineOption const benchmark_option(
+      QStringLiteral("benchmark"),
+      QStringLiteral("Run the scripted stress battle with this many units "
+                     "per side and append a JSON report."),
+      QStringLiteral("units-per-side"));
+  parser.addOption(map_option);
+  parser.addOption(replay_option);
+  parser.addOption(ticks_option);
+  parser.addOption(seed_option);
+  parser.addOption(benchmark_option);
+  parser.process(app);
+
+  QTextStream out(stdout);
+  QTextStream err(stderr);
+
+  if (!parser.isSet(map_option) && !parser.isSet(replay_option) &&
+      !parser.isSet(benchmark_option)) {
+    err << "One of --map, --replay or --benchmark is required.\n";
+    return 1;
+  }
+
+  int const benchmark_units =
+      parser.isSet(benchmark_option) ? parser.value(benchmark_option).toInt()
+                                     : 0;
+  if (parser.isSet(benchmark_option) && benchmark_units < 2) {
+    err << "--benchmark needs at least 2 units per side.\n";
+    return 1;
+  }
+
+  Game::Systems::NationRegistry::instance().initializeDefaults();
+  Game::Systems::TroopCountRegistry::instance().initialize();
+  Game::Systems::GlobalStatsRegistry::instance().initialize();
+
+  auto world = std::make_unique<Engine::Core::World>();
+  registerSimSystems(*world);
+
+  // The loaders thread renderer state objects through; constructing them
+  // is GL-free, and with no initialize() call no GL is ever touched.
+  Render::GL::Renderer renderer;
+  Render::GL::Camera camera;
+
+  auto &replay = Game::Systems::ReplayService::instance();
+  auto &rng = Engine::Core::SimRng::instance();
+
+  QString map_path = parser.value(map_option);
+  QVariantList player_configs;
+  if (parser.isSet(replay_option)) {
+    if (!replay.startPlayback(parser.value(replay_option))) {
+      err << "Could not load replay file " << parser.value(replay_option)
+          << "\n";
+      return 1;
+    }
+    rng.setSeed(replay.playbackSeed());
+    map_path = replay.playbackMapPath();
+    player_configs = replay.playbackPlayerConfigs();
+  } else if (parser.isSet(seed_option)) {
+    rng.setSeed(parser.value(seed_option).toUInt());
+  }
+  if (benchmark_units > 0 && !parser.isSet(replay_option)) {
+    if (map_path.isEmpty()) {
+      map_path = QString::fromUtf8(k_benchmark_map);
+    }
+    player_configs = Game::Systems::BenchmarkScenario::playerConfigs();
+  }
+
+  Game::Map::SkirmishLoader loader(*world, renderer, camera);
+  int resolved_player_id = 0;
+  auto const load_result =
+      loader.start(map_path, player_configs, 1, resolved_player_id);
+  if (!load_result.ok) {
+    err << "Map load failed: " << load_result.errorMessage << "\n";
+    return 1;
+  }
+  replay.armPlayback();
+
+  int benchmark_spawned = 0;
+  if (benchmark_units > 0) {
+    benchmark_spawned =
+        Game::Systems::BenchmarkScenario::spawnArmies(*world, benchmark_units);
+    out << "benchmark:      " << benchmark_spawned << " of "
+        << benchmark_units * 2 << " requested units spawned\n";
+  }
+
+  int const ticks = parser.value(ticks_option).toInt();
+
+  Game::Systems::BenchmarkReport report;
+  QElapsedTimer tick_timer;
+  QElapsedTimer timer;
+  timer.start();
+  for (int tick = 1; tick <= ticks; ++tick) {
+    rng.beginTick(static_cast<std::uint64_t>(tick));
+    replay.beginTick(static_cast<std::uint64_t>(tick));
+    if (replay.isPlaybackActive()) {
+      replay.playbackTick(*world);
+    }
+    if (benchmark_units > 0) {
+      tick_timer.start();
+      world->update(k_sim_tick_dt);
+      report.addTickMs(static_cast<double>(tick_timer.nsecsElapsed()) * 1e-6);
+    } else {
+      world->update(k_sim_tick_dt);
+    }
+
+    // Service queued singleShot continuations (path workers, timers)
+    // without paying for an event-loop pass every tick.
+    if ((tick & 1023) == 0) {
+      QCoreApplication::processEvents();
+    }
+  }
+  double const elapsed_s =
+      static_cast<double>(timer.nsecsElapsed()) / 1.0e9;
+
+  double const ticks_per_second =
+      elapsed_s > 0.0 ? static_cast<double>(ticks) / elapsed_s : 0.0;
+  double const peak_mib =
+      static_cast<double>(peakMemoryBytes()) / (1024.0 * 1024.0);
+
+  out << "map:            " << load_result.map_name << "\n";
+  out << "ticks:          " << ticks << " (" << ticks * k_sim_tick_dt
+      << " s of sim time)\n";
+  out << "wall time:      " << QString::number(elapsed_s, 'f', 2) << " s\n";
+  out << "ticks/sec:      " << QString::number(ticks_per_second, 'f', 1)
+      << "\n";
+  out << "peak rss:       " << QString::number(peak_mib, 'f', 1) << " MiB\n";
+  out << "final checksum: 0x"
+      << QString::number(Engine::Core::computeWorldChecksum(*world), 16)
+      << "\n";
+  if (benchmark_units > 0) {
+    out << report.toJson(benchmark_units, benchmark_spawned) << "\n";
+  }
+  return 0;
+}
@@ -1,5 +1,6 @@
 #include "gl_view.h"
 #include "../app/core/game_engine.h"
+#include "../render/thread_topology.h"
 
 #include <QOpenGLFramebufferObject>
 #include <QOpenGLFramebufferObjectFormat>
@@ -29,7 +30,12 @@ void GLView::setEngine(QObject *eng) {
 }
 
 GLView::GLRenderer::GLRenderer(QPointer<GameEngine> engine)
-    : m_engine(std::move(std::move(engine))) {}
+    : m_engine(std::move(std::move(engine))) {
+  // createRenderer() runs on the Qt Quick render thread, which also
+  // carries the sim tick; pin it before the first frame.
+  Render::ThreadTopology::instance().registerCurrentThread(
+      Render::ThreadTopology::Role::Render, "render");
+}
 
 void GLView::GLRenderer::render() {
   if (m_engine == nullptr) {
@@ -9,6 +9,9 @@ Item {
     property real gameSpeed: 1
     property bool setRallyMode: false
     property string cursorMode: "normal"
+    // Attack-context cursor: driven entirely by the engine's per-frame
+    // cached hover classification, never by per-move world queries.
+    property bool attackContext: (typeof game !== 'undefined' && game.hoveredEnemy && game.hasUnitsSelected && cursorMode === "normal")
     property var pressedKeys: ({})
 
     signal mapClicked(real x, real y)
@@ -176,6 +179,14 @@ Item {
             game.selectAllTroops();
             event.accepted = true;
             break;
+        case Qt.Key_F10:
+            game.profilerEnabled = !game.profilerEnabled;
+            event.accepted = true;
+            break;
+        case Qt.Key_F11:
+            console.log("Profiler trace:", game.exportProfilerTrace());
+            event.accepted = true;
+            break;
         }
     }
     Keys.onReleased: function(event) {
@@ -273,7 +284,7 @@ Item {
             hoverEnabled: true
             propagateComposedEvents: true
             preventStealing: true
-            cursorShape: (gameView.cursorMode === "normal") ? Qt.ArrowCursor : Qt.BlankCursor
+            cursorShape: (gameView.cursorMode === "normal" && !gameView.attackContext) ? Qt.ArrowCursor : Qt.BlankCursor
             enabled: gameView.visible
             onEntered: {
                 if (typeof game !== 'undefined' && game.setHoverAtScreen)
@@ -383,10 +394,17 @@ Item {
 
     }
 
+    ProfilerOverlay {
+        anchors.top: parent.top
+        anchors.left: parent.left
+        anchors.margins: 12
+        z: 10000
+    }
+
     Item {
         id: customCursorContainer
 
-        visible: gameView.cursorMode !== "normal"
+        visible: gameView.cursorMode !== "normal" || gameView.attackContext
         width: 32
         height: 32
         z: 999999
@@ -398,7 +416,7 @@ Item {
 
             property real pulseScale: 1
 
-            visible: gameView.cursorMode === "attack"
+            visible: gameView.cursorMode === "attack" || gameView.attackContext
             anchors.fill: parent
 
             Canvas {
@@ -414,4 +414,26 @@ RowLayout {
         }
     }
 
+    Rectangle {
+        Layout.fillHeight: true
+        Layout.preferredWidth: height
+        Layout.alignment: Qt.AlignTop
+        color: "#0f1419"
+        border.color: "#3498db"
+        border.width: 2
+        radius: 6
+
+        Image {
+            anchors.fill: parent
+            anchors.margins: 4
+            // The engine bumps minimapVersion whenever the provider
+            // recomposes (~10 Hz); keying the URL on it re-pulls the image.
+            source: (typeof game !== 'undefined') ? "image://minimap/map?" + game.minimapVersion : ""
+            cache: false
+            fillMode: Image.PreserveAspectFit
+            smooth: false
+        }
+
+    }
+
 }
@@ -17,6 +17,15 @@ ApplicationWindow {
     visible: true
     title: qsTr("Standard of Iron - RTS Game")
 
+    // A --benchmark launch skips the menu; the engine loads the scripted
+    // battle itself once the GL view is rendering.
+    Component.onCompleted: {
+        if (typeof game !== 'undefined' && game.benchmarkRequested()) {
+            mainWindow.menuVisible = false;
+            mainWindow.gameStarted = true;
+        }
+    }
+
     GameView {
         id: gameViewItem
 
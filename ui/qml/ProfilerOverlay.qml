@@ -0,0 +1,195 @@
+import QtQuick 2.15
+
+// Frame-timing HUD fed by game.profilerSnapshot(). Rows are indented by
+// zone nesting depth; the right column shows the worst frame over the
+// profiler's rolling window. Toggled with F10.
+Rectangle {
+    id: overlayRoot
+
+    function refresh() {
+        if (!game)
+            return ;
+
+        snapshot = game.profilerSnapshot();
+    }
+
+    function formatMs(ms) {
+        return Number(ms).toFixed(2) + " ms";
+    }
+
+    property var snapshot: ({
+    })
+    readonly property var liveZones: snapshot.zones !== undefined ? snapshot.zones : []
+    readonly property var worstZones: snapshot.worstZones !== undefined ? snapshot.worstZones : []
+    readonly property var allocRows: snapshot.allocs !== undefined ? snapshot.allocs : []
+    readonly property var threadRows: snapshot.threads !== undefined ? snapshot.threads : []
+    readonly property var pathQueues: snapshot.pathQueues !== undefined ? snapshot.pathQueues : null
+
+    visible: game ? game.profilerEnabled : false
+    width: 620
+    height: Math.min(520, contentColumn.implicitHeight + 16)
+    color: "#0f1a22"
+    opacity: 0.92
+    radius: 4
+    border.color: "#2c3e50"
+    border.width: 1
+    onVisibleChanged: {
+        if (visible)
+            refresh();
+
+    }
+
+    Timer {
+        interval: 250
+        repeat: true
+        running: overlayRoot.visible
+        onTriggered: overlayRoot.refresh()
+    }
+
+    Column {
+        id: contentColumn
+
+        anchors.fill: parent
+        anchors.margins: 8
+        spacing: 2
+
+        Text {
+            text: "Profiler — frame " + (overlayRoot.snapshot.frameIndex !== undefined ? overlayRoot.snapshot.frameIndex : 0) + "  " + overlayRoot.formatMs(overlayRoot.snapshot.frameMs !== undefined ? overlayRoot.snapshot.frameMs : 0)
+            color: "#ecf0f1"
+            font.pixelSize: 13
+            font.bold: true
+        }
+
+        Text {
+            text: "Input latency  p50 " + overlayRoot.formatMs(overlayRoot.snapshot.inputLatencyP50 !== undefined ? overlayRoot.snapshot.inputLatencyP50 : 0) + "  p99 " + overlayRoot.formatMs(overlayRoot.snapshot.inputLatencyP99 !== undefined ? overlayRoot.snapshot.inputLatencyP99 : 0) + "  (" + (overlayRoot.snapshot.inputLatencySamples !== undefined ? overlayRoot.snapshot.inputLatencySamples : 0) + " samples)"
+            color: "#95a5a6"
+            font.pixelSize: 11
+            visible: overlayRoot.snapshot.inputLatencySamples !== undefined && overlayRoot.snapshot.inputLatencySamples > 0
+        }
+
+        Row {
+            spacing: 16
+            width: parent.width
+
+            Column {
+                width: (parent.width - 16) / 2
+                spacing: 1
+
+                Text {
+                    text: "Current"
+                    color: "#95a5a6"
+                    font.pixelSize: 11
+                }
+
+                Repeater {
+                    model: overlayRoot.liveZones
+
+                    Text {
+                        required property var modelData
+
+                        text: overlayRoot.formatMs(modelData.ms) + "  " + modelData.name
+                        leftPadding: modelData.depth * 12 + (modelData.thread > 0 ? 6 : 0)
+                        color: modelData.thread > 0 ? "#7fb3d5" : "#d5dbdb"
+                        font.pixelSize: 11
+                        font.family: "monospace"
+                        elide: Text.ElideRight
+                        width: parent.width
+                    }
+
+                }
+
+            }
+
+            Column {
+                width: (parent.width - 16) / 2
+                spacing: 1
+
+                Text {
+                    text: "Worst (frame " + (overlayRoot.snapshot.worstFrameIndex !== undefined ? overlayRoot.snapshot.worstFrameIndex : 0) + ", " + overlayRoot.formatMs(overlayRoot.snapshot.worstMs !== undefined ? overlayRoot.snapshot.worstMs : 0) + ")"
+                    color: "#95a5a6"
+                    font.pixelSize: 11
+                }
+
+                Repeater {
+                    model: overlayRoot.worstZones
+
+                    Text {
+                        required property var modelData
+
+                        text: overlayRoot.formatMs(modelData.ms) + "  " + modelData.name
+                        leftPadding: modelData.depth * 12 + (modelData.thread > 0 ? 6 : 0)
+                        color: modelData.thread > 0 ? "#7fb3d5" : "#f5b041"
+                        font.pixelSize: 11
+                        font.family: "monospace"
+                        elide: Text.ElideRight
+                        width: parent.width
+                    }
+
+                }
+
+            }
+
+        }
+
+        Text {
+            text: "Heap (per frame)"
+            color: "#95a5a6"
+            font.pixelSize: 11
+            topPadding: 4
+        }
+
+        Repeater {
+            model: overlayRoot.allocRows
+
+            Text {
+                required property var modelData
+
+                text: modelData.tag + ": " + modelData.count + " allocs, " + (modelData.bytes / 1024).toFixed(1) + " KiB"
+                visible: modelData.count > 0
+                color: "#d5dbdb"
+                font.pixelSize: 11
+                font.family: "monospace"
+            }
+
+        }
+
+        Text {
+            visible: overlayRoot.pathQueues !== null
+            text: "Path queues"
+            color: "#95a5a6"
+            font.pixelSize: 11
+            topPadding: 4
+        }
+
+        Text {
+            visible: overlayRoot.pathQueues !== null
+            text: overlayRoot.pathQueues === null ? "" : "high " + overlayRoot.pathQueues.high + " (" + formatMs(overlayRoot.pathQueues.highWaitMs) + ")  normal " + overlayRoot.pathQueues.normal + " (" + formatMs(overlayRoot.pathQueues.normalWaitMs) + ")  dropped " + overlayRoot.pathQueues.dropped
+            color: "#d5dbdb"
+            font.pixelSize: 11
+            font.family: "monospace"
+        }
+
+        Text {
+            text: "Threads (core affinity)"
+            color: "#95a5a6"
+            font.pixelSize: 11
+            topPadding: 4
+        }
+
+        Repeater {
+            model: overlayRoot.threadRows
+
+            Text {
+                required property var modelData
+
+                text: modelData.name + " [" + modelData.role + "]  cores " + modelData.cores
+                color: "#d5dbdb"
+                font.pixelSize: 11
+                font.family: "monospace"
+            }
+
+        }
+
+    }
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace Utils::Parallel {
+
+// Number of contiguous bands forBands() will split a range of `count`
+// items into: one per hardware thread, never more than `count`.
+[[nodiscard]] inline auto bandCount(int count) -> int {
+  if (count <= 0) {
+    return 0;
+  }
+  const unsigned hw = std::thread::hardware_concurrency();
+  const int workers = hw == 0U ? 1 : static_cast<int>(hw);
+  return std::clamp(count, 1, workers);
+}
+
+// Splits [0, count) into bandCount(count) contiguous bands and runs
+// fn(band, begin, end) for each, on std::async workers plus the calling
+// thread. Bands must be independent; callers that accumulate results
+// should collect per-band output and concatenate it in band order so the
+// combined result is deterministic regardless of thread timing.
+template <typename Fn> void forBands(int count, Fn &&fn) {
+  const int bands = bandCount(count);
+  if (bands <= 0) {
+    return;
+  }
+  if (bands == 1) {
+    fn(0, 0, count);
+    return;
+  }
+
+  const int per_band = (count + bands - 1) / bands;
+
+  std::vector<std::future<void>> pending;
+  pending.reserve(bands - 1);
+  for (int band = 1; band < bands; ++band) {
+    const int begin = std::min(band * per_band, count);
+    const int end = std::min(begin + per_band, count);
+    if (begin >= end) {
+      continue;
+    }
+    pending.push_back(std::async(std::launch::async, [&fn, band, begin, end]() {
+      fn(band, begin, end);
+    }));
+  }
+
+  fn(0, 0, std::min(per_band, count));
+
+  for (auto &task : pending) {
+    task.wait();
+  }
+}
+
+} // namespace Utils::Parallel